@@ -0,0 +1,169 @@
+/***************************************************************************//**
+ * @file    burst_capture.c
+ * @brief   Block-batched burst data capture into the IIO circular buffer
+ * @details Samples read one at a time from the device are gathered into a
+ *          contiguous staging block, which is committed to the circular
+ *          buffer with a single write, instead of one write per sample.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include "burst_capture.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Initialize the burst capture descriptor.
+ * @param	desc[out] - Burst capture descriptor
+ * @param	param[in] - Burst capture init parameters
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t burst_capture_init(struct burst_capture_desc **desc,
+			   struct burst_capture_init_param *param)
+{
+	struct burst_capture_desc *burst;
+
+	if (!desc || !param || !param->read_unit || !param->unit_size
+	    || !param->block_units) {
+		return -EINVAL;
+	}
+
+	burst = no_os_calloc(1, sizeof(*burst));
+	if (!burst) {
+		return -ENOMEM;
+	}
+
+	burst->block = no_os_calloc(param->block_units, param->unit_size);
+	if (!burst->block) {
+		no_os_free(burst);
+		return -ENOMEM;
+	}
+
+	burst->read_unit = param->read_unit;
+	burst->ctx = param->ctx;
+	burst->unit_size = param->unit_size;
+	burst->block_units = param->block_units;
+	burst->get_ticks = param->get_ticks;
+	burst->ticks_per_sec = param->ticks_per_sec;
+	burst->process_block = param->process_block;
+	burst->process_ctx = param->process_ctx;
+
+	*desc = burst;
+
+	return 0;
+}
+
+/**
+ * @brief 	Free the resources allocated for burst capture.
+ * @param	desc[in] - Burst capture descriptor
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t burst_capture_remove(struct burst_capture_desc *desc)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	no_os_free(desc->block);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Capture the requested number of units into the circular buffer.
+ * @param	desc[in] - Burst capture descriptor
+ * @param	cb[in] - Circular buffer to write into
+ * @param	nb_of_units[in] - Number of units to capture
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	With block processing, nb_of_units counts the processed units.
+ */
+int32_t burst_capture_read(struct burst_capture_desc *desc,
+			   struct no_os_circular_buffer *cb,
+			   uint32_t nb_of_units)
+{
+	uint32_t remaining = nb_of_units;
+	uint32_t block_units;
+	uint32_t start_ticks = 0;
+	uint8_t *dst;
+	uint32_t unit;
+	int32_t ret;
+
+	if (!desc || !cb) {
+		return -EINVAL;
+	}
+
+	desc->last_units = 0;
+	desc->last_ticks = 0;
+
+	while (remaining) {
+		block_units = no_os_min(remaining, desc->block_units);
+
+		if (desc->get_ticks) {
+			start_ticks = desc->get_ticks();
+		}
+
+		dst = desc->block;
+		for (unit = 0; unit < block_units; unit++) {
+			ret = desc->read_unit(desc->ctx, dst);
+			if (ret) {
+				return ret;
+			}
+
+			dst += desc->unit_size;
+		}
+
+		/* Processing never adds units, so the block stays within the
+		 * remaining units of the burst */
+		if (desc->process_block) {
+			block_units = desc->process_block(desc->process_ctx, desc->block,
+							  block_units);
+		}
+
+		if (block_units) {
+			ret = no_os_cb_write(cb, desc->block, block_units * desc->unit_size);
+			if (ret) {
+				return ret;
+			}
+		}
+
+		/* Accumulate per block so that a time base wrap-around between
+		 * the start and end of the burst is accounted for */
+		if (desc->get_ticks) {
+			desc->last_ticks += (uint32_t)(desc->get_ticks() - start_ticks);
+		}
+
+		desc->last_units += block_units;
+		remaining -= block_units;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Get the throughput achieved during the last burst.
+ * @param	desc[in] - Burst capture descriptor
+ * @return 	Units captured per second (0 if not measured)
+ */
+uint32_t burst_capture_get_rate(struct burst_capture_desc *desc)
+{
+	if (!desc || !desc->last_ticks) {
+		return 0;
+	}
+
+	return (uint32_t)(((uint64_t)desc->last_units * desc->ticks_per_sec) /
+			  desc->last_ticks);
+}
@@ -0,0 +1,82 @@
+/***************************************************************************//**
+ * @file    burst_capture.h
+ * @brief   Block-batched burst data capture into the IIO circular buffer
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _BURST_CAPTURE_H_
+#define _BURST_CAPTURE_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "no_os_circular_buffer.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct burst_capture_init_param
+ * @brief Burst capture initialization parameters
+ */
+struct burst_capture_init_param {
+	/* Read one unit (sample or scan) of data into the destination */
+	int32_t (*read_unit)(void *ctx, void *dst);
+	/* Context passed to the read function */
+	void *ctx;
+	/* Size of one unit of data (in bytes) */
+	uint32_t unit_size;
+	/* Number of units staged before committing to the circular buffer */
+	uint32_t block_units;
+	/* Optional time base used for throughput measurement */
+	uint32_t (*get_ticks)(void);
+	/* Frequency of the time base (in Hz) */
+	uint32_t ticks_per_sec;
+	/* Optional in place processing of a block before it is committed,
+	 * returning the number of units left in the block (e.g. decimation) */
+	uint32_t (*process_block)(void *ctx, void *block, uint32_t units);
+	/* Context passed to the block processing function */
+	void *process_ctx;
+};
+
+/**
+ * @struct burst_capture_desc
+ * @brief Burst capture descriptor
+ */
+struct burst_capture_desc {
+	int32_t (*read_unit)(void *ctx, void *dst);
+	void *ctx;
+	uint32_t unit_size;
+	uint32_t block_units;
+	uint32_t (*get_ticks)(void);
+	uint32_t ticks_per_sec;
+	uint32_t (*process_block)(void *ctx, void *block, uint32_t units);
+	void *process_ctx;
+	/* Staging block holding 'block_units' units */
+	uint8_t *block;
+	/* Units captured during the last burst */
+	uint32_t last_units;
+	/* Time base ticks elapsed during the last burst */
+	uint64_t last_ticks;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int32_t burst_capture_init(struct burst_capture_desc **desc,
+			   struct burst_capture_init_param *param);
+int32_t burst_capture_remove(struct burst_capture_desc *desc);
+int32_t burst_capture_read(struct burst_capture_desc *desc,
+			   struct no_os_circular_buffer *cb,
+			   uint32_t nb_of_units);
+uint32_t burst_capture_get_rate(struct burst_capture_desc *desc);
+
+#endif // _BURST_CAPTURE_H_
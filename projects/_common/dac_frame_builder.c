@@ -0,0 +1,294 @@
+/***************************************************************************//**
+ * @file    dac_frame_builder.c
+ * @brief   SPI DMA frame building for the DAC IIO applications
+ * @details The DMA streams the frames straight from memory, so the
+ *          instruction (register address) of each write has to sit next to
+ *          its data:
+ *          - Streaming mode: one instruction followed by all the samples.
+ *            The instruction is written into the headroom reserved ahead of
+ *            the IIO buffer, the samples are not moved.
+ *          - Single instruction mode: one instruction per sample. The frames
+ *            are expanded in place (the buffer holding twice the samples
+ *            size), one 32-bit frame per 16-bit sample, walking backwards so
+ *            that no sample is overwritten before being read.
+ *          - Template frames: the layout of the frames of a scan (e.g. the
+ *            input register writes of some channels followed by a software
+ *            LDAC command) is computed once per channel configuration, then
+ *            stamped in place with the samples of every scan.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "dac_frame_builder.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Bytes per sample (16-bit DAC codes) */
+#define DAC_FRAME_SAMPLE_SIZE		2
+
+/* Single instruction frame (instruction and sample) */
+#define DAC_FRAME_SINGLE_INSTR_SIZE	(DAC_FRAME_INSTR_SIZE + DAC_FRAME_SAMPLE_SIZE)
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Expand the IIO buffer samples into single instruction frames.
+ * @param	buff[in,out] - IIO buffer, holding at least 2 * nb_bytes
+ * @param	nb_bytes[in] - Size of the samples in the buffer (in bytes)
+ * @param	instr[in] - Instruction of each active channel, in scan order
+ * @param	nb_chns[in] - Number of active channels
+ * @param	frames_size[out] - Size of the frames (in bytes)
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	Frames are laid out as the instruction (MSB first) followed by the
+ *			sample bytes as received. Only whole scans are converted.
+ */
+int32_t dac_frame_build_single_instr(uint8_t *buff, uint32_t nb_bytes,
+				     const uint16_t *instr, uint8_t nb_chns,
+				     uint32_t *frames_size)
+{
+	uint32_t heads[DAC_FRAME_MAX_CHANNELS];
+	const uint8_t *src;
+	uint8_t *dst;
+	uint32_t nb_scans;
+	uint32_t frame;
+	uint16_t sample;
+	uint8_t chn;
+
+	if (!buff || !instr || !nb_chns || nb_chns > DAC_FRAME_MAX_CHANNELS
+	    || !frames_size) {
+		return -EINVAL;
+	}
+
+	/* Instruction bytes in wire order, in the lower half of the frame word
+	 * (little endian memory, as on the Cortex-M cores) */
+	for (chn = 0; chn < nb_chns; chn++) {
+		heads[chn] = (uint32_t)(instr[chn] >> 8) | ((uint32_t)(instr[chn] & 0xFF) << 8);
+	}
+
+	nb_scans = nb_bytes / (nb_chns * DAC_FRAME_SAMPLE_SIZE);
+	src = buff + nb_scans * nb_chns * DAC_FRAME_SAMPLE_SIZE;
+	dst = buff + nb_scans * nb_chns * DAC_FRAME_SINGLE_INSTR_SIZE;
+	*frames_size = (uint32_t)(dst - buff);
+
+	/* Frame k ends at 4(k+1) and sample k starts at 2k, so walking from the
+	 * last sample, a frame only overwrites samples already read */
+	while (nb_scans--) {
+		chn = nb_chns;
+		while (chn--) {
+			src -= DAC_FRAME_SAMPLE_SIZE;
+			dst -= DAC_FRAME_SINGLE_INSTR_SIZE;
+
+			memcpy(&sample, src, sizeof(sample));
+			frame = heads[chn] | ((uint32_t)sample << 16);
+			memcpy(dst, &frame, sizeof(frame));
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Prepend the streaming mode instruction to the IIO buffer samples.
+ * @param	payload[in] - IIO buffer, preceded by DAC_FRAME_HEADROOM bytes
+ * @param	instr[in] - Instruction of the first active channel
+ * @return 	Start of the frame (instruction followed by the samples)
+ */
+uint8_t *dac_frame_prepend_instr(uint8_t *payload, uint16_t instr)
+{
+	payload[-2] = instr >> 8;
+	payload[-1] = instr & 0xFF;
+
+	return payload - DAC_FRAME_INSTR_SIZE;
+}
+
+/**
+ * @brief 	Start an empty frame template.
+ * @param	tmpl[out] - Frame template
+ * @param	scan_samples[in] - Number of samples per scan in the IIO buffer
+ * @param	msb_first[in] - Samples sent MSB first (swapped from the buffer)
+ * @return 	none
+ */
+void dac_frame_template_init(struct dac_frame_template *tmpl,
+			     uint8_t scan_samples, bool msb_first)
+{
+	tmpl->nb_frames = 0;
+	tmpl->scan_samples = scan_samples;
+	tmpl->msb_first = msb_first;
+}
+
+/**
+ * @brief 	Append a frame to the template.
+ * @param	tmpl[in,out] - Frame template
+ * @param	frame[in] - Frame bytes in wire order (DAC_FRAME_SIZE bytes, the
+ *			data bytes being ignored for a sample frame)
+ * @param	sample[in] - Index of the scan sample sent in the frame, or
+ *			DAC_FRAME_NO_SAMPLE for a constant frame
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t dac_frame_template_add(struct dac_frame_template *tmpl,
+			       const uint8_t *frame, uint8_t sample)
+{
+	uint32_t word;
+
+	if (tmpl->nb_frames >= DAC_FRAME_MAX_TEMPLATE
+	    || (sample != DAC_FRAME_NO_SAMPLE && sample >= tmpl->scan_samples)) {
+		return -EINVAL;
+	}
+
+	memcpy(&word, frame, sizeof(word));
+	if (sample != DAC_FRAME_NO_SAMPLE) {
+		/* Data bytes stamped from the sample (little endian memory) */
+		word &= 0xFFFF;
+	}
+
+	tmpl->words[tmpl->nb_frames] = word;
+	tmpl->samples[tmpl->nb_frames] = sample;
+	tmpl->nb_frames++;
+
+	return 0;
+}
+
+/**
+ * @brief 	Stamp the frames of one scan.
+ * @param	tmpl[in] - Frame template
+ * @param	samples[in] - Samples of the scan, followed by a zero sample for
+ *			the constant frames
+ * @param	dst[out] - Frames of the scan
+ * @return 	none
+ */
+static inline void dac_frame_stamp_scan(const struct dac_frame_template *tmpl,
+					const uint16_t *samples, uint8_t *dst)
+{
+	uint32_t word;
+	uint8_t frame;
+
+	for (frame = 0; frame < tmpl->nb_frames; frame++) {
+		word = tmpl->words[frame]
+		       | ((uint32_t)samples[tmpl->samples[frame]] << 16);
+		memcpy(dst, &word, sizeof(word));
+		dst += DAC_FRAME_SIZE;
+	}
+}
+
+/**
+ * @brief 	Load the samples of one scan.
+ * @param	tmpl[in] - Frame template
+ * @param	src[in] - Scan in the IIO buffer
+ * @param	samples[out] - Samples, byte swapped if sent MSB first
+ * @return 	none
+ */
+static inline void dac_frame_load_scan(const struct dac_frame_template *tmpl,
+				       const uint8_t *src, uint16_t *samples)
+{
+	uint8_t sample;
+
+	if (tmpl->msb_first) {
+		for (sample = 0; sample < tmpl->scan_samples; sample++) {
+			samples[sample] = (uint16_t)((src[0] << 8) | src[1]);
+			src += DAC_FRAME_SAMPLE_SIZE;
+		}
+	} else {
+		for (sample = 0; sample < tmpl->scan_samples; sample++) {
+			samples[sample] = (uint16_t)(src[0] | (src[1] << 8));
+			src += DAC_FRAME_SAMPLE_SIZE;
+		}
+	}
+}
+
+/**
+ * @brief 	Stamp the IIO buffer scans into the template frames, in place.
+ * @param	tmpl[in] - Frame template
+ * @param	buff[in,out] - IIO buffer
+ * @param	nb_scans[in] - Number of scans in the buffer
+ * @param	buff_size[in] - Size of the memory available from the buffer start
+ * @param	frames_size[out] - Size of the frames (in bytes)
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	A scan is fully read before its frames are written. Frames larger
+ *			than the scans are stamped from the last scan, smaller ones from
+ *			the first scan, so that no scan is overwritten before being read.
+ */
+int32_t dac_frame_stamp(const struct dac_frame_template *tmpl, uint8_t *buff,
+			uint32_t nb_scans, uint32_t buff_size,
+			uint32_t *frames_size)
+{
+	uint16_t samples[DAC_FRAME_MAX_CHANNELS + 1];
+	uint32_t scan_size;
+	uint32_t frame_size;
+	const uint8_t *src;
+	uint8_t *dst;
+	uint32_t scan;
+
+	if (!tmpl || !buff || !frames_size || !tmpl->nb_frames
+	    || tmpl->scan_samples > DAC_FRAME_MAX_CHANNELS) {
+		return -EINVAL;
+	}
+
+	/* Sample of the constant frames */
+	samples[DAC_FRAME_NO_SAMPLE] = 0;
+
+	scan_size = tmpl->scan_samples * DAC_FRAME_SAMPLE_SIZE;
+	frame_size = tmpl->nb_frames * DAC_FRAME_SIZE;
+
+	if ((uint64_t)nb_scans * frame_size > buff_size
+	    || (uint64_t)nb_scans * scan_size > buff_size) {
+		return -ENOMEM;
+	}
+
+	if (frame_size > scan_size) {
+		src = buff + nb_scans * scan_size;
+		dst = buff + nb_scans * frame_size;
+		for (scan = 0; scan < nb_scans; scan++) {
+			src -= scan_size;
+			dst -= frame_size;
+			dac_frame_load_scan(tmpl, src, samples);
+			dac_frame_stamp_scan(tmpl, samples, dst);
+		}
+	} else {
+		src = buff;
+		dst = buff;
+		for (scan = 0; scan < nb_scans; scan++) {
+			dac_frame_load_scan(tmpl, src, samples);
+			dac_frame_stamp_scan(tmpl, samples, dst);
+			src += scan_size;
+			dst += frame_size;
+		}
+	}
+
+	*frames_size = nb_scans * frame_size;
+
+	return 0;
+}
+
+/**
+ * @brief 	Fill the memory with a repeated frame.
+ * @param	buff[out] - Memory to fill
+ * @param	nb_bytes[in] - Size of the memory (whole frames are filled)
+ * @param	frame[in] - Frame bytes in wire order (DAC_FRAME_SIZE bytes)
+ * @return 	none
+ */
+void dac_frame_fill(uint8_t *buff, uint32_t nb_bytes, const uint8_t *frame)
+{
+	uint32_t word;
+	uint32_t frames;
+
+	memcpy(&word, frame, sizeof(word));
+
+	for (frames = nb_bytes / DAC_FRAME_SIZE; frames; frames--) {
+		memcpy(buff, &word, sizeof(word));
+		buff += DAC_FRAME_SIZE;
+	}
+}
@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ * @file    dac_frame_builder.h
+ * @brief   SPI DMA frame building for the DAC IIO applications
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _DAC_FRAME_BUILDER_H_
+#define _DAC_FRAME_BUILDER_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Max channels in a scan */
+#define DAC_FRAME_MAX_CHANNELS		16
+
+/* Size of the instruction (address) phase of a frame */
+#define DAC_FRAME_INSTR_SIZE		2
+
+/* Free space to reserve ahead of the IIO buffer for the instruction
+ * prepended in streaming mode (word aligned) */
+#define DAC_FRAME_HEADROOM			4
+
+/* Size of a template frame (instruction and 16-bit data) */
+#define DAC_FRAME_SIZE				4
+
+/* Max frames per scan in a template (one per channel and a trailing
+ * command, e.g. a software LDAC) */
+#define DAC_FRAME_MAX_TEMPLATE		(DAC_FRAME_MAX_CHANNELS + 1)
+
+/* Template frame not carrying a scan sample (stamped with a zero sample
+ * held past the scan samples) */
+#define DAC_FRAME_NO_SAMPLE			DAC_FRAME_MAX_CHANNELS
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct dac_frame_template
+ * @brief Layout of the frames sent for every scan, computed once per channel
+ *        configuration and stamped with the scan samples
+ */
+struct dac_frame_template {
+	/* Frame words holding the constant bytes, in wire order */
+	uint32_t words[DAC_FRAME_MAX_TEMPLATE];
+	/* Scan sample stamped into the data bytes of each frame
+	 * (DAC_FRAME_NO_SAMPLE for the constant frames) */
+	uint8_t samples[DAC_FRAME_MAX_TEMPLATE];
+	/* Number of frames per scan */
+	uint8_t nb_frames;
+	/* Number of samples per scan in the IIO buffer */
+	uint8_t scan_samples;
+	/* Samples sent MSB first (byte swapped from the IIO buffer) */
+	bool msb_first;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int32_t dac_frame_build_single_instr(uint8_t *buff, uint32_t nb_bytes,
+				     const uint16_t *instr, uint8_t nb_chns,
+				     uint32_t *frames_size);
+uint8_t *dac_frame_prepend_instr(uint8_t *payload, uint16_t instr);
+void dac_frame_template_init(struct dac_frame_template *tmpl,
+			     uint8_t scan_samples, bool msb_first);
+int32_t dac_frame_template_add(struct dac_frame_template *tmpl,
+			       const uint8_t *frame, uint8_t sample);
+int32_t dac_frame_stamp(const struct dac_frame_template *tmpl, uint8_t *buff,
+			uint32_t nb_scans, uint32_t buff_size,
+			uint32_t *frames_size);
+void dac_frame_fill(uint8_t *buff, uint32_t nb_bytes, const uint8_t *frame);
+
+#endif // _DAC_FRAME_BUILDER_H_
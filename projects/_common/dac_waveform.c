@@ -0,0 +1,292 @@
+/***************************************************************************//**
+ * @file    dac_waveform.c
+ * @brief   Pre-rendered cyclic waveform playback for the DAC IIO applications
+ * @details The cyclic buffer sent by the IIO client is rendered once into the
+ *          device frames (command/address and data) ready to be shifted out
+ *          on the SPI bus, so that a timer triggered DMA can replay them
+ *          without popping and formatting every sample. The frames can be
+ *          rendered in place over the IIO buffer data. The achieved DAC
+ *          update rate is measured from the played back units accounted by
+ *          the transfer complete callbacks.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include "dac_waveform.h"
+#include "no_os_alloc.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Initialize the DAC waveform descriptor.
+ * @param	desc[out] - DAC waveform descriptor
+ * @param	param[in] - DAC waveform init parameters
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t dac_waveform_init(struct dac_waveform_desc **desc,
+			  struct dac_waveform_init_param *param)
+{
+	struct dac_waveform_desc *waveform;
+
+	if (!desc || !param || !param->render_frame || !param->frame_size
+	    || !param->frames || param->frames_mem_size < param->frame_size) {
+		return -EINVAL;
+	}
+
+	if (param->sample_size != 1 && param->sample_size != 2
+	    && param->sample_size != 4) {
+		return -EINVAL;
+	}
+
+	waveform = no_os_calloc(1, sizeof(*waveform));
+	if (!waveform) {
+		return -ENOMEM;
+	}
+
+	waveform->render_frame = param->render_frame;
+	waveform->ctx = param->ctx;
+	waveform->frame_size = param->frame_size;
+	waveform->sample_size = param->sample_size;
+	waveform->frames = param->frames;
+	waveform->frames_mem_size = param->frames_mem_size;
+	waveform->rate.get_ticks = param->get_ticks;
+	waveform->rate.ticks_per_sec = param->ticks_per_sec;
+	waveform->rate.get_ms = param->get_ms;
+
+	*desc = waveform;
+
+	return 0;
+}
+
+/**
+ * @brief 	Free the resources allocated for the DAC waveform.
+ * @param	desc[in] - DAC waveform descriptor
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t dac_waveform_remove(struct dac_waveform_desc *desc)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Render the IIO buffer into the device frames.
+ * @param	desc[in] - DAC waveform descriptor
+ * @param	data[in] - IIO buffer data (scans of the active channels)
+ * @param	nb_bytes[in] - Size of the IIO buffer data (in bytes)
+ * @param	chns[in] - Active channels, in scan order
+ * @param	nb_chns[in] - Number of active channels
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	-ENOMEM is returned when the frames do not fit in the frame
+ *			memory, the caller being free to fall back to per sample writes.
+ * @note	The frames are rendered from the last one backwards, so the frame
+ *			memory may start at the IIO buffer data (in place rendering) as long
+ *			as a frame is not smaller than a sample.
+ */
+int32_t dac_waveform_render(struct dac_waveform_desc *desc, const void *data,
+			    uint32_t nb_bytes, const uint8_t *chns, uint8_t nb_chns)
+{
+	const uint8_t *sample;
+	uint8_t *frame;
+	uint32_t nb_scans;
+	uint32_t scan;
+	uint32_t code;
+	uint8_t chn;
+
+	if (!desc || !data || !chns || !nb_chns) {
+		return -EINVAL;
+	}
+
+	desc->ready = false;
+
+	nb_scans = nb_bytes / (desc->sample_size * nb_chns);
+	if (!nb_scans) {
+		return -EINVAL;
+	}
+
+	if ((uint64_t)nb_scans * nb_chns * desc->frame_size >
+	    desc->frames_mem_size) {
+		return -ENOMEM;
+	}
+
+	if (desc->frames == data && desc->frame_size < desc->sample_size) {
+		return -EINVAL;
+	}
+
+	/* Backwards, a frame never overwrites a sample not yet rendered */
+	sample = (const uint8_t *)data + (nb_scans * nb_chns * desc->sample_size);
+	frame = desc->frames + (nb_scans * nb_chns * desc->frame_size);
+	for (scan = 0; scan < nb_scans; scan++) {
+		for (chn = nb_chns; chn > 0; chn--) {
+			sample -= desc->sample_size;
+			frame -= desc->frame_size;
+
+			/* IIO buffer samples are little endian */
+			switch (desc->sample_size) {
+			case 1:
+				code = sample[0];
+				break;
+			case 2:
+				code = sample[0] | ((uint32_t)sample[1] << 8);
+				break;
+			default:
+				code = sample[0] | ((uint32_t)sample[1] << 8)
+				       | ((uint32_t)sample[2] << 16) | ((uint32_t)sample[3] << 24);
+				break;
+			}
+
+			desc->render_frame(desc->ctx, chns[chn - 1], code, frame);
+		}
+	}
+
+	desc->nb_scans = nb_scans;
+	desc->nb_frames = nb_scans * nb_chns;
+	desc->ready = true;
+
+	return 0;
+}
+
+/**
+ * @brief 	Invalidate the rendered waveform (new IIO buffer expected).
+ * @param	desc[in] - DAC waveform descriptor
+ * @return 	none
+ */
+void dac_waveform_reset(struct dac_waveform_desc *desc)
+{
+	desc->ready = false;
+	desc->nb_frames = 0;
+	desc->nb_scans = 0;
+	desc->rate.units = 0;
+	desc->rate.ticks = 0;
+}
+
+/**
+ * @brief 	Mark the start of the playback (rate measurement reference).
+ * @param	desc[in] - DAC waveform descriptor
+ * @return 	none
+ */
+void dac_waveform_start(struct dac_waveform_desc *desc)
+{
+	dac_update_rate_start(&desc->rate, 1);
+}
+
+/**
+ * @brief 	Account for one complete waveform cycle played back.
+ * @param	desc[in] - DAC waveform descriptor
+ * @return 	none
+ * @note	Called from the transfer complete interrupt of the replay DMA.
+ * @note	The frames (channel updates) are accounted, the unit of the per
+ *			update (trigger) accounting of the interrupt modes.
+ */
+void dac_waveform_cycle_done(struct dac_waveform_desc *desc)
+{
+	dac_update_rate_account(&desc->rate, desc->nb_frames);
+}
+
+/**
+ * @brief 	Get the DAC update rate achieved since the start of the playback.
+ * @param	desc[in] - DAC waveform descriptor
+ * @return 	DAC channel updates (frames) per second (0 if not measured yet)
+ */
+uint32_t dac_waveform_get_rate(struct dac_waveform_desc *desc)
+{
+	if (!desc) {
+		return 0;
+	}
+
+	return dac_update_rate_get(&desc->rate);
+}
+
+/**
+ * @brief 	Start the update rate measurement.
+ * @param	rate[in] - DAC update rate descriptor
+ * @param	units_per_update[in] - Units accounted per DAC update
+ * @return 	none
+ */
+void dac_update_rate_start(struct dac_update_rate *rate,
+			   uint32_t units_per_update)
+{
+	rate->units_per_update = units_per_update ? units_per_update : 1;
+	rate->units = 0;
+	rate->ticks = 0;
+
+	if (rate->get_ticks) {
+		rate->last_tick = rate->get_ticks();
+	}
+
+	if (rate->get_ms) {
+		rate->last_ms = rate->get_ms();
+	}
+}
+
+/**
+ * @brief 	Account for units played back.
+ * @param	rate[in] - DAC update rate descriptor
+ * @param	nb_units[in] - Units played back since the last accounting
+ * @return 	none
+ * @note	Ticks are accumulated per call so that the time base wrap-around
+ *			is accounted for. Without a millisecond time base, the calls must be
+ *			less than one wrap-around apart (about 24 s for a 180 MHz core cycle
+ *			counter), otherwise the whole wrap-arounds are counted from the
+ *			millisecond time base.
+ */
+void dac_update_rate_account(struct dac_update_rate *rate, uint32_t nb_units)
+{
+	uint64_t elapsed;
+	uint64_t elapsed_ms_ticks;
+	uint32_t now;
+	uint32_t now_ms;
+
+	rate->units += nb_units;
+
+	if (rate->get_ticks) {
+		now = rate->get_ticks();
+		elapsed = (uint32_t)(now - rate->last_tick);
+		rate->last_tick = now;
+
+		if (rate->get_ms) {
+			now_ms = rate->get_ms();
+			elapsed_ms_ticks = ((uint64_t)(uint32_t)(now_ms - rate->last_ms) *
+					    rate->ticks_per_sec) / 1000;
+			rate->last_ms = now_ms;
+
+			/* Add the whole wrap-arounds, rounded to the nearest */
+			if (elapsed_ms_ticks > elapsed) {
+				elapsed += ((elapsed_ms_ticks - elapsed + (1ULL << 31)) >> 32) << 32;
+			}
+		}
+
+		rate->ticks += elapsed;
+	}
+}
+
+/**
+ * @brief 	Get the DAC update rate achieved since the start.
+ * @param	rate[in] - DAC update rate descriptor
+ * @return 	DAC updates per second (0 if not measured yet)
+ */
+uint32_t dac_update_rate_get(struct dac_update_rate *rate)
+{
+	if (!rate || !rate->ticks || !rate->units_per_update) {
+		return 0;
+	}
+
+	return (uint32_t)((rate->units * rate->ticks_per_sec) /
+			  ((uint64_t)rate->ticks * rate->units_per_update));
+}
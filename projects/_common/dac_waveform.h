@@ -0,0 +1,118 @@
+/***************************************************************************//**
+ * @file    dac_waveform.h
+ * @brief   Pre-rendered cyclic waveform playback for the DAC IIO applications
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _DAC_WAVEFORM_H_
+#define _DAC_WAVEFORM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct dac_update_rate
+ * @brief DAC update rate measurement
+ * @note The updates are accounted in units (scans, frames or bytes) played
+ *		 back, converted into DAC updates when the rate is read.
+ */
+struct dac_update_rate {
+	/* Time base used for the measurement */
+	uint32_t (*get_ticks)(void);
+	/* Frequency of the time base (in Hz) */
+	uint32_t ticks_per_sec;
+	/* Optional millisecond time base, resolving the wrap-arounds of the
+	 * time base between two accountings */
+	uint32_t (*get_ms)(void);
+	/* Units played back per DAC update */
+	uint32_t units_per_update;
+	/* Units played back since the start */
+	uint64_t units;
+	/* Time base ticks elapsed since the start */
+	uint64_t ticks;
+	/* Time base value at the last accounting */
+	uint32_t last_tick;
+	/* Millisecond time base value at the last accounting */
+	uint32_t last_ms;
+};
+
+/**
+ * @struct dac_waveform_init_param
+ * @brief DAC waveform initialization parameters
+ */
+struct dac_waveform_init_param {
+	/* Render the device frame writing a code into a channel */
+	void (*render_frame)(void *ctx, uint8_t chn, uint32_t code,
+			     uint8_t *frame);
+	/* Context passed to the render function */
+	void *ctx;
+	/* Size of one device frame (in bytes) */
+	uint32_t frame_size;
+	/* Size of one sample in the IIO buffer (1, 2 or 4 bytes) */
+	uint32_t sample_size;
+	/* Memory holding the rendered frames (may be the IIO buffer memory,
+	 * the frames being rendered in place over the samples) */
+	uint8_t *frames;
+	/* Size of the frame memory (in bytes) */
+	uint32_t frames_mem_size;
+	/* Optional time base used for update rate measurement */
+	uint32_t (*get_ticks)(void);
+	/* Frequency of the time base (in Hz) */
+	uint32_t ticks_per_sec;
+	/* Optional millisecond time base (wrap-arounds of the time base) */
+	uint32_t (*get_ms)(void);
+};
+
+/**
+ * @struct dac_waveform_desc
+ * @brief DAC waveform descriptor
+ */
+struct dac_waveform_desc {
+	void (*render_frame)(void *ctx, uint8_t chn, uint32_t code,
+			     uint8_t *frame);
+	void *ctx;
+	uint32_t frame_size;
+	uint32_t sample_size;
+	uint8_t *frames;
+	uint32_t frames_mem_size;
+	/* Rendered frames (one per channel per scan) */
+	uint32_t nb_frames;
+	/* Rendered scans (DAC updates per waveform cycle) */
+	uint32_t nb_scans;
+	/* Waveform rendered and ready for playback */
+	bool ready;
+	/* Achieved update rate */
+	struct dac_update_rate rate;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int32_t dac_waveform_init(struct dac_waveform_desc **desc,
+			  struct dac_waveform_init_param *param);
+int32_t dac_waveform_remove(struct dac_waveform_desc *desc);
+int32_t dac_waveform_render(struct dac_waveform_desc *desc, const void *data,
+			    uint32_t nb_bytes, const uint8_t *chns, uint8_t nb_chns);
+void dac_waveform_reset(struct dac_waveform_desc *desc);
+void dac_waveform_start(struct dac_waveform_desc *desc);
+void dac_waveform_cycle_done(struct dac_waveform_desc *desc);
+uint32_t dac_waveform_get_rate(struct dac_waveform_desc *desc);
+void dac_update_rate_start(struct dac_update_rate *rate,
+			   uint32_t units_per_update);
+void dac_update_rate_account(struct dac_update_rate *rate, uint32_t nb_units);
+uint32_t dac_update_rate_get(struct dac_update_rate *rate);
+
+#endif // _DAC_WAVEFORM_H_
@@ -0,0 +1,399 @@
+/***************************************************************************//**
+ * @file    decimation_stage.c
+ * @brief   On-device decimation stage for the interleaved ADC scan data
+ * @details The stage sits between the data acquisition and the IIO buffer.
+ *          Every active channel is filtered and decimated by a common ratio,
+ *          so that the data stays as interleaved scans of the active channels.
+ *          The samples are processed in place and are kept in the storage
+ *          format (size, sign and real bits) of the channel scan type.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include "decimation_stage.h"
+#include "sample_format.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************* Macros and Constants Definitions ***********************/
+/******************************************************************************/
+
+/* Number of FIR taps per unit of decimation ratio */
+#define DECIM_FIR_TAPS_PER_RATIO	8
+
+/* FIR cutoff frequency relative to the output Nyquist frequency */
+#define DECIM_FIR_CUTOFF_SCALE		0.8f
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Initialize the decimation stage.
+ * @param	desc[out] - Decimation stage descriptor
+ * @param	param[in] - Decimation stage init parameters
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t decim_stage_init(struct decim_stage_desc **desc,
+			 struct decim_stage_init_param *param)
+{
+	struct decim_stage_desc *decim;
+	uint8_t chn;
+	int32_t ret;
+
+	if (!desc || !param || !param->num_chns || !param->max_ratio
+	    || ((param->bytes_per_sample != 2) && (param->bytes_per_sample != 4))
+	    || !param->cic_order || (param->cic_order > DECIM_CIC_MAX_ORDER)) {
+		return -EINVAL;
+	}
+
+	decim = no_os_calloc(1, sizeof(*decim));
+	if (!decim) {
+		return -ENOMEM;
+	}
+
+	decim->num_chns = param->num_chns;
+	decim->bytes_per_sample = param->bytes_per_sample;
+	decim->max_ratio = param->max_ratio;
+	decim->cic_order = param->cic_order;
+
+	decim->chn_config = no_os_calloc(param->num_chns, sizeof(*decim->chn_config));
+	decim->state = no_os_calloc(param->num_chns, sizeof(*decim->state));
+	if (!decim->chn_config || !decim->state) {
+		ret = -ENOMEM;
+		goto err_free;
+	}
+
+	for (chn = 0; chn < param->num_chns; chn++) {
+		decim->state[chn].fir_state = no_os_calloc(DECIM_FIR_MAX_TAPS +
+					      param->max_ratio - 1, sizeof(q31_t));
+		decim->state[chn].fir_in = no_os_calloc(param->max_ratio, sizeof(q31_t));
+		if (!decim->state[chn].fir_state || !decim->state[chn].fir_in) {
+			ret = -ENOMEM;
+			goto err_free;
+		}
+	}
+
+	ret = decim_stage_set_ratio(decim, 1);
+	if (ret) {
+		goto err_free;
+	}
+
+	*desc = decim;
+
+	return 0;
+
+err_free:
+	decim_stage_remove(decim);
+	return ret;
+}
+
+/**
+ * @brief 	Free the resources allocated for the decimation stage.
+ * @param	desc[in] - Decimation stage descriptor
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t decim_stage_remove(struct decim_stage_desc *desc)
+{
+	uint8_t chn;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	if (desc->state) {
+		for (chn = 0; chn < desc->num_chns; chn++) {
+			no_os_free(desc->state[chn].fir_state);
+			no_os_free(desc->state[chn].fir_in);
+		}
+	}
+
+	no_os_free(desc->state);
+	no_os_free(desc->chn_config);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Design the windowed-sinc (Hamming) low pass FIR for the ratio.
+ * @param	desc[in] - Decimation stage descriptor
+ * @return 	None
+ */
+static void decim_stage_design_fir(struct decim_stage_desc *desc)
+{
+	float coeffs[DECIM_FIR_MAX_TAPS];
+	float cutoff = DECIM_FIR_CUTOFF_SCALE / (2.0f * desc->ratio);
+	float center = (desc->fir_taps - 1) / 2.0f;
+	float sum = 0;
+	float t;
+	uint16_t tap;
+
+	for (tap = 0; tap < desc->fir_taps; tap++) {
+		t = tap - center;
+		coeffs[tap] = (t == 0) ? 2.0f * cutoff :
+			      sinf(2.0f * PI * cutoff * t) / (PI * t);
+		coeffs[tap] *= 0.54f - 0.46f * cosf(2.0f * PI * tap /
+						    (desc->fir_taps - 1));
+		sum += coeffs[tap];
+	}
+
+	/* Normalize to unity DC gain */
+	for (tap = 0; tap < desc->fir_taps; tap++) {
+		desc->fir_coeffs[tap] = (q31_t)(coeffs[tap] / sum * 2147483647.0f);
+	}
+}
+
+/**
+ * @brief 	Set the decimation ratio.
+ * @param	desc[in] - Decimation stage descriptor
+ * @param	ratio[in] - Decimation ratio (1 to bypass the stage)
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	To be called while no data capture is in progress.
+ */
+int32_t decim_stage_set_ratio(struct decim_stage_desc *desc, uint16_t ratio)
+{
+	uint8_t order;
+
+	if (!desc || !ratio || (ratio > desc->max_ratio)) {
+		return -EINVAL;
+	}
+
+	desc->ratio = ratio;
+
+	desc->cic_gain = 1;
+	for (order = 0; order < desc->cic_order; order++) {
+		desc->cic_gain *= ratio;
+	}
+
+	if (ratio > 1) {
+		desc->fir_taps = no_os_min(DECIM_FIR_TAPS_PER_RATIO * ratio,
+					   DECIM_FIR_MAX_TAPS);
+		decim_stage_design_fir(desc);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Set the decimation configuration of a channel.
+ * @param	desc[in] - Decimation stage descriptor
+ * @param	chn[in] - Device channel
+ * @param	config[in] - Channel configuration
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t decim_stage_set_chn_config(struct decim_stage_desc *desc, uint8_t chn,
+				   struct decim_chn_config *config)
+{
+	if (!desc || !config || (chn >= desc->num_chns)
+	    || (config->filter >= DECIM_FILTER_MAX) || !config->realbits
+	    || (config->realbits > desc->bytes_per_sample * 8)) {
+		return -EINVAL;
+	}
+
+	desc->chn_config[chn] = *config;
+
+	return 0;
+}
+
+/**
+ * @brief 	Reset the filters of the active channels for a new capture.
+ * @param	desc[in] - Decimation stage descriptor
+ * @param	active_chns[in] - Active device channels (in scan order)
+ * @param	num_active[in] - Number of active channels
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t decim_stage_start(struct decim_stage_desc *desc,
+			  const uint8_t *active_chns, uint8_t num_active)
+{
+	struct decim_chn_state *state;
+	uint8_t chn;
+
+	if (!desc || !active_chns || (num_active > desc->num_chns)) {
+		return -EINVAL;
+	}
+
+	for (chn = 0; chn < num_active; chn++) {
+		if ((active_chns[chn] >= desc->num_chns)
+		    || !desc->chn_config[active_chns[chn]].realbits) {
+			return -EINVAL;
+		}
+
+		state = &desc->state[chn];
+		state->config = &desc->chn_config[active_chns[chn]];
+		state->acc = 0;
+		memset(state->integ, 0, sizeof(state->integ));
+		memset(state->comb, 0, sizeof(state->comb));
+
+		if ((desc->ratio > 1) && (state->config->filter == DECIM_FILTER_FIR)) {
+			if (arm_fir_decimate_init_q31(&state->fir, desc->fir_taps,
+						      desc->ratio, desc->fir_coeffs,
+						      state->fir_state, desc->ratio)
+			    != ARM_MATH_SUCCESS) {
+				return -EINVAL;
+			}
+		}
+	}
+
+	desc->num_active = num_active;
+	desc->scan_pos = 0;
+	desc->phase = 0;
+
+	return 0;
+}
+
+/**
+ * @brief 	Divide with rounding to nearest.
+ * @param	num[in] - Numerator
+ * @param	den[in] - Denominator (positive)
+ * @return 	Quotient
+ */
+static inline int64_t decim_div_round(int64_t num, int64_t den)
+{
+	return (num >= 0) ? (num + den / 2) / den : (num - den / 2) / den;
+}
+
+/**
+ * @brief 	Feed one sample to the filter of a channel.
+ * @param	desc[in] - Decimation stage descriptor
+ * @param	state[in] - Channel filter state
+ * @param	code[in] - Sample in storage format
+ * @param	out[out] - Decimated sample in storage format
+ * @return 	true if the decimation period is complete and out is updated
+ */
+static bool decim_chn_filter(struct decim_stage_desc *desc,
+			     struct decim_chn_state *state,
+			     uint32_t code, uint32_t *out)
+{
+	struct decim_chn_config *config = state->config;
+	bool last = (desc->phase == desc->ratio - 1);
+	uint8_t shift = 32 - config->realbits;
+	int64_t value;
+	uint64_t y;
+	uint64_t t;
+	q31_t q31_out;
+	uint8_t order;
+
+	if (config->is_signed) {
+		value = sample_sign_extend_code(code, config->realbits);
+	} else {
+		value = code & (0xFFFFFFFF >> shift);
+	}
+
+	switch (config->filter) {
+	case DECIM_FILTER_BOXCAR:
+		state->acc += value;
+		if (!last) {
+			return false;
+		}
+
+		value = decim_div_round(state->acc, desc->ratio);
+		state->acc = 0;
+		break;
+
+	case DECIM_FILTER_CIC:
+		/* Integrators run at the input rate (modular arithmetic) */
+		state->integ[0] += (uint64_t)value;
+		for (order = 1; order < desc->cic_order; order++) {
+			state->integ[order] += state->integ[order - 1];
+		}
+		if (!last) {
+			return false;
+		}
+
+		/* Combs run at the output rate */
+		y = state->integ[desc->cic_order - 1];
+		for (order = 0; order < desc->cic_order; order++) {
+			t = y;
+			y -= state->comb[order];
+			state->comb[order] = t;
+		}
+
+		value = decim_div_round((int64_t)y, (int64_t)desc->cic_gain);
+		break;
+
+	case DECIM_FILTER_FIR:
+	default:
+		/* Straight binary data is filtered as two's complement */
+		if (!config->is_signed) {
+			value = sample_offset_binary_code((uint32_t)value, config->realbits);
+		}
+
+		state->fir_in[desc->phase] = (q31_t)((uint32_t)value << shift);
+		if (!last) {
+			return false;
+		}
+
+		arm_fir_decimate_q31(&state->fir, state->fir_in, &q31_out, desc->ratio);
+		value = q31_out >> shift;
+
+		if (!config->is_signed) {
+			value = (value ^ (1LL << (config->realbits - 1))) &
+				(0xFFFFFFFF >> shift);
+		}
+		break;
+	}
+
+	*out = (uint32_t)value;
+
+	return true;
+}
+
+/**
+ * @brief 	Filter and decimate the interleaved scan data in place.
+ * @param	desc[in] - Decimation stage descriptor
+ * @param	data[in,out] - Samples of the active channels (interleaved scans)
+ * @param	samples[in] - Number of samples
+ * @return 	Number of decimated samples written at the start of data
+ * @note	The scan position and filter states are retained across calls, so
+ *			the data may be split at any sample boundary.
+ */
+uint32_t decim_stage_process(struct decim_stage_desc *desc, void *data,
+			     uint32_t samples)
+{
+	uint32_t in_idx;
+	uint32_t out_idx = 0;
+	uint32_t code;
+	uint32_t out;
+
+	if (!desc || !data || (desc->ratio <= 1) || !desc->num_active) {
+		return samples;
+	}
+
+	for (in_idx = 0; in_idx < samples; in_idx++) {
+		if (desc->bytes_per_sample == 2) {
+			code = ((uint16_t *)data)[in_idx];
+		} else {
+			code = ((uint32_t *)data)[in_idx];
+		}
+
+		if (decim_chn_filter(desc, &desc->state[desc->scan_pos], code, &out)) {
+			if (desc->bytes_per_sample == 2) {
+				((uint16_t *)data)[out_idx++] = (uint16_t)out;
+			} else {
+				((uint32_t *)data)[out_idx++] = out;
+			}
+		}
+
+		if (++desc->scan_pos == desc->num_active) {
+			desc->scan_pos = 0;
+			if (++desc->phase == desc->ratio) {
+				desc->phase = 0;
+			}
+		}
+	}
+
+	return out_idx;
+}
@@ -0,0 +1,141 @@
+/***************************************************************************//**
+ * @file    decimation_stage.h
+ * @brief   On-device decimation stage for the interleaved ADC scan data
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _DECIMATION_STAGE_H_
+#define _DECIMATION_STAGE_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "arm_math.h"
+
+/******************************************************************************/
+/************************ Macros/Constants ************************************/
+/******************************************************************************/
+
+/* Max order of the CIC decimation filter */
+#define DECIM_CIC_MAX_ORDER		4
+
+/* Max number of taps of the FIR decimation filter */
+#define DECIM_FIR_MAX_TAPS		128
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @enum decim_filter
+ * @brief Decimation filter types
+ */
+enum decim_filter {
+	/* Average of the samples in each decimation period */
+	DECIM_FILTER_BOXCAR,
+	/* Cascaded integrator-comb filter (normalized to unity DC gain) */
+	DECIM_FILTER_CIC,
+	/* Windowed-sinc low pass FIR filter (CMSIS-DSP) */
+	DECIM_FILTER_FIR,
+	DECIM_FILTER_MAX
+};
+
+/**
+ * @struct decim_chn_config
+ * @brief Decimation configuration of a channel
+ */
+struct decim_chn_config {
+	/* Decimation filter */
+	enum decim_filter filter;
+	/* Data is two's complement (true) or straight binary (false) */
+	bool is_signed;
+	/* Number of valid data bits (scan type real bits) */
+	uint8_t realbits;
+};
+
+/**
+ * @struct decim_stage_init_param
+ * @brief Decimation stage initialization parameters
+ */
+struct decim_stage_init_param {
+	/* Number of device channels */
+	uint8_t num_chns;
+	/* Bytes occupied by one sample in memory (2 or 4) */
+	uint8_t bytes_per_sample;
+	/* Max decimation ratio */
+	uint16_t max_ratio;
+	/* Order of the CIC filter */
+	uint8_t cic_order;
+};
+
+/**
+ * @struct decim_chn_state
+ * @brief Decimation filter state of an active channel
+ */
+struct decim_chn_state {
+	/* Channel configuration */
+	struct decim_chn_config *config;
+	/* Boxcar accumulator */
+	int64_t acc;
+	/* CIC integrator and comb stages */
+	uint64_t integ[DECIM_CIC_MAX_ORDER];
+	uint64_t comb[DECIM_CIC_MAX_ORDER];
+	/* FIR decimator instance and state */
+	arm_fir_decimate_instance_q31 fir;
+	q31_t *fir_state;
+	/* FIR input samples of the ongoing decimation period */
+	q31_t *fir_in;
+};
+
+/**
+ * @struct decim_stage_desc
+ * @brief Decimation stage descriptor
+ */
+struct decim_stage_desc {
+	uint8_t num_chns;
+	uint8_t bytes_per_sample;
+	uint16_t max_ratio;
+	uint8_t cic_order;
+	/* Decimation ratio (1 = bypass) */
+	uint16_t ratio;
+	/* Gain of the CIC filter (ratio ^ order) */
+	uint64_t cic_gain;
+	/* Number of FIR taps for the current ratio */
+	uint16_t fir_taps;
+	/* FIR coefficients for the current ratio */
+	q31_t fir_coeffs[DECIM_FIR_MAX_TAPS];
+	/* Configuration of all device channels */
+	struct decim_chn_config *chn_config;
+	/* Filter state of the active channels (in scan order) */
+	struct decim_chn_state *state;
+	/* Number of active channels */
+	uint8_t num_active;
+	/* Position of the next sample within the scan */
+	uint8_t scan_pos;
+	/* Position of the next scan within the decimation period */
+	uint16_t phase;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int32_t decim_stage_init(struct decim_stage_desc **desc,
+			 struct decim_stage_init_param *param);
+int32_t decim_stage_remove(struct decim_stage_desc *desc);
+int32_t decim_stage_set_ratio(struct decim_stage_desc *desc, uint16_t ratio);
+int32_t decim_stage_set_chn_config(struct decim_stage_desc *desc, uint8_t chn,
+				   struct decim_chn_config *config);
+int32_t decim_stage_start(struct decim_stage_desc *desc,
+			  const uint8_t *active_chns, uint8_t num_active);
+uint32_t decim_stage_process(struct decim_stage_desc *desc, void *data,
+			     uint32_t samples);
+
+#endif // _DECIMATION_STAGE_H_
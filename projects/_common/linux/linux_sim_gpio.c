@@ -0,0 +1,242 @@
+/***************************************************************************//**
+ * @file    linux_sim_gpio.c
+ * @brief   Simulated GPIOs for the host (Linux) builds.
+ * @details The pin levels are kept in memory, for the simulated devices to
+ *          sample the control lines driven by the driver (e.g. mode pins) and
+ *          to drive the status lines read back by the driver. The falling
+ *          edges driven on every pin are counted, so that a device model can
+ *          tell its conversion (sample) events apart.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include "no_os_alloc.h"
+#include "linux_sim_gpio.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct linux_sim_gpio_pin
+ * @brief Simulated pin state.
+ */
+struct linux_sim_gpio_pin {
+	/** Pin level */
+	uint8_t value;
+	/** Pin direction (NO_OS_GPIO_IN/OUT) */
+	uint8_t direction;
+	/** Number of falling edges driven on the pin */
+	uint32_t falling_edges;
+};
+
+/* Simulated pins */
+static struct linux_sim_gpio_pin linux_sim_gpio_pins[LINUX_SIM_GPIO_MAX_PINS];
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Get a simulated GPIO.
+ * @param 	desc[out] - GPIO descriptor.
+ * @param 	param[in] - GPIO initialization parameters.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_gpio_get(struct no_os_gpio_desc **desc,
+				  const struct no_os_gpio_init_param *param)
+{
+	struct no_os_gpio_desc *gpio_desc;
+
+	if (!desc || !param || param->number >= LINUX_SIM_GPIO_MAX_PINS) {
+		return -EINVAL;
+	}
+
+	gpio_desc = no_os_calloc(1, sizeof(*gpio_desc));
+	if (!gpio_desc) {
+		return -ENOMEM;
+	}
+
+	gpio_desc->port = param->port;
+	gpio_desc->number = param->number;
+	gpio_desc->pull = param->pull;
+	gpio_desc->extra = param->extra;
+
+	*desc = gpio_desc;
+
+	return 0;
+}
+
+/**
+ * @brief 	Get a simulated GPIO (optional).
+ * @param 	desc[out] - GPIO descriptor (NULL if not used).
+ * @param 	param[in] - GPIO initialization parameters (NULL if not used).
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_gpio_get_optional(struct no_os_gpio_desc **desc,
+		const struct no_os_gpio_init_param *param)
+{
+	if (!param) {
+		*desc = NULL;
+		return 0;
+	}
+
+	return linux_sim_gpio_get(desc, param);
+}
+
+/**
+ * @brief 	Free the resources allocated by linux_sim_gpio_get().
+ * @param 	desc[in] - GPIO descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_gpio_remove(struct no_os_gpio_desc *desc)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Set the pin level (driven by either side).
+ * @param 	number[in] - GPIO number.
+ * @param 	value[in] - Pin level.
+ * @return 	None
+ */
+void linux_sim_gpio_drive(uint32_t number, uint8_t value)
+{
+	struct linux_sim_gpio_pin *pin;
+
+	if (number >= LINUX_SIM_GPIO_MAX_PINS) {
+		return;
+	}
+
+	pin = &linux_sim_gpio_pins[number];
+	if (pin->value && !value) {
+		pin->falling_edges++;
+	}
+	pin->value = value ? NO_OS_GPIO_HIGH : NO_OS_GPIO_LOW;
+}
+
+/**
+ * @brief 	Configure the GPIO as input.
+ * @param 	desc[in] - GPIO descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_gpio_direction_input(struct no_os_gpio_desc *desc)
+{
+	linux_sim_gpio_pins[desc->number].direction = NO_OS_GPIO_IN;
+
+	return 0;
+}
+
+/**
+ * @brief 	Configure the GPIO as output.
+ * @param 	desc[in] - GPIO descriptor.
+ * @param 	value[in] - Initial pin level.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_gpio_direction_output(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	linux_sim_gpio_pins[desc->number].direction = NO_OS_GPIO_OUT;
+	linux_sim_gpio_drive(desc->number, value);
+
+	return 0;
+}
+
+/**
+ * @brief 	Get the GPIO direction.
+ * @param 	desc[in] - GPIO descriptor.
+ * @param 	direction[out] - NO_OS_GPIO_IN/OUT.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_gpio_get_direction(struct no_os_gpio_desc *desc,
+		uint8_t *direction)
+{
+	*direction = linux_sim_gpio_pins[desc->number].direction;
+
+	return 0;
+}
+
+/**
+ * @brief 	Set the GPIO level.
+ * @param 	desc[in] - GPIO descriptor.
+ * @param 	value[in] - Pin level.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_gpio_set_value(struct no_os_gpio_desc *desc,
+					uint8_t value)
+{
+	linux_sim_gpio_drive(desc->number, value);
+
+	return 0;
+}
+
+/**
+ * @brief 	Get the GPIO level.
+ * @param 	desc[in] - GPIO descriptor.
+ * @param 	value[out] - Pin level.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_gpio_get_value(struct no_os_gpio_desc *desc,
+					uint8_t *value)
+{
+	*value = linux_sim_gpio_pins[desc->number].value;
+
+	return 0;
+}
+
+/**
+ * @brief 	Get the pin level (device model side).
+ * @param 	number[in] - GPIO number.
+ * @return 	Pin level.
+ */
+uint8_t linux_sim_gpio_level(uint32_t number)
+{
+	if (number >= LINUX_SIM_GPIO_MAX_PINS) {
+		return NO_OS_GPIO_LOW;
+	}
+
+	return linux_sim_gpio_pins[number].value;
+}
+
+/**
+ * @brief 	Get the number of falling edges driven on the pin.
+ * @param 	number[in] - GPIO number.
+ * @return 	Number of falling edges (wraps around).
+ */
+uint32_t linux_sim_gpio_falling_edges(uint32_t number)
+{
+	if (number >= LINUX_SIM_GPIO_MAX_PINS) {
+		return 0;
+	}
+
+	return linux_sim_gpio_pins[number].falling_edges;
+}
+
+/**
+ * @brief Simulated GPIO platform ops.
+ */
+const struct no_os_gpio_platform_ops linux_sim_gpio_ops = {
+	.gpio_ops_get = &linux_sim_gpio_get,
+	.gpio_ops_get_optional = &linux_sim_gpio_get_optional,
+	.gpio_ops_remove = &linux_sim_gpio_remove,
+	.gpio_ops_direction_input = &linux_sim_gpio_direction_input,
+	.gpio_ops_direction_output = &linux_sim_gpio_direction_output,
+	.gpio_ops_get_direction = &linux_sim_gpio_get_direction,
+	.gpio_ops_set_value = &linux_sim_gpio_set_value,
+	.gpio_ops_get_value = &linux_sim_gpio_get_value
+};
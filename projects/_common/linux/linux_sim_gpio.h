@@ -1,8 +1,8 @@
 /***************************************************************************//**
-*   @file   stm32_tdm_support.h
-*   @brief  Header file for STM32 TDM-DMA Data Capture Wrapper file
+ * @file    linux_sim_gpio.h
+ * @brief   Simulated GPIOs for the host (Linux) builds.
 ********************************************************************************
-* Copyright (c) 2023 Analog Devices, Inc.
+* Copyright (c) 2026 Analog Devices, Inc.
 * All rights reserved.
 *
 * This software is proprietary to Analog Devices, Inc. and its licensors.
@@ -10,35 +10,33 @@
 * Analog Devices Software License Agreement.
 *******************************************************************************/
 
-#ifndef STM32_TDM_SUPPORT_H_
-#define STM32_TDM_SUPPORT_H_
+#ifndef _LINUX_SIM_GPIO_H_
+#define _LINUX_SIM_GPIO_H_
 
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
-
 #include <stdint.h>
-#include <stdbool.h>
-#include "no_os_circular_buffer.h"
-#include "iio_types.h"
-#include "no_os_tdm.h"
+#include "no_os_gpio.h"
 
 /******************************************************************************/
-/************************ Macros/Constants ************************************/
+/********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 
+/* Number of simulated GPIOs (gpio number) */
+#define LINUX_SIM_GPIO_MAX_PINS		64
+
 /******************************************************************************/
 /************************ Public Declarations *********************************/
 /******************************************************************************/
 
-extern volatile bool dma_buffer_full;
-extern uint8_t *dma_buff;
-int32_t start_tdm_dma_to_cb_transfer(struct no_os_tdm_desc *tdm_desc,
-				     struct iio_device_data *iio_dev_data, uint32_t buffer_size,
-				     uint8_t bytes_per_sample, uint32_t n_samples_tdm_read);
-void update_dma_buffer_overflow(void);
-int32_t end_tdm_dma_to_cb_transfer(struct no_os_tdm_desc *tdm_desc,
-				   struct iio_device_data *iio_dev_data,
-				   uint32_t buffer_size, uint8_t bytes_per_sample);
-
-#endif // STM32_TDM_SUPPORT_H_
+/**
+ * @brief Simulated GPIO platform ops.
+ */
+extern const struct no_os_gpio_platform_ops linux_sim_gpio_ops;
+
+uint8_t linux_sim_gpio_level(uint32_t number);
+uint32_t linux_sim_gpio_falling_edges(uint32_t number);
+void linux_sim_gpio_drive(uint32_t number, uint8_t value);
+
+#endif // _LINUX_SIM_GPIO_H_
@@ -0,0 +1,314 @@
+/***************************************************************************//**
+ * @file    linux_sim_irq.c
+ * @brief   Simulated interrupt controller for the host (Linux) builds.
+ * @details The interrupt lines are raised by the simulated peripherals (e.g.
+ *          the PWM trigger thread) and the registered callbacks are run in the
+ *          context of the raising thread. A process wide lock stands for the
+ *          CPU interrupt masking: the callbacks run with the lock held and
+ *          no_os_irq_global_disable() takes it, so the application critical
+ *          sections are not preempted by the simulated interrupts, as on the
+ *          target.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+/* Recursive mutex static initializer */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <errno.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "no_os_alloc.h"
+#include "linux_sim_irq.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct linux_sim_irq_line
+ * @brief Simulated interrupt line state.
+ */
+struct linux_sim_irq_line {
+	/** Registered callback */
+	struct no_os_callback_desc cb;
+	/** Callback registered */
+	bool registered;
+	/** Line enabled */
+	bool enabled;
+};
+
+/* Interrupt lines of the simulated controllers */
+static struct linux_sim_irq_line
+	linux_sim_irq_lines[LINUX_SIM_IRQ_MAX_CTRL][LINUX_SIM_IRQ_MAX_LINES];
+
+/* Interrupt masking lock (recursive, as the callbacks may mask the interrupts
+ * themselves) */
+static pthread_mutex_t linux_sim_irq_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/* Number of global disables pending on the calling thread */
+static __thread uint32_t linux_sim_irq_disable_depth;
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Initialize the simulated interrupt controller.
+ * @param 	desc[out] - Interrupt controller descriptor.
+ * @param 	param[in] - Interrupt controller initialization parameters.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int linux_sim_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+				   const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *irq_desc;
+
+	if (!desc || !param || param->irq_ctrl_id >= LINUX_SIM_IRQ_MAX_CTRL) {
+		return -EINVAL;
+	}
+
+	irq_desc = no_os_calloc(1, sizeof(*irq_desc));
+	if (!irq_desc) {
+		return -ENOMEM;
+	}
+
+	irq_desc->irq_ctrl_id = param->irq_ctrl_id;
+	irq_desc->extra = param->extra;
+
+	*desc = irq_desc;
+
+	return 0;
+}
+
+/**
+ * @brief 	Get the interrupt line of a controller.
+ * @param 	desc[in] - Interrupt controller descriptor.
+ * @param 	irq_id[in] - Interrupt line ID.
+ * @return 	Interrupt line, NULL if invalid.
+ */
+static struct linux_sim_irq_line *linux_sim_irq_get_line(
+	struct no_os_irq_ctrl_desc *desc,
+	uint32_t irq_id)
+{
+	if (!desc || irq_id >= LINUX_SIM_IRQ_MAX_LINES) {
+		return NULL;
+	}
+
+	return &linux_sim_irq_lines[desc->irq_ctrl_id][irq_id];
+}
+
+/**
+ * @brief 	Register the callback of an interrupt line.
+ * @param 	desc[in] - Interrupt controller descriptor.
+ * @param 	irq_id[in] - Interrupt line ID.
+ * @param 	cb[in] - Callback descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int linux_sim_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_sim_irq_line *line = linux_sim_irq_get_line(desc, irq_id);
+
+	if (!line || !cb) {
+		return -EINVAL;
+	}
+
+	pthread_mutex_lock(&linux_sim_irq_lock);
+	line->cb = *cb;
+	line->registered = true;
+	pthread_mutex_unlock(&linux_sim_irq_lock);
+
+	return 0;
+}
+
+/**
+ * @brief 	Unregister the callback of an interrupt line.
+ * @param 	desc[in] - Interrupt controller descriptor.
+ * @param 	irq_id[in] - Interrupt line ID.
+ * @param 	cb[in] - Callback descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int linux_sim_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_sim_irq_line *line = linux_sim_irq_get_line(desc, irq_id);
+
+	if (!line) {
+		return -EINVAL;
+	}
+
+	pthread_mutex_lock(&linux_sim_irq_lock);
+	line->registered = false;
+	line->enabled = false;
+	pthread_mutex_unlock(&linux_sim_irq_lock);
+
+	return 0;
+}
+
+/**
+ * @brief 	Unmask the simulated interrupts.
+ * @param 	desc[in] - Interrupt controller descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int linux_sim_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	if (linux_sim_irq_disable_depth) {
+		linux_sim_irq_disable_depth--;
+		pthread_mutex_unlock(&linux_sim_irq_lock);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Mask the simulated interrupts.
+ * @param 	desc[in] - Interrupt controller descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ * @note	Waits for the callback in progress (if any) to return.
+ */
+static int linux_sim_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	pthread_mutex_lock(&linux_sim_irq_lock);
+	linux_sim_irq_disable_depth++;
+
+	return 0;
+}
+
+/**
+ * @brief 	Set the trigger level of an interrupt line.
+ * @param 	desc[in] - Interrupt controller descriptor.
+ * @param 	irq_id[in] - Interrupt line ID.
+ * @param 	trig[in] - Trigger level.
+ * @return 	0 in case of success, negative error code otherwise.
+ * @note	The simulated lines are raised per event, the level is not used.
+ */
+static int linux_sim_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		enum no_os_irq_trig_level trig)
+{
+	return linux_sim_irq_get_line(desc, irq_id) ? 0 : -EINVAL;
+}
+
+/**
+ * @brief 	Enable an interrupt line.
+ * @param 	desc[in] - Interrupt controller descriptor.
+ * @param 	irq_id[in] - Interrupt line ID.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int linux_sim_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id)
+{
+	struct linux_sim_irq_line *line = linux_sim_irq_get_line(desc, irq_id);
+
+	if (!line) {
+		return -EINVAL;
+	}
+
+	line->enabled = true;
+
+	return 0;
+}
+
+/**
+ * @brief 	Disable an interrupt line.
+ * @param 	desc[in] - Interrupt controller descriptor.
+ * @param 	irq_id[in] - Interrupt line ID.
+ * @return 	0 in case of success, negative error code otherwise.
+ * @note	Returns once the callback in progress (if any) is done.
+ */
+static int linux_sim_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id)
+{
+	struct linux_sim_irq_line *line = linux_sim_irq_get_line(desc, irq_id);
+
+	if (!line) {
+		return -EINVAL;
+	}
+
+	pthread_mutex_lock(&linux_sim_irq_lock);
+	line->enabled = false;
+	pthread_mutex_unlock(&linux_sim_irq_lock);
+
+	return 0;
+}
+
+/**
+ * @brief 	Free the resources allocated by linux_sim_irq_ctrl_init().
+ * @param 	desc[in] - Interrupt controller descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int linux_sim_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	uint32_t irq_id;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	pthread_mutex_lock(&linux_sim_irq_lock);
+	for (irq_id = 0; irq_id < LINUX_SIM_IRQ_MAX_LINES; irq_id++) {
+		linux_sim_irq_lines[desc->irq_ctrl_id][irq_id].registered = false;
+		linux_sim_irq_lines[desc->irq_ctrl_id][irq_id].enabled = false;
+	}
+	pthread_mutex_unlock(&linux_sim_irq_lock);
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Raise an interrupt line (simulated peripheral event).
+ * @param 	irq_ctrl_id[in] - Interrupt controller ID.
+ * @param 	irq_id[in] - Interrupt line ID.
+ * @return 	0 in case of success (including a disabled line), negative error
+ *			code otherwise.
+ * @note	The callback runs in the calling thread, once the interrupts are
+ *			unmasked.
+ */
+int linux_sim_irq_raise(uint32_t irq_ctrl_id, uint32_t irq_id)
+{
+	struct linux_sim_irq_line *line;
+
+	if (irq_ctrl_id >= LINUX_SIM_IRQ_MAX_CTRL
+	    || irq_id >= LINUX_SIM_IRQ_MAX_LINES) {
+		return -EINVAL;
+	}
+
+	line = &linux_sim_irq_lines[irq_ctrl_id][irq_id];
+
+	pthread_mutex_lock(&linux_sim_irq_lock);
+	if (line->registered && line->enabled && line->cb.callback) {
+		line->cb.callback(line->cb.ctx);
+	}
+	pthread_mutex_unlock(&linux_sim_irq_lock);
+
+	return 0;
+}
+
+/**
+ * @brief Simulated interrupt controller platform ops.
+ */
+const struct no_os_irq_platform_ops linux_sim_irq_ops = {
+	.init = &linux_sim_irq_ctrl_init,
+	.register_callback = &linux_sim_irq_register_callback,
+	.unregister_callback = &linux_sim_irq_unregister_callback,
+	.global_enable = &linux_sim_irq_global_enable,
+	.global_disable = &linux_sim_irq_global_disable,
+	.trigger_level_set = &linux_sim_irq_trigger_level_set,
+	.enable = &linux_sim_irq_enable,
+	.disable = &linux_sim_irq_disable,
+	.remove = &linux_sim_irq_ctrl_remove
+};
@@ -1,8 +1,8 @@
 /***************************************************************************//**
-*   @file   stm32_tdm_support.h
-*   @brief  Header file for STM32 TDM-DMA Data Capture Wrapper file
+ * @file    linux_sim_irq.h
+ * @brief   Simulated interrupt controller for the host (Linux) builds.
 ********************************************************************************
-* Copyright (c) 2023 Analog Devices, Inc.
+* Copyright (c) 2026 Analog Devices, Inc.
 * All rights reserved.
 *
 * This software is proprietary to Analog Devices, Inc. and its licensors.
@@ -10,35 +10,34 @@
 * Analog Devices Software License Agreement.
 *******************************************************************************/
 
-#ifndef STM32_TDM_SUPPORT_H_
-#define STM32_TDM_SUPPORT_H_
+#ifndef _LINUX_SIM_IRQ_H_
+#define _LINUX_SIM_IRQ_H_
 
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
-
 #include <stdint.h>
-#include <stdbool.h>
-#include "no_os_circular_buffer.h"
-#include "iio_types.h"
-#include "no_os_tdm.h"
+#include "no_os_irq.h"
 
 /******************************************************************************/
-/************************ Macros/Constants ************************************/
+/********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 
+/* Number of simulated interrupt controllers (irq_ctrl_id) */
+#define LINUX_SIM_IRQ_MAX_CTRL		2
+
+/* Number of interrupt lines per controller (irq_id) */
+#define LINUX_SIM_IRQ_MAX_LINES		8
+
 /******************************************************************************/
 /************************ Public Declarations *********************************/
 /******************************************************************************/
 
-extern volatile bool dma_buffer_full;
-extern uint8_t *dma_buff;
-int32_t start_tdm_dma_to_cb_transfer(struct no_os_tdm_desc *tdm_desc,
-				     struct iio_device_data *iio_dev_data, uint32_t buffer_size,
-				     uint8_t bytes_per_sample, uint32_t n_samples_tdm_read);
-void update_dma_buffer_overflow(void);
-int32_t end_tdm_dma_to_cb_transfer(struct no_os_tdm_desc *tdm_desc,
-				   struct iio_device_data *iio_dev_data,
-				   uint32_t buffer_size, uint8_t bytes_per_sample);
-
-#endif // STM32_TDM_SUPPORT_H_
+/**
+ * @brief Simulated interrupt controller platform ops.
+ */
+extern const struct no_os_irq_platform_ops linux_sim_irq_ops;
+
+int linux_sim_irq_raise(uint32_t irq_ctrl_id, uint32_t irq_id);
+
+#endif // _LINUX_SIM_IRQ_H_
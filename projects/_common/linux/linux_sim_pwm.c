@@ -0,0 +1,287 @@
+/***************************************************************************//**
+ * @file    linux_sim_pwm.c
+ * @brief   Simulated PWM (conversion trigger) for the host (Linux) builds.
+ * @details A thread wakes up on the absolute period boundaries (monotonic
+ *          clock) and raises the simulated interrupt line tied to the PWM
+ *          output, standing for the conversion trigger of the target. When an
+ *          interrupt is still being handled at the next period boundary, the
+ *          elapsed periods are counted as missed instead of being queued, as
+ *          the edges would be lost on the target.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <time.h>
+#include "no_os_alloc.h"
+#include "linux_sim_irq.h"
+#include "linux_sim_pwm.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define LINUX_SIM_PWM_NSEC_PER_SEC	1000000000ULL
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Get the monotonic time.
+ * @return 	Time (nsec).
+ */
+static uint64_t linux_sim_pwm_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * LINUX_SIM_PWM_NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/**
+ * @brief 	PWM period thread.
+ * @param 	arg[in] - PWM descriptor.
+ * @return 	NULL
+ */
+static void *linux_sim_pwm_thread(void *arg)
+{
+	struct no_os_pwm_desc *desc = arg;
+	struct linux_sim_pwm_desc *sim_desc = desc->extra;
+	struct timespec ts;
+	uint64_t deadline = linux_sim_pwm_now();
+	uint64_t period;
+	uint64_t now;
+
+	while (sim_desc->running) {
+		period = desc->period_ns ? desc->period_ns : 1;
+		deadline += period;
+
+		ts.tv_sec = deadline / LINUX_SIM_PWM_NSEC_PER_SEC;
+		ts.tv_nsec = deadline % LINUX_SIM_PWM_NSEC_PER_SEC;
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+
+		(void)linux_sim_irq_raise(sim_desc->irq_ctrl_id, sim_desc->irq_id);
+		sim_desc->periods++;
+
+		/* Skip the period boundaries elapsed while the interrupt was handled */
+		now = linux_sim_pwm_now();
+		if (now > deadline + period) {
+			sim_desc->missed += (now - deadline) / period;
+			deadline += ((now - deadline) / period) * period;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief 	Initialize the simulated PWM.
+ * @param 	desc[out] - PWM descriptor.
+ * @param 	param[in] - PWM initialization parameters.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_pwm_init(struct no_os_pwm_desc **desc,
+				  const struct no_os_pwm_init_param *param)
+{
+	struct linux_sim_pwm_init_param *sim_param;
+	struct linux_sim_pwm_desc *sim_desc;
+	struct no_os_pwm_desc *pwm_desc;
+
+	if (!desc || !param || !param->extra || !param->period_ns) {
+		return -EINVAL;
+	}
+
+	sim_param = param->extra;
+
+	pwm_desc = no_os_calloc(1, sizeof(*pwm_desc));
+	if (!pwm_desc) {
+		return -ENOMEM;
+	}
+
+	sim_desc = no_os_calloc(1, sizeof(*sim_desc));
+	if (!sim_desc) {
+		no_os_free(pwm_desc);
+		return -ENOMEM;
+	}
+
+	sim_desc->irq_ctrl_id = sim_param->irq_ctrl_id;
+	sim_desc->irq_id = sim_param->irq_id;
+
+	pwm_desc->id = param->id;
+	pwm_desc->period_ns = param->period_ns;
+	pwm_desc->duty_cycle_ns = param->duty_cycle_ns;
+	pwm_desc->polarity = param->polarity;
+	pwm_desc->extra = sim_desc;
+
+	*desc = pwm_desc;
+
+	return 0;
+}
+
+/**
+ * @brief 	Start the PWM period thread.
+ * @param 	desc[in] - PWM descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_pwm_enable(struct no_os_pwm_desc *desc)
+{
+	struct linux_sim_pwm_desc *sim_desc;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	sim_desc = desc->extra;
+	if (sim_desc->running) {
+		return 0;
+	}
+
+	sim_desc->running = true;
+	if (pthread_create(&sim_desc->thread, NULL, linux_sim_pwm_thread, desc)) {
+		sim_desc->running = false;
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Stop the PWM period thread.
+ * @param 	desc[in] - PWM descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_pwm_disable(struct no_os_pwm_desc *desc)
+{
+	struct linux_sim_pwm_desc *sim_desc;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	sim_desc = desc->extra;
+	if (!sim_desc->running) {
+		return 0;
+	}
+
+	sim_desc->running = false;
+	pthread_join(sim_desc->thread, NULL);
+
+	return 0;
+}
+
+/**
+ * @brief 	Set the PWM period.
+ * @param 	desc[in] - PWM descriptor.
+ * @param 	period_ns[in] - Period (nsec).
+ * @return 	0 in case of success, negative error code otherwise.
+ * @note	Applies from the next period boundary.
+ */
+static int32_t linux_sim_pwm_set_period(struct no_os_pwm_desc *desc,
+					uint32_t period_ns)
+{
+	if (!desc || !period_ns) {
+		return -EINVAL;
+	}
+
+	desc->period_ns = period_ns;
+
+	return 0;
+}
+
+/**
+ * @brief 	Get the PWM period.
+ * @param 	desc[in] - PWM descriptor.
+ * @param 	period_ns[out] - Period (nsec).
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_pwm_get_period(struct no_os_pwm_desc *desc,
+					uint32_t *period_ns)
+{
+	if (!desc || !period_ns) {
+		return -EINVAL;
+	}
+
+	*period_ns = desc->period_ns;
+
+	return 0;
+}
+
+/**
+ * @brief 	Set the PWM duty cycle.
+ * @param 	desc[in] - PWM descriptor.
+ * @param 	duty_cycle_ns[in] - Duty cycle (nsec).
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_pwm_set_duty_cycle(struct no_os_pwm_desc *desc,
+		uint32_t duty_cycle_ns)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	desc->duty_cycle_ns = duty_cycle_ns;
+
+	return 0;
+}
+
+/**
+ * @brief 	Get the PWM duty cycle.
+ * @param 	desc[in] - PWM descriptor.
+ * @param 	duty_cycle_ns[out] - Duty cycle (nsec).
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_pwm_get_duty_cycle(struct no_os_pwm_desc *desc,
+		uint32_t *duty_cycle_ns)
+{
+	if (!desc || !duty_cycle_ns) {
+		return -EINVAL;
+	}
+
+	*duty_cycle_ns = desc->duty_cycle_ns;
+
+	return 0;
+}
+
+/**
+ * @brief 	Free the resources allocated by linux_sim_pwm_init().
+ * @param 	desc[in] - PWM descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_pwm_remove(struct no_os_pwm_desc *desc)
+{
+	int32_t ret;
+
+	ret = linux_sim_pwm_disable(desc);
+	if (ret) {
+		return ret;
+	}
+
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Simulated PWM platform ops.
+ */
+const struct no_os_pwm_platform_ops linux_sim_pwm_ops = {
+	.pwm_ops_init = &linux_sim_pwm_init,
+	.pwm_ops_enable = &linux_sim_pwm_enable,
+	.pwm_ops_disable = &linux_sim_pwm_disable,
+	.pwm_ops_set_period = &linux_sim_pwm_set_period,
+	.pwm_ops_get_period = &linux_sim_pwm_get_period,
+	.pwm_ops_set_duty_cycle = &linux_sim_pwm_set_duty_cycle,
+	.pwm_ops_get_duty_cycle = &linux_sim_pwm_get_duty_cycle,
+	.pwm_ops_remove = &linux_sim_pwm_remove
+};
@@ -0,0 +1,67 @@
+/***************************************************************************//**
+ * @file    linux_sim_pwm.h
+ * @brief   Simulated PWM (conversion trigger) for the host (Linux) builds.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _LINUX_SIM_PWM_H_
+#define _LINUX_SIM_PWM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "no_os_pwm.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct linux_sim_pwm_init_param
+ * @brief Simulated PWM specific initialization parameters.
+ */
+struct linux_sim_pwm_init_param {
+	/** Controller of the interrupt line raised every period */
+	uint32_t irq_ctrl_id;
+	/** Interrupt line raised every period (falling edge of the output) */
+	uint32_t irq_id;
+};
+
+/**
+ * @struct linux_sim_pwm_desc
+ * @brief Simulated PWM specific descriptor.
+ */
+struct linux_sim_pwm_desc {
+	/** Controller of the interrupt line raised every period */
+	uint32_t irq_ctrl_id;
+	/** Interrupt line raised every period */
+	uint32_t irq_id;
+	/** Period thread */
+	pthread_t thread;
+	/** Period thread running */
+	volatile bool running;
+	/** Number of periods elapsed */
+	volatile uint64_t periods;
+	/** Number of periods missed (previous interrupt still being handled) */
+	volatile uint64_t missed;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+/**
+ * @brief Simulated PWM platform ops.
+ */
+extern const struct no_os_pwm_platform_ops linux_sim_pwm_ops;
+
+#endif // _LINUX_SIM_PWM_H_
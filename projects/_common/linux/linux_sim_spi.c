@@ -0,0 +1,176 @@
+/***************************************************************************//**
+ * @file    linux_sim_spi.c
+ * @brief   Simulated SPI controller for the host (Linux) builds.
+ * @details The transfers are handed to the model of the device on the bus,
+ *          which answers them from its simulated registers and conversion
+ *          results.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_alloc.h"
+#include "linux_sim_spi.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Initialize the simulated SPI.
+ * @param 	desc[out] - SPI descriptor.
+ * @param 	param[in] - SPI initialization parameters.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_spi_init(struct no_os_spi_desc **desc,
+				  const struct no_os_spi_init_param *param)
+{
+	struct linux_sim_spi_init_param *sim_param;
+	struct linux_sim_spi_desc *sim_desc;
+	struct no_os_spi_desc *spi_desc;
+
+	if (!desc || !param || !param->extra) {
+		return -EINVAL;
+	}
+
+	sim_param = param->extra;
+	if (!sim_param->xfer) {
+		return -EINVAL;
+	}
+
+	spi_desc = no_os_calloc(1, sizeof(*spi_desc));
+	if (!spi_desc) {
+		return -ENOMEM;
+	}
+
+	sim_desc = no_os_calloc(1, sizeof(*sim_desc));
+	if (!sim_desc) {
+		no_os_free(spi_desc);
+		return -ENOMEM;
+	}
+
+	sim_desc->xfer = sim_param->xfer;
+	sim_desc->ctx = sim_param->ctx;
+
+	spi_desc->device_id = param->device_id;
+	spi_desc->max_speed_hz = param->max_speed_hz;
+	spi_desc->chip_select = param->chip_select;
+	spi_desc->mode = param->mode;
+	spi_desc->bit_order = param->bit_order;
+	spi_desc->extra = sim_desc;
+
+	*desc = spi_desc;
+
+	return 0;
+}
+
+/**
+ * @brief 	Write and read data over the simulated SPI.
+ * @param 	desc[in] - SPI descriptor.
+ * @param 	data[in,out] - Data to write, replaced by the data read.
+ * @param 	bytes_number[in] - Number of bytes.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_spi_write_and_read(struct no_os_spi_desc *desc,
+		uint8_t *data,
+		uint16_t bytes_number)
+{
+	struct linux_sim_spi_desc *sim_desc;
+
+	if (!desc || !data) {
+		return -EINVAL;
+	}
+
+	sim_desc = desc->extra;
+
+	return sim_desc->xfer(sim_desc->ctx, data, bytes_number);
+}
+
+/**
+ * @brief 	Run a list of SPI messages over the simulated SPI.
+ * @param 	desc[in] - SPI descriptor.
+ * @param 	msgs[in] - SPI messages.
+ * @param 	len[in] - Number of messages.
+ * @return 	0 in case of success, negative error code otherwise.
+ * @note	The messages are clocked through a scratch buffer, so the TX
+ *			buffers are never written to.
+ */
+static int32_t linux_sim_spi_transfer(struct no_os_spi_desc *desc,
+				      struct no_os_spi_msg *msgs,
+				      uint32_t len)
+{
+	struct linux_sim_spi_desc *sim_desc;
+	uint8_t scratch[64];
+	uint32_t offset;
+	uint32_t bytes;
+	uint32_t i;
+	int ret;
+
+	if (!desc || !msgs) {
+		return -EINVAL;
+	}
+
+	sim_desc = desc->extra;
+
+	for (i = 0; i < len; i++) {
+		for (offset = 0; offset < msgs[i].bytes_number; offset += bytes) {
+			bytes = msgs[i].bytes_number - offset;
+			if (bytes > sizeof(scratch)) {
+				bytes = sizeof(scratch);
+			}
+
+			if (msgs[i].tx_buff) {
+				memcpy(scratch, msgs[i].tx_buff + offset, bytes);
+			} else {
+				memset(scratch, 0, bytes);
+			}
+
+			ret = sim_desc->xfer(sim_desc->ctx, scratch, bytes);
+			if (ret) {
+				return ret;
+			}
+
+			if (msgs[i].rx_buff) {
+				memcpy(msgs[i].rx_buff + offset, scratch, bytes);
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Free the resources allocated by linux_sim_spi_init().
+ * @param 	desc[in] - SPI descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_spi_remove(struct no_os_spi_desc *desc)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Simulated SPI platform ops.
+ */
+const struct no_os_spi_platform_ops linux_sim_spi_ops = {
+	.init = &linux_sim_spi_init,
+	.write_and_read = &linux_sim_spi_write_and_read,
+	.transfer = &linux_sim_spi_transfer,
+	.remove = &linux_sim_spi_remove
+};
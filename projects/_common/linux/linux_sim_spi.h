@@ -1,8 +1,8 @@
 /***************************************************************************//**
-*   @file   stm32_tdm_support.h
-*   @brief  Header file for STM32 TDM-DMA Data Capture Wrapper file
+ * @file    linux_sim_spi.h
+ * @brief   Simulated SPI controller for the host (Linux) builds.
 ********************************************************************************
-* Copyright (c) 2023, 2025 Analog Devices, Inc.
+* Copyright (c) 2026 Analog Devices, Inc.
 * All rights reserved.
 *
 * This software is proprietary to Analog Devices, Inc. and its licensors.
@@ -10,35 +10,49 @@
 * Analog Devices Software License Agreement.
 *******************************************************************************/
 
-#ifndef STM32_TDM_SUPPORT_H_
-#define STM32_TDM_SUPPORT_H_
+#ifndef _LINUX_SIM_SPI_H_
+#define _LINUX_SIM_SPI_H_
 
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
-
 #include <stdint.h>
-#include <stdbool.h>
-#include "no_os_circular_buffer.h"
-#include "iio_types.h"
-#include "no_os_tdm.h"
+#include "no_os_spi.h"
 
 /******************************************************************************/
-/************************ Macros/Constants ************************************/
+/********************** Variables and User Defined Data Types *****************/
 /******************************************************************************/
 
+/**
+ * @struct linux_sim_spi_init_param
+ * @brief Simulated SPI specific initialization parameters.
+ */
+struct linux_sim_spi_init_param {
+	/** Device model transfer (chip select asserted for the whole transfer),
+	 *  the received bytes replace the sent ones in data */
+	int (*xfer)(void *ctx, uint8_t *data, uint32_t len);
+	/** Device model context */
+	void *ctx;
+};
+
+/**
+ * @struct linux_sim_spi_desc
+ * @brief Simulated SPI specific descriptor.
+ */
+struct linux_sim_spi_desc {
+	/** Device model transfer */
+	int (*xfer)(void *ctx, uint8_t *data, uint32_t len);
+	/** Device model context */
+	void *ctx;
+};
+
 /******************************************************************************/
 /************************ Public Declarations *********************************/
 /******************************************************************************/
 
-extern volatile bool dma_buffer_full;
-extern uint8_t *dma_buff;
-int32_t start_tdm_dma_to_cb_transfer(struct no_os_tdm_desc *tdm_desc,
-				     struct iio_device_data *iio_dev_data, uint32_t buffer_size,
-				     uint8_t bytes_per_sample, uint32_t n_samples_tdm_read);
-void update_dma_buffer_overflow(void);
-int32_t end_tdm_dma_to_cb_transfer(struct no_os_tdm_desc *tdm_desc,
-				   struct iio_device_data *iio_dev_data,
-				   uint32_t buffer_size, uint8_t bytes_per_sample);
-
-#endif // STM32_TDM_SUPPORT_H_
+/**
+ * @brief Simulated SPI platform ops.
+ */
+extern const struct no_os_spi_platform_ops linux_sim_spi_ops;
+
+#endif // _LINUX_SIM_SPI_H_
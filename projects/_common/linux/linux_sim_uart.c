@@ -0,0 +1,282 @@
+/***************************************************************************//**
+ * @file    linux_sim_uart.c
+ * @brief   Socket backed UART for the host (Linux) builds.
+ * @details The IIO UART of the firmware is served over a TCP socket on the
+ *          loopback interface, so the IIOD serial protocol is reached the
+ *          same way as on the target VCOM (one client at a time; a new client
+ *          is accepted once the previous one disconnects). The console UART
+ *          (port 0) goes to the process stdout.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "no_os_alloc.h"
+#include "linux_sim_uart.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Time to wait for the client data on a read with none pending (msec), keeps
+ * the polling IIO loop from spinning the CPU */
+#define LINUX_SIM_UART_POLL_TIMEOUT_MS		1
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Initialize the socket backed UART.
+ * @param 	desc[out] - UART descriptor.
+ * @param 	param[in] - UART initialization parameters.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_uart_init(struct no_os_uart_desc **desc,
+				   struct no_os_uart_init_param *param)
+{
+	struct linux_sim_uart_init_param *sim_param;
+	struct linux_sim_uart_desc *sim_desc;
+	struct no_os_uart_desc *uart_desc;
+	struct sockaddr_in addr = { 0 };
+	int opt = 1;
+	int ret;
+
+	if (!desc || !param || !param->extra) {
+		return -EINVAL;
+	}
+
+	sim_param = param->extra;
+
+	uart_desc = no_os_calloc(1, sizeof(*uart_desc));
+	if (!uart_desc) {
+		return -ENOMEM;
+	}
+
+	sim_desc = no_os_calloc(1, sizeof(*sim_desc));
+	if (!sim_desc) {
+		ret = -ENOMEM;
+		goto err_sim_desc;
+	}
+
+	sim_desc->port = sim_param->port;
+	sim_desc->listen_fd = -1;
+	sim_desc->client_fd = -1;
+
+	if (sim_desc->port) {
+		sim_desc->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+		if (sim_desc->listen_fd < 0) {
+			ret = -errno;
+			goto err_socket;
+		}
+
+		(void)setsockopt(sim_desc->listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt,
+				 sizeof(opt));
+
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(sim_desc->port);
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		if (bind(sim_desc->listen_fd, (struct sockaddr *)&addr, sizeof(addr))
+		    || listen(sim_desc->listen_fd, 1)) {
+			ret = -errno;
+			goto err_listen;
+		}
+
+		printf("IIO UART listening on 127.0.0.1:%u\n", sim_desc->port);
+		fflush(stdout);
+	}
+
+	uart_desc->device_id = param->device_id;
+	uart_desc->baud_rate = param->baud_rate;
+	uart_desc->extra = sim_desc;
+
+	*desc = uart_desc;
+
+	return 0;
+
+err_listen:
+	close(sim_desc->listen_fd);
+err_socket:
+	no_os_free(sim_desc);
+err_sim_desc:
+	no_os_free(uart_desc);
+
+	return ret;
+}
+
+/**
+ * @brief 	Drop the connected client.
+ * @param 	sim_desc[in] - Socket backed UART descriptor.
+ * @return 	None
+ */
+static void linux_sim_uart_disconnect(struct linux_sim_uart_desc *sim_desc)
+{
+	close(sim_desc->client_fd);
+	sim_desc->client_fd = -1;
+}
+
+/**
+ * @brief 	Accept a client if none is connected.
+ * @param 	sim_desc[in] - Socket backed UART descriptor.
+ * @param 	timeout_ms[in] - Time to wait for a client (msec).
+ * @return 	true if a client is connected, false otherwise.
+ */
+static bool linux_sim_uart_connected(struct linux_sim_uart_desc *sim_desc,
+				     int timeout_ms)
+{
+	struct pollfd pfd = { .fd = sim_desc->listen_fd, .events = POLLIN };
+	int opt = 1;
+
+	if (sim_desc->client_fd >= 0) {
+		return true;
+	}
+
+	if (poll(&pfd, 1, timeout_ms) <= 0) {
+		return false;
+	}
+
+	sim_desc->client_fd = accept(sim_desc->listen_fd, NULL, NULL);
+	if (sim_desc->client_fd < 0) {
+		return false;
+	}
+
+	/* The IIOD responses are short, send them without coalescing delay */
+	(void)setsockopt(sim_desc->client_fd, IPPROTO_TCP, TCP_NODELAY, &opt,
+			 sizeof(opt));
+
+	return true;
+}
+
+/**
+ * @brief 	Read the data received from the client.
+ * @param 	desc[in] - UART descriptor.
+ * @param 	data[out] - Received data.
+ * @param 	bytes_number[in] - Maximum number of bytes to read.
+ * @return 	Number of bytes read (0 if none pending) in case of success,
+ *			negative error code otherwise.
+ */
+static int32_t linux_sim_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
+				   uint32_t bytes_number)
+{
+	struct linux_sim_uart_desc *sim_desc = desc->extra;
+	struct pollfd pfd;
+	ssize_t len;
+
+	if (!sim_desc->port
+	    || !linux_sim_uart_connected(sim_desc, LINUX_SIM_UART_POLL_TIMEOUT_MS)) {
+		return 0;
+	}
+
+	pfd.fd = sim_desc->client_fd;
+	pfd.events = POLLIN;
+	if (poll(&pfd, 1, LINUX_SIM_UART_POLL_TIMEOUT_MS) <= 0) {
+		return 0;
+	}
+
+	len = recv(sim_desc->client_fd, data, bytes_number, 0);
+	if (len <= 0) {
+		/* Client gone, wait for the next one */
+		linux_sim_uart_disconnect(sim_desc);
+		return 0;
+	}
+
+	return len;
+}
+
+/**
+ * @brief 	Send data to the client.
+ * @param 	desc[in] - UART descriptor.
+ * @param 	data[in] - Data to send.
+ * @param 	bytes_number[in] - Number of bytes to send.
+ * @return 	Number of bytes sent in case of success, negative error code
+ *			otherwise.
+ * @note	Blocks until all the data is handed to the socket (back-pressure
+ *			of the client, as with the VCOM endpoint).
+ */
+static int32_t linux_sim_uart_write(struct no_os_uart_desc *desc,
+				    const uint8_t *data,
+				    uint32_t bytes_number)
+{
+	struct linux_sim_uart_desc *sim_desc = desc->extra;
+	uint32_t sent = 0;
+	ssize_t len;
+
+	if (!sim_desc->port) {
+		len = fwrite(data, 1, bytes_number, stdout);
+		fflush(stdout);
+		return len;
+	}
+
+	if (sim_desc->client_fd < 0) {
+		return -ENOTCONN;
+	}
+
+	while (sent < bytes_number) {
+		len = send(sim_desc->client_fd, data + sent, bytes_number - sent,
+			   MSG_NOSIGNAL);
+		if (len < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			linux_sim_uart_disconnect(sim_desc);
+			return -EIO;
+		}
+		sent += len;
+	}
+
+	return bytes_number;
+}
+
+/**
+ * @brief 	Free the resources allocated by linux_sim_uart_init().
+ * @param 	desc[in] - UART descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_sim_uart_remove(struct no_os_uart_desc *desc)
+{
+	struct linux_sim_uart_desc *sim_desc;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	sim_desc = desc->extra;
+	if (sim_desc->client_fd >= 0) {
+		close(sim_desc->client_fd);
+	}
+	if (sim_desc->listen_fd >= 0) {
+		close(sim_desc->listen_fd);
+	}
+
+	no_os_free(sim_desc);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Socket backed UART platform ops.
+ */
+const struct no_os_uart_platform_ops linux_sim_uart_ops = {
+	.init = &linux_sim_uart_init,
+	.read = &linux_sim_uart_read,
+	.write = &linux_sim_uart_write,
+	.remove = &linux_sim_uart_remove
+};
@@ -0,0 +1,65 @@
+/***************************************************************************//**
+ * @file    linux_sim_uart.h
+ * @brief   Socket backed UART for the host (Linux) builds.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _LINUX_SIM_UART_H_
+#define _LINUX_SIM_UART_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "no_os_uart.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Default TCP port of the IIO UART */
+#define LINUX_SIM_UART_DEFAULT_PORT		30431
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct linux_sim_uart_init_param
+ * @brief Socket backed UART specific initialization parameters.
+ */
+struct linux_sim_uart_init_param {
+	/** TCP port listened to on the loopback interface, 0 for the process
+	 *  stdout (console) */
+	uint16_t port;
+};
+
+/**
+ * @struct linux_sim_uart_desc
+ * @brief Socket backed UART specific descriptor.
+ */
+struct linux_sim_uart_desc {
+	/** TCP port (0 for stdout) */
+	uint16_t port;
+	/** Listening socket */
+	int listen_fd;
+	/** Connected client socket (-1 if none) */
+	int client_fd;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+/**
+ * @brief Socket backed UART platform ops.
+ */
+extern const struct no_os_uart_platform_ops linux_sim_uart_ops;
+
+#endif // _LINUX_SIM_UART_H_
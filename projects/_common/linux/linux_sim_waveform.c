@@ -0,0 +1,95 @@
+/***************************************************************************//**
+ * @file    linux_sim_waveform.c
+ * @brief   Deterministic test waveforms for the simulated converters.
+ * @details The waveforms are computed from the sample index alone (no state
+ *          and no time base), so a capture of the simulated converter is the
+ *          same from run to run whatever the host load and can be checked
+ *          sample by sample on the host side.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <math.h>
+#include "linux_sim_waveform.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define LINUX_SIM_WAVEFORM_2PI		6.283185307179586
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Get the waveform value of a sample.
+ * @param 	wf[in] - Waveform.
+ * @param 	sample[in] - Sample index.
+ * @return 	Waveform value.
+ */
+double linux_sim_waveform_value(const struct linux_sim_waveform *wf,
+				uint64_t sample)
+{
+	double cycles;
+	double phase;
+	double value;
+
+	if (!wf->sample_rate) {
+		return wf->offset;
+	}
+
+	/* Phase in [0, 1), with the whole cycles dropped ahead of the floating
+	 * point conversion to keep the resolution over long captures */
+	cycles = (double)sample * wf->frequency / wf->sample_rate;
+	phase = cycles - floor(cycles);
+
+	switch (wf->type) {
+	case LINUX_SIM_WAVEFORM_RAMP:
+		value = 2.0 * phase - 1.0;
+		break;
+	case LINUX_SIM_WAVEFORM_SQUARE:
+		value = (phase < 0.5) ? 1.0 : -1.0;
+		break;
+	case LINUX_SIM_WAVEFORM_SINE:
+	default:
+		value = sin(LINUX_SIM_WAVEFORM_2PI * phase);
+		break;
+	}
+
+	return wf->offset + wf->amplitude * value;
+}
+
+/**
+ * @brief 	Get the waveform value of a sample as a converter code.
+ * @param 	wf[in] - Waveform (in code units).
+ * @param 	sample[in] - Sample index.
+ * @param 	code_min[in] - Minimum code (clipping).
+ * @param 	code_max[in] - Maximum code (clipping).
+ * @return 	Converter code.
+ */
+int32_t linux_sim_waveform_code(const struct linux_sim_waveform *wf,
+				uint64_t sample,
+				int32_t code_min,
+				int32_t code_max)
+{
+	double value = round(linux_sim_waveform_value(wf, sample));
+
+	if (value < code_min) {
+		return code_min;
+	}
+
+	if (value > code_max) {
+		return code_max;
+	}
+
+	return (int32_t)value;
+}
@@ -0,0 +1,62 @@
+/***************************************************************************//**
+ * @file    linux_sim_waveform.h
+ * @brief   Deterministic test waveforms for the simulated converters.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _LINUX_SIM_WAVEFORM_H_
+#define _LINUX_SIM_WAVEFORM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @enum linux_sim_waveform_type
+ * @brief Waveform shapes.
+ */
+enum linux_sim_waveform_type {
+	LINUX_SIM_WAVEFORM_SINE,
+	LINUX_SIM_WAVEFORM_RAMP,
+	LINUX_SIM_WAVEFORM_SQUARE,
+};
+
+/**
+ * @struct linux_sim_waveform
+ * @brief Waveform definition.
+ */
+struct linux_sim_waveform {
+	/** Shape */
+	enum linux_sim_waveform_type type;
+	/** Sample rate (ODR) the waveform is sampled at (Hz) */
+	double sample_rate;
+	/** Waveform frequency (Hz) */
+	double frequency;
+	/** Peak amplitude (same unit as the output) */
+	double amplitude;
+	/** Offset (same unit as the output) */
+	double offset;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+double linux_sim_waveform_value(const struct linux_sim_waveform *wf,
+				uint64_t sample);
+int32_t linux_sim_waveform_code(const struct linux_sim_waveform *wf,
+				uint64_t sample,
+				int32_t code_min,
+				int32_t code_max);
+
+#endif // _LINUX_SIM_WAVEFORM_H_
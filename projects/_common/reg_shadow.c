@@ -0,0 +1,521 @@
+/***************************************************************************//**
+ * @file    reg_shadow.c
+ * @brief   Device register shadow with dirty tracking and burst transfers
+ * @details The shadow holds an image of the device register map with a valid
+ *          and a dirty bit per byte. Register reads are served from the
+ *          image once the register is valid, register writes only update the
+ *          image (and are dropped when the value does not change) until the
+ *          flush, which writes every dirty run of bytes in one streaming
+ *          transfer. Register lists are read back the same way, abutting
+ *          registers being merged into one transfer. Bursts longer than the
+ *          burst buffer are split on register boundaries.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include "reg_shadow.h"
+#include "no_os_alloc.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Bitmap words for a map of n bytes */
+#define REG_SHADOW_BITMAP_WORDS(n)	(((n) + 31) / 32)
+
+/* Max register size (in bytes) */
+#define REG_SHADOW_MAX_REG_SIZE		4
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+static inline bool reg_shadow_test(const uint32_t *bitmap, uint16_t pos)
+{
+	return (bitmap[pos / 32] >> (pos % 32)) & 1;
+}
+
+static inline void reg_shadow_set(uint32_t *bitmap, uint16_t pos)
+{
+	bitmap[pos / 32] |= (1u << (pos % 32));
+}
+
+static inline void reg_shadow_clear(uint32_t *bitmap, uint16_t pos)
+{
+	bitmap[pos / 32] &= ~(1u << (pos % 32));
+}
+
+/**
+ * @brief 	Get the address of the nth byte streamed from an address.
+ * @param	desc[in] - Register shadow descriptor
+ * @param	addr[in] - Stream start address
+ * @param	n[in] - Byte index in the stream
+ * @return 	Byte address
+ */
+static inline uint16_t reg_shadow_stream_addr(struct reg_shadow_desc *desc,
+		uint16_t addr, uint16_t n)
+{
+	return desc->descending ? addr - n : addr + n;
+}
+
+/**
+ * @brief 	Get the byte range covered by a register.
+ * @param	desc[in] - Register shadow descriptor
+ * @param	addr[in] - Register address
+ * @param	size[in] - Register size (in bytes)
+ * @param	lo[out] - Lowest byte address
+ * @param	hi[out] - Highest byte address
+ * @return 	0 in case of success, negative error code otherwise
+ */
+static int32_t reg_shadow_span(struct reg_shadow_desc *desc, uint16_t addr,
+			       uint8_t size, uint16_t *lo, uint16_t *hi)
+{
+	if (!size || size > REG_SHADOW_MAX_REG_SIZE || addr >= desc->map_size) {
+		return -EINVAL;
+	}
+
+	if (desc->descending) {
+		if (addr < size - 1) {
+			return -EINVAL;
+		}
+		*lo = addr - (size - 1);
+		*hi = addr;
+	} else {
+		if (addr + size > desc->map_size) {
+			return -EINVAL;
+		}
+		*lo = addr;
+		*hi = addr + (size - 1);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Transfer a range of bytes between the image and the device.
+ * @param	desc[in] - Register shadow descriptor
+ * @param	lo[in] - Lowest byte address
+ * @param	hi[in] - Highest byte address
+ * @param	write[in] - Write the image to the device (read it otherwise)
+ * @return 	0 in case of success, negative error code otherwise
+ */
+static int32_t reg_shadow_burst(struct reg_shadow_desc *desc, uint16_t lo,
+				uint16_t hi, bool write)
+{
+	uint8_t *data = desc->burst + desc->headroom;
+	uint16_t len = hi - lo + 1;
+	uint16_t start;
+	uint16_t n;
+	uint16_t i;
+	int32_t ret;
+
+	start = desc->descending ? hi : lo;
+
+	while (len) {
+		n = len;
+		if (n > desc->max_burst) {
+			/* Stop the burst ahead of a register when possible */
+			n = desc->max_burst;
+			while (n > 1 && !reg_shadow_test(desc->first,
+							 reg_shadow_stream_addr(desc, start, n))) {
+				n--;
+			}
+			if (n == 1) {
+				n = desc->max_burst;
+			}
+		}
+
+		if (write) {
+			for (i = 0; i < n; i++) {
+				data[i] = desc->image[reg_shadow_stream_addr(desc, start, i)];
+			}
+
+			ret = desc->ops->write(desc->ctx, start, data, n);
+			if (ret) {
+				return ret;
+			}
+		} else {
+			ret = desc->ops->read(desc->ctx, start, data, n);
+			if (ret) {
+				return ret;
+			}
+
+			for (i = 0; i < n; i++) {
+				desc->image[reg_shadow_stream_addr(desc, start, i)] = data[i];
+				reg_shadow_set(desc->valid, reg_shadow_stream_addr(desc, start, i));
+			}
+		}
+
+		desc->stats.transfers++;
+		start = reg_shadow_stream_addr(desc, start, n);
+		len -= n;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Initialize the register shadow.
+ * @param	desc[out] - Register shadow descriptor
+ * @param	param[in] - Register shadow init parameters
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	The image starts invalid, reg_shadow_load() fetches the registers
+ *			of interest.
+ */
+int32_t reg_shadow_init(struct reg_shadow_desc **desc,
+			const struct reg_shadow_init_param *param)
+{
+	struct reg_shadow_desc *shadow;
+	uint16_t words;
+
+	if (!desc || !param || !param->ops || !param->ops->read
+	    || !param->ops->write || !param->map_size || !param->max_burst) {
+		return -EINVAL;
+	}
+
+	shadow = no_os_calloc(1, sizeof(*shadow));
+	if (!shadow) {
+		return -ENOMEM;
+	}
+
+	words = REG_SHADOW_BITMAP_WORDS(param->map_size);
+
+	shadow->image = no_os_calloc(param->map_size, sizeof(*shadow->image));
+	shadow->valid = no_os_calloc(words, sizeof(*shadow->valid));
+	shadow->dirty = no_os_calloc(words, sizeof(*shadow->dirty));
+	shadow->first = no_os_calloc(words, sizeof(*shadow->first));
+	shadow->burst = no_os_calloc(param->headroom + param->max_burst,
+				     sizeof(*shadow->burst));
+	if (!shadow->image || !shadow->valid || !shadow->dirty || !shadow->first
+	    || !shadow->burst) {
+		reg_shadow_remove(shadow);
+		return -ENOMEM;
+	}
+
+	shadow->map_size = param->map_size;
+	shadow->descending = param->descending;
+	shadow->max_burst = param->max_burst;
+	shadow->headroom = param->headroom;
+	shadow->ops = param->ops;
+	shadow->ctx = param->ctx;
+
+	*desc = shadow;
+
+	return 0;
+}
+
+/**
+ * @brief 	Free the resources allocated for the register shadow.
+ * @param	desc[in] - Register shadow descriptor
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t reg_shadow_remove(struct reg_shadow_desc *desc)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	no_os_free(desc->burst);
+	no_os_free(desc->first);
+	no_os_free(desc->dirty);
+	no_os_free(desc->valid);
+	no_os_free(desc->image);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Read a list of registers from the device into the image.
+ * @param	desc[in] - Register shadow descriptor
+ * @param	regs[in] - Registers, in increasing address order
+ * @param	nb_regs[in] - Number of registers
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	Abutting registers are read in one transfer. Pending writes to
+ *			these registers are discarded.
+ */
+int32_t reg_shadow_load(struct reg_shadow_desc *desc,
+			const struct reg_shadow_reg *regs, uint16_t nb_regs)
+{
+	uint16_t run_lo = 0;
+	uint16_t run_hi = 0;
+	bool in_run = false;
+	uint16_t lo;
+	uint16_t hi;
+	uint16_t i;
+	uint16_t pos;
+	int32_t ret;
+
+	if (!desc || (!regs && nb_regs)) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < nb_regs; i++) {
+		ret = reg_shadow_span(desc, regs[i].addr, regs[i].size, &lo, &hi);
+		if (ret) {
+			return ret;
+		}
+
+		reg_shadow_set(desc->first, regs[i].addr);
+		for (pos = lo; pos <= hi; pos++) {
+			reg_shadow_clear(desc->dirty, pos);
+		}
+
+		if (in_run && lo == run_hi + 1) {
+			run_hi = hi;
+			continue;
+		}
+
+		if (in_run) {
+			ret = reg_shadow_burst(desc, run_lo, run_hi, false);
+			if (ret) {
+				return ret;
+			}
+		}
+
+		run_lo = lo;
+		run_hi = hi;
+		in_run = true;
+	}
+
+	if (in_run) {
+		ret = reg_shadow_burst(desc, run_lo, run_hi, false);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	desc->stats.reg_accesses += nb_regs;
+
+	return 0;
+}
+
+/**
+ * @brief 	Read a register, from the image when it is valid.
+ * @param	desc[in] - Register shadow descriptor
+ * @param	addr[in] - Register address
+ * @param	size[in] - Register size (in bytes)
+ * @param	val[out] - Register value
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t reg_shadow_read(struct reg_shadow_desc *desc, uint16_t addr,
+			uint8_t size, uint32_t *val)
+{
+	uint16_t lo;
+	uint16_t hi;
+	uint16_t pos;
+	uint8_t i;
+	int32_t ret;
+
+	if (!desc || !val) {
+		return -EINVAL;
+	}
+
+	ret = reg_shadow_span(desc, addr, size, &lo, &hi);
+	if (ret) {
+		return ret;
+	}
+
+	reg_shadow_set(desc->first, addr);
+
+	for (pos = lo; pos <= hi; pos++) {
+		if (!reg_shadow_test(desc->valid, pos)) {
+			ret = reg_shadow_burst(desc, lo, hi, false);
+			if (ret) {
+				return ret;
+			}
+			break;
+		}
+	}
+
+	*val = 0;
+	for (i = 0; i < size; i++) {
+		*val = (*val << 8) | desc->image[reg_shadow_stream_addr(desc, addr, i)];
+	}
+
+	desc->stats.reg_accesses++;
+
+	return 0;
+}
+
+/**
+ * @brief 	Write a register into the image.
+ * @param	desc[in] - Register shadow descriptor
+ * @param	addr[in] - Register address
+ * @param	size[in] - Register size (in bytes)
+ * @param	val[in] - Register value
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	The register is only marked dirty when its value changes (or is
+ *			not known), reg_shadow_flush() writes it to the device.
+ */
+int32_t reg_shadow_write(struct reg_shadow_desc *desc, uint16_t addr,
+			 uint8_t size, uint32_t val)
+{
+	uint16_t pos;
+	uint16_t lo;
+	uint16_t hi;
+	bool changed = false;
+	uint8_t byte;
+	uint8_t i;
+	int32_t ret;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	ret = reg_shadow_span(desc, addr, size, &lo, &hi);
+	if (ret) {
+		return ret;
+	}
+
+	reg_shadow_set(desc->first, addr);
+
+	for (i = 0; i < size; i++) {
+		pos = reg_shadow_stream_addr(desc, addr, i);
+		byte = (uint8_t)(val >> (8 * (size - 1 - i)));
+
+		if (!reg_shadow_test(desc->valid, pos) || desc->image[pos] != byte) {
+			desc->image[pos] = byte;
+			changed = true;
+		}
+	}
+
+	/* The whole register is written back, never a part of it */
+	if (changed) {
+		for (pos = lo; pos <= hi; pos++) {
+			reg_shadow_set(desc->valid, pos);
+			reg_shadow_set(desc->dirty, pos);
+		}
+	}
+
+	desc->stats.reg_accesses++;
+
+	return 0;
+}
+
+/**
+ * @brief 	Write the dirty registers to the device.
+ * @param	desc[in] - Register shadow descriptor
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	Every run of dirty bytes is written in one transfer.
+ */
+int32_t reg_shadow_flush(struct reg_shadow_desc *desc)
+{
+	uint16_t lo;
+	uint16_t hi;
+	uint16_t pos;
+	int32_t ret;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	for (lo = 0; lo < desc->map_size; lo = hi + 1) {
+		if (!reg_shadow_test(desc->dirty, lo)) {
+			hi = lo;
+			continue;
+		}
+
+		hi = lo;
+		while (hi + 1 < desc->map_size && reg_shadow_test(desc->dirty, hi + 1)) {
+			hi++;
+		}
+
+		ret = reg_shadow_burst(desc, lo, hi, true);
+		if (ret) {
+			return ret;
+		}
+
+		for (pos = lo; pos <= hi; pos++) {
+			reg_shadow_clear(desc->dirty, pos);
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Mark a list of registers to be written back from the image.
+ * @param	desc[in] - Register shadow descriptor
+ * @param	regs[in] - Registers
+ * @param	nb_regs[in] - Number of registers
+ * @note	Used to restore the device registers (after a reset or a power
+ *			down) with the next reg_shadow_flush(). Registers not valid in
+ *			the image are ignored.
+ */
+void reg_shadow_mark_dirty(struct reg_shadow_desc *desc,
+			   const struct reg_shadow_reg *regs, uint16_t nb_regs)
+{
+	uint16_t pos;
+	uint16_t lo;
+	uint16_t hi;
+	uint16_t i;
+
+	if (!desc || !regs) {
+		return;
+	}
+
+	for (i = 0; i < nb_regs; i++) {
+		if (reg_shadow_span(desc, regs[i].addr, regs[i].size, &lo, &hi)) {
+			continue;
+		}
+
+		for (pos = lo; pos <= hi; pos++) {
+			if (reg_shadow_test(desc->valid, pos)) {
+				reg_shadow_set(desc->dirty, pos);
+			}
+		}
+	}
+
+	desc->stats.reg_accesses += nb_regs;
+}
+
+/**
+ * @brief 	Drop the image of a register changed by the device itself.
+ * @param	desc[in] - Register shadow descriptor
+ * @param	addr[in] - Register address
+ * @param	size[in] - Register size (in bytes)
+ */
+void reg_shadow_invalidate(struct reg_shadow_desc *desc, uint16_t addr,
+			   uint8_t size)
+{
+	uint16_t pos;
+	uint16_t lo;
+	uint16_t hi;
+
+	if (!desc || reg_shadow_span(desc, addr, size, &lo, &hi)) {
+		return;
+	}
+
+	for (pos = lo; pos <= hi; pos++) {
+		reg_shadow_clear(desc->valid, pos);
+		reg_shadow_clear(desc->dirty, pos);
+	}
+}
+
+/**
+ * @brief 	Get the transfer accounting.
+ * @param	desc[in] - Register shadow descriptor
+ * @param	stats[out] - Register accesses and transfers since the init
+ * @note	reg_accesses - transfers is the number of device transfers saved
+ *			over per register accesses. The counts wrap around, the
+ *			difference of two snapshots accounting for a period.
+ */
+void reg_shadow_get_stats(struct reg_shadow_desc *desc,
+			  struct reg_shadow_stats *stats)
+{
+	if (!desc || !stats) {
+		return;
+	}
+
+	*stats = desc->stats;
+}
@@ -0,0 +1,125 @@
+/***************************************************************************//**
+ * @file    reg_shadow.h
+ * @brief   Device register shadow with dirty tracking and burst transfers
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _REG_SHADOW_H_
+#define _REG_SHADOW_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct reg_shadow_reg
+ * @brief Register of the device map
+ * @note The register is accessed from its address, its bytes (MSB first)
+ *       being at the following addresses in the streaming direction.
+ */
+struct reg_shadow_reg {
+	/* Register (access) address */
+	uint16_t addr;
+	/* Register size (in bytes, 1 to 4) */
+	uint8_t size;
+};
+
+/**
+ * @struct reg_shadow_ops
+ * @brief Device burst transfers
+ * @note The data buffers are preceded by the headroom requested at init, free
+ *       for the instruction phase of the transfer.
+ */
+struct reg_shadow_ops {
+	/* Stream len bytes from the device, starting at addr */
+	int32_t (*read)(void *ctx, uint16_t addr, uint8_t *data, uint16_t len);
+	/* Stream len bytes to the device, starting at addr */
+	int32_t (*write)(void *ctx, uint16_t addr, uint8_t *data, uint16_t len);
+};
+
+/**
+ * @struct reg_shadow_stats
+ * @brief Transfer accounting
+ */
+struct reg_shadow_stats {
+	/* Register accesses requested (transfers of a per register access) */
+	uint32_t reg_accesses;
+	/* Device transfers issued */
+	uint32_t transfers;
+};
+
+/**
+ * @struct reg_shadow_init_param
+ * @brief Register shadow init parameters
+ */
+struct reg_shadow_init_param {
+	/* Size of the device map (highest register byte address + 1) */
+	uint16_t map_size;
+	/* Addresses decrement while streaming */
+	bool descending;
+	/* Max data bytes per burst */
+	uint16_t max_burst;
+	/* Free bytes needed ahead of the burst data (instruction phase) */
+	uint8_t headroom;
+	/* Device burst transfers and their context */
+	const struct reg_shadow_ops *ops;
+	void *ctx;
+};
+
+/**
+ * @struct reg_shadow_desc
+ * @brief Register shadow descriptor
+ */
+struct reg_shadow_desc {
+	/* Device map image, indexed by byte address */
+	uint8_t *image;
+	/* Bytes holding the device value (bitmap) */
+	uint32_t *valid;
+	/* Bytes to be written to the device (bitmap) */
+	uint32_t *dirty;
+	/* Bytes starting a register in the streaming direction (bitmap) */
+	uint32_t *first;
+	/* Burst buffer (headroom followed by max_burst bytes) */
+	uint8_t *burst;
+	uint16_t map_size;
+	bool descending;
+	uint16_t max_burst;
+	uint8_t headroom;
+	const struct reg_shadow_ops *ops;
+	void *ctx;
+	struct reg_shadow_stats stats;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int32_t reg_shadow_init(struct reg_shadow_desc **desc,
+			const struct reg_shadow_init_param *param);
+int32_t reg_shadow_remove(struct reg_shadow_desc *desc);
+int32_t reg_shadow_load(struct reg_shadow_desc *desc,
+			const struct reg_shadow_reg *regs, uint16_t nb_regs);
+int32_t reg_shadow_read(struct reg_shadow_desc *desc, uint16_t addr,
+			uint8_t size, uint32_t *val);
+int32_t reg_shadow_write(struct reg_shadow_desc *desc, uint16_t addr,
+			 uint8_t size, uint32_t val);
+int32_t reg_shadow_flush(struct reg_shadow_desc *desc);
+void reg_shadow_mark_dirty(struct reg_shadow_desc *desc,
+			   const struct reg_shadow_reg *regs, uint16_t nb_regs);
+void reg_shadow_invalidate(struct reg_shadow_desc *desc, uint16_t addr,
+			   uint8_t size);
+void reg_shadow_get_stats(struct reg_shadow_desc *desc,
+			  struct reg_shadow_stats *stats);
+
+#endif /* _REG_SHADOW_H_ */
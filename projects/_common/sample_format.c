@@ -0,0 +1,257 @@
+/***************************************************************************//**
+ * @file    sample_format.c
+ * @brief   ADC sample format conversion (unpack/pack/sign extend/offset binary)
+ * @details The big endian words received over SPI are unpacked into 32-bit
+ *          samples a full machine word at a time. The byte swap of each word
+ *          maps onto a single REV instruction on Cortex-M and the unaligned
+ *          word loads onto single LDR instructions (Cortex-M3 and above).
+ *          18/20-bit codes are received as 24-bit words and 16-bit codes as
+ *          16-bit words, so the unpacked samples can then be sign extended or
+ *          converted from offset binary to the actual resolution.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "sample_format.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Load a big endian 32-bit word from unaligned memory
+ * @param	src[in] - Memory to load from
+ * @return	Loaded word
+ */
+static inline uint32_t sample_load_be32(const uint8_t *src)
+{
+	uint32_t word;
+
+	memcpy(&word, src, sizeof(word));
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	return word;
+#else
+	return __builtin_bswap32(word);
+#endif
+}
+
+/**
+ * @brief 	Unpack big endian 16-bit words into 32-bit samples
+ * @param	src[in] - Packed words
+ * @param	dst[out] - Unpacked samples
+ * @param	samples[in] - Number of samples to unpack
+ * @return	None
+ * @note	The packed words may be placed at the tail of the destination
+ *			memory (src = (uint8_t *)dst + 2 * samples) to unpack in place.
+ */
+void sample_unpack_be16(const uint8_t *src, uint32_t *dst, uint32_t samples)
+{
+	uint32_t w0;
+
+	for (; samples >= 2; samples -= 2) {
+		w0 = sample_load_be32(src);
+		src += 4;
+
+		dst[0] = w0 >> 16;
+		dst[1] = w0 & 0xFFFF;
+		dst += 2;
+	}
+
+	if (samples) {
+		*dst = ((uint32_t)src[0] << 8) | src[1];
+	}
+}
+
+/**
+ * @brief 	Unpack big endian 24-bit words into 32-bit samples
+ * @param	src[in] - Packed words
+ * @param	dst[out] - Unpacked samples
+ * @param	samples[in] - Number of samples to unpack
+ * @return	None
+ * @note	Four samples (three 32-bit words) are unpacked per iteration. The
+ *			packed words may be placed at the tail of the destination memory
+ *			(src = (uint8_t *)dst + samples) to unpack in place, since every
+ *			iteration then writes behind the data still to be read.
+ */
+void sample_unpack_be24(const uint8_t *src, uint32_t *dst, uint32_t samples)
+{
+	uint32_t w0, w1, w2;
+
+	for (; samples >= 4; samples -= 4) {
+		w0 = sample_load_be32(&src[0]);
+		w1 = sample_load_be32(&src[4]);
+		w2 = sample_load_be32(&src[8]);
+		src += 12;
+
+		dst[0] = w0 >> 8;
+		dst[1] = ((w0 & 0xFF) << 16) | (w1 >> 16);
+		dst[2] = ((w1 & 0xFFFF) << 8) | (w2 >> 24);
+		dst[3] = w2 & 0xFFFFFF;
+		dst += 4;
+	}
+
+	for (; samples; samples--) {
+		*dst++ = ((uint32_t)src[0] << 16) | ((uint32_t)src[1] << 8) | src[2];
+		src += 3;
+	}
+}
+
+/**
+ * @brief 	Unpack big endian 32-bit words into 32-bit samples
+ * @param	src[in] - Packed words
+ * @param	dst[out] - Unpacked samples
+ * @param	samples[in] - Number of samples to unpack
+ * @return	None
+ * @note	The packed words may share memory with the samples (src = dst).
+ */
+void sample_unpack_be32(const uint8_t *src, uint32_t *dst, uint32_t samples)
+{
+	for (; samples; samples--) {
+		*dst++ = sample_load_be32(src);
+		src += 4;
+	}
+}
+
+/**
+ * @brief 	Unpack big endian words of given size into 32-bit samples
+ * @param	src[in] - Packed words
+ * @param	dst[out] - Unpacked samples
+ * @param	samples[in] - Number of samples to unpack
+ * @param	bytes_per_word[in] - Size of the packed words (2, 3 or 4 bytes)
+ * @return	0 in case of success, negative error code otherwise
+ */
+int32_t sample_unpack_be(const uint8_t *src, uint32_t *dst, uint32_t samples,
+			 uint8_t bytes_per_word)
+{
+	if (!src || !dst) {
+		return -EINVAL;
+	}
+
+	switch (bytes_per_word) {
+	case 2:
+		sample_unpack_be16(src, dst, samples);
+		break;
+
+	case 3:
+		sample_unpack_be24(src, dst, samples);
+		break;
+
+	case 4:
+		sample_unpack_be32(src, dst, samples);
+		break;
+
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Pack 32-bit samples tightly into a little endian bit stream
+ * @param	src[in] - Samples
+ * @param	dst[out] - Packed stream
+ * @param	samples[in] - Number of samples to pack
+ * @param	bits[in] - Packed size of a sample (16, 20 or 24 bits)
+ * @return	Number of bytes written, negative error code otherwise
+ * @details	Sample n takes the bits [n * bits, (n + 1) * bits) of the stream,
+ *			LSB first, so the 16 and 24-bit packings are plain little endian
+ *			words and two 20-bit samples take 5 bytes. The samples are
+ *			truncated to the packed size, the last byte is zero padded.
+ */
+int32_t sample_pack_le(const uint32_t *src, uint8_t *dst, uint32_t samples,
+		       uint8_t bits)
+{
+	uint8_t *start = dst;
+	uint32_t s0;
+	uint32_t s1;
+
+	if (!src || !dst) {
+		return -EINVAL;
+	}
+
+	switch (bits) {
+	case 16:
+		for (; samples; samples--) {
+			s0 = *src++;
+			*dst++ = s0;
+			*dst++ = s0 >> 8;
+		}
+		break;
+
+	case 20:
+		for (; samples >= 2; samples -= 2) {
+			s0 = *src++ & 0xFFFFF;
+			s1 = *src++ & 0xFFFFF;
+			*dst++ = s0;
+			*dst++ = s0 >> 8;
+			*dst++ = (s0 >> 16) | (s1 << 4);
+			*dst++ = s1 >> 4;
+			*dst++ = s1 >> 12;
+		}
+
+		if (samples) {
+			s0 = *src & 0xFFFFF;
+			*dst++ = s0;
+			*dst++ = s0 >> 8;
+			*dst++ = s0 >> 16;
+		}
+		break;
+
+	case 24:
+		for (; samples; samples--) {
+			s0 = *src++;
+			*dst++ = s0;
+			*dst++ = s0 >> 8;
+			*dst++ = s0 >> 16;
+		}
+		break;
+
+	default:
+		return -EINVAL;
+	}
+
+	return dst - start;
+}
+
+/**
+ * @brief 	Sign extend the two's complement samples in place
+ * @param	data[in,out] - Samples
+ * @param	samples[in] - Number of samples
+ * @param	bits[in] - Resolution of the samples (1 to 32)
+ * @return	None
+ */
+void sample_sign_extend(uint32_t *data, uint32_t samples, uint8_t bits)
+{
+	for (; samples; samples--) {
+		*data = (uint32_t)sample_sign_extend_code(*data, bits);
+		data++;
+	}
+}
+
+/**
+ * @brief 	Convert the offset binary samples to two's complement in place
+ * @param	data[in,out] - Samples
+ * @param	samples[in] - Number of samples
+ * @param	bits[in] - Resolution of the samples (1 to 32)
+ * @return	None
+ */
+void sample_offset_binary_to_twos(uint32_t *data, uint32_t samples,
+				  uint8_t bits)
+{
+	for (; samples; samples--) {
+		*data = (uint32_t)sample_offset_binary_code(*data, bits);
+		data++;
+	}
+}
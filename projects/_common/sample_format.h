@@ -0,0 +1,60 @@
+/***************************************************************************//**
+ * @file    sample_format.h
+ * @brief   ADC sample format conversion (unpack/pack/sign extend/offset binary)
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _SAMPLE_FORMAT_H_
+#define _SAMPLE_FORMAT_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Sign extend a two's complement code to 32-bit
+ * @param	code[in] - ADC code
+ * @param	bits[in] - Resolution of the code (1 to 32)
+ * @return	Sign extended code
+ */
+static inline int32_t sample_sign_extend_code(uint32_t code, uint8_t bits)
+{
+	uint8_t shift = 32 - bits;
+
+	return (int32_t)(code << shift) >> shift;
+}
+
+/**
+ * @brief 	Convert an offset binary code to a 32-bit two's complement code
+ * @param	code[in] - ADC code
+ * @param	bits[in] - Resolution of the code (1 to 32)
+ * @return	Two's complement code
+ */
+static inline int32_t sample_offset_binary_code(uint32_t code, uint8_t bits)
+{
+	return sample_sign_extend_code(code ^ (1UL << (bits - 1)), bits);
+}
+
+void sample_unpack_be16(const uint8_t *src, uint32_t *dst, uint32_t samples);
+void sample_unpack_be24(const uint8_t *src, uint32_t *dst, uint32_t samples);
+void sample_unpack_be32(const uint8_t *src, uint32_t *dst, uint32_t samples);
+int32_t sample_unpack_be(const uint8_t *src, uint32_t *dst, uint32_t samples,
+			 uint8_t bytes_per_word);
+int32_t sample_pack_le(const uint32_t *src, uint8_t *dst, uint32_t samples,
+		       uint8_t bits);
+void sample_sign_extend(uint32_t *data, uint32_t samples, uint8_t bits);
+void sample_offset_binary_to_twos(uint32_t *data, uint32_t samples,
+				  uint8_t bits);
+
+#endif /* _SAMPLE_FORMAT_H_ */
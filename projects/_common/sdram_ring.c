@@ -0,0 +1,266 @@
+/***************************************************************************//**
+ * @file    sdram_ring.c
+ * @brief   Streaming producer/consumer ring over the IIO capture buffer
+ * @details The ADC producer (trigger handler or DMA completion) writes into
+ *          the ring while the IIO transport drains it from the main loop.
+ *          Instead of letting the circular buffer overwrite data the host
+ *          has not read yet, the producer drops the incoming data when the
+ *          ring is full and accounts for it, keeping the level, high water
+ *          mark and overrun telemetry of the stream. Producers with a
+ *          circular DMA writing in place are not held off, the overwritten
+ *          data is only counted (see sdram_ring_block_done()).
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include "sdram_ring.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Get the number of bytes written to the ring and not yet drained.
+ * @param	cb[in] - Circular buffer used as the ring
+ * @return 	Number of unread bytes
+ */
+static uint32_t sdram_ring_level(struct no_os_circular_buffer *cb)
+{
+	uint64_t written = (uint64_t)cb->write.spin_count * cb->size + cb->write.idx;
+	uint64_t read = (uint64_t)cb->read.spin_count * cb->size + cb->read.idx;
+
+	if (read >= written) {
+		return 0;
+	}
+
+	return (uint32_t)(written - read);
+}
+
+/**
+ * @brief 	Update the high water mark with the current ring level.
+ * @param	desc[in] - Streaming ring descriptor
+ * @return 	None
+ */
+static void sdram_ring_track_level(struct sdram_ring_desc *desc)
+{
+	uint32_t level = sdram_ring_level(desc->cb);
+
+	if (level > desc->high_water_mark) {
+		desc->high_water_mark = level;
+	}
+}
+
+/**
+ * @brief 	Account data dropped because the ring was full.
+ * @param	desc[in] - Streaming ring descriptor
+ * @param	len[in] - Number of bytes dropped
+ * @return 	None
+ * @note	Consecutive drops are counted as a single overrun event.
+ */
+static void sdram_ring_drop(struct sdram_ring_desc *desc, uint32_t len)
+{
+	if (!desc->dropping) {
+		desc->overruns++;
+		desc->dropping = true;
+	}
+
+	desc->dropped_bytes += len;
+}
+
+/**
+ * @brief 	Initialize the streaming ring descriptor.
+ * @param	desc[out] - Streaming ring descriptor
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t sdram_ring_init(struct sdram_ring_desc **desc)
+{
+	struct sdram_ring_desc *ring;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	ring = no_os_calloc(1, sizeof(*ring));
+	if (!ring) {
+		return -ENOMEM;
+	}
+
+	*desc = ring;
+
+	return 0;
+}
+
+/**
+ * @brief 	Free the resources allocated for the streaming ring.
+ * @param	desc[in] - Streaming ring descriptor
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t sdram_ring_remove(struct sdram_ring_desc *desc)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Start streaming into the circular buffer.
+ * @param	desc[in] - Streaming ring descriptor
+ * @param	cb[in] - Circular buffer used as the ring (the IIO buffer)
+ * @param	capacity[in] - Memory available to the circular buffer (in bytes)
+ * @param	unit_size[in] - Size of the data unit, e.g. bytes per scan
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	The circular buffer size is trimmed down to a multiple of the unit
+ *          size, so that a unit never straddles the ring wrap-around. The
+ *          telemetry is reset.
+ */
+int32_t sdram_ring_start(struct sdram_ring_desc *desc,
+			 struct no_os_circular_buffer *cb,
+			 uint32_t capacity,
+			 uint32_t unit_size)
+{
+	if (!desc || !cb || !unit_size || (capacity < unit_size)) {
+		return -EINVAL;
+	}
+
+	cb->size = (capacity / unit_size) * unit_size;
+
+	desc->cb = cb;
+	desc->unit_size = unit_size;
+	desc->unit_offset = 0;
+	desc->dropping = false;
+	desc->high_water_mark = 0;
+	desc->overruns = 0;
+	desc->dropped_bytes = 0;
+
+	return 0;
+}
+
+/**
+ * @brief 	Write data into the ring (producer side).
+ * @param	desc[in] - Streaming ring descriptor
+ * @param	data[in] - Data to be written
+ * @param	len[in] - Number of bytes to be written
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	The room is checked at every unit boundary, for the whole unit (or
+ *          the whole write, if larger). When the ring is full the data is
+ *          dropped up to the next unit boundary and accounted as an overrun,
+ *          which is not reported as an error.
+ */
+int32_t sdram_ring_write(struct sdram_ring_desc *desc,
+			 const void *data,
+			 uint32_t len)
+{
+	int32_t ret;
+
+	if (!desc || !desc->cb || !data) {
+		return -EINVAL;
+	}
+
+	if (!desc->unit_offset) {
+		if (desc->cb->size - sdram_ring_level(desc->cb) <
+		    no_os_max(len, desc->unit_size)) {
+			sdram_ring_drop(desc, 0);
+		} else {
+			desc->dropping = false;
+		}
+	}
+
+	desc->unit_offset = (desc->unit_offset + len) % desc->unit_size;
+
+	if (desc->dropping) {
+		sdram_ring_drop(desc, len);
+		return 0;
+	}
+
+	ret = no_os_cb_write(desc->cb, (void *)data, len);
+	if (ret) {
+		return ret;
+	}
+
+	sdram_ring_track_level(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Account a block written in place into the ring by DMA.
+ * @param	desc[in] - Streaming ring descriptor
+ * @param	len[in] - Number of bytes in the block
+ * @return 	None
+ * @note	To be called from the DMA completion, before the block is
+ *          committed to the circular buffer. This only accounts the block:
+ *          a DMA in circular mode cannot be held off, so any unread data the
+ *          block landed on is already overwritten and is counted as dropped,
+ *          not prevented.
+ */
+void sdram_ring_block_done(struct sdram_ring_desc *desc, uint32_t len)
+{
+	uint32_t level;
+
+	if (!desc || !desc->cb) {
+		return;
+	}
+
+	level = sdram_ring_level(desc->cb);
+	if (level + len > desc->cb->size) {
+		sdram_ring_drop(desc, level + len - desc->cb->size);
+	} else {
+		desc->dropping = false;
+	}
+
+	desc->high_water_mark = no_os_max(desc->high_water_mark,
+					  no_os_min(level + len, desc->cb->size));
+}
+
+/**
+ * @brief 	Account a block the producer had to drop because the ring was full.
+ * @param	desc[in] - Streaming ring descriptor
+ * @param	len[in] - Number of bytes in the block
+ * @return 	None
+ * @note	For producers which steer their DMA away from unread data by
+ *          themselves, e.g. into a scratch area.
+ */
+void sdram_ring_block_dropped(struct sdram_ring_desc *desc, uint32_t len)
+{
+	if (!desc || !desc->cb) {
+		return;
+	}
+
+	sdram_ring_drop(desc, len);
+}
+
+/**
+ * @brief 	Get the streaming ring telemetry.
+ * @param	desc[in] - Streaming ring descriptor
+ * @param	stats[out] - Ring telemetry
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t sdram_ring_get_stats(struct sdram_ring_desc *desc,
+			     struct sdram_ring_stats *stats)
+{
+	if (!desc || !stats) {
+		return -EINVAL;
+	}
+
+	stats->level = desc->cb ? sdram_ring_level(desc->cb) : 0;
+	stats->high_water_mark = desc->high_water_mark;
+	stats->overruns = desc->overruns;
+	stats->dropped_bytes = desc->dropped_bytes;
+
+	return 0;
+}
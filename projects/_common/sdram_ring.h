@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ * @file    sdram_ring.h
+ * @brief   Streaming producer/consumer ring over the IIO capture buffer
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _SDRAM_RING_H_
+#define _SDRAM_RING_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_circular_buffer.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct sdram_ring_stats
+ * @brief Streaming ring telemetry
+ */
+struct sdram_ring_stats {
+	/* Bytes written and not yet drained by the IIO transport */
+	uint32_t level;
+	/* Highest level reached since the start of streaming */
+	uint32_t high_water_mark;
+	/* Number of overrun events (the ring was full when data arrived) */
+	uint32_t overruns;
+	/* Bytes lost to overruns (wraps around after 4 GB) */
+	uint32_t dropped_bytes;
+};
+
+/**
+ * @struct sdram_ring_desc
+ * @brief Streaming ring descriptor
+ * @details The IIO circular buffer (placed in the SDP-K1 SDRAM when enabled)
+ * is used as a ring shared between the ADC producer and the IIO transport,
+ * which drains it concurrently. A producer writing through the ring, or
+ * steering its DMA away from unread data, never overwrites it: when the ring
+ * is full the incoming data is dropped in whole units (scans), so that the
+ * stream stays aligned and capture can go on for longer than the ring holds,
+ * as long as the transport keeps up on average. A circular DMA writing in
+ * place cannot be held off; the ring then only counts the overwrites.
+ */
+struct sdram_ring_desc {
+	/* Circular buffer used as the ring */
+	struct no_os_circular_buffer *cb;
+	/* Size of the data unit dropped as a whole on overrun (in bytes) */
+	uint32_t unit_size;
+	/* Bytes of the current unit seen by the producer so far */
+	uint32_t unit_offset;
+	/* Current unit is being dropped */
+	bool dropping;
+	/* Telemetry */
+	uint32_t high_water_mark;
+	uint32_t overruns;
+	uint32_t dropped_bytes;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int32_t sdram_ring_init(struct sdram_ring_desc **desc);
+int32_t sdram_ring_remove(struct sdram_ring_desc *desc);
+int32_t sdram_ring_start(struct sdram_ring_desc *desc,
+			 struct no_os_circular_buffer *cb,
+			 uint32_t capacity,
+			 uint32_t unit_size);
+int32_t sdram_ring_write(struct sdram_ring_desc *desc,
+			 const void *data,
+			 uint32_t len);
+void sdram_ring_block_done(struct sdram_ring_desc *desc, uint32_t len);
+void sdram_ring_block_dropped(struct sdram_ring_desc *desc, uint32_t len);
+int32_t sdram_ring_get_stats(struct sdram_ring_desc *desc,
+			     struct sdram_ring_stats *stats);
+
+#endif // _SDRAM_RING_H_
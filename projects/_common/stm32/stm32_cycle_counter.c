@@ -0,0 +1,45 @@
+/***************************************************************************//**
+ * @file    stm32_cycle_counter.c
+ * @brief   Core cycle counter support for STM32 MCUs.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "stm32_cycle_counter.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/* Key unlocking the write access to DWT registers on Cortex-M7 cores */
+#define DWT_LAR_UNLOCK_KEY		0xC5ACCE55
+
+/**
+ * @brief 	Enable the DWT core cycle counter.
+ * @return 	None
+ */
+void stm32_cycle_counter_enable(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if (__CORTEX_M == 7U)
+	DWT->LAR = DWT_LAR_UNLOCK_KEY;
+#endif
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief 	Get the frequency of the core cycle counter.
+ * @return 	Cycle counter frequency in Hz
+ */
+uint32_t stm32_cycle_counter_freq(void)
+{
+	return SystemCoreClock;
+}
@@ -0,0 +1,37 @@
+/***************************************************************************//**
+ * @file    stm32_cycle_counter.h
+ * @brief   Core cycle counter support for STM32 MCUs.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _STM32_CYCLE_COUNTER_H_
+#define _STM32_CYCLE_COUNTER_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "stm32_hal.h"
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+void stm32_cycle_counter_enable(void);
+uint32_t stm32_cycle_counter_freq(void);
+
+/**
+ * @brief 	Get the current core cycle count.
+ * @return 	Core cycle count (wraps around at 2^32)
+ */
+static inline uint32_t stm32_cycle_counter_get(void)
+{
+	return DWT->CYCCNT;
+}
+
+#endif // _STM32_CYCLE_COUNTER_H_
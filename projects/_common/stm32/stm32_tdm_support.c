@@ -0,0 +1,362 @@
+/***************************************************************************//*
+ * @file    stm32_tdm_support.c
+ * @brief   STM32 TDM-DMA data streaming support
+******************************************************************************
+ * Copyright (c) 2023, 2026 Analog Devices, Inc. All Rights Reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <errno.h>
+#include "stm32_tdm_support.h"
+#include "stm32_tdm.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************* Macros and Constants Definitions ***********************/
+/******************************************************************************/
+
+/* Number of slots in the TDM-DMA ping-pong buffer (half + full transfer) */
+#define TDM_STREAM_SLOTS_PER_XFER	2
+
+/******************************************************************************/
+/******************** Variables and User Defined Data Types *******************/
+/******************************************************************************/
+
+/* Flag to denote if the DMA buffer is full */
+volatile bool dma_buffer_full;
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief Update the TDM DMA buffer overflow flag
+ * @return None
+ */
+void update_dma_buffer_overflow(void)
+{
+	dma_buffer_full = true;
+}
+
+/**
+ * @brief Initialize the TDM stream descriptor
+ * @param desc[out] - TDM stream descriptor
+ * @param param[in] - TDM stream init parameters
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t stm32_tdm_stream_init(struct stm32_tdm_stream_desc **desc,
+			      struct stm32_tdm_stream_init_param *param)
+{
+	struct stm32_tdm_stream_desc *stream;
+
+	if (!desc || !param || !param->tdm_desc || !param->slot_samples
+	    || !param->bytes_per_sample
+	    || (param->max_buffer_size < param->slot_samples * param->bytes_per_sample *
+		TDM_STREAM_SLOTS_PER_XFER)) {
+		return -EINVAL;
+	}
+
+	stream = no_os_calloc(1, sizeof(*stream));
+	if (!stream) {
+		return -ENOMEM;
+	}
+
+	stream->tdm_desc = param->tdm_desc;
+	stream->slot_samples = param->slot_samples;
+	stream->slot_size = param->slot_samples * param->bytes_per_sample;
+	stream->max_slots = param->max_buffer_size / stream->slot_size;
+
+	stream->dma_buff = no_os_calloc(TDM_STREAM_SLOTS_PER_XFER, stream->slot_size);
+	if (!stream->dma_buff) {
+		no_os_free(stream);
+		return -ENOMEM;
+	}
+
+	stream->slot_seq = no_os_calloc(stream->max_slots, sizeof(*stream->slot_seq));
+	if (!stream->slot_seq) {
+		no_os_free(stream->dma_buff);
+		no_os_free(stream);
+		return -ENOMEM;
+	}
+
+	*desc = stream;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated for the TDM stream
+ * @param desc[in] - TDM stream descriptor
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t stm32_tdm_stream_remove(struct stm32_tdm_stream_desc *desc)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	no_os_free(desc->slot_seq);
+	no_os_free(desc->dma_buff);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Get the number of bytes written to the circular buffer and not yet read
+ * @param cb[in] - Circular buffer
+ * @return Number of unread bytes
+ */
+static uint32_t stm32_tdm_stream_unread(struct no_os_circular_buffer *cb)
+{
+	uint64_t written = (uint64_t)cb->write.spin_count * cb->size + cb->write.idx;
+	uint64_t read = (uint64_t)cb->read.spin_count * cb->size + cb->read.idx;
+
+	if (read >= written) {
+		return 0;
+	}
+
+	return (uint32_t)(written - read);
+}
+
+/**
+ * @brief Select the mode of the SAI Rx DMA for the next TDM-DMA transfer
+ * @param desc[in] - TDM stream descriptor
+ * @param circular[in] - Circular mode (streaming) or normal mode
+ * @return 0 in case of success, negative error code otherwise
+ * @note The DMA streams of the STM32F4/F7 have a circular mode. The GPDMA of
+ *       the STM32H5 only loops through linked lists, it is kept in normal mode
+ *       and the transfer is re-armed from the full transfer callback instead.
+ */
+static int32_t stm32_tdm_stream_dma_mode(struct stm32_tdm_stream_desc *desc,
+		bool circular)
+{
+#ifdef DMA_CIRCULAR
+	struct stm32_tdm_desc *sdesc = desc->tdm_desc->extra;
+	DMA_HandleTypeDef *hdma = sdesc->hsai.hdmarx;
+
+	if (!hdma) {
+		return -EINVAL;
+	}
+
+	hdma->Init.Mode = circular ? DMA_CIRCULAR : DMA_NORMAL;
+	if (HAL_DMA_Init(hdma) != HAL_OK) {
+		return -EIO;
+	}
+#endif
+
+	return 0;
+}
+
+/**
+ * @brief Arm the TDM-DMA transfer onto the ping-pong buffer
+ * @param desc[in] - TDM stream descriptor
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int32_t stm32_tdm_stream_arm(struct stm32_tdm_stream_desc *desc)
+{
+	int32_t ret;
+
+	ret = stm32_tdm_stream_dma_mode(desc, true);
+	if (ret) {
+		return ret;
+	}
+
+	return no_os_tdm_read(desc->tdm_desc, desc->dma_buff,
+			      desc->slot_samples * TDM_STREAM_SLOTS_PER_XFER);
+}
+
+/**
+ * @brief Publish one completed slot into the circular buffer
+ * @param desc[in] - TDM stream descriptor
+ * @param slot[in] - Half of the ping-pong buffer holding the slot data
+ * @return None
+ */
+static void stm32_tdm_stream_publish(struct stm32_tdm_stream_desc *desc,
+				     const uint8_t *slot)
+{
+	struct no_os_circular_buffer *cb = desc->cb;
+
+	if (cb->size - stm32_tdm_stream_unread(cb) < desc->slot_size) {
+		desc->dropped_slots++;
+		desc->dropping = true;
+	} else {
+		/* Write index is always aligned to a slot */
+		desc->slot_seq[cb->write.idx / desc->slot_size] = desc->seq;
+		no_os_cb_write(cb, (void *)slot, desc->slot_size);
+		desc->dropping = false;
+	}
+
+	desc->seq++;
+}
+
+/**
+ * @brief Start streaming TDM data into the circular buffer
+ * @param desc[in] - TDM stream descriptor
+ * @param cb[in] - Circular buffer to stream into
+ * @param n_samples_ignore[in] - Number of samples to discard before streaming
+ *                               (at most two slots worth of samples)
+ * @return 0 in case of success, negative error code otherwise
+ * @note The circular buffer size is trimmed down to a multiple of the slot
+ *       size, so that no slot straddles the buffer wrap-around. It must not
+ *       exceed the maximum buffer size the stream was set up for.
+ */
+int32_t stm32_tdm_stream_start(struct stm32_tdm_stream_desc *desc,
+			       struct no_os_circular_buffer *cb,
+			       uint32_t n_samples_ignore)
+{
+	int32_t ret;
+
+	if (!desc || !cb
+	    || (n_samples_ignore > desc->slot_samples * TDM_STREAM_SLOTS_PER_XFER)) {
+		return -EINVAL;
+	}
+
+	if ((cb->size < desc->slot_size) || (cb->size / desc->slot_size > desc->max_slots)) {
+		return -EINVAL;
+	}
+
+	cb->size = (cb->size / desc->slot_size) * desc->slot_size;
+	desc->cb = cb;
+	desc->n_slots = cb->size / desc->slot_size;
+
+	desc->seq = 0;
+	desc->dropped_slots = 0;
+	desc->dropping = false;
+	desc->n_samples_ignore = n_samples_ignore;
+	desc->active = true;
+
+	if (n_samples_ignore) {
+		/* Discard the initial samples with a single normal mode transfer,
+		 * the streaming transfer is armed on its completion */
+		ret = stm32_tdm_stream_dma_mode(desc, false);
+		if (ret) {
+			return ret;
+		}
+
+		return no_os_tdm_read(desc->tdm_desc, desc->dma_buff, n_samples_ignore);
+	}
+
+	return stm32_tdm_stream_arm(desc);
+}
+
+/**
+ * @brief Stop streaming TDM data
+ * @param desc[in] - TDM stream descriptor
+ * @return 0 in case of success, negative error code otherwise
+ * @note The SAI Rx DMA is put back in normal mode for the other TDM reads.
+ */
+int32_t stm32_tdm_stream_stop(struct stm32_tdm_stream_desc *desc)
+{
+	int32_t ret;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	desc->active = false;
+
+	ret = no_os_tdm_stop(desc->tdm_desc);
+	if (ret) {
+		return ret;
+	}
+
+	return stm32_tdm_stream_dma_mode(desc, false);
+}
+
+/**
+ * @brief Handle the TDM-DMA half transfer completion
+ * @param desc[in] - TDM stream descriptor
+ * @return None
+ * @note To be called from the SAI DMA Rx half complete callback. The first
+ *       half of the ping-pong buffer is complete.
+ */
+void stm32_tdm_stream_half_cplt(struct stm32_tdm_stream_desc *desc)
+{
+	if (!desc || !desc->active || desc->n_samples_ignore) {
+		return;
+	}
+
+	stm32_tdm_stream_publish(desc, desc->dma_buff);
+}
+
+/**
+ * @brief Handle the TDM-DMA full transfer completion
+ * @param desc[in] - TDM stream descriptor
+ * @return None
+ * @note To be called from the SAI DMA Rx complete callback. The second half
+ *       of the ping-pong buffer is complete. The circular DMA goes on into
+ *       the first half by itself; without a circular mode (GPDMA), the
+ *       transfer is re-armed here right away.
+ */
+void stm32_tdm_stream_cplt(struct stm32_tdm_stream_desc *desc)
+{
+	if (!desc || !desc->active) {
+		return;
+	}
+
+	if (desc->n_samples_ignore) {
+		/* End of the initial discard, start the streaming transfer */
+		desc->n_samples_ignore = 0;
+		stm32_tdm_stream_arm(desc);
+		return;
+	}
+
+	stm32_tdm_stream_publish(desc, desc->dma_buff + desc->slot_size);
+
+#ifndef DMA_CIRCULAR
+	stm32_tdm_stream_arm(desc);
+#endif
+}
+
+/**
+ * @brief Get the number of slots dropped since the start of streaming
+ * @param desc[in] - TDM stream descriptor
+ * @param dropped_slots[out] - Number of dropped slots
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t stm32_tdm_stream_get_dropped_slots(struct stm32_tdm_stream_desc *desc,
+		uint32_t *dropped_slots)
+{
+	if (!desc || !dropped_slots) {
+		return -EINVAL;
+	}
+
+	*dropped_slots = desc->dropped_slots;
+
+	return 0;
+}
+
+/**
+ * @brief Get the sequence number of the slot at the read index of the
+ *        circular buffer
+ * @param desc[in] - TDM stream descriptor
+ * @param seq[out] - Sequence number of the slot being read
+ * @return 0 in case of success, -ENODATA if no slot is unread, negative error
+ *         code otherwise
+ * @note Consecutive slots of the stream have consecutive sequence numbers, a
+ *       jump between the slots read marks the slots dropped in between.
+ */
+int32_t stm32_tdm_stream_get_read_seq(struct stm32_tdm_stream_desc *desc,
+				      uint32_t *seq)
+{
+	if (!desc || !desc->cb || !seq) {
+		return -EINVAL;
+	}
+
+	if (!stm32_tdm_stream_unread(desc->cb)) {
+		return -ENODATA;
+	}
+
+	*seq = desc->slot_seq[desc->cb->read.idx / desc->slot_size];
+
+	return 0;
+}
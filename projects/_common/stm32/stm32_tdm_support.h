@@ -0,0 +1,111 @@
+/***************************************************************************//**
+*   @file   stm32_tdm_support.h
+*   @brief  Header file for STM32 TDM-DMA data streaming support
+********************************************************************************
+* Copyright (c) 2023, 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef STM32_TDM_SUPPORT_H_
+#define STM32_TDM_SUPPORT_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_circular_buffer.h"
+#include "no_os_tdm.h"
+
+/******************************************************************************/
+/************************ Macros/Constants ************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct stm32_tdm_stream_init_param
+ * @brief TDM stream initialization parameters
+ */
+struct stm32_tdm_stream_init_param {
+	/* TDM descriptor of the SAI block to stream from */
+	struct no_os_tdm_desc *tdm_desc;
+	/* Number of samples in one slot (half of a TDM-DMA transfer) */
+	uint32_t slot_samples;
+	/* Bytes occupied by one sample in memory */
+	uint8_t bytes_per_sample;
+	/* Memory available to the circular buffer streamed into (in bytes) */
+	uint32_t max_buffer_size;
+};
+
+/**
+ * @struct stm32_tdm_stream_desc
+ * @brief TDM stream descriptor
+ * @details The circular buffer is split into a ring of equally sized slots.
+ * The TDM-DMA runs in circular mode over a ping-pong buffer of two slots,
+ * so that it is started once and never stops while streaming. Each half of
+ * the ping-pong buffer is copied into the next slot of the circular buffer
+ * from the half/full transfer callbacks, while the DMA fills the other half.
+ * A slot is only written when it holds no unread data. When the reader falls
+ * behind, the completed slot is accounted as dropped, so that data is never
+ * silently overwritten. Every completed slot gets a sequence number, which
+ * lets the reader locate the gaps left by the dropped slots.
+ */
+struct stm32_tdm_stream_desc {
+	/* TDM descriptor of the SAI block to stream from */
+	struct no_os_tdm_desc *tdm_desc;
+	/* Circular buffer receiving the streamed data */
+	struct no_os_circular_buffer *cb;
+	/* Number of samples in one slot */
+	uint32_t slot_samples;
+	/* Size of one slot (in bytes) */
+	uint32_t slot_size;
+	/* Number of slots in the circular buffer */
+	uint32_t n_slots;
+	/* Largest number of slots the circular buffer can hold */
+	uint32_t max_slots;
+	/* Ping-pong buffer targeted by the TDM-DMA (two slots) */
+	uint8_t *dma_buff;
+	/* Sequence number of the data held by each slot of the circular buffer */
+	uint32_t *slot_seq;
+	/* Number of samples to be discarded at start of streaming */
+	uint32_t n_samples_ignore;
+	/* Sequence number of the next slot to complete */
+	volatile uint32_t seq;
+	/* Number of slots dropped due to circular buffer being full */
+	volatile uint32_t dropped_slots;
+	/* Last completed slot was dropped */
+	volatile bool dropping;
+	/* Streaming is in progress */
+	volatile bool active;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+extern volatile bool dma_buffer_full;
+void update_dma_buffer_overflow(void);
+
+int32_t stm32_tdm_stream_init(struct stm32_tdm_stream_desc **desc,
+			      struct stm32_tdm_stream_init_param *param);
+int32_t stm32_tdm_stream_remove(struct stm32_tdm_stream_desc *desc);
+int32_t stm32_tdm_stream_start(struct stm32_tdm_stream_desc *desc,
+			       struct no_os_circular_buffer *cb,
+			       uint32_t n_samples_ignore);
+int32_t stm32_tdm_stream_stop(struct stm32_tdm_stream_desc *desc);
+void stm32_tdm_stream_half_cplt(struct stm32_tdm_stream_desc *desc);
+void stm32_tdm_stream_cplt(struct stm32_tdm_stream_desc *desc);
+int32_t stm32_tdm_stream_get_dropped_slots(struct stm32_tdm_stream_desc *desc,
+		uint32_t *dropped_slots);
+int32_t stm32_tdm_stream_get_read_seq(struct stm32_tdm_stream_desc *desc,
+				      uint32_t *seq);
+
+#endif // STM32_TDM_SUPPORT_H_
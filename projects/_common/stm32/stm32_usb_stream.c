@@ -0,0 +1,201 @@
+/***************************************************************************//**
+ * @file    stm32_usb_stream.c
+ * @brief   Binary framed data streaming over the STM32 USB CDC ACM (VCOM).
+ * @details The blocks of a circular DMA buffer are sent to the host as they
+ *          complete, each preceded by a frame header, without copying the
+ *          block data. The host paces the stream by reading the endpoint;
+ *          when it falls behind, the blocks overwritten by the DMA are skipped
+ *          (gap in the frame sequence) rather than sent corrupted. The stream
+ *          runs until the host writes any byte to the VCOM.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include "no_os_alloc.h"
+#include "stm32_usb_uart.h"
+#include "stm32_usb_stream.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Polls of a pending endpoint write before the host is considered gone */
+#define STM32_USB_STREAM_TX_TIMEOUT		0xFFFFFF
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Initialize the stream.
+ * @param 	desc[out] - Stream descriptor.
+ * @param 	param[in] - Stream initialization parameters.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+int stm32_usb_stream_init(struct stm32_usb_stream_desc **desc,
+			  struct stm32_usb_stream_init_param *param)
+{
+	struct stm32_usb_stream_desc *sdesc;
+
+	if (!desc || !param || !param->uart_desc || !param->buf
+	    || !param->block_size || param->nb_blocks < 2) {
+		return -EINVAL;
+	}
+
+	sdesc = no_os_calloc(1, sizeof(*sdesc));
+	if (!sdesc) {
+		return -ENOMEM;
+	}
+
+	sdesc->uart_desc = param->uart_desc;
+	sdesc->buf = param->buf;
+	sdesc->block_size = param->block_size;
+	sdesc->nb_blocks = param->nb_blocks;
+
+	*desc = sdesc;
+
+	return 0;
+}
+
+/**
+ * @brief 	Free the resources allocated by stm32_usb_stream_init().
+ * @param 	desc[in] - Stream descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+int stm32_usb_stream_remove(struct stm32_usb_stream_desc *desc)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Write to the bulk IN endpoint and wait for the host to read it.
+ * @param 	desc[in] - Stream descriptor.
+ * @param 	data[in] - Data to write.
+ * @param 	len[in] - Number of bytes to write.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int stm32_usb_stream_write(struct stm32_usb_stream_desc *desc,
+				  const uint8_t *data,
+				  uint32_t len)
+{
+	uint32_t timeout = STM32_USB_STREAM_TX_TIMEOUT;
+	int ret;
+
+	ret = stm32_usb_uart_write_async(desc->uart_desc, data, len);
+	if (ret) {
+		return ret;
+	}
+
+	while (stm32_usb_uart_tx_busy(desc->uart_desc)) {
+		if (!--timeout) {
+			return -ETIMEDOUT;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 	Send a frame to the host.
+ * @param 	desc[in] - Stream descriptor.
+ * @param 	seq[in] - Block index.
+ * @param 	payload[in] - Block data (NULL for the end frame).
+ * @param 	len[in] - Number of payload bytes.
+ * @param 	flags[in] - STM32_USB_STREAM_FLAG_x.
+ * @return 	0 in case of success, negative error code otherwise.
+ */
+static int stm32_usb_stream_send_frame(struct stm32_usb_stream_desc *desc,
+				       uint32_t seq,
+				       const uint8_t *payload,
+				       uint32_t len,
+				       uint32_t flags)
+{
+	int ret;
+
+	desc->hdr.magic = STM32_USB_STREAM_MAGIC;
+	desc->hdr.seq = seq;
+	desc->hdr.len = len;
+	desc->hdr.flags = flags;
+
+	ret = stm32_usb_stream_write(desc, (uint8_t *)&desc->hdr, sizeof(desc->hdr));
+	if (ret || !len) {
+		return ret;
+	}
+
+	/* The payload goes to the endpoint straight from the DMA buffer */
+	return stm32_usb_stream_write(desc, payload, len);
+}
+
+/**
+ * @brief 	Stream the DMA blocks to the host until it requests to stop.
+ * @param 	desc[in] - Stream descriptor.
+ * @return 	0 in case of success, negative error code otherwise.
+ * @note	The DMA must be started (into an empty buffer) before calling this,
+ *			with stm32_usb_stream_block_done() called for every block completed.
+ *			The stream ends with an end frame and the bytes written by the host
+ *			to stop it are discarded.
+ */
+int stm32_usb_stream_run(struct stm32_usb_stream_desc *desc)
+{
+	uint32_t next = 0;
+	uint32_t flags = 0;
+	uint32_t produced;
+	uint8_t stop;
+	int ret = 0;
+
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	while (!stm32_usb_uart_rx_available(desc->uart_desc)) {
+		produced = desc->produced;
+		if (produced == next) {
+			/* Keep the USB stack running while waiting for the DMA */
+			(void)stm32_usb_uart_tx_busy(desc->uart_desc);
+			continue;
+		}
+
+		/* The oldest pending block is being overwritten by the DMA, skip to
+		 * the last completed one */
+		if (produced - next >= desc->nb_blocks) {
+			next = produced - 1;
+		}
+
+		ret = stm32_usb_stream_send_frame(desc, next,
+						  desc->buf + (next % desc->nb_blocks) * desc->block_size,
+						  desc->block_size, flags);
+		if (ret) {
+			return ret;
+		}
+
+		/* Flag the frame just sent as corrupted (in the next one) if the DMA
+		 * wrapped around to its block while the host was reading it */
+		flags = (desc->produced - next >= desc->nb_blocks) ?
+			STM32_USB_STREAM_FLAG_OVERRUN : 0;
+		next++;
+	}
+
+	ret = stm32_usb_stream_send_frame(desc, next, NULL, 0,
+					  flags | STM32_USB_STREAM_FLAG_END);
+
+	while (stm32_usb_uart_rx_available(desc->uart_desc)) {
+		(void)no_os_uart_read(desc->uart_desc, &stop, 1);
+	}
+
+	return ret;
+}
@@ -0,0 +1,110 @@
+/***************************************************************************//**
+ * @file    stm32_usb_stream.h
+ * @brief   Binary framed data streaming over the STM32 USB CDC ACM (VCOM).
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _STM32_USB_STREAM_H_
+#define _STM32_USB_STREAM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_uart.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Frame header magic ("STRM" in the byte order sent on the wire) */
+#define STM32_USB_STREAM_MAGIC			0x4D525453
+
+/* Frame flags */
+/* The DMA overwrote the previous frame payload while it was being sent */
+#define STM32_USB_STREAM_FLAG_OVERRUN	NO_OS_BIT(0)
+/* Last frame of the stream (no payload) */
+#define STM32_USB_STREAM_FLAG_END		NO_OS_BIT(1)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct stm32_usb_stream_frame_hdr
+ * @brief Header preceding every streamed block (little endian).
+ */
+struct stm32_usb_stream_frame_hdr {
+	/** STM32_USB_STREAM_MAGIC */
+	uint32_t magic;
+	/** Index of the block since the stream start, gaps are dropped blocks */
+	uint32_t seq;
+	/** Number of payload bytes following the header */
+	uint32_t len;
+	/** STM32_USB_STREAM_FLAG_x */
+	uint32_t flags;
+};
+
+/**
+ * @struct stm32_usb_stream_init_param
+ * @brief Stream initialization parameters.
+ */
+struct stm32_usb_stream_init_param {
+	/** VCOM descriptor (stm32_usb_uart_ops) */
+	struct no_os_uart_desc *uart_desc;
+	/** Circular DMA buffer */
+	uint8_t *buf;
+	/** Number of bytes per block (DMA half/full transfer complete) */
+	uint32_t block_size;
+	/** Number of blocks in the DMA buffer (2 for a ping-pong buffer) */
+	uint32_t nb_blocks;
+};
+
+/**
+ * @struct stm32_usb_stream_desc
+ * @brief Stream descriptor.
+ */
+struct stm32_usb_stream_desc {
+	/** VCOM descriptor */
+	struct no_os_uart_desc *uart_desc;
+	/** Circular DMA buffer */
+	uint8_t *buf;
+	/** Number of bytes per block */
+	uint32_t block_size;
+	/** Number of blocks in the DMA buffer */
+	uint32_t nb_blocks;
+	/** Number of blocks completed by the DMA */
+	volatile uint32_t produced;
+	/** Header of the frame being sent */
+	struct stm32_usb_stream_frame_hdr hdr;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int stm32_usb_stream_init(struct stm32_usb_stream_desc **desc,
+			  struct stm32_usb_stream_init_param *param);
+int stm32_usb_stream_remove(struct stm32_usb_stream_desc *desc);
+int stm32_usb_stream_run(struct stm32_usb_stream_desc *desc);
+
+/**
+ * @brief 	Account a block completed by the DMA.
+ * @param 	desc[in] - Stream descriptor.
+ * @return 	None
+ * @note	To be called from the DMA (half) transfer complete callback.
+ */
+static inline void stm32_usb_stream_block_done(struct stm32_usb_stream_desc
+		*desc)
+{
+	desc->produced++;
+}
+
+#endif // _STM32_USB_STREAM_H_
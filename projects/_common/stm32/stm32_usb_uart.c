@@ -36,6 +36,16 @@
 #define STM32_USB_CDC_ACM_TXBUF_LEN UX_SLAVE_REQUEST_DATA_MAX_LENGTH
 #endif
 
+/* Packet memory address of the bulk IN endpoint (second buffer in the upper
+ * half word when the endpoint is double buffered) */
+#if defined(STM32_USB_CDC_ACM_EPIN_DBL_BUF)
+#define USBD_EPIN_PMA_CONFIG	PCD_DBL_BUF
+#define USBD_EPIN_PMA_ADDR		((0x160U << 16) | 0xA0U)
+#else
+#define USBD_EPIN_PMA_CONFIG	PCD_SNG_BUF
+#define USBD_EPIN_PMA_ADDR		0xA0U
+#endif
+
 /* USB slave device descriptor */
 UX_SLAVE_CLASS_CDC_ACM *gusbdevice;
 
@@ -225,7 +235,8 @@ static int32_t stm32_usb_uart_init(struct no_os_uart_desc **desc,
 	/* TODO: Figure how the address (last arg) is calculated and use a macro */
 	HAL_PCDEx_PMAConfig(suip->hpcd, 0x00, PCD_SNG_BUF, 0x20);
 	HAL_PCDEx_PMAConfig(suip->hpcd, 0x80, PCD_SNG_BUF, 0x60);
-	HAL_PCDEx_PMAConfig(suip->hpcd, USBD_EPIN_ADDR, PCD_SNG_BUF, 0xA0);
+	HAL_PCDEx_PMAConfig(suip->hpcd, USBD_EPIN_ADDR, USBD_EPIN_PMA_CONFIG,
+			    USBD_EPIN_PMA_ADDR);
 	HAL_PCDEx_PMAConfig(suip->hpcd, USBD_EPOUT_ADDR, PCD_SNG_BUF, 0xE0);
 	HAL_PCDEx_PMAConfig(suip->hpcd, USBD_EPINCMD_ADDR, PCD_SNG_BUF, 0x120);
 
@@ -365,6 +376,70 @@ static int32_t stm32_usb_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 	return i;
 }
 
+/**
+ * @brief Start writing the data block to the bulk IN endpoint.
+ * @param desc[in] - Instance of UART.
+ * @param data[in] - Data block, must remain unchanged until the write completes.
+ * @param bytes_number[in] - Number of bytes to write.
+ * @return 0 in case of success, -EBUSY if the previous block is still being
+ *         written, negative error code otherwise.
+ * @note The block is handed to the USBX CDC ACM class as is, without splitting
+ *       it into STM32_USB_CDC_ACM_TXBUF_LEN writes. With the class configured
+ *       for zero copy (UX_DEVICE_CLASS_CDC_ACM_ZERO_COPY) the endpoint transfers
+ *       straight out of the block memory.
+ */
+int32_t stm32_usb_uart_write_async(struct no_os_uart_desc *desc,
+				   const uint8_t *data,
+				   uint32_t bytes_number)
+{
+	int ret;
+
+	if (!desc || !data || !bytes_number) {
+		return -EINVAL;
+	}
+
+	if (tx_pending) {
+		return -EBUSY;
+	}
+
+	tx_pending = 1;
+	ret = ux_device_class_cdc_acm_write_with_callback(gusbdevice, (uint8_t *)data,
+			bytes_number);
+	if (ret) {
+		tx_pending = 0;
+		return -EFAULT;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Check if a write to the bulk IN endpoint is in progress.
+ * @param desc[in] - Instance of UART.
+ * @return true if the write is in progress, false otherwise.
+ * @note The USBX device stack tasks are run on every call, so the write makes
+ *       progress while polled. The write stays in progress for as long as the
+ *       host doesn't read the endpoint (back-pressure).
+ */
+bool stm32_usb_uart_tx_busy(struct no_os_uart_desc *desc)
+{
+	ux_device_stack_tasks_run();
+
+	return tx_pending;
+}
+
+/**
+ * @brief Check if data has been received from the host.
+ * @param desc[in] - Instance of UART.
+ * @return true if received data is available to read, false otherwise.
+ */
+bool stm32_usb_uart_rx_available(struct no_os_uart_desc *desc)
+{
+	struct stm32_usb_uart_desc *sdesc = desc->extra;
+
+	return !lf256fifo_is_empty(sdesc->fifo);
+}
+
 /**
  * @brief STM32 platform specific UART platform ops structure
  */
@@ -47,4 +47,10 @@ struct stm32_usb_uart_desc {
  */
 extern const struct no_os_uart_platform_ops stm32_usb_uart_ops;
 
+int32_t stm32_usb_uart_write_async(struct no_os_uart_desc *desc,
+				   const uint8_t *data,
+				   uint32_t bytes_number);
+bool stm32_usb_uart_tx_busy(struct no_os_uart_desc *desc);
+bool stm32_usb_uart_rx_available(struct no_os_uart_desc *desc);
+
 #endif
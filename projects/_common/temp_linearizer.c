@@ -0,0 +1,67 @@
+/***************************************************************************//**
+ * @file    temp_linearizer.c
+ * @brief   Table driven temperature sensor linearization
+ * @details The sensor conversions (RTD Callendar-Van Dusen, NTC Steinhart-Hart,
+ *          thermocouple inverse polynomials) are tabulated offline over a
+ *          uniform grid of an input which is linear in the ADC code (RTD
+ *          resistance ratio, NTC divider ratio, thermocouple EMF). A
+ *          conversion is then one multiply to locate the grid point and a
+ *          linear interpolation, with a bounded error (see the tables).
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "temp_linearizer.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Convert a buffer of ADC codes into temperatures.
+ * @param	tbl[in] - Sensor linearization table
+ * @param	codes[in] - ADC codes
+ * @param	nb_codes[in] - Number of codes
+ * @param	scale[in] - Table input per ADC code
+ * @param	offset[in] - Table input at code 0
+ * @param	temps[out] - Temperatures (degC)
+ * @return 	none
+ * @note	The table input of a code is (code * scale + offset), e.g. for a
+ *			bipolar ratiometric RTD measurement:
+ *			scale = Rref / (R0 * gain * 2^(N-1)), offset = -Rref / (R0 * gain).
+ */
+void temp_lin_convert_codes(const struct temp_lin_table *tbl,
+			    const int32_t *codes, uint32_t nb_codes,
+			    float scale, float offset, float *temps)
+{
+	/* Fold the table offset and grid step into the code scaling */
+	float pos_scale = scale * tbl->x_scale;
+	float pos_offset = (offset - tbl->x_min) * tbl->x_scale;
+	int32_t last = tbl->nb_points - 2;
+	float pos;
+	int32_t idx;
+	uint32_t i;
+
+	for (i = 0; i < nb_codes; i++) {
+		pos = codes[i] * pos_scale + pos_offset;
+
+		if (pos <= 0) {
+			idx = 0;
+		} else if (pos >= last) {
+			idx = last;
+		} else {
+			idx = (int32_t)pos;
+		}
+
+		temps[i] = tbl->temps[idx] + (pos - idx) * (tbl->temps[idx + 1] -
+				tbl->temps[idx]);
+	}
+}
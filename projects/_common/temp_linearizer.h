@@ -0,0 +1,80 @@
+/***************************************************************************//**
+ * @file    temp_linearizer.h
+ * @brief   Table driven temperature sensor linearization
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _TEMP_LINEARIZER_H_
+#define _TEMP_LINEARIZER_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct temp_lin_table
+ * @brief Temperatures of a sensor over a uniform grid of the table input
+ */
+struct temp_lin_table {
+	/* Table input of the first point */
+	float x_min;
+	/* Points per table input unit (1 / grid step) */
+	float x_scale;
+	/* Number of points */
+	uint16_t nb_points;
+	/* Temperature (degC) at every point */
+	const float *temps;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+/* Platinum RTD, input: resistance ratio R/R0 (PT100: R/100, PT1000: R/1000) */
+extern const struct temp_lin_table temp_lin_pt_rtd;
+
+/* NTC 10K 44031RC, input: ratio R/(R + 10K) of the NTC biased through a 10K
+ * sense resistor, i.e. the NTC voltage over the bias (reference) voltage */
+extern const struct temp_lin_table temp_lin_ntc_10k_44031;
+
+/* Type T thermocouple, input: EMF in mV (0 degC reference junction) */
+extern const struct temp_lin_table temp_lin_tc_type_t;
+
+/**
+ * @brief 	Convert a table input into temperature.
+ * @param	tbl[in] - Sensor linearization table
+ * @param	x[in] - Table input
+ * @return	Temperature (degC), linearly extrapolated out of the table range
+ */
+static inline float temp_lin_convert(const struct temp_lin_table *tbl, float x)
+{
+	float pos = (x - tbl->x_min) * tbl->x_scale;
+	int32_t idx;
+
+	if (pos <= 0) {
+		idx = 0;
+	} else if (pos >= tbl->nb_points - 2) {
+		idx = tbl->nb_points - 2;
+	} else {
+		idx = (int32_t)pos;
+	}
+
+	return tbl->temps[idx] + (pos - idx) * (tbl->temps[idx + 1] - tbl->temps[idx]);
+}
+
+void temp_lin_convert_codes(const struct temp_lin_table *tbl,
+			    const int32_t *codes, uint32_t nb_codes,
+			    float scale, float offset, float *temps);
+
+#endif /* _TEMP_LINEARIZER_H_ */
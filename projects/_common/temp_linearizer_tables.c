@@ -0,0 +1,334 @@
+/***************************************************************************//**
+ * @file    temp_linearizer_tables.c
+ * @brief   Temperature sensor linearization tables
+ * @details Generated by tools/temp_linearizer/scripts/temp_lut_gen.py, do not
+ *          edit. Max interpolation error: 0.010 degC.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "temp_linearizer.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Platinum RTD (PT100/PT1000), -200 to 850 degC
+ * Input: resistance ratio R/R0, 96 points (max error 0.0088 degC) */
+static const float temp_lin_pt_rtd_temps[96] = {
+	-200.000000f, -190.909270f, -181.751338f, -172.528587f, -163.243448f, -153.898387f,
+	-144.495887f, -135.038428f, -125.528473f, -115.968447f, -106.360721f, -96.707590f,
+	-87.011262f, -77.273833f, -67.497276f, -57.683425f, -47.833954f, -37.950369f,
+	-28.033990f, -18.085942f, -8.107136f, 1.901739f, 11.940385f, 22.009008f,
+	32.107877f, 42.237266f, 52.397455f, 62.588725f, 72.811363f, 83.065662f,
+	93.351917f, 103.670428f, 114.021502f, 124.405448f, 134.822581f, 145.273223f,
+	155.757697f, 166.276335f, 176.829474f, 187.417454f, 198.040624f, 208.699336f,
+	219.393949f, 230.124829f, 240.892348f, 251.696883f, 262.538818f, 273.418545f,
+	284.336462f, 295.292973f, 306.288491f, 317.323436f, 328.398234f, 339.513321f,
+	350.669139f, 361.866140f, 373.104783f, 384.385536f, 395.708876f, 407.075289f,
+	418.485270f, 429.939325f, 441.437968f, 452.981724f, 464.571127f, 476.206724f,
+	487.889072f, 499.618739f, 511.396304f, 523.222359f, 535.097508f, 547.022367f,
+	558.997567f, 571.023749f, 583.101571f, 595.231703f, 607.414832f, 619.651659f,
+	631.942898f, 644.289283f, 656.691563f, 669.150504f, 681.666890f, 694.241522f,
+	706.875221f, 719.568829f, 732.323204f, 745.139229f, 758.017806f, 770.959859f,
+	783.966338f, 797.038213f, 810.176481f, 823.382165f, 836.656313f, 850.000000f,
+};
+
+const struct temp_lin_table temp_lin_pt_rtd = {
+	.x_min = 0.1852008f,
+	.x_scale = 25.5403089f,
+	.nb_points = 96,
+	.temps = temp_lin_pt_rtd_temps
+};
+
+/* NTC 10K 44031RC thermistor, -40 to 150 degC
+ * Input: divider ratio R/(R + 10K), 1040 points (max error 0.0099 degC) */
+static const float temp_lin_ntc_10k_44031_temps[1040] = {
+	150.000000f, 148.236079f, 146.548002f, 144.929848f, 143.376344f, 141.882780f,
+	140.444929f, 139.058986f, 137.721513f, 136.429395f, 135.179800f, 133.970147f,
+	132.798077f, 131.661431f, 130.558223f, 129.486628f, 128.444962f, 127.431669f,
+	126.445308f, 125.484542f, 124.548130f, 123.634916f, 122.743823f, 121.873843f,
+	121.024038f, 120.193527f, 119.381483f, 118.587132f, 117.809746f, 117.048640f,
+	116.303166f, 115.572717f, 114.856718f, 114.154625f, 113.465924f, 112.790129f,
+	112.126777f, 111.475432f, 110.835677f, 110.207118f, 109.589380f, 108.982104f,
+	108.384951f, 107.797595f, 107.219728f, 106.651054f, 106.091291f, 105.540168f,
+	104.997429f, 104.462825f, 103.936121f, 103.417090f, 102.905515f, 102.401187f,
+	101.903907f, 101.413482f, 100.929729f, 100.452470f, 99.981534f, 99.516757f,
+	99.057982f, 98.605056f, 98.157833f, 97.716172f, 97.279936f, 96.848994f,
+	96.423219f, 96.002490f, 95.586687f, 95.175696f, 94.769408f, 94.367714f,
+	93.970513f, 93.577704f, 93.189191f, 92.804879f, 92.424678f, 92.048501f,
+	91.676262f, 91.307878f, 90.943270f, 90.582360f, 90.225072f, 89.871334f,
+	89.521074f, 89.174223f, 88.830715f, 88.490484f, 88.153467f, 87.819603f,
+	87.488832f, 87.161095f, 86.836337f, 86.514501f, 86.195535f, 85.879385f,
+	85.566003f, 85.255337f, 84.947339f, 84.641964f, 84.339164f, 84.038896f,
+	83.741115f, 83.445780f, 83.152848f, 82.862280f, 82.574036f, 82.288078f,
+	82.004367f, 81.722868f, 81.443545f, 81.166362f, 80.891285f, 80.618282f,
+	80.347319f, 80.078365f, 79.811388f, 79.546358f, 79.283245f, 79.022020f,
+	78.762655f, 78.505121f, 78.249392f, 77.995440f, 77.743240f, 77.492765f,
+	77.243992f, 76.996895f, 76.751450f, 76.507634f, 76.265424f, 76.024796f,
+	75.785730f, 75.548204f, 75.312195f, 75.077684f, 74.844650f, 74.613073f,
+	74.382932f, 74.154210f, 73.926887f, 73.700945f, 73.476365f, 73.253129f,
+	73.031221f, 72.810622f, 72.591317f, 72.373288f, 72.156519f, 71.940995f,
+	71.726699f, 71.513616f, 71.301732f, 71.091031f, 70.881498f, 70.673120f,
+	70.465883f, 70.259771f, 70.054773f, 69.850874f, 69.648062f, 69.446323f,
+	69.245645f, 69.046016f, 68.847422f, 68.649853f, 68.453295f, 68.257738f,
+	68.063170f, 67.869580f, 67.676956f, 67.485288f, 67.294565f, 67.104776f,
+	66.915911f, 66.727960f, 66.540912f, 66.354758f, 66.169487f, 65.985091f,
+	65.801560f, 65.618883f, 65.437053f, 65.256060f, 65.075895f, 64.896550f,
+	64.718015f, 64.540282f, 64.363343f, 64.187190f, 64.011813f, 63.837207f,
+	63.663361f, 63.490269f, 63.317923f, 63.146315f, 62.975438f, 62.805284f,
+	62.635846f, 62.467117f, 62.299090f, 62.131758f, 61.965114f, 61.799151f,
+	61.633863f, 61.469243f, 61.305284f, 61.141980f, 60.979324f, 60.817311f,
+	60.655935f, 60.495188f, 60.335066f, 60.175562f, 60.016670f, 59.858385f,
+	59.700700f, 59.543611f, 59.387112f, 59.231197f, 59.075860f, 58.921098f,
+	58.766903f, 58.613271f, 58.460197f, 58.307676f, 58.155703f, 58.004272f,
+	57.853379f, 57.703020f, 57.553188f, 57.403881f, 57.255092f, 57.106817f,
+	56.959052f, 56.811792f, 56.665033f, 56.518771f, 56.373000f, 56.227718f,
+	56.082919f, 55.938599f, 55.794754f, 55.651381f, 55.508475f, 55.366031f,
+	55.224047f, 55.082518f, 54.941441f, 54.800811f, 54.660625f, 54.520878f,
+	54.381569f, 54.242691f, 54.104243f, 53.966221f, 53.828620f, 53.691438f,
+	53.554671f, 53.418316f, 53.282368f, 53.146826f, 53.011685f, 52.876943f,
+	52.742595f, 52.608639f, 52.475073f, 52.341891f, 52.209092f, 52.076673f,
+	51.944629f, 51.812959f, 51.681660f, 51.550728f, 51.420160f, 51.289954f,
+	51.160106f, 51.030615f, 50.901476f, 50.772688f, 50.644248f, 50.516152f,
+	50.388399f, 50.260985f, 50.133907f, 50.007165f, 49.880753f, 49.754671f,
+	49.628916f, 49.503484f, 49.378374f, 49.253583f, 49.129109f, 49.004949f,
+	48.881101f, 48.757563f, 48.634331f, 48.511404f, 48.388780f, 48.266456f,
+	48.144430f, 48.022700f, 47.901263f, 47.780117f, 47.659261f, 47.538691f,
+	47.418406f, 47.298404f, 47.178683f, 47.059239f, 46.940073f, 46.821180f,
+	46.702560f, 46.584211f, 46.466129f, 46.348314f, 46.230763f, 46.113475f,
+	45.996448f, 45.879678f, 45.763166f, 45.646908f, 45.530904f, 45.415150f,
+	45.299646f, 45.184389f, 45.069378f, 44.954611f, 44.840086f, 44.725802f,
+	44.611756f, 44.497946f, 44.384373f, 44.271032f, 44.157924f, 44.045045f,
+	43.932395f, 43.819972f, 43.707774f, 43.595800f, 43.484047f, 43.372516f,
+	43.261202f, 43.150107f, 43.039226f, 42.928560f, 42.818107f, 42.707865f,
+	42.597832f, 42.488007f, 42.378389f, 42.268976f, 42.159767f, 42.050760f,
+	41.941954f, 41.833347f, 41.724938f, 41.616726f, 41.508709f, 41.400886f,
+	41.293254f, 41.185814f, 41.078564f, 40.971502f, 40.864627f, 40.757937f,
+	40.651432f, 40.545110f, 40.438969f, 40.333009f, 40.227228f, 40.121625f,
+	40.016199f, 39.910948f, 39.805871f, 39.700966f, 39.596234f, 39.491672f,
+	39.387279f, 39.283054f, 39.178996f, 39.075103f, 38.971375f, 38.867810f,
+	38.764407f, 38.661165f, 38.558083f, 38.455160f, 38.352394f, 38.249784f,
+	38.147330f, 38.045030f, 37.942883f, 37.840888f, 37.739043f, 37.637349f,
+	37.535803f, 37.434405f, 37.333153f, 37.232047f, 37.131085f, 37.030267f,
+	36.929591f, 36.829056f, 36.728662f, 36.628407f, 36.528290f, 36.428310f,
+	36.328467f, 36.228759f, 36.129185f, 36.029745f, 35.930437f, 35.831260f,
+	35.732213f, 35.633296f, 35.534508f, 35.435847f, 35.337312f, 35.238903f,
+	35.140619f, 35.042458f, 34.944420f, 34.846505f, 34.748710f, 34.651035f,
+	34.553479f, 34.456042f, 34.358722f, 34.261518f, 34.164431f, 34.067457f,
+	33.970598f, 33.873852f, 33.777217f, 33.680694f, 33.584281f, 33.487978f,
+	33.391784f, 33.295697f, 33.199717f, 33.103844f, 33.008075f, 32.912412f,
+	32.816852f, 32.721394f, 32.626039f, 32.530785f, 32.435631f, 32.340577f,
+	32.245621f, 32.150764f, 32.056004f, 31.961340f, 31.866772f, 31.772298f,
+	31.677919f, 31.583633f, 31.489439f, 31.395337f, 31.301326f, 31.207406f,
+	31.113574f, 31.019831f, 30.926177f, 30.832609f, 30.739128f, 30.645732f,
+	30.552421f, 30.459195f, 30.366052f, 30.272992f, 30.180013f, 30.087116f,
+	29.994300f, 29.901563f, 29.808905f, 29.716326f, 29.623824f, 29.531399f,
+	29.439051f, 29.346778f, 29.254580f, 29.162456f, 29.070405f, 28.978427f,
+	28.886521f, 28.794687f, 28.702923f, 28.611229f, 28.519605f, 28.428049f,
+	28.336561f, 28.245140f, 28.153785f, 28.062497f, 27.971274f, 27.880115f,
+	27.789021f, 27.697989f, 27.607020f, 27.516113f, 27.425268f, 27.334482f,
+	27.243757f, 27.153091f, 27.062484f, 26.971934f, 26.881442f, 26.791007f,
+	26.700627f, 26.610303f, 26.520034f, 26.429819f, 26.339657f, 26.249549f,
+	26.159492f, 26.069487f, 25.979533f, 25.889629f, 25.799775f, 25.709970f,
+	25.620213f, 25.530504f, 25.440842f, 25.351227f, 25.261658f, 25.172134f,
+	25.082655f, 24.993219f, 24.903828f, 24.814479f, 24.725172f, 24.635907f,
+	24.546683f, 24.457499f, 24.368355f, 24.279251f, 24.190185f, 24.101156f,
+	24.012166f, 23.923212f, 23.834294f, 23.745411f, 23.656564f, 23.567751f,
+	23.478971f, 23.390225f, 23.301512f, 23.212830f, 23.124180f, 23.035560f,
+	22.946971f, 22.858411f, 22.769880f, 22.681377f, 22.592902f, 22.504455f,
+	22.416034f, 22.327639f, 22.239269f, 22.150924f, 22.062604f, 21.974307f,
+	21.886033f, 21.797782f, 21.709552f, 21.621344f, 21.533156f, 21.444989f,
+	21.356841f, 21.268712f, 21.180601f, 21.092508f, 21.004433f, 20.916373f,
+	20.828330f, 20.740302f, 20.652289f, 20.564291f, 20.476305f, 20.388333f,
+	20.300374f, 20.212426f, 20.124490f, 20.036564f, 19.948648f, 19.860742f,
+	19.772845f, 19.684956f, 19.597075f, 19.509201f, 19.421334f, 19.333473f,
+	19.245617f, 19.157766f, 19.069919f, 18.982076f, 18.894236f, 18.806398f,
+	18.718563f, 18.630728f, 18.542894f, 18.455060f, 18.367226f, 18.279391f,
+	18.191554f, 18.103714f, 18.015872f, 17.928026f, 17.840176f, 17.752322f,
+	17.664462f, 17.576596f, 17.488724f, 17.400845f, 17.312958f, 17.225063f,
+	17.137159f, 17.049245f, 16.961321f, 16.873387f, 16.785441f, 16.697483f,
+	16.609513f, 16.521529f, 16.433532f, 16.345520f, 16.257494f, 16.169452f,
+	16.081393f, 15.993318f, 15.905225f, 15.817114f, 15.728984f, 15.640835f,
+	15.552666f, 15.464477f, 15.376266f, 15.288033f, 15.199778f, 15.111500f,
+	15.023198f, 14.934871f, 14.846520f, 14.758143f, 14.669739f, 14.581309f,
+	14.492851f, 14.404364f, 14.315849f, 14.227304f, 14.138729f, 14.050123f,
+	13.961486f, 13.872816f, 13.784114f, 13.695378f, 13.606608f, 13.517803f,
+	13.428963f, 13.340086f, 13.251173f, 13.162222f, 13.073233f, 12.984205f,
+	12.895137f, 12.806029f, 12.716880f, 12.627690f, 12.538457f, 12.449181f,
+	12.359862f, 12.270498f, 12.181089f, 12.091634f, 12.002132f, 11.912584f,
+	11.822987f, 11.733342f, 11.643647f, 11.553902f, 11.464106f, 11.374259f,
+	11.284359f, 11.194406f, 11.104400f, 11.014339f, 10.924222f, 10.834050f,
+	10.743821f, 10.653534f, 10.563189f, 10.472785f, 10.382321f, 10.291797f,
+	10.201211f, 10.110563f, 10.019852f, 9.929077f, 9.838238f, 9.747334f,
+	9.656363f, 9.565326f, 9.474220f, 9.383047f, 9.291804f, 9.200490f,
+	9.109106f, 9.017650f, 8.926122f, 8.834520f, 8.742844f, 8.651092f,
+	8.559265f, 8.467361f, 8.375379f, 8.283318f, 8.191178f, 8.098958f,
+	8.006657f, 7.914273f, 7.821807f, 7.729256f, 7.636621f, 7.543901f,
+	7.451093f, 7.358199f, 7.265216f, 7.172143f, 7.078981f, 6.985727f,
+	6.892381f, 6.798942f, 6.705409f, 6.611781f, 6.518057f, 6.424236f,
+	6.330317f, 6.236299f, 6.142182f, 6.047963f, 5.953643f, 5.859219f,
+	5.764692f, 5.670060f, 5.575321f, 5.480476f, 5.385523f, 5.290460f,
+	5.195288f, 5.100004f, 5.004607f, 4.909098f, 4.813474f, 4.717734f,
+	4.621877f, 4.525903f, 4.429809f, 4.333596f, 4.237261f, 4.140804f,
+	4.044223f, 3.947518f, 3.850687f, 3.753728f, 3.656642f, 3.559425f,
+	3.462079f, 3.364600f, 3.266988f, 3.169242f, 3.071360f, 2.973341f,
+	2.875184f, 2.776888f, 2.678450f, 2.579871f, 2.481149f, 2.382281f,
+	2.283268f, 2.184107f, 2.084798f, 1.985338f, 1.885727f, 1.785963f,
+	1.686045f, 1.585972f, 1.485741f, 1.385351f, 1.284802f, 1.184091f,
+	1.083217f, 0.982178f, 0.880974f, 0.779602f, 0.678061f, 0.576350f,
+	0.474467f, 0.372410f, 0.270177f, 0.167768f, 0.065180f, -0.037588f,
+	-0.140538f, -0.243671f, -0.346989f, -0.450494f, -0.554188f, -0.658072f,
+	-0.762148f, -0.866417f, -0.970883f, -1.075545f, -1.180407f, -1.285470f,
+	-1.390736f, -1.496206f, -1.601883f, -1.707768f, -1.813864f, -1.920173f,
+	-2.026696f, -2.133435f, -2.240392f, -2.347570f, -2.454970f, -2.562595f,
+	-2.670446f, -2.778527f, -2.886838f, -2.995382f, -3.104161f, -3.213178f,
+	-3.322434f, -3.431932f, -3.541674f, -3.651663f, -3.761901f, -3.872390f,
+	-3.983133f, -4.094131f, -4.205388f, -4.316906f, -4.428687f, -4.540735f,
+	-4.653050f, -4.765637f, -4.878498f, -4.991634f, -5.105050f, -5.218748f,
+	-5.332730f, -5.446999f, -5.561558f, -5.676410f, -5.791558f, -5.907005f,
+	-6.022753f, -6.138806f, -6.255166f, -6.371837f, -6.488822f, -6.606124f,
+	-6.723745f, -6.841691f, -6.959962f, -7.078564f, -7.197499f, -7.316770f,
+	-7.436381f, -7.556336f, -7.676638f, -7.797291f, -7.918298f, -8.039662f,
+	-8.161389f, -8.283480f, -8.405941f, -8.528775f, -8.651986f, -8.775577f,
+	-8.899554f, -9.023920f, -9.148679f, -9.273836f, -9.399394f, -9.525358f,
+	-9.651733f, -9.778523f, -9.905732f, -10.033365f, -10.161426f, -10.289921f,
+	-10.418855f, -10.548231f, -10.678055f, -10.808332f, -10.939068f, -11.070266f,
+	-11.201933f, -11.334074f, -11.466695f, -11.599800f, -11.733395f, -11.867487f,
+	-12.002080f, -12.137181f, -12.272795f, -12.408930f, -12.545590f, -12.682782f,
+	-12.820513f, -12.958788f, -13.097615f, -13.237001f, -13.376951f, -13.517473f,
+	-13.658574f, -13.800262f, -13.942542f, -14.085424f, -14.228914f, -14.373020f,
+	-14.517750f, -14.663111f, -14.809113f, -14.955763f, -15.103069f, -15.251040f,
+	-15.399686f, -15.549014f, -15.699034f, -15.849755f, -16.001186f, -16.153337f,
+	-16.306218f, -16.459839f, -16.614210f, -16.769341f, -16.925243f, -17.081926f,
+	-17.239402f, -17.397682f, -17.556777f, -17.716699f, -17.877460f, -18.039072f,
+	-18.201548f, -18.364899f, -18.529140f, -18.694284f, -18.860343f, -19.027333f,
+	-19.195267f, -19.364159f, -19.534024f, -19.704878f, -19.876736f, -20.049614f,
+	-20.223528f, -20.398495f, -20.574531f, -20.751654f, -20.929883f, -21.109234f,
+	-21.289727f, -21.471382f, -21.654217f, -21.838252f, -22.023509f, -22.210009f,
+	-22.397773f, -22.586824f, -22.777185f, -22.968878f, -23.161928f, -23.356361f,
+	-23.552200f, -23.749473f, -23.948207f, -24.148428f, -24.350166f, -24.553449f,
+	-24.758309f, -24.964774f, -25.172879f, -25.382654f, -25.594135f, -25.807356f,
+	-26.022353f, -26.239163f, -26.457824f, -26.678375f, -26.900858f, -27.125315f,
+	-27.351788f, -27.580323f, -27.810966f, -28.043764f, -28.278769f, -28.516030f,
+	-28.755601f, -28.997538f, -29.241897f, -29.488737f, -29.738120f, -29.990109f,
+	-30.244771f, -30.502175f, -30.762390f, -31.025493f, -31.291559f, -31.560670f,
+	-31.832909f, -32.108363f, -32.387123f, -32.669284f, -32.954945f, -33.244210f,
+	-33.537186f, -33.833987f, -34.134732f, -34.439544f, -34.748553f, -35.061896f,
+	-35.379717f, -35.702166f, -36.029401f, -36.361589f, -36.698906f, -37.041538f,
+	-37.389681f, -37.743540f, -38.103336f, -38.469301f, -38.841680f, -39.220735f,
+	-39.606743f, -40.000000f,
+};
+
+const struct temp_lin_table temp_lin_ntc_10k_44031 = {
+	.x_min = 0.0231665474f,
+	.x_scale = 1109.11755f,
+	.nb_points = 1040,
+	.temps = temp_lin_ntc_10k_44031_temps
+};
+
+/* Type T thermocouple, -200 to 400 degC
+ * Input: EMF in mV (0 degC reference junction), 512 points (max error 0.0098 degC) */
+static const float temp_lin_tc_type_t_temps[512] = {
+	-199.964083f, -196.746392f, -193.605217f, -190.536345f, -187.535812f, -184.599888f,
+	-181.725065f, -178.908047f, -176.145741f, -173.435243f, -170.773832f, -168.158956f,
+	-165.588225f, -163.059405f, -160.570402f, -158.119263f, -155.704159f, -153.323384f,
+	-150.975345f, -148.658554f, -146.371625f, -144.113262f, -141.882260f, -139.677492f,
+	-137.497907f, -135.342527f, -133.210437f, -131.100784f, -129.012769f, -126.945648f,
+	-124.898722f, -122.871338f, -120.862883f, -118.872779f, -116.900486f, -114.945490f,
+	-113.007310f, -111.085488f, -109.179590f, -107.289202f, -105.413932f, -103.553401f,
+	-101.707250f, -99.875131f, -98.056710f, -96.251665f, -94.459682f, -92.680459f,
+	-90.913701f, -89.159120f, -87.416438f, -85.685380f, -83.965680f, -82.257077f,
+	-80.559314f, -78.872141f, -77.195313f, -75.528590f, -73.871738f, -72.224527f,
+	-70.586732f, -68.958136f, -67.338525f, -65.727693f, -64.125439f, -62.531569f,
+	-60.945895f, -59.368236f, -57.798419f, -56.236277f, -54.681652f, -53.134392f,
+	-51.594355f, -50.061406f, -48.535417f, -47.016270f, -45.503854f, -43.998067f,
+	-42.498813f, -41.006005f, -39.519563f, -38.039414f, -36.565490f, -35.097732f,
+	-33.636081f, -32.180486f, -30.730899f, -29.287272f, -27.849560f, -26.417715f,
+	-24.991690f, -23.571432f, -22.156884f, -20.747981f, -19.344649f, -17.946800f,
+	-16.554335f, -15.167134f, -13.785061f, -12.407952f, -11.035621f, -9.667850f,
+	-8.304386f, -6.944941f, -5.589183f, -4.236733f, -2.887163f, -1.539986f,
+	-0.194657f, 1.147360f, 2.485200f, 3.819029f, 5.148885f, 6.474806f,
+	7.796829f, 9.114990f, 10.429326f, 11.739873f, 13.046667f, 14.349742f,
+	15.649135f, 16.944878f, 18.237008f, 19.525557f, 20.810560f, 22.092049f,
+	23.370058f, 24.644618f, 25.915763f, 27.183525f, 28.447934f, 29.709022f,
+	30.966821f, 32.221361f, 33.472672f, 34.720784f, 35.965727f, 37.207531f,
+	38.446224f, 39.681836f, 40.914395f, 42.143928f, 43.370466f, 44.594033f,
+	45.814660f, 47.032371f, 48.247194f, 49.459156f, 50.668283f, 51.874601f,
+	53.078134f, 54.278910f, 55.476953f, 56.672288f, 57.864939f, 59.054931f,
+	60.242288f, 61.427033f, 62.609191f, 63.788785f, 64.965837f, 66.140371f,
+	67.312409f, 68.481973f, 69.649085f, 70.813768f, 71.976043f, 73.135931f,
+	74.293453f, 75.448631f, 76.601485f, 77.752035f, 78.900301f, 80.046304f,
+	81.190064f, 82.331599f, 83.470929f, 84.608074f, 85.743052f, 86.875881f,
+	88.006581f, 89.135170f, 90.261665f, 91.386085f, 92.508447f, 93.628768f,
+	94.747067f, 95.863359f, 96.977662f, 98.089992f, 99.200367f, 100.308801f,
+	101.415312f, 102.519915f, 103.622626f, 104.723461f, 105.822434f, 106.919562f,
+	108.014858f, 109.108339f, 110.200018f, 111.289911f, 112.378031f, 113.464392f,
+	114.549010f, 115.631896f, 116.713066f, 117.792533f, 118.870310f, 119.946409f,
+	121.020846f, 122.093631f, 123.164779f, 124.234301f, 125.302210f, 126.368519f,
+	127.433239f, 128.496382f, 129.557961f, 130.617987f, 131.676472f, 132.733427f,
+	133.788863f, 134.842793f, 135.895226f, 136.946173f, 137.995647f, 139.043656f,
+	140.090212f, 141.135326f, 142.179006f, 143.221265f, 144.262111f, 145.301555f,
+	146.339606f, 147.376275f, 148.411570f, 149.445502f, 150.478079f, 151.509311f,
+	152.539208f, 153.567777f, 154.595029f, 155.620971f, 156.645613f, 157.668964f,
+	158.691031f, 159.711823f, 160.731349f, 161.749617f, 162.766635f, 163.782412f,
+	164.796954f, 165.810270f, 166.822367f, 167.833254f, 168.842938f, 169.851427f,
+	170.858727f, 171.864847f, 172.869793f, 173.873573f, 174.876194f, 175.877662f,
+	176.877986f, 177.877171f, 178.875225f, 179.872154f, 180.867965f, 181.862664f,
+	182.856258f, 183.848754f, 184.840157f, 185.830475f, 186.819713f, 187.807877f,
+	188.794974f, 189.781009f, 190.765989f, 191.749920f, 192.732807f, 193.714656f,
+	194.695473f, 195.675264f, 196.654033f, 197.631788f, 198.608533f, 199.584273f,
+	200.559015f, 201.532763f, 202.505523f, 203.477300f, 204.448099f, 205.417925f,
+	206.386784f, 207.354681f, 208.321620f, 209.287606f, 210.252645f, 211.216741f,
+	212.179900f, 213.142125f, 214.103422f, 215.063795f, 216.023250f, 216.981790f,
+	217.939420f, 218.896145f, 219.851969f, 220.806897f, 221.760934f, 222.714083f,
+	223.666349f, 224.617736f, 225.568249f, 226.517892f, 227.466669f, 228.414584f,
+	229.361642f, 230.307847f, 231.253203f, 232.197713f, 233.141382f, 234.084215f,
+	235.026214f, 235.967384f, 236.907730f, 237.847254f, 238.785961f, 239.723854f,
+	240.660938f, 241.597216f, 242.532693f, 243.467371f, 244.401255f, 245.334349f,
+	246.266655f, 247.198179f, 248.128923f, 249.058891f, 249.988087f, 250.916514f,
+	251.844176f, 252.771077f, 253.697220f, 254.622608f, 255.547246f, 256.471137f,
+	257.394283f, 258.316690f, 259.238359f, 260.159295f, 261.079501f, 261.998981f,
+	262.917737f, 263.835773f, 264.753093f, 265.669699f, 266.585596f, 267.500786f,
+	268.415273f, 269.329060f, 270.242151f, 271.154548f, 272.066255f, 272.977274f,
+	273.887611f, 274.797266f, 275.706245f, 276.614549f, 277.522182f, 278.429147f,
+	279.335448f, 280.241087f, 281.146067f, 282.050392f, 282.954065f, 283.857088f,
+	284.759466f, 285.661200f, 286.562294f, 287.462751f, 288.362574f, 289.261766f,
+	290.160329f, 291.058268f, 291.955584f, 292.852281f, 293.748362f, 294.643829f,
+	295.538685f, 296.432934f, 297.326579f, 298.219621f, 299.112064f, 300.003911f,
+	300.895164f, 301.785827f, 302.675902f, 303.565391f, 304.454298f, 305.342626f,
+	306.230376f, 307.117553f, 308.004158f, 308.890193f, 309.775663f, 310.660569f,
+	311.544914f, 312.428700f, 313.311931f, 314.194608f, 315.076734f, 315.958312f,
+	316.839345f, 317.719834f, 318.599782f, 319.479192f, 320.358066f, 321.236406f,
+	322.114215f, 322.991496f, 323.868249f, 324.744479f, 325.620186f, 326.495373f,
+	327.370043f, 328.244198f, 329.117840f, 329.990970f, 330.863592f, 331.735706f,
+	332.607316f, 333.478424f, 334.349030f, 335.219138f, 336.088749f, 336.957865f,
+	337.826488f, 338.694620f, 339.562262f, 340.429417f, 341.296086f, 342.162270f,
+	343.027973f, 343.893194f, 344.757936f, 345.622200f, 346.485989f, 347.349302f,
+	348.212142f, 349.074511f, 349.936409f, 350.797837f, 351.658798f, 352.519292f,
+	353.379321f, 354.238885f, 355.097986f, 355.956625f, 356.814802f, 357.672519f,
+	358.529777f, 359.386576f, 360.242917f, 361.098802f, 361.954230f, 362.809202f,
+	363.663719f, 364.517782f, 365.371390f, 366.224545f, 367.077246f, 367.929494f,
+	368.781290f, 369.632632f, 370.483522f, 371.333960f, 372.183945f, 373.033477f,
+	373.882557f, 374.731183f, 375.579356f, 376.427075f, 377.274340f, 378.121151f,
+	378.967506f, 379.813405f, 380.658847f, 381.503833f, 382.348359f, 383.192427f,
+	384.036034f, 384.879179f, 385.721862f, 386.564081f, 387.405834f, 388.247121f,
+	389.087939f, 389.928287f, 390.768163f, 391.607566f, 392.446493f, 393.284942f,
+	394.122912f, 394.960400f, 395.797403f, 396.633921f, 397.469949f, 398.305485f,
+	399.140527f, 399.975072f,
+};
+
+const struct temp_lin_table temp_lin_tc_type_t = {
+	.x_min = -5.603f,
+	.x_scale = 19.3012276f,
+	.nb_points = 512,
+	.temps = temp_lin_tc_type_t_temps
+};
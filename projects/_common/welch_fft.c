@@ -0,0 +1,390 @@
+/***************************************************************************//**
+ * @file    welch_fft.c
+ * @brief   Streaming Welch spectrum averaging and converter performance metrics
+ * @details The samples are accumulated into 50% overlapping frames as they are
+ *          captured. The frames are double buffered: a complete frame is set
+ *          aside while the next one keeps filling, then it is windowed
+ *          (4-term Blackman-Harris), transformed with the CMSIS-DSP real FFT
+ *          and its power spectrum is added to the average. The metrics are
+ *          computed on request from the averaged spectrum, so the raw record
+ *          never needs to be stored.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <stdbool.h>
+#include "welch_fft.h"
+#include "no_os_alloc.h"
+
+/******************************************************************************/
+/********************* Macros and Constants Definitions ***********************/
+/******************************************************************************/
+
+/* Number of bins on either side of a tone spread by the window main lobe */
+#define WELCH_SPAN_BINS		5
+
+/* Highest harmonic included in the distortion */
+#define WELCH_MAX_HARMONIC	5
+
+/* Number of excluded spectrum regions (DC, fundamental and harmonics) */
+#define WELCH_MAX_REGIONS	(WELCH_MAX_HARMONIC + 1)
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Initialize the Welch FFT engine.
+ * @param	desc[out] - Welch FFT descriptor
+ * @param	param[in] - Welch FFT init parameters
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t welch_fft_init(struct welch_fft_desc **desc,
+		       struct welch_fft_init_param *param)
+{
+	struct welch_fft_desc *fft;
+	uint16_t n;
+	float phase;
+	int32_t ret;
+
+	if (!desc || !param || (param->full_scale <= 0)) {
+		return -EINVAL;
+	}
+
+	fft = no_os_calloc(1, sizeof(*fft));
+	if (!fft) {
+		return -ENOMEM;
+	}
+
+	/* Validates the FFT length as well */
+	if (arm_rfft_fast_init_f32(&fft->rfft, param->fft_len) != ARM_MATH_SUCCESS) {
+		ret = -EINVAL;
+		goto err_free;
+	}
+
+	fft->fft_len = param->fft_len;
+	fft->full_scale = param->full_scale;
+
+	fft->window = no_os_calloc(param->fft_len, sizeof(float));
+	fft->frames = no_os_calloc(2 * param->fft_len, sizeof(float));
+	fft->work = no_os_calloc(2 * param->fft_len, sizeof(float));
+	fft->psd = no_os_calloc(param->fft_len / 2 + 1, sizeof(float));
+	if (!fft->window || !fft->frames || !fft->work || !fft->psd) {
+		ret = -ENOMEM;
+		goto err_free;
+	}
+
+	/* 4-term Blackman-Harris window (-92dB side lobes) */
+	for (n = 0; n < param->fft_len; n++) {
+		phase = 2.0f * PI * n / param->fft_len;
+		fft->window[n] = 0.35875f - 0.48829f * cosf(phase) +
+				 0.14128f * cosf(2.0f * phase) - 0.01168f * cosf(3.0f * phase);
+		fft->window_power += fft->window[n] * fft->window[n];
+	}
+
+	fft->frame = fft->frames;
+
+	*desc = fft;
+
+	return 0;
+
+err_free:
+	welch_fft_remove(fft);
+	return ret;
+}
+
+/**
+ * @brief 	Free the resources allocated for the Welch FFT engine.
+ * @param	desc[in] - Welch FFT descriptor
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t welch_fft_remove(struct welch_fft_desc *desc)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	no_os_free(desc->window);
+	no_os_free(desc->frames);
+	no_os_free(desc->work);
+	no_os_free(desc->psd);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief 	Discard the averaged spectrum and start a new analysis.
+ * @param	desc[in] - Welch FFT descriptor
+ * @param	sample_rate[in] - Sample rate of the analyzed signal (Hz)
+ * @return 	0 in case of success, negative error code otherwise
+ */
+int32_t welch_fft_reset(struct welch_fft_desc *desc, float sample_rate)
+{
+	if (!desc) {
+		return -EINVAL;
+	}
+
+	desc->sample_rate = sample_rate;
+	desc->frame_fill = 0;
+	desc->pending = NULL;
+	desc->averages = 0;
+	memset(desc->psd, 0, (desc->fft_len / 2 + 1) * sizeof(float));
+
+	return 0;
+}
+
+/**
+ * @brief 	Drop the partially filled frame, the next samples pushed are not
+ *			contiguous with the previous ones.
+ * @param	desc[in] - Welch FFT descriptor
+ * @return 	None
+ */
+void welch_fft_restart_frame(struct welch_fft_desc *desc)
+{
+	if (!desc) {
+		return;
+	}
+
+	desc->frame_fill = 0;
+}
+
+/**
+ * @brief 	Add the power spectrum of the pending frame to the average.
+ * @param	desc[in] - Welch FFT descriptor
+ * @return 	None
+ * @note	Called once a frame is complete, possibly in between the captured
+ *			blocks. The frame being filled is not touched.
+ */
+void welch_fft_process(struct welch_fft_desc *desc)
+{
+	uint16_t half_len;
+	float *in;
+	float *out;
+	uint16_t k;
+
+	if (!desc || !desc->pending) {
+		return;
+	}
+
+	half_len = desc->fft_len / 2;
+	in = desc->work;
+	out = &desc->work[desc->fft_len];
+
+	arm_mult_f32(desc->pending, desc->window, in, desc->fft_len);
+	arm_rfft_fast_f32(&desc->rfft, in, out, 0);
+
+	/* DC and Nyquist bins are packed into the first complex value */
+	desc->psd[0] += out[0] * out[0];
+	desc->psd[half_len] += out[1] * out[1];
+	for (k = 1; k < half_len; k++) {
+		desc->psd[k] += out[2 * k] * out[2 * k] + out[2 * k + 1] * out[2 * k + 1];
+	}
+
+	desc->averages++;
+	desc->pending = NULL;
+}
+
+/**
+ * @brief 	Push the captured samples into the analysis.
+ * @param	desc[in] - Welch FFT descriptor
+ * @param	samples[in] - Samples (two's complement codes)
+ * @param	count[in] - Number of samples to push
+ * @param	stride[in] - Distance between consecutive samples (in samples)
+ * @return 	None
+ * @note	A complete frame is only set aside, it is added to the average by
+ *			welch_fft_process(). It is processed here only if a frame is
+ *			completed while the previous one is still pending.
+ */
+void welch_fft_push(struct welch_fft_desc *desc, const int32_t *samples,
+		    uint32_t count, uint32_t stride)
+{
+	uint16_t half_len;
+	float *next;
+
+	if (!desc || !samples) {
+		return;
+	}
+
+	half_len = desc->fft_len / 2;
+
+	for (; count; count--) {
+		desc->frame[desc->frame_fill++] = (float)*samples;
+		samples += stride;
+
+		if (desc->frame_fill == desc->fft_len) {
+			welch_fft_process(desc);
+
+			/* Second half of the frame starts the next (overlapping) frame,
+			 * which is filled in the other buffer */
+			next = (desc->frame == desc->frames) ?
+			       &desc->frames[desc->fft_len] : desc->frames;
+			memcpy(next, &desc->frame[half_len], half_len * sizeof(float));
+
+			desc->pending = desc->frame;
+			desc->frame = next;
+			desc->frame_fill = half_len;
+		}
+	}
+}
+
+/**
+ * @brief 	Sum the power of the spectrum region around a bin.
+ * @param	desc[in] - Welch FFT descriptor
+ * @param	center[in] - Center bin of the region
+ * @param	first[out] - First bin of the region
+ * @param	last[out] - Last bin of the region
+ * @return 	Power of the region
+ */
+static float welch_fft_region_power(struct welch_fft_desc *desc, int32_t center,
+				    int32_t *first, int32_t *last)
+{
+	float power = 0;
+	int32_t k;
+
+	*first = (center > WELCH_SPAN_BINS) ? center - WELCH_SPAN_BINS : 0;
+	*last = center + WELCH_SPAN_BINS;
+	if (*last > desc->fft_len / 2) {
+		*last = desc->fft_len / 2;
+	}
+
+	for (k = *first; k <= *last; k++) {
+		power += desc->psd[k];
+	}
+
+	return power;
+}
+
+/**
+ * @brief 	Compute the converter performance metrics of the averaged spectrum.
+ * @param	desc[in] - Welch FFT descriptor
+ * @param	metrics[out] - Performance metrics
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	The noise excludes DC, the fundamental and its harmonics (2nd to
+ *			5th, aliased into the first Nyquist zone) and is extrapolated over
+ *			the excluded bins.
+ */
+int32_t welch_fft_get_metrics(struct welch_fft_desc *desc,
+			      struct welch_fft_metrics *metrics)
+{
+	int32_t first[WELCH_MAX_REGIONS + 1];
+	int32_t last[WELCH_MAX_REGIONS + 1];
+	uint8_t regions = 0;
+	int32_t half_len;
+	int32_t fund = 0;
+	int32_t harm_bin;
+	int32_t k;
+	uint8_t harm;
+	uint8_t region;
+	bool excluded;
+	float signal;
+	float distortion = 0;
+	float noise = 0;
+	uint32_t noise_bins = 0;
+	float centroid = 0;
+	float amplitude_sq;
+
+	if (!desc || !metrics) {
+		return -EINVAL;
+	}
+
+	welch_fft_process(desc);
+
+	if (!desc->averages) {
+		return -ENODATA;
+	}
+
+	half_len = desc->fft_len / 2;
+
+	/* DC region */
+	welch_fft_region_power(desc, 0, &first[regions], &last[regions]);
+	regions++;
+
+	/* Fundamental is the largest bin outside of the DC region */
+	for (k = last[0] + 1; k <= half_len; k++) {
+		if (!fund || (desc->psd[k] > desc->psd[fund])) {
+			fund = k;
+		}
+	}
+
+	if (!fund) {
+		return -ENODATA;
+	}
+
+	signal = welch_fft_region_power(desc, fund, &first[regions], &last[regions]);
+	for (k = first[regions]; k <= last[regions]; k++) {
+		centroid += k * desc->psd[k];
+	}
+	regions++;
+
+	/* Harmonics, skipping the ones folding onto an already counted region */
+	for (harm = 2; harm <= WELCH_MAX_HARMONIC; harm++) {
+		harm_bin = (harm * fund) % desc->fft_len;
+		if (harm_bin > half_len) {
+			harm_bin = desc->fft_len - harm_bin;
+		}
+
+		excluded = false;
+		for (region = 0; region < regions; region++) {
+			if ((harm_bin + WELCH_SPAN_BINS >= first[region])
+			    && (harm_bin - WELCH_SPAN_BINS <= last[region])) {
+				excluded = true;
+				break;
+			}
+		}
+		if (excluded) {
+			continue;
+		}
+
+		distortion += welch_fft_region_power(desc, harm_bin, &first[regions],
+						     &last[regions]);
+		regions++;
+	}
+
+	/* Noise is the power of all remaining bins */
+	for (k = last[0] + 1; k <= half_len; k++) {
+		excluded = false;
+		for (region = 1; region < regions; region++) {
+			if ((k >= first[region]) && (k <= last[region])) {
+				excluded = true;
+				break;
+			}
+		}
+
+		if (!excluded) {
+			noise += desc->psd[k];
+			noise_bins++;
+		}
+	}
+
+	if (!noise_bins || (signal <= 0)) {
+		return -ENODATA;
+	}
+
+	noise *= (float)(half_len - last[0]) / noise_bins;
+
+	metrics->snr = 10.0f * log10f(signal / noise);
+	metrics->sinad = 10.0f * log10f(signal / (noise + distortion));
+	metrics->thd = (distortion > 0) ? 10.0f * log10f(distortion / signal) : -INFINITY;
+	metrics->enob = (metrics->sinad - 1.76f) / 6.02f;
+	metrics->fund_freq = (centroid / signal) * desc->sample_rate / desc->fft_len;
+
+	/* Sine of amplitude A spreads A^2/4 * N * sum(w^2) over its bins */
+	amplitude_sq = 4.0f * (signal / desc->averages) /
+		       (desc->fft_len * desc->window_power);
+	metrics->fund_dbfs = 10.0f * log10f(amplitude_sq /
+					    (desc->full_scale * desc->full_scale));
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+/***************************************************************************//**
+ * @file    welch_fft.h
+ * @brief   Streaming Welch spectrum averaging and converter performance metrics
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _WELCH_FFT_H_
+#define _WELCH_FFT_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "arm_math.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct welch_fft_init_param
+ * @brief Welch FFT initialization parameters
+ */
+struct welch_fft_init_param {
+	/* FFT length (power of 2, 32 to 4096) */
+	uint16_t fft_len;
+	/* Full scale amplitude (in codes) of the analyzed signal */
+	float full_scale;
+};
+
+/**
+ * @struct welch_fft_metrics
+ * @brief Converter performance metrics of the averaged spectrum
+ */
+struct welch_fft_metrics {
+	/* Signal to noise ratio (dB) */
+	float snr;
+	/* Signal to noise and distortion ratio (dB) */
+	float sinad;
+	/* Total harmonic distortion (dB) */
+	float thd;
+	/* Effective number of bits */
+	float enob;
+	/* Fundamental frequency (Hz) */
+	float fund_freq;
+	/* Fundamental amplitude (dBFS) */
+	float fund_dbfs;
+};
+
+/**
+ * @struct welch_fft_desc
+ * @brief Welch FFT descriptor
+ */
+struct welch_fft_desc {
+	uint16_t fft_len;
+	float full_scale;
+	/* Sample rate of the analyzed signal (Hz) */
+	float sample_rate;
+	/* CMSIS-DSP real FFT instance */
+	arm_rfft_fast_instance_f32 rfft;
+	/* Window coefficients and their sum of squares */
+	float *window;
+	float window_power;
+	/* Double buffered frames (50% overlapping): one is being filled while
+	 * the other holds the last complete frame until it is processed */
+	float *frames;
+	/* Frame being filled */
+	float *frame;
+	uint16_t frame_fill;
+	/* Complete frame waiting to be processed (NULL if none) */
+	float *pending;
+	/* FFT input/output work area */
+	float *work;
+	/* Accumulated power spectrum (fft_len / 2 + 1 bins) */
+	float *psd;
+	/* Number of spectra accumulated */
+	uint32_t averages;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int32_t welch_fft_init(struct welch_fft_desc **desc,
+		       struct welch_fft_init_param *param);
+int32_t welch_fft_remove(struct welch_fft_desc *desc);
+int32_t welch_fft_reset(struct welch_fft_desc *desc, float sample_rate);
+void welch_fft_restart_frame(struct welch_fft_desc *desc);
+void welch_fft_push(struct welch_fft_desc *desc, const int32_t *samples,
+		    uint32_t count, uint32_t stride);
+void welch_fft_process(struct welch_fft_desc *desc);
+int32_t welch_fft_get_metrics(struct welch_fft_desc *desc,
+			      struct welch_fft_metrics *metrics);
+
+#endif // _WELCH_FFT_H_
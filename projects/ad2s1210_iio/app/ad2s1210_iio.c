@@ -20,16 +20,20 @@
 #include <string.h>
 #include <errno.h>
 #include <limits.h>
+#include <math.h>
 
 #include "iio.h"
 #include "iio_trigger.h"
 
 #include "ad2s1210_iio.h"
+#include "ad2s1210_observer.h"
 #include "app_config.h"
 #include "ad2s1210_user_config.h"
 #include "common.h"
+#include "burst_capture.h"
 #include "no_os_error.h"
 #include "no_os_util.h"
+#include "no_os_irq.h"
 
 /******** Forward declaration of getter/setter functions ********/
 static int iio_ad2s1210_attr_get(void *device, char *buf, uint32_t len,
@@ -50,12 +54,12 @@ static int iio_ad2s1210_attr_set(void *device, char *buf, uint32_t len,
 	.store = iio_ad2s1210_attr_set\
 }
 
-#define AD2S1210_CH(_name, _idx, _type, _ch_out) {\
+#define AD2S1210_CH(_name, _idx, _type, _num, _ch_out) {\
 	.name = _name, \
 	.ch_type = _type,\
 	.ch_out = _ch_out,\
 	.indexed = true,\
-	.channel = 0,\
+	.channel = _num,\
 	.scan_index = _idx,\
 	.scan_type = &chn_scan[_idx],\
 	.attributes = &ad2s1210_iio_ch_attributes[_idx][0]\
@@ -71,6 +75,54 @@ static int iio_ad2s1210_attr_set(void *device, char *buf, uint32_t len,
 
 #define AD2S1210_IIO_TRIGGER_NAME         "ad2s1210_iio_trigger"
 
+/* Scan index of the channels */
+#define POSITION_CHN_IDX	0
+#define VELOCITY_CHN_IDX	1
+#define EXCITATION_CHN_IDX	2
+#define MULTITURN_CHN_IDX	3
+#define TIMESTAMP_CHN_IDX	4
+#define SPEED_CHN_IDX		5
+#define ACCEL_CHN_IDX		6
+
+/* Channel number of the multi-turn position (angl1) */
+#define MULTITURN_CHN_NUM	1
+
+/* Channel number of the observer speed (anglvel1) */
+#define SPEED_CHN_NUM		1
+
+#define MULTITURN_CHN_MASK	NO_OS_BIT(MULTITURN_CHN_IDX)
+#define TIMESTAMP_CHN_MASK	NO_OS_BIT(TIMESTAMP_CHN_IDX)
+#define SPEED_CHN_MASK		NO_OS_BIT(SPEED_CHN_IDX)
+#define ACCEL_CHN_MASK		NO_OS_BIT(ACCEL_CHN_IDX)
+
+/* Channels computed by the tracking observer */
+#define OBSERVER_CHN_MASK	(SPEED_CHN_MASK | ACCEL_CHN_MASK)
+
+/* 32-bit channels, following the device channels in the scan */
+#define WORD_CHN_MASK	\
+	(MULTITURN_CHN_MASK | TIMESTAMP_CHN_MASK | OBSERVER_CHN_MASK)
+
+/* Channels read from the device by ad2s1210_spi_single_conversion() */
+#define AD2S1210_READ_CHN_MASK	(AD2S1210_POS_MASK | AD2S1210_VEL_MASK)
+
+/* Number of bytes of the 32-bit channels */
+#define BYTES_PER_WORD		4
+
+/* Max number of bytes per scan (all the channels enabled) */
+#define MAX_BYTES_PER_SCAN	(2 * BYTES_PER_SAMPLE + 4 * BYTES_PER_WORD)
+
+/* Max ratio of the conversions to the scans pushed to the IIO buffer */
+#define MAX_DECIMATION_RATIO	64
+
+/* Default tracking bandwidth of the observer (Hz) */
+#define DEFAULT_OBSERVER_BW		100
+
+/* Number of scans staged before committing to the IIO buffer in burst mode */
+#define BURST_BLOCK_SCANS	64
+
+/* Polls of the conversion trigger before the timer is considered stopped */
+#define TIMER_PACING_TIMEOUT	0xFFFFFF
+
 /* data buffer size */
 #if defined(USE_SDRAM)
 #define data_buffer				SDRAM_START_ADDRESS
@@ -96,6 +148,63 @@ uint32_t active_chn_count;
 static struct iio_hw_trig *ad2s1210_hw_trig_desc;
 #endif
 
+/* Channels of the ongoing capture */
+static uint32_t ad2s1210_scan_mask;
+
+/* Channels read from the device for the ongoing capture */
+static uint32_t ad2s1210_read_mask;
+
+/* Multi-turn position (16-bit turn fraction, turns in the upper bits) */
+static int32_t ad2s1210_multiturn;
+
+/* Last position unwrapped into the multi-turn position */
+static uint16_t ad2s1210_last_position;
+
+/* Multi-turn position tracking started */
+static bool ad2s1210_multiturn_valid;
+
+/* Number of conversions of the ongoing/last capture */
+static uint32_t ad2s1210_scan_count;
+
+/* Timestamp of the last conversion */
+static uint32_t ad2s1210_last_ticks;
+
+/* Cycle counter ticks elapsed between the first and the last conversion */
+static uint64_t ad2s1210_capture_ticks;
+
+/* Tracking observer, run on every position conversion */
+static struct ad2s1210_observer ad2s1210_observer;
+
+/* Tracking bandwidth of the observer (Hz) */
+static uint32_t ad2s1210_observer_bw = DEFAULT_OBSERVER_BW;
+
+/* Number of conversions per scan pushed to the IIO buffer */
+static uint16_t ad2s1210_decimation = 1;
+
+/* Conversions since the last scan pushed to the IIO buffer (trigger mode) */
+static uint16_t ad2s1210_decimation_phase;
+
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+static int32_t ad2s1210_read_scan(void *ctx, void *dst);
+
+/* Block-batched burst capture init parameters */
+static struct burst_capture_init_param burst_capture_init_params = {
+	.read_unit = ad2s1210_read_scan,
+	.block_units = BURST_BLOCK_SCANS,
+};
+
+/* Block-batched burst capture descriptor */
+static struct burst_capture_desc *ad2s1210_burst_desc;
+#endif
+
+#if defined(TIMER_PACED_BURST_CAPTURE)
+/* Number of conversion trigger (timer) edges */
+static volatile uint32_t ad2s1210_timer_edges;
+
+/* Number of timer edges consumed by the burst capture */
+static uint32_t ad2s1210_timer_edges_seen;
+#endif
+
 enum ad2s1210_attribute_id {
 	RAW_ATTR_ID,
 	SCALE_ATTR_ID,
@@ -105,6 +214,10 @@ enum ad2s1210_attribute_id {
 	HYSTERESIS_AVAILABLE_ATTR_ID,
 	FREQ_ATTR_ID,
 	FREQ_AVAIL_ATTR_ID,
+	ACHIEVED_SAMPLING_FREQ_ATTR_ID,
+	DECIMATION_RATIO_ATTR_ID,
+	OBSERVER_BW_ATTR_ID,
+	RPM_ATTR_ID,
 };
 
 struct scan_type chn_scan[RESOLVER_CHANNELS] = {
@@ -129,6 +242,34 @@ struct scan_type chn_scan[RESOLVER_CHANNELS] = {
 		.shift = 0,
 		.is_big_endian = false,
 	},
+	{
+		.sign = 's',
+		.realbits = BYTES_PER_WORD * 8,
+		.storagebits = BYTES_PER_WORD * 8,
+		.shift = 0,
+		.is_big_endian = false,
+	},
+	{
+		.sign = 'u',
+		.realbits = BYTES_PER_WORD * 8,
+		.storagebits = BYTES_PER_WORD * 8,
+		.shift = 0,
+		.is_big_endian = false,
+	},
+	{
+		.sign = 's',
+		.realbits = BYTES_PER_WORD * 8,
+		.storagebits = BYTES_PER_WORD * 8,
+		.shift = 0,
+		.is_big_endian = false,
+	},
+	{
+		.sign = 's',
+		.realbits = BYTES_PER_WORD * 8,
+		.storagebits = BYTES_PER_WORD * 8,
+		.shift = 0,
+		.is_big_endian = false,
+	},
 };
 
 /* IIO channels attributes list */
@@ -154,19 +295,53 @@ static struct iio_attribute
 		AD2S1210_CHN_ATTR("label", LABEL_ATTR_ID),
 		END_ATTRIBUTES_ARRAY
 	},
+	{
+		AD2S1210_CHN_ATTR("label", LABEL_ATTR_ID),
+		AD2S1210_CHN_ATTR("raw", RAW_ATTR_ID),
+		AD2S1210_CHN_ATTR("scale", SCALE_ATTR_ID),
+		END_ATTRIBUTES_ARRAY
+	},
+	{
+		AD2S1210_CHN_ATTR("label", LABEL_ATTR_ID),
+		AD2S1210_CHN_ATTR("raw", RAW_ATTR_ID),
+		AD2S1210_CHN_ATTR("scale", SCALE_ATTR_ID),
+		END_ATTRIBUTES_ARRAY
+	},
+	{
+		AD2S1210_CHN_ATTR("label", LABEL_ATTR_ID),
+		AD2S1210_CHN_ATTR("raw", RAW_ATTR_ID),
+		AD2S1210_CHN_ATTR("rpm", RPM_ATTR_ID),
+		AD2S1210_CHN_ATTR("scale", SCALE_ATTR_ID),
+		END_ATTRIBUTES_ARRAY
+	},
+	{
+		AD2S1210_CHN_ATTR("label", LABEL_ATTR_ID),
+		AD2S1210_CHN_ATTR("raw", RAW_ATTR_ID),
+		AD2S1210_CHN_ATTR("scale", SCALE_ATTR_ID),
+		END_ATTRIBUTES_ARRAY
+	},
 };
 
 /* IIO device (global) attributes list */
 static struct iio_attribute ad2s1210_iio_global_attributes[] = {
 	AD2S1210_CHN_ATTR("sampling_frequency", SAMPLING_FREQ_ATTR_ID),
+	AD2S1210_CHN_ATTR("achieved_sampling_frequency",
+			  ACHIEVED_SAMPLING_FREQ_ATTR_ID),
+	AD2S1210_CHN_ATTR("decimation_ratio", DECIMATION_RATIO_ATTR_ID),
+	AD2S1210_CHN_ATTR("observer_bandwidth", OBSERVER_BW_ATTR_ID),
 	END_ATTRIBUTES_ARRAY
 };
 
 /* IIO channels info */
 static struct iio_channel ad2s1210_iio_channels[RESOLVER_CHANNELS] = {
-	AD2S1210_CH("position", 0, IIO_ANGL, false),
-	AD2S1210_CH("velocity", 1, IIO_ANGL_VEL, false),
-	AD2S1210_CH("altvoltage", 2, IIO_ALTVOLTAGE, true)
+	AD2S1210_CH("position", POSITION_CHN_IDX, IIO_ANGL, 0, false),
+	AD2S1210_CH("velocity", VELOCITY_CHN_IDX, IIO_ANGL_VEL, 0, false),
+	AD2S1210_CH("altvoltage", EXCITATION_CHN_IDX, IIO_ALTVOLTAGE, 0, true),
+	AD2S1210_CH("multiturn", MULTITURN_CHN_IDX, IIO_ANGL, MULTITURN_CHN_NUM,
+		    false),
+	AD2S1210_CH("timestamp", TIMESTAMP_CHN_IDX, IIO_COUNT, 0, false),
+	AD2S1210_CH("speed", SPEED_CHN_IDX, IIO_ANGL_VEL, SPEED_CHN_NUM, false),
+	AD2S1210_CH("acceleration", ACCEL_CHN_IDX, IIO_ACCEL, 0, false)
 };
 
 /* Flag to indicate if size of the buffer is updated according to requested
@@ -181,6 +356,236 @@ static const float ad2s1210_velocity_scale[] = {
 	AD2S1210_TRACKING_RATE_16BIT,
 };
 
+/**
+ * @brief	Unwrap the position into the multi-turn position
+ * @param	position[in] - Position (16-bit turn fraction)
+ * @return	none
+ * @note	The shaft must turn less than half a turn between two positions.
+ */
+static void ad2s1210_unwrap_position(uint16_t position)
+{
+	if (!ad2s1210_multiturn_valid) {
+		/* Start counting from the turn 0 */
+		ad2s1210_multiturn = position;
+		ad2s1210_multiturn_valid = true;
+	} else {
+		ad2s1210_multiturn += (int16_t)(position - ad2s1210_last_position);
+	}
+
+	ad2s1210_last_position = position;
+}
+
+/**
+ * @brief	Get the number of bytes per scan of the channels
+ * @param	chn_mask[in] - Channels select mask
+ * @return	Number of bytes per scan
+ * @note	The 32-bit channels are aligned on 4 bytes within the scan (as laid
+ *			out by the IIO clients).
+ */
+static uint32_t ad2s1210_scan_size(uint32_t chn_mask)
+{
+	uint32_t size = 0;
+
+	if (chn_mask & AD2S1210_POS_MASK) {
+		size += BYTES_PER_SAMPLE;
+	}
+
+	if (chn_mask & AD2S1210_VEL_MASK) {
+		size += BYTES_PER_SAMPLE;
+	}
+
+	if (chn_mask & WORD_CHN_MASK) {
+		size = (size + BYTES_PER_WORD - 1) & ~(BYTES_PER_WORD - 1);
+		size += BYTES_PER_WORD * __builtin_popcount(chn_mask & WORD_CHN_MASK);
+	}
+
+	return size;
+}
+
+#if defined(TIMER_PACED_BURST_CAPTURE)
+/**
+ * @brief	Conversion trigger (timer) interrupt callback
+ * @param	context[in] - Callback context (unused)
+ * @return	none
+ */
+void ad2s1210_timer_callback(void *context)
+{
+	ad2s1210_timer_edges++;
+}
+
+/**
+ * @brief	Wait for the next conversion trigger (timer) edge
+ * @return	0 in case of success, negative error code otherwise
+ * @note	The edges elapsed while the previous scan was captured are skipped,
+ *			which shows up in the achieved sampling frequency.
+ */
+static int32_t ad2s1210_wait_timer(void)
+{
+	uint32_t timeout = TIMER_PACING_TIMEOUT;
+
+	while (ad2s1210_timer_edges == ad2s1210_timer_edges_seen) {
+		if (!--timeout) {
+			return -ETIMEDOUT;
+		}
+	}
+
+	ad2s1210_timer_edges_seen = ad2s1210_timer_edges;
+
+	return 0;
+}
+#endif
+
+/**
+ * @brief	Run a conversion for the ongoing capture
+ * @param	data[out] - Channels read from the device (big endian)
+ * @param	ticks[out] - Cycle counter timestamp of the conversion
+ * @return	0 in case of success, negative error code otherwise
+ * @details	The position also feeds the multi-turn position and the tracking
+ *			observer, which run on every conversion, decimated or not.
+ */
+static int32_t ad2s1210_convert(uint16_t *data, uint32_t *ticks)
+{
+	uint16_t position;
+	int32_t ret;
+
+#if defined(TIMER_PACED_BURST_CAPTURE)
+	ret = ad2s1210_wait_timer();
+	if (ret) {
+		return ret;
+	}
+#endif
+
+	/* The conversion is started (SAMPLE pulse) right after the timestamp */
+	*ticks = cycle_counter_get();
+
+	if (ad2s1210_read_mask) {
+		ret = ad2s1210_spi_single_conversion(ad2s1210_dev_inst, ad2s1210_read_mask,
+						     data, 2 * BYTES_PER_SAMPLE);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	if (ad2s1210_read_mask & AD2S1210_POS_MASK) {
+		position = no_os_get_unaligned_be16((uint8_t *)&data[0]);
+		ad2s1210_unwrap_position(position);
+
+		if (ad2s1210_scan_mask & OBSERVER_CHN_MASK) {
+			ad2s1210_observer_update(&ad2s1210_observer, position);
+		}
+	}
+
+	/* Accumulate per conversion so that the cycle counter wrap-around is
+	 * accounted for */
+	if (ad2s1210_scan_count) {
+		ad2s1210_capture_ticks += (uint32_t)(*ticks - ad2s1210_last_ticks);
+	}
+	ad2s1210_last_ticks = *ticks;
+	ad2s1210_scan_count++;
+
+	return 0;
+}
+
+/**
+ * @brief	Pack the active channels into a scan
+ * @param	data[in] - Channels read from the device (big endian)
+ * @param	ticks[in] - Cycle counter timestamp of the conversion
+ * @param	scan[out] - Scan data (ad2s1210_scan_size() bytes)
+ * @return	none
+ * @details	The position and velocity are stored as read from the device (big
+ *			endian), followed by the 32-bit channels (CPU endianness, i.e.
+ *			little endian, 4 bytes aligned).
+ */
+static void ad2s1210_pack_scan(const uint16_t *data, uint32_t ticks,
+			       uint8_t *scan)
+{
+	uint32_t offset = 0;
+	uint8_t idx = 0;
+	int32_t value;
+
+	if (ad2s1210_read_mask & AD2S1210_POS_MASK) {
+		if (ad2s1210_scan_mask & AD2S1210_POS_MASK) {
+			memcpy(&scan[offset], &data[idx], BYTES_PER_SAMPLE);
+			offset += BYTES_PER_SAMPLE;
+		}
+		idx++;
+	}
+
+	if (ad2s1210_scan_mask & AD2S1210_VEL_MASK) {
+		memcpy(&scan[offset], &data[idx], BYTES_PER_SAMPLE);
+		offset += BYTES_PER_SAMPLE;
+	}
+
+	if (ad2s1210_scan_mask & WORD_CHN_MASK) {
+		for (; offset % BYTES_PER_WORD; offset++) {
+			scan[offset] = 0;
+		}
+	}
+
+	if (ad2s1210_scan_mask & MULTITURN_CHN_MASK) {
+		memcpy(&scan[offset], &ad2s1210_multiturn, BYTES_PER_WORD);
+		offset += BYTES_PER_WORD;
+	}
+
+	if (ad2s1210_scan_mask & TIMESTAMP_CHN_MASK) {
+		memcpy(&scan[offset], &ticks, BYTES_PER_WORD);
+		offset += BYTES_PER_WORD;
+	}
+
+	if (ad2s1210_scan_mask & SPEED_CHN_MASK) {
+		value = ad2s1210_observer_speed(&ad2s1210_observer);
+		memcpy(&scan[offset], &value, BYTES_PER_WORD);
+		offset += BYTES_PER_WORD;
+	}
+
+	if (ad2s1210_scan_mask & ACCEL_CHN_MASK) {
+		value = ad2s1210_observer_accel(&ad2s1210_observer);
+		memcpy(&scan[offset], &value, BYTES_PER_WORD);
+	}
+}
+
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+/**
+ * @brief	Capture a scan of the active channels
+ * @param	ctx[in] - Unused
+ * @param	dst[out] - Scan data (ad2s1210_scan_size() bytes)
+ * @return	0 in case of success, negative error code otherwise
+ * @note	With decimation, the scan holds the last of the conversions run.
+ */
+static int32_t ad2s1210_read_scan(void *ctx, void *dst)
+{
+	uint16_t data[2];
+	uint32_t ticks;
+	uint16_t i;
+	int32_t ret;
+
+	for (i = 0; i < ad2s1210_decimation; i++) {
+		ret = ad2s1210_convert(data, &ticks);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	ad2s1210_pack_scan(data, ticks, dst);
+
+	return 0;
+}
+#endif
+
+/**
+ * @brief	Get the scan rate achieved during the ongoing/last capture
+ * @return	Scans per second (0 if not measured)
+ */
+static uint32_t ad2s1210_achieved_rate(void)
+{
+	if (ad2s1210_scan_count < 2 || !ad2s1210_capture_ticks) {
+		return 0;
+	}
+
+	return (uint32_t)(((uint64_t)(ad2s1210_scan_count - 1) * cycle_counter_freq()) /
+			  (ad2s1210_capture_ticks * ad2s1210_decimation));
+}
+
 
 /*!
  * @brief       Getter functions for AD2S1210 attributes
@@ -210,6 +615,19 @@ static int iio_ad2s1210_attr_get(void *device, char *buf, uint32_t len,
 
 	switch (priv) {
 	case RAW_ATTR_ID:
+		if (channel->type == IIO_COUNT) {
+			return sprintf(buf, "%lu", (unsigned long)cycle_counter_get());
+		}
+
+		/* Observer estimates of the ongoing/last capture */
+		if (channel->type == IIO_ANGL_VEL && channel->ch_num == SPEED_CHN_NUM) {
+			return sprintf(buf, "%ld",
+				       (long)ad2s1210_observer_speed(&ad2s1210_observer));
+		} else if (channel->type == IIO_ACCEL) {
+			return sprintf(buf, "%ld",
+				       (long)ad2s1210_observer_accel(&ad2s1210_observer));
+		}
+
 		ret = ad2s1210_spi_single_conversion(device, active_mask,
 						     data, sizeof(data));
 		if (ret) {
@@ -223,22 +641,62 @@ static int iio_ad2s1210_attr_get(void *device, char *buf, uint32_t len,
 			return sprintf(buf, "%d", (int16_t)data_cpu);
 		}
 
+		if (channel->ch_num == MULTITURN_CHN_NUM) {
+			/* Tracks the turns for as long as read at least twice a turn */
+			ad2s1210_unwrap_position(data_cpu);
+			return sprintf(buf, "%ld", (long)ad2s1210_multiturn);
+		}
+
 		return sprintf(buf, "%u", data_cpu);
 	case SCALE_ATTR_ID:
+		/* The observer runs at the conversion rate */
+		if (channel->type == IIO_ANGL_VEL && channel->ch_num == SPEED_CHN_NUM) {
+			return snprintf(buf, len, "%.10f",
+					ldexpf(2 * MATH_PI * SAMPLING_RATE,
+					       -AD2S1210_OBSERVER_SPEED_BITS));
+		} else if (channel->type == IIO_ACCEL) {
+			return snprintf(buf, len, "%.10f",
+					ldexpf(2 * MATH_PI * SAMPLING_RATE * (float)SAMPLING_RATE,
+					       -AD2S1210_OBSERVER_ACCEL_BITS));
+		}
+
 		if (channel->type == IIO_ANGL_VEL) {
 			rps_max = ad2s1210_velocity_scale[dev->resolution];
 			scale = 2 * MATH_PI * rps_max / (SHRT_MAX + 1);
+		} else if (channel->type == IIO_COUNT) {
+			/* Timestamp in nanoseconds */
+			scale = 1000000000.0f / cycle_counter_freq();
 		}
 
 		return snprintf(buf, len, "%10f", scale);
 
 	case SAMPLING_FREQ_ATTR_ID:
-		return snprintf(buf, len, "%d", SAMPLING_RATE);
+		/* Rate of the scans pushed to the IIO buffer */
+		return snprintf(buf, len, "%d", SAMPLING_RATE / ad2s1210_decimation);
+	case ACHIEVED_SAMPLING_FREQ_ATTR_ID:
+		return snprintf(buf, len, "%lu", (unsigned long)ad2s1210_achieved_rate());
+	case DECIMATION_RATIO_ATTR_ID:
+		return snprintf(buf, len, "%u", ad2s1210_decimation);
+	case OBSERVER_BW_ATTR_ID:
+		return snprintf(buf, len, "%lu", (unsigned long)ad2s1210_observer_bw);
+	case RPM_ATTR_ID:
+		return snprintf(buf, len, "%f",
+				ldexpf(60.0f * SAMPLING_RATE *
+				       ad2s1210_observer_speed(&ad2s1210_observer),
+				       -AD2S1210_OBSERVER_SPEED_BITS));
 	case LABEL_ATTR_ID:
-		if (channel->type == IIO_ANGL_VEL) {
+		if (channel->type == IIO_ANGL_VEL && channel->ch_num == SPEED_CHN_NUM) {
+			return snprintf(buf, len, "speed");
+		} else if (channel->type == IIO_ACCEL) {
+			return snprintf(buf, len, "acceleration");
+		} else if (channel->type == IIO_ANGL_VEL) {
 			return snprintf(buf, len, "velocity");
 		} else if (channel->type == IIO_ALTVOLTAGE) {
 			return snprintf(buf, len, "excitation");
+		} else if (channel->type == IIO_COUNT) {
+			return snprintf(buf, len, "timestamp");
+		} else if (channel->ch_num == MULTITURN_CHN_NUM) {
+			return snprintf(buf, len, "multiturn");
 		}
 		return snprintf(buf, len, "position");
 
@@ -284,6 +742,8 @@ static int iio_ad2s1210_attr_set(void *device, char *buf, uint32_t len,
 				 intptr_t priv)
 {
 	struct ad2s1210_dev *dev = (struct ad2s1210_dev *) device;
+	unsigned long bandwidth;
+	uint16_t decimation;
 	uint16_t fexcit;
 	uint8_t hysteresis;
 	int ret;
@@ -294,8 +754,34 @@ static int iio_ad2s1210_attr_set(void *device, char *buf, uint32_t len,
 	case LABEL_ATTR_ID:
 	case HYSTERESIS_AVAILABLE_ATTR_ID:
 	case FREQ_AVAIL_ATTR_ID:
+	case ACHIEVED_SAMPLING_FREQ_ATTR_ID:
+	case RPM_ATTR_ID:
 		/* All read-only attributes */
 		break;
+	case DECIMATION_RATIO_ATTR_ID:
+		ret = sscanf(buf, "%hu", &decimation);
+		if (ret != 1 || !decimation || decimation > MAX_DECIMATION_RATIO) {
+			return -EINVAL;
+		}
+
+		ad2s1210_decimation = decimation;
+		break;
+
+	case OBSERVER_BW_ATTR_ID:
+		ret = sscanf(buf, "%lu", &bandwidth);
+		if (ret != 1) {
+			return -EINVAL;
+		}
+
+		ret = ad2s1210_observer_set_bandwidth(&ad2s1210_observer, bandwidth,
+						      SAMPLING_RATE);
+		if (ret) {
+			return ret;
+		}
+
+		ad2s1210_observer_bw = bandwidth;
+		break;
+
 	case FREQ_ATTR_ID:
 		ret = sscanf(buf, "%hu", &fexcit);
 		if (ret != 1) {
@@ -360,35 +846,23 @@ static int32_t iio_ad2s1210_debug_reg_write(void *dev, uint32_t reg,
  */
 static int32_t iio_ad2s1210_submit_buffer(struct iio_device_data *iio_dev_data)
 {
-
-	uint32_t sample_indx = 0;
-	uint32_t nb_of_samples;
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	uint32_t nb_of_scans;
 	int32_t ret;
-	uint16_t data[2];
-	uint8_t i;
 
-#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
-	nb_of_samples = iio_dev_data->buffer->size / BYTES_PER_SAMPLE;
+	nb_of_scans = iio_dev_data->buffer->size /
+		      iio_dev_data->buffer->bytes_per_scan;
 
 	if (!buf_size_updated) {
 		iio_dev_data->buffer->buf->size = iio_dev_data->buffer->size;
 		buf_size_updated = true;
 	}
 
-	/* Push into circular buffer */
-	while (sample_indx < nb_of_samples) {
-		ret = ad2s1210_spi_single_conversion(ad2s1210_dev_inst,
-						     iio_dev_data->buffer->active_mask,
-						     data, sizeof(data));
-		if (ret) {
-			return ret;
-		}
-		ret = no_os_cb_write(iio_dev_data->buffer->buf, data,
-				     BYTES_PER_SAMPLE * active_chn_count);
-		if (ret) {
-			return ret;
-		}
-		sample_indx++;
+	/* Scans are committed to the IIO buffer in blocks */
+	ret = burst_capture_read(ad2s1210_burst_desc, iio_dev_data->buffer->buf,
+				 nb_of_scans);
+	if (ret) {
+		return ret;
 	}
 #endif
 	return 0;
@@ -405,13 +879,45 @@ static int32_t iio_ad2s1210_prepare_transfer(void *dev_instance,
 {
 	int32_t ret;
 
+	active_chn_count = __builtin_popcount(chn_mask);
+
+	/* The position is read for the multi-turn position and the observer
+	 * too, which start over with every capture */
+	ad2s1210_scan_mask = chn_mask;
+	ad2s1210_read_mask = chn_mask & AD2S1210_READ_CHN_MASK;
+	if (chn_mask & (MULTITURN_CHN_MASK | OBSERVER_CHN_MASK)) {
+		ad2s1210_read_mask |= AD2S1210_POS_MASK;
+	}
+	ad2s1210_multiturn_valid = false;
+	ad2s1210_observer_reset(&ad2s1210_observer);
+	ad2s1210_decimation_phase = 0;
+
+	ad2s1210_scan_count = 0;
+	ad2s1210_capture_ticks = 0;
+
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	burst_capture_init_params.unit_size = ad2s1210_scan_size(chn_mask);
+	ret = burst_capture_init(&ad2s1210_burst_desc, &burst_capture_init_params);
+	if (ret) {
+		return ret;
+	}
+#endif
+
+#if defined(TIMER_PACED_BURST_CAPTURE)
+	/* Wait for the timer edges from now on */
+	ad2s1210_timer_edges_seen = ad2s1210_timer_edges;
+	ret = no_os_irq_enable(trigger_irq_desc, TRIGGER_INT_ID);
+	if (ret) {
+		return ret;
+	}
+#endif
+
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 	ret = iio_trig_enable(ad2s1210_hw_trig_desc);
 	if (ret) {
 		return ret;
 	}
 #endif
-	active_chn_count = __builtin_popcount(chn_mask);
 
 	return 0;
 }
@@ -431,6 +937,21 @@ static int32_t iio_ad2s1210_end_transfer(void *dev)
 		return ret;
 	}
 #endif
+
+#if defined(TIMER_PACED_BURST_CAPTURE)
+	ret = no_os_irq_disable(trigger_irq_desc, TRIGGER_INT_ID);
+	if (ret) {
+		return ret;
+	}
+#endif
+
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	ret = burst_capture_remove(ad2s1210_burst_desc);
+	ad2s1210_burst_desc = NULL;
+	if (ret) {
+		return ret;
+	}
+#endif
 	return 0;
 }
 
@@ -441,8 +962,10 @@ static int32_t iio_ad2s1210_end_transfer(void *dev)
  */
 int32_t ad2s1210_trigger_handler(struct iio_device_data *iio_dev_data)
 {
-	int32_t ret;
+	uint8_t scan[MAX_BYTES_PER_SCAN];
 	uint16_t data[2];
+	uint32_t ticks;
+	int32_t ret;
 
 	if (!buf_size_updated) {
 		/* Update total buffer size according to bytes per scan for
@@ -454,15 +977,21 @@ int32_t ad2s1210_trigger_handler(struct iio_device_data *iio_dev_data)
 		buf_size_updated = true;
 	}
 
-	ret = ad2s1210_spi_single_conversion(ad2s1210_dev_inst,
-					     iio_dev_data->buffer->active_mask,
-					     data, sizeof(data));
+	ret = ad2s1210_convert(data, &ticks);
 	if (ret) {
 		return ret;
 	}
 
-	ret = no_os_cb_write(iio_dev_data->buffer->buf, data,
-			     BYTES_PER_SAMPLE * active_chn_count);
+	/* Push the last conversion of every decimation period */
+	if (++ad2s1210_decimation_phase < ad2s1210_decimation) {
+		return 0;
+	}
+	ad2s1210_decimation_phase = 0;
+
+	ad2s1210_pack_scan(data, ticks, scan);
+
+	ret = no_os_cb_write(iio_dev_data->buffer->buf, scan,
+			     iio_dev_data->buffer->bytes_per_scan);
 	if (ret) {
 		return ret;
 	}
@@ -643,13 +1172,25 @@ int32_t ad2s1210_iio_initialize(void)
 	if (init_status) {
 		return init_status;
 	}
+#endif
 
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) || defined(TIMER_PACED_BURST_CAPTURE)
 	/* Initialize the PWM trigger source for periodic RESOLVER sampling */
 	init_status = init_pwm_trigger();
 	if (init_status) {
 		return init_status;
 	}
 #endif
+
+	/* Timestamp and achieved sampling rate time base */
+	cycle_counter_enable();
+
+	init_status = ad2s1210_observer_set_bandwidth(&ad2s1210_observer,
+			ad2s1210_observer_bw, SAMPLING_RATE);
+	if (init_status) {
+		return init_status;
+	}
+
 	return 0;
 }
 
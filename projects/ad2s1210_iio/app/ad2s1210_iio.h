@@ -32,4 +32,7 @@ int32_t ad2s1210_iio_initialize(void);
 /* Run the IIO event handler */
 void ad2s1210_iio_event_handler(void);
 
+/* Burst capture pacing (PWM trigger edge) callback */
+void ad2s1210_timer_callback(void *context);
+
 #endif /* _AD2S1210_IIO_H_ */
@@ -0,0 +1,172 @@
+/***************************************************************************//**
+ * @file    ad2s1210_observer.c
+ * @brief   Fixed-point resolver tracking observer (angle, speed, acceleration)
+ * @details Third order tracking loop run on every position sample: the angle,
+ *          speed and acceleration estimates are extrapolated by one sample and
+ *          corrected with the angle error against the measured position
+ *          (critically damped alpha-beta-gamma filter). The loop runs in
+ *          integer arithmetic only, the gains being computed once from the
+ *          tracking bandwidth.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <math.h>
+#include "ad2s1210_observer.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Fractional bits of the loop gains */
+#define OBSERVER_GAIN_FRAC		30
+
+/* Fractional (per turn) bits of the angle and speed estimates */
+#define OBSERVER_ANGLE_FRAC		48
+
+/* Fractional (per turn) bits of the acceleration estimate */
+#define OBSERVER_ACCEL_FRAC		56
+
+/* Fractional (per turn) bits of the angle error */
+#define OBSERVER_ERROR_FRAC		32
+
+/* Angle error (2^-32 turn) times gain (Q30) to the estimates resolution */
+#define OBSERVER_ANGLE_SHIFT	\
+	(OBSERVER_ERROR_FRAC + OBSERVER_GAIN_FRAC - OBSERVER_ANGLE_FRAC)
+#define OBSERVER_ACCEL_SHIFT	\
+	(OBSERVER_ERROR_FRAC + OBSERVER_GAIN_FRAC - OBSERVER_ACCEL_FRAC)
+
+#define OBSERVER_2PI			6.28318530718
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief	Set the tracking bandwidth of the observer
+ * @param	obs[in,out] - Observer
+ * @param	bandwidth[in] - Tracking bandwidth (Hz)
+ * @param	sample_rate[in] - Position sample rate (Hz)
+ * @return	0 in case of success, negative error code otherwise
+ * @note	The higher the bandwidth, the faster the estimates follow the
+ *			speed changes and the noisier they are.
+ */
+int32_t ad2s1210_observer_set_bandwidth(struct ad2s1210_observer *obs,
+					uint32_t bandwidth, uint32_t sample_rate)
+{
+	double theta;
+
+	if (!obs || bandwidth < AD2S1210_OBSERVER_MIN_BW
+	    || bandwidth > sample_rate / AD2S1210_OBSERVER_MAX_BW_DIV) {
+		return -EINVAL;
+	}
+
+	/* Critically damped (fading memory) gains, the three loop poles being
+	 * placed at theta */
+	theta = exp(-OBSERVER_2PI * bandwidth / sample_rate);
+
+	obs->k_angle = (int32_t)ldexp(1 - theta * theta * theta,
+				      OBSERVER_GAIN_FRAC);
+	obs->k_speed = (int32_t)ldexp(1.5 * (1 - theta) * (1 - theta) * (1 + theta),
+				      OBSERVER_GAIN_FRAC);
+	obs->k_accel = (int32_t)ldexp((1 - theta) * (1 - theta) * (1 - theta),
+				      OBSERVER_GAIN_FRAC);
+
+	return 0;
+}
+
+/**
+ * @brief	Restart the observer from the next position
+ * @param	obs[in,out] - Observer
+ * @return	none
+ */
+void ad2s1210_observer_reset(struct ad2s1210_observer *obs)
+{
+	obs->angle = 0;
+	obs->speed = 0;
+	obs->accel = 0;
+	obs->started = false;
+}
+
+/**
+ * @brief	Run the observer on a position sample
+ * @param	obs[in,out] - Observer
+ * @param	position[in] - Position (16-bit turn fraction)
+ * @return	none
+ */
+void ad2s1210_observer_update(struct ad2s1210_observer *obs, uint16_t position)
+{
+	uint64_t measured = (uint64_t)position << (OBSERVER_ANGLE_FRAC - 16);
+	int32_t error;
+
+	if (!obs->started) {
+		obs->angle = measured;
+		obs->speed = 0;
+		obs->accel = 0;
+		obs->started = true;
+		return;
+	}
+
+	/* Extrapolate by one sample */
+	obs->angle += obs->speed + (obs->accel >> (OBSERVER_ACCEL_FRAC -
+			OBSERVER_ANGLE_FRAC + 1));
+	obs->speed += obs->accel >> (OBSERVER_ACCEL_FRAC - OBSERVER_ANGLE_FRAC);
+
+	/* Angle error within a turn (sign extended from the turn fraction) */
+	error = (int32_t)((int64_t)((measured - obs->angle) <<
+				    (64 - OBSERVER_ANGLE_FRAC)) >> (64 - OBSERVER_ERROR_FRAC));
+
+	/* Correct the estimates */
+	obs->angle += ((int64_t)error * obs->k_angle) >> OBSERVER_ANGLE_SHIFT;
+	obs->speed += ((int64_t)error * obs->k_speed) >> OBSERVER_ANGLE_SHIFT;
+	obs->accel += ((int64_t)error * obs->k_accel) >> OBSERVER_ACCEL_SHIFT;
+}
+
+/**
+ * @brief	Saturate an estimate to the 32-bit output range
+ * @param	value[in] - Estimate at the output resolution
+ * @return	Saturated estimate
+ */
+static int32_t ad2s1210_observer_saturate(int64_t value)
+{
+	if (value > INT32_MAX) {
+		return INT32_MAX;
+	}
+
+	if (value < INT32_MIN) {
+		return INT32_MIN;
+	}
+
+	return (int32_t)value;
+}
+
+/**
+ * @brief	Get the speed estimate
+ * @param	obs[in] - Observer
+ * @return	Speed (2^-32 turn per sample)
+ */
+int32_t ad2s1210_observer_speed(const struct ad2s1210_observer *obs)
+{
+	return ad2s1210_observer_saturate(obs->speed >> (OBSERVER_ANGLE_FRAC -
+					  AD2S1210_OBSERVER_SPEED_BITS));
+}
+
+/**
+ * @brief	Get the acceleration estimate
+ * @param	obs[in] - Observer
+ * @return	Acceleration (2^-40 turn per sample^2)
+ */
+int32_t ad2s1210_observer_accel(const struct ad2s1210_observer *obs)
+{
+	return ad2s1210_observer_saturate(obs->accel >> (OBSERVER_ACCEL_FRAC -
+					  AD2S1210_OBSERVER_ACCEL_BITS));
+}
@@ -0,0 +1,71 @@
+/***************************************************************************//**
+ * @file    ad2s1210_observer.h
+ * @brief   Fixed-point resolver tracking observer (angle, speed, acceleration)
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD2S1210_OBSERVER_H_
+#define _AD2S1210_OBSERVER_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Output speed resolution: 2^-32 turn per sample */
+#define AD2S1210_OBSERVER_SPEED_BITS	32
+
+/* Output acceleration resolution: 2^-40 turn per sample^2 */
+#define AD2S1210_OBSERVER_ACCEL_BITS	40
+
+/* Min tracking bandwidth (Hz) */
+#define AD2S1210_OBSERVER_MIN_BW		1
+
+/* Max tracking bandwidth as a fraction of the sample rate */
+#define AD2S1210_OBSERVER_MAX_BW_DIV	4
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct ad2s1210_observer
+ * @brief Tracking observer state
+ */
+struct ad2s1210_observer {
+	/* Loop gains of the angle, speed and acceleration estimates (Q30) */
+	int32_t k_angle;
+	int32_t k_speed;
+	int32_t k_accel;
+	/* Angle estimate (2^-48 turn, wraps around every 65536 turns) */
+	uint64_t angle;
+	/* Speed estimate (2^-48 turn per sample) */
+	int64_t speed;
+	/* Acceleration estimate (2^-56 turn per sample^2) */
+	int64_t accel;
+	/* Estimates initialized from the first position */
+	bool started;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int32_t ad2s1210_observer_set_bandwidth(struct ad2s1210_observer *obs,
+					uint32_t bandwidth, uint32_t sample_rate);
+void ad2s1210_observer_reset(struct ad2s1210_observer *obs);
+void ad2s1210_observer_update(struct ad2s1210_observer *obs, uint16_t position);
+int32_t ad2s1210_observer_speed(const struct ad2s1210_observer *obs);
+int32_t ad2s1210_observer_accel(const struct ad2s1210_observer *obs);
+
+#endif /* _AD2S1210_OBSERVER_H_ */
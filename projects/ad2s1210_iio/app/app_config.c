@@ -19,6 +19,7 @@
 #include <stdbool.h>
 
 #include "app_config.h"
+#include "ad2s1210_iio.h"
 #include "common.h"
 #include "no_os_error.h"
 #include "no_os_uart.h"
@@ -105,6 +106,16 @@ struct no_os_irq_ctrl_desc *trigger_irq_desc;
 /* PWM descriptor */
 struct no_os_pwm_desc *pwm_desc;
 
+#if defined(TIMER_PACED_BURST_CAPTURE)
+/* Burst capture pacing (PWM trigger edge) callback descriptor */
+static struct no_os_callback_desc timer_callback_desc = {
+	.callback = ad2s1210_timer_callback,
+	.ctx = NULL,
+	.event = NO_OS_EVT_GPIO,
+	.peripheral = NO_OS_GPIO_IRQ
+};
+#endif
+
 /******************************************************************************/
 /************************** Functions Declarations ****************************/
 /******************************************************************************/
@@ -151,6 +162,26 @@ static int32_t gpio_trigger_Init(void)
 		return ret;
 	}
 
+#if defined(TIMER_PACED_BURST_CAPTURE)
+	/* The burst capture enables the IRQ for its duration */
+	ret = no_os_irq_register_callback(trigger_irq_desc, TRIGGER_INT_ID,
+					  &timer_callback_desc);
+	if (ret) {
+		return ret;
+	}
+
+	ret = no_os_irq_trigger_level_set(trigger_irq_desc, TRIGGER_INT_ID,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret) {
+		return ret;
+	}
+
+	ret = no_os_irq_disable(trigger_irq_desc, TRIGGER_INT_ID);
+	if (ret) {
+		return ret;
+	}
+#endif
+
 	return 0;
 }
 
@@ -191,7 +222,7 @@ int32_t init_system(void)
 		return ret;
 	}
 
-#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) || defined(TIMER_PACED_BURST_CAPTURE)
 	ret = gpio_trigger_Init();
 	if (ret) {
 		return ret;
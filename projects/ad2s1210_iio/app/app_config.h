@@ -26,6 +26,7 @@
 
 /* List of supported platforms */
 #define	MBED_PLATFORM		1
+#define	LINUX_SIM_PLATFORM	3
 
 /* List of data capture modes */
 #define CONTINUOUS_DATA_CAPTURE		0
@@ -61,6 +62,14 @@
 #define DATA_CAPTURE_MODE	CONTINUOUS_DATA_CAPTURE
 #endif
 
+/* Pace the burst capture with the PWM conversion trigger, so that the scans
+ * are evenly spaced at SAMPLING_RATE. Comment out to read the scans
+ * back-to-back (free-running, at the SPI throughput limit). The tracking
+ * observer channels assume the conversions paced at SAMPLING_RATE */
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+#define TIMER_PACED_BURST_CAPTURE
+#endif
+
 /* Enable the UART/VirtualCOM port connection (default VCOM) */
 /* #define USE_PHY_COM_PORT		// Uncomment to select UART */
 
@@ -93,6 +102,33 @@
 #define TRIGGER_GPIO_PORT 0  /* Unused macro */
 #define TRIGGER_GPIO_PIN  PWM_TRIGGER
 #define TRIGGER_INT_ID	GPIO_IRQ_ID1
+#define cycle_counter_enable mbed_cycle_counter_enable
+#define cycle_counter_get mbed_cycle_counter_get
+#define cycle_counter_freq mbed_cycle_counter_freq
+#elif (ACTIVE_PLATFORM == LINUX_SIM_PLATFORM)
+#include "app_config_linux.h"
+
+#define HW_CARRIER_NAME         linux_sim
+
+/* Redefine the init params structure mapping w.r.t. platform */
+#define pwm_extra_init_params linux_pwm_extra_init_params
+#define uart_extra_init_params linux_uart_extra_init_params
+#define vcom_extra_init_params linux_vcom_extra_init_params
+#define spi_extra_init_params linux_spi_extra_init_params
+#define trigger_gpio_irq_extra_params linux_trigger_irq_extra_init_params
+#define irq_ops linux_sim_irq_ops
+#define gpio_ops linux_sim_gpio_ops
+#define spi_ops linux_sim_spi_ops
+#define uart_ops linux_sim_uart_ops
+#define vcom_ops linux_sim_uart_ops
+#define pwm_ops linux_sim_pwm_ops
+#define trigger_gpio_irq_ops linux_sim_irq_ops
+#define trigger_gpio_handle 0	/* Unused macro */
+#define IRQ_INT_ID PWM_TRIGGER
+#define TRIGGER_INT_ID	PWM_TRIGGER
+#define cycle_counter_enable linux_cycle_counter_enable
+#define cycle_counter_get linux_cycle_counter_get
+#define cycle_counter_freq linux_cycle_counter_freq
 #else
 #error "No/Invalid active platform selected"
 #endif
@@ -103,7 +139,7 @@
 #define HW_VENDOR		"Analog Devices"
 #define NUM_CTX_ATTR		4
 
-#define RESOLVER_CHANNELS		 3
+#define RESOLVER_CHANNELS		 7
 #define RESOLVER_MAX_ATTR		10
 
 /* Max count is always 16 bit. LSBs are ignored in lower resolutions */
@@ -0,0 +1,273 @@
+/***************************************************************************//**
+ *   @file    app_config_linux.c
+ *   @brief   Application configurations module for the host (Linux) simulation
+ *            platform
+ *   @details The AD2S1210 is replaced by a model answering the SPI transfers
+ *            of the driver: the configuration mode register accesses and the
+ *            normal mode position/velocity reads. The shaft angle follows a
+ *            deterministic waveform indexed by the SAMPLE pulses, so that a
+ *            capture of N samples is the same from run to run.
+********************************************************************************
+ * Copyright (c) 2026 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include "app_config.h"
+#include "app_config_linux.h"
+
+/******************************************************************************/
+/************************ Macros/Constants ************************************/
+/******************************************************************************/
+
+/* AD2S1210 register map */
+#define SIM_AD2S1210_REG_POSITION_MSB	0x80
+#define SIM_AD2S1210_REG_POSITION_LSB	0x81
+#define SIM_AD2S1210_REG_VELOCITY_MSB	0x82
+#define SIM_AD2S1210_REG_VELOCITY_LSB	0x83
+#define SIM_AD2S1210_REG_EXCIT_FREQ	0x91
+#define SIM_AD2S1210_REG_CONTROL	0x92
+#define SIM_AD2S1210_REG_SOFT_RESET	0xF0
+#define SIM_AD2S1210_REG_FAULT		0xFF
+
+/* Configuration mode byte: address (MSB set) or data */
+#define SIM_AD2S1210_ADDR_MSK		0x80
+
+/******************************************************************************/
+/******************** Variables and User Defined Data Types *******************/
+/******************************************************************************/
+
+/**
+ * @struct sim_ad2s1210
+ * @brief AD2S1210 model state.
+ */
+struct sim_ad2s1210 {
+	/** Configuration registers */
+	uint8_t regs[256];
+	/** Register addressed by the last configuration mode address byte */
+	uint8_t addr;
+	/** Last configuration mode byte was an address (read out next) */
+	bool addr_pending;
+	/** Index of the latched sample (SAMPLE falling edges) */
+	uint32_t sample;
+	/** Latched position code */
+	uint16_t position;
+	/** Latched velocity code */
+	int16_t velocity;
+	/** Shaft angle (turns) */
+	struct linux_sim_waveform shaft;
+};
+
+/* AD2S1210 model */
+static struct sim_ad2s1210 sim_ad2s1210 = {
+	.regs = {
+		[SIM_AD2S1210_REG_EXCIT_FREQ] = 0x28,
+		[SIM_AD2S1210_REG_CONTROL] = 0x7E,
+	},
+	.sample = UINT32_MAX,
+	.shaft = {
+		.type = SIM_SHAFT_WAVEFORM,
+		.sample_rate = SAMPLING_RATE,
+		.frequency = SIM_SHAFT_FREQUENCY,
+		.amplitude = (SIM_SHAFT_WAVEFORM == LINUX_SIM_WAVEFORM_SINE) ?
+		SIM_SHAFT_SWING : 0.5,
+		.offset = 0.5,
+	},
+};
+
+static int sim_ad2s1210_xfer(void *ctx, uint8_t *data, uint32_t len);
+
+/* UART (console) simulation platform specific init parameters */
+struct linux_sim_uart_init_param linux_uart_extra_init_params = {
+	.port = 0
+};
+
+/* VCOM (IIO) simulation platform specific init parameters */
+struct linux_sim_uart_init_param linux_vcom_extra_init_params = {
+	.port = IIO_UART_TCP_PORT
+};
+
+/* SPI simulation platform specific parameters */
+struct linux_sim_spi_init_param linux_spi_extra_init_params = {
+	.xfer = sim_ad2s1210_xfer,
+	.ctx = &sim_ad2s1210
+};
+
+/* The simulated interrupt controller has no specific parameters */
+uint8_t linux_trigger_irq_extra_init_params;
+
+struct linux_sim_pwm_init_param linux_pwm_extra_init_params = {
+	.irq_ctrl_id = 0,
+	.irq_id = PWM_TRIGGER
+};
+
+/******************************************************************************/
+/************************** Functions Declarations ****************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief	Get the velocity full scale for the resolution set on the RES pins
+ * @return	Velocity full scale (rps)
+ */
+static double sim_ad2s1210_max_rps(void)
+{
+	switch ((linux_sim_gpio_level(GPIO_RES0) << 1) |
+		linux_sim_gpio_level(GPIO_RES1)) {
+	case 0:
+		return AD2S1210_TRACKING_RATE_10BIT;
+	case 1:
+		return AD2S1210_TRACKING_RATE_12BIT;
+	case 2:
+		return AD2S1210_TRACKING_RATE_14BIT;
+	default:
+		return AD2S1210_TRACKING_RATE_16BIT;
+	}
+}
+
+/**
+ * @brief	Latch the position and velocity of the last SAMPLE pulse
+ * @param	dev[in] - AD2S1210 model
+ * @return	none
+ */
+static void sim_ad2s1210_latch(struct sim_ad2s1210 *dev)
+{
+	uint32_t sample = linux_sim_gpio_falling_edges(GPIO_SAMPLE);
+	double turns;
+	double delta;
+	double rps;
+
+	if (sample == dev->sample) {
+		return;
+	}
+	dev->sample = sample;
+
+	turns = linux_sim_waveform_value(&dev->shaft, sample);
+	dev->position = (uint16_t)(int64_t)floor((turns - floor(turns)) * 65536.0);
+
+	/* Velocity of the tracking loop (shortest way between the samples) */
+	delta = 0;
+	if (sample) {
+		delta = turns - linux_sim_waveform_value(&dev->shaft, sample - 1);
+	}
+	delta -= floor(delta + 0.5);
+	rps = delta * dev->shaft.sample_rate;
+	rps = fmax(fmin(rps / sim_ad2s1210_max_rps(), 1.0), -1.0);
+	dev->velocity = (int16_t)lround(rps * INT16_MAX);
+
+	dev->regs[SIM_AD2S1210_REG_POSITION_MSB] = dev->position >> 8;
+	dev->regs[SIM_AD2S1210_REG_POSITION_LSB] = dev->position & 0xFF;
+	dev->regs[SIM_AD2S1210_REG_VELOCITY_MSB] = (uint16_t)dev->velocity >> 8;
+	dev->regs[SIM_AD2S1210_REG_VELOCITY_LSB] = (uint16_t)dev->velocity & 0xFF;
+}
+
+/**
+ * @brief	AD2S1210 model SPI transfer
+ * @param	ctx[in] - AD2S1210 model
+ * @param	data[in,out] - Bytes clocked in, replaced by the bytes clocked out
+ * @param	len[in] - Number of bytes
+ * @return	0 in case of success, negative error code otherwise
+ * @details	The mode is selected by the A0/A1 pins. In configuration mode,
+ *			every byte is a frame: an address (MSB set) selects the register
+ *			clocked out in the next frame, a data byte writes the register
+ *			addressed last. In normal mode, the position or velocity (MSB
+ *			first) is clocked out, followed by the fault register.
+ */
+static int sim_ad2s1210_xfer(void *ctx, uint8_t *data, uint32_t len)
+{
+	struct sim_ad2s1210 *dev = ctx;
+	uint16_t value;
+	uint8_t in;
+	uint32_t i;
+
+	sim_ad2s1210_latch(dev);
+
+	if (linux_sim_gpio_level(GPIO_A0) && linux_sim_gpio_level(GPIO_A1)) {
+		for (i = 0; i < len; i++) {
+			in = data[i];
+			data[i] = dev->addr_pending ? dev->regs[dev->addr] : 0;
+
+			if (in & SIM_AD2S1210_ADDR_MSK) {
+				dev->addr = in;
+				dev->addr_pending = true;
+				continue;
+			}
+
+			dev->addr_pending = false;
+			if (dev->addr == SIM_AD2S1210_REG_SOFT_RESET) {
+				continue;
+			}
+			/* Only the configuration registers are writable */
+			if (dev->addr > SIM_AD2S1210_REG_VELOCITY_LSB) {
+				dev->regs[dev->addr] = in;
+			}
+		}
+
+		return 0;
+	}
+
+	value = linux_sim_gpio_level(GPIO_A1) ? (uint16_t)dev->velocity :
+		dev->position;
+	for (i = 0; i < len; i++) {
+		switch (i) {
+		case 0:
+			data[i] = value >> 8;
+			break;
+		case 1:
+			data[i] = value & 0xFF;
+			break;
+		case 2:
+			data[i] = dev->regs[SIM_AD2S1210_REG_FAULT];
+			break;
+		default:
+			data[i] = 0;
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief	Enable the cycle counter (the monotonic clock, always running)
+ * @return	none
+ */
+void linux_cycle_counter_enable(void)
+{
+}
+
+/**
+ * @brief	Get the current cycle count
+ * @return	Monotonic clock in nanoseconds (wraps around at 2^32)
+ */
+uint32_t linux_cycle_counter_get(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint32_t)((uint64_t)now.tv_sec * LINUX_CYCLE_COUNTER_FREQ +
+			  now.tv_nsec);
+}
+
+/**
+ * @brief	Get the frequency of the cycle counter
+ * @return	Cycle counter frequency in Hz
+ */
+uint32_t linux_cycle_counter_freq(void)
+{
+	return LINUX_CYCLE_COUNTER_FREQ;
+}
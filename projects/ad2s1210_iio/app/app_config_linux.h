@@ -0,0 +1,85 @@
+/***************************************************************************//**
+ *   @file    app_config_linux.h
+ *   @brief   Header file for the host (Linux) simulation platform configurations
+********************************************************************************
+ * Copyright (c) 2026 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef APP_CONFIG_LINUX_H_
+#define APP_CONFIG_LINUX_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+
+#include "linux_sim_uart.h"
+#include "linux_sim_irq.h"
+#include "linux_sim_spi.h"
+#include "linux_sim_pwm.h"
+#include "linux_sim_gpio.h"
+#include "linux_sim_waveform.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Simulated GPIO numbers */
+#define SPI_CSB		0
+#define GPIO_A0		1
+#define GPIO_A1		2
+#define GPIO_RES0	3
+#define GPIO_RES1	4
+#define GPIO_SAMPLE	5
+
+/* Simulated interrupt line of the PWM conversion trigger */
+#define PWM_TRIGGER	0
+
+/* TCP port (loopback) of the IIO UART */
+#if !defined(IIO_UART_TCP_PORT)
+#define IIO_UART_TCP_PORT	LINUX_SIM_UART_DEFAULT_PORT
+#endif
+
+/* Conversion trigger rate (ODR). Can be raised well beyond the target rate
+ * to find the throughput limit of the capture path on the host */
+#if !defined(SAMPLING_RATE)
+#define SAMPLING_RATE                                   (16000)
+#endif
+#define CONV_TRIGGER_PERIOD_NSEC                (((float)(1.0 / SAMPLING_RATE) * 1000000) * 1000)
+#define CONV_TRIGGER_DUTY_CYCLE_NSEC    (CONV_TRIGGER_PERIOD_NSEC / 2)
+
+/* Cycle counter (timestamp) frequency, the monotonic clock in nanoseconds */
+#define LINUX_CYCLE_COUNTER_FREQ	1000000000
+
+/* Simulated shaft angle: a ramp turns the shaft at a constant speed
+ * (SIM_SHAFT_FREQUENCY in rps), a sine makes it swing around half a turn */
+#if !defined(SIM_SHAFT_WAVEFORM)
+#define SIM_SHAFT_WAVEFORM	LINUX_SIM_WAVEFORM_RAMP
+#endif
+#if !defined(SIM_SHAFT_FREQUENCY)
+#define SIM_SHAFT_FREQUENCY	10.0
+#endif
+/* Swing amplitude of the sine waveform (turns) */
+#define SIM_SHAFT_SWING		0.25
+
+/******************************************************************************/
+/********************** Public/Extern Declarations ****************************/
+/******************************************************************************/
+
+extern struct linux_sim_uart_init_param linux_uart_extra_init_params;
+extern struct linux_sim_uart_init_param linux_vcom_extra_init_params;
+extern struct linux_sim_spi_init_param linux_spi_extra_init_params;
+extern uint8_t linux_trigger_irq_extra_init_params;
+extern struct linux_sim_pwm_init_param linux_pwm_extra_init_params;
+
+void linux_cycle_counter_enable(void);
+uint32_t linux_cycle_counter_get(void);
+uint32_t linux_cycle_counter_freq(void);
+
+#endif /* APP_CONFIG_LINUX_H_ */
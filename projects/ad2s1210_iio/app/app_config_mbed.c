@@ -16,6 +16,7 @@
 /******************************************************************************/
 
 #include <stdbool.h>
+#include "cmsis.h"
 #include "app_config.h"
 #include "app_config_mbed.h"
 
@@ -23,6 +24,9 @@
 /************************ Macros/Constants ************************************/
 /******************************************************************************/
 
+/* Key unlocking the write access to DWT registers on Cortex-M7 cores */
+#define DWT_LAR_UNLOCK_KEY		0xC5ACCE55
+
 /******************************************************************************/
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
@@ -76,3 +80,35 @@ struct mbed_pwm_init_param mbed_pwm_extra_init_params = {
 /******************************************************************************/
 /************************** Functions Definitions *****************************/
 /******************************************************************************/
+
+/**
+ * @brief	Enable the DWT core cycle counter
+ * @return	none
+ */
+void mbed_cycle_counter_enable(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if (__CORTEX_M == 7U)
+	DWT->LAR = DWT_LAR_UNLOCK_KEY;
+#endif
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief	Get the current core cycle count
+ * @return	Core cycle count (wraps around at 2^32)
+ */
+uint32_t mbed_cycle_counter_get(void)
+{
+	return DWT->CYCCNT;
+}
+
+/**
+ * @brief	Get the frequency of the core cycle counter
+ * @return	Cycle counter frequency in Hz
+ */
+uint32_t mbed_cycle_counter_freq(void)
+{
+	return SystemCoreClock;
+}
@@ -68,4 +68,8 @@ extern struct mbed_gpio_init_param mbed_trigger_gpio_extra_init_params;
 extern struct mbed_gpio_irq_init_param mbed_trigger_gpio_irq_init_params;
 extern struct mbed_pwm_init_param mbed_pwm_extra_init_params;
 
+void mbed_cycle_counter_enable(void);
+uint32_t mbed_cycle_counter_get(void);
+uint32_t mbed_cycle_counter_freq(void);
+
 #endif /* APP_CONFIG_MBED_H_ */
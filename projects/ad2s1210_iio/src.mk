@@ -10,6 +10,40 @@ SRC_DIRS += $(LIBRARIES_PATH)/no-OS/include
 SRC_DIRS += $(LIBRARIES_PATH)/precision-converters-library/common
 SRC_DIRS += $(LIBRARIES_PATH)/precision-converters-library/board_info
 SRC_DIRS += $(LIBRARIES_PATH)/precision-converters-library/sdp_k1_sdram
+SRC_DIRS += $(ROOT_DRIVE)/projects/_common
+
+# ALL_IGNORED_FILES variable used for excluding particular source files in SRC_DIRS in Build
+# The CMSIS-DSP based modules of the common sources are not used
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/decimation_stage.c
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/decimation_stage.h
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/welch_fft.c
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/welch_fft.h
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/stm32
+
+ifeq 'linux' '$(PLATFORM)'
+# Experimental host build against the simulated peripherals (IIO over TCP on
+# the loopback, e.g. make PLATFORM=linux SAMPLING_RATE=64000). Only this
+# project is ported so far, it replaces the mbed platform sources.
+SRC_DIRS := $(filter-out $(LIBRARIES_PATH)/no-OS/drivers/platform/mbed \
+	$(LIBRARIES_PATH)/precision-converters-library/sdp_k1_sdram, $(SRC_DIRS))
+SRC_DIRS += $(LIBRARIES_PATH)/no-OS/drivers/platform/linux
+ALL_IGNORED_FILES += $(PROJECT_APP_PATH)/app_config_mbed.c
+ALL_IGNORED_FILES += $(PROJECT_APP_PATH)/app_config_mbed.h
+
+# Extra Macros
+override NEW_CFLAGS += -DACTIVE_PLATFORM=LINUX_SIM_PLATFORM
+ifneq '' '$(SAMPLING_RATE)'
+override NEW_CFLAGS += -DSAMPLING_RATE=$(SAMPLING_RATE)
+endif
+ifneq '' '$(IIO_UART_TCP_PORT)'
+override NEW_CFLAGS += -DIIO_UART_TCP_PORT=$(IIO_UART_TCP_PORT)
+endif
+LDFLAGS += -lpthread -lm
+else
+ALL_IGNORED_FILES += $(PROJECT_APP_PATH)/app_config_linux.c
+ALL_IGNORED_FILES += $(PROJECT_APP_PATH)/app_config_linux.h
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/linux
 
 # Extra Macros
 override NEW_CFLAGS += -DACTIVE_PLATFORM=MBED_PLATFORM
+endif
@@ -30,6 +30,9 @@
 #include "common.h"
 #include "iio_trigger.h"
 #include "version.h"
+#include "dac_frame_builder.h"
+#include "dac_waveform.h"
+#include "stm32_cycle_counter.h"
 
 /******** Forward declaration of getter/setter functions ********/
 static int ad3530r_iio_attr_get(void *device,
@@ -87,9 +90,6 @@ static int ad3530r_iio_attr_available_set(void *device,
 /* Bytes per sample (for DAC resolution of 16-bits) */
 #define	BYTES_PER_SAMPLE	sizeof(uint16_t)
 
-/* Bytes per sample with address (for DAC resolution of 16-bits) */
-#define BYTES_PER_SAMPLE_WITH_ADDRESS	2 * sizeof(uint16_t)
-
 /* Number of data storage bits (needed for IIO client to send buffer of data) */
 #define CHN_STORAGE_BITS	(BYTES_PER_SAMPLE * 8)
 
@@ -136,7 +136,28 @@ struct iio_device *ad3530r_iio_dev;
 #if (INTERFACE_MODE == SPI_INTERRUPT)
 /* AD3530R IIO hw trigger descriptor */
 static struct iio_hw_trig *ad3530r_hw_trig_desc;
+
+/* IIO trigger init parameters */
+static struct iio_trigger_init iio_trigger_init_params = {
+	.descriptor = &ad3530r_iio_trig_desc,
+	.name = AD3530R_IIO_TRIGGER_NAME,
+};
+#endif
+
+/* IIO device init parameters (kept for the IIO interface restart) */
+static struct iio_device_init iio_device_init_params[NUM_OF_IIO_DEVICES] = {{
+		/* Headroom for the streaming mode address */
+		.raw_buf = (int8_t *)dac_data_buffer + DAC_FRAME_HEADROOM,
+	}
+};
+
+/* IIO interface init parameters */
+static struct iio_init_param iio_init_params = {
+	.phy_type = USE_UART,
+#if (INTERFACE_MODE == SPI_INTERRUPT)
+	.trigs = &iio_trigger_init_params,
 #endif
+};
 
 /* Active channel sequence */
 static volatile uint8_t ad3530r_active_chns[DAC_MAX_CHANNELS];
@@ -164,6 +185,7 @@ enum ad3530r_attribute_ids {
 	DAC_MULTI_INPUT_CH,
 	DAC_MULTI_DAC_CH,
 	DAC_SAMPLING_FREQUENCY,
+	DAC_ACHIEVED_SAMPLING_FREQUENCY,
 	DAC_STREAMING_TECHNIQUE
 };
 
@@ -330,6 +352,8 @@ static struct iio_attribute ad3530r_iio_global_attributes[] = {
 	AD3530R_CHN_ATTR("all_ch_input_registers", DAC_MULTI_INPUT_CH),
 	AD3530R_CHN_ATTR("all_ch_raw", DAC_MULTI_DAC_CH),
 	AD3530R_CHN_ATTR("sampling_frequency", DAC_SAMPLING_FREQUENCY),
+	AD3530R_CHN_ATTR("achieved_sampling_frequency",
+			 DAC_ACHIEVED_SAMPLING_FREQUENCY),
 	AD3530R_CHN_ATTR("data_streaming_mode", DAC_STREAMING_TECHNIQUE),
 	AD3530R_CHN_AVAIL_ATTR("data_streaming_mode_available", DAC_STREAMING_TECHNIQUE),
 	AD3530R_CHN_ATTR("sw_ldac_trigger", DAC_SW_LDAC),
@@ -356,6 +380,8 @@ static struct iio_attribute ad3532r_iio_global_attributes[] = {
 	AD3530R_CHN_ATTR("all_ch_input_registers", DAC_MULTI_INPUT_CH),
 	AD3530R_CHN_ATTR("all_ch_raw", DAC_MULTI_DAC_CH),
 	AD3530R_CHN_ATTR("sampling_frequency", DAC_SAMPLING_FREQUENCY),
+	AD3530R_CHN_ATTR("achieved_sampling_frequency",
+			 DAC_ACHIEVED_SAMPLING_FREQUENCY),
 	END_ATTRIBUTES_ARRAY,
 };
 
@@ -407,6 +433,12 @@ enum reg_access_mode streaming_option = SINGLE_INSTRUCTION_MODE;
 /* Global variable to store number of samples */
 uint32_t num_of_samples;
 
+/* Achieved sampling rate (DAC channel updates per second) */
+struct dac_update_rate ad3530r_update_rate = {
+	.get_ticks = stm32_cycle_counter_get,
+	.get_ms = HAL_GetTick
+};
+
 /* Variable to store number of channels */
 static uint8_t num_of_chns = AD3530R_NUM_CH;
 
@@ -414,6 +446,9 @@ static uint8_t num_of_chns = AD3530R_NUM_CH;
 /* Flag to indicate if SPI DMA enabled */
 static bool spi_dma_enabled = false;
 
+/* Flag to restart the IIO interface on a streaming option change */
+static bool restart_iio_flag = false;
+
 /* STM32 SPI Init params */
 struct stm32_spi_init_param* spi_init_param;
 
@@ -423,6 +458,9 @@ static uint16_t ch_addr_array[DAC_MAX_CHANNELS];
 /* Global variable for iio buffer */
 uint8_t* global_iio_buff;
 
+/* Number of bytes transferred per receive DMA cycle */
+uint32_t ad3530r_dma_cycle_bytes;
+
 /* Variable to store regsister map */
 static const uint32_t *ad353xr_regs;
 
@@ -714,6 +752,11 @@ static int ad3530r_iio_attr_get(void *device,
 
 		return sprintf(buf, "%lu", sampling_rate);
 
+	case DAC_ACHIEVED_SAMPLING_FREQUENCY:
+		/* Measured over the transfers since the start of the streaming */
+		return sprintf(buf, "%lu",
+			       (unsigned long)dac_update_rate_get(&ad3530r_update_rate));
+
 	case DAC_STREAMING_TECHNIQUE:
 		return sprintf(buf, "%s", ad3530r_streaming_select_str[streaming_option]);
 
@@ -1011,6 +1054,10 @@ static int ad3530r_iio_attr_set(void *device,
 		}
 		break;
 
+	case DAC_ACHIEVED_SAMPLING_FREQUENCY:
+		/* NA - Measured by the firmware */
+		return -EINVAL;
+
 	case DAC_STREAMING_TECHNIQUE:
 		for (value = 0; value < NO_OS_ARRAY_SIZE(ad3530r_streaming_select_str);
 		     value++) {
@@ -1023,6 +1070,11 @@ static int ad3530r_iio_attr_set(void *device,
 		if (streaming_option != value) {
 			streaming_option = value;
 			reconfig_stm32_params();
+#if (INTERFACE_MODE == SPI_DMA)
+			/* The accepted buffer length depends upon the streaming option,
+			 * the IIO interface is restarted once this request is served */
+			restart_iio_flag = true;
+#endif
 		}
 
 		break;
@@ -1177,6 +1229,9 @@ static int32_t ad3530r_iio_prepare_transfer(void* dev, uint32_t mask)
 	ad3530r_dev_desc->crc_en = false;
 
 #if (INTERFACE_MODE == SPI_INTERRUPT)
+	/* One channel updated per trigger */
+	dac_update_rate_start(&ad3530r_update_rate, 1);
+
 	ret = iio_trig_enable(ad3530r_hw_trig_desc);
 	if (ret) {
 		return ret;
@@ -1295,42 +1350,34 @@ static int32_t ad3530r_iio_close_channels(void *dev)
 
 #if (INTERFACE_MODE == SPI_DMA)
 /**
- * @brief Update the iio buffer by inserting channel register addresses.
+ * @brief Expand the iio buffer into single instruction frames.
  * @param iio_dev_data[in, out] - IIO device data instance.
+ * @param frames_size[out] - Size of the frames (in bytes).
  * @return 0 in case of success or negative value otherwise.
- * @detail The input iio buffer samples will be inserted with channel addresses
- *		   before the samples for single instruction based data streaming
+ * @detail The frames (channel address followed by the sample) are built in
+ *		   place, the buffer being used up to twice the samples size.
  */
-static int update_iio_buffer_with_ch_ids(struct iio_device_data* iio_dev_data)
+static int update_iio_buffer_with_ch_ids(struct iio_device_data* iio_dev_data,
+		uint32_t *frames_size)
 {
+	uint16_t instr[DAC_MAX_CHANNELS];
+	uint8_t ch_id;
+
 	if (!iio_dev_data) {
 		return -EINVAL;
 	}
 
-	uint16_t nb_of_samples_per_chn = iio_dev_data->buffer->size /
-					 (BYTES_PER_SAMPLE * num_of_active_channels); // number of samples per channel
-	uint32_t buff_len = iio_dev_data->buffer->size;
-	uint32_t iio_buff_idx = buff_len - 1;		 // input iio buffer index
-	uint32_t modified_buff_idx = 2 * buff_len - 1; // modified iio buffer index
-	int8_t* iio_buff = iio_dev_data->buffer->buf->buff;
-	int16_t sample_id;
-	int8_t ch_id;
-
-	/* Iterate over the samples per active channels in the iio buffer from backwards */
-	for (sample_id = nb_of_samples_per_chn - 1; sample_id >= 0; sample_id--) {
-		/* Iterate over the active channles per each sample in the iio buffer */
-		for (ch_id = num_of_active_channels - 1; ch_id >= 0; ch_id--) {
-			/* Copy data */
-			iio_buff[modified_buff_idx--] = iio_buff[iio_buff_idx--];
-			iio_buff[modified_buff_idx--] = iio_buff[iio_buff_idx--];
-
-			/* Copy active channel address for the respective channel */
-			iio_buff[modified_buff_idx--] = ch_addr_array[ad3530r_active_chns[ch_id]];
-			iio_buff[modified_buff_idx--] = ch_addr_array[ad3530r_active_chns[ch_id]] >> 8;
-		}
+	if (2 * iio_dev_data->buffer->size > DATA_BUFFER_SIZE - DAC_FRAME_HEADROOM) {
+		return -ENOMEM;
 	}
 
-	return 0;
+	for (ch_id = 0; ch_id < num_of_active_channels; ch_id++) {
+		instr[ch_id] = ch_addr_array[ad3530r_active_chns[ch_id]];
+	}
+
+	return dac_frame_build_single_instr((uint8_t *)iio_dev_data->buffer->buf->buff,
+					    iio_dev_data->buffer->size, instr,
+					    num_of_active_channels, frames_size);
 }
 #endif
 
@@ -1346,6 +1393,7 @@ static int32_t ad3530r_iio_submit_samples(struct iio_device_data *iio_dev_data)
 	uint16_t local_buff = 0;
 	int8_t* iio_buff;
 	uint8_t addr;
+	uint32_t frames_size;
 
 	if (!iio_dev_data) {
 		return -EINVAL;
@@ -1362,30 +1410,36 @@ static int32_t ad3530r_iio_submit_samples(struct iio_device_data *iio_dev_data)
 
 		if (streaming_option == SINGLE_INSTRUCTION_MODE) {
 			/* Insert channel addresses in iio buffer before streaming the data */
-			ret = update_iio_buffer_with_ch_ids(iio_dev_data);
+			ret = update_iio_buffer_with_ch_ids(iio_dev_data, &frames_size);
 			if (ret) {
 				return ret;
 			}
 
 			/* SPI Message */
 			ad3530r_spi_msg.tx_buff = (uint8_t*)iio_buff;
-			ad3530r_spi_msg.bytes_number = num_of_samples * BYTES_PER_SAMPLE_WITH_ADDRESS;
+			ad3530r_spi_msg.bytes_number = frames_size;
 		} else { // STREAMING_MODE
 			/* Get 1st channel address from the channel mask */
 			addr = AD3530R_REG_ADDR_DAC_CHN(no_os_find_first_set_bit(
 								iio_dev_data->buffer->active_mask));
 
-			/* Insert address and shift received data from iio buffer */
-			memmove(iio_buff + 2, iio_buff,
-				iio_dev_data->buffer->size);
-			iio_buff[0] = 0x00;
-			iio_buff[1] = addr;
-
-			global_iio_buff = (uint8_t*)iio_buff;
+			/* Insert address in the headroom ahead of the iio buffer data */
+			global_iio_buff = dac_frame_prepend_instr((uint8_t*)iio_buff, addr);
 
 			/* SPI Message */
-			ad3530r_spi_msg.tx_buff = (uint8_t*)iio_buff;
-			ad3530r_spi_msg.bytes_number = (num_of_samples * BYTES_PER_SAMPLE) + 2;
+			ad3530r_spi_msg.tx_buff = global_iio_buff;
+			ad3530r_spi_msg.bytes_number = (num_of_samples * BYTES_PER_SAMPLE) +
+						       DAC_FRAME_INSTR_SIZE;
+		}
+
+		/* The receive DMA completes once per buffer cycle, the channel
+		 * updates being accounted from the frames (or samples) sent */
+		ad3530r_dma_cycle_bytes = ad3530r_spi_msg.bytes_number;
+		if (streaming_option == SINGLE_INSTRUCTION_MODE) {
+			dac_update_rate_start(&ad3530r_update_rate,
+					      DAC_FRAME_INSTR_SIZE + BYTES_PER_SAMPLE);
+		} else {
+			dac_update_rate_start(&ad3530r_update_rate, BYTES_PER_SAMPLE);
 		}
 
 		/* Set CS low */
@@ -1448,6 +1502,8 @@ static int32_t ad3530r_trigger_handler(struct iio_device_data *iio_dev_data)
 	}
 
 	chan_idx += 1;
+	dac_update_rate_account(&ad3530r_update_rate, 1);
+
 	return 0;
 }
 #endif
@@ -1741,6 +1797,43 @@ static int32_t ad353xr_assign_device(enum ad3530r_id dev_id,
 
 }
 
+/**
+ * @brief	Get the IIO buffer length accepted in the current streaming option
+ * @return	Buffer length (in bytes)
+ * @note	The single instruction mode frames take up twice the samples size.
+ */
+static uint32_t ad3530r_iio_buf_len(void)
+{
+#if (INTERFACE_MODE == SPI_DMA)
+	if (streaming_option == SINGLE_INSTRUCTION_MODE) {
+		return (DATA_BUFFER_SIZE - DAC_FRAME_HEADROOM) / 2;
+	}
+#endif
+
+	return DATA_BUFFER_SIZE - DAC_FRAME_HEADROOM;
+}
+
+#if (INTERFACE_MODE == SPI_DMA)
+/**
+ * @brief	Restart the IIO interface with the buffer length accepted
+ *			in the current streaming option
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t ad3530r_iio_restart(void)
+{
+	int32_t ret;
+
+	ret = iio_remove(ad3530r_iio_desc);
+	if (ret) {
+		return ret;
+	}
+
+	iio_device_init_params[0].raw_buf_len = ad3530r_iio_buf_len();
+
+	return iio_init(&ad3530r_iio_desc, &iio_init_params);
+}
+#endif
+
 /**
  * @brief	Initialize the IIO interface for AD3530R IIO device
  * @return	0 in case of success,negative error code otherwise
@@ -1751,28 +1844,6 @@ int32_t iio_app_initialize(void)
 	enum ad3530r_id dev_id;
 	uint8_t indx;
 
-#if (INTERFACE_MODE == SPI_INTERRUPT)
-	/* IIO trigger init parameters */
-	struct iio_trigger_init iio_trigger_init_params = {
-		.descriptor = &ad3530r_iio_trig_desc,
-		.name = AD3530R_IIO_TRIGGER_NAME,
-	};
-#endif
-
-	struct iio_device_init iio_device_init_params[NUM_OF_IIO_DEVICES] = {{
-			.raw_buf = dac_data_buffer,
-			.raw_buf_len = DATA_BUFFER_SIZE / 2, // Allocate only half the buffer size to accommodate the other half for addresses
-		}
-	};
-
-	/* IIO interface init parameters */
-	struct iio_init_param iio_init_params = {
-		.phy_type = USE_UART,
-#if (INTERFACE_MODE == SPI_INTERRUPT)
-		.trigs = &iio_trigger_init_params,
-#endif
-	};
-
 	/* Add a fixed delay of 1 sec before system init for the PoR sequence to get completed */
 	no_os_udelay(
 		1000000);
@@ -1831,6 +1902,7 @@ int32_t iio_app_initialize(void)
 	/* Initialize the IIO interface */
 	iio_init_params.uart_desc = uart_iio_com_desc;
 	iio_init_params.devs = iio_device_init_params;
+	iio_device_init_params[0].raw_buf_len = ad3530r_iio_buf_len();
 	ret = iio_init(&ad3530r_iio_desc, &iio_init_params);
 	if (ret) {
 		return ret;
@@ -1848,6 +1920,10 @@ int32_t iio_app_initialize(void)
 		return ret;
 	}
 
+	/* Achieved sampling rate time base */
+	stm32_cycle_counter_enable();
+	ad3530r_update_rate.ticks_per_sec = stm32_cycle_counter_freq();
+
 	return 0;
 }
 
@@ -1858,5 +1934,16 @@ int32_t iio_app_initialize(void)
  */
 void iio_app_event_handler(void)
 {
+#if (INTERFACE_MODE == SPI_DMA)
+	if (restart_iio_flag) {
+		/* Reset the restart_iio flag */
+		restart_iio_flag = false;
+
+		if (ad3530r_iio_restart()) {
+			return;
+		}
+	}
+#endif
+
 	iio_step(ad3530r_iio_desc);
 }
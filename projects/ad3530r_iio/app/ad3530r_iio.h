@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include "iio.h"
 #include "app_config.h"
+#include "dac_waveform.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -42,6 +43,8 @@ extern struct ad3530r_desc *ad3530r_dev_desc;
 extern uint8_t streaming_option;
 extern uint8_t* global_iio_buff;
 extern uint32_t num_of_samples;
+extern uint32_t ad3530r_dma_cycle_bytes;
+extern struct dac_update_rate ad3530r_update_rate;
 
 int32_t ad3530r_iio_initialize(void);
 void ad3530r_iio_event_handler(void);
@@ -336,12 +336,15 @@ int stm32_abort_dma_transfer(void)
 
 /**
  * @brief Callback function to flag the transfer of number
- *        of requested samples.
+ *        of requested samples, accounting the achieved sampling rate.
  * @param hdma[in] - DMA Handler (Unused)
  * @return	None
  */
 void receivecomplete_callback(DMA_HandleTypeDef* hdma)
 {
+	/* One buffer cycle transferred */
+	dac_update_rate_account(&ad3530r_update_rate, ad3530r_dma_cycle_bytes);
+
 	if (streaming_option == SINGLE_INSTRUCTION_MODE) {
 		if (transfer_stop_flag) {
 			TIM8->DIER &= ~TIM_DIER_CC1DE;
@@ -22,7 +22,12 @@
 #include "no_os_error.h"
 #include "no_os_util.h"
 #include "no_os_gpio.h"
+#include "no_os_delay.h"
 #include "iio_trigger.h"
+#include "dac_waveform.h"
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+#include "stm32_cycle_counter.h"
+#endif
 
 /******** Forward declaration of getter/setter functions ********/
 static int ad355xr_iio_attr_get(void *device,
@@ -133,6 +138,13 @@ static uint8_t num_channels_en;
 /* Flag to indicate if SPI DMA enabled */
 volatile static bool spi_dma_enabled = false;
 
+static uint32_t ad355xr_get_ticks(void);
+
+/* DAC update rate achieved during the data transfer */
+struct dac_update_rate ad355xr_update_rate = {
+	.get_ticks = ad355xr_get_ticks
+};
+
 /* IIO attributes ID */
 enum ad355xr_attribute_id {
 	DAC_RAW,
@@ -143,7 +155,8 @@ enum ad355xr_attribute_id {
 	DAC_CH_MODE,
 	DAC_VREF_VOLTAGE,
 	DAC_SIMULTANEOUS_UPDATE,
-	DAC_SAMPLING_FREQUENCY
+	DAC_SAMPLING_FREQUENCY,
+	DAC_ACHIEVED_SAMPLING_FREQUENCY
 };
 
 /* IIO channels scan structure */
@@ -204,6 +217,8 @@ static struct iio_attribute ad355xr_iio_global_attributes[] = {
 	AD355XR_CHN_ATTR("simultaneous_update", DAC_SIMULTANEOUS_UPDATE),
 #endif
 	AD355XR_CHN_ATTR("sampling_frequency", DAC_SAMPLING_FREQUENCY),
+	AD355XR_CHN_ATTR("achieved_sampling_frequency",
+			 DAC_ACHIEVED_SAMPLING_FREQUENCY),
 	END_ATTRIBUTES_ARRAY
 };
 
@@ -363,6 +378,10 @@ static int ad355xr_iio_attr_get(void *device,
 	case DAC_SAMPLING_FREQUENCY:
 		return sprintf(buf, "%u", ad355xr_sampling_rate);
 
+	case DAC_ACHIEVED_SAMPLING_FREQUENCY:
+		return sprintf(buf, "%lu",
+			       (unsigned long)dac_update_rate_get(&ad355xr_update_rate));
+
 	default:
 		return -EINVAL;
 	}
@@ -484,6 +503,10 @@ static int ad355xr_iio_attr_set(void *device,
 		}
 		break;
 
+	case DAC_ACHIEVED_SAMPLING_FREQUENCY:
+		/* NA - Measured by the firmware */
+		return -EINVAL;
+
 	default:
 		return -EINVAL;
 	}
@@ -686,6 +709,8 @@ static int32_t ad355xr_iio_prepare_transfer(void *dev,
 	}
 #endif
 
+	dac_update_rate_start(&ad355xr_update_rate, 1);
+
 	ret = iio_trig_enable(ad355xr_hw_trig_desc);
 	if (ret) {
 		return ret;
@@ -813,6 +838,9 @@ static int32_t ad355xr_iio_submit_buffer(struct iio_device_data* iio_dev_data)
 			return ret;
 		}
 
+		/* Accounted per LDAC edge which starts the DMA transfer */
+		dac_update_rate_start(&ad355xr_update_rate, 1);
+
 		ret = no_os_irq_enable(trigger_irq_desc, TRIGGER_INT_ID);
 		if (ret) {
 			return ret;
@@ -846,6 +874,8 @@ static int32_t ad355xr_trigger_handler(struct iio_device_data *iio_dev_data)
 		return ret;
 	}
 
+	dac_update_rate_account(&ad355xr_update_rate, 1);
+
 	if (channel_mask == AD3552R_MASK_ALL_CH) {
 		return ad355xr_write_one_sample_all_ch(ad355xr_dev_inst, dac_code);
 	} else {
@@ -930,6 +960,21 @@ static int32_t ad355xr_iio_param_init(struct iio_device **desc)
 	return 0;
 }
 
+/**
+ * @brief	Get the time base of the update rate measurement
+ * @return	Core cycle count on STM32 platform, time in usec otherwise
+ */
+static uint32_t ad355xr_get_ticks(void)
+{
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+	return stm32_cycle_counter_get();
+#else
+	struct no_os_time now = no_os_get_time();
+
+	return now.s * 1000000 + now.us;
+#endif
+}
+
 /**
  * @brief	Initialize the IIO interface for AD355XR IIO device
  * @return	0 in case of success, negative error code otherwise
@@ -1020,6 +1065,13 @@ int32_t ad355xr_iio_initialize(void)
 		return ret;
 	}
 
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+	stm32_cycle_counter_enable();
+	ad355xr_update_rate.ticks_per_sec = stm32_cycle_counter_freq();
+#else
+	ad355xr_update_rate.ticks_per_sec = 1000000;
+#endif
+
 	return 0;
 }
 
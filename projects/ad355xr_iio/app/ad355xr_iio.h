@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 #include "ad3552r.h"
+#include "dac_waveform.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -29,6 +30,7 @@
 /******************************************************************************/
 
 extern struct ad3552r_desc *ad355xr_dev_inst;
+extern struct dac_update_rate ad355xr_update_rate;
 int32_t ad355xr_iio_initialize(void);
 void ad355xr_iio_event_handler(void);
 
@@ -17,6 +17,7 @@
 #include "app_config_stm32.h"
 #include "no_os_error.h"
 #include "no_os_util.h"
+#include "ad355xr_iio.h"
 
 /******************************************************************************/
 /************************ Macros/Constants ************************************/
@@ -140,6 +141,8 @@ void EXTI15_10_IRQHandler(void)
 		/* start timer*/
 		htim4.Instance->CNT = 0;
 		htim4.Instance->CR1 |= TIM_CR1_CEN;
+
+		dac_update_rate_account(&ad355xr_update_rate, 1);
 	}
 #else
 	HAL_GPIO_EXTI_IRQHandler(1 << LDAC_PIN);
@@ -9,6 +9,15 @@ SRC_DIRS += $(LIBRARIES_PATH)/no-OS/include
 SRC_DIRS += $(LIBRARIES_PATH)/precision-converters-library/common
 SRC_DIRS += $(LIBRARIES_PATH)/precision-converters-library/board_info
 SRC_DIRS += $(LIBRARIES_PATH)/precision-converters-library/sdp_k1_sdram
+SRC_DIRS += $(ROOT_DRIVE)/projects/_common
+
+# The CMSIS-DSP based modules of the common sources are not used
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/decimation_stage.c
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/decimation_stage.h
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/welch_fft.c
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/welch_fft.h
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/stm32
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/linux
 
 ifeq 'mbed' '$(PLATFORM)'
 # ALL_IGNORED_FILES variable used for excluding particular source files in SRC_DIRS in Build
@@ -133,6 +133,27 @@ enum ad405x_operation_mode ad405x_operating_mode = AD405X_ADC_MODE_OP;
 /* Selected interface mode. Default is DMA mode */
 enum ad405x_interface_modes ad405x_interface_mode = SPI_DMA;
 
+/* Selected data streaming mode. Default is IIO buffer */
+enum ad405x_streaming_modes ad405x_streaming_mode = IIO_BUFFER_STREAMING;
+
+/* Selected IIO buffer sample packing. Default is no packing */
+enum ad405x_sample_packings ad405x_sample_packing = SAMPLE_PACKING_NONE;
+
+/* Packed size of the IIO buffer samples (0 when not packed) */
+uint8_t ad405x_packed_bits;
+
+/* Configuration the IIO interface was last initialized with. The operating
+ * and interface modes and the sample packing shape the IIO context
+ * (attributes, scan type and trigger), which is generated once by iio_init() */
+static struct {
+	bool valid;
+	enum ad405x_operation_mode operating_mode;
+	enum ad405x_interface_modes interface_mode;
+} ad405x_applied_config;
+
+/* Streaming ring over the data buffer for continuous data capture */
+struct sdram_ring_desc *ad405x_sdram_ring;
+
 /* Variable to store data ready status of ADC */
 volatile bool data_ready = false;
 
@@ -148,7 +169,19 @@ enum ad405x_attribute_ids {
 	ADC_SAMPLE_RATE,
 	RESTART_IIO,
 	ADC_BURST_SAMPLE_RATE,
-	ADC_FILTER_LENGTH
+	ADC_FILTER_LENGTH,
+	DATA_STREAMING_MODE,
+	CAPTURE_WINDOWS,
+	CAPTURE_WINDOWS_PENDING,
+	WINDOW_TIMESTAMP,
+	WINDOW_DROPPED_SAMPLES,
+	MODE_SWITCH_LATENCY,
+	SAMPLE_PACKING,
+	PACKED_SAMPLE_FORMAT,
+	RING_LEVEL,
+	RING_HIGH_WATER_MARK,
+	RING_OVERRUNS,
+	RING_DROPPED_BYTES
 };
 
 /* IIOD channels configurations */
@@ -196,6 +229,18 @@ static char *ad405x_burst_sample_rates_str[] = {
 	"111sps"
 };
 
+/* Data streaming modes string representation */
+static char *ad405x_streaming_mode_str[] = {
+	"iio_buffer",
+	"usb_bulk"
+};
+
+/* Sample packings string representation */
+static char *ad405x_sample_packing_str[] = {
+	"none",
+	"packed"
+};
+
 /* Burst mode sample rates (in kHz) */
 static float ad405x_burst_sample_rates[] = {
 	2000,
@@ -230,12 +275,33 @@ static struct iio_attribute iio_ad405x_global_attributes_system_config[] = {
 	AD405X_CHN_AVAIL_ATTR("operating_mode_available", ADC_OPERATING_MODE),
 	AD405X_CHN_ATTR("reconfigure_system", RESTART_IIO),
 	AD405X_CHN_ATTR("reconfigure_system_available", RESTART_IIO),
+#ifdef USB_STREAM_SUPPORT_AVAILABLE
+	AD405X_CHN_ATTR("data_streaming_mode", DATA_STREAMING_MODE),
+	AD405X_CHN_AVAIL_ATTR("data_streaming_mode_available", DATA_STREAMING_MODE),
+#endif
+#ifdef SPI_SUPPORT_AVAILABLE
+	AD405X_CHN_ATTR("sample_packing", SAMPLE_PACKING),
+	AD405X_CHN_AVAIL_ATTR("sample_packing_available", SAMPLE_PACKING),
+#endif
 	END_ATTRIBUTES_ARRAY
 };
 
 /* ad405x device (global) specific sample mode attributes list */
 static struct iio_attribute iio_ad405x_global_attributes_sample_mode[] = {
 	AD405X_CHN_ATTR("sampling_frequency", ADC_SAMPLE_RATE),
+#ifdef MULTI_WINDOW_CAPTURE_AVAILABLE
+	AD405X_CHN_ATTR("capture_windows", CAPTURE_WINDOWS),
+	AD405X_CHN_ATTR("capture_windows_pending", CAPTURE_WINDOWS_PENDING),
+	AD405X_CHN_ATTR("window_timestamp_us", WINDOW_TIMESTAMP),
+	AD405X_CHN_ATTR("window_dropped_samples", WINDOW_DROPPED_SAMPLES),
+	AD405X_CHN_ATTR("mode_switch_latency_us", MODE_SWITCH_LATENCY),
+#endif
+#if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	AD405X_CHN_ATTR("ring_level", RING_LEVEL),
+	AD405X_CHN_ATTR("ring_high_water_mark", RING_HIGH_WATER_MARK),
+	AD405X_CHN_ATTR("ring_overruns", RING_OVERRUNS),
+	AD405X_CHN_ATTR("ring_dropped_bytes", RING_DROPPED_BYTES),
+#endif
 	END_ATTRIBUTES_ARRAY
 };
 
@@ -247,6 +313,15 @@ static struct iio_attribute iio_ad405x_global_attributes_burst_averaging_mode[]
 	AD405X_CHN_ATTR("avg_filter_length", ADC_FILTER_LENGTH),
 	AD405X_CHN_AVAIL_ATTR("avg_filter_length_available", ADC_FILTER_LENGTH),
 	AD405X_CHN_ATTR("sampling_frequency", ADC_SAMPLE_RATE),
+#ifdef SPI_SUPPORT_AVAILABLE
+	AD405X_CHN_ATTR("packed_sample_format", PACKED_SAMPLE_FORMAT),
+#endif
+#if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	AD405X_CHN_ATTR("ring_level", RING_LEVEL),
+	AD405X_CHN_ATTR("ring_high_water_mark", RING_HIGH_WATER_MARK),
+	AD405X_CHN_ATTR("ring_overruns", RING_OVERRUNS),
+	AD405X_CHN_ATTR("ring_dropped_bytes", RING_DROPPED_BYTES),
+#endif
 	END_ATTRIBUTES_ARRAY
 };
 
@@ -255,6 +330,15 @@ static struct iio_attribute iio_ad405x_global_attributes_averaging_mode[] = {
 	AD405X_CHN_ATTR("avg_filter_length", ADC_FILTER_LENGTH),
 	AD405X_CHN_AVAIL_ATTR("avg_filter_length_available", ADC_FILTER_LENGTH),
 	AD405X_CHN_ATTR("sampling_frequency", ADC_SAMPLE_RATE),
+#ifdef SPI_SUPPORT_AVAILABLE
+	AD405X_CHN_ATTR("packed_sample_format", PACKED_SAMPLE_FORMAT),
+#endif
+#if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	AD405X_CHN_ATTR("ring_level", RING_LEVEL),
+	AD405X_CHN_ATTR("ring_high_water_mark", RING_HIGH_WATER_MARK),
+	AD405X_CHN_ATTR("ring_overruns", RING_OVERRUNS),
+	AD405X_CHN_ATTR("ring_dropped_bytes", RING_DROPPED_BYTES),
+#endif
 	END_ATTRIBUTES_ARRAY
 };
 
@@ -542,6 +626,12 @@ static int iio_ad405x_attr_get(void *device,
 	uint8_t reg_data;
 	uint32_t value;
 	struct no_os_gpio_desc **pp_gpio_cnv = &p_ad405x_dev->extra.spi_extra.gpio_cnv;
+#ifdef MULTI_WINDOW_CAPTURE_AVAILABLE
+	struct ad405x_window_capture_status window_status;
+#endif
+#if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	struct sdram_ring_stats ring_stats;
+#endif
 
 	switch (priv) {
 	case ADC_RAW:
@@ -664,6 +754,63 @@ static int iio_ad405x_attr_get(void *device,
 	case RESTART_IIO:
 		return sprintf(buf, "%s", "enable");
 
+	case DATA_STREAMING_MODE:
+		return sprintf(buf, "%s", ad405x_streaming_mode_str[ad405x_streaming_mode]);
+
+#ifdef MULTI_WINDOW_CAPTURE_AVAILABLE
+	case CAPTURE_WINDOWS:
+		return sprintf(buf, "%lu", ad405x_get_capture_windows());
+
+	case CAPTURE_WINDOWS_PENDING:
+		ad405x_get_window_capture_status(&window_status);
+		return sprintf(buf, "%lu", window_status.pending);
+
+	case WINDOW_TIMESTAMP:
+		ad405x_get_window_capture_status(&window_status);
+		return sprintf(buf, "%lu", window_status.timestamp_us);
+
+	case WINDOW_DROPPED_SAMPLES:
+		ad405x_get_window_capture_status(&window_status);
+		return sprintf(buf, "%lu", window_status.dropped_samples);
+
+	case MODE_SWITCH_LATENCY:
+		ad405x_get_window_capture_status(&window_status);
+		return sprintf(buf, "%lu", window_status.mode_switch_latency_us);
+#endif
+
+	case SAMPLE_PACKING:
+		return sprintf(buf, "%s", ad405x_sample_packing_str[ad405x_sample_packing]);
+
+	case PACKED_SAMPLE_FORMAT:
+		if (!ad405x_packed_bits) {
+			return sprintf(buf, "%s", "none");
+		}
+
+		/* Sample format within the packed stream, in the IIO notation */
+		return sprintf(buf,
+			       "le:%c%d/%d>>0",
+			       ad405x_iio_scan_type.sign,
+			       resolution,
+			       ad405x_packed_bits);
+
+#if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	case RING_LEVEL:
+		sdram_ring_get_stats(ad405x_sdram_ring, &ring_stats);
+		return sprintf(buf, "%lu", ring_stats.level);
+
+	case RING_HIGH_WATER_MARK:
+		sdram_ring_get_stats(ad405x_sdram_ring, &ring_stats);
+		return sprintf(buf, "%lu", ring_stats.high_water_mark);
+
+	case RING_OVERRUNS:
+		sdram_ring_get_stats(ad405x_sdram_ring, &ring_stats);
+		return sprintf(buf, "%lu", ring_stats.overruns);
+
+	case RING_DROPPED_BYTES:
+		sdram_ring_get_stats(ad405x_sdram_ring, &ring_stats);
+		return sprintf(buf, "%lu", ring_stats.dropped_bytes);
+#endif
+
 	default:
 		break;
 	}
@@ -864,6 +1011,62 @@ static int iio_ad405x_attr_set(void *device,
 	case RESTART_IIO:
 		/* Set flag to true */
 		restart_iio_flag = true;
+		break;
+
+	case DATA_STREAMING_MODE:
+		if (!strcmp(buf, ad405x_streaming_mode_str[USB_BULK_STREAMING])) {
+			ad405x_streaming_mode = USB_BULK_STREAMING;
+		} else if (!strcmp(buf,
+				   ad405x_streaming_mode_str[IIO_BUFFER_STREAMING])) {
+			ad405x_streaming_mode = IIO_BUFFER_STREAMING;
+		} else {
+			return -EINVAL;
+		}
+
+		return len;
+
+#ifdef MULTI_WINDOW_CAPTURE_AVAILABLE
+	case CAPTURE_WINDOWS:
+		ret = ad405x_set_capture_windows(no_os_str_to_uint32(buf));
+		if (ret) {
+			return ret;
+		}
+
+		return len;
+
+	case CAPTURE_WINDOWS_PENDING:
+	case WINDOW_TIMESTAMP:
+	case WINDOW_DROPPED_SAMPLES:
+	case MODE_SWITCH_LATENCY:
+		/* Capture status, read only */
+		return -EINVAL;
+#endif
+
+	case SAMPLE_PACKING:
+		/* Applied with the next system reconfiguration */
+		if (!strcmp(buf, ad405x_sample_packing_str[SAMPLE_PACKING_TIGHT])) {
+			ad405x_sample_packing = SAMPLE_PACKING_TIGHT;
+		} else if (!strcmp(buf,
+				   ad405x_sample_packing_str[SAMPLE_PACKING_NONE])) {
+			ad405x_sample_packing = SAMPLE_PACKING_NONE;
+		} else {
+			return -EINVAL;
+		}
+
+		return len;
+
+	case PACKED_SAMPLE_FORMAT:
+		/* NA - Selected from the resolution */
+		return -EINVAL;
+
+#if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	case RING_LEVEL:
+	case RING_HIGH_WATER_MARK:
+	case RING_OVERRUNS:
+	case RING_DROPPED_BYTES:
+		/* Streaming ring telemetry, read only */
+		return -EINVAL;
+#endif
 
 	default :
 		break;
@@ -947,6 +1150,18 @@ static int iio_ad405x_attr_available_get(void *device,
 	case RESTART_IIO:
 		return sprintf(buf, "%s", "enable");
 
+	case DATA_STREAMING_MODE:
+		return sprintf(buf,
+			       "%s %s",
+			       ad405x_streaming_mode_str[0],
+			       ad405x_streaming_mode_str[1]);
+
+	case SAMPLE_PACKING:
+		return sprintf(buf,
+			       "%s %s",
+			       ad405x_sample_packing_str[0],
+			       ad405x_sample_packing_str[1]);
+
 	default:
 		break;
 	}
@@ -1218,6 +1433,34 @@ static int32_t ad405x_assign_device(uint8_t dev_type,
 	return 0;
 }
 
+/**
+* @brief	Select the packed size of the IIO buffer samples
+* @return	Packed size in bits, 0 when the samples are not packed
+* @note	The samples are packed in the smallest of 16/20/24 bits holding the
+*			resolution, if that is smaller than the storage slot.
+*/
+static uint8_t ad405x_select_packed_bits(void)
+{
+	uint8_t packed_bits = 0;
+
+	if ((ad405x_sample_packing == SAMPLE_PACKING_TIGHT) &&
+	    (ad405x_interface_mode == SPI_INTR)) {
+		if (resolution <= 16) {
+			packed_bits = 16;
+		} else if (resolution <= 20) {
+			packed_bits = 20;
+		} else if (resolution <= 24) {
+			packed_bits = 24;
+		}
+
+		if (packed_bits >= storage_bits) {
+			packed_bits = 0;
+		}
+	}
+
+	return packed_bits;
+}
+
 /**
 * @brief	Init for reading/writing and parameterization of a
 * 			ad405x IIO device
@@ -1227,6 +1470,17 @@ static int32_t ad405x_assign_device(uint8_t dev_type,
 static int32_t iio_ad405x_init(struct iio_device **desc)
 {
 	struct iio_device *iio_ad405x_inst;
+#if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	int32_t ret;
+
+	/* The streaming ring is kept across the in place reconfigurations */
+	if (!ad405x_sdram_ring) {
+		ret = sdram_ring_init(&ad405x_sdram_ring);
+		if (ret) {
+			return ret;
+		}
+	}
+#endif
 
 	iio_ad405x_inst = calloc(1, sizeof(struct iio_device));
 	if (!iio_ad405x_inst) {
@@ -1237,6 +1491,22 @@ static int32_t iio_ad405x_init(struct iio_device **desc)
 
 	iio_ad405x_channels[0].scan_type->storagebits = storage_bits;
 
+#if (ADC_DATA_FORMAT == STRAIGHT_BINARY)
+	iio_ad405x_channels[0].scan_type->sign = 'u';
+#else
+	iio_ad405x_channels[0].scan_type->sign = 's';
+#endif
+
+	/* The IIO buffer carries a byte stream when the samples are packed, the
+	 * sample format within it being reported by the packed_sample_format
+	 * attribute */
+	ad405x_packed_bits = ad405x_select_packed_bits();
+	if (ad405x_packed_bits) {
+		iio_ad405x_channels[0].scan_type->sign = 'u';
+		iio_ad405x_channels[0].scan_type->realbits = 8;
+		iio_ad405x_channels[0].scan_type->storagebits = 8;
+	}
+
 	if (ad405x_interface_mode == I3C_DMA) {
 		iio_ad405x_channels[0].scan_type->is_big_endian = true;
 	} else {
@@ -1356,6 +1626,14 @@ int iio_params_deinit(void)
 
 	iio_init_params.nb_devs = 0;
 
+#if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	/* Free the streaming ring along with the IIO device it telemeters */
+	if (ad405x_sdram_ring) {
+		sdram_ring_remove(ad405x_sdram_ring);
+		ad405x_sdram_ring = NULL;
+	}
+#endif
+
 	return 0;
 }
 
@@ -1399,6 +1677,8 @@ int32_t iio_app_initialize(void)
 	/* IIOD init parameters */
 	static struct iio_device_init iio_device_init_params[NUM_OF_IIO_DEVICES];
 
+	ad405x_applied_config.valid = false;
+
 	/* Add a fixed delay of 1 sec before system init for the PoR sequence to get completed */
 	no_os_mdelay(1000);
 
@@ -1556,6 +1836,10 @@ int32_t iio_app_initialize(void)
 #endif
 
 			iio_init_params.nb_devs++;
+
+			ad405x_applied_config.valid = true;
+			ad405x_applied_config.operating_mode = ad405x_operating_mode;
+			ad405x_applied_config.interface_mode = ad405x_interface_mode;
 		} while (false);
 	}
 
@@ -1595,6 +1879,31 @@ iio_fail:
 	return init_status;
 }
 
+/**
+ * @brief	Apply the staged system configuration to the running device
+ * @return	0 in case of success, negative error code otherwise
+ * @details	The operating mode is written to the device by its attribute
+ *			setter. A new operating or interface mode, or a new packing of
+ *			the IIO buffer samples, changes the IIO context and needs a full
+ *			restart (-EAGAIN). Otherwise the device, the PWM and the IIO
+ *			interface are kept as they are.
+ */
+static int32_t iio_app_apply_config(void)
+{
+	if (!ad405x_applied_config.valid) {
+		/* No device to reconfigure (HW mezzanine not detected) */
+		return -ENODEV;
+	}
+
+	if ((ad405x_operating_mode != ad405x_applied_config.operating_mode)
+	    || (ad405x_interface_mode != ad405x_applied_config.interface_mode)
+	    || (ad405x_select_packed_bits() != ad405x_packed_bits)) {
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+
 /**
  * @brief 	Run the AD405X IIO event handler
  * @return	none
@@ -1603,24 +1912,28 @@ iio_fail:
 void iio_app_event_handler(void)
 {
 	if (restart_iio_flag) {
-		/* Remove and free the pointers allocated during IIO init */
+		/* Reset the restart_iio flag */
+		restart_iio_flag = false;
+
+		/* Keep the device and the IIO interface unless the staged
+		 * configuration changes the IIO context */
+		if (iio_app_apply_config()) {
+			/* Remove and free the pointers allocated during IIO init */
 #if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
-		iio_hw_trig_remove(ad405x_hw_trig_desc);
+			iio_hw_trig_remove(ad405x_hw_trig_desc);
 #endif
-		deinit_pwm();
+			deinit_pwm();
 
-		ad405x_remove(p_ad405x_dev);
+			ad405x_remove(p_ad405x_dev);
 
-		iio_params_deinit();
+			iio_params_deinit();
 
-		remove_iio_context_attributes(iio_init_params.ctx_attrs);
+			remove_iio_context_attributes(iio_init_params.ctx_attrs);
 
-		iio_remove(p_ad405x_iio_desc);
+			iio_remove(p_ad405x_iio_desc);
 
-		/* Reset the restart_iio flag */
-		restart_iio_flag = false;
-
-		iio_app_initialize();
+			iio_app_initialize();
+		}
 	}
 
 #ifdef USE_VIRTUAL_COM_PORT
@@ -19,6 +19,7 @@
 /******************************************************************************/
 #include <stdint.h>
 #include "app_config.h"
+#include "sdram_ring.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -35,9 +36,29 @@ enum ad405x_interface_modes {
 	I3C_INTR
 };
 
+/* Enum of data streaming modes */
+enum ad405x_streaming_modes {
+	/* Data read by the IIO client through the IIO buffer (READBUF) */
+	IIO_BUFFER_STREAMING,
+	/* Data pushed continuously as binary frames over the USB VCOM */
+	USB_BULK_STREAMING
+};
+
+/* Enum of IIO buffer sample packings */
+enum ad405x_sample_packings {
+	/* Samples in storage bits slots */
+	SAMPLE_PACKING_NONE,
+	/* Samples tightly packed in 16/20/24 bits (little endian bit stream) */
+	SAMPLE_PACKING_TIGHT
+};
+
 extern struct ad405x_dev *p_ad405x_dev;
+extern enum ad405x_streaming_modes ad405x_streaming_mode;
+extern enum ad405x_sample_packings ad405x_sample_packing;
+extern uint8_t ad405x_packed_bits;
 extern enum ad405x_interface_modes ad405x_interface_mode;
 extern enum ad405x_operation_mode ad405x_operating_mode;
+extern struct sdram_ring_desc *ad405x_sdram_ring;
 
 int32_t iio_app_initialize(void);
 void iio_app_event_handler(void);
@@ -15,14 +15,17 @@
 /******************************************************************************/
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "iio.h"
 #include "iio_trigger.h"
 #include "app_support.h"
 #include "ad405x_iio.h"
 #include "ad405x_user_config.h"
+#include "sample_format.h"
 
 #include "no_os_error.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -34,6 +37,10 @@
 /* Maximum value the DMA NDTR register can take */
 #define MAX_DMA_NDTR		(no_os_min(65535, MAX_LOCAL_BUF_SIZE/2))
 
+/* Number of samples packed at once into the IIO buffer (a multiple of 2 so
+ * that the 20-bit packed blocks end on a byte boundary) */
+#define PACK_BLOCK_SAMPLES	64
+
 /******************************************************************************/
 /********************** Variables and User Defined Data Types *****************/
 /******************************************************************************/
@@ -53,6 +60,52 @@ extern struct iio_hw_trig *ad405x_hw_trig_desc;
 
 extern uint8_t bytes_per_sample;
 
+/* Samples waiting to be packed into the IIO buffer */
+static uint32_t pack_block[PACK_BLOCK_SAMPLES];
+static uint32_t pack_block_samples;
+
+/* Packed samples staging buffer */
+static uint8_t packed_block[PACK_BLOCK_SAMPLES * sizeof(uint32_t)];
+
+#ifdef MULTI_WINDOW_CAPTURE_AVAILABLE
+/* Number of windows recorded ahead of the host (requested) */
+static uint32_t nb_capture_windows = DEFAULT_CAPTURE_WINDOWS;
+
+/* Number of window slots of the running capture */
+static uint32_t nb_window_slots;
+
+/* Window slots, following the IIO buffer in the ADC data buffer */
+static uint8_t *window_slots;
+
+/* Size of a window (in bytes) */
+static uint32_t window_bytes;
+
+/* Bytes recorded into the window being recorded */
+static uint32_t window_offset;
+
+/* Windows recorded and pulled by the host since the capture start */
+static volatile uint32_t windows_recorded;
+static volatile uint32_t windows_pulled;
+
+/* Index of the first sample of each window slot */
+static uint64_t window_start_sample[MAX_CAPTURE_WINDOWS];
+
+/* Samples streamed by the DMA since the capture start */
+static uint64_t samples_streamed;
+
+/* Samples dropped while all the window slots were pending */
+static volatile uint32_t window_dropped_samples;
+
+/* Conversion period (in nsec) of the running capture */
+static uint32_t window_sample_period_ns;
+
+/* Start of the last pulled window (in usec from the capture start) */
+static uint32_t window_timestamp_us;
+
+/* Cycles spent switching into the data capture */
+static uint32_t mode_switch_ticks;
+#endif
+
 /*
  * @brief  Reconfigures the SPI interface for data transfer.
  * @param  enable_stream[in] - Flag to indicate streaming.
@@ -97,6 +150,73 @@ static int32_t ad405x_spi_reconfigure(bool enable_stream)
 	return 0;
 }
 
+/**
+ * @brief  Write data into the IIO buffer.
+ * @param  buf[in] - IIO buffer.
+ * @param  data[in] - Data to be written.
+ * @param  len[in] - Number of bytes to be written.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note   In continuous data capture the IIO buffer is the streaming ring
+ *         drained by the IIO transport while the capture goes on.
+ */
+static int32_t ad405x_buf_write(struct no_os_circular_buffer *buf,
+				void *data,
+				uint32_t len)
+{
+#if APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE
+	return sdram_ring_write(ad405x_sdram_ring, data, len);
+#else
+	return no_os_cb_write(buf, data, len);
+#endif
+}
+
+/**
+ * @brief  Write the staged samples into the IIO buffer, packed.
+ * @param  buf[in] - IIO buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad405x_flush_pack_block(struct no_os_circular_buffer *buf)
+{
+	int32_t nb_bytes;
+
+	if (!pack_block_samples) {
+		return 0;
+	}
+
+	nb_bytes = sample_pack_le(pack_block, packed_block, pack_block_samples,
+				  ad405x_packed_bits);
+	if (nb_bytes < 0) {
+		return nb_bytes;
+	}
+
+	pack_block_samples = 0;
+
+	return ad405x_buf_write(buf, packed_block, nb_bytes);
+}
+
+/**
+ * @brief  Write a sample into the IIO buffer.
+ * @param  buf[in] - IIO buffer.
+ * @param  adc_data[in] - Sample.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note   With the sample packing, the samples are staged and written as a
+ *         packed block once PACK_BLOCK_SAMPLES are collected.
+ */
+static int32_t ad405x_write_sample(struct no_os_circular_buffer *buf,
+				   uint32_t adc_data)
+{
+	if (!ad405x_packed_bits) {
+		return ad405x_buf_write(buf, &adc_data, bytes_per_sample);
+	}
+
+	pack_block[pack_block_samples++] = adc_data;
+	if (pack_block_samples < PACK_BLOCK_SAMPLES) {
+		return 0;
+	}
+
+	return ad405x_flush_pack_block(buf);
+}
+
 #if APP_CAPTURE_MODE == WINDOWED_DATA_CAPTURE
 /**
  * @brief  Prepares the device for data transfer.
@@ -106,9 +226,12 @@ static int32_t ad405x_spi_reconfigure(bool enable_stream)
  */
 static int32_t ad405x_pre_enable_windowed(void *dev, uint32_t mask)
 {
+	uint32_t start_ticks;
 	int32_t ret;
 
 	if (ad405x_interface_mode == SPI_DMA) {
+		start_ticks = stm32_cycle_counter_get();
+
 		ret = ad405x_set_operation_mode(p_ad405x_dev, ad405x_operating_mode);
 		if (ret) {
 			return ret;
@@ -122,6 +245,9 @@ static int32_t ad405x_pre_enable_windowed(void *dev, uint32_t mask)
 		/* Configure CS and CNV gpios for alternate functionality as
 		 * Timer PWM outputs */
 		stm32_cs_output_gpio_config(false);
+
+		/* The capture start on the first window request completes the switch */
+		mode_switch_ticks = stm32_cycle_counter_get() - start_ticks;
 	}
 
 	return 0;
@@ -160,6 +286,189 @@ static int32_t ad405x_post_disable_windowed(void *dev)
 	return 0;
 }
 
+/**
+ * @brief  Start the multi-window capture.
+ * @param  iio_dev_data[in] - IIO device data instance.
+ * @return 0 in case of success, negative error code otherwise.
+ * @details The conversions and the SPI RX DMA keep running from here until
+ *          the buffer is disabled. Each window request of the host is served
+ *          from the windows recorded back-to-back in the ADC data buffer,
+ *          after the IIO buffer.
+ */
+static int32_t ad405x_window_capture_start(struct iio_device_data
+		*iio_dev_data)
+{
+	uint32_t start_ticks = stm32_cycle_counter_get();
+	uint32_t nb_of_samples = nb_of_bytes_g / bytes_per_sample;
+	int32_t ret;
+
+	window_bytes = nb_of_bytes_g;
+	window_slots = (uint8_t *)iio_dev_data->buffer->buf->buff + window_bytes;
+	nb_window_slots = no_os_min(nb_capture_windows,
+				    (DATA_BUFFER_SIZE - window_bytes) / window_bytes);
+	if (!nb_window_slots) {
+		return -ENOMEM;
+	}
+
+	ret = no_os_pwm_get_period(pwm_desc, &window_sample_period_ns);
+	if (ret) {
+		return ret;
+	}
+
+	window_offset = 0;
+	windows_recorded = 0;
+	windows_pulled = 0;
+	samples_streamed = 0;
+	window_dropped_samples = 0;
+	window_timestamp_us = 0;
+
+	/* Cap SPI RX DMA NDTR to MAX_DMA_NDTR. */
+	rxdma_ndtr = no_os_min(MAX_DMA_NDTR, nb_of_samples);
+
+	/* Register half complete callback, for ping-pong buffers implementation. */
+	HAL_DMA_RegisterCallback(&hdma_spi1_rx,
+				 HAL_DMA_XFER_HALFCPLT_CB_ID,
+				 receivecomplete_callback);
+
+	struct no_os_spi_msg ad405x_spi_msg = {
+		.tx_buff = NULL,
+		.rx_buff = local_buf,
+		.bytes_number = rxdma_ndtr
+	};
+
+	ret = no_os_spi_transfer_dma_async(p_ad405x_dev->com_desc.spi_desc,
+					   &ad405x_spi_msg,
+					   1,
+					   NULL,
+					   NULL);
+	if (ret) {
+		return ret;
+	}
+
+	dma_config_updated = true;
+	update_buff(local_buf, (uint8_t *)window_slots);
+
+	stm32_timer_enable();
+
+	/* Enable TIM DMA request */
+	ret = no_os_pwm_enable(tx_trigger_desc);
+	if (ret) {
+		return ret;
+	}
+
+	mode_switch_ticks += stm32_cycle_counter_get() - start_ticks;
+
+	return 0;
+}
+
+/**
+ * @brief  Record a block of samples read by the DMA into the capture windows.
+ * @param  data[in] - Samples read by the DMA.
+ * @param  len[in] - Number of bytes.
+ * @return None
+ * @note   Called from the SPI RX DMA (half) complete interrupt. The block is
+ *         dropped when all the window slots are pending, the next window
+ *         then starts at a later block.
+ */
+void ad405x_window_capture_handler(const uint8_t *data, uint32_t len)
+{
+	uint32_t slot;
+	uint32_t chunk;
+
+	while (len) {
+		if (windows_recorded - windows_pulled >= nb_window_slots) {
+			window_dropped_samples += len / bytes_per_sample;
+			samples_streamed += len / bytes_per_sample;
+			return;
+		}
+
+		slot = windows_recorded % nb_window_slots;
+		if (!window_offset) {
+			window_start_sample[slot] = samples_streamed;
+		}
+
+		chunk = no_os_min(len, window_bytes - window_offset);
+		memcpy(window_slots + (slot * window_bytes) + window_offset, data, chunk);
+
+		window_offset += chunk;
+		samples_streamed += chunk / bytes_per_sample;
+		data += chunk;
+		len -= chunk;
+
+		if (window_offset == window_bytes) {
+			window_offset = 0;
+			windows_recorded++;
+		}
+	}
+}
+
+/**
+ * @brief  Pull the oldest recorded window into the IIO buffer.
+ * @param  iio_dev_data[in] - IIO device data instance.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad405x_window_capture_pull(struct iio_device_data *iio_dev_data)
+{
+	uint32_t slot = windows_pulled % nb_window_slots;
+	int32_t ret;
+
+	ret = no_os_cb_write(iio_dev_data->buffer->buf,
+			     window_slots + (slot * window_bytes),
+			     window_bytes);
+	if (ret) {
+		return ret;
+	}
+
+	window_timestamp_us = (window_start_sample[slot] * window_sample_period_ns) /
+			      1000;
+
+	/* Free the window slot for the recording */
+	windows_pulled++;
+
+	return 0;
+}
+
+/**
+ * @brief  Set the number of windows recorded ahead of the host.
+ * @param  nb_windows[in] - Number of windows.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note   Applied at the next capture start.
+ */
+int32_t ad405x_set_capture_windows(uint32_t nb_windows)
+{
+	if (!nb_windows || nb_windows > MAX_CAPTURE_WINDOWS) {
+		return -EINVAL;
+	}
+
+	nb_capture_windows = nb_windows;
+
+	return 0;
+}
+
+/**
+ * @brief  Get the number of windows recorded ahead of the host.
+ * @return Number of windows.
+ */
+uint32_t ad405x_get_capture_windows(void)
+{
+	return nb_capture_windows;
+}
+
+/**
+ * @brief  Get the multi-window capture status.
+ * @param  status[out] - Capture status.
+ * @return None
+ */
+void ad405x_get_window_capture_status(struct ad405x_window_capture_status
+				      *status)
+{
+	status->pending = dma_config_updated ? (windows_recorded - windows_pulled) : 0;
+	status->timestamp_us = window_timestamp_us;
+	status->dropped_samples = window_dropped_samples;
+	status->mode_switch_latency_us = ((uint64_t)mode_switch_ticks * 1000000) /
+					 stm32_cycle_counter_freq();
+}
+
 /**
  * @brief Writes all the samples from the ADC buffer into the
 		  IIO buffer.
@@ -172,6 +481,8 @@ static int32_t ad405x_submit_windowed(struct iio_device_data *iio_dev_data)
 	uint32_t adc_data;
 	int32_t ret;
 	uint32_t nb_of_samples;
+	uint32_t nb_of_packed_samples = 0;
+	uint32_t nb_of_padding_bytes;
 
 	data_ready = false;
 	nb_of_samples = iio_dev_data->buffer->size / bytes_per_sample;
@@ -205,6 +516,14 @@ static int32_t ad405x_submit_windowed(struct iio_device_data *iio_dev_data)
 			return ret;
 		}
 
+		if (ad405x_packed_bits) {
+			/* The buffer holds the packed stream, fill it with as many
+			 * samples as it fits */
+			nb_of_samples = (iio_dev_data->buffer->size * 8) / ad405x_packed_bits;
+			nb_of_packed_samples = nb_of_samples;
+			pack_block_samples = 0;
+		}
+
 		ret = no_os_pwm_enable(pwm_desc);
 		if (ret) {
 			return ret;
@@ -223,7 +542,7 @@ static int32_t ad405x_submit_windowed(struct iio_device_data *iio_dev_data)
 				return ret;
 			}
 
-			ret = no_os_cb_write(iio_dev_data->buffer->buf, &adc_data, bytes_per_sample);
+			ret = ad405x_write_sample(iio_dev_data->buffer->buf, adc_data);
 			if (ret) {
 				return ret;
 			}
@@ -231,6 +550,25 @@ static int32_t ad405x_submit_windowed(struct iio_device_data *iio_dev_data)
 			data_ready = false;
 		}
 
+		if (ad405x_packed_bits) {
+			ret = ad405x_flush_pack_block(iio_dev_data->buffer->buf);
+			if (ret) {
+				return ret;
+			}
+
+			/* Zero pad the tail of the buffer not holding a whole sample */
+			nb_of_padding_bytes = iio_dev_data->buffer->size -
+					      NO_OS_DIV_ROUND_UP(nb_of_packed_samples * ad405x_packed_bits, 8);
+			if (nb_of_padding_bytes) {
+				memset(packed_block, 0, nb_of_padding_bytes);
+				ret = no_os_cb_write(iio_dev_data->buffer->buf, packed_block,
+						     nb_of_padding_bytes);
+				if (ret) {
+					return ret;
+				}
+			}
+		}
+
 		ret = no_os_pwm_disable(pwm_desc);
 		if (ret) {
 			return ret;
@@ -248,51 +586,15 @@ static int32_t ad405x_submit_windowed(struct iio_device_data *iio_dev_data)
 			return ret;
 		}
 	} else {
-		ret = no_os_cb_prepare_async_write(iio_dev_data->buffer->buf,
-						   nb_of_samples * (bytes_per_sample),
-						   (void **) &buff_start_addr,
-						   &data_read);
-		if (ret) {
-			return ret;
-		}
-
 		if (!dma_config_updated) {
-			/* Cap SPI RX DMA NDTR to MAX_DMA_NDTR. */
-			rxdma_ndtr = no_os_min(MAX_DMA_NDTR, nb_of_samples);
-
-			/* Register half complete callback, for ping-pong buffers implementation. */
-			HAL_DMA_RegisterCallback(&hdma_spi1_rx,
-						 HAL_DMA_XFER_HALFCPLT_CB_ID,
-						 receivecomplete_callback);
-
-			struct no_os_spi_msg ad405x_spi_msg = {
-				.tx_buff = NULL,
-				.rx_buff = local_buf,
-				.bytes_number = rxdma_ndtr
-			};
-
-			ret = no_os_spi_transfer_dma_async(p_ad405x_dev->com_desc.spi_desc,
-							   &ad405x_spi_msg,
-							   1,
-							   NULL,
-							   NULL);
+			ret = ad405x_window_capture_start(iio_dev_data);
 			if (ret) {
 				return ret;
 			}
-
-			dma_config_updated = true;
-			update_buff(local_buf, (uint8_t *)buff_start_addr);
-
-			stm32_timer_enable();
 		}
 
-		dma_cycle_count = (nb_of_bytes_g + rxdma_ndtr - 1) / rxdma_ndtr;
-		nb_of_bytes_remaining_g = nb_of_bytes_g - (rxdma_ndtr * (dma_cycle_count - 1));
-
-		/* Enable TIM DMA request */
-		no_os_pwm_enable(tx_trigger_desc);
-
-		while (data_ready != true && timeout > 0) {
+		/* Wait for a recorded window */
+		while (windows_recorded == windows_pulled && timeout > 0) {
 			timeout--;
 		}
 
@@ -300,7 +602,10 @@ static int32_t ad405x_submit_windowed(struct iio_device_data *iio_dev_data)
 			return -EIO;
 		}
 
-		no_os_cb_end_async_write(iio_dev_data->buffer->buf);
+		ret = ad405x_window_capture_pull(iio_dev_data);
+		if (ret) {
+			return ret;
+		}
 	}
 
 	return 0;
@@ -375,6 +680,7 @@ static int32_t ad405x_post_disable_continuous(void *dev)
 		stm32_timer_stop();
 		no_os_spi_transfer_abort(p_ad405x_dev->com_desc.spi_desc);
 		stm32_cs_output_gpio_config(true);
+		HAL_DMA_UnRegisterCallback(&AD405x_RxDMA_HANDLE, HAL_DMA_XFER_HALFCPLT_CB_ID);
 
 		ret = ad405x_spi_reconfigure(false);
 		if (ret) {
@@ -393,6 +699,9 @@ static int32_t ad405x_post_disable_continuous(void *dev)
 		if (ret) {
 			return ret;
 		}
+
+		/* Discard the samples left out of the last packed block */
+		pack_block_samples = 0;
 	}
 
 	buf_size_updated = false;
@@ -410,11 +719,15 @@ static int32_t ad405x_post_disable_continuous(void *dev)
 		  IIO buffer.
  * @param iio_dev_data[in] - IIO device data instance.
  * @return Number of samples read.
+ * @note  The SPI RX DMA runs into the local ping-pong buffer and each
+ *		  completed half is written into the streaming ring, which drops it
+ *		  as a whole when the host has not drained enough room.
  */
 static int32_t ad405x_submit_continuous(struct iio_device_data *iio_dev_data)
 {
 	int32_t ret;
 	uint32_t nb_of_samples;
+	uint32_t bytes_per_scan = iio_dev_data->buffer->bytes_per_scan;
 
 	data_ready = false;
 	nb_of_samples = iio_dev_data->buffer->size / bytes_per_sample;
@@ -422,30 +735,39 @@ static int32_t ad405x_submit_continuous(struct iio_device_data *iio_dev_data)
 	iio_dev_data_g = iio_dev_data;
 
 	if (!buf_size_updated) {
-		/* Update total buffer size according to bytes per scan for proper
-		 * alignment of multi-channel IIO buffer data */
-		iio_dev_data->buffer->buf->size = iio_dev_data->buffer->size;
-		buf_size_updated = true;
-	}
-
-	if (!dma_config_updated) {
-		ret = no_os_cb_prepare_async_write(iio_dev_data->buffer->buf,
-						   nb_of_samples * (bytes_per_sample),
-						   (void **) &buff_start_addr,
-						   &data_read);
+		/* Stream through the whole data buffer, with the total buffer size
+		 * aligned to bytes per scan for proper alignment of multi-channel
+		 * IIO buffer data */
+		ret = sdram_ring_start(ad405x_sdram_ring,
+				       iio_dev_data->buffer->buf,
+				       DATA_BUFFER_SIZE,
+				       bytes_per_scan);
 		if (ret) {
 			return ret;
 		}
+		buf_size_updated = true;
+	}
 
-		/* Cap SPI RX DMA NDTR to MAX_DMA_NDTR. */
+	if (!dma_config_updated) {
+		/* Cap SPI RX DMA NDTR to MAX_DMA_NDTR, with whole scans in each
+		 * half of the DMA buffer */
 		rxdma_ndtr = no_os_min(MAX_DMA_NDTR, nb_of_samples);
+		rxdma_ndtr = no_os_max(rxdma_ndtr - (rxdma_ndtr % bytes_per_scan),
+				       bytes_per_scan);
+
+		/* Register half complete callback, for ping-pong buffers implementation. */
+		HAL_DMA_RegisterCallback(&AD405x_RxDMA_HANDLE,
+					 HAL_DMA_XFER_HALFCPLT_CB_ID,
+					 receivecomplete_callback);
 
 		struct no_os_spi_msg ad405x_spi_msg = {
 			.tx_buff = NULL,
-			.rx_buff = (uint8_t *)buff_start_addr,
+			.rx_buff = local_buf,
 			.bytes_number = rxdma_ndtr
 		};
 
+		update_buff(local_buf, (uint8_t *)iio_dev_data->buffer->buf->buff);
+
 		ret = no_os_spi_transfer_dma_async(p_ad405x_dev->com_desc.spi_desc,
 						   &ad405x_spi_msg,
 						   1,
@@ -479,10 +801,16 @@ static int32_t ad405x_trigger_handler_continuous(struct iio_device_data
 	uint32_t adc_data;
 
 	if (!buf_size_updated) {
-		/* Update total buffer size according to bytes per scan for proper
-		 * alignment of multi-channel IIO buffer data */
-		iio_dev_data->buffer->buf->size = ((uint32_t)(DATA_BUFFER_SIZE /
-						   iio_dev_data->buffer->bytes_per_scan)) * iio_dev_data->buffer->bytes_per_scan;
+		/* Stream through the whole data buffer, with the total buffer size
+		 * aligned to bytes per scan for proper alignment of multi-channel
+		 * IIO buffer data */
+		ret = sdram_ring_start(ad405x_sdram_ring,
+				       iio_dev_data->buffer->buf,
+				       DATA_BUFFER_SIZE,
+				       iio_dev_data->buffer->bytes_per_scan);
+		if (ret) {
+			return ret;
+		}
 		buf_size_updated = true;
 	}
 
@@ -492,7 +820,7 @@ static int32_t ad405x_trigger_handler_continuous(struct iio_device_data
 		return ret;
 	}
 
-	return no_os_cb_write(iio_dev_data->buffer->buf, &adc_data, bytes_per_sample);
+	return ad405x_write_sample(iio_dev_data->buffer->buf, adc_data);
 }
 
 #endif
@@ -364,6 +364,7 @@ static int32_t ad406x_post_disable_continuous(void *dev)
 		if (ret)
 			return ret;
 
+		HAL_DMA_UnRegisterCallback(&AD405x_RxDMA_HANDLE, HAL_DMA_XFER_HALFCPLT_CB_ID);
 		dma_config_updated = false;
 	}
 
@@ -377,6 +378,115 @@ static int32_t ad406x_post_disable_continuous(void *dev)
 	return 0;
 }
 
+#ifdef USB_STREAM_SUPPORT_AVAILABLE
+/**
+ * @brief Streams the I3C DMA data to the host as binary frames over the USB
+ *		  VCOM until the host stops it.
+ * @param iio_dev_data[in] - IIO device data instance.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note  The DMA runs into the local ping-pong buffer and each half is sent
+ *		  to the USB endpoint as it completes, without copying it through the
+ *		  IIO buffer. The READBUF request that started the stream is completed
+ *		  afterwards with the last streamed samples.
+ */
+static int32_t ad406x_stream_continuous(struct iio_device_data *iio_dev_data)
+{
+	struct stm32_usb_stream_init_param usb_stream_init_params = {
+		.uart_desc = uart_iio_com_desc,
+		.buf = local_adc_data,
+		.block_size = MAX_DMA_BYTES / 2,
+		.nb_blocks = 2
+	};
+	struct stm32_usb_stream_desc *stream_desc;
+	int32_t ret;
+	uint32_t adc_data;
+
+	rxdma_ndtr = MAX_DMA_BYTES;
+
+	struct no_os_i3c_msg i3c_data_read_msg = {
+		.tx_buff = NULL,
+		.tx_size = 0,
+		.rx_buff = local_adc_data,
+		.rx_size = rxdma_ndtr
+	};
+
+	ret = stm32_usb_stream_init(&stream_desc, &usb_stream_init_params);
+	if (ret) {
+		return ret;
+	}
+
+	/* Both the halves of the DMA buffer are streamed */
+	HAL_DMA_RegisterCallback(&AD405x_RxDMA_HANDLE,
+				 HAL_DMA_XFER_HALFCPLT_CB_ID,
+				 receivecomplete_callback);
+	usb_stream_desc = stream_desc;
+
+	/*
+	 * Read the data to start a new conversion and Update the address pointer of
+	 * ADC to point to the necessary data register.
+	 */
+	ret = ad405x_read(p_ad405x_dev,
+			  AD405X_REG_CONV_READ(bytes_per_sample - 1),
+			  (uint8_t *)&adc_data,
+			  bytes_per_sample);
+	if (ret) {
+		goto err_stream;
+	}
+
+	ret = no_os_i3c_transfer_dma_async(p_ad405x_dev->com_desc.i3c_desc,
+					   &i3c_data_read_msg, 1, NULL, NULL);
+	if (ret) {
+		goto err_stream;
+	}
+
+	/* Stop the previous CR transaction */
+	ret = no_os_dma_xfer_abort(ad405x_dma_desc, &ad405x_dma_desc->channels[0]);
+	if (ret) {
+		goto err_xfer;
+	}
+
+	/* Set the trigger for TC DMA to write the address */
+	ret = no_os_dma_config_xfer(ad405x_dma_desc,
+				    &i3c_cr_dma_xfer,
+				    1,
+				    &ad405x_dma_desc->channels[0]);
+	if (ret) {
+		goto err_xfer;
+	}
+
+	ret = no_os_dma_xfer_start(ad405x_dma_desc, &ad405x_dma_desc->channels[0]);
+	if (ret) {
+		goto err_xfer;
+	}
+
+	/* Disable requested interrupts */
+	__HAL_I3C_DISABLE_IT(&I3C_HANDLE, (HAL_I3C_IT_FCIE | HAL_I3C_IT_ERRIE));
+
+	ret = no_os_pwm_enable(pwm_desc);
+	if (ret) {
+		goto err_xfer;
+	}
+
+	ret = stm32_usb_stream_run(stream_desc);
+
+	(void)no_os_pwm_disable(pwm_desc);
+err_xfer:
+	/* Abort the I3C transaction along with the DMA */
+	(void)no_os_i3c_transfer_abort(p_ad405x_dev->com_desc.i3c_desc);
+err_stream:
+	usb_stream_desc = NULL;
+	HAL_DMA_UnRegisterCallback(&AD405x_RxDMA_HANDLE, HAL_DMA_XFER_HALFCPLT_CB_ID);
+	stm32_usb_stream_remove(stream_desc);
+
+	if (ret) {
+		return ret;
+	}
+
+	return no_os_cb_write(iio_dev_data->buffer->buf, local_adc_data,
+			      no_os_min(nb_of_bytes_g, MAX_DMA_BYTES));
+}
+#endif
+
 /**
  * @brief Writes all the samples from the ADC buffer into the
 		  IIO buffer. Only I3C DMA function reaches here.
@@ -394,32 +504,44 @@ static int32_t ad406x_submit_continuous(struct iio_device_data *iio_dev_data)
 	iio_dev_data_g = iio_dev_data;
 
 	if (!buf_size_updated) {
-		/* Update total buffer size according to bytes per scan for proper
-		 * alignment of multi-channel IIO buffer data */
-		iio_dev_data->buffer->buf->size = iio_dev_data->buffer->size;
-		buf_size_updated = true;
-	}
-
-	if (!dma_config_updated) {
-
-		ret = no_os_cb_prepare_async_write(iio_dev_data->buffer->buf,
-						   nb_of_bytes_g,
-						   (void **) &buff_start_addr,
-						   &data_read);
+		/* Stream through the whole data buffer, with the total buffer size
+		 * aligned to bytes per scan for proper alignment of multi-channel
+		 * IIO buffer data */
+		ret = sdram_ring_start(ad405x_sdram_ring,
+				       iio_dev_data->buffer->buf,
+				       DATA_BUFFER_SIZE,
+				       iio_dev_data->buffer->bytes_per_scan);
 		if (ret) {
 			return ret;
 		}
+		buf_size_updated = true;
+	}
 
-		/* Cap I3C RX DMA NDTR to MAX_DMA_NDTR. */
+#ifdef USB_STREAM_SUPPORT_AVAILABLE
+	if (ad405x_streaming_mode == USB_BULK_STREAMING) {
+		return ad406x_stream_continuous(iio_dev_data);
+	}
+#endif
+
+	if (!dma_config_updated) {
+		/* Cap I3C RX DMA NDTR to MAX_DMA_NDTR, 8B aligned so that each half
+		 * of the DMA buffer holds whole scans */
 		rxdma_ndtr = no_os_min(MAX_DMA_BYTES, nb_of_bytes_g);
+		rxdma_ndtr = no_os_max(rxdma_ndtr - (rxdma_ndtr % ALIGN_SIZE), ALIGN_SIZE);
 
 		struct no_os_i3c_msg i3c_data_read_msg = {
 			.tx_buff = NULL,
 			.tx_size = 0,
-			.rx_buff = (uint8_t *)buff_start_addr,
+			.rx_buff = local_adc_data,
 			.rx_size = rxdma_ndtr
 		};
 
+		/* Both the halves of the DMA buffer are written into the ring */
+		HAL_DMA_RegisterCallback(&AD405x_RxDMA_HANDLE,
+					 HAL_DMA_XFER_HALFCPLT_CB_ID,
+					 receivecomplete_callback);
+		update_buff(local_adc_data, (uint8_t *)iio_dev_data->buffer->buf->buff);
+
 		/*
 		 * Read the data to start a new conversion and Update the address pointer of
 		 * ADC to point to the necessary data register.
@@ -484,10 +606,16 @@ static int32_t ad406x_trigger_handler_continuous(struct iio_device_data
 	uint32_t adc_data;
 
 	if (!buf_size_updated) {
-		/* Update total buffer size according to bytes per scan for proper
-		 * alignment of multi-channel IIO buffer data */
-		iio_dev_data->buffer->buf->size = ((uint32_t)(DATA_BUFFER_SIZE /
-						   iio_dev_data->buffer->bytes_per_scan)) * iio_dev_data->buffer->bytes_per_scan;
+		/* Stream through the whole data buffer, with the total buffer size
+		 * aligned to bytes per scan for proper alignment of multi-channel
+		 * IIO buffer data */
+		ret = sdram_ring_start(ad405x_sdram_ring,
+				       iio_dev_data->buffer->buf,
+				       DATA_BUFFER_SIZE,
+				       iio_dev_data->buffer->bytes_per_scan);
+		if (ret) {
+			return ret;
+		}
 		buf_size_updated = true;
 	}
 
@@ -511,7 +639,7 @@ static int32_t ad406x_trigger_handler_continuous(struct iio_device_data
 		return ret;
 	}
 
-	return no_os_cb_write(iio_dev_data->buffer->buf, &adc_data, bytes_per_sample);
+	return sdram_ring_write(ad405x_sdram_ring, &adc_data, bytes_per_sample);
 }
 
 #endif
@@ -19,6 +19,7 @@
 #include "app_config_stm32.h"
 #include "ad405x_iio.h"
 #include "ad405x.h"
+#include "app_support.h"
 #include "iio.h"
 
 #ifdef STM32F469xx
@@ -244,6 +245,11 @@ volatile int dma_cycle_count = 0;
 /* The number of transactions requested for the RX DMA stream */
 uint32_t rxdma_ndtr;
 
+#ifdef USB_STREAM_SUPPORT_AVAILABLE
+/* USB stream descriptor (valid while the data is streamed over USB) */
+struct stm32_usb_stream_desc *usb_stream_desc;
+#endif
+
 /* Pointer to start of the IIO buffer */
 volatile uint8_t *iio_buf_start_idx;
 
@@ -435,6 +441,9 @@ void stm32_system_init(void)
 	MX_SPI1_Init();
 	MX_USB_DEVICE_Init();
 	HAL_NVIC_DisableIRQ(STM32_GP1_IRQ);
+#ifdef MULTI_WINDOW_CAPTURE_AVAILABLE
+	stm32_cycle_counter_enable();
+#endif
 #endif
 #ifdef STM32H563xx
 
@@ -515,52 +524,27 @@ void update_buff(uint8_t *local_buf, uint8_t *buf_start_addr)
  */
 void receivecomplete_callback(DMA_HandleTypeDef * hdma)
 {
-#if (APP_CAPTURE_MODE == WINDOWED_DATA_CAPTURE)
 	uint32_t half_cmplt_size = rxdma_ndtr;
 
-	if (dma_cycle_count) {
-
-		dma_cycle_count--;
-
-		/* Update samples captured so far */
-		if (dma_cycle_count) {
-			memcpy((void *)iio_buf_current_idx,
-			       (void *)dma_buf_current_idx,
-			       half_cmplt_size);
-
-			/* Update the current IIO buffer pointer */
-			iio_buf_current_idx += half_cmplt_size;
-		} else {
-
-			/* Stop timers at the last entry to the callback */
-			TIM8->DIER &= ~TIM_DIER_CC1DE;
-
-			/* Timer is already stopped in GPDMA1_Channel1_IRQHandler */
-			memcpy((void *)iio_buf_current_idx,
-			       (void *)dma_buf_current_idx,
-			       nb_of_bytes_remaining_g);
-
-			/* Update the current IIO buffer pointer */
-			iio_buf_current_idx = iio_buf_start_idx;
-			data_ready = true;
-		}
-	}
+#if (APP_CAPTURE_MODE == WINDOWED_DATA_CAPTURE)
+	/* Record the completed DMA buffer half into the capture windows */
+	ad405x_window_capture_handler((const uint8_t *)dma_buf_current_idx,
+				      half_cmplt_size);
+#elif (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	/* Write the completed DMA buffer half into the streaming ring, which
+	 * drops it when the host has not drained enough room */
+	sdram_ring_write(ad405x_sdram_ring,
+			 (const void *)dma_buf_current_idx,
+			 half_cmplt_size);
+#endif
 
-	/* Update the current DMA and IIO buffer pointers */
+	/* Update the current DMA buffer pointer */
 	if (dma_buf_current_idx != dma_buf_start_idx) {
 		dma_buf_current_idx = dma_buf_start_idx;
 	} else {
 		dma_buf_current_idx += half_cmplt_size;
 	}
 
-#elif (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
-	no_os_cb_end_async_write(iio_dev_data_g->buffer->buf);
-	no_os_cb_prepare_async_write(iio_dev_data_g->buffer->buf,
-				     nb_of_bytes_g,
-				     (void **)&buff_start_addr,
-				     &data_read);
-#endif
-
 	return;
 }
 
@@ -570,14 +554,6 @@ void receivecomplete_callback(DMA_HandleTypeDef * hdma)
   */
 void DMA2_Stream0_IRQHandler(void)
 {
-#if (APP_CAPTURE_MODE == WINDOWED_DATA_CAPTURE)
-	/* Stop timers at the last entry to the callback */
-	if (dma_cycle_count == 1) {
-
-		TIM8->DIER &= ~TIM_DIER_CC1DE;
-	}
-#endif
-
 	HAL_DMA_IRQHandler(&hdma_spi1_rx);
 }
 
@@ -718,10 +694,10 @@ void GPDMA1_Channel1_IRQHandler(void)
  */
 void receivecomplete_callback(DMA_HandleTypeDef *hdma)
 {
-#if (APP_CAPTURE_MODE == WINDOWED_DATA_CAPTURE)
 	/* rxdma_ndtr is always 2B or 4B aligned */
 	uint32_t half_cmplt_size = rxdma_ndtr >> 1;
 
+#if (APP_CAPTURE_MODE == WINDOWED_DATA_CAPTURE)
 	if (dma_cycle_count) {
 
 		dma_cycle_count--;
@@ -758,11 +734,26 @@ void receivecomplete_callback(DMA_HandleTypeDef *hdma)
 	}
 
 #elif (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
-	no_os_cb_end_async_write(iio_dev_data_g->buffer->buf);
-	no_os_cb_prepare_async_write(iio_dev_data_g->buffer->buf,
-				     nb_of_bytes_g,
-				     (void **)&buff_start_addr,
-				     &data_read);
+#ifdef USB_STREAM_SUPPORT_AVAILABLE
+	/* The DMA buffer halves are sent to the host as they complete */
+	if (usb_stream_desc) {
+		stm32_usb_stream_block_done(usb_stream_desc);
+		return;
+	}
+#endif
+
+	/* Write the completed DMA buffer half into the streaming ring, which
+	 * drops it when the host has not drained enough room */
+	sdram_ring_write(ad405x_sdram_ring,
+			 (const void *)dma_buf_current_idx,
+			 half_cmplt_size);
+
+	/* Update the current DMA buffer pointer */
+	if (dma_buf_current_idx != dma_buf_start_idx) {
+		dma_buf_current_idx = dma_buf_start_idx;
+	} else {
+		dma_buf_current_idx += half_cmplt_size;
+	}
 #endif
 
 	return;
@@ -30,10 +30,12 @@
 #ifdef STM32F469xx
 #include "stm32_spi.h"
 #include "stm32_usb_uart.h"
+#include "stm32_cycle_counter.h"
 #endif
 #ifdef STM32H563xx
 #include "stm32_i3c.h"
 #include "stm32_usb_uart.h"
+#include "stm32_usb_stream.h"
 #endif
 
 /******************************************************************************/
@@ -60,6 +62,11 @@
 #define SDRAM_SUPPORT_AVAILABLE
 #define CONSOLE_STDIO_PORT_AVAILABLE
 
+/* Windowed SPI DMA data recorded as back-to-back windows into the SDRAM */
+#if (APP_CAPTURE_MODE == WINDOWED_DATA_CAPTURE)
+#define MULTI_WINDOW_CAPTURE_AVAILABLE
+#endif
+
 #define I2C_EXTRA_PARAM_PTR			NULL
 #define I2C_MAX_SPEED_HZ			100000
 
@@ -131,6 +138,11 @@
 #define I3C_SUPPORT_AVAILABLE
 #define CONSOLE_STDIO_PORT_AVAILABLE
 
+/* Binary framed streaming of the continuous I3C DMA data over the USBX VCOM */
+#if (APP_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && defined(USE_VIRTUAL_COM_PORT)
+#define USB_STREAM_SUPPORT_AVAILABLE
+#endif
+
 /**** I2C Parameters ****/
 #define I2C_DEV_ID					1    // I2C1
 #define I2C_MAX_SPEED_HZ			100000
@@ -310,6 +322,9 @@ extern struct stm32_dma_channel i3c_dma_txdma_channel;
 #endif
 extern uint32_t rxdma_ndtr;
 extern volatile int dma_cycle_count;
+#ifdef USB_STREAM_SUPPORT_AVAILABLE
+extern struct stm32_usb_stream_desc *usb_stream_desc;
+#endif
 
 void stm32_system_init(void);
 void stm32_system_init_post_verification(void);
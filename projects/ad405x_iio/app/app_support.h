@@ -34,6 +34,13 @@
  * is tested for SDP-K1 platform @180Mhz default core clock */
 #define BUF_READ_TIMEOUT	0xffffffff
 
+#ifdef MULTI_WINDOW_CAPTURE_AVAILABLE
+/* Max number of windows recorded ahead of the host */
+#define MAX_CAPTURE_WINDOWS		16
+/* Number of windows recorded ahead of the host by default */
+#define DEFAULT_CAPTURE_WINDOWS	4
+#endif
+
 /******************************************************************************/
 /********************** Variables and User Defined Data Types *****************/
 /******************************************************************************/
@@ -48,6 +55,28 @@ struct ad405x_support_desc {
 	int32_t (*trigger_handler)(struct iio_device_data *dev);
 };
 
+#ifdef MULTI_WINDOW_CAPTURE_AVAILABLE
+/* Multi-window capture status */
+struct ad405x_window_capture_status {
+	/* Recorded windows not pulled by the host yet */
+	uint32_t pending;
+	/* Start of the last pulled window (in usec from the capture start) */
+	uint32_t timestamp_us;
+	/* Samples dropped while all the windows were pending */
+	uint32_t dropped_samples;
+	/* Time to switch into the data capture (in usec) */
+	uint32_t mode_switch_latency_us;
+};
+#endif
+
 extern const struct ad405x_support_desc *support_desc[];
 
+#ifdef MULTI_WINDOW_CAPTURE_AVAILABLE
+int32_t ad405x_set_capture_windows(uint32_t nb_windows);
+uint32_t ad405x_get_capture_windows(void);
+void ad405x_get_window_capture_status(struct ad405x_window_capture_status
+				      *status);
+void ad405x_window_capture_handler(const uint8_t *data, uint32_t len);
+#endif
+
 #endif /* AD405X_SUPPORT_H_ */
@@ -8,6 +8,7 @@ import os
 import csv
 import math
 from adi.ad405x import *
+from ad405x_sample_unpack import parse_packed_format, unpack_samples
 
 # Global variables
 line = 0
@@ -17,6 +18,7 @@ iterations = 0
 data_capture_abort = False
 chn_count = 0
 data_list = []
+packed_format = None
 
 def key_press_event(key):
     global data_capture_abort
@@ -28,6 +30,7 @@ def init_data_capture():
     global chn_count
     global listener
     global samples_block
+    global packed_format
 
     ######## User configuration ##########
     # Configure the backend for PC to IIOD interface
@@ -57,6 +60,16 @@ def init_data_capture():
     device.rx_buffer_size = samples_block    # Size of the IIO buffer (buffer is submitted during call to rx() method)
     device._rx_data_type = np.uint16         # size of ADC sample
 
+    # Packed samples (sample_packing attribute of the system_config device)
+    # are received as a byte stream and unpacked on the host
+    try:
+        packed_format = parse_packed_format(
+            device._get_iio_dev_attr_str("packed_sample_format"))
+    except Exception:
+        packed_format = None
+    if packed_format:
+        device._rx_data_type = np.uint8
+
     listener = keyboard.Listener(on_press=key_press_event)
     listener.start()
 
@@ -103,6 +116,9 @@ def read_buffered_data():
 
     # Receive data from device
     data = device.rx()
+    if packed_format:
+        signed, realbits, packbits = packed_format
+        data = unpack_samples(data.tobytes(), realbits, packbits, signed)
     if (line == 0):
         print("Data capture started >>")
     print("."*line, end="\r")
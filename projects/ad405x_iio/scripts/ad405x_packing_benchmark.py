@@ -0,0 +1,94 @@
+import sys
+import time
+import iio
+from ad405x_sample_unpack import parse_packed_format, unpack_samples
+
+# Throughput benchmark of the IIO buffer sample packings.
+# For each packing, the firmware is reconfigured (system_config attributes
+# 'sample_packing' and 'reconfigure_system'), the same number of buffers is
+# captured over the same link and the host visible sample rate is reported.
+# The operating mode must be set beforehand to an averaging mode (where the
+# samples are packed), e.g. with the 'operating_mode' attribute.
+
+######## User configuration ##########
+uri = "serial:COM16,230400"     # Must be same as set in the FW
+device_name = "ad4052"          # Name of the device must be same as set in the FW
+buffer_size = 4000              # Buffer size (in IIO buffer samples)
+nb_buffers = 20                 # Number of buffers captured per packing
+reconfigure_delay = 5           # Time (in sec) for the firmware to restart the IIO
+######################################
+
+def open_context():
+    ctx = iio.Context(uri)
+    ctx.set_timeout(100000)
+    return ctx
+
+def select_packing(ctx, packing):
+    system = ctx.find_device("system_config")
+    if "sample_packing" not in system.attrs:
+        raise RuntimeError("Sample packing not supported by the firmware")
+    system.attrs["sample_packing"].value = packing
+    system.attrs["reconfigure_system"].value = "enable"
+
+def run_capture(ctx):
+    dev = ctx.find_device(device_name)
+    chn = dev.find_channel("voltage0")
+    chn.enabled = True
+
+    fmt = None
+    if "packed_sample_format" in dev.attrs:
+        fmt = parse_packed_format(dev.attrs["packed_sample_format"].value)
+
+    buf = iio.Buffer(dev, buffer_size)
+    nb_bytes = 0
+    nb_samples = 0
+
+    start = time.perf_counter()
+    for _ in range(nb_buffers):
+        buf.refill()
+        data = buf.read()
+        nb_bytes += len(data)
+        if fmt:
+            signed, realbits, packbits = fmt
+            nb_samples += len(unpack_samples(data, realbits, packbits, signed))
+        else:
+            nb_samples += (len(data) * 8) // chn.data_format.length
+    elapsed = time.perf_counter() - start
+
+    del buf
+    chn.enabled = False
+    return fmt, nb_bytes, nb_samples, elapsed
+
+def main():
+    ctx = open_context()
+    results = []
+
+    for packing in ("none", "packed"):
+        select_packing(ctx, packing)
+
+        # The firmware re-creates its IIO interface on a packing change:
+        # release the context (this is the last reference, which closes
+        # the connection) and connect again once the firmware is back
+        del ctx
+        time.sleep(reconfigure_delay)
+        ctx = open_context()
+
+        fmt, nb_bytes, nb_samples, elapsed = run_capture(ctx)
+        results.append((packing, fmt, nb_bytes, nb_samples, elapsed))
+
+    print("{:<8} {:<12} {:>12} {:>12} {:>14}".format(
+        "packing", "sample bits", "bytes/s", "samples/s", "bytes/sample"))
+    for packing, fmt, nb_bytes, nb_samples, elapsed in results:
+        bits = "{}/{}".format(fmt[1], fmt[2]) if fmt else "slot"
+        print("{:<8} {:<12} {:>12.0f} {:>12.0f} {:>14.2f}".format(
+            packing, bits, nb_bytes / elapsed, nb_samples / elapsed,
+            nb_bytes / nb_samples))
+
+    if results[0][3] and results[1][3]:
+        gain = (results[1][3] / results[1][4]) / (results[0][3] / results[0][4])
+        print("Packed/unpacked host sample rate: {:.2f}x".format(gain))
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1:
+        uri = sys.argv[1]
+    main()
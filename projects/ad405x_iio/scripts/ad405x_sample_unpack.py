@@ -0,0 +1,67 @@
+import re
+import numpy as np
+
+# Unpacker of the packed IIO buffer sample stream of the AD405x firmware.
+# With the system_config 'sample_packing' attribute set to 'packed', the
+# averaging mode samples are packed tightly in 16, 20 or 24 bits, LSB first:
+# sample n takes the bits [n * bits, (n + 1) * bits) of the byte stream (two
+# 20-bit samples in 5 bytes). The 'packed_sample_format' device attribute
+# reports the sample format within the stream in the IIO notation,
+# e.g. "le:s20/20>>0", or "none" when the samples are not packed.
+
+PACKED_FORMAT = re.compile(r"le:([su])(\d+)/(\d+)>>0")
+
+def parse_packed_format(fmt):
+    """Return (signed, realbits, packbits), or None if the samples are not packed"""
+    match = PACKED_FORMAT.fullmatch(fmt.strip())
+    if not match:
+        return None
+    return (match.group(1) == 's', int(match.group(2)), int(match.group(3)))
+
+def unpack_samples(data, realbits, packbits, signed=True):
+    """Unpack the packed byte stream into an int32 array of samples"""
+    data = np.frombuffer(data, dtype=np.uint8)
+    nb_samples = (len(data) * 8) // packbits
+
+    if packbits == 16:
+        words = data[:nb_samples * 2].view('<u2').astype(np.uint32)
+    elif packbits == 24:
+        b = data[:nb_samples * 3].reshape(-1, 3).astype(np.uint32)
+        words = b[:, 0] | (b[:, 1] << 8) | (b[:, 2] << 16)
+    elif packbits == 20:
+        # Zero pad to whole 5 byte pairs, then split each pair
+        nb_pairs = (nb_samples + 1) // 2
+        b = np.zeros(nb_pairs * 5, dtype=np.uint32)
+        b[:min(len(data), nb_pairs * 5)] = data[:nb_pairs * 5]
+        b = b.reshape(-1, 5)
+        words = np.empty(nb_pairs * 2, dtype=np.uint32)
+        words[0::2] = b[:, 0] | (b[:, 1] << 8) | ((b[:, 2] & 0x0F) << 16)
+        words[1::2] = (b[:, 2] >> 4) | (b[:, 3] << 4) | (b[:, 4] << 12)
+        words = words[:nb_samples]
+    else:
+        raise ValueError("Unsupported packed sample size: {}".format(packbits))
+
+    words &= (1 << realbits) - 1
+    if signed:
+        sign = np.uint32(1 << (realbits - 1))
+        return (words ^ sign).astype(np.int32) - np.int32(sign)
+    return words.astype(np.int32)
+
+def pack_samples(samples, packbits):
+    """Pack the samples as the firmware does (reference for tests)"""
+    words = np.asarray(samples).astype(np.int64) & ((1 << packbits) - 1)
+    nb_bits = len(words) * packbits
+    stream = 0
+    for n, word in enumerate(words):
+        stream |= int(word) << (n * packbits)
+    return stream.to_bytes((nb_bits + 7) // 8, 'little')
+
+if __name__ == "__main__":
+    # Round trip self check of the unpacker
+    rng = np.random.default_rng(0)
+    for realbits, packbits in ((14, 16), (20, 20), (20, 24)):
+        for count in (1, 2, 7, 64):
+            ref = rng.integers(-(1 << (realbits - 1)), 1 << (realbits - 1), count)
+            out = unpack_samples(pack_samples(ref, packbits), realbits, packbits)
+            assert np.array_equal(out, ref), (realbits, packbits, count)
+    print("Unpacker round trip OK")
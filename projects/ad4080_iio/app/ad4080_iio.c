@@ -27,6 +27,7 @@
 #include "no_os_alloc.h"
 #include "iio.h"
 #include "iio_trigger.h"
+#include "sample_format.h"
 #include "version.h"
 
 /******************************************************************************/
@@ -59,6 +60,8 @@ static int iio_ad4080_attr_available_set(void *device,
 
 int32_t ad4080_deassert_oscillators(void);
 
+int32_t ad4080_assert_oscillator(void);
+
 int32_t ad4080_iio_start_fifo_mode_capture(uint32_t samples,
 		bool update_fifo_watermark);
 
@@ -131,6 +134,9 @@ static int8_t adc_data_buffer[DATA_BUFFER_SIZE];
 /* Fifo depth limit (watermark count) for data capture */
 #define FIFO_SIZE				16384
 
+/* Max number of bytes preceding the FIFO data in a FIFO read (quad lane) */
+#define FIFO_DATA_OFFSET_MAX	4
+
 /* Maximum threshold code */
 #define MAX_THRESHOLD_CODE		0x7FF
 
@@ -211,6 +217,9 @@ static struct iio_attribute ad4080_iio_ch_attributes[] = {
 static struct iio_attribute ad4080_iio_global_attributes[] = {
 	AD4080_CHN_ATTR("select_conversion_rate", SELECT_SAMPLING_FREQ_ATTR_ID),
 	AD4080_CHN_AVAIL_ATTR("select_conversion_rate_available", SELECT_SAMPLING_FREQ_ATTR_ID),
+	/* A buffer capture larger than fifo_watermark (or the FIFO depth when the
+	 * FIFO is disabled) is done in FIFO batches, with a gap between batches:
+	 * the samples converted while a batch is read out are lost */
 	AD4080_CHN_ATTR("fifo_mode", FIFO_MODE_ATTR_ID),
 	AD4080_CHN_AVAIL_ATTR("fifo_mode_available", FIFO_MODE_ATTR_ID),
 	AD4080_CHN_ATTR("fifo_watermark", FIFO_WATERMARK_ATTR_ID),
@@ -382,16 +391,18 @@ static const float threshold_lsb = 1.46484;
 /* LSB (in millivolts) for the Hysteresis register */
 static const float hysteresis_lsb = 1.46484;
 
-/* Array to store raw data from ADC FIFO */
-static uint8_t fifo_data[1 + AD4080_SIGN_EXTENDED_RESOLUTION_BYTES * FIFO_SIZE];
+/* Array to store raw data of the short FIFO reads (raw attribute and tail of
+ * a streamed capture). Bulk FIFO data is read straight into the IIO buffer. */
+static uint8_t fifo_data[FIFO_DATA_OFFSET_MAX *
+			 (1 + AD4080_SIGN_EXTENDED_RESOLUTION_BYTES)];
 
 /* Offset Correction Coefficient.
  * Twos complement data format where LSB = 0.00572 mV.
  * 0x800 represents −2048 × LSB, and 0x7FF represents +2047 × LSB. */
 static const float offset_correction_coefficient = 0.00572;
 
-/* Formatted data of ADC FIFO raw data */
-static uint32_t actual_fifo_data[FIFO_SIZE];
+/* Formatted data of ADC FIFO raw data (raw attribute) */
+static uint32_t actual_fifo_data[1];
 
 /* Flag to indicate if size of the buffer is updated according to requested
  * number of samples for the multi-channel IIO buffer data alignment */
@@ -1328,24 +1339,56 @@ int32_t ad4080_deassert_oscillators(void)
 }
 
 /**
- * @brief  Initiates data capture into FIFO.
- * @param samples[in] - Number of requested samples.
- * @param update_fifo_watermark[in] - Indication to update ADC FIFO watermark.
+ * @brief  Assert back the oscillator of the chosen sampling frequency.
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t ad4080_iio_start_fifo_mode_capture(uint32_t samples,
-		bool update_fifo_watermark)
+int32_t ad4080_assert_oscillator(void)
+{
+	switch (ad4080_sampling_freq) {
+	case 40000000:
+		/* 40 MHz */
+		return no_os_gpio_set_value(gpio_osc_en_40m_desc, NO_OS_GPIO_HIGH);
+
+	case 20000000:
+		/* 20 MHz */
+		return no_os_gpio_set_value(gpio_osc_en_20m_desc, NO_OS_GPIO_HIGH);
+
+	case 10000000:
+		/* 10 MHz */
+		return no_os_gpio_set_value(gpio_osc_en_10m_desc, NO_OS_GPIO_HIGH);
+
+	default:
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief  Wait for the FIFO full flag (tracked on GPIO3).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad4080_wait_for_fifo_full(void)
 {
-	int32_t ret;
 	uint8_t val;
 	uint32_t timeout = BUF_READ_TIMEOUT;
 
-	/* Check for number of samples requested */
-	if (samples > FIFO_SIZE) {
-		return -EINVAL;
+	while (timeout--) {
+		no_os_gpio_get_value(gpio_gp3_desc, &val);
+		if (val == NO_OS_GPIO_HIGH) {
+			return 0;
+		}
 	}
 
-	/* Enable GPIO3 and set it to track FIFO_FULL */
+	return -ETIMEDOUT;
+}
+
+/**
+ * @brief  Enable GPIO3 and set it to track the FIFO full flag.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad4080_fifo_full_gpio_config(void)
+{
+	int32_t ret;
+
 	ret = ad4080_update_bits(ad4080_dev_inst,
 				 AD4080_REG_GPIO_CONFIG_A,
 				 AD4080_GPIO_EN_MSK(3),
@@ -1354,10 +1397,30 @@ int32_t ad4080_iio_start_fifo_mode_capture(uint32_t samples,
 		return ret;
 	}
 
-	ret = ad4080_update_bits(ad4080_dev_inst,
-				 AD4080_REG_GPIO_CONFIG_C,
-				 AD4080_GPIO_SEL_MSK(3),
-				 no_os_field_prep(AD4080_GPIO_SEL_MSK(3), AD4080_GPIO_FIFO_FULL));
+	return ad4080_update_bits(ad4080_dev_inst,
+				  AD4080_REG_GPIO_CONFIG_C,
+				  AD4080_GPIO_SEL_MSK(3),
+				  no_os_field_prep(AD4080_GPIO_SEL_MSK(3), AD4080_GPIO_FIFO_FULL));
+}
+
+/**
+ * @brief  Initiates data capture into FIFO.
+ * @param samples[in] - Number of requested samples.
+ * @param update_fifo_watermark[in] - Indication to update ADC FIFO watermark.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad4080_iio_start_fifo_mode_capture(uint32_t samples,
+		bool update_fifo_watermark)
+{
+	int32_t ret;
+
+	/* Check for number of samples requested */
+	if (samples > FIFO_SIZE) {
+		return -EINVAL;
+	}
+
+	/* Enable GPIO3 and set it to track FIFO_FULL */
+	ret = ad4080_fifo_full_gpio_config();
 	if (ret) {
 		return ret;
 	}
@@ -1388,23 +1451,47 @@ int32_t ad4080_iio_start_fifo_mode_capture(uint32_t samples,
 	}
 
 	/* Wait for FIFO full flag */
-	while (timeout--) {
-		no_os_gpio_get_value(gpio_gp3_desc, &val);
-		if (val  == NO_OS_GPIO_HIGH) {
-			break;
-		}
-	}
+	ret = ad4080_wait_for_fifo_full();
 
 	/* Deassert all oscillators once data has been captured into FIFO */
-	ret = ad4080_deassert_oscillators();
+	ret |= ad4080_deassert_oscillators();
 	if (ret) {
 		return ret;
 	}
 
-	if (timeout == 0) {
-		return -ETIMEDOUT;
+	return 0;
+}
+
+/**
+ * @brief  Drain the FIFO straight into the IIO buffer.
+ * @param dst[out] - IIO buffer memory receiving the samples.
+ * @param samples[in] - Number of samples to read from FIFO.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note The raw FIFO data is read into the tail of the destination memory and
+ *       unpacked in place, so that no intermediate copy of the data is needed.
+ */
+static int32_t ad4080_fifo_drain(uint32_t *dst, uint32_t samples)
+{
+	int32_t ret;
+	uint8_t *raw;
+	uint8_t data_offset =
+		(ad4080_dev_inst->cnv_spi_lvds_lanes == AD4080_ONE_LANE) ? 1 : 4;
+
+	if (samples < data_offset) {
+		/* Packed data doesn't fit within the destination */
+		raw = fifo_data;
+	} else {
+		raw = (uint8_t *)dst + (samples * BYTES_PER_SAMPLE) -
+		      (samples * AD4080_SIGN_EXTENDED_RESOLUTION_BYTES + data_offset);
+	}
+
+	ret = ad4080_read_fifo_data(ad4080_dev_inst, raw, samples);
+	if (ret) {
+		return ret;
 	}
 
+	sample_unpack_be24(&raw[data_offset], dst, samples);
+
 	return 0;
 }
 
@@ -1434,25 +1521,7 @@ int32_t ad4080_iio_end_fifo_mode_capture(uint32_t *formatted_fifo_data,
 	}
 
 	/* Assert back the chosen oscillator */
-	switch (ad4080_sampling_freq) {
-	case 40000000:
-		/* 40 MHz */
-		no_os_gpio_set_value(gpio_osc_en_40m_desc,
-				     NO_OS_GPIO_HIGH);
-		break;
-
-	case 20000000:
-		/* 20 MHz */
-		no_os_gpio_set_value(gpio_osc_en_20m_desc,
-				     NO_OS_GPIO_HIGH);
-		break;
-
-	case 10000000:
-		/* 10 MHz */
-		no_os_gpio_set_value(gpio_osc_en_10m_desc,
-				     NO_OS_GPIO_HIGH);
-		break;
-	}
+	ad4080_assert_oscillator();
 
 	/* Disable FIFO */
 	ret = ad4080_set_fifo_mode(ad4080_dev_inst, AD4080_FIFO_DISABLE);
@@ -1461,34 +1530,42 @@ int32_t ad4080_iio_end_fifo_mode_capture(uint32_t *formatted_fifo_data,
 	}
 
 	/* Format the FIFO data based on data offset */
-	for (uint32_t idx = 0; idx < samples; idx++) {
-		formatted_fifo_data[idx] =
-			no_os_get_unaligned_be24(&raw_fifo_data[3 * idx + data_offset]);
-	}
+	sample_unpack_be24(&raw_fifo_data[data_offset], formatted_fifo_data, samples);
 
 	return 0;
 }
 
 /**
- * @brief Writes all the samples from the ADC buffer into the
-		  IIO buffer.
+ * @brief Stream the samples from the ADC FIFO into the IIO buffer.
  * @param iio_dev_data[in] - IIO device data instance.
  * @return 0 in case of success, negative value otherwise
+ * @note The request is captured as a series of FIFO batches. Each batch is
+ *       captured into the FIFO up to the watermark (FIFO full event) and then
+ *       drained straight into the IIO buffer, after which the FIFO is re-armed
+ *       for the next batch. The samples within a batch are contiguous, but
+ *       the batches are not: the AD4080 FIFO stops filling at the watermark
+ *       and can't be refilled while it is read out, so the samples converted
+ *       during each drain are lost (a gap of about the drain time between
+ *       consecutive batches).
+ *       As for a single FIFO capture, the oscillators are deasserted while the
+ *       FIFO is read out, so that the ADC doesn't convert (and its clock
+ *       doesn't couple into the data) during the SPI readout.
  */
 static int32_t iio_ad4080_submit_samples(struct iio_device_data *iio_dev_data)
 {
 	int32_t ret;
-	uint32_t remaining_samples = 0;
-	bool update_fifo_watermark = false;
+	uint32_t remaining_samples;
+	uint32_t batch_samples;
+	uint32_t max_batch_samples;
+	uint32_t buff_available_size;
+	uint16_t fifo_watermark = 0;
+	enum ad4080_fifo_mode fifo_mode;
+	void *buff_start;
 
 	/* Update remaining/requested sample count */
 	remaining_samples = iio_dev_data->buffer->size /
 			    iio_dev_data->buffer->bytes_per_scan;
 
-	if (remaining_samples > FIFO_SIZE) {
-		return -EINVAL;
-	}
-
 	if (!buf_size_updated) {
 		/* Update total buffer size according to bytes per scan for proper
 		 * alignment of multi-channel IIO buffer data */
@@ -1496,44 +1573,106 @@ static int32_t iio_ad4080_submit_samples(struct iio_device_data *iio_dev_data)
 		buf_size_updated = true;
 	}
 
-	/* If FIFO watermark not set previously, set the watermark as the
-	 * requested number of samples */
-	if (ad4080_dev_inst->fifo_mode == AD4080_FIFO_DISABLE) {
-		watermark = remaining_samples;
-		update_fifo_watermark = true;
+	/* Batches are sized by the FIFO watermark when a FIFO mode is configured,
+	 * otherwise the FIFO is used in immediate trigger mode at its full depth */
+	fifo_mode = ad4080_dev_inst->fifo_mode;
+	if (fifo_mode == AD4080_FIFO_DISABLE) {
+		fifo_mode = AD4080_IMMEDIATE_TRIGGER;
+		max_batch_samples = FIFO_SIZE;
+	} else {
+		max_batch_samples = watermark;
 	}
 
-	/* Start FIFO mode capture */
-	ret = ad4080_iio_start_fifo_mode_capture(remaining_samples,
-			update_fifo_watermark);
+	/* Enable GPIO3 and set it to track FIFO_FULL */
+	ret = ad4080_fifo_full_gpio_config();
 	if (ret) {
-		goto end_capture;
+		return ret;
 	}
 
-	/* Read FIFO data */
-	ret = ad4080_read_fifo_data(ad4080_dev_inst, fifo_data, remaining_samples);
-	if (ret) {
-		goto end_capture;
+	while (remaining_samples) {
+		batch_samples = no_os_min(remaining_samples, max_batch_samples);
+
+		ret = no_os_cb_prepare_async_write(iio_dev_data->buffer->buf,
+						   batch_samples * BYTES_PER_SAMPLE,
+						   &buff_start,
+						   &buff_available_size);
+		if (ret) {
+			goto end_capture;
+		}
+
+		/* Limit the batch to the contiguous space left in the buffer */
+		batch_samples = buff_available_size / BYTES_PER_SAMPLE;
+		if (!batch_samples) {
+			ret = -ENOMEM;
+			goto end_capture;
+		}
+
+		if (batch_samples != fifo_watermark) {
+			ret = ad4080_set_fifo_watermark(ad4080_dev_inst, batch_samples);
+			if (ret) {
+				goto end_capture;
+			}
+			fifo_watermark = batch_samples;
+		}
+
+		/* Arm the FIFO for the batch and wait for it to fill up */
+		ret = ad4080_set_fifo_mode(ad4080_dev_inst, fifo_mode);
+		if (ret) {
+			goto end_capture;
+		}
+
+		ret = ad4080_wait_for_fifo_full();
+
+		/* Deassert all oscillators once the batch has been captured into FIFO */
+		ret |= ad4080_deassert_oscillators();
+		if (ret) {
+			goto end_capture;
+		}
+
+		ret = ad4080_fifo_drain(buff_start, batch_samples);
+		if (ret) {
+			goto end_capture;
+		}
+
+		ret = no_os_cb_end_async_write(iio_dev_data->buffer->buf);
+		if (ret) {
+			goto end_capture;
+		}
+
+		/* Disarm the FIFO, so that next batch starts with an empty FIFO */
+		ret = ad4080_set_fifo_mode(ad4080_dev_inst, AD4080_FIFO_DISABLE);
+		if (ret) {
+			goto end_capture;
+		}
+
+		/* Assert back the chosen oscillator for the next batch */
+		ret = ad4080_assert_oscillator();
+		if (ret) {
+			goto end_capture;
+		}
+
+		remaining_samples -= batch_samples;
 	}
 
 end_capture:
-	/* End FIFO mode capture and retain the previous ret value if any of
-	 * previous stages is failed */
-	ret |= ad4080_iio_end_fifo_mode_capture(actual_fifo_data, fifo_data,
-						remaining_samples);
+	/* Clear the High Threshold and Low Threshold detection bits and disable
+	 * the FIFO, retaining the previous ret value if any stage has failed */
+	ret |= ad4080_write(ad4080_dev_inst, AD4080_REG_DEVICE_STATUS,
+			    NO_OS_GENMASK(5, 4));
+	ret |= ad4080_set_fifo_mode(ad4080_dev_inst, AD4080_FIFO_DISABLE);
+
+	/* Make sure the chosen oscillator is running again if the capture failed
+	 * during the FIFO readout */
 	if (ret) {
-		return ret;
+		ad4080_assert_oscillator();
 	}
 
-	/* Write data into circular buffer if all stages are success */
-	ret = no_os_cb_write(iio_dev_data->buffer->buf,
-			     actual_fifo_data,
-			     (remaining_samples * BYTES_PER_SAMPLE));
-	if (ret) {
-		return ret;
+	/* Restore the watermark configured through the IIO attribute */
+	if (fifo_watermark != watermark) {
+		ret |= ad4080_set_fifo_watermark(ad4080_dev_inst, watermark);
 	}
 
-	return 0;
+	return ret;
 }
 
 /*!
@@ -30,6 +30,7 @@
 #include "no_os_error.h"
 #include "board_info.h"
 #include "iio_trigger.h"
+#include "burst_capture.h"
 #if (ACTIVE_IIO_CLIENT == IIO_CLIENT_LOCAL)
 #include "pl_gui_views.h"
 #include "pl_gui_events.h"
@@ -131,6 +132,9 @@ static int32_t ad4130_code_to_straight_binary(uint32_t code, uint8_t chn);
 /* Fifo depth limit (watermark count) for data capture */
 #define FIFO_SIZE		256		// Range: 1-256
 
+/* Number of samples staged before committing to the IIO buffer in burst mode */
+#define BURST_BLOCK_SAMPLES		256
+
 /* Timeout count to avoid stuck into potential infinite loop while checking
  * for new data into an acquisition buffer. The actual timeout factor is determined
  * through 'sampling_frequency' attribute of IIO app, but this period here makes sure
@@ -188,6 +192,20 @@ static struct iio_trigger_init iio_trigger_init_params = {
 };
 #endif
 
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+static int32_t ad4130_burst_read_sample(void *ctx, void *sample);
+
+/* Block-batched burst capture init parameters */
+static struct burst_capture_init_param burst_capture_init_params = {
+	.read_unit = ad4130_burst_read_sample,
+	.unit_size = BYTES_PER_SAMPLE,
+	.block_units = BURST_BLOCK_SAMPLES,
+};
+
+/* Block-batched burst capture descriptor */
+static struct burst_capture_desc *ad4130_burst_desc;
+#endif
+
 #if (ACTIVE_IIO_CLIENT == IIO_CLIENT_LOCAL)
 /* IIO local backend init parameters */
 static struct iio_local_backend local_backend_init_params = {
@@ -1160,6 +1178,18 @@ static int32_t read_fifo_data(struct iio_device_data *iio_dev_data,
 	return 0;
 }
 
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+/*!
+ * @brief	Read one ADC sample of the burst (burst capture read op)
+ * @param	ctx[in] - Unused context
+ * @param	sample[out] - Sample read
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t ad4130_burst_read_sample(void *ctx, void *sample)
+{
+	return ad413x_mon_conv_and_read_data(ad4130_dev_inst, (uint32_t *)sample);
+}
+
 /*!
  * @brief	Capture requested number of ADC samples in burst (one-shot) mode
  * @param	iio_dev_data[in] - IIO device data instance
@@ -1169,8 +1199,6 @@ static int32_t read_fifo_data(struct iio_device_data *iio_dev_data,
 static int32_t read_burst_data(struct iio_device_data *iio_dev_data,
 			       uint32_t nb_of_samples)
 {
-	uint32_t sample_index = 0;
-	uint32_t adc_raw;
 	int32_t ret;
 
 	ret = start_burst_mode_capture();
@@ -1178,18 +1206,11 @@ static int32_t read_burst_data(struct iio_device_data *iio_dev_data,
 		return ret;
 	}
 
-	while (sample_index < nb_of_samples) {
-		ret = ad413x_mon_conv_and_read_data(ad4130_dev_inst, &adc_raw);
-		if (ret) {
-			return ret;
-		}
-
-		ret = no_os_cb_write(iio_dev_data->buffer->buf, &adc_raw, BYTES_PER_SAMPLE);
-		if (ret) {
-			return ret;
-		}
-
-		sample_index++;
+	/* Samples are committed to the IIO buffer in blocks */
+	ret = burst_capture_read(ad4130_burst_desc, iio_dev_data->buffer->buf,
+				 nb_of_samples);
+	if (ret) {
+		return ret;
 	}
 
 	/* Stop any previous conversion */
@@ -1200,6 +1221,7 @@ static int32_t read_burst_data(struct iio_device_data *iio_dev_data,
 
 	return 0;
 }
+#endif
 
 /**
  * @brief	Read buffered data corresponding to AD4130 ADC IIO device
@@ -1570,6 +1592,16 @@ int32_t ad4130_data_capture_init(void)
 		}
 	}
 
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	/* Init the block-batched burst capture */
+	if (!ad4130_burst_desc) {
+		ret = burst_capture_init(&ad4130_burst_desc, &burst_capture_init_params);
+		if (ret) {
+			return ret;
+		}
+	}
+#endif
+
 	return 0;
 }
 
@@ -20,6 +20,7 @@
 #include "ad4130_support.h"
 #include "ad4130_user_config.h"
 #include "no_os_error.h"
+#include "sample_format.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -384,8 +385,6 @@ int32_t ad4130_read_fifo(struct ad413x_dev *dev, uint32_t *data,
 			 uint32_t adc_samples)
 {
 	int32_t ret;
-	uint32_t loop_cntr;
-	uint32_t buf_indx = 0;
 	uint32_t bytes;
 
 	if (!dev || !data) {
@@ -419,20 +418,8 @@ int32_t ad4130_read_fifo(struct ad413x_dev *dev, uint32_t *data,
 	}
 
 	/* Extract the data from buffer (data doesn't contain header/status info) */
-	for (loop_cntr = AD4130_FIFO_READ_CMD_BYTES; loop_cntr < bytes;
-	     loop_cntr += (ADC_RESOLUTION / BYTE_SIZE)) {
-#if (ADC_RESOLUTION == 24)
-		data[buf_indx++] = ((int32_t)fifo_buf[loop_cntr] << 16) |
-				   ((int32_t)fifo_buf[loop_cntr + 1] << 8) |
-				   (int32_t)fifo_buf[loop_cntr + 2];
-#else
-		/* For 16-bit resolution */
-		data[buf_indx++] = ((int32_t)fifo_buf[loop_cntr] << 8) |
-				   (int32_t)fifo_buf[loop_cntr + 1];
-#endif
-	}
-
-	return 0;
+	return sample_unpack_be(&fifo_buf[AD4130_FIFO_READ_CMD_BYTES], data,
+				adc_samples, ADC_RESOLUTION / BYTE_SIZE);
 }
 
 /*!
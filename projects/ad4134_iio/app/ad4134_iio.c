@@ -26,6 +26,8 @@
 #include "stm32_tdm_support.h"
 #endif
 #include "version.h"
+#include "sdram_ring.h"
+#include "burst_capture.h"
 
 /******************************************************************************/
 /************************** Functions Declarations ****************************/
@@ -46,6 +48,16 @@ static int get_sampling_frequency(void *device, char *buf, uint32_t len,
 				  const struct iio_ch_info *channel, intptr_t priv);
 static int set_sampling_frequency(void *device, char *buf, uint32_t len,
 				  const struct iio_ch_info *channel, intptr_t priv);
+static int get_ring_telemetry(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel, intptr_t priv);
+static int set_ring_telemetry(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel, intptr_t priv);
+#if (INTERFACE_MODE == TDM_MODE)
+static int get_tdm_dropped_slots(void *device, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel, intptr_t priv);
+static int set_tdm_dropped_slots(void *device, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel, intptr_t priv);
+#endif
 
 /******************************************************************************/
 /********************* Macros and Constants Definition ************************/
@@ -62,9 +74,20 @@ static int set_sampling_frequency(void *device, char *buf, uint32_t len,
 /* Number of IIO devices */
 #define NUM_OF_IIO_DEVICES	1
 
+/* Number of scans staged before committing to the IIO buffer in burst mode */
+#define BURST_BLOCK_SCANS	64
+
 /******************************************************************************/
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
+/* Streaming ring telemetry attribute IDs */
+enum ad7134_ring_attribute_id {
+	RING_LEVEL_ATTR_ID,
+	RING_HIGH_WATER_MARK_ATTR_ID,
+	RING_OVERRUNS_ATTR_ID,
+	RING_DROPPED_BYTES_ATTR_ID
+};
+
 /* IIOD channels attributes list */
 struct iio_attribute channel_input_attributes[] = {
 	{
@@ -93,6 +116,37 @@ static struct iio_attribute global_attributes[] = {
 		.show = get_sampling_frequency,
 		.store = set_sampling_frequency,
 	},
+	{
+		.name = "ring_level",
+		.show = get_ring_telemetry,
+		.store = set_ring_telemetry,
+		.priv = RING_LEVEL_ATTR_ID
+	},
+	{
+		.name = "ring_high_water_mark",
+		.show = get_ring_telemetry,
+		.store = set_ring_telemetry,
+		.priv = RING_HIGH_WATER_MARK_ATTR_ID
+	},
+	{
+		.name = "ring_overruns",
+		.show = get_ring_telemetry,
+		.store = set_ring_telemetry,
+		.priv = RING_OVERRUNS_ATTR_ID
+	},
+	{
+		.name = "ring_dropped_bytes",
+		.show = get_ring_telemetry,
+		.store = set_ring_telemetry,
+		.priv = RING_DROPPED_BYTES_ATTR_ID
+	},
+#if (INTERFACE_MODE == TDM_MODE)
+	{
+		.name = "tdm_dropped_slots",
+		.show = get_tdm_dropped_slots,
+		.store = set_tdm_dropped_slots
+	},
+#endif
 
 	END_ATTRIBUTES_ARRAY
 };
@@ -168,12 +222,10 @@ static float attr_scale_val[] = {
 /* Offset attribute value per channel */
 static int attr_offset_val[AD7134_NUM_CHANNELS] = { 0x0 };
 
-/* ADC data buffer size */
+/* ADC data buffer */
 #if defined(USE_SDRAM)
 #define adc_data_buffer				SDRAM_START_ADDRESS
-#define DATA_BUFFER_SIZE			SDRAM_SIZE_BYTES
 #else
-#define DATA_BUFFER_SIZE			(128000)
 static int8_t adc_data_buffer[DATA_BUFFER_SIZE];
 #endif
 
@@ -181,7 +233,27 @@ static int8_t adc_data_buffer[DATA_BUFFER_SIZE];
  * number of samples for the multi-channel IIO buffer data alignment */
 static bool buf_size_updated = false;
 
+/* Streaming ring over the data buffer for continuous data capture */
+static struct sdram_ring_desc *ad7134_sdram_ring;
+
+static int32_t ad7134_burst_read_scan(void *ctx, void *scan);
+
+/* Block-batched burst capture init parameters (bit banging interface) */
+static struct burst_capture_init_param burst_capture_init_params = {
+	.read_unit = ad7134_burst_read_scan,
+	.block_units = BURST_BLOCK_SCANS,
+};
+
+/* Block-batched burst capture descriptor (bit banging interface) */
+static struct burst_capture_desc *ad7134_burst_desc;
+
+/* Channels requested by the client for the burst capture */
+static uint32_t ad7134_burst_chn_mask;
+
 #if (INTERFACE_MODE == TDM_MODE)
+/* Sequence number of the next TDM slot to be accounted in the ring telemetry */
+static uint32_t ad7134_tdm_ring_seq;
+
 /* Global pointer to copy the private iio_device_data
  * structure from ad7134_trigger_handler() */
 struct iio_device_data *ad7134_iio_dev_data;
@@ -309,6 +381,102 @@ static int set_sampling_frequency(void *device,
 	return -EINVAL;
 }
 
+/*!
+ * @brief	Getter/Setter for the streaming ring telemetry attribute values
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	priv- Attribute ID
+ * @return	Number of characters read/written
+ * @Note	The telemetry covers the ongoing (or last) continuous data capture.
+ *			Level and high water mark are in bytes of the data buffer.
+ */
+static int get_ring_telemetry(void *device,
+			      char *buf,
+			      uint32_t len,
+			      const struct iio_ch_info *channel,
+			      intptr_t priv)
+{
+	struct sdram_ring_stats ring_stats;
+	uint32_t val;
+	int32_t ret;
+
+	ret = sdram_ring_get_stats(ad7134_sdram_ring, &ring_stats);
+	if (ret) {
+		return ret;
+	}
+
+	switch (priv) {
+	case RING_LEVEL_ATTR_ID:
+		val = ring_stats.level;
+		break;
+	case RING_HIGH_WATER_MARK_ATTR_ID:
+		val = ring_stats.high_water_mark;
+		break;
+	case RING_OVERRUNS_ATTR_ID:
+		val = ring_stats.overruns;
+		break;
+	case RING_DROPPED_BYTES_ATTR_ID:
+		val = ring_stats.dropped_bytes;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return sprintf(buf, "%lu", (unsigned long)val);
+}
+
+static int set_ring_telemetry(void *device,
+			      char *buf,
+			      uint32_t len,
+			      const struct iio_ch_info *channel,
+			      intptr_t priv)
+{
+	/* Telemetry is read-only */
+	return -EINVAL;
+}
+
+#if (INTERFACE_MODE == TDM_MODE)
+/*!
+ * @brief	Getter/Setter for the TDM dropped slots attribute value
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	priv- Attribute ID (optional)
+ * @return	Number of characters read/written
+ * @Note	Number of TDM slots dropped since the start of the ongoing (or
+ *			last) continuous data capture, due to the IIO buffer being full
+ */
+static int get_tdm_dropped_slots(void *device,
+				 char *buf,
+				 uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t priv)
+{
+	uint32_t dropped_slots;
+	int32_t ret;
+
+	ret = stm32_tdm_stream_get_dropped_slots(ad7134_tdm_stream, &dropped_slots);
+	if (ret) {
+		return ret;
+	}
+
+	return sprintf(buf, "%lu", (unsigned long)dropped_slots);
+}
+
+static int set_tdm_dropped_slots(void *device,
+				 char *buf,
+				 uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t priv)
+{
+	/* Telemetry is read-only */
+	return -EINVAL;
+}
+#endif
+
 
 /*!
  * @brief	Getter/Setter for the raw attribute value
@@ -401,6 +569,20 @@ static int32_t iio_ad7134_prepare_transfer(void* dev, uint32_t mask)
 {
 	int32_t ret;
 
+	buf_size_updated = false;
+
+	if (ad4134_get_data_capture_mode() == DATA_CAPTURE_MODE_BURST
+	    && ad4134_get_interface_mode() == INTERFACE_MODE_BIT_BANGING) {
+		/* One scan of the requested channels per ODR period */
+		ad7134_burst_chn_mask = mask;
+		burst_capture_init_params.unit_size = no_os_hweight32(mask) *
+						      BYTES_PER_SAMPLE;
+		ret = burst_capture_init(&ad7134_burst_desc, &burst_capture_init_params);
+		if (ret) {
+			return ret;
+		}
+	}
+
 	if (use_iio_trigger) {
 		/* Clear any pending interrupts on the ODR pin */
 		ret = no_os_irq_clear_pending(external_int_desc, IRQ_INT_ID);
@@ -423,9 +605,20 @@ static int32_t iio_ad7134_prepare_transfer(void* dev, uint32_t mask)
 			/* Wait for IIO trigger and to get assigned with dev data */
 			while (ad7134_iio_dev_data == NULL);
 
+			/* Stream through the whole data buffer. The TDM stream further
+			 * trims the size down to a multiple of its slot size */
+			ret = sdram_ring_start(ad7134_sdram_ring,
+					       ad7134_iio_dev_data->buffer->buf,
+					       DATA_BUFFER_SIZE,
+					       ad7134_iio_dev_data->buffer->bytes_per_scan);
+			if (ret) {
+				return ret;
+			}
+
 			/* Start TDM transfer */
-			ret = start_tdm_dma_to_cb_transfer(ad7134_tdm_desc, ad7134_iio_dev_data,
-							   TDM_DMA_READ_SIZE, BYTES_PER_SAMPLE, TDM_DMA_READ_SIZE);
+			ad7134_tdm_ring_seq = 0;
+			ret = stm32_tdm_stream_start(ad7134_tdm_stream,
+						     ad7134_iio_dev_data->buffer->buf, 0);
 			if (ret) {
 				return ret;
 			}
@@ -506,44 +699,76 @@ static int32_t ad7134_read_burst_data_tdm(struct iio_device_data *iio_dev_data)
 }
 #endif
 
+#if (INTERFACE_MODE == TDM_MODE)
 /**
- * @brief Read data in burst mode via Bit Banging Method
- * @param iio_dev_data[in] - IIO Device data instance
+ * @brief Account the TDM slot just published into the ring telemetry
+ * @return None
+ * @note To be called from the SAI DMA Rx callbacks, after the TDM stream
+ *       handling of the completed slot
+ */
+void ad7134_tdm_ring_account(void)
+{
+	/* Samples discarded at start of streaming are not part of the stream */
+	if (!ad7134_tdm_stream->active
+	    || (ad7134_tdm_stream->seq == ad7134_tdm_ring_seq)) {
+		return;
+	}
+
+	ad7134_tdm_ring_seq = ad7134_tdm_stream->seq;
+
+	if (ad7134_tdm_stream->dropping) {
+		sdram_ring_block_dropped(ad7134_sdram_ring, ad7134_tdm_stream->slot_size);
+	} else {
+		/* The slot is already in the ring, only the level is tracked */
+		sdram_ring_block_done(ad7134_sdram_ring, 0);
+	}
+}
+#endif
+
+/**
+ * @brief Read one scan of the burst via Bit Banging Method (burst capture
+ *		  read op)
+ * @param ctx[in] - Unused context
+ * @param scan[out] - Samples of the channels requested by client
  * @return 0 in case of success or negative value otherwise
  */
-static int32_t ad7134_read_burst_data_bit_bang(struct iio_device_data
-		*iio_dev_data)
+static int32_t ad7134_burst_read_scan(void *ctx, void *scan)
 {
-	int32_t ret;
-	uint32_t sample_index = 0;
 	uint16_t adc_data[AD7134_NUM_CHANNELS] = {0};
+	uint16_t *sample = scan;
 	uint8_t ch_id;
+	int32_t ret;
 
-	for (sample_index = 0; sample_index < iio_dev_data->buffer->samples;
-	     sample_index++) {
-		/* Read all channels using GPIO Bit Banging method for
-		 * detecting a level change in DCLK signal */
-		ret = ad7134_read_all_channels_bit_banging(adc_data, true);
-		if (ret) {
-			return ret;
-		}
+	/* Read all channels using GPIO Bit Banging method for
+	 * detecting a level change in DCLK signal */
+	ret = ad7134_read_all_channels_bit_banging(adc_data, true);
+	if (ret) {
+		return ret;
+	}
 
-		/* Write the ADC Data to circular buffer for channels requested by client */
-		for (ch_id = 0; ch_id < AD7134_NUM_CHANNELS; ch_id++) {
-			if (NO_OS_BIT(ch_id) & iio_dev_data->buffer->active_mask) {
-				ret = no_os_cb_write(iio_dev_data->buffer->buf,
-						     &adc_data[ch_id],
-						     BYTES_PER_SAMPLE);
-				if (ret) {
-					return ret;
-				}
-			}
+	/* Keep the ADC Data of the channels requested by client */
+	for (ch_id = 0; ch_id < AD7134_NUM_CHANNELS; ch_id++) {
+		if (NO_OS_BIT(ch_id) & ad7134_burst_chn_mask) {
+			*sample++ = adc_data[ch_id];
 		}
 	}
 
 	return 0;
 }
 
+/**
+ * @brief Read data in burst mode via Bit Banging Method
+ * @param iio_dev_data[in] - IIO Device data instance
+ * @return 0 in case of success or negative value otherwise
+ */
+static int32_t ad7134_read_burst_data_bit_bang(struct iio_device_data
+		*iio_dev_data)
+{
+	/* Scans are committed to the circular buffer in blocks */
+	return burst_capture_read(ad7134_burst_desc, iio_dev_data->buffer->buf,
+				  iio_dev_data->buffer->samples);
+}
+
 /**
  * @brief Read buffer data corresponding to AD7134 IIO device
  * @param iio_dev_data[in] - Pointer to IIO device data structure
@@ -577,6 +802,14 @@ static int32_t iio_ad7134_end_transfer(void *dev)
 {
 	int32_t ret;
 
+	if (ad7134_burst_desc) {
+		ret = burst_capture_remove(ad7134_burst_desc);
+		ad7134_burst_desc = NULL;
+		if (ret) {
+			return ret;
+		}
+	}
+
 	if (use_iio_trigger) {
 		/* Disable IIO triggers */
 		ret = iio_trig_disable(ad7134_hw_trig_desc);
@@ -600,7 +833,7 @@ static int32_t iio_ad7134_end_transfer(void *dev)
 			ad7134_iio_dev_data = NULL;
 
 			/* Stop TDM DMA data capture */
-			ret = no_os_tdm_stop(ad7134_tdm_desc);
+			ret = stm32_tdm_stream_stop(ad7134_tdm_stream);
 			if (ret) {
 				return ret;
 			}
@@ -645,18 +878,25 @@ int32_t ad7134_trigger_handler(struct iio_device_data *iio_dev_data)
 #endif
 	default:
 		if (!buf_size_updated) {
-			/* Update total buffer size according to bytes per scan for proper
-			 * alignment of multi-channel IIO buffer data */
-			iio_dev_data->buffer->buf->size = iio_dev_data->buffer->size;
+			/* Stream through the whole data buffer, with the total buffer size
+			 * aligned to bytes per scan for proper alignment of multi-channel
+			 * IIO buffer data */
+			ret = sdram_ring_start(ad7134_sdram_ring,
+					       iio_dev_data->buffer->buf,
+					       DATA_BUFFER_SIZE,
+					       iio_dev_data->buffer->bytes_per_scan);
+			if (ret) {
+				return ret;
+			}
 			buf_size_updated = true;
 		}
 
 		/* Write the ADC Data to circular buffer for channels requested by client */
 		for (ch_id = 0; ch_id < AD7134_NUM_CHANNELS; ch_id++) {
 			if (NO_OS_BIT(ch_id) & iio_dev_data->buffer->active_mask) {
-				ret = no_os_cb_write(iio_dev_data->buffer->buf,
-						     &adc_data_continuous_mode[ch_id],
-						     BYTES_PER_SAMPLE);
+				ret = sdram_ring_write(ad7134_sdram_ring,
+						       &adc_data_continuous_mode[ch_id],
+						       BYTES_PER_SAMPLE);
 				if (ret) {
 					return ret;
 				}
@@ -809,6 +1049,11 @@ int32_t iio_app_initialize(void)
 			return init_status;
 		}
 
+		init_status = sdram_ring_init(&ad7134_sdram_ring);
+		if (init_status) {
+			return init_status;
+		}
+
 		iio_device_init_params[0].name = ACTIVE_DEVICE_NAME;
 		iio_device_init_params[0].raw_buf = adc_data_buffer;
 		iio_device_init_params[0].raw_buf_len = DATA_BUFFER_SIZE;
@@ -829,6 +1074,10 @@ int32_t iio_app_initialize(void)
 	iio_init_params.devs = iio_device_init_params;
 	init_status = iio_init(&p_ad7134_iio_desc, &iio_init_params);
 	if (init_status) {
+		if (ad7134_sdram_ring) {
+			sdram_ring_remove(ad7134_sdram_ring);
+			ad7134_sdram_ring = NULL;
+		}
 		return init_status;
 	}
 
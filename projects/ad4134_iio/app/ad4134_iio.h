@@ -37,4 +37,7 @@ int32_t ad7134_iio_initialize(void);
 /* Run the IIO event handler */
 void ad7134_iio_event_handler(void);
 
+/* Account the completed TDM slot into the streaming ring telemetry */
+void ad7134_tdm_ring_account(void);
+
 #endif /* AD7134_IIO_H_ */
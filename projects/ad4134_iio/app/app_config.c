@@ -24,6 +24,9 @@
 #include "no_os_gpio.h"
 #include "no_os_pwm.h"
 #include "no_os_tdm.h"
+#if (INTERFACE_MODE == TDM_MODE)
+#include "stm32_tdm_support.h"
+#endif
 
 /******************************************************************************/
 /************************ Macros/Constants ************************************/
@@ -181,6 +184,16 @@ struct no_os_tdm_init_param tdm_init_param = {
 
 /* TDM Descriptor */
 struct no_os_tdm_desc *ad7134_tdm_desc;
+
+/* TDM stream init parameters */
+static struct stm32_tdm_stream_init_param tdm_stream_init_param = {
+	.slot_samples = TDM_DMA_READ_SIZE,
+	.bytes_per_sample = BYTES_PER_SAMPLE,
+	.max_buffer_size = DATA_BUFFER_SIZE
+};
+
+/* TDM stream descriptor */
+struct stm32_tdm_stream_desc *ad7134_tdm_stream;
 #endif // INTERFACE_MODE
 
 /* Define the GPIO init parameter structure for PDN Pin */
@@ -368,7 +381,9 @@ static int32_t init_tdm(void)
 		return -EINVAL;
 	}
 
-	return 0;
+	tdm_stream_init_param.tdm_desc = ad7134_tdm_desc;
+
+	return stm32_tdm_stream_init(&ad7134_tdm_stream, &tdm_stream_init_param);
 }
 #endif // INTERFACE_MODE
 
@@ -169,6 +169,13 @@ INFO_MSG(message("No / Unsupported ADxxxxy symbol defined.AD4134 defined"))
 /* Enable/Disable the use of SDRAM for ADC data capture buffer */
 // #define USE_SDRAM		// Uncomment to use SDRAM for data buffer
 
+/* ADC data buffer size */
+#if defined(USE_SDRAM)
+#define DATA_BUFFER_SIZE			SDRAM_SIZE_BYTES
+#else
+#define DATA_BUFFER_SIZE			(128000)
+#endif
+
 /* Check if any serial port available for use as console stdio port */
 #if defined(USE_PHY_COM_PORT)
 /* If PHY com is selected, VCOM or alternate PHY com port can act as a console stdio port */
@@ -187,6 +194,9 @@ extern struct no_os_uart_desc *uart_iio_com_desc;
 extern struct no_os_uart_desc *uart_console_stdio_desc;
 extern struct no_os_irq_ctrl_desc *external_int_desc;
 extern struct no_os_tdm_desc *ad7134_tdm_desc;
+#if (INTERFACE_MODE == TDM_MODE)
+extern struct stm32_tdm_stream_desc *ad7134_tdm_stream;
+#endif
 extern struct no_os_eeprom_desc *eeprom_desc;
 extern struct no_os_gpio_init_param pdn_init_param;
 extern struct no_os_pwm_desc *pwm_desc;
@@ -19,6 +19,7 @@
 #include "app_config_stm32.h"
 #include "stm32_tdm_support.h"
 #include "ad4134_support.h"
+#include "ad4134_iio.h"
 
 /******************************************************************************/
 /********************* Macros and Constants Definition ************************/
@@ -169,8 +170,8 @@ void ad7134_dma_rx_half_cplt(void *hsai)
 {
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 	if (data_capture_operation) {
-		end_tdm_dma_to_cb_transfer(ad7134_tdm_desc, ad7134_iio_dev_data,
-					   TDM_DMA_READ_SIZE, BYTES_PER_SAMPLE);
+		stm32_tdm_stream_half_cplt(ad7134_tdm_stream);
+		ad7134_tdm_ring_account();
 	}
 #endif
 }
@@ -186,12 +187,9 @@ void ad7134_dma_rx_cplt(void *hsai)
 
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 	if (data_capture_operation) {
-		end_tdm_dma_to_cb_transfer(ad7134_tdm_desc, ad7134_iio_dev_data,
-					   TDM_DMA_READ_SIZE, BYTES_PER_SAMPLE);
-
-		/* Start TDM DMA read as the peripheral is disabled in Normal(Linear)
-		 * Buffer Mode upon buffer completion */
-		no_os_tdm_read(ad7134_tdm_desc, dma_buff, TDM_DMA_READ_SIZE << 1);
+		/* Publish the completed slot */
+		stm32_tdm_stream_cplt(ad7134_tdm_stream);
+		ad7134_tdm_ring_account();
 	}
 #endif
 }
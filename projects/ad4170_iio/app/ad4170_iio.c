@@ -38,6 +38,18 @@
 #include "stm32_tdm_support.h"
 #endif
 
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+#include "stm32_cycle_counter.h"
+#endif
+
+#if (INTERFACE_MODE == SPI_INTERRUPT_MODE) && (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+#include "burst_capture.h"
+#endif
+
+#if defined(STREAMING_FFT_ANALYSIS)
+#include "welch_fft.h"
+#endif
+
 #if (ACTIVE_IIO_CLIENT == IIO_CLIENT_LOCAL)
 #include "pl_gui_views.h"
 #include "pl_gui_events.h"
@@ -92,22 +104,11 @@ static int ad4170_determine_fs_actual(uint32_t fs, uint32_t *fs_actual,
  * is tested for SDP-K1 platform @180Mhz default core clock */
 #define BUF_READ_TIMEOUT	0xffffffff
 
-/* ADC data buffer size */
+/* ADC data buffer */
 #if defined(USE_SDRAM)
 /* SDRAM configs for SDP-K1 */
 #define adc_data_buffer				SDRAM_START_ADDRESS
-#define DATA_BUFFER_SIZE			SDRAM_SIZE_BYTES
-#else
-#if (ACTIVE_IIO_CLIENT == IIO_CLIENT_LOCAL)
-/* Note: Setting lower size due to memory constraints on MCU */
-#define DATA_BUFFER_SIZE			(16384)
 #else
-#if (INTERFACE_MODE == TDM_MODE)
-#define DATA_BUFFER_SIZE			(128000)
-#else
-#define DATA_BUFFER_SIZE			(131072)
-#endif
-#endif	// ACTIVE_IIO_CLIENT
 static int8_t adc_data_buffer[DATA_BUFFER_SIZE] = { 0 };
 #endif
 
@@ -117,8 +118,13 @@ static int8_t adc_data_buffer[DATA_BUFFER_SIZE] = { 0 };
 static char app_local_backend_buff[APP_LOCAL_BACKEND_BUF_SIZE];
 #endif
 
-/* Max number of cached registers */
-#define N_REGISTERS_CACHED ADC_REGISTER_COUNT
+/* Number of samples staged before committing to the IIO buffer in burst mode */
+#define BURST_BLOCK_SAMPLES		256
+
+#if defined(STREAMING_FFT_ANALYSIS)
+/* FFT length of the streaming spectrum analysis */
+#define STREAMING_FFT_LEN		2048
+#endif
 
 /* Limits for Filter FS values */
 #define AD4190_SINC5_FS_LOW			4
@@ -243,9 +249,6 @@ static bool adc_data_capture_started = false;
 /* Diagnostic error status */
 static uint16_t diag_err_status = 0;
 
-/* To store the ADC register values during power-down */
-static uint32_t adc_reg_data[ADC_REGISTER_COUNT];
-
 /* Attribute IDs */
 enum ad4170_attr_id {
 	IIO_RAW_ATTR_ID,
@@ -344,6 +347,57 @@ volatile bool tdm_read_started = false;
 /* Number of samples to be ignored initially during TDM-DMA read */
 static uint32_t num_samples_ignore = 0;
 
+/* Pointer to the ADC data buffer for TDM-DMA burst read */
+uint8_t *ad4170_dma_buff;
+
+#if (INTERFACE_MODE == SPI_INTERRUPT_MODE) && (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+static int32_t ad4170_burst_read_sample(void *ctx, void *sample);
+#if defined(STREAMING_FFT_ANALYSIS)
+static uint32_t ad4170_analyze_block(void *ctx, void *block, uint32_t samples);
+#endif
+
+/* Block-batched burst capture init parameters */
+static struct burst_capture_init_param burst_capture_init_params = {
+	.read_unit = ad4170_burst_read_sample,
+	.unit_size = BYTES_PER_SAMPLE,
+	.block_units = BURST_BLOCK_SAMPLES,
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+	.get_ticks = stm32_cycle_counter_get,
+#endif
+#if defined(STREAMING_FFT_ANALYSIS)
+	.process_block = ad4170_analyze_block
+#endif
+};
+
+/* Block-batched burst capture descriptor */
+static struct burst_capture_desc *ad4170_burst_desc;
+#endif
+
+#if defined(STREAMING_FFT_ANALYSIS)
+/* Streaming FFT init parameters */
+static struct welch_fft_init_param welch_fft_init_params = {
+	.fft_len = STREAMING_FFT_LEN,
+	.full_scale = ADC_MAX_COUNT_BIPOLAR
+};
+
+/* Streaming FFT descriptor */
+static struct welch_fft_desc *ad4170_fft_desc;
+
+/* Position of the next burst sample within the channel scan */
+static uint8_t fft_scan_pos;
+
+/* Streaming FFT attribute IDs */
+enum streaming_fft_attr_id {
+	FFT_SNR_ATTR_ID,
+	FFT_SINAD_ATTR_ID,
+	FFT_THD_ATTR_ID,
+	FFT_ENOB_ATTR_ID,
+	FFT_FUND_FREQ_ATTR_ID,
+	FFT_FUND_DBFS_ATTR_ID,
+	FFT_AVERAGES_ATTR_ID
+};
+#endif
+
 /* Flag to indicate if data read request is for raw read Operation
  * or data capture operation */
 bool data_capture_operation = false;
@@ -415,6 +469,11 @@ uint8_t local_buf[MAX_LOCAL_BUF_SIZE + (BYTES_PER_SAMPLE *
 
 /* Maximum value the DMA NDTR register can take */
 #define MAX_DMA_NDTR		(no_os_min(65535, MAX_LOCAL_BUF_SIZE))
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/* Size of each ping-pong DMA block (in bytes) */
+static uint32_t spi_dma_block_size;
+#endif
 #endif
 
 /* Serial interface reset command */
@@ -427,21 +486,6 @@ static const uint8_t ad4170_serial_intf_reset[24] = {
 	0xFF, 0xFF, 0xFF, 0xFE
 };
 
-/**
- * @struct ad4170_cached_reg
- * @brief Cached register
- */
-struct ad4170_cached_reg {
-	uint32_t addr;
-	uint32_t value
-};
-
-/* Cached registers */
-struct ad4170_cached_reg reg_values[N_REGISTERS_CACHED];
-
-/* Register index */
-uint8_t read_reg_id = 0;
-
 /* Permissible HW Mezzanine names */
 static const char *mezzanine_names[] = {
 	"EVAL-AD4170-4ARDZ",
@@ -494,6 +538,27 @@ static const char *restart_iio_options[] = {
 	"Enable",
 };
 
+/* System reconfiguration types */
+enum ad4170_reconfig_type {
+	AD4170_RECONFIG_NONE,
+	AD4170_RECONFIG_INCREMENTAL,
+	AD4170_RECONFIG_FULL
+};
+
+static const char *ad4170_reconfig_types[] = {
+	"none",
+	"incremental",
+	"full"
+};
+
+/* Type and duration (in usec) of the last system reconfiguration */
+static enum ad4170_reconfig_type last_reconfig_type = AD4170_RECONFIG_NONE;
+static uint32_t last_reconfig_latency_us;
+
+/* Duration (in usec) of the last device and IIO interface initialization,
+ * which is what a full restart re-runs */
+static uint32_t last_init_latency_us;
+
 /******************************************************************************/
 /************************ Functions Prototypes ********************************/
 /******************************************************************************/
@@ -703,18 +768,17 @@ static int get_adc_raw(void *device,
 
 	switch (id) {
 	case IIO_RAW_ATTR_ID:
-		/* Apply calibrated coefficients before new sampling */
+		/* Apply calibrated coefficients before new sampling (written only
+		 * when they differ from the setup coefficients) */
 		if (adc_calibration_status[channel->ch_num] == CALIB_DONE) {
-			ret = ad4170_spi_reg_write(p_ad4170_dev_inst,
-						   AD4170_REG_ADC_SETUPS_OFFSET(setup),
-						   adc_calibration_config[channel->ch_num].offset_after_calib);
+			ret = ad4170_shadow_reg_write(AD4170_REG_ADC_SETUPS_OFFSET(setup),
+						      adc_calibration_config[channel->ch_num].offset_after_calib);
 			if (ret) {
 				break;
 			}
 
-			ret = ad4170_spi_reg_write(p_ad4170_dev_inst,
-						   AD4170_REG_ADC_SETUPS_GAIN(setup),
-						   adc_calibration_config[channel->ch_num].gain_after_calib);
+			ret = ad4170_shadow_reg_write(AD4170_REG_ADC_SETUPS_GAIN(setup),
+						      adc_calibration_config[channel->ch_num].gain_after_calib);
 			if (ret) {
 				break;
 			}
@@ -816,6 +880,300 @@ static int set_diag_error(void *device,
 	return len;
 }
 
+#if (INTERFACE_MODE == SPI_DMA_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/*!
+ * @brief	Getter/Setter for the DMA overrun count attribute value
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	id- Attribute ID (optional)
+ * @return	Number of characters read/written
+ * @note	The count is in DMA blocks dropped while the IIO buffer was full,
+ *          the data handed to the host is never overwritten. Any write to
+ *          the attribute clears the overrun count.
+ */
+static int get_dma_overrun_count(void *device,
+				 char *buf,
+				 uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t id)
+{
+	return sprintf(buf, "%lu", (unsigned long)dma_overrun_count);
+}
+
+static int set_dma_overrun_count(void *device,
+				 char *buf,
+				 uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t id)
+{
+	dma_overrun_count = 0;
+
+	return len;
+}
+#endif
+
+#if (INTERFACE_MODE == TDM_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/*!
+ * @brief	Getter/Setter for the TDM dropped slots attribute value
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	id- Attribute ID (optional)
+ * @return	Number of characters read/written
+ * @note	Number of TDM slots dropped since the start of the ongoing (or
+ *			last) data capture, due to the IIO buffer being full
+ */
+static int get_tdm_dropped_slots(void *device,
+				 char *buf,
+				 uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t id)
+{
+	uint32_t dropped_slots;
+	int32_t ret;
+
+	ret = stm32_tdm_stream_get_dropped_slots(ad4170_tdm_stream, &dropped_slots);
+	if (ret) {
+		return ret;
+	}
+
+	return sprintf(buf, "%lu", (unsigned long)dropped_slots);
+}
+
+static int set_tdm_dropped_slots(void *device,
+				 char *buf,
+				 uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t id)
+{
+	/* NA- Can't set dropped slots count */
+	return -EINVAL;
+}
+#endif
+
+/*!
+ * @brief	Getter/Setter for the last system reconfiguration latency
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	id- Attribute ID (optional)
+ * @return	Number of characters read/written
+ * @note	The latency (in usec) covers the whole reconfiguration, from the
+ *			restart request to the IIO interface being ready again.
+ */
+static int get_reconfigure_latency(void *device,
+				   char *buf,
+				   uint32_t len,
+				   const struct iio_ch_info *channel,
+				   intptr_t id)
+{
+	return sprintf(buf, "%lu", (unsigned long)last_reconfig_latency_us);
+}
+
+static int set_reconfigure_latency(void *device,
+				   char *buf,
+				   uint32_t len,
+				   const struct iio_ch_info *channel,
+				   intptr_t id)
+{
+	/* NA - Measured by the firmware */
+	return -EINVAL;
+}
+
+/*!
+ * @brief	Getter/Setter for the last system reconfiguration type
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	id- Attribute ID (optional)
+ * @return	Number of characters read/written
+ */
+static int get_reconfigure_type(void *device,
+				char *buf,
+				uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t id)
+{
+	return sprintf(buf, "%s", ad4170_reconfig_types[last_reconfig_type]);
+}
+
+static int set_reconfigure_type(void *device,
+				char *buf,
+				uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t id)
+{
+	/* NA - Selected by the firmware from the staged changes */
+	return -EINVAL;
+}
+
+/*!
+ * @brief	Getter/Setter for the last initialization latency
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	id- Attribute ID (optional)
+ * @return	Number of characters read/written
+ * @note	The latency (in usec) covers the device, register shadow and IIO
+ *			interface initialization run at power-up and by a full restart,
+ *			the reference for the incremental reconfiguration latency.
+ */
+static int get_init_latency(void *device,
+			    char *buf,
+			    uint32_t len,
+			    const struct iio_ch_info *channel,
+			    intptr_t id)
+{
+	return sprintf(buf, "%lu", (unsigned long)last_init_latency_us);
+}
+
+static int set_init_latency(void *device,
+			    char *buf,
+			    uint32_t len,
+			    const struct iio_ch_info *channel,
+			    intptr_t id)
+{
+	/* NA - Measured by the firmware */
+	return -EINVAL;
+}
+
+/*!
+ * @brief	Getter/Setter for the register shadow SPI savings attribute value
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	id- Attribute ID (optional)
+ * @return	Number of characters read/written
+ * @note	Reports the SPI transactions saved by the last register restore
+ *			(data capture end or power-down exit) over per register accesses.
+ *			Any write to the attribute clears the count.
+ */
+static int get_reg_shadow_spi_saved(void *device,
+				    char *buf,
+				    uint32_t len,
+				    const struct iio_ch_info *channel,
+				    intptr_t id)
+{
+	return sprintf(buf, "%lu", (unsigned long)ad4170_shadow_get_spi_saved());
+}
+
+static int set_reg_shadow_spi_saved(void *device,
+				    char *buf,
+				    uint32_t len,
+				    const struct iio_ch_info *channel,
+				    intptr_t id)
+{
+	ad4170_shadow_clear_spi_saved();
+
+	return len;
+}
+
+#if (INTERFACE_MODE == SPI_INTERRUPT_MODE) && (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+/*!
+ * @brief	Getter/Setter for the sampling frequency achieved in last burst
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	id- Attribute ID (optional)
+ * @return	Number of characters read/written
+ * @note	Compare against the 'sampling_frequency' attribute to determine the
+ *			efficiency of the burst data read
+ */
+static int get_achieved_sampling_frequency(void *device,
+		char *buf,
+		uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t id)
+{
+	return sprintf(buf, "%lu",
+		       (unsigned long)burst_capture_get_rate(ad4170_burst_desc));
+}
+
+static int set_achieved_sampling_frequency(void *device,
+		char *buf,
+		uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t id)
+{
+	/* NA - Measured by the firmware */
+	return -EINVAL;
+}
+#endif
+
+#if defined(STREAMING_FFT_ANALYSIS)
+/*!
+ * @brief	Getter/Setter for the streaming FFT analysis results
+ * @param	device- pointer to IIO device structure
+ * @param	buf- pointer to buffer holding attribute value
+ * @param	len- length of buffer string data
+ * @param	channel- pointer to IIO channel structure
+ * @param	id- Attribute ID
+ * @return	Number of characters read/written
+ * @note	The spectrum of the first active channel is averaged over all the
+ *			bursts captured since the buffer was enabled
+ */
+static int get_streaming_fft(void *device,
+			     char *buf,
+			     uint32_t len,
+			     const struct iio_ch_info *channel,
+			     intptr_t id)
+{
+	struct welch_fft_metrics metrics;
+	int32_t ret;
+
+	if (id == FFT_AVERAGES_ATTR_ID) {
+		return sprintf(buf, "%lu", ad4170_fft_desc->averages);
+	}
+
+	ret = welch_fft_get_metrics(ad4170_fft_desc, &metrics);
+	if (ret) {
+		return ret;
+	}
+
+	switch (id) {
+	case FFT_SNR_ATTR_ID:
+		return sprintf(buf, "%.2f", metrics.snr);
+
+	case FFT_SINAD_ATTR_ID:
+		return sprintf(buf, "%.2f", metrics.sinad);
+
+	case FFT_THD_ATTR_ID:
+		return sprintf(buf, "%.2f", metrics.thd);
+
+	case FFT_ENOB_ATTR_ID:
+		return sprintf(buf, "%.2f", metrics.enob);
+
+	case FFT_FUND_FREQ_ATTR_ID:
+		return sprintf(buf, "%.2f", metrics.fund_freq);
+
+	case FFT_FUND_DBFS_ATTR_ID:
+		return sprintf(buf, "%.2f", metrics.fund_dbfs);
+
+	default:
+		break;
+	}
+
+	return -EINVAL;
+}
+
+static int set_streaming_fft(void *device,
+			     char *buf,
+			     uint32_t len,
+			     const struct iio_ch_info *channel,
+			     intptr_t id)
+{
+	/* NA- Can't set the FFT analysis results */
+	return -EINVAL;
+}
+#endif
 
 /*!
  * @brief	Getter/Setter for the ADC mode available values
@@ -988,7 +1346,6 @@ static int set_adc_mode(void *device,
 			intptr_t id)
 {
 	bool found = false;
-	uint32_t reg;
 	uint8_t new_adc_mode_indx;
 	uint8_t current_adc_mode;
 	struct ad4170_adc_ctrl adc_ctrl = p_ad4170_dev_inst->config.adc_ctrl;
@@ -1021,20 +1378,14 @@ static int set_adc_mode(void *device,
 			no_os_mdelay(1000);
 
 			/* Restore all the registers upon exit from power-down mode */
-			for (reg = 0; reg < ADC_REGISTER_COUNT; reg++) {
-				if (ad4170_spi_reg_write(device, ad4170_regs[reg],
-							 adc_reg_data[reg])) {
-					return -EINVAL;
-				}
+			if (ad4170_shadow_restore(true)) {
+				return -EINVAL;
 			}
 		} else if ((new_adc_mode_indx == AD4170_MODE_POWER_DOWN)
 			   && (current_adc_mode != AD4170_MODE_POWER_DOWN)) {
 			/* Store all ADC registers before entering into power down mode */
-			for (reg = 0; reg < ADC_REGISTER_COUNT; reg++) {
-				if (ad4170_spi_reg_read(device, ad4170_regs[reg],
-							&adc_reg_data[reg])) {
-					return -EINVAL;
-				}
+			if (ad4170_shadow_save(true)) {
+				return -EINVAL;
 			}
 
 			/* Place ADC into standby mode first before entering into power-down mode */
@@ -1161,10 +1512,9 @@ static int set_pga(void *device,
 	ad4170_init_params.config.setups[ad4170_init_params.config.setup[channel->ch_num].setup_n].afe.pga_gain
 		= pga_id;
 
-	/* Read the AFE register */
-	ret = ad4170_spi_reg_read(p_ad4170_dev_inst,
-				  AD4170_REG_ADC_SETUPS_AFE(
-					  ad4170_init_params.config.setup[channel->ch_num].setup_n), &reg_val);
+	/* Read the AFE register (cached) */
+	ret = ad4170_shadow_reg_read(AD4170_REG_ADC_SETUPS_AFE(
+					     ad4170_init_params.config.setup[channel->ch_num].setup_n), &reg_val);
 	if (ret) {
 		return ret;
 	}
@@ -1172,9 +1522,8 @@ static int set_pga(void *device,
 	/* Update the value of PGA Gain */
 	reg_val |= no_os_field_prep(AD4170_ADC_SETUPS_AFE_PGA_GAIN_MSK, pga_id);
 
-	ret = ad4170_spi_reg_write(p_ad4170_dev_inst,
-				   AD4170_REG_ADC_SETUPS_AFE(
-					   ad4170_init_params.config.setup[channel->ch_num].setup_n), reg_val);
+	ret = ad4170_shadow_reg_write(AD4170_REG_ADC_SETUPS_AFE(
+					      ad4170_init_params.config.setup[channel->ch_num].setup_n), reg_val);
 	if (ret) {
 		return ret;
 	}
@@ -1522,17 +1871,13 @@ int32_t perform_adc_calibration(uint8_t chn,
 	/* Read the gain/offset coefficient value (pre calibrated) */
 	if ((calib_mode == AD4170_MODE_SELF_GAIN_CAL)
 	    || (calib_mode == AD4170_MODE_SYS_GAIN_CAL)) {
-		status = ad4170_spi_reg_read(p_ad4170_dev_inst,
-					     AD4170_REG_ADC_SETUPS_GAIN(setup),
-					     &data);
+		status = ad4170_shadow_reg_read(AD4170_REG_ADC_SETUPS_GAIN(setup), &data);
 		if (status) {
 			return status;
 		}
 		adc_calibration_config[chn].gain_before_calib = data;
 	} else {
-		status = ad4170_spi_reg_read(p_ad4170_dev_inst,
-					     AD4170_REG_ADC_SETUPS_OFFSET(setup),
-					     &data);
+		status = ad4170_shadow_reg_read(AD4170_REG_ADC_SETUPS_OFFSET(setup), &data);
 		if (status) {
 			return status;
 		}
@@ -1573,9 +1918,10 @@ int32_t perform_adc_calibration(uint8_t chn,
 		/* Wait for conversion to finish */
 		no_os_mdelay(100);
 
-		/* Read the gain coefficient value (post calibrated) */
-		status = ad4170_spi_reg_read(p_ad4170_dev_inst,
-					     AD4170_REG_ADC_SETUPS_GAIN(setup), &data);
+		/* Read the gain coefficient value (post calibrated, updated by
+		 * the device) */
+		ad4170_shadow_invalidate(AD4170_REG_ADC_SETUPS_GAIN(setup));
+		status = ad4170_shadow_reg_read(AD4170_REG_ADC_SETUPS_GAIN(setup), &data);
 		if (status) {
 			return status;
 		}
@@ -1600,9 +1946,10 @@ int32_t perform_adc_calibration(uint8_t chn,
 		/* Wait for conversion to finish */
 		no_os_mdelay(100);
 
-		/* Read the coefficient value (post calibrated) */
-		status = ad4170_spi_reg_read(p_ad4170_dev_inst,
-					     AD4170_REG_ADC_SETUPS_OFFSET(setup), &data);
+		/* Read the coefficient value (post calibrated, updated by the
+		 * device) */
+		ad4170_shadow_invalidate(AD4170_REG_ADC_SETUPS_OFFSET(setup));
+		status = ad4170_shadow_reg_read(AD4170_REG_ADC_SETUPS_OFFSET(setup), &data);
 		if (status) {
 			return status;
 		}
@@ -1978,6 +2325,9 @@ int32_t debug_reg_write(void *dev, uint32_t reg, uint32_t writeval)
 		return ret;
 	}
 
+	/* The register shadow fetches the new value on its next access */
+	ad4170_shadow_invalidate(reg_base_add);
+
 	return 0;
 }
 
@@ -2174,7 +2524,11 @@ static int32_t ad4170_stop_data_capture(void)
 	adc_ctrl.mode = AD4170_MODE_STANDBY;
 
 #if (INTERFACE_MODE == TDM_MODE)
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	ret = stm32_tdm_stream_stop(ad4170_tdm_stream);
+#else
 	ret = no_os_tdm_stop(ad4170_tdm_desc);
+#endif
 	if (ret) {
 		return ret;
 	}
@@ -2218,7 +2572,7 @@ static int32_t ad4170_stop_data_capture(void)
 	}
 
 	/* Restore cached reg values */
-	ret = ad4170_restore_cache();
+	ret = ad4170_shadow_restore(false);
 	if (ret) {
 		return ret;
 	}
@@ -2267,13 +2621,13 @@ static int32_t ad4170_read_burst_data_tdm(uint32_t nb_of_bytes,
 		/* Retrieve the address of data buffer from where DMA data write needs to start */
 		ret = no_os_cb_prepare_async_write(iio_dev_data->buffer->buf,
 						   nb_of_bytes,
-						   &dma_buff, &ad4170_buff_available_size);
+						   (void **)&ad4170_dma_buff, &ad4170_buff_available_size);
 		if (ret) {
 			return ret;
 		}
 
 		/* Trigger TDM-DMA read to capture data into buffer in the background */
-		ret = no_os_tdm_read(ad4170_tdm_desc, dma_buff, num_samples_ignore);
+		ret = no_os_tdm_read(ad4170_tdm_desc, ad4170_dma_buff, num_samples_ignore);
 		if (ret) {
 			return ret;
 		}
@@ -2312,6 +2666,52 @@ static int32_t ad4170_read_burst_data_tdm(uint32_t nb_of_bytes,
 	return 0;
 }
 
+#if (INTERFACE_MODE == SPI_INTERRUPT_MODE) && (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+/**
+ * @brief Read single ADC sample for the block-batched burst capture
+ * @param ctx[in] - Burst capture context (unused)
+ * @param sample[out] - ADC sample
+ * @return 0 in case of success or negative value otherwise
+ */
+static int32_t ad4170_burst_read_sample(void *ctx, void *sample)
+{
+	/* This function monitors RDY line to read ADC result */
+	return ad4170_read24(p_ad4170_dev_inst, sample, 1);
+}
+
+#if defined(STREAMING_FFT_ANALYSIS)
+/**
+ * @brief Add the samples of the first active channel to the streaming FFT
+ * @param ctx[in] - Block processing context (unused)
+ * @param block[in] - Block of ADC samples (in channel scan order)
+ * @param samples[in] - Number of samples in the block
+ * @return Number of samples to commit (the block is left untouched)
+ * @note Each frame is processed as soon as the block completing it arrives,
+ *		 while the next frame keeps filling
+ */
+static uint32_t ad4170_analyze_block(void *ctx, void *block, uint32_t samples)
+{
+	uint32_t *data = block;
+	uint32_t indx;
+	int32_t code;
+
+	for (indx = 0; indx < samples; indx++) {
+		if (!fft_scan_pos) {
+			code = perform_sign_conversion(data[indx], active_channels[0]);
+			welch_fft_push(ad4170_fft_desc, &code, 1, 1);
+		}
+
+		if (++fft_scan_pos >= num_of_active_channels) {
+			fft_scan_pos = 0;
+		}
+	}
+
+	welch_fft_process(ad4170_fft_desc);
+
+	return samples;
+}
+#endif
+
 /**
  * @brief Read data in burst mode via SPI
  * @param nb_of_samples[in] - Number of samples requested by IIO
@@ -2321,28 +2721,24 @@ static int32_t ad4170_read_burst_data_tdm(uint32_t nb_of_bytes,
 static int32_t ad4170_read_burst_data_spi(uint32_t nb_of_samples,
 		struct iio_device_data *iio_dev_data)
 {
-	uint32_t sample_index = 0;
-	uint32_t adc_raw;
 	int32_t ret;
 
+#if defined(STREAMING_FFT_ANALYSIS)
+	/* The bursts are not contiguous, so no frame spans two bursts */
+	welch_fft_restart_frame(ad4170_fft_desc);
+	fft_scan_pos = 0;
+#endif
+
 	ret = ad4170_start_data_capture();
 	if (ret) {
 		return ret;
 	}
 
-	while (sample_index < nb_of_samples) {
-		/* This function monitors RDY line to read ADC result */
-		ret = ad4170_read24(p_ad4170_dev_inst, &adc_raw, 1);
-		if (ret) {
-			return ret;
-		}
-
-		ret = no_os_cb_write(iio_dev_data->buffer->buf, &adc_raw, BYTES_PER_SAMPLE);
-		if (ret) {
-			return ret;
-		}
-
-		sample_index++;
+	/* Samples are committed to the IIO buffer in blocks */
+	ret = burst_capture_read(ad4170_burst_desc, iio_dev_data->buffer->buf,
+				 nb_of_samples);
+	if (ret) {
+		return ret;
 	}
 
 	ret = ad4170_stop_data_capture();
@@ -2352,6 +2748,7 @@ static int32_t ad4170_read_burst_data_spi(uint32_t nb_of_samples,
 
 	return 0;
 }
+#endif
 
 /**
  * @brief Read data in burst mode via SPI DMA
@@ -2463,27 +2860,20 @@ static int32_t ad4170_read_burst_data_spi_dma(uint32_t nb_of_samples,
 		return ret;
 	}
 #else
+	/* Conversions stream continuously into the IIO buffer once DMA is
+	 * configured. Completed DMA blocks are published to the IIO buffer from
+	 * the DMA IRQ, so nothing is left to be done (or waited upon) here */
 	if (!dma_config_updated) {
-		ret = no_os_cb_prepare_async_write(iio_dev_data->buffer->buf,
-						   nb_of_samples, &buff_start_addr, &data_read);
-		if (ret) {
-			return ret;
-		}
-
 		/* Set SYNC Low */
 		ret = no_os_gpio_set_value(p_ad4170_dev_inst->gpio_sync_inb, NO_OS_GPIO_LOW);
 		if (ret) {
 			return ret;
 		}
 
-		/* Cap SPI RX DMA NDTR to MAX_DMA_NDTR. */
-		spirxdma_ndtr = no_os_min(MAX_DMA_NDTR, nb_of_samples);
-		rxdma_ndtr = spirxdma_ndtr;
-
 		struct no_os_spi_msg  ad4170_spi_msg = {
 			.tx_buff = (uint32_t*)local_tx_data,
-			.rx_buff = (uint32_t*)local_buf,
-			.bytes_number = spirxdma_ndtr
+			.rx_buff = (uint32_t*)iio_dev_data->buffer->buf->buff,
+			.bytes_number = spi_dma_block_size
 		};
 
 		ret = no_os_spi_transfer_dma_async(p_ad4170_dev_inst->spi_desc, &ad4170_spi_msg,
@@ -2492,13 +2882,20 @@ static int32_t ad4170_read_burst_data_spi_dma(uint32_t nb_of_samples,
 			return ret;
 		}
 
+		/* Let the RX DMA alternate between consecutive IIO buffer blocks */
+		/* The local buffer is unused in continuous capture, it holds off the
+		 * DMA while the IIO buffer is full */
+		ret = stm32_spi_dma_double_buffer_config(iio_dev_data->buffer->buf,
+				spi_dma_block_size, local_buf);
+		if (ret) {
+			return ret;
+		}
+
 		dma_config_updated = true;
 
 		/* Configure Tx trigger timer parameters */
 		tim8_config();
 
-		update_buff(local_buf, buff_start_addr);
-
 		/* Set CS Low to stream data continuously on SDO */
 		ret = no_os_gpio_set_value(csb_gpio_desc, NO_OS_GPIO_LOW);
 		if (ret) {
@@ -2530,9 +2927,16 @@ static int32_t iio_ad4170_submit_buffer(struct iio_device_data *iio_dev_data)
 
 #if (INTERFACE_MODE  != TDM_MODE)
 	if (!buf_size_updated) {
+#if (INTERFACE_MODE == SPI_DMA_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+		/* Size the IIO buffer to an integral number of DMA blocks, so that
+		 * no block straddles the wrap-around of the IIO buffer */
+		iio_dev_data->buffer->buf->size = (DATA_BUFFER_SIZE / spi_dma_block_size) *
+						  spi_dma_block_size;
+#else
 		/* Update total buffer size according to requested samples
 		 * IIO from  for proper alignment of multi-channel IIO buffer data */
 		iio_dev_data->buffer->buf->size = iio_dev_data->buffer->size;
+#endif
 		buf_size_updated = true;
 	}
 #endif
@@ -2566,97 +2970,6 @@ static int32_t iio_ad4170_submit_buffer(struct iio_device_data *iio_dev_data)
 	return 0;
 }
 
-/**
- * @brief Cache register values modified by attributes
- * @return 0 in case of success, negative error code otherwise
- */
-int ad4170_cache_register_values(void)
-{
-	int ret;
-	uint8_t chn_setup_index = 0;
-	uint32_t debug_addr = AD4170_REG_ADC_CTRL;
-	uint32_t debug_val = 0;
-
-	read_reg_id = 0;
-
-	/* Cache ADC control register */
-	reg_values[read_reg_id].addr = AD4170_REG_ADC_CTRL;
-	ret = ad4170_spi_reg_read(p_ad4170_dev_inst, reg_values[read_reg_id].addr,
-				  &reg_values[read_reg_id].value);
-	if (ret) {
-		return ret;
-	}
-
-	read_reg_id++;
-
-	/* Cache setup register */
-	for (chn_setup_index = 0; chn_setup_index < AD4170_NUM_SETUPS;
-	     chn_setup_index++) {
-		reg_values[read_reg_id].addr = AD4170_REG_ADC_CHANNEL_SETUP(chn_setup_index);
-		ret = ad4170_spi_reg_read(p_ad4170_dev_inst,
-					  reg_values[read_reg_id].addr, &reg_values[read_reg_id].value);
-		if (ret) {
-			return ret;
-		}
-		read_reg_id++;
-	}
-
-	/* Cache AFE register */
-	for (chn_setup_index = 0; chn_setup_index < AD4170_NUM_SETUPS;
-	     chn_setup_index++) {
-		reg_values[read_reg_id].addr = AD4170_REG_ADC_SETUPS_AFE(chn_setup_index);
-		ret = ad4170_spi_reg_read(p_ad4170_dev_inst,
-					  reg_values[read_reg_id].addr, &reg_values[read_reg_id].value);
-		if (ret) {
-			return ret;
-		}
-		read_reg_id++;
-	}
-
-	/* Cache clock control register */
-	reg_values[read_reg_id].addr = AD4170_REG_CLOCK_CTRL;
-	ret = ad4170_spi_reg_read(p_ad4170_dev_inst,
-				  reg_values[read_reg_id].addr, &reg_values[read_reg_id].value);
-	if (ret) {
-		return ret;
-	}
-	read_reg_id++;
-
-	/* Cache Filter Fs register */
-	for (chn_setup_index = 0; chn_setup_index < AD4170_NUM_SETUPS;
-	     chn_setup_index++) {
-		reg_values[read_reg_id].addr = AD4170_REG_ADC_SETUPS_FILTER_FS(chn_setup_index);
-		ret = ad4170_spi_reg_read(p_ad4170_dev_inst,
-					  reg_values[read_reg_id].addr, &reg_values[read_reg_id].value);
-		if (ret) {
-			return ret;
-		}
-		read_reg_id++;
-	}
-
-	return 0;
-}
-
-/**
- * @brief Restore cached register values
- * @return 0 in case of success, negative error code otherwise
- */
-int ad4170_restore_cache(void)
-{
-	int ret;
-	uint8_t write_reg_id;
-
-	for (write_reg_id = 0; write_reg_id < read_reg_id; write_reg_id++) {
-		ret = ad4170_spi_reg_write(p_ad4170_dev_inst,
-					   reg_values[write_reg_id].addr, reg_values[write_reg_id].value);
-		if (ret) {
-			return ret;
-		}
-	}
-
-	return 0;
-}
-
 /**
  * @brief	Prepare for ADC data capture (transfer from device to memory)
  * @param	dev_instance[in] - IIO device instance
@@ -2667,28 +2980,32 @@ static int32_t iio_ad4170_prepare_transfer(void *dev_instance,
 		uint32_t chn_mask)
 {
 	int32_t ret;
-	uint8_t mask = 0x1;
+	uint16_t mask = 0x1;
 	uint8_t chn;
 	uint8_t setup;
 	uint8_t index = 0;
 	uint32_t timeout = BUF_READ_TIMEOUT;
+#if defined(STREAMING_FFT_ANALYSIS)
+	float t_settle = 0;
+#endif
 
 	num_of_active_channels = 0;
 	buf_size_updated = false;
 	data_capture_operation = true;
 
-	/* Store the previous active channels */
+	/* Store the previous active channels, the channels selected in the
+	 * IIO client are enabled in place for the data capture */
 	prev_active_channels = p_ad4170_dev_inst->config.channel_en;
 
 	/* Cache register values */
-	ret = ad4170_cache_register_values();
+	ret = ad4170_shadow_save(false);
 	if (ret) {
 		return ret;
 	}
 
 	/* Enable/Disable channels based on channel mask set in the IIO client */
 	for (chn = 0; chn < AD4170_NUM_CHANNELS; chn++) {
-		if (ad4170_init_params.config.channel_en & mask) {
+		if (chn_mask & mask) {
 			num_of_active_channels++;
 			active_channels[index++] = chn;
 
@@ -2711,6 +3028,30 @@ static int32_t iio_ad4170_prepare_transfer(void *dev_instance,
 		mask <<= 1;
 	}
 
+#if (INTERFACE_MODE == SPI_DMA_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	/* Size the ping-pong DMA block to an integral number of scans */
+	spi_dma_block_size = (no_os_min(MAX_DMA_NDTR, DATA_BUFFER_SIZE / 2) /
+			      (BYTES_PER_SAMPLE * num_of_active_channels)) *
+			     (BYTES_PER_SAMPLE * num_of_active_channels);
+#endif
+
+#if defined(STREAMING_FFT_ANALYSIS)
+	/* Restart the spectrum averaging at the per channel sampling rate */
+	ret = ad4170_determine_t_settle(&t_settle,
+					ad4170_init_params.config.setups[0].filter.filter_type,
+					ad4170_init_params.config.setups[0].filter_fs);
+	if (ret) {
+		return ret;
+	}
+
+	fft_scan_pos = 0;
+	ret = welch_fft_reset(ad4170_fft_desc,
+			      (1 / t_settle) / num_of_active_channels);
+	if (ret) {
+		return ret;
+	}
+#endif
+
 	adc_data_capture_started = true;
 
 	/* Ignore num_of_active_channels-1 samples if more than
@@ -2721,7 +3062,7 @@ static int32_t iio_ad4170_prepare_transfer(void *dev_instance,
 		num_samples_ignore = 2;
 	}
 
-#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && (INTERFACE_MODE != SPI_DMA_MODE)
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && ((INTERFACE_MODE == SPI_INTERRUPT_MODE) || (INTERFACE_MODE == TDM_MODE))
 	ret = iio_trig_enable(ad4170_hw_trig_desc);
 	if (ret) {
 		return ret;
@@ -2734,8 +3075,8 @@ static int32_t iio_ad4170_prepare_transfer(void *dev_instance,
 	}
 
 #if (INTERFACE_MODE == TDM_MODE)
-	/* Ensure that the start_tdm_dma_to_cb_transfer() is executed
-	 * only after the ad4170_iio_dev_data is populated */
+	/* Ensure that the TDM stream is started only after the
+	 * ad4170_iio_dev_data is populated */
 	while ((!is_triggered) && (timeout > 0)) {
 		timeout--;
 	}
@@ -2744,8 +3085,11 @@ static int32_t iio_ad4170_prepare_transfer(void *dev_instance,
 		return -ETIMEDOUT;
 	}
 
-	ret = start_tdm_dma_to_cb_transfer(ad4170_tdm_desc, ad4170_iio_dev_data,
-					   TDM_DMA_READ_SIZE, BYTES_PER_SAMPLE, num_samples_ignore);
+	/* The first few samples are discarded by the TDM stream, as the
+	 * TDM read is not invoked in-time to read the first channel in sequencer */
+	ret = stm32_tdm_stream_start(ad4170_tdm_stream,
+				     ad4170_iio_dev_data->buffer->buf,
+				     num_samples_ignore << 1);
 	if (ret) {
 		return ret;
 	}
@@ -2803,12 +3147,6 @@ static int32_t iio_ad4170_end_transfer(void *dev)
 	if (ret) {
 		return ret;
 	}
-
-	/* Restore (re-enable) the previous active channels */
-	ret = ad4170_set_channel_en(p_ad4170_dev_inst, prev_active_channels);
-	if (ret) {
-		return ret;
-	}
 #endif
 #else // SPI_DMA
 	stm32_timer_stop();
@@ -2837,13 +3175,15 @@ static int32_t iio_ad4170_end_transfer(void *dev)
 		return ret;
 	}
 
-	/* Restore (re-enable) the previous active channels */
+	dma_config_updated = false;
+#endif
+
+	/* Restore (re-enable) the previous active channels, on every capture
+	 * path since the captured channels are enabled in place */
 	ret = ad4170_set_channel_en(p_ad4170_dev_inst, prev_active_channels);
 	if (ret) {
 		return ret;
 	}
-	dma_config_updated = false;
-#endif
 
 	data_capture_operation = false;
 
@@ -3022,6 +3362,21 @@ struct iio_attribute ad4170_board_global_attributes[] = {
 		.name = "reconfigure_system_available",
 		.show = get_reconfigure_system_available,
 	},
+	{
+		.name = "reconfigure_latency_us",
+		.show = get_reconfigure_latency,
+		.store = set_reconfigure_latency
+	},
+	{
+		.name = "reconfigure_type",
+		.show = get_reconfigure_type,
+		.store = set_reconfigure_type
+	},
+	{
+		.name = "init_latency_us",
+		.show = get_init_latency,
+		.store = set_init_latency
+	},
 
 	END_ATTRIBUTES_ARRAY
 };
@@ -3068,6 +3423,76 @@ static struct iio_attribute global_attributes[] = {
 		.show = get_clock_available,
 		.store = set_clock_available
 	},
+#if (INTERFACE_MODE == SPI_INTERRUPT_MODE) && (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	{
+		.name = "achieved_sampling_frequency",
+		.show = get_achieved_sampling_frequency,
+		.store = set_achieved_sampling_frequency
+	},
+#endif
+#if defined(STREAMING_FFT_ANALYSIS)
+	{
+		.name = "fft_snr",
+		.show = get_streaming_fft,
+		.store = set_streaming_fft,
+		.priv = FFT_SNR_ATTR_ID
+	},
+	{
+		.name = "fft_sinad",
+		.show = get_streaming_fft,
+		.store = set_streaming_fft,
+		.priv = FFT_SINAD_ATTR_ID
+	},
+	{
+		.name = "fft_thd",
+		.show = get_streaming_fft,
+		.store = set_streaming_fft,
+		.priv = FFT_THD_ATTR_ID
+	},
+	{
+		.name = "fft_enob",
+		.show = get_streaming_fft,
+		.store = set_streaming_fft,
+		.priv = FFT_ENOB_ATTR_ID
+	},
+	{
+		.name = "fft_fundamental_frequency",
+		.show = get_streaming_fft,
+		.store = set_streaming_fft,
+		.priv = FFT_FUND_FREQ_ATTR_ID
+	},
+	{
+		.name = "fft_fundamental_dbfs",
+		.show = get_streaming_fft,
+		.store = set_streaming_fft,
+		.priv = FFT_FUND_DBFS_ATTR_ID
+	},
+	{
+		.name = "fft_averages",
+		.show = get_streaming_fft,
+		.store = set_streaming_fft,
+		.priv = FFT_AVERAGES_ATTR_ID
+	},
+#endif
+#if (INTERFACE_MODE == SPI_DMA_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	{
+		.name = "dma_overrun_count",
+		.show = get_dma_overrun_count,
+		.store = set_dma_overrun_count
+	},
+#endif
+#if (INTERFACE_MODE == TDM_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	{
+		.name = "tdm_dropped_slots",
+		.show = get_tdm_dropped_slots,
+		.store = set_tdm_dropped_slots
+	},
+#endif
+	{
+		.name = "reg_shadow_spi_saved",
+		.show = get_reg_shadow_spi_saved,
+		.store = set_reg_shadow_spi_saved
+	},
 
 	END_ATTRIBUTES_ARRAY
 };
@@ -3229,27 +3654,22 @@ static int32_t ad4170_iio_trigger_param_init(struct iio_hw_trig **desc)
 }
 
 /**
- * @brief	Init for reading/writing and parameterization of a
- * 			ad4170 IIO device
- * @param 	desc[in,out] - IIO device descriptor
+ * @brief	Build the IIO channel table of the ad4170 IIO device
+ * @param 	iio_dev[in,out] - IIO device
  * @param	dev_indx[in] - Device Index
- * @return	0 in case of success or negative value otherwise
+ * @return	None
+ * @note	All the input channels are published, whether enabled in the
+ *			device or not, so the IIO context description does not depend on
+ *			the enabled channels. The channels selected for a data capture
+ *			are enabled for its duration.
  */
-static int32_t ad4170_iio_init(struct iio_device **desc, uint8_t dev_indx)
+static void ad4170_iio_update_channels(struct iio_device *iio_dev,
+				       uint8_t dev_indx)
 {
-	struct iio_device *iio_ad4170_inst;
 	uint8_t chn;
 	uint8_t setup;
 	bool bipolar;
-	uint16_t chn_mask = p_ad4170_dev_inst->config.channel_en;
 	static struct iio_channel channels[TOTAL_CHANNELS];
-	uint16_t mask = 0x1;
-	uint8_t id = 0;
-
-	iio_ad4170_inst = calloc(1, sizeof(struct iio_device));
-	if (!iio_ad4170_inst) {
-		return -EINVAL;
-	}
 
 	/* Update IIO device init parameters */
 	for (chn = 0; chn < AD4170_NUM_CHANNELS; chn++) {
@@ -3273,31 +3693,46 @@ static int32_t ad4170_iio_init(struct iio_device **desc, uint8_t dev_indx)
 		chn_scan[chn].shift = 0;
 		chn_scan[chn].is_big_endian = false;
 #endif
+	}
 
-		/* Update the channel map structure to include the enabled channels only */
-		if (chn_mask & mask) {
-			channels[id] = iio_ad4170_channels[dev_indx][chn];
-			id++;
-		}
+	for (chn = 0; chn < TOTAL_CHANNELS; chn++) {
+		channels[chn] = iio_ad4170_channels[dev_indx][chn];
+	}
 
-		mask <<= 1;
+	iio_dev->num_ch = TOTAL_CHANNELS;
+	iio_dev->channels = channels;
+	num_of_channels = no_os_hweight16(p_ad4170_dev_inst->config.channel_en);
+}
+
+/**
+ * @brief	Init for reading/writing and parameterization of a
+ * 			ad4170 IIO device
+ * @param 	desc[in,out] - IIO device descriptor
+ * @param	dev_indx[in] - Device Index
+ * @return	0 in case of success or negative value otherwise
+ */
+static int32_t ad4170_iio_init(struct iio_device **desc, uint8_t dev_indx)
+{
+	struct iio_device *iio_ad4170_inst;
+
+	iio_ad4170_inst = calloc(1, sizeof(struct iio_device));
+	if (!iio_ad4170_inst) {
+		return -EINVAL;
 	}
 
-	iio_ad4170_inst->num_ch = no_os_hweight16(chn_mask);
-	iio_ad4170_inst->channels = channels;
+	ad4170_iio_update_channels(iio_ad4170_inst, dev_indx);
 	iio_ad4170_inst->attributes = global_attributes;
 
 	iio_ad4170_inst->submit = iio_ad4170_submit_buffer;
 	iio_ad4170_inst->pre_enable = iio_ad4170_prepare_transfer;
 	iio_ad4170_inst->post_disable = iio_ad4170_end_transfer;
-#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && (INTERFACE_MODE != SPI_DMA_MODE)
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && ((INTERFACE_MODE == SPI_INTERRUPT_MODE) || (INTERFACE_MODE == TDM_MODE))
 	iio_ad4170_inst->trigger_handler = iio_ad4170_trigger_handler;
 #endif
 
 	iio_ad4170_inst->debug_reg_read = debug_reg_read;
 	iio_ad4170_inst->debug_reg_write = debug_reg_write;
 
-	num_of_channels = iio_ad4170_inst->num_ch;
 	*desc = iio_ad4170_inst;
 
 	return 0;
@@ -3428,6 +3863,36 @@ static int board_iio_params_init(struct iio_device** desc,
 	return 0;
 }
 
+/**
+ * @brief	Get a timestamp for the reconfiguration latency measurements
+ * @return	Timestamp (cycle counter ticks on STM32, usec otherwise)
+ */
+static uint32_t ad4170_get_timestamp(void)
+{
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+	return stm32_cycle_counter_get();
+#else
+	struct no_os_time now = no_os_get_time();
+
+	return now.s * 1000000 + now.us;
+#endif
+}
+
+/**
+ * @brief	Get the time elapsed since a timestamp
+ * @param	start[in] - Timestamp from ad4170_get_timestamp()
+ * @return	Elapsed time (in usec)
+ */
+static uint32_t ad4170_get_elapsed_us(uint32_t start)
+{
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+	return (uint64_t)(stm32_cycle_counter_get() - start) * 1000000 /
+	       stm32_cycle_counter_freq();
+#else
+	return ad4170_get_timestamp() - start;
+#endif
+}
+
 /**
  * @brief	Initialize the IIO interface for AD4170 IIO device
  * @return	none
@@ -3437,6 +3902,7 @@ int32_t ad4170_iio_initialize(void)
 {
 	int32_t init_status;
 	uint8_t read_id;
+	uint32_t start_time;
 	static bool entered = false;
 	static bool s_rate_configured = false;
 
@@ -3446,9 +3912,36 @@ int32_t ad4170_iio_initialize(void)
 		if (init_status) {
 			return init_status;
 		}
+
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+		/* Cycle counter timing the burst captures and the reconfigurations */
+		stm32_cycle_counter_enable();
+#endif
+
+#if (INTERFACE_MODE == SPI_INTERRUPT_MODE) && (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+		/* Init the block-batched burst capture */
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+		burst_capture_init_params.ticks_per_sec = stm32_cycle_counter_freq();
+#endif
+		init_status = burst_capture_init(&ad4170_burst_desc,
+						 &burst_capture_init_params);
+		if (init_status) {
+			return init_status;
+		}
+#endif
+
+#if defined(STREAMING_FFT_ANALYSIS)
+		/* Init the streaming FFT analysis of the burst data */
+		init_status = welch_fft_init(&ad4170_fft_desc, &welch_fft_init_params);
+		if (init_status) {
+			return init_status;
+		}
+#endif
 		entered = true;
 	}
 
+	start_time = ad4170_get_timestamp();
+
 	/* Read context attributes */
 	for (read_id = 0; read_id < NO_OS_ARRAY_SIZE(mezzanine_names); read_id++) {
 		init_status = get_iio_context_attributes(&iio_init_params.ctx_attrs,
@@ -3497,6 +3990,12 @@ int32_t ad4170_iio_initialize(void)
 			return init_status;
 		}
 
+		/* Initialize the register shadow with the configured registers */
+		init_status = ad4170_shadow_init();
+		if (init_status) {
+			return init_status;
+		}
+
 		/* Initialize the device if HW mezzanine status is valid */
 		init_status = ad4170_iio_init(&p_iio_ad4170_dev[iio_init_params.nb_devs],
 					      iio_init_params.nb_devs);
@@ -3513,7 +4012,7 @@ int32_t ad4170_iio_initialize(void)
 
 		iio_init_params.nb_devs++;
 
-#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && (INTERFACE_MODE != SPI_DMA_MODE)
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && ((INTERFACE_MODE == SPI_INTERRUPT_MODE) || (INTERFACE_MODE == TDM_MODE))
 		iio_init_params.nb_trigs++;
 #endif
 	}
@@ -3540,7 +4039,7 @@ int32_t ad4170_iio_initialize(void)
 		return init_status;
 	}
 
-#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && (INTERFACE_MODE != SPI_DMA_MODE)
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && ((INTERFACE_MODE == SPI_INTERRUPT_MODE) || (INTERFACE_MODE == TDM_MODE))
 	/* Initialize the IIO trigger specific parameters */
 	init_status = ad4170_iio_trigger_param_init(&ad4170_hw_trig_desc);
 	if (init_status) {
@@ -3556,6 +4055,8 @@ int32_t ad4170_iio_initialize(void)
 	}
 #endif
 
+	last_init_latency_us = ad4170_get_elapsed_us(start_time);
+
 	return init_status;
 }
 
@@ -3580,50 +4081,148 @@ int iio_params_deinit(void)
 }
 
 /**
- * @brief 	Run the AD4170 IIO event handler
- * @return	none
- * @details	This function monitors the new IIO client event
+ * @brief	Apply the staged system configuration to the running device
+ * @return	0 in case of success, negative error code otherwise
+ * @details	The configuration staged through the system_config attributes
+ *			(filter, FS and channel enable) is compared with the one applied
+ *			to the device. Only the setup registers that changed are written,
+ *			through the register shadow. Since all the input channels are
+ *			published, a new set of enabled channels is written to the device
+ *			only, keeping the IIO descriptor and the context description.
  */
-void ad4170_iio_event_handler(void)
+static int32_t ad4170_iio_apply_config(void)
 {
-	int ret;
+	struct ad4170_config *staged = &ad4170_init_params.config;
+	struct ad4170_config *applied;
+	uint32_t reg_val;
+	uint8_t setup;
+	int32_t ret;
 
-	if (restart_iio_flag) {
-#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && ((INTERFACE_MODE == SPI_INTERRUPT_MODE) || (INTERFACE_MODE == TDM_MODE))
-		/* Remove and free the pointers allocated during IIO init */
-		ret = iio_hw_trig_remove(ad4170_hw_trig_desc);
-		if (ret) {
-			return;
-		}
-#endif
+	if (!p_ad4170_dev_inst) {
+		/* No device to reconfigure (HW mezzanine not detected) */
+		return -ENODEV;
+	}
 
-		/* Remove IIO Parameters */
-		iio_params_deinit();
+	applied = &p_ad4170_dev_inst->config;
 
-		/* Remove IIO Context attributes */
-		remove_iio_context_attributes(iio_init_params.ctx_attrs);
+	for (setup = 0; setup < AD4170_NUM_SETUPS; setup++) {
+		if (staged->setups[setup].filter.filter_type !=
+		    applied->setups[setup].filter.filter_type) {
+			ret = ad4170_shadow_reg_read(AD4170_REG_ADC_SETUPS_FILTER(setup), &reg_val);
+			if (ret) {
+				return ret;
+			}
 
-		/* Remove AD4170 Device descriptor */
-		ret = ad4170_remove(p_ad4170_dev_inst);
-		if (ret) {
-			return;
+			reg_val &= ~AD4170_ADC_SETUPS_FILTER_TYPE_MSK;
+			reg_val |= no_os_field_prep(AD4170_ADC_SETUPS_FILTER_TYPE_MSK,
+						    staged->setups[setup].filter.filter_type);
+
+			ret = ad4170_shadow_reg_write(AD4170_REG_ADC_SETUPS_FILTER(setup), reg_val);
+			if (ret) {
+				return ret;
+			}
+
+			applied->setups[setup].filter.filter_type =
+				staged->setups[setup].filter.filter_type;
+		}
+
+		if (staged->setups[setup].filter_fs != applied->setups[setup].filter_fs) {
+			ret = ad4170_shadow_reg_write(AD4170_REG_ADC_SETUPS_FILTER_FS(setup),
+						      staged->setups[setup].filter_fs);
+			if (ret) {
+				return ret;
+			}
+
+			applied->setups[setup].filter_fs = staged->setups[setup].filter_fs;
 		}
+	}
 
-		/* Remove the AD4170 IIO Descriptor */
-		ret = iio_remove(p_ad4170_iio_desc);
+	if (staged->channel_en != applied->channel_en) {
+		ret = ad4170_set_channel_en(p_ad4170_dev_inst, staged->channel_en);
 		if (ret) {
-			return;
+			return ret;
 		}
+		ad4170_shadow_invalidate(AD4170_REG_CHANNEL_EN);
+
+		num_of_channels = no_os_hweight16(staged->channel_en);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief	Tear down and re-initialize the device and the IIO interface
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t ad4170_iio_restart(void)
+{
+	int32_t ret;
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && ((INTERFACE_MODE == SPI_INTERRUPT_MODE) || (INTERFACE_MODE == TDM_MODE))
+	/* Remove and free the pointers allocated during IIO init */
+	ret = iio_hw_trig_remove(ad4170_hw_trig_desc);
+	if (ret) {
+		return ret;
+	}
+#endif
+
+	/* Remove IIO Parameters */
+	iio_params_deinit();
+
+	/* Remove IIO Context attributes */
+	remove_iio_context_attributes(iio_init_params.ctx_attrs);
+
+	/* Remove AD4170 Device descriptor */
+	ret = ad4170_remove(p_ad4170_dev_inst);
+	if (ret) {
+		return ret;
+	}
+
+	/* Remove the AD4170 IIO Descriptor */
+	ret = iio_remove(p_ad4170_iio_desc);
+	if (ret) {
+		return ret;
+	}
 
 #if (ACTIVE_IIO_CLIENT == IIO_CLIENT_LOCAL)
-		no_os_free(pocket_lab_gui_desc);
-		pl_gui_remove();
+	no_os_free(pocket_lab_gui_desc);
+	pl_gui_remove();
 #endif
+
+	/* Initialize AD4170 device and peripheral interface */
+	return ad4170_iio_initialize();
+}
+
+/**
+ * @brief 	Run the AD4170 IIO event handler
+ * @return	none
+ * @details	This function monitors the new IIO client event
+ */
+void ad4170_iio_event_handler(void)
+{
+	uint32_t start_time;
+	int32_t ret;
+
+	if (restart_iio_flag) {
+		start_time = ad4170_get_timestamp();
+
 		/* Reset the restart_iio flag */
 		restart_iio_flag = false;
 
-		/* Initialize AD4170 device and peripheral interface */
-		ad4170_iio_initialize();
+		/* Apply the configuration changes in place, falling back to a full
+		 * restart of the device and the IIO interface if needed */
+		ret = ad4170_iio_apply_config();
+		if (!ret) {
+			last_reconfig_type = AD4170_RECONFIG_INCREMENTAL;
+		} else {
+			last_reconfig_type = AD4170_RECONFIG_FULL;
+			ret = ad4170_iio_restart();
+		}
+
+		last_reconfig_latency_us = ad4170_get_elapsed_us(start_time);
+		if (ret) {
+			return;
+		}
 	}
 
 	(void)iio_step(p_ad4170_iio_desc);
@@ -13,9 +13,13 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
+#include <string.h>
 #include "ad4170_support.h"
 #include "app_config.h"
 #include "ad4170_iio.h"
+#include "ad4170_regs.h"
+#include "reg_shadow.h"
+#include "sample_format.h"
 #include "no_os_error.h"
 
 /******************************************************************************/
@@ -25,10 +29,41 @@
 /* Scale value for Filters - SINC5, SINC5_AVG and SINC3 */
 #define FILTER_SCALE		32
 
+/* Register access instruction (long instruction mode, CRC disabled): R/W bit
+ * and 14-bit address of the first register byte, the device then streams the
+ * following bytes at decrementing addresses (default ADDR_ASCENSION = 0) */
+#define AD4170_SHADOW_INSTR_LEN		2
+#define AD4170_SHADOW_READ			0x80
+
+/* Access address of a register: streaming downwards, a register is accessed
+ * from its MSB, at the highest address of the register */
+#define AD4170_SHADOW_ADDR(reg)		(AD4170_ADDR(reg) + AD4170_TRANSF_LEN(reg) - 1)
+
+/* Max bytes per register shadow burst (the channel and setup blocks abut) */
+#define AD4170_SHADOW_MAX_BURST		256
+
+/* Registers owned by the application (reconfigured through the attributes) */
+#define AD4170_SHADOW_CONFIG_REGS	(2 + (2 * AD4170_NUM_CHANNELS) + \
+					 (6 * AD4170_NUM_SETUPS))
+
 /******************************************************************************/
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
 
+/* Register shadow of the device */
+static struct reg_shadow_desc *ad4170_shadow;
+
+/* Device register map and registers owned by the application (increasing
+ * address order) */
+static struct reg_shadow_reg ad4170_shadow_map_regs[ADC_REGISTER_COUNT];
+static struct reg_shadow_reg ad4170_shadow_config_regs[AD4170_SHADOW_CONFIG_REGS];
+
+/* SPI transactions saved by the last reconfiguration */
+static uint32_t ad4170_shadow_saved;
+
+/* Transfer accounting at the start of the reconfiguration */
+static struct reg_shadow_stats ad4170_shadow_stats_start;
+
 /******************************************************************************/
 /************************** Functions Definitions *****************************/
 /******************************************************************************/
@@ -161,8 +196,8 @@ int32_t ad4170_read_converted_sample(uint32_t *adc_data)
 		return -EIO;
 	}
 
-	/* Extract data:       MSB                       LSB */
-	*adc_data = (buf[0] << 16) | (buf[1] << 8) | buf[2];
+	/* Extract data: MSB first */
+	sample_unpack_be24(buf, adc_data, 1);
 
 	return 0;
 }
@@ -185,13 +220,7 @@ int32_t perform_sign_conversion(uint32_t adc_raw_data, uint8_t chn)
 	 **/
 	if (bipolar) {
 		/* Data output format is 2's complement for bipolar mode */
-		if (adc_raw_data >= ADC_MAX_COUNT_BIPOLAR) {
-			/* Remove the offset from result to convert into negative reading */
-			adc_data = ADC_MAX_COUNT_UNIPOLAR - adc_raw_data;
-			adc_data = -adc_data;
-		} else {
-			adc_data = adc_raw_data;
-		}
+		adc_data = sample_sign_extend_code(adc_raw_data, ADC_RESOLUTION);
 	} else {
 		/* Data output format is straight binary for unipolar mode */
 		adc_data = adc_raw_data;
@@ -529,7 +558,7 @@ int32_t ad4170_set_filter(struct ad4170_dev *dev, uint8_t chn,
 
 	reg = no_os_field_prep(AD4170_ADC_SETUPS_FILTER_TYPE_MSK,
 			       filt_type);
-	ret = ad4170_spi_reg_write(dev, AD4170_REG_ADC_SETUPS_FILTER(setup), reg);
+	ret = ad4170_shadow_reg_write(AD4170_REG_ADC_SETUPS_FILTER(setup), reg);
 	if (ret) {
 		return ret;
 	}
@@ -559,7 +588,7 @@ int32_t ad4170_set_reference(struct ad4170_dev *dev, uint8_t chn,
 
 	reg = no_os_field_prep(AD4170_ADC_SETUPS_AFE_REF_SELECT_MSK,
 			       ref);
-	ret = ad4170_spi_reg_write(dev, AD4170_REG_ADC_SETUPS_AFE(setup), reg);
+	ret = ad4170_shadow_reg_write(AD4170_REG_ADC_SETUPS_AFE(setup), reg);
 	if (ret) {
 		return ret;
 	}
@@ -588,7 +617,7 @@ int32_t ad4170_set_fs(struct ad4170_dev *dev, uint8_t setup, uint8_t chn,
 		return -EINVAL;
 	}
 
-	ret = ad4170_spi_reg_write(dev, AD4170_REG_ADC_SETUPS_FILTER_FS(setup), fs_val);
+	ret = ad4170_shadow_reg_write(AD4170_REG_ADC_SETUPS_FILTER_FS(setup), fs_val);
 	if (ret) {
 		return ret;
 	}
@@ -654,3 +683,252 @@ int ad4170_determine_t_settle(float *t_settle,
 	return 0;
 }
 
+
+/*!
+ * @brief	Stream register bytes from the device (register shadow read op)
+ * @param	ctx[in] - Device instance pointer (struct ad4170_dev **)
+ * @param	addr[in] - Address of the first byte
+ * @param	data[out] - Register bytes (preceded by the instruction headroom)
+ * @param	len[in] - Number of bytes
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t ad4170_shadow_spi_read(void *ctx, uint16_t addr, uint8_t *data,
+				      uint16_t len)
+{
+	struct ad4170_dev *dev = *(struct ad4170_dev **)ctx;
+	uint8_t *buf = data - AD4170_SHADOW_INSTR_LEN;
+
+	buf[0] = AD4170_SHADOW_READ | (uint8_t)(addr >> 8);
+	buf[1] = (uint8_t)addr;
+	memset(data, 0, len);
+
+	return no_os_spi_write_and_read(dev->spi_desc, buf,
+					len + AD4170_SHADOW_INSTR_LEN);
+}
+
+/*!
+ * @brief	Stream register bytes to the device (register shadow write op)
+ * @param	ctx[in] - Device instance pointer (struct ad4170_dev **)
+ * @param	addr[in] - Address of the first byte
+ * @param	data[in] - Register bytes (preceded by the instruction headroom)
+ * @param	len[in] - Number of bytes
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t ad4170_shadow_spi_write(void *ctx, uint16_t addr, uint8_t *data,
+				       uint16_t len)
+{
+	struct ad4170_dev *dev = *(struct ad4170_dev **)ctx;
+	uint8_t *buf = data - AD4170_SHADOW_INSTR_LEN;
+
+	buf[0] = (uint8_t)(addr >> 8);
+	buf[1] = (uint8_t)addr;
+
+	return no_os_spi_write_and_read(dev->spi_desc, buf,
+					len + AD4170_SHADOW_INSTR_LEN);
+}
+
+static const struct reg_shadow_ops ad4170_shadow_ops = {
+	.read = ad4170_shadow_spi_read,
+	.write = ad4170_shadow_spi_write
+};
+
+/*!
+ * @brief	Get the register shadow entry of a device register
+ * @param	reg[in] - Register (address and size, as defined in ad4170.h)
+ * @return	Register shadow entry
+ */
+static struct reg_shadow_reg ad4170_shadow_reg(uint32_t reg)
+{
+	struct reg_shadow_reg shadow_reg = {
+		.addr = AD4170_SHADOW_ADDR(reg),
+		.size = AD4170_TRANSF_LEN(reg)
+	};
+
+	return shadow_reg;
+}
+
+/*!
+ * @brief	Initialize the register shadow and load the registers owned by
+ *			the application
+ * @return	0 in case of success, negative error code otherwise
+ * @note	The device instance is looked up on every transfer, as it is
+ *			re-allocated when the device is re-initialized.
+ */
+int32_t ad4170_shadow_init(void)
+{
+	struct reg_shadow_init_param shadow_init_params = {
+		.map_size = AD4170_SHADOW_ADDR(MAX_REGISTER_ADDRESS) + 1,
+		.descending = true,
+		.max_burst = AD4170_SHADOW_MAX_BURST,
+		.headroom = AD4170_SHADOW_INSTR_LEN,
+		.ops = &ad4170_shadow_ops,
+		.ctx = &p_ad4170_dev_inst
+	};
+	uint16_t nb_regs = 0;
+	uint8_t index;
+	int32_t ret;
+
+	/* Bursts are built for the long instruction mode without CRC */
+	if (p_ad4170_dev_inst->spi_settings.short_instruction
+	    || p_ad4170_dev_inst->spi_settings.crc_enabled) {
+		return -ENOTSUP;
+	}
+
+	if (!ad4170_shadow) {
+		ret = reg_shadow_init(&ad4170_shadow, &shadow_init_params);
+		if (ret) {
+			return ret;
+		}
+
+		for (index = 0; index < ADC_REGISTER_COUNT; index++) {
+			ad4170_shadow_map_regs[index] = ad4170_shadow_reg(ad4170_regs[index]);
+		}
+
+		ad4170_shadow_config_regs[nb_regs++] = ad4170_shadow_reg(AD4170_REG_CLOCK_CTRL);
+		ad4170_shadow_config_regs[nb_regs++] = ad4170_shadow_reg(AD4170_REG_ADC_CTRL);
+
+		for (index = 0; index < AD4170_NUM_CHANNELS; index++) {
+			ad4170_shadow_config_regs[nb_regs++] =
+				ad4170_shadow_reg(AD4170_REG_ADC_CHANNEL_SETUP(index));
+			ad4170_shadow_config_regs[nb_regs++] =
+				ad4170_shadow_reg(AD4170_REG_ADC_CHANNEL_MAP(index));
+		}
+
+		for (index = 0; index < AD4170_NUM_SETUPS; index++) {
+			ad4170_shadow_config_regs[nb_regs++] =
+				ad4170_shadow_reg(AD4170_REG_ADC_SETUPS_MISC(index));
+			ad4170_shadow_config_regs[nb_regs++] =
+				ad4170_shadow_reg(AD4170_REG_ADC_SETUPS_AFE(index));
+			ad4170_shadow_config_regs[nb_regs++] =
+				ad4170_shadow_reg(AD4170_REG_ADC_SETUPS_FILTER(index));
+			ad4170_shadow_config_regs[nb_regs++] =
+				ad4170_shadow_reg(AD4170_REG_ADC_SETUPS_FILTER_FS(index));
+			ad4170_shadow_config_regs[nb_regs++] =
+				ad4170_shadow_reg(AD4170_REG_ADC_SETUPS_OFFSET(index));
+			ad4170_shadow_config_regs[nb_regs++] =
+				ad4170_shadow_reg(AD4170_REG_ADC_SETUPS_GAIN(index));
+		}
+	}
+
+	return ad4170_shadow_save(false);
+}
+
+/*!
+ * @brief	Read a device register from the register shadow
+ * @param	reg[in] - Register (address and size, as defined in ad4170.h)
+ * @param	val[out] - Register value
+ * @return	0 in case of success, negative error code otherwise
+ * @note	The device is only accessed when the register is not cached.
+ */
+int32_t ad4170_shadow_reg_read(uint32_t reg, uint32_t *val)
+{
+	return reg_shadow_read(ad4170_shadow, AD4170_SHADOW_ADDR(reg),
+			       AD4170_TRANSF_LEN(reg), val);
+}
+
+/*!
+ * @brief	Write a device register through the register shadow
+ * @param	reg[in] - Register (address and size, as defined in ad4170.h)
+ * @param	val[in] - Register value
+ * @return	0 in case of success, negative error code otherwise
+ * @note	The device is only accessed when the register value changes.
+ */
+int32_t ad4170_shadow_reg_write(uint32_t reg, uint32_t val)
+{
+	int32_t ret;
+
+	ret = reg_shadow_write(ad4170_shadow, AD4170_SHADOW_ADDR(reg),
+			       AD4170_TRANSF_LEN(reg), val);
+	if (ret) {
+		return ret;
+	}
+
+	return reg_shadow_flush(ad4170_shadow);
+}
+
+/*!
+ * @brief	Drop the cached value of a register written outside the shadow
+ * @param	reg[in] - Register (address and size, as defined in ad4170.h)
+ * @return	none
+ */
+void ad4170_shadow_invalidate(uint32_t reg)
+{
+	reg_shadow_invalidate(ad4170_shadow, AD4170_SHADOW_ADDR(reg),
+			      AD4170_TRANSF_LEN(reg));
+}
+
+/*!
+ * @brief	Save the device registers into the register shadow
+ * @param	full_map[in] - Save the whole register map (registers owned by
+ *			the application otherwise)
+ * @return	0 in case of success, negative error code otherwise
+ * @note	Starts a reconfiguration, the SPI transactions being accounted
+ *			from here up to the ad4170_shadow_restore().
+ */
+int32_t ad4170_shadow_save(bool full_map)
+{
+	reg_shadow_get_stats(ad4170_shadow, &ad4170_shadow_stats_start);
+
+	if (full_map) {
+		return reg_shadow_load(ad4170_shadow, ad4170_shadow_map_regs,
+				       ADC_REGISTER_COUNT);
+	}
+
+	return reg_shadow_load(ad4170_shadow, ad4170_shadow_config_regs,
+			       AD4170_SHADOW_CONFIG_REGS);
+}
+
+/*!
+ * @brief	Restore the device registers saved in the register shadow
+ * @param	full_map[in] - Restore the whole register map (registers owned by
+ *			the application otherwise)
+ * @return	0 in case of success, negative error code otherwise
+ * @note	Ends a reconfiguration: the SPI transactions saved since its
+ *			ad4170_shadow_save() (over one transaction per register access) are
+ *			reported by ad4170_shadow_get_spi_saved().
+ */
+int32_t ad4170_shadow_restore(bool full_map)
+{
+	struct reg_shadow_stats stats;
+	int32_t ret;
+
+	if (full_map) {
+		reg_shadow_mark_dirty(ad4170_shadow, ad4170_shadow_map_regs,
+				      ADC_REGISTER_COUNT);
+	} else {
+		reg_shadow_mark_dirty(ad4170_shadow, ad4170_shadow_config_regs,
+				      AD4170_SHADOW_CONFIG_REGS);
+	}
+
+	ret = reg_shadow_flush(ad4170_shadow);
+	if (ret) {
+		return ret;
+	}
+
+	reg_shadow_get_stats(ad4170_shadow, &stats);
+	ad4170_shadow_saved = (stats.reg_accesses -
+			       ad4170_shadow_stats_start.reg_accesses) -
+			      (stats.transfers - ad4170_shadow_stats_start.transfers);
+	ad4170_shadow_stats_start = stats;
+
+	return 0;
+}
+
+/*!
+ * @brief	Get the SPI transactions saved by the last reconfiguration
+ * @return	Number of SPI transactions saved
+ */
+uint32_t ad4170_shadow_get_spi_saved(void)
+{
+	return ad4170_shadow_saved;
+}
+
+/*!
+ * @brief	Clear the SPI transaction accounting
+ * @return	none
+ */
+void ad4170_shadow_clear_spi_saved(void)
+{
+	reg_shadow_get_stats(ad4170_shadow, &ad4170_shadow_stats_start);
+	ad4170_shadow_saved = 0;
+}
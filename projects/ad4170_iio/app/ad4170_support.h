@@ -16,6 +16,7 @@
 /******************************************************************************/
 
 #include <stdlib.h>
+#include <stdbool.h>
 #include "ad4170.h"
 
 /******************************************************************************/
@@ -51,4 +52,12 @@ int32_t ad4170_set_fs(struct ad4170_dev *dev, uint8_t setup, uint8_t chn,
 		      uint16_t fs_val);
 int ad4170_determine_t_settle(float *t_settle,
 			      enum ad4170_filter_type  filter_type, uint32_t filter_fs);
+int32_t ad4170_shadow_init(void);
+int32_t ad4170_shadow_reg_read(uint32_t reg, uint32_t *val);
+int32_t ad4170_shadow_reg_write(uint32_t reg, uint32_t val);
+void ad4170_shadow_invalidate(uint32_t reg);
+int32_t ad4170_shadow_save(bool full_map);
+int32_t ad4170_shadow_restore(bool full_map);
+uint32_t ad4170_shadow_get_spi_saved(void);
+void ad4170_shadow_clear_spi_saved(void);
 #endif	/* end of AD4170_SUPPORT_H_ */
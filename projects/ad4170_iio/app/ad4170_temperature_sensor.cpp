@@ -17,9 +17,6 @@
 #include <stdint.h>
 #include <math.h>
 
-#include <thermocouple.h>
-#include <ntc_10k_44031.h>
-#include <ptxxx.h>
 #include "ad4170_temperature_sensor.h"
 
 #ifdef __cplusplus
@@ -29,6 +26,7 @@ extern "C"
 
 #include "app_config.h"
 #include "ad4170_support.h"
+#include "temp_linearizer.h"
 
 #ifdef __cplusplus  // Closing extern c
 }
@@ -38,12 +36,16 @@ extern "C"
 /********************* Macros and Constants Definitions ***********************/
 /******************************************************************************/
 
-/* NTC thermistor Rsense value (in ohms) */
+/* NTC thermistor Rsense value (in ohms), matching temp_lin_ntc_10k_44031 */
 #define NTC_RSENSE			10000U
 
 /* RTD Rref Resistance value (in ohms) */
 #define RTD_RREF			5110U
 
+/* Nominal (0 degC) resistance of the PT100 and PT1000 RTDs (in ohms) */
+#define PT100_R0			100.0f
+#define PT1000_R0			1000.0f
+
 /******************************************************************************/
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
@@ -53,17 +55,16 @@ extern "C"
 /******************************************************************************/
 
 /*!
- * @brief	Convert the NTC thermistor voltage into equivalent resistance
- * @param	voltage[in] - NTC Thermistor voltage
- * @return	NTC Thermistor resistance value
- * @note	The NTC is biased with constant ADC reference voltage. Below formula
- *			is based on ratiometric measurement, where fixed value of ADC REF
- *			and gain is taken into account
+ * @brief	Convert the NTC thermistor voltage into the NTC divider ratio
+ * @param	ntc_voltage[in] - NTC Thermistor voltage
+ * @return	NTC divider ratio, R / (R + NTC_RSENSE)
+ * @note	The NTC is biased with constant ADC reference voltage through
+ *			NTC_RSENSE. Below formula is based on ratiometric measurement, where
+ *			fixed value of ADC REF and gain is taken into account
  */
-static float convert_ntc_voltage_into_resistance(float ntc_voltage)
+static float convert_ntc_voltage_into_ratio(float ntc_voltage)
 {
-	return ((ntc_voltage * NTC_RSENSE) / (AD4170_REFIN_REFOUT_VOLTAGE -
-					      ntc_voltage));
+	return (ntc_voltage / AD4170_REFIN_REFOUT_VOLTAGE);
 }
 
 /**
@@ -75,14 +76,13 @@ static float convert_ntc_voltage_into_resistance(float ntc_voltage)
  */
 float get_ntc_thermistor_temperature(uint32_t ntc_sample, uint8_t chn)
 {
-	ntc_10k_44031rc ntc_thermistor;
 	float ntc_voltage;
-	float ntc_resistance;
 
 	ntc_voltage = convert_adc_sample_into_voltage(ntc_sample, chn);
-	ntc_resistance = convert_ntc_voltage_into_resistance(ntc_voltage);
 
-	return ntc_thermistor.convert(ntc_resistance);
+	/* Fixed 10K NTC_RSENSE divider (see temp_linearizer.h) */
+	return temp_lin_convert(&temp_lin_ntc_10k_44031,
+				convert_ntc_voltage_into_ratio(ntc_voltage));
 }
 
 /**
@@ -94,11 +94,10 @@ float get_ntc_thermistor_temperature(uint32_t ntc_sample, uint8_t chn)
  */
 float get_rtd_temperature(uint32_t rtd_sample, uint8_t chn)
 {
-	PT100 rtd_sensor;
 	float rtd_resistance;
 
 	rtd_resistance = convert_adc_raw_into_rtd_resistance(rtd_sample, RTD_RREF, chn);
-	return rtd_sensor.convertResistanceToTemperature(rtd_resistance);
+	return temp_lin_convert(&temp_lin_pt_rtd, rtd_resistance / PT100_R0);
 }
 
 /**
@@ -116,20 +115,21 @@ float get_tc_temperature(uint32_t tc_sample, uint32_t cjc_sample,
 			 uint8_t tc_chn,
 			 uint8_t cjc_chn, float *cjc_temp)
 {
-	Thermocouple_Type_T tcSensor;
 	float tc_mv;
 	float tc_temperature;
 	float cjc_temperature;
-	PT1000 rtd_sensor;
+#if defined(USE_CJC_AS_RTD)
 	float rtd_resistance;
+#endif
 
 	tc_mv = convert_adc_sample_into_voltage(tc_sample, tc_chn) * 1000;
-	tc_temperature = tcSensor.convert(tc_mv);
+	tc_temperature = temp_lin_convert(&temp_lin_tc_type_t, tc_mv);
 
 #if defined(USE_CJC_AS_RTD)
 	rtd_resistance = convert_adc_raw_into_rtd_resistance(cjc_sample, RTD_RREF,
 			 cjc_chn);
-	cjc_temperature = rtd_sensor.convertResistanceToTemperature(rtd_resistance);
+	cjc_temperature = temp_lin_convert(&temp_lin_pt_rtd,
+					   rtd_resistance / PT1000_R0);
 #else
 	cjc_temperature = get_ntc_thermistor_temperature(cjc_sample, cjc_chn);
 #endif
@@ -26,6 +26,9 @@
 #include "no_os_i2c.h"
 #include "no_os_eeprom.h"
 #include "no_os_tdm.h"
+#if (INTERFACE_MODE == TDM_MODE)
+#include "stm32_tdm_support.h"
+#endif
 #include "no_os_pwm.h"
 #include "no_os_delay.h"
 #if (ACTIVE_IIO_CLIENT == IIO_CLIENT_LOCAL)
@@ -127,6 +130,16 @@ struct no_os_tdm_init_param tdm_init_param = {
 
 /* TDM Descriptor */
 struct no_os_tdm_desc *ad4170_tdm_desc;
+
+/* TDM stream init parameters */
+static struct stm32_tdm_stream_init_param tdm_stream_init_param = {
+	.slot_samples = TDM_DMA_READ_SIZE,
+	.bytes_per_sample = BYTES_PER_SAMPLE,
+	.max_buffer_size = DATA_BUFFER_SIZE
+};
+
+/* TDM stream descriptor */
+struct stm32_tdm_stream_desc *ad4170_tdm_stream;
 #endif // INTERFACE_MODE
 
 /* I2C init parameters */
@@ -322,6 +335,10 @@ static int32_t init_tdm(void)
 	if (no_os_tdm_init(&ad4170_tdm_desc, &tdm_init_param) != 0) {
 		return -EINVAL;
 	}
+
+	tdm_stream_init_param.tdm_desc = ad4170_tdm_desc;
+
+	return stm32_tdm_stream_init(&ad4170_tdm_stream, &tdm_stream_init_param);
 #endif // INTERFACE_MODE
 
 	return 0;
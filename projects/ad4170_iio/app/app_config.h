@@ -138,6 +138,14 @@
 #define DATA_CAPTURE_MODE	BURST_DATA_CAPTURE
 #endif
 
+/* The spectrum of the SPI burst data is analyzed with CMSIS-DSP, which is
+ * built into the Disco-F769NI project only */
+#if (ACTIVE_PLATFORM == STM32_PLATFORM) && !defined(TARGET_SDP_K1) \
+	&& !defined(NUCLEO_H563) && (INTERFACE_MODE == SPI_INTERRUPT_MODE) \
+	&& (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+#define STREAMING_FFT_ANALYSIS
+#endif
+
 /* Enable the UART/VirtualCOM port connection (default VCOM) */
 //#define USE_PHY_COM_PORT		// Uncomment to select UART
 
@@ -273,6 +281,22 @@
 #define USE_SDRAM		// Comment to disable SDRAM for data buffer
 #endif
 
+/* ADC data buffer size */
+#if defined(USE_SDRAM)
+#define DATA_BUFFER_SIZE			SDRAM_SIZE_BYTES
+#else
+#if (ACTIVE_IIO_CLIENT == IIO_CLIENT_LOCAL)
+/* Note: Setting lower size due to memory constraints on MCU */
+#define DATA_BUFFER_SIZE			(16384)
+#else
+#if (INTERFACE_MODE == TDM_MODE)
+#define DATA_BUFFER_SIZE			(128000)
+#else
+#define DATA_BUFFER_SIZE			(131072)
+#endif
+#endif	// ACTIVE_IIO_CLIENT
+#endif
+
 /* Calculations for sampling frequency (used to define timeout in IIO client):
  * Note: Below calculations are based on default user configurations set in the
  *		  ad4170_xyz_config.h files. These configurations are used for data capturing.
@@ -301,6 +325,9 @@ extern struct no_os_gpio_desc *csb_gpio_desc;
 extern struct no_os_spi_init_param spi_init_params;
 extern struct no_os_irq_ctrl_desc *trigger_irq_desc;
 extern struct no_os_tdm_desc *ad4170_tdm_desc;
+#if (INTERFACE_MODE == TDM_MODE)
+extern struct stm32_tdm_stream_desc *ad4170_tdm_stream;
+#endif
 extern struct no_os_eeprom_desc *eeprom_desc;
 extern struct no_os_pwm_desc *tx_trigger_desc;
 int32_t init_system(void);
@@ -171,6 +171,26 @@ uint8_t* dma_buf_current_idx;
 
 /* STM32 SPI desc */
 struct stm32_spi_desc* sdesc;
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/* Size of each ping-pong DMA block (in bytes) */
+static uint32_t dma_block_size;
+
+/* Number of DMA blocks that fit into the IIO circular buffer */
+static uint32_t dma_num_blocks;
+
+/* Index of the IIO buffer block to be armed next on the idle DMA target */
+static uint32_t dma_next_block;
+
+/* Block receiving the conversions while the IIO buffer is full */
+static uint8_t *dma_scratch_block;
+
+/* Flags telling whether each DMA target (M0/M1) points to the scratch block */
+static bool dma_target_scratch[2];
+
+/* Count of DMA blocks dropped because the host had not read the IIO buffer */
+volatile uint32_t dma_overrun_count = 0;
+#endif
 #endif
 
 #if (ACTIVE_IIO_CLIENT == IIO_CLIENT_LOCAL)
@@ -229,9 +249,8 @@ void ad4170_dma_rx_half_cplt(SAI_HandleTypeDef *hsai)
 {
 
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
-	if ((tdm_read_started) && (data_capture_operation)) {
-		end_tdm_dma_to_cb_transfer(ad4170_tdm_desc, ad4170_iio_dev_data,
-					   TDM_DMA_READ_SIZE, BYTES_PER_SAMPLE);
+	if (data_capture_operation) {
+		stm32_tdm_stream_half_cplt(ad4170_tdm_stream);
 	}
 
 #endif // INTERFACE_MODE
@@ -249,25 +268,12 @@ void ad4170_dma_rx_cplt(SAI_HandleTypeDef *hsai)
 
 	if (data_capture_operation) {
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
-		/* TDM read is not invoked in-time to read the first channel in sequencer
-		 * due to higher execution time of MCU, which results into missing of
-		 * first sample. So ignoring the first (num_of_active_channels-1) samples
-		 * before filling up the buffer */
-		if (!tdm_read_started) {
-			/* Start TDM DMA read as the peripheral is disabled in Normal(Linear)
-			 * Buffer Mode upon buffer completion */
-			no_os_tdm_read(ad4170_tdm_desc, dma_buff, TDM_DMA_READ_SIZE << 1);
-			tdm_read_started = true;
-		} else {
-			end_tdm_dma_to_cb_transfer(ad4170_tdm_desc, ad4170_iio_dev_data,
-						   TDM_DMA_READ_SIZE, BYTES_PER_SAMPLE);
-			/* Start TDM DMA read as the peripheral is disabled in Normal(Linear)
-			 * Buffer Mode upon buffer completion */
-			no_os_tdm_read(ad4170_tdm_desc, dma_buff, TDM_DMA_READ_SIZE << 1);
-		}
+		/* Publish the completed slot (or end the initial discard of samples
+		 * and start the streaming TDM DMA read) */
+		stm32_tdm_stream_cplt(ad4170_tdm_stream);
 #else
 		if (!tdm_read_started) {
-			no_os_tdm_read(ad4170_tdm_desc, dma_buff,
+			no_os_tdm_read(ad4170_tdm_desc, ad4170_dma_buff,
 				       ad4170_iio_dev_data->buffer->samples * num_of_active_channels);
 			tdm_read_started = true;
 		} else {
@@ -309,10 +315,6 @@ void ad4170_spi_dma_rx_cplt_callback(DMA_HandleTypeDef* hdma)
 		iio_buf_current_idx += rxdma_ndtr / 2;
 	}
 
-#else // CONTUNUOUS_DATA_CAPTURE
-	no_os_cb_end_async_write(iio_dev_data_g->buffer->buf);
-	no_os_cb_prepare_async_write(iio_dev_data_g->buffer->buf,
-				     nb_of_samples_g, &buff_start_addr, &data_read);
 #endif // DATA_CAPTURE_MODE
 #endif // INTERFACE_MODE
 }
@@ -416,6 +418,11 @@ void stm32_abort_dma_transfer(void)
 	if (ret) {
 		return ret;
 	}
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	/* Revert the RX DMA stream from double buffer mode */
+	hdma_spi1_rx.Instance->CR &= ~(DMA_SxCR_DBM | DMA_SxCR_CT);
+#endif
 #endif
 }
 
@@ -438,6 +445,117 @@ void tim8_init(struct no_os_pwm_desc *pwm_desc)
 #endif
 }
 
+#if (INTERFACE_MODE == SPI_DMA_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/**
+ * @brief Switch the SPI RX DMA stream into double buffer (ping-pong) mode
+ *        targeting consecutive blocks of the IIO circular buffer
+ * @param cb[in] - IIO circular buffer receiving the ADC data
+ * @param block_size[in] - Size of each DMA block (in bytes)
+ * @param scratch[in] - Block receiving the conversions while the IIO buffer
+ *                      is full (at least block_size bytes)
+ * @return 0 in case of success, negative error code otherwise
+ * @note The RX DMA must have been started on the first block of the circular
+ *       buffer and no conversion must be in progress when this is called.
+ *       The circular buffer size must be an integral multiple of block size.
+ */
+int32_t stm32_spi_dma_double_buffer_config(struct no_os_circular_buffer *cb,
+		uint32_t block_size, uint8_t *scratch)
+{
+	DMA_Stream_TypeDef *stream = hdma_spi1_rx.Instance;
+
+	if (!cb || !block_size || !scratch || (cb->size % block_size)
+	    || (cb->size < (block_size << 1))) {
+		return -EINVAL;
+	}
+
+	dma_block_size = block_size;
+	dma_num_blocks = cb->size / block_size;
+	dma_next_block = 2 % dma_num_blocks;
+	dma_scratch_block = scratch;
+	dma_target_scratch[0] = false;
+	dma_target_scratch[1] = false;
+	dma_overrun_count = 0;
+
+	/* Stream must be disabled before switching to double buffer mode */
+	__HAL_DMA_DISABLE(&hdma_spi1_rx);
+	while (stream->CR & DMA_SxCR_EN) {
+	}
+
+	stream->NDTR = block_size;
+	stream->M0AR = (uint32_t)cb->buff;
+	stream->M1AR = (uint32_t)(cb->buff + block_size);
+
+	/* Only block (transfer) completion is of interest, completed blocks
+	 * are published to the IIO buffer in place without any copy */
+	stream->CR &= ~(DMA_SxCR_CT | DMA_SxCR_HTIE);
+	stream->CR |= DMA_SxCR_DBM | DMA_SxCR_TCIE;
+
+	__HAL_DMA_CLEAR_FLAG(&hdma_spi1_rx,
+			     __HAL_DMA_GET_TC_FLAG_INDEX(&hdma_spi1_rx));
+	__HAL_DMA_ENABLE(&hdma_spi1_rx);
+
+	return 0;
+}
+
+/**
+ * @brief Publish the DMA block just completed into the IIO circular buffer
+ *        and re-arm the idle DMA target with the next block
+ * @return None
+ * @note The circular DMA cannot be paused, so when the next IIO buffer block
+ *       still holds data the host has not read, the idle target is held off
+ *       on the scratch block instead. Conversions landing there are dropped
+ *       in whole blocks (scans stay aligned) and counted as overruns.
+ */
+static void ad4170_spi_dma_block_cplt(void)
+{
+	struct no_os_circular_buffer *cb = iio_dev_data_g->buffer->buf;
+	DMA_Stream_TypeDef *stream = hdma_spi1_rx.Instance;
+	uint64_t unread_bytes;
+	uint32_t needed_bytes;
+	uint32_t block_bytes;
+	uint8_t done_target;
+	void *block;
+
+	/* CT bit indicates the memory target currently in use by the DMA, the
+	 * other one has just been completed and is now idle */
+	done_target = (stream->CR & DMA_SxCR_CT) ? 0 : 1;
+
+	if (dma_target_scratch[done_target]) {
+		dma_overrun_count++;
+	} else {
+		/* IIO blocks complete in circular buffer order, so the write index
+		 * always points to the block just filled by DMA. Only advance it. */
+		no_os_cb_prepare_async_write(cb, dma_block_size, &block, &block_bytes);
+		no_os_cb_end_async_write(cb);
+	}
+
+	/* The next IIO block, along with the one being filled (unless that is the
+	 * scratch block), must be free of data the host has not read yet */
+	unread_bytes = ((uint64_t)cb->write.spin_count * cb->size + cb->write.idx) -
+		       ((uint64_t)cb->read.spin_count * cb->size + cb->read.idx);
+	needed_bytes = dma_target_scratch[!done_target] ? dma_block_size :
+		       (dma_block_size << 1);
+
+	if (unread_bytes + needed_bytes > cb->size) {
+		dma_target_scratch[done_target] = true;
+		if (done_target) {
+			stream->M1AR = (uint32_t)dma_scratch_block;
+		} else {
+			stream->M0AR = (uint32_t)dma_scratch_block;
+		}
+		return;
+	}
+
+	dma_target_scratch[done_target] = false;
+	if (done_target) {
+		stream->M1AR = (uint32_t)(cb->buff + (dma_next_block * dma_block_size));
+	} else {
+		stream->M0AR = (uint32_t)(cb->buff + (dma_next_block * dma_block_size));
+	}
+	dma_next_block = (dma_next_block + 1) % dma_num_blocks;
+}
+#endif
+
 #if (INTERFACE_MODE == SPI_DMA_MODE)
 void DMA2_Stream0_IRQHandler(void)
 {
@@ -446,8 +564,12 @@ void DMA2_Stream0_IRQHandler(void)
 		HAL_GPIO_WritePin(SYNC_INB_PORT_ID, 1 << SYNC_INB, GPIO_PIN_RESET);
 	}
 #else
-	memcpy(iio_buf_current_idx,
-	       dma_buf_current_idx, rxdma_ndtr);
+	if (__HAL_DMA_GET_FLAG(&hdma_spi1_rx,
+			       __HAL_DMA_GET_TC_FLAG_INDEX(&hdma_spi1_rx))) {
+		__HAL_DMA_CLEAR_FLAG(&hdma_spi1_rx,
+				     __HAL_DMA_GET_TC_FLAG_INDEX(&hdma_spi1_rx));
+		ad4170_spi_dma_block_cplt();
+	}
 #endif
 	HAL_DMA_IRQHandler(&hdma_spi1_rx);
 }
@@ -31,6 +31,7 @@
 #endif
 #if (INTERFACE_MODE == SPI_DMA_MODE)
 #include "stm32_pwm.h"
+#include "no_os_circular_buffer.h"
 #endif
 #if defined (TARGET_SDP_K1)
 #include "stm32_usb_uart.h"
@@ -236,6 +237,7 @@ extern struct stm32_usb_uart_init_param stm32_vcom_extra_init_params;
 extern bool data_capture_operation;
 extern struct iio_device_data *ad4170_iio_dev_data;
 extern volatile bool tdm_read_started;
+extern uint8_t *ad4170_dma_buff;
 extern volatile struct iio_device_data* iio_dev_data_g;
 extern uint32_t nb_of_samples_g;
 extern volatile uint32_t* buff_start_addr;
@@ -250,6 +252,11 @@ extern struct stm32_pwm_init_param stm32_tx_trigger_extra_init_params;
 extern struct no_os_dma_init_param ad4170_dma_init_param;
 extern struct stm32_dma_channel rxdma_channel;
 extern struct stm32_dma_channel txdma_channel;
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+extern volatile uint32_t dma_overrun_count;
+int32_t stm32_spi_dma_double_buffer_config(struct no_os_circular_buffer *cb,
+		uint32_t block_size, uint8_t *scratch);
+#endif
 #endif
 
 void tim8_config(void);
@@ -58,6 +58,24 @@ class ad4170_system_config(rx, context_manager):
                 f"Use one of: {self.reconfigure_system_avail}"
             )
     
+    @property
+    def reconfigure_type(self):
+        """Get the type of the last reconfiguration.
+        Options: none, incremental, full
+        """
+        return self._get_iio_dev_attr_str("reconfigure_type")
+
+    @property
+    def reconfigure_latency_us(self):
+        """Get the duration (in usec) of the last reconfiguration."""
+        return int(self._get_iio_dev_attr_str("reconfigure_latency_us"))
+
+    @property
+    def init_latency_us(self):
+        """Get the duration (in usec) of the last device and IIO
+        interface initialization, which a full restart re-runs."""
+        return int(self._get_iio_dev_attr_str("init_latency_us"))
+
     class _channel(attribute):
         """AD4170 Channel Configuration"""
 
@@ -27,6 +27,18 @@ def test_ad4170(serial_port, device_name, serial_com_type, target_reset):
     # Allow VCOM connection to establish upon power-up
     sleep(3)
 
+    # *********** Reconfiguration latency, before/after ***********
+    # The channel set change is applied in place; the initialization
+    # latency is what every reconfiguration cost with the full restart
+    dev = ad4170_system_config(uri_str, "system_config")
+    print("\nInit (full restart) latency: {0} us".format(dev.init_latency_us))
+    print("Reconfiguration ({0}) latency: {1} us".format(
+        dev.reconfigure_type, dev.reconfigure_latency_us))
+    assert dev.reconfigure_type == 'incremental', "Full restart on a channel set change!!"
+    assert dev.reconfigure_latency_us < dev.init_latency_us, "Reconfiguration slower than a restart!!"
+    del dev._ctx
+    del dev
+
     # Create a new instance of AD4170 class which creates
     # a device context as well for IIO interface
     ad4170_dev = ad4170(uri_str, iio_device[device_name])  
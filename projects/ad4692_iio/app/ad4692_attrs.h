@@ -119,6 +119,8 @@ static struct iio_attribute
 		AD4692_CHN_ATTR("channel_seq_length", SEQUENCE_LENGTH_ATTR_ID),
 		AD4692_CHN_ATTR("oscillator_frequency", OSC_FREQUENCY_ATTR_ID),
 		AD4692_CHN_AVAIL_ATTR("oscillator_frequency_available", OSC_FREQUENCY_ATTR_ID),
+		AD4692_CHN_ATTR("achieved_scan_rate", ACHIEVED_SCAN_RATE_ATTR_ID),
+		AD4692_CHN_ATTR("max_scan_rate", MAX_SCAN_RATE_ATTR_ID),
 
 		END_ATTRIBUTES_ARRAY
 	},
@@ -150,6 +152,8 @@ static struct iio_attribute
 	{
 		AD4692_CHN_ATTR("sampling_frequency", ADC_SAMPLING_FREQUENCY_ATTR_ID),
 		AD4692_CHN_ATTR("channel_seq_length", SEQUENCE_LENGTH_ATTR_ID),
+		AD4692_CHN_ATTR("achieved_scan_rate", ACHIEVED_SCAN_RATE_ATTR_ID),
+		AD4692_CHN_ATTR("max_scan_rate", MAX_SCAN_RATE_ATTR_ID),
 
 		END_ATTRIBUTES_ARRAY
 	},
@@ -181,6 +185,8 @@ static struct iio_attribute
 	{
 		AD4692_CHN_ATTR("sampling_frequency", ADC_SAMPLING_FREQUENCY_ATTR_ID),
 		AD4692_CHN_ATTR("acc_depth", ACC_COUNT_ATTR_ID),
+		AD4692_CHN_ATTR("achieved_scan_rate", ACHIEVED_SCAN_RATE_ATTR_ID),
+		AD4692_CHN_ATTR("max_scan_rate", MAX_SCAN_RATE_ATTR_ID),
 
 		END_ATTRIBUTES_ARRAY
 	},
@@ -215,6 +221,8 @@ static struct iio_attribute
 		AD4692_CHN_ATTR("acc_depth", ACC_COUNT_ATTR_ID),
 		AD4692_CHN_ATTR("oscillator_frequency", OSC_FREQUENCY_ATTR_ID),
 		AD4692_CHN_AVAIL_ATTR("oscillator_frequency_available", OSC_FREQUENCY_ATTR_ID),
+		AD4692_CHN_ATTR("achieved_scan_rate", ACHIEVED_SCAN_RATE_ATTR_ID),
+		AD4692_CHN_ATTR("max_scan_rate", MAX_SCAN_RATE_ATTR_ID),
 
 		END_ATTRIBUTES_ARRAY
 	},
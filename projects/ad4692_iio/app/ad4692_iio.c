@@ -29,6 +29,7 @@
 #include "ad4692.h"
 #include "version.h"
 #include "ad4692_attrs.h"
+#include "stm32_cycle_counter.h"
 
 /******** Forward declaration of functions ********/
 
@@ -42,6 +43,13 @@ static int ad4692_stop_data_capture(struct ad4692_desc *desc);
 
 static void ad4692_get_tx_command(uint8_t* local_tx_data);
 
+static void ad4692_scan_init(struct no_os_circular_buffer *buf,
+			     uint32_t nb_of_scans);
+
+static uint32_t ad4692_get_achieved_scan_rate(void);
+
+static uint32_t ad4692_get_max_scan_rate(void);
+
 /******************************************************************************/
 /************************ Macros/Constants ************************************/
 /******************************************************************************/
@@ -166,6 +174,12 @@ struct scan_type ad4692_iio_scan_type[NUM_OF_IIO_DEVICES][NO_OF_CHANNELS] = {
 /* Number of bytes per transaction for averaged data */
 #define AD4692_N_BYTES_CNV_CLOCK_16BIT	4
 
+/* Number of bytes of a register write (address and data byte) */
+#define AD4692_N_BYTES_REG_WRITE	3
+
+/* Max number of chained messages of a DATA_READY triggered scan */
+#define AD4692_SCAN_MAX_MSGS		3
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -301,6 +315,26 @@ static const char *ad4692_osc_frequencies[] = {
 	"1P25kHz"
 };
 
+/* Oscillator frequency values in Hz (same order as the oscillator frequencies) */
+static const uint32_t ad4692_osc_frequencies_hz[] = {
+	1000000,
+	500000,
+	400000,
+	250000,
+	200000,
+	166667,
+	133333,
+	125000,
+	100000,
+	50000,
+	25000,
+	12500,
+	10000,
+	5000,
+	2500,
+	1250
+};
+
 /* Restart IIO option */
 static const char *restart_iio_options[] = {
 	"Enable",
@@ -358,6 +392,17 @@ enum ad4692_readback_options ad4692_readback_option = AVERAGED_DATA;
 /* Restart IIO flag */
 static bool restart_iio_flag = false;
 
+/* Configuration the IIO interface was last initialized with. The modes and
+ * the prioritized channels shape the IIO context (attributes, channels and
+ * scan types), which is generated once by iio_init() */
+static struct {
+	uint8_t mode;
+	enum ad4692_sequencer_modes sequencer_mode;
+	enum ad4692_data_capture_modes data_capture_mode;
+	enum ad4692_readback_options readback_option;
+	uint8_t channel_priorities[NO_OF_CHANNELS];
+} ad4692_applied_config;
+
 /* Default oscillator frequency */
 static enum ad4692_int_osc_sel osc_freq_id = AD4692_OSC_1MHZ;
 
@@ -433,6 +478,33 @@ static uint8_t acc_data_buff[AD4692_N_BYTES_CNV_CLOCK_24BIT *
 /* Number of bytes per SPI transaction for non manual modes */
 static uint8_t n_bytes_per_transaction = AD4692_N_BYTES_CNV_CLOCK_16BIT;
 
+/* Channel readback commands of a DATA_READY triggered scan (built once per capture) */
+static uint8_t scan_tx_buff[AD4692_N_BYTES_CNV_CLOCK_24BIT *
+							  AD4692_MAX_CHANNELS] = { 0x0 };
+
+/* Accumulator state reset and SPI burst start, chained after the channel readback */
+static uint8_t scan_state_reset_cmd[AD4692_N_BYTES_REG_WRITE] = { 0x0 };
+static uint8_t scan_conv_start_cmd[AD4692_N_BYTES_REG_WRITE] = { 0x0 };
+
+/* Chained SPI messages of a DATA_READY triggered scan */
+static struct no_os_spi_msg scan_msgs[AD4692_SCAN_MAX_MSGS];
+static uint8_t nb_scan_msgs;
+
+/* Circular buffer receiving the scans in burst data capture */
+static struct no_os_circular_buffer *scan_buf;
+
+/* Scans requested in burst data capture and scans read since the capture start */
+static uint32_t nb_scans_requested;
+static volatile uint32_t nb_scans;
+
+/* Error of the DATA_READY triggered scan readback */
+static volatile int32_t scan_err;
+
+/* DATA_READY edge time of the last scan and time elapsed since the first one
+ * (in cycle counter ticks) */
+static volatile uint32_t scan_last_ticks;
+static volatile uint64_t scan_elapsed_ticks;
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -627,6 +699,12 @@ int ad4692_iio_attr_get(void *device,
 	case READBACK_OPTION_ATTR_ID:
 		return sprintf(buf, "%s", readback_modes[ad4692_readback_option]);
 
+	case ACHIEVED_SCAN_RATE_ATTR_ID:
+		return sprintf(buf, "%lu", ad4692_get_achieved_scan_rate());
+
+	case MAX_SCAN_RATE_ATTR_ID:
+		return sprintf(buf, "%lu", ad4692_get_max_scan_rate());
+
 	case ACC_COUNT_ATTR_ID:
 		/* In Standard Sequencer Mode, the ACC_DEPTH_IN0 register sets
 		 * the accumulator depth for all 16 channels. For Advanced Sequencer Mode,
@@ -1440,6 +1518,11 @@ static int32_t ad4692_iio_prepare_transfer(void* dev_instance, uint32_t ch_mask)
 		channel_mask = mask;
 	}
 
+	if (ad4692_drdy_scan_enabled()) {
+		/* Continuous capture scans are pushed from the trigger handler */
+		ad4692_scan_init(NULL, 0);
+	}
+
 	if ((ad4692_data_capture_mode == CONTINUOUS)
 	    || (ad4692_interface_mode == SPI_DMA)) {
 		/* Start ADC Data capture */
@@ -1558,6 +1641,223 @@ static int32_t ad4692_iio_end_transfer(void *dev)
 	return 0;
 }
 
+/**
+ * @brief Check if the sequencer scans are read from the DATA_READY interrupt
+ * @return true if the scans are DATA_READY triggered, false otherwise
+ */
+bool ad4692_drdy_scan_enabled(void)
+{
+#if defined(DRDY_TRIGGERED_SCAN)
+	return (ad4692_interface_mode == SPI_INTR)
+	       && (ad4692_init_params.mode != AD4692_MANUAL_MODE);
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief Build the chained SPI messages of the DATA_READY triggered scans
+ * @param buf[in] - Circular buffer receiving the scans (burst data capture only)
+ * @param nb_of_scans[in] - Number of scans to be read (burst data capture only)
+ * @return None
+ * @note The channel readback is followed by the accumulator state reset so that
+ * the next accumulation starts as soon as the data is read out. In SPI burst mode,
+ * the next burst is started by the last message, so the bursts are paced by the
+ * conversions and the scan readback only.
+ */
+static void ad4692_scan_init(struct no_os_circular_buffer *buf,
+			     uint32_t nb_of_scans)
+{
+	ad4692_get_tx_command(scan_tx_buff);
+
+	scan_msgs[0].tx_buff = scan_tx_buff;
+	scan_msgs[0].rx_buff = acc_data_buff;
+	scan_msgs[0].bytes_number = num_of_active_channels * n_bytes_per_transaction;
+	scan_msgs[0].cs_change = CS_CHANGE;
+
+	scan_state_reset_cmd[0] = AD4692_MSB_MASK(AD4692_STATE_RESET_REG);
+	scan_state_reset_cmd[1] = AD4692_LSB_MASK(AD4692_STATE_RESET_REG);
+	scan_state_reset_cmd[2] = AD4692_STATE_RESET_ALL;
+
+	scan_msgs[1].tx_buff = scan_state_reset_cmd;
+	scan_msgs[1].rx_buff = NULL;
+	scan_msgs[1].bytes_number = AD4692_N_BYTES_REG_WRITE;
+	scan_msgs[1].cs_change = CS_CHANGE;
+	nb_scan_msgs = 2;
+
+	if (ad4692_init_params.mode == AD4692_SPI_BURST) {
+		scan_conv_start_cmd[0] = AD4692_MSB_MASK(AD4692_OSC_EN_REG);
+		scan_conv_start_cmd[1] = AD4692_LSB_MASK(AD4692_OSC_EN_REG);
+		scan_conv_start_cmd[2] = AD4692_CONV_START_MASK;
+
+		scan_msgs[2].tx_buff = scan_conv_start_cmd;
+		scan_msgs[2].rx_buff = NULL;
+		scan_msgs[2].bytes_number = AD4692_N_BYTES_REG_WRITE;
+		scan_msgs[2].cs_change = CS_CHANGE;
+		nb_scan_msgs = 3;
+	}
+
+	scan_buf = buf;
+	nb_scans_requested = nb_of_scans;
+	nb_scans = 0;
+	scan_err = 0;
+	scan_elapsed_ticks = 0;
+}
+
+/**
+ * @brief Read a sequencer scan and push it into the IIO buffer
+ * @param buf[in] - Circular buffer receiving the scan
+ * @return 0 in case of success, negative error code otherwise
+ * @note Called on the DATA_READY falling edge. The scan is read and the
+ * accumulators are reset in a single SPI transaction.
+ */
+static int32_t ad4692_read_scan(struct no_os_circular_buffer *buf)
+{
+	uint32_t ticks = stm32_cycle_counter_get();
+	uint8_t bytes_offset = 2; // Offset to start reading the Rx word from SPI Data
+	uint32_t data_read;
+	uint8_t ch;
+	uint8_t id;
+	int32_t ret;
+
+	ret = no_os_spi_transfer(ad4692_dev->comm_desc, scan_msgs, nb_scan_msgs);
+	if (ret) {
+		return ret;
+	}
+
+	if (nb_scans) {
+		scan_elapsed_ticks += (uint32_t)(ticks - scan_last_ticks);
+	}
+	scan_last_ticks = ticks;
+	nb_scans++;
+
+	for (ch = 0; ch < num_of_active_channels; ch++) {
+		id = (ch * n_bytes_per_transaction) + bytes_offset;
+		if (ad4692_readback_option == ACCUMULATOR_DATA) {
+			data_read = no_os_get_unaligned_be24(&acc_data_buff[id]);
+		} else {
+			data_read = no_os_get_unaligned_be16(&acc_data_buff[id]);
+		}
+
+		ret = no_os_cb_write(buf, &data_read, n_data_bytes);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Wait for the DATA_READY triggered scans of a burst data capture
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int32_t ad4692_wait_for_scans(void)
+{
+	uint32_t timeout = BUF_READ_TIMEOUT;
+	uint32_t scans_read = 0;
+
+	while ((nb_scans < nb_scans_requested) && !scan_err) {
+		if (nb_scans != scans_read) {
+			/* The timeout applies to each scan */
+			scans_read = nb_scans;
+			timeout = BUF_READ_TIMEOUT;
+		} else if (--timeout == 0) {
+			return -ETIMEDOUT;
+		}
+	}
+
+	return scan_err;
+}
+
+/**
+ * @brief Get the scan rate achieved by the last (or ongoing) data capture
+ * @return Scan rate in scans per second (0 if less than two scans were read)
+ * @note The rate is timed from the DATA_READY edges of the scans read.
+ */
+static uint32_t ad4692_get_achieved_scan_rate(void)
+{
+	if ((nb_scans < 2) || !scan_elapsed_ticks) {
+		return 0;
+	}
+
+	return ((uint64_t)(nb_scans - 1) * stm32_cycle_counter_freq()) /
+	       scan_elapsed_ticks;
+}
+
+/**
+ * @brief Get the scan rate the conversion clock allows for the current configuration
+ * @return Scan rate in scans per second (0 until the channels of the standard
+ * sequencer are enabled)
+ * @note A scan ends (DATA_READY) once every channel of the sequence has accumulated
+ * its count limit + 1 conversions. A channel gets one conversion per pass of the
+ * sequence it appears in (once in standard sequencer, one or more slots in advanced
+ * sequencer). The conversions are clocked by the internal oscillator in the burst
+ * modes and by the CNV PWM in CNV clock mode, a CNV burst being also paced by the
+ * CNV PWM.
+ */
+static uint32_t ad4692_get_max_scan_rate(void)
+{
+	uint32_t conversions_per_scan;
+	uint32_t max_passes = 1;
+	uint32_t seq_length;
+	uint32_t occurrences;
+	uint32_t passes;
+	uint32_t osc_rate;
+	uint8_t ch_id;
+	uint8_t slot;
+
+	if (ad4692_sequencer_mode == STANDARD_SEQUENCER) {
+		seq_length = num_of_active_channels;
+		max_passes = ad4692_acc_count[0] + 1;
+	} else {
+		seq_length = num_of_as_slots;
+		for (ch_id = 0; ch_id < NO_OF_CHANNELS; ch_id++) {
+			occurrences = 0;
+			for (slot = 0; slot < num_of_as_slots; slot++) {
+				if (channel_sequence[slot] == ch_id) {
+					occurrences++;
+				}
+			}
+
+			if (!occurrences) {
+				continue;
+			}
+
+			passes = NO_OS_DIV_ROUND_UP(ad4692_acc_count[ch_id] + 1, occurrences);
+			if (passes > max_passes) {
+				max_passes = passes;
+			}
+		}
+	}
+
+	if (!seq_length) {
+		return 0;
+	}
+
+	conversions_per_scan = seq_length * max_passes;
+
+	switch (ad4692_init_params.mode) {
+	case AD4692_CNV_CLOCK:
+		return ad4692_sampling_frequency / conversions_per_scan;
+
+	case AD4692_CNV_BURST:
+		osc_rate = ad4692_osc_frequencies_hz[osc_freq_id] / conversions_per_scan;
+		return no_os_min(ad4692_sampling_frequency, osc_rate);
+
+	case AD4692_SPI_BURST:
+		osc_rate = ad4692_osc_frequencies_hz[osc_freq_id] / conversions_per_scan;
+		if (ad4692_drdy_scan_enabled()) {
+			return osc_rate;
+		}
+
+		return no_os_min(ad4692_sampling_frequency, osc_rate);
+
+	default:
+		return ad4692_sampling_frequency / seq_length;
+	}
+}
+
 /**
  * @brief Push data into IIO buffer when trigger handler IRQ is invoked
  * @param iio_dev_data[in] - IIO device data instance
@@ -1592,6 +1892,8 @@ int32_t ad4692_trigger_handler(struct iio_device_data *iio_dev_data)
 		if (ret) {
 			return ret;
 		}
+	} else if (ad4692_drdy_scan_enabled()) {
+		return ad4692_read_scan(iio_dev_data->buffer->buf);
 	} else {
 		/* Populate the Tx command */
 		ad4692_get_tx_command(acc_data_buff);
@@ -1668,9 +1970,17 @@ int32_t ad4692_trigger_handler(struct iio_device_data *iio_dev_data)
  * @return none
  * @note Callback registered for the the DRDY interrupt to indicate
  * end of conversion in case of burst data capturing with SPI operation.
+ * With DATA_READY triggered scans, the scan is read from the callback.
  */
 void ad4692_data_capture_callback(void *ctx)
 {
+	if (ad4692_drdy_scan_enabled()) {
+		if (scan_buf && (nb_scans < nb_scans_requested) && !scan_err) {
+			scan_err = ad4692_read_scan(scan_buf);
+		}
+		return;
+	}
+
 	ad4692_conversion_flag = true;
 }
 
@@ -1695,22 +2005,22 @@ void ad4692_get_tx_command(uint8_t* local_tx_data)
 		index = 0;
 		for (ch_id = 0; ch_id < num_of_active_channels; ch_id++) {
 			if (ad4692_readback_option == ACCUMULATOR_DATA) {
-				acc_data_buff[index++] = AD4692_RW_ADDR_MASK | AD4692_MSB_MASK(
+				local_tx_data[index++] = AD4692_RW_ADDR_MASK | AD4692_MSB_MASK(
 								 AD4692_ACC_IN_REG(
 										 ad4692_active_channels[ch_id]));
-				acc_data_buff[index++] = AD4692_LSB_MASK(AD4692_ACC_IN_REG(
+				local_tx_data[index++] = AD4692_LSB_MASK(AD4692_ACC_IN_REG(
 								 ad4692_active_channels[ch_id]));
-				acc_data_buff[index++] = 0x0;
-				acc_data_buff[index++] = 0x0;
-				acc_data_buff[index++] = 0x0;
+				local_tx_data[index++] = 0x0;
+				local_tx_data[index++] = 0x0;
+				local_tx_data[index++] = 0x0;
 			} else {
-				acc_data_buff[index++] = AD4692_RW_ADDR_MASK | AD4692_MSB_MASK(
+				local_tx_data[index++] = AD4692_RW_ADDR_MASK | AD4692_MSB_MASK(
 								 AD4692_AVG_IN_REG(
 										 ad4692_active_channels[ch_id]));
-				acc_data_buff[index++] = AD4692_LSB_MASK(AD4692_AVG_IN_REG(
+				local_tx_data[index++] = AD4692_LSB_MASK(AD4692_AVG_IN_REG(
 								 ad4692_active_channels[ch_id]));
-				acc_data_buff[index++] = 0x0;
-				acc_data_buff[index++] = 0x0;
+				local_tx_data[index++] = 0x0;
+				local_tx_data[index++] = 0x0;
 			}
 		}
 	}
@@ -1911,6 +2221,7 @@ static int32_t ad4692_iio_submit_samples(struct iio_device_data *iio_dev_data)
 	uint8_t eoc_status;
 	uint8_t id = 0;
 	uint8_t bytes_offset = 2; // Offset to start reading the Rx word from SPI Data
+	int32_t scan_ret = 0;
 
 	if (!iio_dev_data) {
 		return -EINVAL;
@@ -1926,6 +2237,11 @@ static int32_t ad4692_iio_submit_samples(struct iio_device_data *iio_dev_data)
 	}
 
 	if (ad4692_interface_mode == SPI_INTR) {
+		if (ad4692_drdy_scan_enabled()) {
+			ad4692_scan_init(iio_dev_data->buffer->buf,
+					 nb_of_samples / num_of_active_channels);
+		}
+
 		/* Start ADC data capture */
 		ret = ad4692_start_data_capture(ad4692_dev);
 		if (ret) {
@@ -1952,110 +2268,115 @@ static int32_t ad4692_iio_submit_samples(struct iio_device_data *iio_dev_data)
 			return ret;
 		}
 
-		while (sample_index < nb_of_samples) {
-			/* Build the Tx Command */
-			ad4692_get_tx_command(acc_data_buff);
+		if (ad4692_drdy_scan_enabled()) {
+			/* The scans are read from the DATA_READY interrupt */
+			scan_ret = ad4692_wait_for_scans();
+		} else {
+			while (sample_index < nb_of_samples) {
+				/* Build the Tx Command */
+				ad4692_get_tx_command(acc_data_buff);
 
-			if (ad4692_init_params.mode == AD4692_SPI_BURST) {
-				/* Write to Convert Start register to trigger the next burst of conversion */
-				ret = ad4692_reg_write(ad4692_dev,
-						       AD4692_OSC_EN_REG,
-						       AD4692_CONV_START_MASK);
-				if (ret) {
-					return ret;
+				if (ad4692_init_params.mode == AD4692_SPI_BURST) {
+					/* Write to Convert Start register to trigger the next burst of conversion */
+					ret = ad4692_reg_write(ad4692_dev,
+							       AD4692_OSC_EN_REG,
+							       AD4692_CONV_START_MASK);
+					if (ret) {
+						return ret;
+					}
 				}
-			}
 
-			/* Check for status of conversion flag */
-			while (!ad4692_conversion_flag && timeout > 0) {
-				timeout--;
-			}
+				/* Check for status of conversion flag */
+				while (!ad4692_conversion_flag && timeout > 0) {
+					timeout--;
+				}
 
-			if (timeout == 0) {
-				return -ETIMEDOUT;
-			}
-			timeout = BUF_READ_TIMEOUT;
+				if (timeout == 0) {
+					return -ETIMEDOUT;
+				}
+				timeout = BUF_READ_TIMEOUT;
 
-			ad4692_conversion_flag = false;
+				ad4692_conversion_flag = false;
 
-			if (ad4692_init_params.mode == AD4692_MANUAL_MODE) {
-				if (chan_id >= num_of_active_channels) {
-					chan_id = 0;
-				}
+				if (ad4692_init_params.mode == AD4692_MANUAL_MODE) {
+					if (chan_id >= num_of_active_channels) {
+						chan_id = 0;
+					}
 
-				data_buff[0] = AD4692_IN_COMMAND(ad4692_active_channels[chan_id++]);
-				data_buff[1] = 0x0;
+					data_buff[0] = AD4692_IN_COMMAND(ad4692_active_channels[chan_id++]);
+					data_buff[1] = 0x0;
 
-				ret = no_os_spi_transfer(ad4692_dev->comm_desc, &ad4692_spi_msg_manual_mode, 1);
-				if (ret) {
-					return ret;
-				}
+					ret = no_os_spi_transfer(ad4692_dev->comm_desc, &ad4692_spi_msg_manual_mode, 1);
+					if (ret) {
+						return ret;
+					}
 
-				ret = no_os_cb_write(iio_dev_data->buffer->buf,
-						     ad4692_spi_msg_manual_mode.rx_buff,
-						     n_data_bytes);
-				if (ret) {
-					return ret;
-				}
+					ret = no_os_cb_write(iio_dev_data->buffer->buf,
+							     ad4692_spi_msg_manual_mode.rx_buff,
+							     n_data_bytes);
+					if (ret) {
+						return ret;
+					}
 
-			} else {
-				if (ad4692_init_params.mode == AD4692_SPI_BURST) {
-					/* Poll for BSY Low */
-					do {
-						ret = no_os_gpio_get_value(ad4692_dev->gpio0_desc, &eoc_status);
-						if (ret) {
-							return ret;
+				} else {
+					if (ad4692_init_params.mode == AD4692_SPI_BURST) {
+						/* Poll for BSY Low */
+						do {
+							ret = no_os_gpio_get_value(ad4692_dev->gpio0_desc, &eoc_status);
+							if (ret) {
+								return ret;
+							}
+						} while ((eoc_status != NO_OS_GPIO_LOW) && (timeout-- > 0));
+
+						if (timeout == 0) {
+							return -ETIMEDOUT;
 						}
-					} while ((eoc_status != NO_OS_GPIO_LOW) && (timeout-- > 0));
+						timeout = BUF_READ_TIMEOUT;
+					}
 
-					if (timeout == 0) {
-						return -ETIMEDOUT;
+					/* Pull CS low, read the data of all channels and Pull back CS High */
+					ret = no_os_gpio_set_value(csb_gpio_desc, NO_OS_GPIO_LOW);
+					if (ret) {
+						return ret;
 					}
-					timeout = BUF_READ_TIMEOUT;
-				}
 
-				/* Pull CS low, read the data of all channels and Pull back CS High */
-				ret = no_os_gpio_set_value(csb_gpio_desc, NO_OS_GPIO_LOW);
-				if (ret) {
-					return ret;
-				}
+					ret = no_os_spi_write_and_read(ad4692_dev->comm_desc, acc_data_buff,
+								       num_of_active_channels * n_bytes_per_transaction);
+					if (ret) {
+						return ret;
+					}
 
-				ret = no_os_spi_write_and_read(ad4692_dev->comm_desc, acc_data_buff,
-							       num_of_active_channels * n_bytes_per_transaction);
-				if (ret) {
-					return ret;
-				}
+					ret = no_os_gpio_set_value(csb_gpio_desc, NO_OS_GPIO_HIGH);
+					if (ret) {
+						return ret;
+					}
 
-				ret = no_os_gpio_set_value(csb_gpio_desc, NO_OS_GPIO_HIGH);
-				if (ret) {
-					return ret;
-				}
+					for (chan_id = 0; chan_id < num_of_active_channels; chan_id++) {
+						id = (chan_id * n_bytes_per_transaction) + bytes_offset;
+						if (ad4692_readback_option == ACCUMULATOR_DATA) {
+							data_read = no_os_get_unaligned_be24(&acc_data_buff[id]);
+						} else {
+							data_read = no_os_get_unaligned_be16(&acc_data_buff[id]);
+						}
 
-				for (chan_id = 0; chan_id < num_of_active_channels; chan_id++) {
-					id = (chan_id * n_bytes_per_transaction) + bytes_offset;
-					if (ad4692_readback_option == ACCUMULATOR_DATA) {
-						data_read = no_os_get_unaligned_be24(&acc_data_buff[id]);
-					} else {
-						data_read = no_os_get_unaligned_be16(&acc_data_buff[id]);
+						ret = no_os_cb_write(iio_dev_data->buffer->buf,
+								     &data_read,
+								     n_data_bytes);
+						if (ret) {
+							return ret;
+						}
 					}
 
-					ret = no_os_cb_write(iio_dev_data->buffer->buf,
-							     &data_read,
-							     n_data_bytes);
+					/* Reset the state of accumulator to start a new burst of conversion*/
+					ret = ad4692_reg_write(ad4692_dev,
+							       AD4692_STATE_RESET_REG,
+							       AD4692_STATE_RESET_ALL);
 					if (ret) {
 						return ret;
 					}
 				}
-
-				/* Reset the state of accumulator to start a new burst of conversion*/
-				ret = ad4692_reg_write(ad4692_dev,
-						       AD4692_STATE_RESET_REG,
-						       AD4692_STATE_RESET_ALL);
-				if (ret) {
-					return ret;
-				}
+				sample_index++;
 			}
-			sample_index++;
 		}
 
 		/* Stop timer */
@@ -2072,6 +2393,10 @@ static int32_t ad4692_iio_submit_samples(struct iio_device_data *iio_dev_data)
 		if (ret) {
 			return ret;
 		}
+
+		if (scan_ret) {
+			return scan_ret;
+		}
 	} else { // SPI_DMA
 		ret = ad4692_read_data_spi_dma(nb_of_samples, iio_dev_data);
 		if (ret) {
@@ -2284,7 +2609,8 @@ static int ad4692_iio_trigger_param_init(struct iio_hw_trig **desc)
 		return -EINVAL;
 	}
 
-	if (ad4692_init_params.mode == AD4692_SPI_BURST) {
+	if ((ad4692_init_params.mode == AD4692_SPI_BURST)
+	    && !ad4692_drdy_scan_enabled()) {
 		ad4692_hw_trig_init_params.irq_id = SPI_BURST_PWM_ID;
 	} else {
 		ad4692_hw_trig_init_params.irq_id = TRIGGER_INT_ID;
@@ -2526,6 +2852,9 @@ int32_t iio_app_initialize(void)
 		return ret;
 	}
 
+	/* Cycle counter timing the DATA_READY triggered scans */
+	stm32_cycle_counter_enable();
+
 	pwm_init_convst.period_ns = CONV_TRIGGER_PERIOD_NSEC(ad4692_sampling_frequency);
 	pwm_spi_burst_init.period_ns = CONV_TRIGGER_PERIOD_NSEC(
 					       ad4692_sampling_frequency);
@@ -2639,6 +2968,13 @@ iio_init:
 		}
 	}
 
+	ad4692_applied_config.mode = ad4692_init_params.mode;
+	ad4692_applied_config.sequencer_mode = ad4692_sequencer_mode;
+	ad4692_applied_config.data_capture_mode = ad4692_data_capture_mode;
+	ad4692_applied_config.readback_option = ad4692_readback_option;
+	memcpy(ad4692_applied_config.channel_priorities, channel_priorities,
+	       sizeof(channel_priorities));
+
 	return 0;
 
 err_iio_init:
@@ -2646,6 +2982,55 @@ err_iio_init:
 	return ret;
 }
 
+/**
+ * @brief	Apply the staged system configuration to the running device
+ * @return	0 in case of success, negative error code otherwise
+ * @details	The configuration staged through the system_config attributes is
+ *			compared with the one the IIO interface was initialized with.
+ *			A new ADC mode, sequencer mode, data capture mode or readback
+ *			option, or a new set of prioritized channels, changes the IIO
+ *			context and needs a full restart (-EAGAIN). New priorities of the
+ *			same channels only reprogram the advanced sequencer slots, and
+ *			the channel priorities are not used by the standard sequencer.
+ */
+static int32_t iio_app_apply_config(void)
+{
+	uint8_t ch;
+
+	if (!ad4692_dev) {
+		/* No device to reconfigure (HW mezzanine not detected) */
+		return -ENODEV;
+	}
+
+	if ((ad4692_init_params.mode != ad4692_applied_config.mode)
+	    || (ad4692_sequencer_mode != ad4692_applied_config.sequencer_mode)
+	    || (ad4692_data_capture_mode != ad4692_applied_config.data_capture_mode)
+	    || (ad4692_readback_option != ad4692_applied_config.readback_option)) {
+		return -EAGAIN;
+	}
+
+	if ((ad4692_sequencer_mode == STANDARD_SEQUENCER)
+	    || !memcmp(channel_priorities, ad4692_applied_config.channel_priorities,
+		       sizeof(channel_priorities))) {
+		return 0;
+	}
+
+	for (ch = 0; ch < NO_OF_CHANNELS; ch++) {
+		if (!channel_priorities[ch] != !ad4692_applied_config.channel_priorities[ch]) {
+			/* The IIO channels are the prioritized ones */
+			return -EAGAIN;
+		}
+	}
+
+	memcpy(ad4692_applied_config.channel_priorities, channel_priorities,
+	       sizeof(channel_priorities));
+
+	return ad4692_configure_channel_priorities(channel_priorities,
+			channel_sequence,
+			&num_of_as_slots,
+			ad4692_acc_count);
+}
+
 /**
  * @brief 	Run the ad4692 IIO event handler
  * @return	None
@@ -2653,13 +3038,15 @@ err_iio_init:
 void iio_app_event_handler(void)
 {
 	if (restart_iio_flag) {
-
-		iio_app_remove();
-
 		/* Reset the restart_iio flag */
 		restart_iio_flag = false;
 
-		iio_app_initialize();
+		/* Apply the configuration changes in place, falling back to a full
+		 * restart of the device and the IIO interface if needed */
+		if (iio_app_apply_config()) {
+			iio_app_remove();
+			iio_app_initialize();
+		}
 	}
 
 	iio_step(ad4692_iio_desc);
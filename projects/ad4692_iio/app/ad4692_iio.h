@@ -59,6 +59,8 @@ enum ad4692_attribute_ids {
 	OSC_FREQUENCY_ATTR_ID,
 	SEQUENCE_LENGTH_ATTR_ID,
 	READBACK_OPTION_ATTR_ID,
+	ACHIEVED_SCAN_RATE_ATTR_ID,
+	MAX_SCAN_RATE_ATTR_ID,
 	RESTART_IIO_ATTR_ID,
 	NUM_OF_DEV_ATTR = RESTART_IIO_ATTR_ID - NUM_OF_CHN_ATTR
 };
@@ -75,6 +77,7 @@ int ad4692_iio_attr_set(void *device, char *buf, uint32_t len,
 			const struct iio_ch_info *channel, intptr_t priv);
 int ad4692_iio_attr_get(void *device, char *buf, uint32_t len,
 			const struct iio_ch_info *channel, intptr_t priv);
+bool ad4692_drdy_scan_enabled(void);
 
 extern struct ad4692_desc *ad4692_dev;
 extern uint32_t ad4692_sampling_frequency;
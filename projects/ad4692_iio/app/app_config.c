@@ -303,8 +303,11 @@ int32_t init_interrupt(void)
 	int32_t ret;
 
 	if (ad4692_interface_mode == SPI_INTR) {
-		/* Configure the IRQ parameters according to the chosen mode */
-		if (ad4692_init_params.mode == AD4692_SPI_BURST) {
+		/* Configure the IRQ parameters according to the chosen mode.
+		 * DATA_READY triggered scans restart the SPI bursts themselves,
+		 * so the SPI burst PWM is not used as interrupt source */
+		if ((ad4692_init_params.mode == AD4692_SPI_BURST)
+		    && !ad4692_drdy_scan_enabled()) {
 			trigger_gpio_irq_params.irq_ctrl_id = SPI_BURST_PWM_ID;
 			stm32_gpio_irq_extra_init_params.port_nb = SPI_BURST_PWM_PORT;
 
@@ -94,6 +94,12 @@
 /* Enable/Disable the use of SDRAM for ADC data capture buffer */
 #define USE_SDRAM  	// Uncomment to use SDRAM as data buffer
 
+/* Read the sequencer scans of the non manual modes from the DATA_READY interrupt,
+ * in one chained SPI transaction per scan (channel readback, accumulator state
+ * reset and next SPI burst start). Comment to poll the end of conversion and
+ * read the scans from the data capture loop */
+#define DRDY_TRIGGERED_SCAN
+
 /* Bytes per sample
  * Note: This is applicable to 16 bit data read in manual mode */
 #define	BYTES_PER_SAMPLE	sizeof(uint16_t)
@@ -29,6 +29,7 @@
 #include "no_os_pwm.h"
 #include "no_os_print_log.h"
 #include "iio_trigger.h"
+#include "sdram_ring.h"
 
 /******** Forward declaration of getter/setter functions ********/
 static int ad469x_iio_attr_get(void *device,
@@ -173,6 +174,11 @@ static volatile bool buf_size_updated = false;
 /* EVB HW validation status */
 static bool hw_mezzanine_is_valid;
 
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/* Streaming ring over the data buffer for continuous data capture */
+struct sdram_ring_desc *ad469x_sdram_ring;
+#endif
+
 /* AD469X attribute unique IDs */
 enum ad469x_attribute_ids {
 	ADC_RAW,
@@ -184,6 +190,10 @@ enum ad469x_attribute_ids {
 	ADC_AIN_HIGH_Z,
 
 	ADC_SAMPLING_FREQUENCY,
+	ADC_RING_LEVEL,
+	ADC_RING_HIGH_WATER_MARK,
+	ADC_RING_OVERRUNS,
+	ADC_RING_DROPPED_BYTES,
 };
 
 /* IIOD channels configurations */
@@ -220,6 +230,12 @@ static struct iio_attribute ad469x_iio_global_attributes[] = {
 	AD469X_CHN_ATTR("sampling_frequency", ADC_SAMPLING_FREQUENCY),
 	AD469X_CHN_ATTR("reference_sel", ADC_REFERENCE_SEL),
 	AD469X_CHN_AVAIL_ATTR("reference_sel_available", ADC_REFERENCE_SEL),
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	AD469X_CHN_ATTR("ring_level", ADC_RING_LEVEL),
+	AD469X_CHN_ATTR("ring_high_water_mark", ADC_RING_HIGH_WATER_MARK),
+	AD469X_CHN_ATTR("ring_overruns", ADC_RING_OVERRUNS),
+	AD469X_CHN_ATTR("ring_dropped_bytes", ADC_RING_DROPPED_BYTES),
+#endif
 	END_ATTRIBUTES_ARRAY,
 };
 
@@ -397,6 +413,9 @@ static int ad469x_iio_attr_get(void *device,
 	uint8_t gain_corr_msb;
 	float scale_value;
 	enum ad469x_ain_high_z ain_high_z;
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	struct sdram_ring_stats ring_stats;
+#endif
 
 	if (buf == NULL) {
 		return -ENOMEM;
@@ -490,6 +509,40 @@ static int ad469x_iio_attr_get(void *device,
 
 		return sprintf(buf, "%s", ad469x_ain_high_z[ain_high_z]);
 
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	case ADC_RING_LEVEL:
+		ret = sdram_ring_get_stats(ad469x_sdram_ring, &ring_stats);
+		if (ret) {
+			return ret;
+		}
+
+		return sprintf(buf, "%lu", (unsigned long)ring_stats.level);
+
+	case ADC_RING_HIGH_WATER_MARK:
+		ret = sdram_ring_get_stats(ad469x_sdram_ring, &ring_stats);
+		if (ret) {
+			return ret;
+		}
+
+		return sprintf(buf, "%lu", (unsigned long)ring_stats.high_water_mark);
+
+	case ADC_RING_OVERRUNS:
+		ret = sdram_ring_get_stats(ad469x_sdram_ring, &ring_stats);
+		if (ret) {
+			return ret;
+		}
+
+		return sprintf(buf, "%lu", (unsigned long)ring_stats.overruns);
+
+	case ADC_RING_DROPPED_BYTES:
+		ret = sdram_ring_get_stats(ad469x_sdram_ring, &ring_stats);
+		if (ret) {
+			return ret;
+		}
+
+		return sprintf(buf, "%lu", (unsigned long)ring_stats.dropped_bytes);
+#endif
+
 	default:
 		return -EINVAL;
 	}
@@ -527,6 +580,12 @@ static int ad469x_iio_attr_set(void *device,
 	case ADC_RAW:
 	case ADC_OFFSET:
 	case ADC_SCALE:
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	case ADC_RING_LEVEL:
+	case ADC_RING_HIGH_WATER_MARK:
+	case ADC_RING_OVERRUNS:
+	case ADC_RING_DROPPED_BYTES:
+#endif
 		break;
 	case ADC_OFFSET_CORRECTION:
 		ad469x_offset_correction = no_os_str_to_uint32(buf);
@@ -987,10 +1046,16 @@ int32_t ad469x_trigger_handler(struct iio_device_data *iio_dev_data)
 
 	if (start_data_capture) {
 		if (!buf_size_updated) {
-			/* Update total buffer size according to bytes per scan for proper
-			 * alignment of multi-channel IIO buffer data */
-			iio_dev_data->buffer->buf->size = ((uint32_t)(DATA_BUFFER_SIZE /
-							   iio_dev_data->buffer->bytes_per_scan)) * iio_dev_data->buffer->bytes_per_scan;
+			/* Stream through the whole data buffer, with the total buffer size
+			 * aligned to bytes per scan for proper alignment of multi-channel
+			 * IIO buffer data */
+			ret = sdram_ring_start(ad469x_sdram_ring,
+					       iio_dev_data->buffer->buf,
+					       DATA_BUFFER_SIZE,
+					       iio_dev_data->buffer->bytes_per_scan);
+			if (ret) {
+				return ret;
+			}
 			buf_size_updated = true;
 		}
 
@@ -1003,9 +1068,7 @@ int32_t ad469x_trigger_handler(struct iio_device_data *iio_dev_data)
 
 		no_os_swap(adc_data[0], adc_data[1]);
 
-		return no_os_cb_write(iio_dev_data->buffer->buf,
-				      adc_data,
-				      BYTES_PER_SAMPLE);
+		return sdram_ring_write(ad469x_sdram_ring, adc_data, BYTES_PER_SAMPLE);
 	} else {
 		/* Enter into register mode or exit from conversion mode */
 		ad469x_exit_conversion_mode(p_ad469x_dev);
@@ -1070,7 +1133,18 @@ static int32_t ad469x_iio_submit_samples(struct iio_device_data *iio_dev_data)
 	if (!buf_size_updated) {
 		/* Update total buffer size according to bytes per scan for proper
 		 * alignment of multi-channel IIO buffer data */
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+		/* Stream through the whole data buffer */
+		ret = sdram_ring_start(ad469x_sdram_ring,
+				       iio_dev_data->buffer->buf,
+				       DATA_BUFFER_SIZE,
+				       iio_dev_data->buffer->bytes_per_scan);
+		if (ret) {
+			return ret;
+		}
+#else
 		iio_dev_data->buffer->buf->size = iio_dev_data->buffer->size;
+#endif
 		buf_size_updated = true;
 	}
 
@@ -1183,12 +1257,24 @@ static int32_t ad469x_iio_submit_samples(struct iio_device_data *iio_dev_data)
 	no_os_cb_end_async_write(iio_dev_data->buffer->buf);
 #else
 	if (!dma_config_updated) {
-		ret = no_os_cb_prepare_async_write(iio_dev_data->buffer->buf,
-						   nb_of_samples * (BYTES_PER_SAMPLE), &buff_start_addr, &data_read);
-		if (ret) {
-			return ret;
-		}
-		ad469x_spi_msg.rx_buff = (uint32_t*) buff_start_addr;
+		/* Cap SPI RX DMA NDTR to MAX_DMA_NDTR, with whole scans in each half
+		 * of the local buffer. The halves are written into the streaming ring,
+		 * which drops them when the host has not drained enough room. */
+		spirxdma_ndtr = no_os_min(MAX_DMA_NDTR, nb_of_samples * (BYTES_PER_SAMPLE));
+		spirxdma_ndtr = no_os_max(spirxdma_ndtr -
+					  (spirxdma_ndtr % (2 * iio_dev_data->buffer->bytes_per_scan)),
+					  2 * iio_dev_data->buffer->bytes_per_scan);
+		rxdma_ndtr = spirxdma_ndtr;
+
+		/* Register half complete callback, for ping-pong buffers implementation. */
+		HAL_DMA_RegisterCallback(&hdma_spi1_rx,
+					 HAL_DMA_XFER_HALFCPLT_CB_ID,
+					 halfcmplt_callback);
+
+		ad469x_spi_msg.rx_buff = (uint32_t*)local_buf;
+		ad469x_spi_msg.bytes_number = spirxdma_ndtr;
+		update_buff((uint32_t*)local_buf,
+			    (uint32_t*)iio_dev_data->buffer->buf->buff);
 
 		ret = no_os_spi_transfer_dma_async(p_ad469x_dev->spi_desc, &ad469x_spi_msg,
 						   1, NULL, NULL);
@@ -1294,6 +1380,13 @@ static int32_t ad469x_iio_remove(struct iio_desc *desc)
 {
 	int32_t status;
 
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	if (ad469x_sdram_ring) {
+		sdram_ring_remove(ad469x_sdram_ring);
+		ad469x_sdram_ring = NULL;
+	}
+#endif
+
 	if (!desc) {
 		return -EINVAL;
 	}
@@ -1421,6 +1514,13 @@ int32_t ad469x_iio_initialize(void)
 			return init_status;
 		}
 
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+		init_status = sdram_ring_init(&ad469x_sdram_ring);
+		if (init_status) {
+			return init_status;
+		}
+#endif
+
 		/* Initialize the IIO interface */
 		iio_device_init_params[0].name = ACTIVE_DEVICE_NAME;
 		iio_device_init_params[0].raw_buf = adc_data_buffer;
@@ -21,6 +21,7 @@
 
 #include "iio.h"
 #include "iio_types.h"
+#include "sdram_ring.h"
 
 /******************************************************************************/
 /****************************** Macros ****************************************/
@@ -35,6 +36,9 @@ extern struct ad469x_dev *p_ad469x_dev;
 
 extern uint32_t callback_count;
 
+/* Streaming ring over the data buffer for continuous data capture */
+extern struct sdram_ring_desc *ad469x_sdram_ring;
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -373,9 +373,11 @@ void receivecomplete_callback(DMA_HandleTypeDef* hdma)
 	}
 	callback_count--;
 #else
-	no_os_cb_end_async_write(global_iio_dev_data->buffer->buf);
-	no_os_cb_prepare_async_write(global_iio_dev_data->buffer->buf,
-				     global_nb_of_samples  * (BYTES_PER_SAMPLE), &buff_start_addr, &data_read);
+	/* Write the second half of the local buffer into the streaming ring,
+	 * which drops it when the host has not drained enough room */
+	sdram_ring_write(ad469x_sdram_ring,
+			 dma_buf_start_idx + (rxdma_ndtr / 2),
+			 rxdma_ndtr / 2);
 #endif // DATA_CAPTURE_MODE
 #endif // INTERFACE_MODE
 }
@@ -389,6 +391,10 @@ void receivecomplete_callback(DMA_HandleTypeDef* hdma)
 void halfcmplt_callback(DMA_HandleTypeDef* hdma)
 {
 #if (INTERFACE_MODE == SPI_DMA)
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	/* Write the first half of the local buffer into the streaming ring */
+	sdram_ring_write(ad469x_sdram_ring, dma_buf_start_idx, rxdma_ndtr / 2);
+#else
 	if (!dma_cycle_count) {
 		return;
 	}
@@ -400,6 +406,7 @@ void halfcmplt_callback(DMA_HandleTypeDef* hdma)
 	iio_buf_current_idx += rxdma_ndtr / 2;
 
 	callback_count--;
+#endif // DATA_CAPTURE_MODE
 #endif
 }
 
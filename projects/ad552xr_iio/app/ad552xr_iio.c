@@ -172,6 +172,7 @@ enum ad552xr_attribute_ids {
 	/* IIO Device Attributes */
 	DEV_ADDR_ATTR_ID,
 	SAMPLE_RATE_ATTR_ID,
+	ACHIEVED_SAMPLE_RATE_ATTR_ID,
 	SCK_FREQ_ATTR_ID,
 	REF_SEL_ATTR_ID,
 	STATUS_ATTR_ID,
@@ -194,7 +195,7 @@ enum ad552xr_attribute_ids {
 	RAMP_STEP_ATTR_ID,
 
 	/* Number of IIO Device attributes */
-	NUM_OF_DEV_ATTR = 6,
+	NUM_OF_DEV_ATTR = 7,
 	NUM_OF_DEV_AVAIL_ATTR = 2,
 
 	/* Number of IIO Channel attributes */
@@ -236,6 +237,7 @@ static struct iio_attribute iio_ad552xr_global_attributes_preset[NUM_OF_DEV_ATTR
 			+ NUM_OF_DEV_AVAIL_ATTR + 1] = {
 	AD552XR_CHN_ATTR("dev_addr", DEV_ADDR_ATTR_ID),
 	AD552XR_CHN_ATTR("sampling_frequency", SAMPLE_RATE_ATTR_ID),
+	AD552XR_CHN_ATTR("achieved_sampling_frequency", ACHIEVED_SAMPLE_RATE_ATTR_ID),
 	AD552XR_CHN_ATTR("sck_frequency", SCK_FREQ_ATTR_ID),
 	AD552XR_CHN_ATTR("ref_sel", REF_SEL_ATTR_ID),
 	AD552XR_CHN_AVAIL_ATTR("ref_sel_available", REF_SEL_ATTR_ID),
@@ -697,6 +699,14 @@ static int iio_ad552xr_attr_get(void *device,
 
 		return sprintf(buf, "%ld", sample_rate);
 
+	case ACHIEVED_SAMPLE_RATE_ATTR_ID:
+		ret = ad552xr_get_achieved_sampling_rate(&sample_rate);
+		if (ret) {
+			return ret;
+		}
+
+		return sprintf(buf, "%lu", (unsigned long)sample_rate);
+
 	case SCK_FREQ_ATTR_ID:
 		return sprintf(buf, "%ld", dev->spi_desc->max_speed_hz);
 
@@ -991,6 +1001,10 @@ static int iio_ad552xr_attr_set(void *device,
 
 		break;
 
+	case ACHIEVED_SAMPLE_RATE_ATTR_ID:
+		/* NA - Measured by the firmware */
+		return -EINVAL;
+
 	case SCK_FREQ_ATTR_ID:
 		val = no_os_str_to_uint32(buf);
 
@@ -23,6 +23,8 @@
 #include "no_os_util.h"
 #include "no_os_spi.h"
 #include "stm32_pwm_ex.h"
+#include "stm32_cycle_counter.h"
+#include "dac_waveform.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -167,6 +169,18 @@ static uint32_t sampling_frequency = ad552xr_iio_sampling_rate;
 /* TGP timer usage status */
 static bool use_tgp_timer = false;
 
+/* DAC update rate achieved during the data transfer, measured in
+ * SPI transfers, one LDAC cycle being one update */
+static struct dac_update_rate ad552xr_update_rate = {
+	.get_ticks = stm32_cycle_counter_get,
+	.get_ms = HAL_GetTick
+};
+
+#if (INTERFACE_MODE == SPI_DMA)
+/* Number of SPI transfers in one pass over the DMA buffer */
+static uint32_t num_spi_transfers_per_pass;
+#endif
+
 /******************************************************************************/
 /************************** Functions Definitions *****************************/
 /******************************************************************************/
@@ -210,6 +224,17 @@ int32_t ad552xr_get_sampling_rate(uint32_t *val)
 	return 0;
 }
 
+/**
+ * @brief	Get the sampling rate achieved during the data transfer.
+ * @param	val[out] - Achieved sample rate value.
+ * @return	0 in case of success, negative error code otherwise.
+ */
+int32_t ad552xr_get_achieved_sampling_rate(uint32_t *val)
+{
+	*val = dac_update_rate_get(&ad552xr_update_rate);
+	return 0;
+}
+
 /**
  * @brief	Configure timer period & duty cycle.
  * @param 	desc[in] - The PWM descriptor.
@@ -316,8 +341,9 @@ static int32_t ad552xr_reinit_tgp_timer(struct ad552xr_dev *dev, uint32_t count)
  */
 static void ad552xr_sg_callback(void *context)
 {
-	// Nothing to do here
 	// Used to bypass default_sg_handler callback of no-os DMA.
+	// Called once per pass over the circular DMA buffer.
+	dac_update_rate_account(&ad552xr_update_rate, num_spi_transfers_per_pass);
 }
 
 /**
@@ -547,6 +573,9 @@ int32_t ad552xr_data_transfer_start(struct iio_device_data *iio_dev_data,
 			return ret;
 		}
 
+		dac_update_rate_start(&ad552xr_update_rate,
+				      info->num_spi_transfers_per_cycle);
+
 		/* Reinitialize TGP timer based on count */
 		if (use_tgp_timer) {
 			ret = ad552xr_reinit_tgp_timer(device, info->num_spi_transfers_per_cycle);
@@ -569,6 +598,7 @@ int32_t ad552xr_data_transfer_start(struct iio_device_data *iio_dev_data,
 
 		info->bytes_transferred += NUM_BYTES_TRANSFER;
 		info->num_spi_data_transfers_done++;
+		dac_update_rate_account(&ad552xr_update_rate, 1);
 
 		/* Reset the bytes to transfer to zero if all bytes are transferred
 		 * and hence entering circular fashion */
@@ -648,6 +678,9 @@ int32_t ad552xr_data_transfer_start(struct iio_device_data *iio_dev_data,
 			return ret;
 		}
 
+		num_spi_transfers_per_pass = ad552xr_spi_msg.bytes_number / NUM_BYTES_TRANSFER;
+		dac_update_rate_start(&ad552xr_update_rate, count);
+
 		/* If SPI transaction required */
 		if (ad552xr_spi_msg.bytes_number != 0) {
 			/* Start SPI DMA transfer */
@@ -706,6 +739,10 @@ int32_t ad552xr_data_transfer_system_init(void)
 {
 	int32_t ret = 0;
 
+	/* Time base for the achieved sampling rate measurement */
+	stm32_cycle_counter_enable();
+	ad552xr_update_rate.ticks_per_sec = stm32_cycle_counter_freq();
+
 	/* Initialize the PWM interface to generate PWM for DAC Update Timer. */
 	ret = no_os_pwm_init(&pwm_dac_update_desc, &pwm_dac_update_init_params);
 	if (ret) {
@@ -27,6 +27,7 @@
 /* Support functions */
 int32_t ad552xr_set_sampling_rate(uint32_t val);
 int32_t ad552xr_get_sampling_rate(uint32_t *val);
+int32_t ad552xr_get_achieved_sampling_rate(uint32_t *val);
 
 /* Data transfer functions */
 int32_t ad552xr_data_transfer_system_init();
@@ -28,6 +28,7 @@
 #include "no_os_alloc.h"
 #include "version.h"
 #include "no_os_delay.h"
+#include "dac_frame_builder.h"
 
 /******** Forward declaration of getter/setter functions ********/
 static int iio_ad5706r_attr_get(void *device,
@@ -1818,16 +1819,14 @@ static int32_t ad5706r_trigger_handler(struct iio_device_data *iio_dev_data)
  * @param device[in] - AD5706R Device descriptor
  * @return 0 in case of success or negative value otherwise.
  */
-void ad5706r_populate_func_mode_data(struct ad5706r_dev *device)
+int32_t ad5706r_populate_func_mode_data(struct ad5706r_dev *device)
 {
 #if (INTERFACE_MODE == SPI_DMA)
 	uint16_t hw_sw_mask = device->ldac_cfg.ldac_hw_sw_mask;
 	uint8_t sw_ldac_reg_len =  AD5706R_LEN(AD5706R_REG_DAC_SW_LDAC);
 	uint8_t sw_ldac_reg_addr = AD5706R_ADDR(AD5706R_REG_DAC_SW_LDAC);
 	uint8_t local_buff[AD5706_N_BYTES_SW_LDAC] = { 0x0 };
-	uint32_t iio_buf_wr_id = 0;
 	uint32_t byte_addr = 0;
-	uint32_t index;
 
 	/* Trigger SW LDAC if any channel configured in SW Mode */
 	if (hw_sw_mask) {
@@ -1844,11 +1843,8 @@ void ad5706r_populate_func_mode_data(struct ad5706r_dev *device)
 		memcpy(&local_buff[byte_addr], &hw_sw_mask, sw_ldac_reg_len);
 	}
 
-	/* Fill up the IIO buffer with the SW LDAC Bits */
-	for (index = 0; index < DATA_BUFFER_SIZE / AD5706_N_BYTES_SW_LDAC; index++) {
-		memcpy(&dac_data_buffer[iio_buf_wr_id], local_buff, AD5706_N_BYTES_SW_LDAC);
-		iio_buf_wr_id += AD5706_N_BYTES_SW_LDAC;
-	}
+	/* Fill up the IIO buffer with the SW LDAC frame, a word at a time */
+	dac_frame_fill((uint8_t *)dac_data_buffer, DATA_BUFFER_SIZE, local_buff);
 
 	/* Update the number of bytes per SPI transaction */
 	if (hw_sw_mask) {
@@ -1861,6 +1857,8 @@ void ad5706r_populate_func_mode_data(struct ad5706r_dev *device)
 	ad5706r_spi_msg.tx_buff = (uint8_t *)dac_data_buffer;
 	ad5706r_spi_msg.bytes_number = DATA_BUFFER_SIZE;
 #endif
+
+	return 0;
 }
 
 /**
@@ -1869,21 +1867,22 @@ void ad5706r_populate_func_mode_data(struct ad5706r_dev *device)
  * @param device[in] - AD5706R Device descriptor
  * @param iio_dev_data[in] - IIO Device Data
  * @return 0 in case of success or negative value otherwise.
+ * @note The frames of a scan are laid out once for the active channels, then
+ * stamped in place with the samples of every scan in the IIO buffer.
  */
-void ad5706r_populate_ldac_mode_data(struct ad5706r_dev *device,
-				     struct iio_device_data *iio_dev_data)
+int32_t ad5706r_populate_ldac_mode_data(struct ad5706r_dev *device,
+					struct iio_device_data *iio_dev_data)
 {
 #if (INTERFACE_MODE == SPI_DMA)
 	uint16_t hw_sw_mask = device->ldac_cfg.ldac_hw_sw_mask;
-	int8_t* iio_buff = iio_dev_data->buffer->buf->buff;
-	static uint8_t sw_ldac_buff[DATA_BUFFER_SIZE] = {0x0};
-	uint32_t modified_buff_idx = 0;
+	uint8_t frame[AD5706_N_BYTES_SW_LDAC] = { 0x0 };
+	struct dac_frame_template tmpl;
 	uint8_t reg_offset_dac_input_a;
 	uint16_t func_en_check_mask;
 	uint8_t reg_offset_sw_ldac;
-	uint32_t iio_buff_idx = 0;
-	uint32_t sample_id;
+	uint32_t frames_size;
 	uint8_t active_chn;
+	int32_t ret;
 
 	/* Modify the address and data bits depending on the status of address ascension */
 	if (device->spi_cfg.addr_asc) {
@@ -1896,37 +1895,48 @@ void ad5706r_populate_ldac_mode_data(struct ad5706r_dev *device,
 		reg_offset_dac_input_a = AD5706R_LEN(AD5706R_REG_DAC_INPUT_A_CH(0)) - 1;
 	}
 
-	for (sample_id = 0; sample_id < iio_dev_data->buffer->samples; sample_id++) {
-		for (active_chn = 0; active_chn < num_of_active_channels; active_chn++) {
-			func_en_check_mask = no_os_field_get(NO_OS_BIT(ad5706r_active_chns[active_chn]),
-							     device->ldac_cfg.func_en_mask);
-
-			/* Check if channel has been configured in LDAC Mode */
-			if (!func_en_check_mask) {
-				/* Populate the SPI Command for SW LDAC Write */
-				sw_ldac_buff[modified_buff_idx++] = AD5706R_MD_ADDR(device->dev_addr);
-				sw_ldac_buff[modified_buff_idx++] = AD5706R_ADDR(AD5706R_REG_DAC_INPUT_A_CH(
-						ad5706r_active_chns[active_chn])) + reg_offset_dac_input_a;
-
-				/* Populate the data */
-				sw_ldac_buff[modified_buff_idx++] = iio_buff[iio_buff_idx + 1];
-				sw_ldac_buff[modified_buff_idx++] = iio_buff[iio_buff_idx];
-			}
+	/* Samples are sent MSB first */
+	dac_frame_template_init(&tmpl, num_of_active_channels, true);
+
+	for (active_chn = 0; active_chn < num_of_active_channels; active_chn++) {
+		func_en_check_mask = no_os_field_get(NO_OS_BIT(ad5706r_active_chns[active_chn]),
+						     device->ldac_cfg.func_en_mask);
 
-			iio_buff_idx += BYTES_PER_SAMPLE;
+		/* Check if channel has been configured in LDAC Mode */
+		if (!func_en_check_mask) {
+			/* SPI Command for SW LDAC Write, the data is stamped per scan */
+			frame[0] = AD5706R_MD_ADDR(device->dev_addr);
+			frame[1] = AD5706R_ADDR(AD5706R_REG_DAC_INPUT_A_CH(
+							ad5706r_active_chns[active_chn])) + reg_offset_dac_input_a;
+
+			ret = dac_frame_template_add(&tmpl, frame, active_chn);
+			if (ret) {
+				return ret;
+			}
 		}
+	}
 
-		/* Prepare for a write operation to SW LDAC Register */
-		if (hw_sw_mask) {
-			sw_ldac_buff[modified_buff_idx++] = AD5706R_MD_ADDR(device->dev_addr);
-			sw_ldac_buff[modified_buff_idx++] = AD5706R_ADDR(AD5706R_REG_DAC_SW_LDAC) +
-							    reg_offset_sw_ldac;
+	/* Prepare for a write operation to SW LDAC Register */
+	if (hw_sw_mask) {
+		frame[0] = AD5706R_MD_ADDR(device->dev_addr);
+		frame[1] = AD5706R_ADDR(AD5706R_REG_DAC_SW_LDAC) + reg_offset_sw_ldac;
+		frame[2] = AD5706R_WRITE_BIT_LONG_INSTR;
+		frame[3] = hw_sw_mask;
 
-			sw_ldac_buff[modified_buff_idx++] = AD5706R_WRITE_BIT_LONG_INSTR;
-			sw_ldac_buff[modified_buff_idx++] = hw_sw_mask;
+		ret = dac_frame_template_add(&tmpl, frame, DAC_FRAME_NO_SAMPLE);
+		if (ret) {
+			return ret;
 		}
 	}
 
+	/* The IIO buffer is the DAC data buffer, the frames are stamped in place */
+	ret = dac_frame_stamp(&tmpl, (uint8_t *)iio_dev_data->buffer->buf->buff,
+			      iio_dev_data->buffer->samples, DATA_BUFFER_SIZE,
+			      &frames_size);
+	if (ret) {
+		return ret;
+	}
+
 	/* Update the number of bytes per SPI transaction */
 	if (hw_sw_mask) {
 		n_bytes = AD5706_SW_LDAC_N_BYTES_WITH_DATA;
@@ -1935,9 +1945,11 @@ void ad5706r_populate_ldac_mode_data(struct ad5706r_dev *device,
 	}
 
 	/* Update the SPI Message */
-	ad5706r_spi_msg.tx_buff = (uint8_t *)sw_ldac_buff;
-	ad5706r_spi_msg.bytes_number = modified_buff_idx;
+	ad5706r_spi_msg.tx_buff = (uint8_t *)iio_dev_data->buffer->buf->buff;
+	ad5706r_spi_msg.bytes_number = frames_size;
 #endif
+
+	return 0;
 }
 
 /**
@@ -1975,10 +1987,13 @@ static int32_t ad5706r_iio_submit_samples(struct iio_device_data *iio_dev_data)
 
 		if (ldac_update) {
 			/* LDAC Update Mode */
-			ad5706r_populate_ldac_mode_data(device, iio_dev_data);
+			ret = ad5706r_populate_ldac_mode_data(device, iio_dev_data);
 		} else {
 			/* Toggle and Dither Modes */
-			ad5706r_populate_func_mode_data(device);
+			ret = ad5706r_populate_func_mode_data(device);
+		}
+		if (ret) {
+			return ret;
 		}
 
 		/* Init Tx Trigger */
@@ -30,6 +30,7 @@
 #include "common.h"
 #include "iio_trigger.h"
 #include "version.h"
+#include "dac_frame_builder.h"
 
 /******** Forward declaration of getter/setter functions ********/
 static int ad5710r_iio_attr_get(void *device,
@@ -87,9 +88,6 @@ static int ad5710r_iio_attr_available_set(void *device,
 /* Bytes per sample (for DAC resolution of 16-bits) */
 #define	BYTES_PER_SAMPLE	sizeof(uint16_t)
 
-/* Bytes per sample with address (for DAC resolution of 16-bits) */
-#define BYTES_PER_SAMPLE_WITH_ADDRESS	2 * BYTES_PER_SAMPLE
-
 /* Number of data storage bits (needed for IIO client to send buffer of data) */
 #define CHN_STORAGE_BITS	(BYTES_PER_SAMPLE * 8)
 
@@ -133,7 +131,29 @@ static struct iio_trigger ad5710r_iio_trig_desc = {
 
 /* AD5710R IIO hw trigger descriptor */
 static struct iio_hw_trig *ad5710r_hw_trig_desc;
+
+/* IIO trigger init parameters */
+static struct iio_trigger_init iio_trigger_init_params = {
+	.descriptor = &ad5710r_iio_trig_desc,
+	.name = AD5710R_IIO_TRIGGER_NAME,
+};
+#endif
+
+/* IIO device init parameters (kept for the IIO interface restart) */
+static struct iio_device_init iio_device_init_params[NUM_OF_IIO_DEVICES] = {{
+		.name = (char *)ACTIVE_DEVICE_NAME,
+		/* Headroom for the streaming mode address */
+		.raw_buf = (int8_t *)dac_data_buffer + DAC_FRAME_HEADROOM,
+	}
+};
+
+/* IIO interface init parameters */
+static struct iio_init_param iio_init_params = {
+	.phy_type = USE_UART,
+#if (INTERFACE_MODE == SPI_INTERRUPT)
+	.trigs = &iio_trigger_init_params,
 #endif
+};
 
 /* Active channel sequence */
 static volatile uint8_t ad5710r_active_chns[DAC_CHANNELS];
@@ -341,6 +361,9 @@ static uint8_t local_buff;
 /* Flag to indicate if SPI DMA enabled */
 static bool spi_dma_enabled = false;
 
+/* Flag to restart the IIO interface on a streaming option change */
+static bool restart_iio_flag = false;
+
 /* STM32 SPI Init params */
 struct stm32_spi_init_param* spi_init_param;
 
@@ -871,6 +894,11 @@ static int ad5710r_iio_attr_set(void *device,
 		if (streaming_option != value) {
 			streaming_option = value;
 			reconfig_stm32_params();
+#if (INTERFACE_MODE == SPI_DMA)
+			/* The accepted buffer length depends upon the streaming option,
+			 * the IIO interface is restarted once this request is served */
+			restart_iio_flag = true;
+#endif
 		}
 
 		break;
@@ -1147,42 +1175,34 @@ static int32_t ad5710r_iio_close_channels(void *dev)
 
 #if (INTERFACE_MODE == SPI_DMA)
 /**
- * @brief Update the iio buffer by inserting channel register addresses.
+ * @brief Expand the iio buffer into single instruction frames.
  * @param iio_dev_data[in, out] - IIO device data instance.
+ * @param frames_size[out] - Size of the frames (in bytes).
  * @return 0 in case of success or negative value otherwise.
- * @detail The input iio buffer samples will be inserted with channel addresses
- *		   before the samples for single instruction based data streaming
+ * @detail The frames (channel address followed by the sample) are built in
+ *		   place, the buffer being used up to twice the samples size.
  */
-static int update_iio_buffer_with_ch_ids(struct iio_device_data* iio_dev_data)
+static int update_iio_buffer_with_ch_ids(struct iio_device_data* iio_dev_data,
+		uint32_t *frames_size)
 {
+	uint16_t instr[DAC_CHANNELS];
+	uint8_t ch_id;
+
 	if (!iio_dev_data) {
 		return -EINVAL;
 	}
 
-	uint16_t nb_of_samples_per_chn = iio_dev_data->buffer->size /
-					 (BYTES_PER_SAMPLE * num_of_active_channels); // number of samples per channel
-	uint32_t buff_len = iio_dev_data->buffer->size;
-	uint32_t iio_buff_idx = buff_len - 1;		 // input iio buffer index
-	uint32_t modified_buff_idx = 2 * buff_len - 1; // modified iio buffer index
-	int8_t* iio_buff = iio_dev_data->buffer->buf->buff;
-	int16_t sample_id;
-	int8_t ch_id;
-
-	/* Iterate over the samples per active channels in the iio buffer from backwards */
-	for (sample_id = nb_of_samples_per_chn - 1; sample_id >= 0; sample_id--) {
-		/* Iterate over the active channles per each sample in the iio buffer */
-		for (ch_id = num_of_active_channels - 1; ch_id >= 0; ch_id--) {
-			/* Copy data */
-			iio_buff[modified_buff_idx--] = iio_buff[iio_buff_idx--];
-			iio_buff[modified_buff_idx--] = iio_buff[iio_buff_idx--];
-
-			/* Copy active channel address for the respective channel */
-			iio_buff[modified_buff_idx--] = ch_addr_array[ad5710r_active_chns[ch_id]];
-			iio_buff[modified_buff_idx--] = ch_addr_array[ad5710r_active_chns[ch_id]] >> 8;
-		}
+	if (2 * iio_dev_data->buffer->size > DATA_BUFFER_SIZE - DAC_FRAME_HEADROOM) {
+		return -ENOMEM;
 	}
 
-	return 0;
+	for (ch_id = 0; ch_id < num_of_active_channels; ch_id++) {
+		instr[ch_id] = ch_addr_array[ad5710r_active_chns[ch_id]];
+	}
+
+	return dac_frame_build_single_instr((uint8_t *)iio_dev_data->buffer->buf->buff,
+					    iio_dev_data->buffer->size, instr,
+					    num_of_active_channels, frames_size);
 }
 #endif
 
@@ -1197,6 +1217,7 @@ static int32_t ad5710r_iio_submit_samples(struct iio_device_data *iio_dev_data)
 	int32_t ret;
 	int8_t* iio_buff;
 	uint8_t addr;
+	uint32_t frames_size;
 
 	if (!iio_dev_data) {
 		return -EINVAL;
@@ -1213,30 +1234,26 @@ static int32_t ad5710r_iio_submit_samples(struct iio_device_data *iio_dev_data)
 
 		if (streaming_option == SINGLE_INSTRUCTION_MODE) {
 			/* Insert channel addresses in iio buffer before streaming the data */
-			ret = update_iio_buffer_with_ch_ids(iio_dev_data);
+			ret = update_iio_buffer_with_ch_ids(iio_dev_data, &frames_size);
 			if (ret) {
 				return ret;
 			}
 
 			/* SPI Message */
 			ad5710r_spi_msg.tx_buff = (uint8_t*)iio_buff;
-			ad5710r_spi_msg.bytes_number = num_of_samples * BYTES_PER_SAMPLE_WITH_ADDRESS;
+			ad5710r_spi_msg.bytes_number = frames_size;
 		} else { // STREAMING_MODE
 			/* Get 1st channel address from the channel mask */
 			addr = AD5710R_REG_ADDR_DAC_CHN(no_os_find_first_set_bit(
 								iio_dev_data->buffer->active_mask));
 
-			/* Insert address and shift received data from iio buffer */
-			memmove(iio_buff + 2, iio_buff,
-				iio_dev_data->buffer->size);
-			iio_buff[0] = 0x00;
-			iio_buff[1] = addr;
-
-			global_iio_buff = (uint8_t*)iio_buff;
+			/* Insert address in the headroom ahead of the iio buffer data */
+			global_iio_buff = dac_frame_prepend_instr((uint8_t*)iio_buff, addr);
 
 			/* SPI Message */
-			ad5710r_spi_msg.tx_buff = (uint8_t*)iio_buff;
-			ad5710r_spi_msg.bytes_number = (num_of_samples * BYTES_PER_SAMPLE) + 2;
+			ad5710r_spi_msg.tx_buff = global_iio_buff;
+			ad5710r_spi_msg.bytes_number = (num_of_samples * BYTES_PER_SAMPLE) +
+						       DAC_FRAME_INSTR_SIZE;
 		}
 
 		/* Set CS low */
@@ -1555,6 +1572,43 @@ static void iio_app_remove(void)
 	}
 }
 
+/**
+ * @brief	Get the IIO buffer length accepted in the current streaming option
+ * @return	Buffer length (in bytes)
+ * @note	The single instruction mode frames take up twice the samples size.
+ */
+static uint32_t ad5710r_iio_buf_len(void)
+{
+#if (INTERFACE_MODE == SPI_DMA)
+	if (streaming_option == SINGLE_INSTRUCTION_MODE) {
+		return (DATA_BUFFER_SIZE - DAC_FRAME_HEADROOM) / 2;
+	}
+#endif
+
+	return DATA_BUFFER_SIZE - DAC_FRAME_HEADROOM;
+}
+
+#if (INTERFACE_MODE == SPI_DMA)
+/**
+ * @brief	Restart the IIO interface with the buffer length accepted
+ *			in the current streaming option
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t ad5710r_iio_restart(void)
+{
+	int32_t ret;
+
+	ret = iio_remove(ad5710r_iio_desc);
+	if (ret) {
+		return ret;
+	}
+
+	iio_device_init_params[0].raw_buf_len = ad5710r_iio_buf_len();
+
+	return iio_init(&ad5710r_iio_desc, &iio_init_params);
+}
+#endif
+
 /**
  * @brief	Initialize the IIO interface for AD5710R IIO device
  * @return	0 in case of success,negative error code otherwise
@@ -1566,29 +1620,6 @@ int32_t ad5710r_iio_initialize(void)
 	uint8_t id;
 	struct no_os_eeprom_desc *eeprom_desc;
 
-#if (INTERFACE_MODE == SPI_INTERRUPT)
-	/* IIO trigger init parameters */
-	struct iio_trigger_init iio_trigger_init_params = {
-		.descriptor = &ad5710r_iio_trig_desc,
-		.name = AD5710R_IIO_TRIGGER_NAME,
-	};
-#endif
-
-	struct iio_device_init iio_device_init_params[NUM_OF_IIO_DEVICES] = {{
-			.name = (char *)ACTIVE_DEVICE_NAME,
-			.raw_buf = dac_data_buffer,
-			.raw_buf_len = DATA_BUFFER_SIZE / 2, // Allocate only half the buffer size to accommodate the other half for addresses
-		}
-	};
-
-	/* IIO interface init parameters */
-	struct iio_init_param iio_init_params = {
-		.phy_type = USE_UART,
-#if (INTERFACE_MODE == SPI_INTERRUPT)
-		.trigs = &iio_trigger_init_params,
-#endif
-	};
-
 	/* Add a fixed delay of 1 sec before system init for the PoR sequence to get completed */
 	no_os_mdelay(1000);
 
@@ -1668,6 +1699,7 @@ int32_t ad5710r_iio_initialize(void)
 	/* Initialize the IIO interface */
 	iio_init_params.uart_desc = uart_iio_com_desc;
 	iio_init_params.devs = iio_device_init_params;
+	iio_device_init_params[0].raw_buf_len = ad5710r_iio_buf_len();
 	ret = iio_init(&ad5710r_iio_desc, &iio_init_params);
 	if (ret) {
 		goto err;
@@ -1703,5 +1735,16 @@ err:
  */
 void ad5710r_iio_event_handler(void)
 {
+#if (INTERFACE_MODE == SPI_DMA)
+	if (restart_iio_flag) {
+		/* Reset the restart_iio flag */
+		restart_iio_flag = false;
+
+		if (ad5710r_iio_restart()) {
+			return;
+		}
+	}
+#endif
+
 	iio_step(ad5710r_iio_desc);
 }
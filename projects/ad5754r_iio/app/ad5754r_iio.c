@@ -29,6 +29,8 @@
 #include "no_os_pwm.h"
 #include "no_os_alloc.h"
 #include "iio_trigger.h"
+#include "dac_waveform.h"
+#include "stm32_cycle_counter.h"
 
 /******** Forward declaration of getter/setter functions ********/
 static int ad5754r_iio_attr_get(void *device,
@@ -124,6 +126,19 @@ static int ad5754r_iio_attr_available_set(void *device,
 static int8_t dac_data_buffer[DATA_BUFFER_SIZE];
 #endif
 
+/* SPI frame writing a DAC channel (instruction/address and 16-bit data) */
+#define AD5754R_FRAME_SIZE			3
+
+#if (INTERFACE_MODE == SPI_DMA)
+/* Frame memory replayed by the DMA, the frames being rendered in place over
+ * the DAC data buffer */
+#define WAVEFORM_MEM_SIZE			no_os_min(DATA_BUFFER_SIZE, REPLAY_MAX_BYTES)
+
+/* Largest IIO buffer whose rendered frames fit in the frame memory */
+#define WAVEFORM_MAX_BUFFER_SIZE	((WAVEFORM_MEM_SIZE / AD5754R_FRAME_SIZE) *\
+					 BYTES_PER_SAMPLE)
+#endif
+
 #ifdef DEV_CN0586
 #define AD5754R_ATTRS_OFFSET	6
 #else
@@ -144,8 +159,10 @@ static struct iio_desc *ad5754r_iio_desc;
 /* Pointer to the struct representing the AD5754R IIO device */
 struct ad5754r_dev *ad5754r_dev_inst = NULL;
 
+#if (INTERFACE_MODE == SPI_INTERRUPT)
 /* AD5754R IIO hw trigger descriptor */
 static struct iio_hw_trig *ad5754r_hw_trig_desc;
+#endif
 
 /* Active channel sequence */
 static uint8_t ad5754r_active_chns[AD5754R_NUM_CHANNELS];
@@ -153,12 +170,28 @@ static uint8_t ad5754r_active_chns[AD5754R_NUM_CHANNELS];
 /* Number of active channels */
 static uint8_t num_of_active_channels = 0;
 
+#if (INTERFACE_MODE == SPI_DMA)
+/* Waveform playback descriptor */
+static struct dac_waveform_desc *ad5754r_waveform;
+
+/* Flag to indicate if the waveform replay is enabled */
+static bool waveform_replay_enabled;
+#else
+/* Achieved update rate (one update per trigger) */
+static struct dac_update_rate ad5754r_update_rate = {
+	.get_ticks = stm32_cycle_counter_get,
+	.get_ms = HAL_GetTick
+};
+#endif
+
+#if (INTERFACE_MODE == SPI_INTERRUPT)
 /* Descriptor to hold iio trigger details */
 static struct iio_trigger ad5754r_iio_trig_desc = {
 	.is_synchronous = true,
 	.enable = NULL,
 	.disable = NULL
 };
+#endif
 
 /* AD5754R attribute unique IDs */
 enum ad5754r_attribute_ids {
@@ -181,6 +214,7 @@ enum ad5754r_attribute_ids {
 	DAC_CLEAR_SETTING,
 	DAC_SDO_DIS,
 	DAC_UPDATE_RATE,
+	DAC_ACHIEVED_UPDATE_RATE,
 	DAC_CLAMP_EN,
 	DAC_TSD_EN,
 	DAC_OC_TSD,
@@ -230,6 +264,7 @@ static struct iio_attribute ad5754r_iio_global_attributes[] = {
 	AD5754R_CHN_ATTR("sdo_disable", DAC_SDO_DIS),
 	AD5754R_CHN_AVAIL_ATTR("sdo_disable_available", DAC_SDO_DIS),
 	AD5754R_CHN_ATTR("sampling_frequency", DAC_UPDATE_RATE),
+	AD5754R_CHN_ATTR("achieved_sampling_frequency", DAC_ACHIEVED_UPDATE_RATE),
 	AD5754R_CHN_ATTR("clamp_enable", DAC_CLAMP_EN),
 	AD5754R_CHN_AVAIL_ATTR("clamp_enable_available", DAC_CLAMP_EN),
 	AD5754R_CHN_ATTR("tsd_enable", DAC_TSD_EN),
@@ -452,6 +487,14 @@ static int ad5754r_iio_attr_get(void *device,
 	float scale;
 	uint8_t chn = channel->ch_num;
 
+#if (INTERFACE_MODE == SPI_DMA)
+	/* The SPI bus is owned by the waveform replay DMA */
+	if (waveform_replay_enabled
+	    && (priv == DAC_CH_RAW || priv == DAC_CH_REG || priv == DAC_OC_TSD)) {
+		return -EBUSY;
+	}
+#endif
+
 	switch (priv) {
 #ifdef DEV_CN0586
 	case HVOUT_STATE:
@@ -528,6 +571,17 @@ static int ad5754r_iio_attr_get(void *device,
 
 		return sprintf(buf, "%lu", sampling_rate);
 
+	case DAC_ACHIEVED_UPDATE_RATE:
+		/* Measured over the waveform cycles replayed by the DMA (0 until
+		 * the first cycle), or over the trigger handler updates */
+#if (INTERFACE_MODE == SPI_DMA)
+		return sprintf(buf, "%lu",
+			       (unsigned long)dac_waveform_get_rate(ad5754r_waveform));
+#else
+		return sprintf(buf, "%lu",
+			       (unsigned long)dac_update_rate_get(&ad5754r_update_rate));
+#endif
+
 	case DAC_CLAMP_EN:
 		return sprintf(buf, "%s", ad5754r_clamp_tsd_state[ad5754r_dev_inst->clamp_en]);
 
@@ -596,6 +650,14 @@ static int ad5754r_iio_attr_set(void *device,
 	char *end;
 	int32_t cyc_count;
 
+#if (INTERFACE_MODE == SPI_DMA)
+	/* The SPI bus is owned by the waveform replay DMA, and the replay
+	 * timing is validated against the LDAC period at its start */
+	if (waveform_replay_enabled) {
+		return -EBUSY;
+	}
+#endif
+
 	switch (priv) {
 #ifdef DEV_CN0586
 	case HVOUT_STATE:
@@ -854,6 +916,10 @@ static int ad5754r_iio_attr_set(void *device,
 	case DAC_SW_LDAC:
 		return ad5754r_write(ad5754r_dev_inst, AD5754R_INSTR_LOAD, 0x0000);
 
+	case DAC_ACHIEVED_UPDATE_RATE:
+		/* NA - Measured by the firmware */
+		return -EINVAL;
+
 	default:
 		return -EINVAL;
 	}
@@ -1001,6 +1067,12 @@ static int32_t ad5754r_iio_debug_reg_read(void *dev,
 		return -EINVAL;
 	}
 
+#if (INTERFACE_MODE == SPI_DMA)
+	if (waveform_replay_enabled) {
+		return -EBUSY;
+	}
+#endif
+
 	return ad5754r_read(dev, (uint8_t)reg, (uint16_t *)readval);
 }
 
@@ -1019,6 +1091,12 @@ static int32_t ad5754r_iio_debug_reg_write(void *dev,
 		return -EINVAL;
 	}
 
+#if (INTERFACE_MODE == SPI_DMA)
+	if (waveform_replay_enabled) {
+		return -EBUSY;
+	}
+#endif
+
 	return ad5754r_write(dev, (uint8_t)reg, (uint16_t)writeval);
 }
 
@@ -1066,6 +1144,13 @@ static int32_t ad5754r_iio_prepare_transfer(void *dev, uint32_t mask)
 		return ret;
 	}
 
+#if (INTERFACE_MODE == SPI_DMA)
+	/* The waveform is rendered and replayed once the buffer is submitted */
+	dac_waveform_reset(ad5754r_waveform);
+	waveform_replay_enabled = false;
+#else
+	dac_update_rate_start(&ad5754r_update_rate, 1);
+
 	/* Clear pending Interrupt before enabling back the trigger.
 	 * Else , a spurious interrupt is observed after a legitimate interrupt, */
 	ret = no_os_irq_clear_pending(trigger_irq_desc, TRIGGER_INT_ID);
@@ -1082,6 +1167,7 @@ static int32_t ad5754r_iio_prepare_transfer(void *dev, uint32_t mask)
 	if (ret) {
 		return ret;
 	}
+#endif
 
 	return 0;
 }
@@ -1099,6 +1185,17 @@ static int32_t ad5754r_iio_end_transfer(void *dev)
 		return -EINVAL;
 	}
 
+#if (INTERFACE_MODE == SPI_DMA)
+	ret = no_os_pwm_disable(pwm_desc);
+	if (ret) {
+		return ret;
+	}
+
+	if (waveform_replay_enabled) {
+		stm32_waveform_replay_stop();
+		waveform_replay_enabled = false;
+	}
+#else
 	ret = iio_trig_disable(ad5754r_hw_trig_desc);
 	if (ret) {
 		return ret;
@@ -1108,6 +1205,7 @@ static int32_t ad5754r_iio_end_transfer(void *dev)
 	if (ret) {
 		return ret;
 	}
+#endif
 
 	/* Reconfigure the LDAC pin as GPIO output (non-PWM) */
 	ret = ad5754r_reconfig_ldac(ad5754r_dev_inst, AD5754_LDAC_GPIO_OUTPUT);
@@ -1126,6 +1224,82 @@ static int32_t ad5754r_iio_end_transfer(void *dev)
 	return 0;
 }
 
+#if (INTERFACE_MODE == SPI_DMA)
+/**
+ * @brief Render the SPI frame writing a code into a DAC channel
+ * @param ctx[in] - Render context (unused)
+ * @param chn[in] - DAC channel
+ * @param code[in] - DAC code
+ * @param frame[out] - SPI frame
+ * @return none
+ */
+static void ad5754r_render_frame(void *ctx, uint8_t chn, uint32_t code,
+				 uint8_t *frame)
+{
+	frame[0] = AD5754R_PREP_INSTR_ADDR(AD5754R_REG_DAC, chn);
+	frame[1] = (code >> BYTE_SIZE) & BYTE_MASK;
+	frame[2] = code & BYTE_MASK;
+}
+
+/* Waveform playback init parameters */
+static struct dac_waveform_init_param waveform_init_params = {
+	.render_frame = ad5754r_render_frame,
+	.ctx = NULL,
+	.frame_size = AD5754R_FRAME_SIZE,
+	.sample_size = BYTES_PER_SAMPLE,
+	/* Rendered in place, the 3-byte frames replacing the 2-byte samples */
+	.frames = (uint8_t *)dac_data_buffer,
+	.frames_mem_size = WAVEFORM_MEM_SIZE,
+	.get_ticks = stm32_cycle_counter_get,
+	.get_ms = HAL_GetTick
+};
+
+/**
+ * @brief Render the cyclic buffer and start its replay
+ * @param iio_dev_data[in] - IIO device data instance
+ * @return 0 in case of success or negative value otherwise
+ * @note The buffer data is only available once submitted (after the
+ *		 prepare_transfer), it is rendered once into the SPI frames here.
+ *		 One frame (one channel) is then sent by DMA on each LDAC update,
+ *		 as done by the trigger handler in the spi interrupt mode.
+ */
+static int32_t ad5754r_iio_submit_samples(struct iio_device_data *iio_dev_data)
+{
+	int32_t ret;
+
+	if (!iio_dev_data) {
+		return -EINVAL;
+	}
+
+	if (waveform_replay_enabled) {
+		return 0;
+	}
+
+	ret = dac_waveform_render(ad5754r_waveform, iio_dev_data->buffer->buf->buff,
+				  iio_dev_data->buffer->size, ad5754r_active_chns,
+				  num_of_active_channels);
+	if (ret) {
+		return ret;
+	}
+
+	ret = stm32_waveform_replay_start(ad5754r_waveform, 1);
+	if (ret) {
+		return ret;
+	}
+
+	dac_waveform_start(ad5754r_waveform);
+
+	ret = no_os_pwm_enable(pwm_desc);
+	if (ret) {
+		stm32_waveform_replay_stop();
+		return ret;
+	}
+
+	waveform_replay_enabled = true;
+
+	return 0;
+}
+#else
 /**
  * @brief Pops data from IIO buffer and writes into DAC when
  *		  trigger handler IRQ is invoked
@@ -1153,8 +1327,11 @@ static int32_t ad5754r_trigger_handler(struct iio_device_data *iio_dev_data)
 				       dac_raw[chn]);
 	chn += 1;
 
+	dac_update_rate_account(&ad5754r_update_rate, 1);
+
 	return 0;
 }
+#endif
 
 /**
 * @brief	Init for reading/writing and parametrization of an
@@ -1177,14 +1354,22 @@ static int32_t ad5754r_iio_param_init(struct iio_device **desc)
 				       AD5754R_ATTRS_OFFSET;
 	iio_ad5754r_inst->debug_attributes = NULL;
 
+#if (INTERFACE_MODE == SPI_DMA)
+	iio_ad5754r_inst->submit = ad5754r_iio_submit_samples;
+#else
 	iio_ad5754r_inst->submit = NULL;
+#endif
 	iio_ad5754r_inst->pre_enable = ad5754r_iio_prepare_transfer;
 	iio_ad5754r_inst->post_disable = ad5754r_iio_end_transfer;
 	iio_ad5754r_inst->read_dev = NULL;
 	iio_ad5754r_inst->write_dev = NULL;
 	iio_ad5754r_inst->debug_reg_read = ad5754r_iio_debug_reg_read;
 	iio_ad5754r_inst->debug_reg_write = ad5754r_iio_debug_reg_write;
+#if (INTERFACE_MODE == SPI_INTERRUPT)
 	iio_ad5754r_inst->trigger_handler = ad5754r_trigger_handler;
+#else
+	iio_ad5754r_inst->trigger_handler = NULL;
+#endif
 
 	*desc = iio_ad5754r_inst;
 
@@ -1225,6 +1410,7 @@ static int32_t cn0586_iio_param_init(struct iio_device **desc)
 	return 0;
 }
 
+#if (INTERFACE_MODE == SPI_INTERRUPT)
 /**
  * @brief	Initialization of AD5754R IIO hardware trigger specific parameters
  * @param 	desc[in,out] - IIO hardware trigger descriptor
@@ -1265,6 +1451,7 @@ static int32_t ad5754r_iio_trigger_param_init(struct iio_hw_trig **desc)
 
 	return 0;
 }
+#endif
 
 /**
  * @brief	Initialize the IIO interface for AD5754R IIO device.
@@ -1280,17 +1467,21 @@ int32_t ad5754r_iio_init(void)
 	struct iio_device *cn0586_iio_dev = NULL;
 #endif
 
+#if (INTERFACE_MODE == SPI_INTERRUPT)
 	/* IIO trigger init parameters */
 	static struct iio_trigger_init iio_trigger_init_params = {
 		.descriptor = &ad5754r_iio_trig_desc,
 		.name = AD5754R_IIO_TRIGGER_NAME,
 	};
+#endif
 
 	/* IIO interface init parameters */
 	static struct iio_init_param iio_init_params = {
 		.phy_type = USE_UART,
+#if (INTERFACE_MODE == SPI_INTERRUPT)
 		.trigs = &iio_trigger_init_params,
 		.nb_trigs = 1
+#endif
 	};
 
 	/* IIOD init parameters */
@@ -1364,10 +1555,15 @@ int32_t ad5754r_iio_init(void)
 		/* AD5754R IIO device init parameters */
 		iio_device_init_params[0].name = ACTIVE_DEVICE_NAME;
 		iio_device_init_params[0].raw_buf = dac_data_buffer;
+#if (INTERFACE_MODE == SPI_DMA)
+		/* The buffer must fit in the frame memory once rendered */
+		iio_device_init_params[0].raw_buf_len = WAVEFORM_MAX_BUFFER_SIZE;
+#else
 		iio_device_init_params[0].raw_buf_len = DATA_BUFFER_SIZE;
+		iio_device_init_params[0].trigger_id = "trigger0";
+#endif
 		iio_device_init_params[0].dev = ad5754r_dev_inst;
 		iio_device_init_params[0].dev_descriptor = ad5754r_iio_dev;
-		iio_device_init_params[0].trigger_id = "trigger0";
 
 #ifdef DEV_CN0586
 		/* CFTL IIO device init parameters */
@@ -1391,16 +1587,31 @@ int32_t ad5754r_iio_init(void)
 		return ret;
 	}
 
+#if (INTERFACE_MODE == SPI_INTERRUPT)
 	ret = ad5754r_iio_trigger_param_init(&ad5754r_hw_trig_desc);
 	if (ret) {
 		return ret;
 	}
+#endif
 
 	ret = init_pwm();
 	if (ret) {
 		return ret;
 	}
 
+	/* Achieved update rate time base */
+	stm32_cycle_counter_enable();
+#if (INTERFACE_MODE == SPI_DMA)
+	waveform_init_params.ticks_per_sec = stm32_cycle_counter_freq();
+
+	ret = dac_waveform_init(&ad5754r_waveform, &waveform_init_params);
+	if (ret) {
+		return ret;
+	}
+#else
+	ad5754r_update_rate.ticks_per_sec = stm32_cycle_counter_freq();
+#endif
+
 	/* Reconfigure the LDAC pin as GPIO output (non-PWM) */
 	ret = ad5754r_reconfig_ldac(ad5754r_dev_inst, AD5754_LDAC_GPIO_OUTPUT);
 	if (ret) {
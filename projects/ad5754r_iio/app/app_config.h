@@ -36,6 +36,20 @@
 #define ACTIVE_PLATFORM	 STM32_PLATFORM
 #endif
 
+/* List of data transmit methods supported by hardware platform */
+#define SPI_DMA				0
+#define SPI_INTERRUPT		1
+
+/* Interface mode either spi interrupt or spi dma (default spi interrupt).
+ * In spi dma mode, the cyclic buffer is rendered once into the SPI frames,
+ * replayed by a DMA triggered from the LDAC timer (no MCU load per update).
+ * The device attributes accessing the SPI bus are busy during the replay */
+//#define INTERFACE_MODE SPI_DMA // Uncomment to select spi dma
+
+#if !defined(INTERFACE_MODE)
+#define INTERFACE_MODE SPI_INTERRUPT
+#endif
+
 // **** Note for User on selection of Active Device ****//
 /* Define the device type here from the list of below device type defines
  * (one at a time. Defining more than one device can result into compile error).
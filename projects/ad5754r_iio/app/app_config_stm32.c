@@ -19,11 +19,38 @@
 #include "ad5754r_iio.h"
 #include "ad5754r.h"
 #include "no_os_pwm.h"
+#include "no_os_error.h"
+#include "dac_waveform.h"
 
 /******************************************************************************/
 /********************* Macros and Constants Definition ************************/
 /******************************************************************************/
 
+#if (INTERFACE_MODE == SPI_DMA)
+/* GPIO BSRR values driving the SPI chip select */
+#define REPLAY_CS_LOW		(1UL << (SPI_CSB + 16))
+#define REPLAY_CS_HIGH		(1UL << SPI_CSB)
+
+/* DMA2 streams of the TIM8 requests (channel 7). DMA2 Stream3 (TIM8_CH2)
+ * is left out, being the SPI1_TX stream (channel 3) */
+#define REPLAY_DATA_STREAM		DMA2_Stream2 // TIM8_CH1
+#define REPLAY_CS_LOW_STREAM	DMA2_Stream7 // TIM8_CH4
+#define REPLAY_CS_HIGH_STREAM	DMA2_Stream4 // TIM8_CH3
+
+/* DMA2 stream flags (interrupt flag clear registers) */
+#define REPLAY_DMA_LIFCR_MASK	(DMA_LIFCR_CFEIF2 | DMA_LIFCR_CDMEIF2 |\
+				 DMA_LIFCR_CTEIF2 | DMA_LIFCR_CHTIF2 | DMA_LIFCR_CTCIF2)
+#define REPLAY_DMA_HIFCR_MASK	(DMA_HIFCR_CFEIF4 | DMA_HIFCR_CDMEIF4 |\
+				 DMA_HIFCR_CTEIF4 | DMA_HIFCR_CHTIF4 | DMA_HIFCR_CTCIF4 |\
+				 DMA_HIFCR_CFEIF7 | DMA_HIFCR_CDMEIF7 | DMA_HIFCR_CTEIF7 |\
+				 DMA_HIFCR_CHTIF7 | DMA_HIFCR_CTCIF7)
+
+/* Timeout count waiting for the frame in progress when stopping the replay.
+ * Note: This timeout factor is dependent upon the MCU clock frequency. Below
+ * timeout is tested for SDP-K1 platform @180Mhz default core clock */
+#define REPLAY_STOP_TIMEOUT		0xffff
+#endif
+
 /******************************************************************************/
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
@@ -80,7 +107,10 @@ struct stm32_pwm_init_param stm32_pwm_extra_init_params = {
 	.mode = TIM_OC_PWM1,
 	.timer_chn = LDAC_PWM_CHANNEL,
 	.get_timer_clock = HAL_RCC_GetPCLK2Freq,
-	.clock_divider = LDAC_PWM_CLK_DIVIDER
+	.clock_divider = LDAC_PWM_CLK_DIVIDER,
+	.slave_mode = STM32_PWM_SM_DISABLE,
+	/* Update event (LDAC rising edge) triggering the waveform replay */
+	.trigger_output = PWM_TRGO_UPDATE
 };
 
 /* VCOM Init Parameter */
@@ -88,6 +118,16 @@ struct stm32_usb_uart_init_param stm32_vcom_extra_init_params = {
 	.husbdevice = &APP_UART_USB_HANDLE
 };
 
+#if (INTERFACE_MODE == SPI_DMA)
+/* Waveform being replayed */
+static struct dac_waveform_desc *replay_waveform;
+
+/* Chip select writes for each byte of a frame, at the start (low) and at
+ * the end (high) of the byte period. Zero writes leave the pin unchanged */
+static uint32_t replay_cs_low_seq[REPLAY_MAX_FRAME_SIZE];
+static uint32_t replay_cs_high_seq[REPLAY_MAX_FRAME_SIZE];
+#endif
+
 /******************************************************************************/
 /************************** Functions Declaration *****************************/
 /******************************************************************************/
@@ -111,3 +151,170 @@ void stm32_system_init(void)
 	MX_TIM1_Init();
 	MX_USB_DEVICE_Init();
 }
+
+#if (INTERFACE_MODE == SPI_DMA)
+/**
+ * @brief Configure a DMA2 stream for a circular memory to peripheral transfer
+ * @param stream[in] - DMA stream
+ * @param cr[in] - Stream configuration (channel, priority, data sizes)
+ * @param dst[in] - Peripheral register address
+ * @param src[in] - Memory address
+ * @param count[in] - Number of data items per cycle
+ * @return None
+ */
+static void stm32_replay_stream_config(DMA_Stream_TypeDef *stream, uint32_t cr,
+				       volatile uint32_t *dst, const void *src, uint32_t count)
+{
+	stream->CR &= ~DMA_SxCR_EN;
+	while (stream->CR & DMA_SxCR_EN);
+
+	stream->CR = cr | DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_DIR_0;
+	stream->FCR = 0; // Direct mode
+	stream->PAR = (uint32_t)dst;
+	stream->M0AR = (uint32_t)src;
+	stream->NDTR = count;
+}
+
+/**
+ * @brief Start the replay of the rendered waveform frames
+ * @param waveform[in] - Rendered waveform
+ * @param frames_per_update[in] - Frames sent on each LDAC update
+ * @return 0 in case of success, negative error code otherwise
+ * @details On each LDAC PWM timer update (TRGO), TIM8 runs one pulse of
+ *			(bytes per update) periods. In every period, its CC4/CC1/CC3
+ *			events request the chip select low write, the frame byte and the
+ *			chip select high write, the chip select toggling only around each
+ *			frame. The data DMA transfer complete interrupt accounts the
+ *			waveform cycles, no MCU processing being done per update.
+ * @note The LDAC PWM timer has to be started afterwards.
+ */
+int32_t stm32_waveform_replay_start(struct dac_waveform_desc *waveform,
+				    uint32_t frames_per_update)
+{
+	uint32_t bytes_per_update;
+	uint32_t byte_ticks;
+	uint32_t burst_ticks;
+	uint32_t ldac_high_ticks;
+	uint32_t i;
+
+	if (!waveform || !waveform->ready || !frames_per_update
+	    || waveform->frame_size > REPLAY_MAX_FRAME_SIZE) {
+		return -EINVAL;
+	}
+
+	bytes_per_update = frames_per_update * waveform->frame_size;
+	if (waveform->nb_frames * waveform->frame_size > REPLAY_MAX_BYTES
+	    || bytes_per_update > TIM_RCR_REP + 1) {
+		return -E2BIG;
+	}
+
+	/* One frame byte per TIM8 period, from the SPI baud rate prescaler */
+	byte_ticks = 8 * (2 << ((REPLAY_SPI->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos)) *
+		     REPLAY_TIMER_CLK_DIVIDER;
+
+	/* The frames must be sent before the LDAC falling edge */
+	burst_ticks = bytes_per_update * (REPLAY_CS_SETUP_TICKS + byte_ticks +
+					  REPLAY_CS_HOLD_TICKS + REPLAY_CS_HIGH_TICKS);
+	ldac_high_ticks = __HAL_TIM_GET_COMPARE(&LDAC_PWM_HANDLE, TIM_CHANNEL_3) *
+			  (LDAC_PWM_HANDLE.Instance->PSC + 1);
+	if (burst_ticks >= ldac_high_ticks) {
+		return -EINVAL;
+	}
+
+	replay_waveform = waveform;
+	for (i = 0; i < waveform->frame_size; i++) {
+		replay_cs_low_seq[i] = i ? 0 : REPLAY_CS_LOW;
+		replay_cs_high_seq[i] = (i == waveform->frame_size - 1) ? REPLAY_CS_HIGH : 0;
+	}
+
+	__HAL_RCC_DMA2_CLK_ENABLE();
+	__HAL_RCC_TIM8_CLK_ENABLE();
+
+	/* Chip select writes first, then the frame bytes */
+	stm32_replay_stream_config(REPLAY_CS_LOW_STREAM,
+				   DMA_CHANNEL_7 | DMA_SxCR_PL | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1,
+				   &REPLAY_CS_GPIO->BSRR, replay_cs_low_seq, waveform->frame_size);
+	stm32_replay_stream_config(REPLAY_CS_HIGH_STREAM,
+				   DMA_CHANNEL_7 | DMA_SxCR_PL | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1,
+				   &REPLAY_CS_GPIO->BSRR, replay_cs_high_seq, waveform->frame_size);
+	stm32_replay_stream_config(REPLAY_DATA_STREAM,
+				   DMA_CHANNEL_7 | DMA_SxCR_PL_1 | DMA_SxCR_TCIE,
+				   &REPLAY_SPI->DR, waveform->frames,
+				   waveform->nb_frames * waveform->frame_size);
+	DMA2->LIFCR = REPLAY_DMA_LIFCR_MASK;
+	DMA2->HIFCR = REPLAY_DMA_HIFCR_MASK;
+
+	/* One pulse of (bytes per update) periods on each TIM1 trigger (ITR0) */
+	TIM8->CR1 = TIM_CR1_OPM | TIM_CR1_URS;
+	TIM8->SMCR = 0;
+	TIM8->DIER = 0;
+	TIM8->CCMR1 = 0;
+	TIM8->CCMR2 = 0;
+	TIM8->PSC = 0;
+	TIM8->CCR4 = 1;
+	TIM8->CCR1 = TIM8->CCR4 + REPLAY_CS_SETUP_TICKS;
+	TIM8->CCR3 = TIM8->CCR1 + byte_ticks + REPLAY_CS_HOLD_TICKS;
+	TIM8->ARR = TIM8->CCR3 + REPLAY_CS_HIGH_TICKS;
+	TIM8->RCR = bytes_per_update - 1;
+	TIM8->EGR = TIM_EGR_UG; // Load the prescaler and repetition counter
+	TIM8->SR = 0;
+	TIM8->SMCR = TIM_TS_ITR0 | TIM_SLAVEMODE_TRIGGER;
+	TIM8->DIER = TIM_DIER_CC1DE | TIM_DIER_CC3DE | TIM_DIER_CC4DE;
+
+	/* The received bytes are not read, the overrun is cleared at stop */
+	REPLAY_SPI->CR1 |= SPI_CR1_SPE;
+
+	REPLAY_CS_LOW_STREAM->CR |= DMA_SxCR_EN;
+	REPLAY_CS_HIGH_STREAM->CR |= DMA_SxCR_EN;
+	REPLAY_DATA_STREAM->CR |= DMA_SxCR_EN;
+
+	HAL_NVIC_SetPriority(REPLAY_DMA_IRQ_ID, LDAC_GPIO_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(REPLAY_DMA_IRQ_ID);
+
+	return 0;
+}
+
+/**
+ * @brief Stop the replay of the waveform frames
+ * @return None
+ * @note The LDAC PWM timer has to be stopped beforehand, the frame in
+ *		 progress being completed.
+ */
+void stm32_waveform_replay_stop(void)
+{
+	uint32_t timeout = REPLAY_STOP_TIMEOUT;
+
+	while ((TIM8->CR1 & TIM_CR1_CEN) && (timeout-- > 0));
+
+	TIM8->SMCR = 0;
+	TIM8->DIER = 0;
+	TIM8->CR1 &= ~TIM_CR1_CEN;
+
+	HAL_NVIC_DisableIRQ(REPLAY_DMA_IRQ_ID);
+	REPLAY_DATA_STREAM->CR &= ~DMA_SxCR_EN;
+	REPLAY_CS_LOW_STREAM->CR &= ~DMA_SxCR_EN;
+	REPLAY_CS_HIGH_STREAM->CR &= ~DMA_SxCR_EN;
+
+	/* De-assert the chip select, should a frame have been cut */
+	REPLAY_CS_GPIO->BSRR = REPLAY_CS_HIGH;
+
+	/* Clear the overrun of the unread received bytes */
+	while (REPLAY_SPI->SR & SPI_SR_BSY);
+	(void)REPLAY_SPI->DR;
+	(void)REPLAY_SPI->SR;
+}
+
+/**
+ * @brief This function handles the waveform replay DMA interrupt
+ * @return None
+ */
+void DMA2_Stream2_IRQHandler(void)
+{
+	if (DMA2->LISR & DMA_LISR_TCIF2) {
+		DMA2->LIFCR = DMA_LIFCR_CTCIF2;
+
+		/* One waveform cycle sent */
+		dac_waveform_cycle_done(replay_waveform);
+	}
+}
+#endif
@@ -70,6 +70,22 @@
 /* Max spi clk speed */
 #define MAX_SPI_CLK 11250000
 
+#if (INTERFACE_MODE == SPI_DMA)
+/* STM32 waveform replay parameters: TIM8 (triggered by the LDAC PWM timer
+ * update) paces the rendered frame bytes into SPI1 and the chip select
+ * writes into GPIOA through DMA2 streams (channel 7) */
+#define REPLAY_CS_GPIO			GPIOA
+#define REPLAY_SPI				SPI1
+#define REPLAY_TIMER_CLK_DIVIDER	2 // multiplier to get timer clock from PLCK2
+#define REPLAY_CS_SETUP_TICKS	16 // CS low to first SCLK (timer ticks)
+#define REPLAY_CS_HOLD_TICKS	16 // Last SCLK to CS high (timer ticks)
+#define REPLAY_CS_HIGH_TICKS	16 // CS high time between frames (timer ticks)
+#define REPLAY_DMA_IRQ_ID		DMA2_Stream2_IRQn
+#define REPLAY_MAX_FRAME_SIZE	4
+/* Max number of bytes replayed (16-bit DMA transfer count) */
+#define REPLAY_MAX_BYTES		65535
+#endif
+
 /* platform ops */
 #define gpio_ops                    stm32_gpio_ops
 #define spi_ops		                stm32_spi_ops
@@ -106,4 +122,11 @@ extern struct stm32_pwm_init_param stm32_pwm_extra_init_params;
 extern struct stm32_gpio_init_param stm32_pwm_gpio_init_params;
 
 void stm32_system_init(void);
+
+#if (INTERFACE_MODE == SPI_DMA)
+struct dac_waveform_desc;
+int32_t stm32_waveform_replay_start(struct dac_waveform_desc *waveform,
+				    uint32_t frames_per_update);
+void stm32_waveform_replay_stop(void);
+#endif
 #endif /* APP_CONFIG_STM32_H_ */
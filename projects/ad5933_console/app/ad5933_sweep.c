@@ -0,0 +1,217 @@
+/***************************************************************************//**
+ * @file    ad5933_sweep.c
+ * @brief   Pipelined AD5933 frequency sweep engine
+ * @details The DFT data of a point stays in the data registers until the
+ *          next point conversion ends (settling cycles and 1024 ADC samples).
+ *          So once a point is valid, its data is read in one block read and
+ *          the next point is started right away: the impedance computation
+ *          and the record streaming of a point overlap the conversion of the
+ *          next one. The status register is polled with receive byte reads
+ *          (address pointer left on the status register), the real and
+ *          imaginary data are read in one block read.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include "no_os_i2c.h"
+#include "ad5933_sweep.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Interface commands (see data sheet, Table 12) */
+#define AD5933_SWEEP_CMD_BLOCK_READ		0xA1
+#define AD5933_SWEEP_CMD_ADDR_POINTER	0xB0
+
+/* Degrees per radian */
+#define AD5933_SWEEP_RAD_TO_DEG			57.29577951f
+
+/* Real and imaginary data registers (2 bytes each, MSB first) */
+#define AD5933_SWEEP_DATA_SIZE			4
+
+/* Max status polls for a point (well above the longest conversion at the
+ * 100 kHz I2C clock) */
+#define AD5933_SWEEP_POLL_TIMEOUT		100000
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief 	Set the address pointer of the receive byte and block reads.
+ * @param	dev[in] - AD5933 device
+ * @param	reg[in] - Register address
+ * @return 	0 in case of success, negative error code otherwise
+ */
+static int32_t ad5933_sweep_set_pointer(struct ad5933_dev *dev, uint8_t reg)
+{
+	uint8_t cmd[2] = { AD5933_SWEEP_CMD_ADDR_POINTER, reg };
+
+	return no_os_i2c_write(dev->i2c_desc, cmd, sizeof(cmd), 1);
+}
+
+/**
+ * @brief 	Wait for the data of the current point.
+ * @param	dev[in] - AD5933 device (address pointer on the status register)
+ * @param	status[out] - Status register
+ * @return 	0 in case of success, negative error code otherwise
+ */
+static int32_t ad5933_sweep_wait_valid(struct ad5933_dev *dev, uint8_t *status)
+{
+	uint32_t polls;
+	int32_t ret;
+
+	for (polls = 0; polls < AD5933_SWEEP_POLL_TIMEOUT; polls++) {
+		ret = no_os_i2c_read(dev->i2c_desc, status, 1, 1);
+		if (ret) {
+			return ret;
+		}
+
+		if (*status & AD5933_STAT_DATA_VALID) {
+			return 0;
+		}
+	}
+
+	return -ETIMEDOUT;
+}
+
+/**
+ * @brief 	Read the real and imaginary data of the current point.
+ * @param	dev[in] - AD5933 device
+ * @param	real[out] - DFT real data
+ * @param	imag[out] - DFT imaginary data
+ * @return 	0 in case of success, negative error code otherwise
+ */
+static int32_t ad5933_sweep_read_data(struct ad5933_dev *dev, int16_t *real,
+				      int16_t *imag)
+{
+	uint8_t cmd[2] = { AD5933_SWEEP_CMD_BLOCK_READ, AD5933_SWEEP_DATA_SIZE };
+	uint8_t data[AD5933_SWEEP_DATA_SIZE];
+	int32_t ret;
+
+	ret = ad5933_sweep_set_pointer(dev, AD5933_REG_REAL_DATA);
+	if (ret) {
+		return ret;
+	}
+
+	ret = no_os_i2c_write(dev->i2c_desc, cmd, sizeof(cmd), 0);
+	if (ret) {
+		return ret;
+	}
+
+	ret = no_os_i2c_read(dev->i2c_desc, data, sizeof(data), 1);
+	if (ret) {
+		return ret;
+	}
+
+	*real = (int16_t)((data[0] << 8) | data[1]);
+	*imag = (int16_t)((data[2] << 8) | data[3]);
+
+	return 0;
+}
+
+/**
+ * @brief 	Run one frequency sweep.
+ * @param	desc[in] - Sweep engine descriptor
+ * @param	records[out] - Records of the sweep points
+ * @param	max_records[in] - Number of records available (at least the
+ *			number of increments + 1)
+ * @param	nb_records[out] - Number of records of the sweep
+ * @return 	0 in case of success, negative error code otherwise
+ * @note	The sweep parameters must have been programmed with
+ *			ad5933_config_sweep().
+ */
+int32_t ad5933_sweep_run(struct ad5933_sweep_desc *desc,
+			 struct ad5933_sweep_record *records, uint16_t max_records,
+			 uint16_t *nb_records)
+{
+	struct ad5933_sweep_record *record;
+	struct ad5933_dev *dev;
+	uint8_t inc_freq_cmd[2];
+	float magnitude;
+	uint8_t status;
+	uint16_t point;
+	bool last;
+	int32_t ret;
+
+	if (!desc || !desc->dev || !records || !nb_records
+	    || max_records <= desc->nb_increments) {
+		return -EINVAL;
+	}
+
+	dev = desc->dev;
+	*nb_records = 0;
+
+	/* Control register write (register address and value) */
+	inc_freq_cmd[0] = AD5933_REG_CONTROL_HB;
+	inc_freq_cmd[1] = AD5933_CONTROL_FUNCTION(AD5933_FUNCTION_INC_FREQ) |
+			  AD5933_CONTROL_RANGE(dev->current_range) |
+			  AD5933_CONTROL_PGA_GAIN(dev->current_gain);
+
+	/* Standby, initialize with the start frequency and start the sweep
+	 * (returns once the first point is valid) */
+	ad5933_start_sweep(dev);
+
+	ret = ad5933_sweep_set_pointer(dev, AD5933_REG_STATUS);
+	if (ret) {
+		return ret;
+	}
+
+	for (point = 0; point <= desc->nb_increments; point++) {
+		ret = ad5933_sweep_wait_valid(dev, &status);
+		if (ret) {
+			return ret;
+		}
+
+		record = &records[point];
+		ret = ad5933_sweep_read_data(dev, &record->real, &record->imag);
+		if (ret) {
+			return ret;
+		}
+
+		/* Start the next point before processing this one */
+		last = (status & AD5933_STAT_SWEEP_DONE) || point == desc->nb_increments;
+		if (!last) {
+			ret = no_os_i2c_write(dev->i2c_desc, inc_freq_cmd, sizeof(inc_freq_cmd), 1);
+			if (ret) {
+				return ret;
+			}
+		}
+
+		ret = ad5933_sweep_set_pointer(dev, AD5933_REG_STATUS);
+		if (ret) {
+			return ret;
+		}
+
+		magnitude = sqrtf((float)record->real * record->real +
+				  (float)record->imag * record->imag);
+
+		record->freq = desc->start_freq + (uint32_t)point * desc->freq_inc;
+		record->impedance = 1.0f / (magnitude * (float)desc->gain_factor);
+		record->phase = atan2f(record->imag, record->real) * AD5933_SWEEP_RAD_TO_DEG;
+
+		if (desc->record_ready) {
+			desc->record_ready(desc->ctx, record);
+		}
+
+		*nb_records = point + 1;
+
+		if (last) {
+			break;
+		}
+	}
+
+	return 0;
+}
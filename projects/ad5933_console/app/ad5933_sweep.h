@@ -0,0 +1,100 @@
+/***************************************************************************//**
+ * @file    ad5933_sweep.h
+ * @brief   Pipelined AD5933 frequency sweep engine
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD5933_SWEEP_H_
+#define _AD5933_SWEEP_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "ad5933.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Sync word starting every binary sweep frame ("ADZS" in wire order) */
+#define AD5933_SWEEP_SYNC		0x535A4441
+
+/* Frequency of the records padding a frame for the points not measured,
+ * when the sweep ended before its last increment */
+#define AD5933_SWEEP_FREQ_MISSING	0
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct ad5933_sweep_header
+ * @brief Header of a binary sweep frame, followed by nb_points records
+ *        (little endian), the missing points being flagged with
+ *        AD5933_SWEEP_FREQ_MISSING
+ */
+struct ad5933_sweep_header {
+	/* AD5933_SWEEP_SYNC */
+	uint32_t sync;
+	/* Sweep index since the start of the acquisition */
+	uint32_t sweep;
+	/* Time of the sweep start (in ms) */
+	uint32_t timestamp_ms;
+	/* Number of records following the header */
+	uint16_t nb_points;
+	/* Size of a record (in bytes) */
+	uint16_t record_size;
+};
+
+/**
+ * @struct ad5933_sweep_record
+ * @brief Result of one frequency point (little endian)
+ */
+struct ad5933_sweep_record {
+	/* Excitation frequency (in Hz) */
+	uint32_t freq;
+	/* DFT real and imaginary data */
+	int16_t real;
+	int16_t imag;
+	/* Impedance magnitude (in ohms) */
+	float impedance;
+	/* Phase of the DFT result (in degrees, system phase not removed) */
+	float phase;
+};
+
+/**
+ * @struct ad5933_sweep_desc
+ * @brief Sweep engine descriptor
+ */
+struct ad5933_sweep_desc {
+	/* AD5933 device (sweep parameters already programmed) */
+	struct ad5933_dev *dev;
+	/* Gain factor (see ad5933_calculate_gain_factor) */
+	double gain_factor;
+	/* Start frequency and frequency increment (in Hz) */
+	uint32_t start_freq;
+	uint32_t freq_inc;
+	/* Number of increments (points - 1) */
+	uint16_t nb_increments;
+	/* Called for every record once the next point conversion is started
+	 * (optional) */
+	void (*record_ready)(void *ctx, const struct ad5933_sweep_record *record);
+	/* Context of record_ready */
+	void *ctx;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int32_t ad5933_sweep_run(struct ad5933_sweep_desc *desc,
+			 struct ad5933_sweep_record *records, uint16_t max_records,
+			 uint16_t *nb_records);
+
+#endif /* _AD5933_SWEEP_H_ */
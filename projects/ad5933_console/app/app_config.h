@@ -29,6 +29,7 @@
 #define spi_ops stm32_spi_ops
 #define uart_extra_init_params 	stm32_uart_extra_init_params
 #define i2c_init_extra_params   stm32_i2c_extra_init_params
+#define get_time_ms				stm32_get_time_ms
 #else
 #error "No/Invalid active platform selected"
 #endif
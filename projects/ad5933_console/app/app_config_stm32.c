@@ -63,3 +63,12 @@ void stm32_system_init(void)
 	MX_I2C1_Init();
 }
 
+/**
+ * @brief Get the time since the system start
+ * @return Time (in ms)
+ */
+uint32_t stm32_get_time_ms(void)
+{
+	return HAL_GetTick();
+}
+
@@ -79,5 +79,6 @@ extern struct stm32_spi_init_param stm32_spi_extra_init_params;
 extern struct stm32_i2c_init_param stm32_i2c_extra_init_params;
 
 extern void stm32_system_init(void);
+uint32_t stm32_get_time_ms(void);
 
 #endif // APP_CONFIG_STM32_H_
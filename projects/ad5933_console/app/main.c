@@ -17,13 +17,16 @@
 #include "no_os_uart.h"
 #include "no_os_error.h"
 #include "no_os_delay.h"
+#include "no_os_util.h"
 #include "app_config.h"
+#include "ad5933_sweep.h"
 
 //Lower this value if storage becomes a problem
 #define MAX_FREQ_INCREMENTS 511
 #define TEMP_LIMIT_MIN -40
 #define TEMP_LIMIT_MAX 125
 #define MAX_SETTLING_CYCLES  511
+#define MAX_STREAM_SWEEPS 10000
 #define EOL "\r\n"
 
 static void print_title(void);
@@ -36,6 +39,7 @@ static int32_t configure_system();
 static uint8_t calculate_gain_factor();
 static uint8_t guide();
 static uint8_t impedance_sweep();
+static int32_t impedance_sweep_stream();
 
 typedef struct ad5933_config_data {
 	float 	start_freq;
@@ -52,6 +56,9 @@ ad5933_config_data config_data;
 static double gain_factor = 0;
 static double temperature;
 
+/* Records of the last sweep */
+static struct ad5933_sweep_record sweep_records[MAX_FREQ_INCREMENTS + 1];
+
 
 /******************************************************************************/
 /************************** Variables Declarations ****************************/
@@ -142,6 +149,9 @@ int main()
 			case 4:
 				impedance_sweep();
 				break;
+			case 5:
+				impedance_sweep_stream();
+				break;
 
 			default:
 				printf("Invalid option: Ignored.");
@@ -177,6 +187,7 @@ void print_prompt()
 	printf("  2  -Configure voltage-range, PGA-Gain and sweep parameters" EOL);
 	printf("  3  -Calculate Gain-Factor" EOL);
 	printf("  4  -Do an impedance sweep" EOL);
+	printf("  5  -Stream repeated impedance sweeps (binary)" EOL);
 	printf("\n\rMake a selection..." EOL);
 
 }
@@ -470,48 +481,157 @@ static uint8_t guide()
 	return 0;
 }
 
+/**
+ * @brief	Get the sweep engine descriptor for the configured sweep
+ * @param	desc[out] - Sweep engine descriptor
+ * @return	none
+ */
+static void get_sweep_desc(struct ad5933_sweep_desc *desc)
+{
+	desc->dev = device;
+	desc->gain_factor = gain_factor;
+	desc->start_freq = (uint32_t)config_data.start_freq;
+	desc->freq_inc = config_data.frequency_increment;
+	desc->nb_increments = config_data.number_increments;
+	desc->record_ready = NULL;
+	desc->ctx = NULL;
+}
+
 static uint8_t impedance_sweep()
 {
 	printf("\nPerform a sweep to calculate an unknown impedance (see data-sheet for information)"EOL);
 	printf("System should have been previously configured (Menu Option 2)" EOL);
 	printf("Impedance will be calculated and results shown.\n\r");
 
-	int32_t status = -EINVAL;
-	double impedance;
-	float frequency = config_data.start_freq;
+	struct ad5933_sweep_desc sweep_desc;
+	uint16_t nb_records;
+	uint16_t point;
+	int32_t ret;
+
+	ad5933_config_sweep(device,
+			    config_data.start_freq,
+			    config_data.frequency_increment,
+			    config_data.number_increments);
 
+	/* Results are printed once the sweep is done, the UART formatting
+	 * being slower than the point conversions */
+	get_sweep_desc(&sweep_desc);
+	ret = ad5933_sweep_run(&sweep_desc, sweep_records,
+			       NO_OS_ARRAY_SIZE(sweep_records), &nb_records);
+	if (ret) {
+		printf(EOL "Impedance sweep failed (%d)" EOL, (int)ret);
+		return ret;
+	}
+
+	printf(EOL" FREQUENCY   IMPEDANCE   PHASE" EOL);
+
+	for (point = 0; point < nb_records; point++) {
+		printf("  %lu,", (unsigned long)sweep_records[point].freq);
+		printf("  %.2f,", sweep_records[point].impedance);
+		printf("  %.2f\n", sweep_records[point].phase);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief	Stream a sweep record over the UART
+ * @param	ctx[in] - Context (unused)
+ * @param	record[in] - Sweep record
+ * @return	none
+ * @note	Called while the next point is converted. The records are sent
+ *			as laid out in memory (little endian, no padding).
+ */
+static void stream_sweep_record(void *ctx, const struct ad5933_sweep_record *record)
+{
+	no_os_uart_write(uart_desc, (const uint8_t *)record, sizeof(*record));
+}
+
+/**
+ * @brief	Complete a streamed sweep frame up to the points of its header
+ * @param	nb_records[in] - Number of records streamed
+ * @param	nb_points[in] - Number of points in the frame header
+ * @return	none
+ * @note	The header is sent before the sweep, which can end early on the
+ *			sweep complete status (or on an error). The points not measured
+ *			are sent as records with the AD5933_SWEEP_FREQ_MISSING frequency.
+ */
+static void stream_missing_records(uint16_t nb_records, uint16_t nb_points)
+{
+	const struct ad5933_sweep_record missing = {
+		.freq = AD5933_SWEEP_FREQ_MISSING
+	};
+
+	for (; nb_records < nb_points; nb_records++) {
+		stream_sweep_record(NULL, &missing);
+	}
+}
+
+/**
+ * @brief	Stream repeated impedance sweeps in binary frames
+ * @return	0 in case of success, negative error code otherwise
+ * @details	Every sweep is sent as a struct ad5933_sweep_header followed by
+ *			the records of the sweep points, for time resolved impedance
+ *			spectroscopy. A text line ends the acquisition.
+ */
+static int32_t impedance_sweep_stream()
+{
+	struct ad5933_sweep_header header;
+	struct ad5933_sweep_desc sweep_desc;
+	uint16_t nb_records;
+	int nb_sweeps;
+	int invalid_check;
+	int sweep;
+	int32_t ret = 0;
+
+	printf("\nStream repeated impedance sweeps as binary frames" EOL);
+	printf("System should have been previously configured (Menu Option 2)" EOL);
+	printf("Enter the number of sweeps (1 to %d): ", MAX_STREAM_SWEEPS);
+
+	invalid_check = scanf("%d", &nb_sweeps);
+	ret = input_check(nb_sweeps, 1, MAX_STREAM_SWEEPS, invalid_check);
+	if (ret) {
+		return ret;
+	}
 
 	ad5933_config_sweep(device,
 			    config_data.start_freq,
 			    config_data.frequency_increment,
 			    config_data.number_increments);
 
-	/*
-		> program frequency sweep parameters into relevant registerS
-		> place the ad5933 into standby mode.
-		> start frequency register
-		> number of increments register
-	*/
-	ad5933_start_sweep(device);
-	printf(EOL" FREQUENCY MAGNITUDE   PHASE	IMPEDANCE" EOL);
+	get_sweep_desc(&sweep_desc);
+	sweep_desc.record_ready = stream_sweep_record;
 
-	do {
-		//Fill up the results struct with data
-		impedance = ad5933_calculate_impedance(device,
-						       gain_factor,
-						       AD5933_FUNCTION_INC_FREQ);
+	header.sync = AD5933_SWEEP_SYNC;
+	/* Number of increments + 1, the points missing when a sweep ends early
+	 * being padded */
+	header.nb_points = sweep_desc.nb_increments + 1;
+	header.record_size = sizeof(struct ad5933_sweep_record);
 
-		printf("  %.2f,", frequency);
-		printf("  %.2f\n", impedance);
+	printf(EOL "Streaming %d sweeps" EOL, nb_sweeps);
+	fflush(stdout);
 
-		frequency += config_data.frequency_increment;
+	for (sweep = 0; sweep < nb_sweeps; sweep++) {
+		header.sweep = sweep;
+		header.timestamp_ms = get_time_ms();
+		no_os_uart_write(uart_desc, (const uint8_t *)&header, sizeof(header));
 
-		//poll the status register to check if frequency sweep is complete.
-		status = ad5933_get_register_value(device, AD5933_REG_STATUS, 1);
+		nb_records = 0;
+		ret = ad5933_sweep_run(&sweep_desc, sweep_records,
+				       NO_OS_ARRAY_SIZE(sweep_records), &nb_records);
+		stream_missing_records(nb_records, header.nb_points);
+		if (ret) {
+			break;
+		}
+	}
 
-	} while ((status & AD5933_STAT_SWEEP_DONE) == 0);
+	if (ret) {
+		printf(EOL "Sweep streaming failed (%d)" EOL, (int)ret);
+	} else {
+		printf(EOL "Sweep streaming done" EOL);
+	}
 
-	return status;
+	return ret;
 }
 
 /*******************************************************************************
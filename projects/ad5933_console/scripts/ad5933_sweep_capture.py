@@ -0,0 +1,75 @@
+import csv
+import struct
+import sys
+from serial import Serial
+
+# Binary sweep frame layout (see app/ad5933_sweep.h)
+SWEEP_SYNC = 0x535A4441
+HEADER_FORMAT = "<IIIHH"    # sync, sweep, timestamp_ms, nb_points, record_size
+RECORD_FORMAT = "<Ihhff"    # freq, real, imag, impedance, phase
+FREQ_MISSING = 0            # Frequency of the records padding a sweep ended early
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+def read_exact(port, size):
+    data = port.read(size)
+    if len(data) != size:
+        raise TimeoutError("Sweep stream timed out")
+    return data
+
+def sync_to_frame(port):
+    # Drop the bytes (menu echo) preceding the first frame header
+    window = b''
+    sync = struct.pack("<I", SWEEP_SYNC)
+    while window != sync:
+        window = (window + read_exact(port, 1))[-4:]
+    return sync
+
+def main():
+    ######## User configuration ##########
+    com_port = "COM16"      # Physical or virtual COM port of the firmware
+    baud_rate = 230400      # Must be same as set in the firmware
+    nb_sweeps = 100         # Number of sweeps to capture
+    csv_file = "ad5933_sweeps.csv"
+    ######################################
+
+    if len(sys.argv) > 1:
+        nb_sweeps = int(sys.argv[1])
+
+    port = Serial(com_port, baud_rate, timeout=10)
+    port.reset_input_buffer()
+
+    # Select the streaming menu option and the number of sweeps
+    port.write(b'5\n')
+    port.write(f'{nb_sweeps}\n'.encode())
+
+    with open(csv_file, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(["sweep", "timestamp_ms", "freq_hz", "real", "imag",
+                         "impedance_ohm", "phase_deg"])
+
+        header = sync_to_frame(port) + read_exact(port, HEADER_SIZE - 4)
+        for _ in range(nb_sweeps):
+            sync, sweep, timestamp_ms, nb_points, record_size = \
+                struct.unpack(HEADER_FORMAT, header)
+            if sync != SWEEP_SYNC or record_size != RECORD_SIZE:
+                raise ValueError("Invalid sweep frame header")
+
+            records = read_exact(port, nb_points * RECORD_SIZE)
+            nb_measured = 0
+            for record in struct.iter_unpack(RECORD_FORMAT, records):
+                if record[0] == FREQ_MISSING:
+                    continue
+                writer.writerow([sweep, timestamp_ms, *record])
+                nb_measured += 1
+
+            print(f"Sweep {sweep}: {nb_measured}/{nb_points} points at {timestamp_ms} ms")
+
+            if sweep + 1 < nb_sweeps:
+                header = read_exact(port, HEADER_SIZE)
+
+    port.close()
+    print(f"Sweeps saved to {csv_file}")
+
+if __name__ == "__main__":
+    main()
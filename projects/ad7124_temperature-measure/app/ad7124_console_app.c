@@ -27,6 +27,7 @@
 #include "no_os_util.h"
 #include "no_os_error.h"
 #include "no_os_spi.h"
+#include "no_os_delay.h"
 
 #include "ad7124.h"
 #include "ad7124_regs.h"
@@ -37,6 +38,10 @@
 #include "ad7124_console_app.h"
 #include "ad7124_temperature_sensor.h"
 
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+#include "stm32_cycle_counter.h"
+#endif
+
 /******************************************************************************/
 /********************* Macros and Constants Definitions ***********************/
 /******************************************************************************/
@@ -72,6 +77,15 @@
  **/
 #define CONVERSION_TIMEOUT			10000
 
+/* Settling time after enabling the sensor channel(s), before sampling */
+#define CHANNEL_SETTLING_TIME_MS	100
+
+/* Max setups of the AD7124 (one per channel in the scan sequencer) */
+#define AD7124_MAX_SETUPS			8
+
+/* Registers of a setup (Config, Filter, Gain and Offset) */
+#define AD7124_SETUP_REGS			4
+
 /******************************************************************************/
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
@@ -85,6 +99,14 @@ static struct ad7124_st_reg ad7124_register_map[AD7124_REG_NO];
 /* Pointer to the struct representing the AD7124 device */
 static struct ad7124_dev *p_ad7124_dev = NULL;
 
+/* First register of each setup register type (setup 0) */
+static const uint8_t ad7124_setup_reg_ids[AD7124_SETUP_REGS] = {
+	AD7124_Config_0,
+	AD7124_Filter_0,
+	AD7124_Gain_0,
+	AD7124_Offset_0
+};
+
 /* Possible sensor configurations (mapped with enum sensor_config_ids) */
 static const char *sensor_configs[NUMBER_OF_SENSOR_CONFIGS] = {
 	"RESET",
@@ -144,6 +166,9 @@ static enum sensor_config_ids current_sensor_config_id;
 /* ADC raw data for n samples */
 static int32_t n_sample_data[NUM_OF_SENSOR_CHANNELS][MAX_ADC_SAMPLES];
 
+/* NTC thermistor temperatures for n samples */
+static float n_ntc_temperature[NUM_OF_SENSOR_CHANNELS][MAX_ADC_SAMPLES];
+
 /* CJC sensor ADC raw data for n samples */
 static int32_t n_cjc_sample_data[MAX_THERMOCOUPLE_SENSORS][MAX_ADC_SAMPLES];
 
@@ -210,6 +235,14 @@ enum rtd_3wire_calibration_type rtd_3wire_calibration_type =
 /* Below channel is configured through 'ad7124_regs_config_3wire_rtd' structure*/
 #define	RTD_3WIRE_REF_MEASUREMENT_CHN	SENSOR_CHANNEL4
 
+/* Scan all the enabled sensors in one continuous conversion (channel sequencer)
+ * rather than one channel at a time. Used for the sensors sharing the same
+ * excitation, i.e. the NTC thermistors */
+static bool scan_sequencer_enabled = true;
+
+/* Duration of the last sensors scan (in usec, 0 if not measured) */
+static uint32_t last_scan_time_us;
+
 /* Forward declaration of console menus */
 console_menu rtd_2wire_menu;
 console_menu rtd_3wire_menu;
@@ -450,7 +483,7 @@ static int32_t perform_adc_conversion(uint8_t chn,
 	}
 
 	/* Let the channel settle */
-	no_os_mdelay(100);
+	no_os_mdelay(CHANNEL_SETTLING_TIME_MS);
 
 	/* Read adc samples */
 	for (uint16_t sample = 0; sample < samples_cnt; sample++) {
@@ -505,6 +538,251 @@ static int32_t perform_adc_conversion(uint8_t chn,
 }
 
 
+/*!
+ * @brief	Get a time stamp for the scan time measurement
+ * @return	Time stamp (core clock cycles on STM32 platform, usec otherwise)
+ */
+static uint32_t get_scan_timestamp(void)
+{
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+	return stm32_cycle_counter_get();
+#else
+	struct no_os_time now = no_os_get_time();
+
+	return now.s * 1000000 + now.us;
+#endif
+}
+
+
+/*!
+ * @brief	Get the time elapsed since a scan time stamp
+ * @param	start[in] - Time stamp at the start of the scan
+ * @return	Elapsed time (in usec)
+ */
+static uint32_t get_scan_time_us(uint32_t start)
+{
+#if (ACTIVE_PLATFORM == STM32_PLATFORM)
+	return (uint32_t)(((uint64_t)(stm32_cycle_counter_get() - start) * 1000000) /
+			  stm32_cycle_counter_freq());
+#else
+	return get_scan_timestamp() - start;
+#endif
+}
+
+
+/*!
+ * @brief	Perform the ADC data conversion for all the enabled channels at once
+ * @param	chn_enable[in] - Enable status of the channels to be sampled
+ * @param	nb_chns[in] - Number of channels in the enable status array
+ * @param	data[out] - Arrays to store converted results (one per channel)
+ * @param	measurement_type[in] - Temperature measurement and display type
+ * @return	0 in case of success, negative error code otherwise
+ * @note	All the enabled channels are programmed in the channel map and
+ *			sampled by the ADC sequencer in one continuous conversion, after a
+ *			single settling time. The status byte is appended to every sample
+ *			(DATA_STATUS) and the samples are demultiplexed using its active
+ *			channel bits. When the ADC calibration is done, each channel is
+ *			given its own setup so that its calibration coefficients apply
+ *			while the sequencer switches channels. The channels and setups
+ *			are restored once the sequence is over.
+ */
+static int32_t perform_adc_sequence(const bool *chn_enable, uint8_t nb_chns,
+				    int32_t (*data)[MAX_ADC_SAMPLES],
+				    sensor_measurement_type measurement_type)
+{
+	uint16_t chn_map[NUM_OF_SENSOR_CHANNELS];
+	uint32_t setup_regs[NUM_OF_SENSOR_CHANNELS][AD7124_SETUP_REGS];
+	uint32_t adc_ctrl_data_status;
+	int64_t avg_sample_data[NUM_OF_SENSOR_CHANNELS] = { 0 };
+	uint16_t samples_read[NUM_OF_SENSOR_CHANNELS] = { 0 };
+	uint8_t chns_pending = 0;
+	uint16_t samples_cnt;
+	int32_t sample_data;
+	uint8_t setup;
+	uint8_t chn;
+	uint8_t reg;
+	uint8_t reg_id;
+	int32_t ret = 0;
+
+	if (nb_chns > NUM_OF_SENSOR_CHANNELS || nb_chns > AD7124_MAX_SETUPS) {
+		return -EINVAL;
+	}
+
+	if (measurement_type == AVERAGED_MEASUREMENT) {
+		samples_cnt = MAX_AVG_ADC_SAMPLES;
+	} else {
+		samples_cnt = MAX_ADC_SAMPLES;
+	}
+
+	/* Save the channels and the setups dedicated to them in the sequence */
+	for (chn = 0; chn < nb_chns; chn++) {
+		chn_map[chn] = ad7124_register_map[AD7124_Channel_0 + chn].value;
+
+		for (reg = 0; reg < AD7124_SETUP_REGS; reg++) {
+			setup_regs[chn][reg] =
+				ad7124_register_map[ad7124_setup_reg_ids[reg] + chn].value;
+		}
+	}
+
+	adc_ctrl_data_status = ad7124_register_map[AD7124_ADC_Control].value &
+			       AD7124_ADC_CTRL_REG_DATA_STATUS;
+
+	/* Program all the enabled channels into the channel map */
+	for (chn = 0; chn < nb_chns; chn++) {
+		if (!chn_enable[chn]) {
+			continue;
+		}
+
+		if (adc_calibration_config.adc_calibration_done) {
+			/* Copy the channel setup into the setup dedicated to the channel.
+			 * The setups dedicated to the previous channels are already
+			 * overwritten, so these are copied from the saved registers
+			 * (Config and Filter being the first setup registers) */
+			setup = ad7124_get_channel_setup(p_ad7124_dev, chn);
+			if (setup < nb_chns) {
+				ad7124_register_map[AD7124_Config_0 + chn].value = setup_regs[setup][0];
+				ad7124_register_map[AD7124_Filter_0 + chn].value = setup_regs[setup][1];
+			} else {
+				ad7124_register_map[AD7124_Config_0 + chn].value =
+					ad7124_register_map[AD7124_Config_0 + setup].value;
+				ad7124_register_map[AD7124_Filter_0 + chn].value =
+					ad7124_register_map[AD7124_Filter_0 + setup].value;
+			}
+			ad7124_register_map[AD7124_Gain_0 + chn].value =
+				adc_calibration_config.gain_after_calib[chn];
+			ad7124_register_map[AD7124_Offset_0 + chn].value =
+				adc_calibration_config.offset_after_calib[chn];
+
+			if (ad7124_write_register(p_ad7124_dev,
+						  ad7124_register_map[AD7124_Config_0 + chn]) != 0
+			    || ad7124_write_register(p_ad7124_dev,
+						     ad7124_register_map[AD7124_Filter_0 + chn]) != 0
+			    || ad7124_write_register(p_ad7124_dev,
+						     ad7124_register_map[AD7124_Gain_0 + chn]) != 0
+			    || ad7124_write_register(p_ad7124_dev,
+						     ad7124_register_map[AD7124_Offset_0 + chn]) != 0) {
+				ret = -EIO;
+				goto restore_chns;
+			}
+
+			ad7124_register_map[AD7124_Channel_0 + chn].value &=
+				~AD7124_CH_MAP_REG_SETUP(AD7124_MAX_SETUPS - 1);
+			ad7124_register_map[AD7124_Channel_0 + chn].value |=
+				AD7124_CH_MAP_REG_SETUP(chn);
+		}
+
+		ad7124_register_map[AD7124_Channel_0 + chn].value |=
+			AD7124_CH_MAP_REG_CH_ENABLE;
+		if (ad7124_write_register(p_ad7124_dev,
+					  ad7124_register_map[AD7124_Channel_0 + chn]) != 0) {
+			ret = -EIO;
+			goto restore_chns;
+		}
+
+		chns_pending++;
+	}
+
+	/* Enter into continuous conversion mode, with the status appended to
+	 * the data so that every sample carries its own channel */
+	ad7124_register_map[AD7124_ADC_Control].value &= (~AD7124_ADC_CTRL_REG_MSK);
+	ad7124_register_map[AD7124_ADC_Control].value |= AD7124_ADC_CTRL_REG_MODE(
+				CONTINUOUS_CONV_MODE) | AD7124_ADC_CTRL_REG_DATA_STATUS;
+	if (ad7124_write_register(p_ad7124_dev,
+				  ad7124_register_map[AD7124_ADC_Control]) != 0) {
+		ret = -EIO;
+		goto restore_chns;
+	}
+
+	/* Let the channels settle (once for the whole scan) */
+	no_os_mdelay(CHANNEL_SETTLING_TIME_MS);
+
+	/* Read the sequenced samples until every channel has its samples */
+	while (chns_pending) {
+		ret = no_os_gpio_set_value(csb_gpio, NO_OS_GPIO_LOW);
+		if (ret) {
+			break;
+		}
+
+		if (ad7124_wait_for_conv_ready(p_ad7124_dev, CONVERSION_TIMEOUT) != 0) {
+			break;
+		}
+
+		/* The status byte appended to the data is stored into the status
+		 * register, so the channel is the one of this very sample even if
+		 * the next conversion completed since READY was polled */
+		if (ad7124_read_data(p_ad7124_dev, &sample_data) != 0) {
+			break;
+		}
+
+		chn = ad7124_register_map[AD7124_Status].value &
+		      AD7124_STATUS_REG_CH_ACTIVE(0xF);
+		if (chn >= nb_chns || !chn_enable[chn]
+		    || samples_read[chn] >= samples_cnt) {
+			continue;
+		}
+
+		if (measurement_type == AVERAGED_MEASUREMENT) {
+			avg_sample_data[chn] += sample_data;
+		} else {
+			data[chn][samples_read[chn]] = sample_data;
+		}
+
+		if (++samples_read[chn] == samples_cnt) {
+			chns_pending--;
+		}
+	}
+
+	if (!ret && chns_pending) {
+		/* Conversion timed out before all the channels were sampled */
+		ret = -EIO;
+	}
+
+	/* Put ADC into Standby mode */
+	ad7124_register_map[AD7124_ADC_Control].value &= ~(AD7124_ADC_CTRL_REG_MSK
+			| AD7124_ADC_CTRL_REG_DATA_STATUS);
+	ad7124_register_map[AD7124_ADC_Control].value |= AD7124_ADC_CTRL_REG_MODE(
+				STANDBY_MODE) | adc_ctrl_data_status;
+	if (ad7124_write_register(p_ad7124_dev,
+				  ad7124_register_map[AD7124_ADC_Control]) != 0) {
+		ret = -EIO;
+	}
+
+	if (measurement_type == AVERAGED_MEASUREMENT) {
+		/* Calculate the averaged adc raw values */
+		for (chn = 0; chn < nb_chns; chn++) {
+			if (chn_enable[chn] && samples_read[chn]) {
+				data[chn][0] = (avg_sample_data[chn] / samples_read[chn]);
+			}
+		}
+	}
+
+restore_chns:
+	/* Disable the channels and restore their setups */
+	for (chn = 0; chn < nb_chns; chn++) {
+		if (ad7124_register_map[AD7124_Channel_0 + chn].value != chn_map[chn]) {
+			ad7124_register_map[AD7124_Channel_0 + chn].value = chn_map[chn];
+			if (ad7124_write_register(p_ad7124_dev,
+						  ad7124_register_map[AD7124_Channel_0 + chn]) != 0) {
+				ret = -EIO;
+			}
+		}
+
+		for (reg = 0; reg < AD7124_SETUP_REGS; reg++) {
+			reg_id = ad7124_setup_reg_ids[reg] + chn;
+			if (ad7124_register_map[reg_id].value != setup_regs[chn][reg]) {
+				ad7124_register_map[reg_id].value = setup_regs[chn][reg];
+				if (ad7124_write_register(p_ad7124_dev,
+							  ad7124_register_map[reg_id]) != 0) {
+					ret = -EIO;
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
+
 /*!
  * @brief	Perform the 3-wire RTD additional configurations
  * @param	multiple_rtd_enabled[in,out]- Multiple RTD enable status flag
@@ -1184,6 +1462,20 @@ static int32_t calibrate_and_measure_3wire_rtd(uint32_t measurement_type)
 }
 
 
+/*!
+ * @brief	Toggle the sensors scan between the sequencer and per channel modes
+ * @param	menu_id[in]- Optional menu ID
+ * @return	MENU_CONTINUE
+ */
+int32_t toggle_scan_sequencer(uint32_t menu_id)
+{
+	scan_sequencer_enabled = !scan_sequencer_enabled;
+	last_scan_time_us = 0;
+
+	return MENU_CONTINUE;
+}
+
+
 /*!
  * @brief	Perform the multiple NTC thermistor sensors measurement
  * @param	measurement_type[in]- Temperature measurement and display type
@@ -1195,6 +1487,7 @@ int32_t perform_ntc_thermistor_measurement(uint32_t measurement_type)
 	uint16_t sample_cnt;
 	bool continue_measurement = false;
 	float temperature;
+	uint32_t scan_start;
 	uint8_t setup;
 
 	if (measurement_type == CONTINUOUS_MEASUREMENT) {
@@ -1214,40 +1507,53 @@ int32_t perform_ntc_thermistor_measurement(uint32_t measurement_type)
 	printf(EOL "\t-----------------------------------------------" EOL EOL);
 
 	do {
-		/* Sample and Read all enabled NTC channels in sequence */
-		for (uint8_t chn = SENSOR_CHANNEL0;
-		     chn < max_supported_sensors[AD7124_CONFIG_THERMISTOR];
-		     chn++) {
-			if (sensor_enable_status[chn]) {
-				/* Apply previous calibration coefficients while performing new measurement  */
-				if (adc_calibration_config.adc_calibration_done) {
-					setup =  ad7124_get_channel_setup(p_ad7124_dev, chn);
+		scan_start = get_scan_timestamp();
 
-					ad7124_register_map[AD7124_Gain_0 + setup].value =
-						adc_calibration_config.gain_after_calib[chn];
-					if (ad7124_write_register(p_ad7124_dev,
-								  ad7124_register_map[AD7124_Gain_0 + setup]) != 0) {
-						adc_error = true;
-						break;
+		if (scan_sequencer_enabled) {
+			/* Sample all enabled NTC channels in one sequenced conversion */
+			if (perform_adc_sequence(sensor_enable_status,
+						 max_supported_sensors[AD7124_CONFIG_THERMISTOR],
+						 n_sample_data, measurement_type) != 0) {
+				adc_error = true;
+			}
+		} else {
+			/* Sample and Read all enabled NTC channels one at a time */
+			for (uint8_t chn = SENSOR_CHANNEL0;
+			     chn < max_supported_sensors[AD7124_CONFIG_THERMISTOR];
+			     chn++) {
+				if (sensor_enable_status[chn]) {
+					/* Apply previous calibration coefficients while performing new measurement  */
+					if (adc_calibration_config.adc_calibration_done) {
+						setup =  ad7124_get_channel_setup(p_ad7124_dev, chn);
+
+						ad7124_register_map[AD7124_Gain_0 + setup].value =
+							adc_calibration_config.gain_after_calib[chn];
+						if (ad7124_write_register(p_ad7124_dev,
+									  ad7124_register_map[AD7124_Gain_0 + setup]) != 0) {
+							adc_error = true;
+							break;
+						}
+
+						ad7124_register_map[AD7124_Offset_0 + setup].value =
+							adc_calibration_config.offset_after_calib[chn];
+						if (ad7124_write_register(p_ad7124_dev,
+									  ad7124_register_map[AD7124_Offset_0 + setup]) != 0) {
+							adc_error = true;
+							break;
+						}
 					}
 
-					ad7124_register_map[AD7124_Offset_0 + setup].value =
-						adc_calibration_config.offset_after_calib[chn];
-					if (ad7124_write_register(p_ad7124_dev,
-								  ad7124_register_map[AD7124_Offset_0 + setup]) != 0) {
+					if (perform_adc_conversion(chn, &n_sample_data[chn],
+								   measurement_type) != 0) {
 						adc_error = true;
 						break;
 					}
 				}
-
-				if (perform_adc_conversion(chn, &n_sample_data[chn],
-							   measurement_type) != 0) {
-					adc_error = true;
-					break;
-				}
 			}
 		}
 
+		last_scan_time_us = get_scan_time_us(scan_start);
+
 		if (adc_error) {
 			printf(EOL EOL "\tError Performing Measurement" EOL);
 			break;
@@ -1266,13 +1572,22 @@ int32_t perform_ntc_thermistor_measurement(uint32_t measurement_type)
 				printf("\t%s" EOL EOL, decimal_eqv_str_arr);
 				decimal_eqv_str_arr[0] = '\0';
 			} else {
+				/* Convert the samples of each channel in one block */
+				for (uint8_t chn = SENSOR_CHANNEL0;
+				     chn < max_supported_sensors[AD7124_CONFIG_THERMISTOR];
+				     chn++) {
+					if (sensor_enable_status[chn]) {
+						get_ntc_thermistor_temperatures(n_sample_data[chn], MAX_ADC_SAMPLES,
+										n_ntc_temperature[chn]);
+					}
+				}
+
 				for (sample_cnt = 0; sample_cnt < MAX_ADC_SAMPLES; sample_cnt++) {
 					for (uint8_t chn = SENSOR_CHANNEL0;
 					     chn < max_supported_sensors[AD7124_CONFIG_THERMISTOR];
 					     chn++) {
 						if (sensor_enable_status[chn]) {
-							temperature = get_ntc_thermistor_temperature(n_sample_data[chn][sample_cnt]);
-							sprintf(decimal_eqv_str, "%.4f  ", temperature);
+							sprintf(decimal_eqv_str, "%.4f  ", n_ntc_temperature[chn][sample_cnt]);
 							strcat(decimal_eqv_str_arr, decimal_eqv_str);
 						}
 					}
@@ -1280,6 +1595,11 @@ int32_t perform_ntc_thermistor_measurement(uint32_t measurement_type)
 					decimal_eqv_str_arr[0] = '\0';
 				}
 			}
+
+			if (last_scan_time_us) {
+				printf("\tScan time: %lu usec (%s)" EOL EOL, last_scan_time_us,
+				       scan_sequencer_enabled ? "sequencer" : "per channel");
+			}
 		}
 	} while (continue_measurement && !was_escape_key_pressed());
 
@@ -2253,6 +2573,12 @@ void ntc_thermistor_menu_header(void)
 	       SENSOR_CHANNEL7, NTC8_THERMISTOR_AINP, NTC8_THERMISTOR_AINM,
 	       status_info[sensor_enable_status[SENSOR_CHANNEL7]]);
 #endif
+	printf(EOL "\t Scan mode: %s",
+	       scan_sequencer_enabled ? "Sequencer" : "Per Channel");
+	if (last_scan_time_us) {
+		printf(" (last scan: %lu usec)", last_scan_time_us);
+	}
+	printf(EOL);
 }
 
 
@@ -2575,6 +2901,8 @@ static console_menu_item ntc_thermistor_menu_items[] = {
 	{ "Perform Averaged Measurement",  'A', perform_ntc_thermistor_measurement, NULL, AVERAGED_MEASUREMENT },
 	{ "Perform Single Measurement",    'S', perform_ntc_thermistor_measurement, NULL, SINGLE_MEASUREMENT },
 	{ "Perform Continuous Measurement", 'C', perform_ntc_thermistor_measurement, NULL, CONTINUOUS_MEASUREMENT },
+	{ " " },
+	{ "Toggle Scan Mode (Sequencer/Per Channel)", 'Q', toggle_scan_sequencer },
 };
 
 console_menu ntc_thermistor_menu = {
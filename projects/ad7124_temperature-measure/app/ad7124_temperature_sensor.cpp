@@ -26,13 +26,11 @@ extern "C"
 {
 #endif //  _cplusplus
 
-#include <thermocouple.h>
-#include <ptxxx.h>
-#include <ntc_10k_44031.h>
 #include <ptc_ky81_110.h>
 #include "ad7124_temperature_sensor.h"
 #include "ad7124_regs_configs.h"
 #include "ad7124_support.h"
+#include "temp_linearizer.h"
 
 #ifdef __cplusplus  // Closing extern c
 }
@@ -42,12 +40,19 @@ extern "C"
 /********************* Macros and Constants Definitions ***********************/
 /******************************************************************************/
 
-/* NTC thermistor Rsense value (in ohms) */
+/* NTC thermistor Rsense value (in ohms), matching temp_lin_ntc_10k_44031 */
 #define NTC_RSENSE			10000U
 
 /* RTD Rref Resistance value (in ohms) */
 #define RTD_RREF			5110U
 
+/* Nominal (0 degC) resistance of the PT100 and PT1000 RTDs (in ohms) */
+#define PT100_R0			100.0f
+#define PT1000_R0			1000.0f
+
+/* Bipolar zero scale code of the ADC */
+#define AD7124_BIPOLAR_ZERO_CODE	(1 << (AD7124_ADC_N_BITS - 1))
+
 /* PTC thermistor Ref Resistance value (in ohms) */
 #define PTC_RREF			5110U
 
@@ -146,15 +151,13 @@ static float convert_adc_raw_into_ntc_voltage(int32_t adc_raw)
 
 
 /*!
- * @brief	Convert the NTC thermistor voltage into equivalent resistance
+ * @brief	Convert the NTC thermistor voltage into the NTC divider ratio
  * @param	voltage[in]- NTC Thermistor voltage
- * @return	NTC Thermistor resistance value
+ * @return	NTC divider ratio, R / (R + NTC_RSENSE)
  */
-static float convert_ntc_voltage_into_resistance(float ntc_voltage)
+static float convert_ntc_voltage_into_ratio(float ntc_voltage)
 {
-	float ntc_resistance = (ntc_voltage * NTC_RSENSE) / (AD7124_REF_VOLTAGE -
-			       ntc_voltage);
-	return ntc_resistance;
+	return (ntc_voltage / AD7124_REF_VOLTAGE);
 }
 
 
@@ -195,25 +198,24 @@ uint32_t get_rtd_rref(void)
 float get_tc_temperature(float tc_sample, float cjc_sample,
 			 cjc_sensor_type cjc_sensor, float *cjc_temp)
 {
-	Thermocouple_Type_T tcSensor;
 	float tc_mv;
 	float tc_temperature;
 	float cjc_temperature;
 
 	tc_mv = convert_raw_adc_into_tc_mv(tc_sample);
-	tc_temperature = tcSensor.convert(tc_mv);
+	tc_temperature = temp_lin_convert(&temp_lin_tc_type_t, tc_mv);
 
 	if (cjc_sensor == PT100_4WIRE_RTD) {
 		cjc_temperature = get_rtd_temperature(cjc_sample, RTD_4WIRE_GAIN_VALUE);
 	} else if (cjc_sensor == THERMISTOR_PTC_KY81_110) {
 		cjc_temperature = get_ptc_thermistor_temperature(cjc_sample);
 	} else if (cjc_sensor == PT1000_2WIRE_RTD) {
-		PT1000 rtd_sensor;
 		float rtd_resistance;
 
 		rtd_resistance = convert_adc_raw_into_rtd_resistance(cjc_sample,
 				 RTD_PT1000_GAIN_VALUE);
-		cjc_temperature = rtd_sensor.convertResistanceToTemperature(rtd_resistance);
+		cjc_temperature = temp_lin_convert(&temp_lin_pt_rtd,
+						   rtd_resistance / PT1000_R0);
 	} else {
 		return 0;
 	}
@@ -238,12 +240,11 @@ float get_tc_temperature(float tc_sample, float cjc_sample,
  */
 float get_rtd_temperature(int32_t rtd_sample, uint8_t gain)
 {
-	PT100 rtd_sensor;
 	float rtd_resistance;
 
 	rtd_resistance = convert_adc_raw_into_rtd_resistance(rtd_sample, gain);
 
-	return rtd_sensor.convertResistanceToTemperature(rtd_resistance);
+	return temp_lin_convert(&temp_lin_pt_rtd, rtd_resistance / PT100_R0);
 }
 
 
@@ -255,14 +256,33 @@ float get_rtd_temperature(int32_t rtd_sample, uint8_t gain)
  */
 float get_ntc_thermistor_temperature(int32_t ntc_sample)
 {
-	ntc_10k_44031rc ntc_thermistor;
 	float ntc_voltage;
-	float ntc_resistance;
 
 	ntc_voltage = convert_adc_raw_into_ntc_voltage(ntc_sample);
-	ntc_resistance = convert_ntc_voltage_into_resistance(ntc_voltage);
 
-	return ntc_thermistor.convert(ntc_resistance);
+	return temp_lin_convert(&temp_lin_ntc_10k_44031,
+				convert_ntc_voltage_into_ratio(ntc_voltage));
+}
+
+
+/**
+ * @brief  	Convert a block of ADC raw values into NTC temperatures
+ * @param	ntc_samples[in] Raw NTC samples
+ * @param	nb_samples[in] Number of samples
+ * @param	temperatures[out] NTC temperatures
+ * @return	none
+ * @note	Fixed NTC 10K 44031RC sensor is used. The divider ratio being
+ *			(code - zero scale) / (gain * zero scale), the whole block is
+ *			converted without per sample voltage/ratio computation.
+ */
+void get_ntc_thermistor_temperatures(const int32_t *ntc_samples,
+				     uint32_t nb_samples, float *temperatures)
+{
+	const float gain = AD7124_PGA_GAIN(THERMISTOR_GAIN_VALUE);
+
+	temp_lin_convert_codes(&temp_lin_ntc_10k_44031, ntc_samples, nb_samples,
+			       1.0f / (gain * AD7124_BIPOLAR_ZERO_CODE), -1.0f / gain,
+			       temperatures);
 }
 
 
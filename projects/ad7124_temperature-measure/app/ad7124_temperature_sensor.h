@@ -39,6 +39,8 @@ uint32_t get_rtd_rref(void);
 float get_rtd_temperature(int32_t rtd_sample, uint8_t gain);
 void store_rtd_calibrated_iout_ratio(float iout_ratio, bool status);
 float get_ntc_thermistor_temperature(int32_t ntc_sample);
+void get_ntc_thermistor_temperatures(const int32_t *ntc_samples,
+				     uint32_t nb_samples, float *temperatures);
 float get_ptc_thermistor_temperature(int32_t ntc_sample);
 
 #ifdef __cplusplus  // Closing extern c
@@ -17,6 +17,7 @@
 #include "no_os_error.h"
 #include "app_config_stm32.h"
 #include "adi_console_menu.h"
+#include "stm32_cycle_counter.h"
 
 /******************************************************************************/
 /********************* Macros and Constants Definition ************************/
@@ -56,6 +57,9 @@ void stm32_system_init(void)
 	MX_GPIO_Init();
 	MX_SPI1_Init();
 	MX_UART5_Init();
+
+	/* Time base of the sensors scan time measurement */
+	stm32_cycle_counter_enable();
 }
 
 /*!
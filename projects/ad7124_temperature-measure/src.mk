@@ -8,6 +8,13 @@ SRC_DIRS += $(LIBRARIES_PATH)/no-OS/util
 SRC_DIRS += $(LIBRARIES_PATH)/no-OS/include
 SRC_DIRS += $(LIBRARIES_PATH)/precision-converters-library/tempsensors
 SRC_DIRS += $(LIBRARIES_PATH)/precision-converters-library/adi_console_menu
+SRC_DIRS += $(ROOT_DRIVE)/projects/_common
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/stm32
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/linux
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/decimation_stage.c
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/decimation_stage.h
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/welch_fft.c
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/welch_fft.h
 
 ifeq 'mbed' '$(PLATFORM)'
 # ALL_IGNORED_FILES variable used for excluding particular source files in SRC_DIRS in Build
@@ -24,11 +24,29 @@
 #include "ad7606.h"
 #include "ad7606_support.h"
 #include "ad7606_user_config.h"
+#include "sample_format.h"
 #include "common.h"
 #include "no_os_error.h"
 #include "no_os_gpio.h"
 #include "iio_trigger.h"
 
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+#include "stm32_cycle_counter.h"
+#if (INTERFACE_MODE == SPI_INTERRUPT)
+#include "burst_capture.h"
+#include "decimation_stage.h"
+#endif
+#endif
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+#include "sdram_ring.h"
+#endif
+
+#if (INTERFACE_MODE == SPI_DMA)
+#include "no_os_irq.h"
+#include "no_os_pwm.h"
+#endif
+
 /******************************************************************************/
 /************************ Macros/Constants ************************************/
 /******************************************************************************/
@@ -70,6 +88,16 @@
 /* IIO trigger name */
 #define IIO_TRIGGER_NAME		"ad7606_iio_trigger"
 
+/* Number of samples staged before committing to the IIO buffer in burst mode */
+#define BURST_BLOCK_SAMPLES		256
+
+/* Max decimation ratio and CIC filter order of the on-device decimation stage */
+#define DECIM_MAX_RATIO			64
+#define DECIM_CIC_ORDER			3
+
+/* Max time (in msec) to wait for a frame of ADC data in SPI DMA mode */
+#define FRAME_READ_TIMEOUT_MSEC	100
+
 /* Number of data storage bits (needed for IIO client to plot ADC data) */
 #define CHN_STORAGE_BITS	(BYTES_PER_SAMPLE * 8)
 
@@ -105,10 +133,87 @@ static volatile uint8_t active_chns[AD7606X_ADC_CHANNELS];
 
 static volatile uint8_t chn_indx = 0;
 
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE) && (INTERFACE_MODE == SPI_INTERRUPT)
+/* ADC data of all channels for the ongoing scan */
+static uint32_t scan_data[AD7606X_ADC_CHANNELS];
+
+static int32_t ad7606_burst_read_sample(void *ctx, void *sample);
+static uint32_t ad7606_decimate_block(void *ctx, void *block, uint32_t samples);
+
+/* Block-batched burst capture init parameters */
+static struct burst_capture_init_param burst_capture_init_params = {
+	.read_unit = ad7606_burst_read_sample,
+	.unit_size = BYTES_PER_SAMPLE,
+	.block_units = BURST_BLOCK_SAMPLES,
+	.get_ticks = stm32_cycle_counter_get,
+	.process_block = ad7606_decimate_block
+};
+
+/* Block-batched burst capture descriptor */
+static struct burst_capture_desc *ad7606_burst_desc;
+
+/* Decimation stage init parameters */
+static struct decim_stage_init_param decim_stage_init_params = {
+	.num_chns = AD7606X_ADC_CHANNELS,
+	.bytes_per_sample = BYTES_PER_SAMPLE,
+	.max_ratio = DECIM_MAX_RATIO,
+	.cic_order = DECIM_CIC_ORDER
+};
+
+/* Decimation stage descriptor */
+static struct decim_stage_desc *ad7606_decim_desc;
+
+/* Decimation filter of each channel */
+static enum decim_filter decim_filter[AD7606X_ADC_CHANNELS];
+
+/* Decimation filter values string representation */
+static const char *decim_filter_str[] = {
+	[DECIM_FILTER_BOXCAR] = "boxcar",
+	[DECIM_FILTER_CIC] = "cic",
+	[DECIM_FILTER_FIR] = "fir"
+};
+#endif
+
+#if (INTERFACE_MODE == SPI_DMA)
+/* Frame of all channels, used when only a subset of channels is active */
+static uint16_t dma_frame[AD7606X_ADC_CHANNELS];
+
+/* Memory receiving the next frame from SPI DMA */
+static uint16_t *volatile dma_frame_dst;
+
+/* Position of the next scan in the IIO buffer */
+static uint16_t *volatile iio_scan_dst;
+
+/* All channels are active, so the frames land directly in the IIO buffer */
+static bool dma_frame_in_place;
+
+/* Number of frames still to be captured in the ongoing burst */
+static volatile uint32_t frames_remaining;
+
+/* Time base ticks of the first and last BUSY falling edges in last burst */
+static volatile uint32_t busy_first_ticks;
+static volatile uint32_t busy_last_ticks;
+
+/* Min/Max period between consecutive BUSY falling edges (in ticks) */
+static volatile uint32_t busy_period_min;
+static volatile uint32_t busy_period_max;
+
+/* Number of BUSY falling edges seen in last burst */
+static volatile uint32_t busy_edge_count;
+
+/* Number of conversions lost as previous frame read was still in progress */
+static volatile uint32_t missed_frame_count;
+#endif
+
 /* Flag to indicate if size of the buffer is updated according to requested
  * number of samples for the multi-channel IIO buffer data alignment */
 static volatile bool buf_size_updated = false;
 
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/* Streaming ring over the data buffer for continuous data capture */
+static struct sdram_ring_desc *ad7606_sdram_ring;
+#endif
+
 /* Device attributes with default values */
 
 /* AD7606 Attribute IDs */
@@ -116,7 +221,11 @@ enum ad7606_attribute_id {
 	RAW_ATTR_ID,
 	SCALE_ATTR_ID,
 	OFFSET_ATTR_ID,
-	SAMPLING_FREQ_ATTR_ID
+	SAMPLING_FREQ_ATTR_ID,
+	RING_LEVEL_ATTR_ID,
+	RING_HIGH_WATER_MARK_ATTR_ID,
+	RING_OVERRUNS_ATTR_ID,
+	RING_DROPPED_BYTES_ATTR_ID
 };
 
 /* Power down mode values string representation (possible values specified in datasheet) */
@@ -247,6 +356,9 @@ static int iio_ad7606_attr_get(void *device,
 	int32_t offset = 0;
 	uint32_t val;
 	int32_t	 ret;
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	struct sdram_ring_stats ring_stats;
+#endif
 
 	val = no_os_str_to_uint32(buf);
 
@@ -277,7 +389,40 @@ static int iio_ad7606_attr_get(void *device,
 		/* Sampling frequency for IIO oscilloscope timeout purpose.
 		 * Does not indicate an actual sampling rate of device.
 		 * Refer the 'note' in function description above for timeout calculations */
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE) && (INTERFACE_MODE == SPI_INTERRUPT)
+		/* Data rate is reduced by the on-device decimation */
+		return sprintf(buf, "%d", SAMPLING_RATE / ad7606_decim_desc->ratio);
+#else
 		return sprintf(buf, "%d", SAMPLING_RATE);
+#endif
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	case RING_LEVEL_ATTR_ID:
+	case RING_HIGH_WATER_MARK_ATTR_ID:
+	case RING_OVERRUNS_ATTR_ID:
+	case RING_DROPPED_BYTES_ATTR_ID:
+		ret = sdram_ring_get_stats(ad7606_sdram_ring, &ring_stats);
+		if (ret) {
+			return ret;
+		}
+
+		switch (priv) {
+		case RING_LEVEL_ATTR_ID:
+			val = ring_stats.level;
+			break;
+		case RING_HIGH_WATER_MARK_ATTR_ID:
+			val = ring_stats.high_water_mark;
+			break;
+		case RING_OVERRUNS_ATTR_ID:
+			val = ring_stats.overruns;
+			break;
+		default:
+			val = ring_stats.dropped_bytes;
+			break;
+		}
+
+		return sprintf(buf, "%lu", (unsigned long)val);
+#endif
 
 	default:
 		break;
@@ -307,6 +452,10 @@ static int iio_ad7606_attr_set(void *device,
 	case SCALE_ATTR_ID:
 	case OFFSET_ATTR_ID:
 	case SAMPLING_FREQ_ATTR_ID:
+	case RING_LEVEL_ATTR_ID:
+	case RING_HIGH_WATER_MARK_ATTR_ID:
+	case RING_OVERRUNS_ATTR_ID:
+	case RING_DROPPED_BYTES_ATTR_ID:
 		/* All are read-only attributes */
 		break;
 
@@ -684,6 +833,228 @@ static int set_bandwidth(void *device,
 }
 
 
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+/*!
+ * @brief	Getter/Setter for the sampling frequency achieved in last burst
+ * @param	device[in]- Pointer to IIO device instance
+ * @param	buf[in]- IIO input data buffer
+ * @param	len[in]- Number of input bytes
+ * @param	channel[in] - Input channel
+ * @param	priv[in] - Attribute private ID
+ * @return	Number of characters read/written in case of success,
+ *			negative error code otherwise
+ * @note	Rate is reported in samples per second across all active channels
+ */
+static int get_achieved_sampling_frequency(void *device,
+		char *buf,
+		uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t id)
+{
+#if (INTERFACE_MODE == SPI_DMA)
+	uint32_t elapsed_ticks = busy_last_ticks - busy_first_ticks;
+	uint64_t rate = 0;
+
+	if ((busy_edge_count > 1) && elapsed_ticks) {
+		rate = ((uint64_t)(busy_edge_count - 1) * stm32_cycle_counter_freq() *
+			num_of_active_channels) / elapsed_ticks;
+	}
+
+	return sprintf(buf, "%lu", (unsigned long)rate);
+#else
+	return sprintf(buf, "%lu",
+		       (unsigned long)burst_capture_get_rate(ad7606_burst_desc));
+#endif
+}
+
+static int set_achieved_sampling_frequency(void *device,
+		char *buf,
+		uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t id)
+{
+	/* NA - Measured by the firmware */
+	return -EINVAL;
+}
+#endif
+
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE) && (INTERFACE_MODE == SPI_INTERRUPT)
+/*!
+ * @brief	Getter/Setter for the decimation ratio of the on-device decimation
+ * @param	device[in]- Pointer to IIO device instance
+ * @param	buf[in]- IIO input data buffer
+ * @param	len[in]- Number of input bytes
+ * @param	channel[in] - Input channel
+ * @param	priv[in] - Attribute private ID
+ * @return	Number of characters read/written in case of success,
+ *			negative error code otherwise
+ * @note	Ratio of 1 bypasses the decimation (raw ADC data)
+ */
+static int get_decimation_ratio(void *device,
+				char *buf,
+				uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t id)
+{
+	return sprintf(buf, "%d", ad7606_decim_desc->ratio);
+}
+
+static int set_decimation_ratio(void *device,
+				char *buf,
+				uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t id)
+{
+	uint32_t ratio = no_os_str_to_uint32(buf);
+
+	if ((ratio > DECIM_MAX_RATIO)
+	    || decim_stage_set_ratio(ad7606_decim_desc, ratio)) {
+		return -EINVAL;
+	}
+
+	return len;
+}
+
+/*!
+ * @brief	Getter/Setter for the decimation filter of a channel
+ * @param	device[in]- Pointer to IIO device instance
+ * @param	buf[in]- IIO input data buffer
+ * @param	len[in]- Number of input bytes
+ * @param	channel[in] - Input channel
+ * @param	priv[in] - Attribute private ID
+ * @return	Number of characters read/written in case of success,
+ *			negative error code otherwise
+ */
+static int get_chn_decimation_filter(void *device,
+				     char *buf,
+				     uint32_t len,
+				     const struct iio_ch_info *channel,
+				     intptr_t id)
+{
+	return sprintf(buf, "%s", decim_filter_str[decim_filter[channel->ch_num]]);
+}
+
+static int set_chn_decimation_filter(void *device,
+				     char *buf,
+				     uint32_t len,
+				     const struct iio_ch_info *channel,
+				     intptr_t id)
+{
+	uint8_t filter;
+
+	for (filter = 0; filter < NO_OS_ARRAY_SIZE(decim_filter_str); filter++) {
+		if (!strcmp(buf, decim_filter_str[filter])) {
+			decim_filter[channel->ch_num] = filter;
+			return len;
+		}
+	}
+
+	return -EINVAL;
+}
+
+/*!
+ * @brief	Getter/Setter for the available decimation filters
+ * @param	device[in]- Pointer to IIO device instance
+ * @param	buf[in]- IIO input data buffer
+ * @param	len[in]- Number of input bytes
+ * @param	channel[in] - Input channel
+ * @param	priv[in] - Attribute private ID
+ * @return	Number of characters read/written in case of success,
+ *			negative error code otherwise
+ */
+static int get_chn_decimation_filter_available(void *device,
+		char *buf,
+		uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t id)
+{
+	return sprintf(buf, "%s %s %s",
+		       decim_filter_str[DECIM_FILTER_BOXCAR],
+		       decim_filter_str[DECIM_FILTER_CIC],
+		       decim_filter_str[DECIM_FILTER_FIR]);
+}
+
+static int set_chn_decimation_filter_available(void *device,
+		char *buf,
+		uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t id)
+{
+	// NA- Can't set available decimation filters
+	return -EINVAL;
+}
+#endif
+
+#if (INTERFACE_MODE == SPI_DMA)
+/*!
+ * @brief	Getter/Setter for the BUSY period jitter seen in last burst
+ * @param	device[in]- Pointer to IIO device instance
+ * @param	buf[in]- IIO input data buffer
+ * @param	len[in]- Number of input bytes
+ * @param	channel[in] - Input channel
+ * @param	priv[in] - Attribute private ID
+ * @return	Number of characters read/written in case of success,
+ *			negative error code otherwise
+ * @note	Jitter is the spread (max - min) of the period between consecutive
+ *			BUSY falling edges, as timestamped by the MCU (in nsec)
+ */
+static int get_busy_period_jitter(void *device,
+				  char *buf,
+				  uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t id)
+{
+	uint64_t jitter_nsec = 0;
+
+	if (busy_edge_count > 2) {
+		jitter_nsec = ((uint64_t)(busy_period_max - busy_period_min) * 1000000000) /
+			      stm32_cycle_counter_freq();
+	}
+
+	return sprintf(buf, "%lu", (unsigned long)jitter_nsec);
+}
+
+static int set_busy_period_jitter(void *device,
+				  char *buf,
+				  uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t id)
+{
+	// NA- Can't set BUSY period jitter
+	return -EINVAL;
+}
+
+/*!
+ * @brief	Getter/Setter for the number of frames missed in last burst
+ * @param	device[in]- Pointer to IIO device instance
+ * @param	buf[in]- IIO input data buffer
+ * @param	len[in]- Number of input bytes
+ * @param	channel[in] - Input channel
+ * @param	priv[in] - Attribute private ID
+ * @return	Number of characters read/written in case of success,
+ *			negative error code otherwise
+ */
+static int get_missed_frames(void *device,
+			     char *buf,
+			     uint32_t len,
+			     const struct iio_ch_info *channel,
+			     intptr_t id)
+{
+	return sprintf(buf, "%lu", (unsigned long)missed_frame_count);
+}
+
+static int set_missed_frames(void *device,
+			     char *buf,
+			     uint32_t len,
+			     const struct iio_ch_info *channel,
+			     intptr_t id)
+{
+	// NA- Can't set missed frames count
+	return -EINVAL;
+}
+#endif
+
+
 /*!
  * @brief	Getter/Setter for the channel range attribute value
  * @@param	device[in]- Pointer to IIO device instance
@@ -1643,53 +2014,279 @@ int32_t debug_reg_write(void *dev, uint32_t reg, uint32_t writeval)
 	return -EINVAL;
 }
 
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE) && (INTERFACE_MODE == SPI_INTERRUPT)
 /**
- * @brief	Read buffer data corresponding to AD7606 IIO device
- * @param	iio_dev_data[in] - Pointer to IIO device data structure
+ * @brief	Read single sample of active channel for the block-batched burst capture
+ * @param	ctx[in] - Burst capture context (unused)
+ * @param	sample[out] - ADC sample
  * @return	0 in case of success, negative error code otherwise
+ * @note	All channels are sampled simultaneously, so the data of all channels
+ *			is read once per scan and next conversion is triggered right after
  */
-static int32_t iio_ad7606_submit_buffer(struct iio_device_data *iio_dev_data)
+static int32_t ad7606_burst_read_sample(void *ctx, void *sample)
 {
 	int32_t ret;
-	uint32_t nb_of_samples;
-	uint32_t sample_index = 0;
-	uint32_t adc_raw;
-
-#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
-	nb_of_samples = iio_dev_data->buffer->size / BYTES_PER_SAMPLE;
 
-	if (!buf_size_updated) {
-		/* Update total buffer size according to bytes per scan for proper
-		 * alignment of multi-channel IIO buffer data */
-		iio_dev_data->buffer->buf->size = iio_dev_data->buffer->size;
-		buf_size_updated = true;
-	}
-
-	while (sample_index < nb_of_samples) {
+	if (!chn_indx) {
 		/* Read converted adc data */
-		ret = ad7606_read_converted_sample(p_ad7606_dev_inst, &adc_raw,
-						   active_chns[chn_indx]);
+		ret = ad7606_read_converted_scan(p_ad7606_dev_inst, scan_data);
 		if (ret) {
 			return ret;
 		}
 
-		chn_indx++;
-		if (chn_indx >= num_of_active_channels) {
-			chn_indx = 0;
-		}
-
-		ret = no_os_cb_write(iio_dev_data->buffer->buf, &adc_raw, BYTES_PER_SAMPLE);
+		/* Trigger next conversion */
+		ret = ad7606_convst(p_ad7606_dev_inst);
 		if (ret) {
 			return ret;
 		}
+	}
 
-		/* Trigger next conversion */
-		ret = ad7606_convst(p_ad7606_dev_inst);
+	memcpy(sample, &scan_data[active_chns[chn_indx]], BYTES_PER_SAMPLE);
+
+	chn_indx++;
+	if (chn_indx >= num_of_active_channels) {
+		chn_indx = 0;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief	Decimate the block of samples before committing to the IIO buffer
+ * @param	ctx[in] - Decimation stage descriptor
+ * @param	block[in,out] - Block of samples (interleaved scans)
+ * @param	samples[in] - Number of samples in the block
+ * @return	Number of decimated samples in the block
+ */
+static uint32_t ad7606_decimate_block(void *ctx, void *block, uint32_t samples)
+{
+	return decim_stage_process(ctx, block, samples);
+}
+
+/**
+ * @brief	Configure the decimation stage for the active channels
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t ad7606_decimation_start(void)
+{
+	struct decim_chn_config chn_config;
+	uint8_t chn;
+	int32_t ret;
+
+	for (chn = 0; chn < num_of_active_channels; chn++) {
+		chn_config.filter = decim_filter[active_chns[chn]];
+		chn_config.is_signed = (chn_scan[active_chns[chn]].sign == 's');
+		chn_config.realbits = chn_scan[active_chns[chn]].realbits;
+
+		ret = decim_stage_set_chn_config(ad7606_decim_desc, active_chns[chn],
+						 &chn_config);
 		if (ret) {
 			return ret;
 		}
+	}
+
+	return decim_stage_start(ad7606_decim_desc, (const uint8_t *)active_chns,
+				 num_of_active_channels);
+}
+#endif
+
+#if (INTERFACE_MODE == SPI_DMA)
+/**
+ * @brief	Callback function for the BUSY falling edge (end of conversion)
+ * @param	context[in] - Callback context (unused)
+ * @return	None
+ * @note	The conversion is started by the CONVST PWM, so this only timestamps
+ *			the edge and kicks the SPI DMA read of the converted frame
+ */
+void ad7606_busy_callback(void *context)
+{
+	uint32_t ticks = stm32_cycle_counter_get();
+	uint32_t period;
+
+	if (busy_edge_count) {
+		period = ticks - busy_last_ticks;
+		if (period < busy_period_min) {
+			busy_period_min = period;
+		}
+		if (period > busy_period_max) {
+			busy_period_max = period;
+		}
+	} else {
+		busy_first_ticks = ticks;
+	}
+	busy_last_ticks = ticks;
+	busy_edge_count++;
+
+	if (!frames_remaining) {
+		return;
+	}
+
+	if (stm32_spi_dma_frame_busy()) {
+		/* Previous frame is still being read, this conversion is lost */
+		missed_frame_count++;
+		return;
+	}
+
+	stm32_spi_dma_frame_read(dma_frame_dst, AD7606X_ADC_CHANNELS);
+}
+
+/**
+ * @brief	Callback function for the SPI DMA frame read completion
+ * @return	None
+ */
+void ad7606_frame_dma_cplt(void)
+{
+	uint8_t chn;
+
+	if (!frames_remaining) {
+		return;
+	}
+
+	if (dma_frame_in_place) {
+		/* Frame has landed directly into the IIO buffer */
+		iio_scan_dst += AD7606X_ADC_CHANNELS;
+		dma_frame_dst = iio_scan_dst;
+	} else {
+		for (chn = 0; chn < num_of_active_channels; chn++) {
+			*iio_scan_dst++ = dma_frame[active_chns[chn]];
+		}
+	}
+
+	frames_remaining--;
+	if (!frames_remaining) {
+		/* Stop the conversions once the requested frames are captured */
+		no_os_pwm_disable(convst_pwm_desc);
+	}
+}
+
+/**
+ * @brief	Stop the hardware timed burst capture and restore the interfaces
+ * @return	None
+ */
+static void ad7606_spi_dma_capture_stop(void)
+{
+	no_os_pwm_disable(convst_pwm_desc);
+	no_os_irq_disable(busy_irq_desc, BUSY_IRQ_ID);
+
+	/* Let the ongoing frame read complete before releasing the SPI */
+	while (stm32_spi_dma_frame_busy()) ;
+
+	frames_remaining = 0;
+	stm32_spi_dma_frame_config(false);
+	stm32_convst_output_gpio_config(true);
+}
+
+/**
+ * @brief	Capture the ADC frames into the IIO buffer, with the conversions
+ *			timed by the CONVST PWM and the frames read using SPI DMA
+ * @param	cb[in] - IIO circular buffer
+ * @param	nb_of_samples[in] - Number of samples to capture
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t ad7606_spi_dma_capture(struct no_os_circular_buffer *cb,
+				      uint32_t nb_of_samples)
+{
+	uint32_t timeout_ticks = (stm32_cycle_counter_freq() / 1000) *
+				 FRAME_READ_TIMEOUT_MSEC;
+	uint32_t buff_available_size;
+	uint32_t last_remaining;
+	uint32_t last_ticks;
+	void *buff_start;
+	int32_t ret;
+
+	if (!num_of_active_channels) {
+		return -EINVAL;
+	}
+
+	ret = no_os_cb_prepare_async_write(cb, nb_of_samples * BYTES_PER_SAMPLE,
+					   &buff_start, &buff_available_size);
+	if (ret) {
+		return ret;
+	}
+
+	if (buff_available_size < nb_of_samples * BYTES_PER_SAMPLE) {
+		return -ENOMEM;
+	}
+
+	iio_scan_dst = buff_start;
+	dma_frame_in_place = (num_of_active_channels == AD7606X_ADC_CHANNELS);
+	dma_frame_dst = dma_frame_in_place ? iio_scan_dst : dma_frame;
+
+	busy_edge_count = 0;
+	busy_period_min = UINT32_MAX;
+	busy_period_max = 0;
+	missed_frame_count = 0;
+	frames_remaining = nb_of_samples / num_of_active_channels;
+
+	stm32_spi_dma_frame_config(true);
+
+	/* Hand over the CONVST pin to the PWM timer */
+	stm32_convst_output_gpio_config(false);
+
+	ret = no_os_irq_enable(busy_irq_desc, BUSY_IRQ_ID);
+	if (ret) {
+		goto err_stop;
+	}
+
+	ret = no_os_pwm_enable(convst_pwm_desc);
+	if (ret) {
+		goto err_stop;
+	}
+
+	/* Wait for the capture to complete, bailing out if no frame completes
+	 * within the timeout (e.g. BUSY edges are not seen) */
+	last_remaining = frames_remaining;
+	last_ticks = stm32_cycle_counter_get();
+	while (frames_remaining) {
+		if (frames_remaining != last_remaining) {
+			last_remaining = frames_remaining;
+			last_ticks = stm32_cycle_counter_get();
+		} else if (stm32_cycle_counter_get() - last_ticks > timeout_ticks) {
+			ret = -ETIMEDOUT;
+			goto err_stop;
+		}
+	}
+
+	ad7606_spi_dma_capture_stop();
+
+	return no_os_cb_end_async_write(cb);
+
+err_stop:
+	ad7606_spi_dma_capture_stop();
+	return ret;
+}
+#endif
+
+/**
+ * @brief	Read buffer data corresponding to AD7606 IIO device
+ * @param	iio_dev_data[in] - Pointer to IIO device data structure
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t iio_ad7606_submit_buffer(struct iio_device_data *iio_dev_data)
+{
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	int32_t ret;
+	uint32_t nb_of_samples;
 
-		sample_index++;
+	nb_of_samples = iio_dev_data->buffer->size / BYTES_PER_SAMPLE;
+
+	if (!buf_size_updated) {
+		/* Update total buffer size according to bytes per scan for proper
+		 * alignment of multi-channel IIO buffer data */
+		iio_dev_data->buffer->buf->size = iio_dev_data->buffer->size;
+		buf_size_updated = true;
+	}
+
+#if (INTERFACE_MODE == SPI_DMA)
+	/* Frames are read by DMA on each BUSY edge of the timed conversions */
+	ret = ad7606_spi_dma_capture(iio_dev_data->buffer->buf, nb_of_samples);
+#else
+	/* Samples are committed to the IIO buffer in blocks */
+	ret = burst_capture_read(ad7606_burst_desc, iio_dev_data->buffer->buf,
+				 nb_of_samples);
+#endif
+	if (ret) {
+		return ret;
 	}
 #endif
 
@@ -1736,6 +2333,13 @@ static int32_t iio_ad7606_prepare_transfer(void *dev_instance,
 		mask <<= 1;
 	}
 
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE) && (INTERFACE_MODE == SPI_INTERRUPT)
+	ret = ad7606_decimation_start();
+	if (ret) {
+		return ret;
+	}
+#endif
+
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 	/* Trigger ADC conversion */
 	ret = ad7606_convst(p_ad7606_dev_inst);
@@ -1773,6 +2377,7 @@ static int32_t iio_ad7606_end_transfer(void *dev)
 	return 0;
 }
 
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 /**
  * @brief Push data into IIO buffer when trigger handler IRQ is invoked
  * @param iio_dev_data[in] - IIO device data instance
@@ -1784,10 +2389,16 @@ int32_t iio_ad7606_trigger_handler(struct iio_device_data *iio_dev_data)
 	int32_t ret;
 
 	if (!buf_size_updated) {
-		/* Update total buffer size according to bytes per scan for proper
-		 * alignment of multi-channel IIO buffer data */
-		iio_dev_data->buffer->buf->size = ((uint32_t)(DATA_BUFFER_SIZE /
-						   iio_dev_data->buffer->bytes_per_scan)) * iio_dev_data->buffer->bytes_per_scan;
+		/* Stream through the whole data buffer, with the total buffer size
+		 * aligned to bytes per scan for proper alignment of multi-channel
+		 * IIO buffer data */
+		ret = sdram_ring_start(ad7606_sdram_ring,
+				       iio_dev_data->buffer->buf,
+				       DATA_BUFFER_SIZE,
+				       iio_dev_data->buffer->bytes_per_scan);
+		if (ret) {
+			return ret;
+		}
 		buf_size_updated = true;
 	}
 
@@ -1803,7 +2414,7 @@ int32_t iio_ad7606_trigger_handler(struct iio_device_data *iio_dev_data)
 		chn_indx = 0;
 	}
 
-	ret = no_os_cb_write(iio_dev_data->buffer->buf, &adc_raw, BYTES_PER_SAMPLE);
+	ret = sdram_ring_write(ad7606_sdram_ring, &adc_raw, BYTES_PER_SAMPLE);
 	if (ret) {
 		return ret;
 	}
@@ -1816,6 +2427,7 @@ int32_t iio_ad7606_trigger_handler(struct iio_device_data *iio_dev_data)
 
 	return 0;
 }
+#endif
 
 /*********************************************************
  *               IIO Attributes and Structures
@@ -1910,6 +2522,18 @@ struct iio_attribute channel_input_attributes[] = {
 		.store = set_bandwidth,
 	},
 #endif
+#endif
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE) && (INTERFACE_MODE == SPI_INTERRUPT)
+	{
+		.name = "decimation_filter",
+		.show = get_chn_decimation_filter,
+		.store = set_chn_decimation_filter,
+	},
+	{
+		.name = "decimation_filter_available",
+		.show = get_chn_decimation_filter_available,
+		.store = set_chn_decimation_filter_available,
+	},
 #endif
 
 	END_ATTRIBUTES_ARRAY
@@ -1946,6 +2570,58 @@ static struct iio_attribute global_attributes[] = {
 		.store = iio_ad7606_attr_set,
 		.priv = SAMPLING_FREQ_ATTR_ID
 	},
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	{
+		.name = "ring_level",
+		.show = iio_ad7606_attr_get,
+		.store = iio_ad7606_attr_set,
+		.priv = RING_LEVEL_ATTR_ID
+	},
+	{
+		.name = "ring_high_water_mark",
+		.show = iio_ad7606_attr_get,
+		.store = iio_ad7606_attr_set,
+		.priv = RING_HIGH_WATER_MARK_ATTR_ID
+	},
+	{
+		.name = "ring_overruns",
+		.show = iio_ad7606_attr_get,
+		.store = iio_ad7606_attr_set,
+		.priv = RING_OVERRUNS_ATTR_ID
+	},
+	{
+		.name = "ring_dropped_bytes",
+		.show = iio_ad7606_attr_get,
+		.store = iio_ad7606_attr_set,
+		.priv = RING_DROPPED_BYTES_ATTR_ID
+	},
+#endif
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	{
+		.name = "achieved_sampling_frequency",
+		.show = get_achieved_sampling_frequency,
+		.store = set_achieved_sampling_frequency
+	},
+#endif
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE) && (INTERFACE_MODE == SPI_INTERRUPT)
+	{
+		.name = "decimation_ratio",
+		.show = get_decimation_ratio,
+		.store = set_decimation_ratio
+	},
+#endif
+#if (INTERFACE_MODE == SPI_DMA)
+	{
+		.name = "busy_period_jitter_ns",
+		.show = get_busy_period_jitter,
+		.store = set_busy_period_jitter
+	},
+	{
+		.name = "missed_frames",
+		.show = get_missed_frames,
+		.store = set_missed_frames
+	},
+#endif
 
 	END_ATTRIBUTES_ARRAY
 };
@@ -2145,13 +2821,7 @@ static int32_t reformat_adc_raw_data(uint32_t adc_raw_data, uint8_t chn)
 	 **/
 	if (polarity == BIPOLAR) {
 		/* Data output format is 2's complement for bipolar mode */
-		if (adc_raw_data > ADC_MAX_COUNT_BIPOLAR) {
-			/* Remove the offset from result to convert into negative reading */
-			adc_data = ADC_MAX_COUNT_UNIPOLAR - adc_raw_data;
-			adc_data = -adc_data;
-		} else {
-			adc_data = adc_raw_data;
-		}
+		adc_data = sample_sign_extend_code(adc_raw_data, AD7606X_ADC_RESOLUTION);
 	} else {
 		/* Data output format is straight binary for unipolar mode */
 		adc_data = adc_raw_data;
@@ -2264,6 +2934,13 @@ int32_t ad7606_iio_remove(struct iio_desc *desc)
 {
 	int32_t status;
 
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	if (ad7606_sdram_ring) {
+		sdram_ring_remove(ad7606_sdram_ring);
+		ad7606_sdram_ring = NULL;
+	}
+#endif
+
 	if (!desc) {
 		return -EINVAL;
 	}
@@ -2323,6 +3000,33 @@ int32_t ad7606_iio_initialize(void)
 		return init_status;
 	}
 
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	stm32_cycle_counter_enable();
+#if (INTERFACE_MODE == SPI_INTERRUPT)
+	/* Init the on-device decimation stage */
+	init_status = decim_stage_init(&ad7606_decim_desc, &decim_stage_init_params);
+	if (init_status) {
+		return init_status;
+	}
+
+	/* Init the block-batched burst capture */
+	burst_capture_init_params.ticks_per_sec = stm32_cycle_counter_freq();
+	burst_capture_init_params.process_ctx = ad7606_decim_desc;
+	init_status = burst_capture_init(&ad7606_burst_desc,
+					 &burst_capture_init_params);
+	if (init_status) {
+		return init_status;
+	}
+#endif
+#endif
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	init_status = sdram_ring_init(&ad7606_sdram_ring);
+	if (init_status) {
+		return init_status;
+	}
+#endif
+
 	/* Initialize AD7606 device and peripheral interface */
 	init_status = ad7606_init(&p_ad7606_dev_inst, &ad7606_init_str);
 	if (init_status) {
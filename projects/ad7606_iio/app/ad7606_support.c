@@ -19,6 +19,7 @@
 
 #include "app_config.h"
 #include "ad7606_support.h"
+#include "sample_format.h"
 #include "no_os_error.h"
 
 /******************************************************************************/
@@ -125,9 +126,44 @@ int32_t ad7606_read_converted_sample(struct ad7606_dev *dev, uint32_t *adc_data,
 		return ret;
 	}
 
-	*adc_data =
-		(uint16_t)(((uint16_t)dev->data[buffer_offset] << 8) |  	// MSB
-			   dev->data[buffer_offset + 1]);  		// LSB
+	/* Extract data: MSB first */
+	sample_unpack_be16(&dev->data[buffer_offset], adc_data, 1);
+#endif
+
+	return 0;
+}
+
+/*!
+ * @brief	Read ADC raw data of all channels for recent conversion
+ * @param	dev[in] - AD7606 device instance
+ * @param	adc_data[out] - Pointer to adc data array (one entry per channel)
+ * @return	0 in case of success, negative error code otherwise
+ */
+int32_t ad7606_read_converted_scan(struct ad7606_dev *dev, uint32_t *adc_data)
+{
+	int32_t ret;
+
+	if (!adc_data) {
+		return -EINVAL;
+	}
+
+#if (AD7606X_ADC_RESOLUTION == 18)
+	/* Read data over spi interface for all ADC channels */
+	ret = ad7606_spi_data_read(dev, adc_data);
+	if (ret < 0) {
+		return ret;
+	}
+#else
+	/* Read data over spi interface for all ADC channels */
+	memset(dev->data, 0, sizeof(dev->data));
+	ret = no_os_spi_write_and_read(dev->spi_desc, dev->data,
+				       AD7606X_ADC_CHANNELS * SAMPLE_SIZE_IN_BYTE);
+	if (ret) {
+		return ret;
+	}
+
+	/* Extract the data of all channels: MSB first */
+	sample_unpack_be16(dev->data, adc_data, AD7606X_ADC_CHANNELS);
 #endif
 
 	return 0;
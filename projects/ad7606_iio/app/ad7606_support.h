@@ -72,6 +72,7 @@ typedef enum {
 
 int32_t ad7606_read_converted_sample(struct ad7606_dev *dev, uint32_t *adc_data,
 				     uint8_t input_chn);
+int32_t ad7606_read_converted_scan(struct ad7606_dev *dev, uint32_t *adc_data);
 int32_t ad7606_read_single_sample(struct ad7606_dev *dev,
 				  uint32_t *adc_data, uint8_t chn);
 polarity_e ad7606_get_input_polarity(uint8_t chn_range_bits);
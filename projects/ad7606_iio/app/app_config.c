@@ -119,6 +119,32 @@ static struct no_os_pwm_init_param pwm_init_params = {
 	.pwm_gpio = &pwm_gpio_init_params
 };
 
+#if (INTERFACE_MODE == SPI_DMA)
+/* BUSY GPIO IRQ parameters */
+static struct no_os_irq_init_param busy_gpio_irq_params = {
+	.irq_ctrl_id = BUSY_IRQ_ID,
+	.platform_ops = &trigger_gpio_irq_ops,
+	.extra = &stm32_busy_gpio_irq_init_params
+};
+
+/* BUSY falling edge callback descriptor */
+static struct no_os_callback_desc busy_callback_desc = {
+	.callback = ad7606_busy_callback,
+	.ctx = NULL,
+	.event = NO_OS_EVT_GPIO,
+	.peripheral = NO_OS_GPIO_IRQ
+};
+
+/* CONVST PWM init parameters */
+static struct no_os_pwm_init_param convst_pwm_init_params = {
+	.id = CONVST_PWM_ID,
+	.period_ns = CONV_TRIGGER_PERIOD_NSEC,			// PWM period in nsec
+	.duty_cycle_ns = CONV_TRIGGER_DUTY_CYCLE_NSEC,	// PWM duty cycle in nsec
+	.extra = &stm32_convst_pwm_extra_init_params,
+	.platform_ops = &pwm_ops
+};
+#endif
+
 /* LED GPO descriptor */
 struct no_os_gpio_desc *led_gpio_desc;
 
@@ -135,6 +161,14 @@ struct no_os_irq_ctrl_desc *trigger_irq_desc;
 /* PWM descriptor */
 struct no_os_pwm_desc *pwm_desc;
 
+#if (INTERFACE_MODE == SPI_DMA)
+/* BUSY GPIO interrupt descriptor */
+struct no_os_irq_ctrl_desc *busy_irq_desc;
+
+/* CONVST PWM descriptor */
+struct no_os_pwm_desc *convst_pwm_desc;
+#endif
+
 /******************************************************************************/
 /************************** Functions Declarations ****************************/
 /******************************************************************************/
@@ -221,6 +255,58 @@ static int32_t gpio_trigger_init(void)
 	return 0;
 }
 
+#if (INTERFACE_MODE == SPI_DMA)
+/**
+ * @brief 	Initialize the BUSY interrupt and the CONVST PWM used for the
+ *			hardware timed data capture
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t busy_convst_init(void)
+{
+	int32_t ret;
+
+	/* Init interrupt controller for BUSY falling edge */
+	ret = no_os_irq_ctrl_init(&busy_irq_desc, &busy_gpio_irq_params);
+	if (ret) {
+		return ret;
+	}
+
+	/* The BUSY falling edge (end of conversion) starts the SPI DMA read
+	 * of the ADC data frame */
+	ret = no_os_irq_register_callback(busy_irq_desc,
+					  BUSY_IRQ_ID,
+					  &busy_callback_desc);
+	if (ret) {
+		return ret;
+	}
+
+	ret = no_os_irq_trigger_level_set(busy_irq_desc,
+					  BUSY_IRQ_ID, NO_OS_IRQ_EDGE_FALLING);
+	if (ret) {
+		return ret;
+	}
+
+	ret = no_os_irq_set_priority(busy_irq_desc, BUSY_IRQ_ID,
+				     BUSY_IRQ_PRIORITY);
+	if (ret) {
+		return ret;
+	}
+
+	ret = no_os_irq_disable(busy_irq_desc, BUSY_IRQ_ID);
+	if (ret) {
+		return ret;
+	}
+
+	/* CONVST PWM is enabled only during the data capture */
+	ret = no_os_pwm_init(&convst_pwm_desc, &convst_pwm_init_params);
+	if (ret) {
+		return ret;
+	}
+
+	return no_os_pwm_disable(convst_pwm_desc);
+}
+#endif
+
 /**
  * @brief 	Initialize the PWM trigger contoller
  * @return	0 in case of success, negative error code otherwise
@@ -272,6 +358,13 @@ int32_t init_system(void)
 	}
 #endif
 
+#if (INTERFACE_MODE == SPI_DMA)
+	ret = busy_convst_init();
+	if (ret) {
+		return ret;
+	}
+#endif
+
 #if defined(USE_SDRAM)
 	ret = sdram_init();
 	if (ret) {
@@ -28,6 +28,10 @@
 #define BURST_DATA_CAPTURE			0
 #define CONTINUOUS_DATA_CAPTURE		1
 
+/* List of data capture interfaces */
+#define SPI_INTERRUPT				0
+#define SPI_DMA						1
+
 /* Macros for stringification */
 #define XSTR(s)		#s
 #define STR(s)		XSTR(s)
@@ -42,6 +46,14 @@
 #define DATA_CAPTURE_MODE	CONTINUOUS_DATA_CAPTURE
 #endif
 
+/* Select the ADC data capture interface (default is SPI interrupt).
+ * Note: SPI DMA mode (CONVST driven by timer PWM and the SPI read kicked
+ * by BUSY falling edge) is supported only for burst data capture of the
+ * 16-bit devices on the STM32 platform */
+#if !defined(INTERFACE_MODE)
+#define INTERFACE_MODE		SPI_INTERRUPT
+#endif
+
 /* Enable the UART/VirtualCOM port connection (default VCOM) */
 //#define USE_PHY_COM_PORT		// Uncomment to select UART
 
@@ -192,6 +204,15 @@
 #define	BYTES_PER_SAMPLE	sizeof(uint16_t)	// For ADC resolution of 16-bits
 #endif
 
+#if (INTERFACE_MODE == SPI_DMA)
+#if (ACTIVE_PLATFORM != STM32_PLATFORM) || (DATA_CAPTURE_MODE != BURST_DATA_CAPTURE)
+#error "SPI DMA mode is supported only for burst data capture on STM32 platform"
+#endif
+#if (AD7606X_ADC_RESOLUTION == 18)
+#error "SPI DMA mode is not supported for 18-bit devices"
+#endif
+#endif
+
 /****** Macros used to form a VCOM serial number ******/
 #define	FIRMWARE_NAME	"ad7606_iio"
 
@@ -235,4 +256,11 @@ extern struct no_os_irq_ctrl_desc *trigger_irq_desc;
 int32_t init_system(void);
 int32_t init_pwm_trigger(void);
 
+#if (INTERFACE_MODE == SPI_DMA)
+extern struct no_os_irq_ctrl_desc *busy_irq_desc;
+extern struct no_os_pwm_desc *convst_pwm_desc;
+
+void ad7606_busy_callback(void *context);
+#endif
+
 #endif /* _APP_CONFIG_H_ */
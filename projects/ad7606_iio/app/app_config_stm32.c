@@ -18,6 +18,11 @@
 #include "no_os_error.h"
 #include "no_os_util.h"
 
+#if (INTERFACE_MODE == SPI_DMA)
+#include "ad7606.h"
+#include "ad7606_iio.h"
+#endif
+
 /******************************************************************************/
 /************************ Macros/Constants ************************************/
 /******************************************************************************/
@@ -53,9 +58,9 @@ struct stm32_gpio_init_param stm32_clear_gpio_init_params = {
 	.speed = GPIO_SPEED_FREQ_VERY_HIGH,
 };
 
-/* Reset pin STM32 GPIO specific parameters */
+/* BUSY pin STM32 GPIO specific parameters */
 struct stm32_gpio_init_param stm32_busy_gpio_extra_init_params = {
-	.mode = GPIO_MODE_OUTPUT_PP,
+	.mode = GPIO_MODE_INPUT,
 	.speed = GPIO_SPEED_FREQ_VERY_HIGH,
 };
 
@@ -129,6 +134,37 @@ struct stm32_pwm_init_param stm32_pwm_extra_init_params = {
 	.clock_divider = PWM_CLK_DIVIDER
 };
 
+#if (INTERFACE_MODE == SPI_DMA)
+/* STM32 BUSY GPIO IRQ specific parameters */
+struct stm32_gpio_irq_init_param stm32_busy_gpio_irq_init_params = {
+	.port_nb = BUSY_PORT
+};
+
+/* CONVST pin STM32 GPIO in PWM alternate function mode specific parameters */
+struct stm32_gpio_init_param stm32_convst_pwm_gpio_extra_init_params = {
+	.mode = GPIO_MODE_AF_PP,
+	.speed = GPIO_SPEED_FREQ_VERY_HIGH,
+	.alternate = GPIO_AF1_TIM1
+};
+
+/* STM32 CONVST PWM specific parameters */
+struct stm32_pwm_init_param stm32_convst_pwm_extra_init_params = {
+	.htimer = &CONVST_PWM_HANDLE,
+	.prescaler = CONVST_PWM_PRESCALER,
+	.timer_autoreload = true,
+	.mode = TIM_OC_PWM1,
+	.timer_chn = CONVST_PWM_CHANNEL,
+	.get_timer_clock = HAL_RCC_GetPCLK2Freq,
+	.clock_divider = CONVST_PWM_CLK_DIVIDER
+};
+
+/* Dummy word clocked out on MOSI while reading a frame */
+static const uint16_t spi_dma_tx_dummy = 0;
+
+/* Flag to indicate a frame read is in progress */
+static volatile bool spi_dma_frame_in_progress;
+#endif
+
 /******************************************************************************/
 /************************** Functions Declarations ****************************/
 /******************************************************************************/
@@ -150,6 +186,144 @@ void stm32_system_init(void)
 	MX_I2C1_Init();
 	MX_UART5_Init();
 	MX_TIM4_Init();
+#if (INTERFACE_MODE == SPI_DMA)
+	MX_TIM1_Init();
+#endif
 	MX_USB_DEVICE_Init();
 }
 
+#if (INTERFACE_MODE == SPI_DMA)
+/**
+ * @brief 	Configure the CONVST pin as GPIO output or in PWM function
+ * @param	is_gpio[in] - Configure the pin as GPIO output when true
+ * @return	None
+ */
+void stm32_convst_output_gpio_config(bool is_gpio)
+{
+	struct no_os_gpio_desc *convst_gpio_desc;
+	struct no_os_gpio_init_param convst_gpio_params = {
+		.port = CONVST_PORT,
+		.number = CONVST_PIN,
+		.platform_ops = &stm32_gpio_ops
+	};
+
+	if (is_gpio) {
+		convst_gpio_params.extra = &stm32_convst_gpio_extra_init_params;
+	} else {
+		convst_gpio_params.extra = &stm32_convst_pwm_gpio_extra_init_params;
+	}
+
+	if (!no_os_gpio_get(&convst_gpio_desc, &convst_gpio_params)) {
+		no_os_gpio_remove(convst_gpio_desc);
+	}
+}
+
+/**
+ * @brief 	Configure the SPI and its Rx/Tx DMA streams for frame reads
+ * @param	enable[in] - Enter (true) or exit (false) the frame read mode
+ * @return	None
+ * @note	In frame read mode, the SPI operates with 16-bit data frames, so
+ *			that every ADC sample is stored by the Rx DMA in native byte order
+ */
+void stm32_spi_dma_frame_config(bool enable)
+{
+	struct stm32_spi_desc *sdesc = p_ad7606_dev_inst->spi_desc->extra;
+	SPI_TypeDef *spi = sdesc->hspi.Instance;
+
+	HAL_NVIC_DisableIRQ(SPI_RXDMA_IRQ_ID);
+	SPI_RXDMA_STREAM->CR &= ~DMA_SxCR_EN;
+	SPI_TXDMA_STREAM->CR &= ~DMA_SxCR_EN;
+	while ((SPI_RXDMA_STREAM->CR | SPI_TXDMA_STREAM->CR) & DMA_SxCR_EN) {
+	}
+	spi_dma_frame_in_progress = false;
+
+	/* Data frame format can be changed only while SPI is disabled */
+	CLEAR_BIT(spi->CR1, SPI_CR1_SPE);
+
+	if (!enable) {
+		CLEAR_BIT(spi->CR2, SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+		CLEAR_BIT(spi->CR1, SPI_CR1_DFF);
+		return;
+	}
+
+	__HAL_RCC_DMA2_CLK_ENABLE();
+
+	SPI_RXDMA_STREAM->PAR = (uint32_t)&spi->DR;
+	SPI_RXDMA_STREAM->FCR = 0;
+	SPI_RXDMA_STREAM->CR = SPI_DMA_CHANNEL | DMA_PERIPH_TO_MEMORY |
+			       DMA_MINC_ENABLE | DMA_PDATAALIGN_HALFWORD |
+			       DMA_MDATAALIGN_HALFWORD | DMA_PRIORITY_VERY_HIGH |
+			       DMA_SxCR_TCIE;
+
+	SPI_TXDMA_STREAM->PAR = (uint32_t)&spi->DR;
+	SPI_TXDMA_STREAM->M0AR = (uint32_t)&spi_dma_tx_dummy;
+	SPI_TXDMA_STREAM->FCR = 0;
+	SPI_TXDMA_STREAM->CR = SPI_DMA_CHANNEL | DMA_MEMORY_TO_PERIPH |
+			       DMA_PDATAALIGN_HALFWORD | DMA_MDATAALIGN_HALFWORD |
+			       DMA_PRIORITY_HIGH;
+
+	SET_BIT(spi->CR1, SPI_CR1_DFF);
+	SET_BIT(spi->CR2, SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+	SET_BIT(spi->CR1, SPI_CR1_SPE);
+
+	HAL_NVIC_SetPriority(SPI_RXDMA_IRQ_ID, 0, 0);
+	HAL_NVIC_EnableIRQ(SPI_RXDMA_IRQ_ID);
+}
+
+/**
+ * @brief 	Start the DMA read of one frame of ADC data
+ * @param	frame[out] - Memory receiving the frame
+ * @param	n_words[in] - Number of 16-bit words in the frame
+ * @return	None
+ * @note	Called from the BUSY falling edge interrupt. The chip select is
+ *			released from the Rx DMA transfer complete interrupt.
+ */
+void stm32_spi_dma_frame_read(uint16_t *frame, uint16_t n_words)
+{
+	spi_dma_frame_in_progress = true;
+
+	/* Assert chip select */
+	SPI_CS_PORT_BASE->BSRR = (uint32_t)NO_OS_BIT(SPI_CSB) << 16;
+
+	DMA2->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 |
+		      DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0 | DMA_LIFCR_CTCIF3 |
+		      DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTEIF3 | DMA_LIFCR_CDMEIF3 |
+		      DMA_LIFCR_CFEIF3;
+
+	/* Rx stream is enabled first, so that no received word is missed */
+	SPI_RXDMA_STREAM->M0AR = (uint32_t)frame;
+	SPI_RXDMA_STREAM->NDTR = n_words;
+	SPI_RXDMA_STREAM->CR |= DMA_SxCR_EN;
+
+	SPI_TXDMA_STREAM->NDTR = n_words;
+	SPI_TXDMA_STREAM->CR |= DMA_SxCR_EN;
+}
+
+/**
+ * @brief 	Check if a frame read is in progress
+ * @return	true if the frame read is in progress, false otherwise
+ */
+bool stm32_spi_dma_frame_busy(void)
+{
+	return spi_dma_frame_in_progress;
+}
+
+/**
+ * @brief 	SPI Rx DMA stream interrupt handler
+ * @return	None
+ */
+void DMA2_Stream0_IRQHandler(void)
+{
+	if (DMA2->LISR & DMA_LISR_TCIF0) {
+		DMA2->LIFCR = DMA_LIFCR_CTCIF0;
+
+		/* Release chip select */
+		SPI_CS_PORT_BASE->BSRR = NO_OS_BIT(SPI_CSB);
+
+		/* Frame is consumed before the next BUSY edge can start a read */
+		ad7606_frame_dma_cplt();
+		spi_dma_frame_in_progress = false;
+	}
+}
+#endif
+
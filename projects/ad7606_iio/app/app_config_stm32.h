@@ -18,6 +18,7 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "stm32_uart.h"
 #include "stm32_i2c.h"
 #include "stm32_spi.h"
@@ -74,6 +75,7 @@
 #define SPI_DEVICE_ID       1 // SPI1
 #define SPI_CSB             15 //PA15
 #define SPI_CS_PORT   0  //PORTA
+#define SPI_CS_PORT_BASE	GPIOA
 
 /* Interrupt Callback parameters */
 #define INT_EVENT         12 // PD12
@@ -89,7 +91,14 @@
  * IIO client. This is derived by testing the firmware on SDP-K1 controller board
  * @22Mhz SPI clock. The max possible ODR can vary from board to board and
  * data continuity is not guaranteed above this ODR on IIO oscilloscope */
+#if (INTERFACE_MODE == SPI_DMA)
+/* Note: In SPI DMA mode, the conversion period must accommodate the conversion
+ * time (BUSY high) and the SPI read of one frame of all channels.
+ * Max ODR is 100KSPS per channel for 8-channel devices @22.5Mhz SPI clock */
+#define SAMPLING_RATE					(100000)
+#else
 #define SAMPLING_RATE					(20000)
+#endif
 
 /* STM32  PWM Specific parameters */
 #define PWM_ID          4 //Timer4
@@ -98,6 +107,25 @@
 #define PWM_PRESCALER   3
 #define PWM_HANDLE      htim4
 
+#if (INTERFACE_MODE == SPI_DMA)
+/* STM32 CONVST PWM specific parameters (CONVST pin in TIM1 CH3 function) */
+#define CONVST_PWM_ID			1 // Timer1
+#define CONVST_PWM_CHANNEL		3 // Channel 3
+#define CONVST_PWM_CLK_DIVIDER	2 // multiplier to get timer clock from PLCK2
+#define CONVST_PWM_PRESCALER	1
+#define CONVST_PWM_HANDLE		htim1
+
+/* BUSY interrupt parameters */
+#define BUSY_IRQ_ID			BUSY_PIN
+#define BUSY_IRQ_PRIORITY	1
+
+/* SPI1 Rx/Tx DMA streams and channel (Ref: STM32F469 DMA2 request mapping) */
+#define SPI_RXDMA_STREAM	DMA2_Stream0
+#define SPI_TXDMA_STREAM	DMA2_Stream3
+#define SPI_DMA_CHANNEL		DMA_CHANNEL_3
+#define SPI_RXDMA_IRQ_ID	DMA2_Stream0_IRQn
+#endif
+
 /******************************************************************************/
 /********************** Variables and User Defined Data Types *****************/
 /******************************************************************************/
@@ -105,6 +133,9 @@
 extern UART_HandleTypeDef APP_UART_HANDLE;
 extern USBD_HandleTypeDef APP_UART_USB_HANDLE;
 extern TIM_HandleTypeDef PWM_HANDLE;
+#if (INTERFACE_MODE == SPI_DMA)
+extern TIM_HandleTypeDef CONVST_PWM_HANDLE;
+#endif
 
 extern struct stm32_gpio_irq_init_param stm32_trigger_gpio_irq_init_params;
 extern struct stm32_gpio_init_param stm32_trigger_gpio_extra_init_params;
@@ -123,7 +154,20 @@ extern struct stm32_usb_uart_init_param stm32_vcom_extra_init_params;
 extern struct stm32_spi_init_param stm32_spi_extra_init_params;
 extern struct stm32_i2c_init_param stm32_i2c_extra_init_params;
 
+#if (INTERFACE_MODE == SPI_DMA)
+extern struct stm32_gpio_irq_init_param stm32_busy_gpio_irq_init_params;
+extern struct stm32_pwm_init_param stm32_convst_pwm_extra_init_params;
+#endif
+
 extern void stm32_system_init(void);
 
+#if (INTERFACE_MODE == SPI_DMA)
+void stm32_convst_output_gpio_config(bool is_gpio);
+void stm32_spi_dma_frame_config(bool enable);
+void stm32_spi_dma_frame_read(uint16_t *frame, uint16_t n_words);
+bool stm32_spi_dma_frame_busy(void);
+void ad7606_frame_dma_cplt(void);
+#endif
+
 #endif
 
@@ -28,6 +28,7 @@
 #include "common.h"
 #include "ad7779.h"
 #include "iio.h"
+#include "burst_capture.h"
 #if (INTERFACE_MODE == TDM_MODE)
 #include "stm32_tdm_support.h"
 #endif
@@ -106,12 +107,10 @@ static void ad777x_update_scale_factor(void);
 /* Attenuation factor for SRC Mux input */
 #define AD777X_SRC_ATT_FACTOR	6
 
-/* ADC data buffer size */
+/* ADC data buffer */
 #if defined(USE_SDRAM)
 #define adc_data_buffer				SDRAM_START_ADDRESS
-#define DATA_BUFFER_SIZE			SDRAM_SIZE_BYTES
 #else
-#define DATA_BUFFER_SIZE			(128000)
 static int8_t adc_data_buffer[DATA_BUFFER_SIZE];
 #endif
 
@@ -121,6 +120,15 @@ static int8_t adc_data_buffer[DATA_BUFFER_SIZE];
 /* Number of IIO Devices */
 #define NUM_OF_IIO_DEVICES			1
 
+/* Burst capture reading one scan per conversion over SPI (not TDM-DMA) */
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE) && \
+	((ADC_TYPE == SAR_ADC) || (INTERFACE_MODE == SPI_MODE))
+#define SPI_BURST_CAPTURE
+#endif
+
+/* Number of scans staged before committing to the IIO buffer in burst mode */
+#define BURST_BLOCK_SCANS			64
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -176,6 +184,7 @@ enum ad777x_attribute_id {
 	REF2P_AVSSX_MUX_ATTR_ID,
 	AVSSX_AVDD4_MUX_ATTR_ID,
 	SINC5_STATE_ATTR_ID,
+	TDM_DROPPED_SLOTS_ATTR_ID,
 };
 
 /* Channel Scan Type */
@@ -229,6 +238,9 @@ static struct iio_attribute ad777x_global_attributes[] = {
 	AD777x_CH_AVAIL_ATTR("sinc_5_state", SINC5_STATE_ATTR_ID),
 	AD777x_CH_ATTR("sinc_5_state_available", SINC5_STATE_ATTR_ID),
 #endif
+#if (INTERFACE_MODE == TDM_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	AD777x_CH_ATTR("tdm_dropped_slots", TDM_DROPPED_SLOTS_ATTR_ID),
+#endif
 
 	END_ATTRIBUTES_ARRAY
 };
@@ -290,6 +302,20 @@ static bool hw_mezzanine_is_valid;
 /* Flag to denote that sample has been captured */
 static bool data_capture_done = false;
 
+#if defined(SPI_BURST_CAPTURE)
+static int32_t ad777x_burst_read_scan(void *ctx, void *scan);
+
+/* Block-batched burst capture init parameters */
+static struct burst_capture_init_param burst_capture_init_params = {
+	.read_unit = ad777x_burst_read_scan,
+	.unit_size = BYTES_PER_SAMPLE * AD777x_NUM_CHANNELS,
+	.block_units = BURST_BLOCK_SCANS,
+};
+
+/* Block-batched burst capture descriptor */
+static struct burst_capture_desc *ad777x_burst_desc;
+#endif
+
 /* Flag to indicate if size of the buffer is updated according to requested
  * number of samples for the multi-channel IIO buffer data alignment */
 static volatile bool buf_size_updated = false;
@@ -330,6 +356,9 @@ static int ad777x_get_attribute(void *device, char *buf, uint32_t len,
 	float sar_conv_value;
 	uint16_t dec_rate_int;
 	uint16_t dec_rate_float;
+#if (INTERFACE_MODE == TDM_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	uint32_t dropped_slots;
+#endif
 
 	switch (priv) {
 	case RAW_ATTR_ID:
@@ -703,6 +732,17 @@ static int ad777x_get_attribute(void *device, char *buf, uint32_t len,
 	case SINC5_STATE_ATTR_ID:
 		return snprintf(buf, len, "%s", sinc5_values[p_ad777x_dev_inst->sinc5_state]);
 
+#if (INTERFACE_MODE == TDM_MODE) && (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	case TDM_DROPPED_SLOTS_ATTR_ID:
+		/* TDM slots dropped since the start of the ongoing (or last) data
+		 * capture, due to the IIO buffer being full */
+		ret = stm32_tdm_stream_get_dropped_slots(ad777x_tdm_stream, &dropped_slots);
+		if (ret) {
+			return ret;
+		}
+		return sprintf(buf, "%lu", (unsigned long)dropped_slots);
+#endif
+
 	default:
 		break;
 	}
@@ -855,6 +895,7 @@ static int ad777x_set_attribute(void *device, char *buf, uint32_t len,
 	case SCALE_ATTR_ID:
 	case OFFSET_ATTR_ID:
 	case SAMPLING_FREQ_ATTR_ID:
+	case TDM_DROPPED_SLOTS_ATTR_ID:
 	default:
 		break;
 	}
@@ -1047,8 +1088,8 @@ static int32_t ad777x_prepare_transfer(void *dev, uint32_t ch_mask)
 		return ret;
 	}
 #if (INTERFACE_MODE == TDM_MODE)
-	ret = start_tdm_dma_to_cb_transfer(ad777x_tdm_desc, ad777x_iio_dev_data,
-					   TDM_DMA_READ_SIZE, BYTES_PER_SAMPLE, TDM_DMA_READ_SIZE);
+	ret = stm32_tdm_stream_start(ad777x_tdm_stream,
+				     ad777x_iio_dev_data->buffer->buf, 0);
 	if (ret) {
 		return ret;
 	}
@@ -1114,7 +1155,7 @@ static int32_t ad777x_end_transfer(void *dev)
 #else // TDM_MODE
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 	/* Stop TDM DMA data capture */
-	ret = no_os_tdm_stop(ad777x_tdm_desc);
+	ret = stm32_tdm_stream_stop(ad777x_tdm_stream);
 	if (ret) {
 		return ret;
 	}
@@ -1126,36 +1167,46 @@ static int32_t ad777x_end_transfer(void *dev)
 	return 0;
 }
 
+#if defined(SPI_BURST_CAPTURE)
 /**
- * @brief Read SAR ADC data in burst mode via SPI
- * @param nb_of_samples[in] - Number of samples requested by IIO
- * @param iio_dev_data[in] - IIO Device data instance
+ * @brief Read one scan of the burst (burst capture read op)
+ * @param ctx[in] - Unused context
+ * @param scan[out] - Scan read (SAR ADC code or all channels' SD ADC codes)
  * @return 0 in case of success or negative value otherwise
  */
-static int32_t ad777x_read_burst_data_sar_spi(uint32_t nb_of_samples,
-		struct iio_device_data *iio_dev_data)
+static int32_t ad777x_burst_read_scan(void *ctx, void *scan)
 {
-	uint16_t sar_adc_code;
-	uint32_t sample_index = 0;
-	int32_t ret;
-
 #if (ADC_TYPE == SAR_ADC)
-	while (sample_index < nb_of_samples) {
-		ret = ad7779_sar_data_read(p_ad777x_dev_inst, SAR_MUX_CONF, &sar_adc_code);
-		if (ret) {
-			return ret;
-		}
+	return ad7779_sar_data_read(p_ad777x_dev_inst, SAR_MUX_CONF,
+				    (uint16_t *)scan);
+#else
+	uint32_t timeout = AD777x_CONV_TIMEOUT;
 
-		ret = no_os_cb_write(iio_dev_data->buffer->buf, &sar_adc_code,
-				     BYTES_PER_SAMPLE * AD777x_NUM_CHANNELS);
-		if (ret) {
-			return ret;
-		}
-		sample_index += AD777x_NUM_CHANNELS;
+	/* Check for data capture completion */
+	while (!data_capture_done && (timeout > 0)) {
+		timeout--;
 	}
+	if (timeout == 0) {
+		return -ETIMEDOUT;
+	}
+	data_capture_done = false;
+
+	return ad777x_read_all_channels(p_ad777x_dev_inst, (uint32_t *)scan);
 #endif
+}
 
-	return 0;
+/**
+ * @brief Read SAR ADC data in burst mode via SPI
+ * @param nb_of_samples[in] - Number of samples requested by IIO
+ * @param iio_dev_data[in] - IIO Device data instance
+ * @return 0 in case of success or negative value otherwise
+ */
+static int32_t ad777x_read_burst_data_sar_spi(uint32_t nb_of_samples,
+		struct iio_device_data *iio_dev_data)
+{
+	/* Samples are committed to the IIO buffer in blocks */
+	return burst_capture_read(ad777x_burst_desc, iio_dev_data->buffer->buf,
+				  nb_of_samples / AD777x_NUM_CHANNELS);
 }
 
 /**
@@ -1167,9 +1218,6 @@ static int32_t ad777x_read_burst_data_sar_spi(uint32_t nb_of_samples,
 static int32_t ad777x_read_burst_data_spi(uint32_t nb_of_samples,
 		struct iio_device_data *iio_dev_data)
 {
-	uint32_t adc_raw_buff[AD777x_NUM_CHANNELS] = { 0x0 };
-	uint32_t timeout;
-	uint32_t sample_index = 0;
 	int32_t ret;
 
 	/* Start conversion by setting the ADC to SD conversion mode */
@@ -1178,29 +1226,11 @@ static int32_t ad777x_read_burst_data_spi(uint32_t nb_of_samples,
 		return ret;
 	}
 
-	while (sample_index < nb_of_samples) {
-		timeout = AD777x_CONV_TIMEOUT;
-
-		/* Check for data capture completion */
-		while (!data_capture_done) {
-			timeout--;
-		}
-		if (timeout == 0) {
-			return -ETIMEDOUT;
-		}
-		data_capture_done = false;
-
-		ret = ad777x_read_all_channels(p_ad777x_dev_inst, adc_raw_buff);
-		if (ret) {
-			return ret;
-		}
-
-		ret = no_os_cb_write(iio_dev_data->buffer->buf, adc_raw_buff,
-				     BYTES_PER_SAMPLE * AD777x_NUM_CHANNELS);
-		if (ret) {
-			return ret;
-		}
-		sample_index += AD777x_NUM_CHANNELS;
+	/* Scans are committed to the IIO buffer in blocks */
+	ret = burst_capture_read(ad777x_burst_desc, iio_dev_data->buffer->buf,
+				 nb_of_samples / AD777x_NUM_CHANNELS);
+	if (ret) {
+		return ret;
 	}
 
 	/* Stop conversion by setting ADC to INT reg mode */
@@ -1211,6 +1241,7 @@ static int32_t ad777x_read_burst_data_spi(uint32_t nb_of_samples,
 
 	return 0;
 }
+#endif
 
 /**
  * @brief Read data in burst mode via TDM-DMA
@@ -1526,6 +1557,15 @@ int32_t ad777x_iio_initialize(void)
 	}
 
 	if (hw_mezzanine_is_valid) {
+#if defined(SPI_BURST_CAPTURE)
+		/* Init the block-batched burst capture */
+		init_status = burst_capture_init(&ad777x_burst_desc,
+						 &burst_capture_init_params);
+		if (init_status) {
+			return init_status;
+		}
+#endif
+
 		/* Initialize the AD777x IIO application interface */
 		init_status = iio_ad777x_init(&p_iio_ad777x_dev);
 		if (init_status) {
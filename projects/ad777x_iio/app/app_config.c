@@ -19,6 +19,9 @@
 #include "no_os_gpio.h"
 #include "no_os_irq.h"
 #include "no_os_tdm.h"
+#if (INTERFACE_MODE == TDM_MODE)
+#include "stm32_tdm_support.h"
+#endif
 #include "no_os_pwm.h"
 
 /******************************************************************************/
@@ -117,6 +120,16 @@ struct no_os_tdm_init_param tdm_init_param = {
 };
 
 struct no_os_tdm_desc *ad777x_tdm_desc;
+
+/* TDM stream init parameters */
+static struct stm32_tdm_stream_init_param tdm_stream_init_param = {
+	.slot_samples = TDM_DMA_READ_SIZE,
+	.bytes_per_sample = BYTES_PER_SAMPLE,
+	.max_buffer_size = DATA_BUFFER_SIZE
+};
+
+/* TDM stream descriptor */
+struct stm32_tdm_stream_desc *ad777x_tdm_stream;
 #endif
 
 /* I2C init parameters */
@@ -290,6 +303,13 @@ int32_t init_tdm(void)
 	if (ret) {
 		return ret;
 	}
+
+	tdm_stream_init_param.tdm_desc = ad777x_tdm_desc;
+
+	ret = stm32_tdm_stream_init(&ad777x_tdm_stream, &tdm_stream_init_param);
+	if (ret) {
+		return ret;
+	}
 #endif
 
 	return 0;
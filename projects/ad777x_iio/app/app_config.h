@@ -192,6 +192,13 @@
 /* Enable/Disable the use of SDRAM for ADC data capture buffer */
 // #define USE_SDRAM	// Uncomment to use SDRAM as data buffer
 
+/* ADC data buffer size */
+#if defined(USE_SDRAM)
+#define DATA_BUFFER_SIZE			SDRAM_SIZE_BYTES
+#else
+#define DATA_BUFFER_SIZE			(128000)
+#endif
+
 /* Check if any serial port available for use as console stdio port */
 #if defined(USE_PHY_COM_PORT)
 /* If PHY com is selected, VCOM or alternate PHY com port can act as a console stdio port */
@@ -278,6 +285,9 @@ extern struct no_os_gpio_desc *gpio_drdy_desc;
 extern struct no_os_gpio_desc *gpio_error_desc;
 extern struct no_os_irq_ctrl_desc *trigger_irq_desc;
 extern struct no_os_tdm_desc *ad777x_tdm_desc;
+#if (INTERFACE_MODE == TDM_MODE)
+extern struct stm32_tdm_stream_desc *ad777x_tdm_stream;
+#endif
 extern struct no_os_eeprom_desc *eeprom_desc;
 
 #endif // APP_CONFIG_H
@@ -197,8 +197,7 @@ void ad777x_dma_rx_half_cplt(SAI_HandleTypeDef *hsai)
 {
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 	if (data_capture_operation) {
-		end_tdm_dma_to_cb_transfer(ad777x_tdm_desc, ad777x_iio_dev_data,
-					   TDM_DMA_READ_SIZE, BYTES_PER_SAMPLE);
+		stm32_tdm_stream_half_cplt(ad777x_tdm_stream);
 	}
 #endif
 }
@@ -214,12 +213,8 @@ void ad777x_dma_rx_cplt(SAI_HandleTypeDef *hsai)
 
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 	if (data_capture_operation) {
-		end_tdm_dma_to_cb_transfer(ad777x_tdm_desc, ad777x_iio_dev_data,
-					   TDM_DMA_READ_SIZE, BYTES_PER_SAMPLE);
-
-		/* Start TDM DMA read as the peripheral is disabled in Normal(Linear)
-		 * Buffer Mode upon buffer completion */
-		no_os_tdm_read(ad777x_tdm_desc, dma_buff, TDM_DMA_READ_SIZE << 1);
+		/* Publish the completed slot */
+		stm32_tdm_stream_cplt(ad777x_tdm_stream);
 	}
 #endif
 }
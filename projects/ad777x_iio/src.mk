@@ -14,11 +14,17 @@ SRC_DIRS += $(LIBRARIES_PATH)/precision-converters-library/sdp_k1_sdram
 ifeq 'mbed' '$(PLATFORM)'
 # ALL_IGNORED_FILES variable used for excluding particular source files in SRC_DIRS in Build
 SRC_DIRS += $(LIBRARIES_PATH)/no-OS/drivers/platform/mbed
+SRC_DIRS += $(ROOT_DRIVE)/projects/_common
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/stm32
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/linux
+# The CMSIS-DSP based modules of the common sources are not used
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/decimation_stage.c
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/decimation_stage.h
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/welch_fft.c
+ALL_IGNORED_FILES += $(ROOT_DRIVE)/projects/_common/welch_fft.h
 ALL_IGNORED_FILES += $(PROJECT_APP_PATH)/app_config_stm32.c
-ALL_IGNORED_FILES += $(PROJECT_APP_PATH)/stm32_tdm_support.c
 ALL_IGNORED_FILES += $(PROJECT_APP_PATH)/stm32_gpio_irq_generated.c
 ALL_IGNORED_FILES += $(PROJECT_APP_PATH)/app_config_stm32.h
-ALL_IGNORED_FILES += $(PROJECT_APP_PATH)/stm32_tdm_support.h
 
 # Extra Macros
 override NEW_CFLAGS += -DACTIVE_PLATFORM=MBED_PLATFORM
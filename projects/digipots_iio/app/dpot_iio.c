@@ -458,6 +458,16 @@ static uint8_t dpot_interface_indx = 0;
 /* Restart IIO flag */
 bool restart_iio_flag = false;
 
+/* Device configuration the IIO interface was last initialized with. The
+ * active device and its operating mode shape the IIO context (device name
+ * and channels), which is generated once by iio_init() */
+static struct {
+	bool valid;
+	enum dpot_dev_id active_device;
+	enum dpot_intf_type intf_type;
+	enum dpot_operating_mode mode;
+} dpot_applied_dev;
+
 /* EVB HW validation status */
 static bool hw_mezzanine_is_valid;
 
@@ -1218,6 +1228,8 @@ int dpot_iio_init(void)
 	init_default();
 #endif
 
+	dpot_applied_dev.valid = false;
+
 	if (hw_mezzanine_is_valid) {
 		dpot_iio_init_params.nb_devs = 0;
 		if (oactive_dev.active_device != 0XFF) {
@@ -1250,6 +1262,11 @@ int dpot_iio_init(void)
 			dpot_iio_dev_init_params[dpot_iio_init_params.nb_devs].dev_descriptor =
 				dpot_iio_dev[dpot_iio_init_params.nb_devs];
 			dpot_iio_init_params.nb_devs++;
+
+			dpot_applied_dev.valid = true;
+			dpot_applied_dev.active_device = oactive_dev.active_device;
+			dpot_applied_dev.intf_type = oactive_dev.intf_type;
+			dpot_applied_dev.mode = oactive_dev.mode;
 		}
 		/* Add Board IIO device */
 #ifdef DPOT_ADD_BOARD_DEVICE
@@ -1282,6 +1299,56 @@ int dpot_iio_init(void)
 	return 0;
 }
 
+#ifdef DPOT_ADD_BOARD_DEVICE
+/**
+ * @brief	Apply the staged device configuration to the running device
+ * @return	0 in case of success, negative error code otherwise
+ * @details	A new active device or operating mode changes the IIO context and
+ *			needs a full restart (-EAGAIN). A new interface only re-creates
+ *			the digipot device descriptor, keeping the IIO interface: the
+ *			attribute handlers access the device through dpot_dev_desc.
+ */
+static int dpot_iio_apply_config(void)
+{
+	int ret;
+
+	if (!dpot_applied_dev.valid) {
+		/* No device to reconfigure (HW mezzanine not detected) */
+		return -ENODEV;
+	}
+
+	if ((oactive_dev.active_device != dpot_applied_dev.active_device)
+	    || (oactive_dev.mode != dpot_applied_dev.mode)) {
+		return -EAGAIN;
+	}
+
+	if (oactive_dev.intf_type == dpot_applied_dev.intf_type) {
+		return 0;
+	}
+
+	ret = dpot_remove(dpot_dev_desc);
+	if (ret) {
+		return ret;
+	}
+	dpot_dev_desc = NULL;
+	dpot_applied_dev.valid = false;
+
+	dpot_info[oactive_dev.active_device].dpot_init_params.intf_type =
+		oactive_dev.intf_type;
+	ret = dpot_init(&dpot_dev_desc,
+			&dpot_info[oactive_dev.active_device].dpot_init_params);
+	if (ret) {
+		return ret;
+	}
+
+	dpot_iio_dev_init_params[0].dev = dpot_dev_desc;
+	dpot_applied_dev.valid = true;
+	dpot_applied_dev.intf_type = oactive_dev.intf_type;
+
+	return 0;
+}
+#endif
+
 /**
  * @brief 	Run the digipot IIO event handler
  * @return	none
@@ -1291,24 +1358,30 @@ void dpot_iio_event_handler(void)
 {
 #ifdef DPOT_ADD_BOARD_DEVICE
 	if (restart_iio_flag) {
-		/* Free resources from the dpot_dev */
-		dpot_remove(dpot_dev_desc);
+		/* Reset the restart_iio flag */
+		restart_iio_flag = false;
 
-		/* Free the board descriptor */
-		free(board_dev);
+		/* Keep the IIO interface unless the staged configuration changes
+		 * the IIO context */
+		if (dpot_iio_apply_config()) {
+			/* Free resources from the dpot_dev */
+			if (dpot_dev_desc) {
+				dpot_remove(dpot_dev_desc);
+			}
 
-		iio_params_deinit();
+			/* Free the board descriptor */
+			free(board_dev);
 
-		board_dev = NULL;
+			iio_params_deinit();
 
-		/* Free IIO desc resources */
-		iio_remove(dpot_iio_desc);
+			board_dev = NULL;
 
-		/* Reset the restart_iio flag */
-		restart_iio_flag = false;
+			/* Free IIO desc resources */
+			iio_remove(dpot_iio_desc);
 
-		/* Invoke init again */
-		dpot_iio_init();
+			/* Invoke init again */
+			dpot_iio_init();
+		}
 	}
 #endif
 	(void)iio_step(dpot_iio_desc);
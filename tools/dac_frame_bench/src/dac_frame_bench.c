@@ -0,0 +1,374 @@
+/***************************************************************************//**
+ * @file    dac_frame_bench.c
+ * @brief   Host microbenchmark of the DAC SPI DMA frame building
+ * @details Times the frame building done before every DMA start, against the
+ *          previous implementations (byte by byte backward walk for the
+ *          single instruction mode, memmove of the buffer for the streaming
+ *          mode, per scan byte loop for the AD5706R SW LDAC frames), over a
+ *          range of buffer sizes and active channel counts.
+ *          The frames of both implementations are checked to be identical.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "dac_frame_builder.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Largest buffer benchmarked (firmware internal DAC data buffer) */
+#define BENCH_MAX_BUFFER_SIZE	65536
+
+/* Total bytes processed per measurement (repetitions scale with the size) */
+#define BENCH_BYTES_PER_RUN		(64 * 1024 * 1024)
+
+/* AD5706R firmware DAC data buffer (SW LDAC frames built from the IIO buffer) */
+#define BENCH_LDAC_BUFFER_SIZE	32768
+
+/* AD5706R SW LDAC frame bytes (multi device address, register, write bit) */
+#define BENCH_LDAC_MD_ADDR		0x01
+#define BENCH_LDAC_INPUT_A(chn)	(0x61 + 2 * (chn))
+#define BENCH_LDAC_SW_LDAC		0x51
+#define BENCH_LDAC_WRITE_LONG	0x80
+#define BENCH_LDAC_MASK			0xA5
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Buffer sizes (bytes of samples received from the IIO client) */
+static const uint32_t bench_sizes[] = {
+	1024, 4096, 16384, 32768
+};
+
+/* Active channel counts */
+static const uint8_t bench_chns[] = {
+	1, 2, 4, 8
+};
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief	Previous single instruction frame building (reference)
+ * @param	buff[in,out] - IIO buffer, holding at least 2 * nb_bytes
+ * @param	nb_bytes[in] - Size of the samples in the buffer (in bytes)
+ * @param	instr[in] - Instruction of each active channel, in scan order
+ * @param	nb_chns[in] - Number of active channels
+ * @return	none
+ */
+static void legacy_single_instr(int8_t *buff, uint32_t nb_bytes,
+				const uint16_t *instr, uint8_t nb_chns)
+{
+	uint16_t nb_of_samples_per_chn = nb_bytes / (2 * nb_chns);
+	uint32_t iio_buff_idx = nb_bytes - 1;
+	uint32_t modified_buff_idx = 2 * nb_bytes - 1;
+	int16_t sample_id;
+	int8_t ch_id;
+
+	for (sample_id = nb_of_samples_per_chn - 1; sample_id >= 0; sample_id--) {
+		for (ch_id = nb_chns - 1; ch_id >= 0; ch_id--) {
+			buff[modified_buff_idx--] = buff[iio_buff_idx--];
+			buff[modified_buff_idx--] = buff[iio_buff_idx--];
+			buff[modified_buff_idx--] = instr[ch_id];
+			buff[modified_buff_idx--] = instr[ch_id] >> 8;
+		}
+	}
+}
+
+/**
+ * @brief	Previous AD5706R SW LDAC frame building (reference)
+ * @param	iio_buff[in] - IIO buffer
+ * @param	nb_scans[in] - Number of scans in the IIO buffer
+ * @param	chns[in] - Active channels
+ * @param	nb_chns[in] - Number of active channels
+ * @param	func_en_mask[in] - Channels not in LDAC mode
+ * @param	sw_ldac_buff[out] - Frames
+ * @return	Size of the frames (in bytes)
+ */
+static uint32_t legacy_sw_ldac(const int8_t *iio_buff, uint32_t nb_scans,
+			       const uint8_t *chns, uint8_t nb_chns,
+			       uint16_t func_en_mask, uint8_t *sw_ldac_buff)
+{
+	uint32_t modified_buff_idx = 0;
+	uint32_t iio_buff_idx = 0;
+	uint32_t sample_id;
+	uint8_t active_chn;
+
+	for (sample_id = 0; sample_id < nb_scans; sample_id++) {
+		for (active_chn = 0; active_chn < nb_chns; active_chn++) {
+			if (!(func_en_mask & (1u << chns[active_chn]))) {
+				sw_ldac_buff[modified_buff_idx++] = BENCH_LDAC_MD_ADDR;
+				sw_ldac_buff[modified_buff_idx++] = BENCH_LDAC_INPUT_A(chns[active_chn]);
+				sw_ldac_buff[modified_buff_idx++] = iio_buff[iio_buff_idx + 1];
+				sw_ldac_buff[modified_buff_idx++] = iio_buff[iio_buff_idx];
+			}
+			iio_buff_idx += 2;
+		}
+
+		sw_ldac_buff[modified_buff_idx++] = BENCH_LDAC_MD_ADDR;
+		sw_ldac_buff[modified_buff_idx++] = BENCH_LDAC_SW_LDAC;
+		sw_ldac_buff[modified_buff_idx++] = BENCH_LDAC_WRITE_LONG;
+		sw_ldac_buff[modified_buff_idx++] = BENCH_LDAC_MASK;
+	}
+
+	return modified_buff_idx;
+}
+
+/**
+ * @brief	Fill the buffer with samples
+ * @param	buff[out] - Buffer
+ * @param	nb_bytes[in] - Number of bytes to fill
+ * @return	none
+ */
+static void fill_samples(uint8_t *buff, uint32_t nb_bytes)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb_bytes; i++) {
+		buff[i] = (uint8_t)(i * 7 + (i >> 8));
+	}
+}
+
+/**
+ * @brief	Get a monotonic time stamp
+ * @return	Time (in ns)
+ */
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief	Benchmark the single instruction frame building
+ * @param	size[in] - Buffer size (in bytes)
+ * @param	nb_chns[in] - Number of active channels
+ * @param	work[in] - Work memory (BENCH_MAX_BUFFER_SIZE * 2 bytes)
+ * @param	ref[in] - Reference memory (BENCH_MAX_BUFFER_SIZE * 2 bytes)
+ * @return	0 in case of success, -1 on frame mismatch
+ */
+static int bench_single_instr(uint32_t size, uint8_t nb_chns, uint8_t *work,
+			      uint8_t *ref)
+{
+	uint16_t instr[DAC_FRAME_MAX_CHANNELS];
+	uint32_t reps = BENCH_BYTES_PER_RUN / size;
+	uint32_t frames_size;
+	uint64_t legacy_ns;
+	uint64_t start;
+	uint32_t rep;
+	uint8_t chn;
+
+	for (chn = 0; chn < nb_chns; chn++) {
+		instr[chn] = 0x0800 | (0x10 + 2 * chn);
+	}
+
+	/* Only whole scans are sent */
+	size -= size % (2 * nb_chns);
+
+	fill_samples(ref, size);
+	legacy_single_instr((int8_t *)ref, size, instr, nb_chns);
+	fill_samples(work, size);
+	dac_frame_build_single_instr(work, size, instr, nb_chns, &frames_size);
+	if (frames_size != 2 * size || memcmp(work, ref, frames_size)) {
+		printf("single instruction frames mismatch (%u bytes, %u chns)\n",
+		       size, nb_chns);
+		return -1;
+	}
+
+	/* The samples are not restored between runs, only the timing matters */
+	start = now_ns();
+	for (rep = 0; rep < reps; rep++) {
+		legacy_single_instr((int8_t *)ref, size, instr, nb_chns);
+	}
+	legacy_ns = now_ns() - start;
+
+	start = now_ns();
+	for (rep = 0; rep < reps; rep++) {
+		dac_frame_build_single_instr(work, size, instr, nb_chns, &frames_size);
+	}
+
+	printf("single_instr  %6u  %4u  %10.2f  %10.2f\n", size, nb_chns,
+	       (double)legacy_ns / reps / 1000,
+	       (double)(now_ns() - start) / reps / 1000);
+
+	return 0;
+}
+
+/**
+ * @brief	Benchmark the streaming mode frame building
+ * @param	size[in] - Buffer size (in bytes)
+ * @param	work[in] - Work memory (BENCH_MAX_BUFFER_SIZE * 2 bytes)
+ * @param	ref[in] - Reference memory (BENCH_MAX_BUFFER_SIZE * 2 bytes)
+ * @return	0 in case of success, -1 on frame mismatch
+ */
+static int bench_stream(uint32_t size, uint8_t *work, uint8_t *ref)
+{
+	uint32_t reps = BENCH_BYTES_PER_RUN / size;
+	uint8_t *payload = work + DAC_FRAME_HEADROOM;
+	uint8_t *frame = NULL;
+	uint64_t legacy_ns;
+	uint64_t start;
+	uint32_t rep;
+
+	fill_samples(ref, size);
+	memmove(ref + 2, ref, size);
+	ref[0] = 0x00;
+	ref[1] = 0x10;
+	fill_samples(payload, size);
+	frame = dac_frame_prepend_instr(payload, 0x10);
+	if (memcmp(frame, ref, size + DAC_FRAME_INSTR_SIZE)) {
+		printf("streaming frames mismatch (%u bytes)\n", size);
+		return -1;
+	}
+
+	start = now_ns();
+	for (rep = 0; rep < reps; rep++) {
+		memmove(ref + 2, ref, size);
+		ref[0] = 0x00;
+		ref[1] = 0x10;
+	}
+	legacy_ns = now_ns() - start;
+
+	start = now_ns();
+	for (rep = 0; rep < reps; rep++) {
+		frame = dac_frame_prepend_instr(payload, 0x10);
+	}
+
+	printf("stream        %6u  %4s  %10.2f  %10.2f\n", size, "-",
+	       (double)legacy_ns / reps / 1000,
+	       (double)(now_ns() - start) / reps / 1000);
+
+	/* Keep the result alive */
+	return frame[0] == 0x00 ? 0 : -1;
+}
+
+/**
+ * @brief	Benchmark the AD5706R SW LDAC template frame stamping
+ * @param	nb_chns[in] - Number of active channels (all in LDAC mode)
+ * @param	work[in] - Work memory (BENCH_MAX_BUFFER_SIZE * 2 bytes)
+ * @param	ref[in] - Reference memory (BENCH_MAX_BUFFER_SIZE * 2 bytes)
+ * @return	0 in case of success, -1 on frame mismatch
+ */
+static int bench_sw_ldac(uint8_t nb_chns, uint8_t *work, uint8_t *ref)
+{
+	/* As many scans as the frames fit in the firmware buffer */
+	uint32_t nb_scans = BENCH_LDAC_BUFFER_SIZE / ((nb_chns + 1) * DAC_FRAME_SIZE);
+	uint32_t size = nb_scans * nb_chns * 2;
+	uint32_t reps = BENCH_BYTES_PER_RUN / size;
+	uint8_t *samples = ref + BENCH_MAX_BUFFER_SIZE;
+	uint8_t frame[DAC_FRAME_SIZE] = { 0 };
+	uint8_t chns[DAC_FRAME_MAX_CHANNELS];
+	struct dac_frame_template tmpl;
+	uint32_t frames_size;
+	uint32_t legacy_size;
+	uint64_t legacy_ns;
+	uint64_t new_ns;
+	uint64_t start;
+	uint32_t rep;
+	uint8_t chn;
+
+	dac_frame_template_init(&tmpl, nb_chns, true);
+	for (chn = 0; chn < nb_chns; chn++) {
+		chns[chn] = chn;
+		frame[0] = BENCH_LDAC_MD_ADDR;
+		frame[1] = BENCH_LDAC_INPUT_A(chn);
+		dac_frame_template_add(&tmpl, frame, chn);
+	}
+	frame[0] = BENCH_LDAC_MD_ADDR;
+	frame[1] = BENCH_LDAC_SW_LDAC;
+	frame[2] = BENCH_LDAC_WRITE_LONG;
+	frame[3] = BENCH_LDAC_MASK;
+	dac_frame_template_add(&tmpl, frame, DAC_FRAME_NO_SAMPLE);
+
+	fill_samples(samples, size);
+	legacy_size = legacy_sw_ldac((int8_t *)samples, nb_scans, chns, nb_chns, 0, ref);
+	fill_samples(work, size);
+	if (dac_frame_stamp(&tmpl, work, nb_scans, BENCH_LDAC_BUFFER_SIZE,
+			    &frames_size)
+	    || frames_size != legacy_size || memcmp(work, ref, frames_size)) {
+		printf("sw ldac frames mismatch (%u chns)\n", nb_chns);
+		return -1;
+	}
+
+	start = now_ns();
+	for (rep = 0; rep < reps; rep++) {
+		legacy_sw_ldac((int8_t *)samples, nb_scans, chns, nb_chns, 0, ref);
+	}
+	legacy_ns = now_ns() - start;
+
+	/* The samples are not restored between runs, only the timing matters */
+	start = now_ns();
+	for (rep = 0; rep < reps; rep++) {
+		dac_frame_stamp(&tmpl, work, nb_scans, BENCH_LDAC_BUFFER_SIZE,
+				&frames_size);
+	}
+	new_ns = now_ns() - start;
+
+	printf("sw_ldac       %6u  %4u  %10.2f  %10.2f  %8.1f  %8.1f\n", size,
+	       nb_chns, (double)legacy_ns / reps / 1000, (double)new_ns / reps / 1000,
+	       (double)frames_size / DAC_FRAME_SIZE * reps * 1000 / legacy_ns,
+	       (double)frames_size / DAC_FRAME_SIZE * reps * 1000 / new_ns);
+
+	return 0;
+}
+
+/**
+ * @brief	Run all the benchmarks
+ * @return	0 in case of success, 1 otherwise
+ */
+int main(void)
+{
+	uint8_t *work = malloc(2 * BENCH_MAX_BUFFER_SIZE);
+	uint8_t *ref = malloc(2 * BENCH_MAX_BUFFER_SIZE);
+	size_t i;
+	size_t j;
+	uint8_t nb_chns;
+	int ret = 0;
+
+	if (!work || !ref) {
+		free(work);
+		free(ref);
+		return 1;
+	}
+
+	printf("mode          bytes   chns  legacy(us)     new(us)\n");
+
+	for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+		for (j = 0; j < sizeof(bench_chns) / sizeof(bench_chns[0]); j++) {
+			ret |= bench_single_instr(bench_sizes[i], bench_chns[j], work, ref);
+		}
+	}
+
+	for (i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+		ret |= bench_stream(bench_sizes[i], work, ref);
+	}
+
+	printf("\nmode          bytes   chns  legacy(us)     new(us)  legacy(Mframes/s)  new(Mframes/s)\n");
+
+	for (nb_chns = 1; nb_chns <= DAC_FRAME_MAX_CHANNELS; nb_chns++) {
+		ret |= bench_sw_ldac(nb_chns, work, ref);
+	}
+
+	free(work);
+	free(ref);
+
+	return ret ? 1 : 0;
+}
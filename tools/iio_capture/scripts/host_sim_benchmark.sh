@@ -0,0 +1,59 @@
+#!/bin/sh
+# Benchmarks the capture path (trigger handler, IIO buffer, IIOD transport) of a
+# firmware project built for the host (PLATFORM=linux) against its simulated
+# converter, at a series of conversion rates.
+#
+# The project is rebuilt for every rate (SAMPLING_RATE build variable), run in
+# the background and captured over its loopback IIO UART. The simulated data is
+# deterministic, so the captures of a rate can be compared from run to run.
+#
+# Usage: host_sim_benchmark.sh <project dir> <iio device> [scans] [rates]
+#        e.g. host_sim_benchmark.sh projects/ad2s1210_iio ad2s1210 200000 "16000 64000 256000"
+
+set -e
+
+PROJECT=$(realpath "${1:?project dir}")
+DEVICE=${2:?iio device}
+SCANS=${3:-200000}
+RATES=${4:-16000 64000 256000}
+BUFFER_SCANS=${BUFFER_SCANS:-4000}
+TCP_PORT=${TCP_PORT:-30431}
+CAPTURE=$(realpath "${CAPTURE:-$(dirname "$0")/../build/iio_capture}")
+BINARY=${BINARY:-$PROJECT/build/$(basename "$PROJECT").out}
+OUT_DIR=${OUT_DIR:-$(mktemp -d)}
+PID=
+
+stop_firmware() {
+	if [ -n "$PID" ]; then
+		kill "$PID" 2> /dev/null || true
+		wait "$PID" 2> /dev/null || true
+		PID=
+	fi
+}
+
+trap stop_firmware EXIT INT TERM
+
+for RATE in $RATES; do
+	echo "== $RATE SPS =="
+	# The rate is a build time macro, rebuild from scratch
+	make -C "$PROJECT" PLATFORM=linux clean > "$OUT_DIR/build_$RATE.log" 2>&1
+	make -C "$PROJECT" PLATFORM=linux SAMPLING_RATE="$RATE" \
+		IIO_UART_TCP_PORT="$TCP_PORT" >> "$OUT_DIR/build_$RATE.log" 2>&1
+
+	"$BINARY" > "$OUT_DIR/firmware_$RATE.log" 2>&1 &
+	PID=$!
+
+	# Wait for the IIO UART to listen
+	for _ in 1 2 3 4 5 6 7 8 9 10; do
+		grep -q "listening" "$OUT_DIR/firmware_$RATE.log" && break
+		sleep 0.5
+	done
+
+	"$CAPTURE" -u "ip:localhost:$TCP_PORT" -d "$DEVICE" -n "$SCANS" \
+		-s "$BUFFER_SCANS" -o "$OUT_DIR/capture_$RATE.iiocap"
+	echo
+
+	stop_firmware
+done
+
+echo "Captures and logs in $OUT_DIR"
@@ -0,0 +1,164 @@
+# Emulated IIOD serial device for testing the iio_capture tool without hardware.
+# Serves the IIOD ASCII commands (PRINT, TIMEOUT, OPEN, READBUF, CLOSE) over a
+# pseudo terminal, with a 4 channel 24-bit ADC generating sine waves.
+#
+# With --stream, a READBUF request starts the firmware USB streaming mode
+# instead: binary frames are pushed until the host writes a byte, followed by
+# the end frame and the usual READBUF response.
+#
+# With --tcp, the commands are served on a loopback TCP port instead, the same
+# way as the IIO UART of the firmware host builds (PLATFORM=linux).
+#
+# Usage: python3 iio_serial_emulator.py [--chunk <bytes>] [--stream [--frame <bytes>]]
+#                                       [--tcp <port>]
+#        then point the capture tool to the printed pseudo terminal path:
+#        iio_capture -u <pty> -d emu_adc -o capture.iiocap -n 100000 [-S]
+#        (or -u ip:localhost:<port> with --tcp)
+
+import argparse
+import math
+import os
+import pty
+import select
+import socket
+import struct
+import sys
+import tty
+
+NUM_CHANNELS = 4
+DEVICE_ID = "iio:device0"
+DEVICE_NAME = "emu_adc"
+
+# USB streaming mode frame header: magic ("STRM"), sequence, length, flags
+STREAM_MAGIC = 0x4D525453
+STREAM_FLAG_END = 1 << 1
+
+def context_xml():
+    channels = ""
+    for chn in range(NUM_CHANNELS):
+        channels += ('<channel id="voltage{0}" type="input" >'
+                     '<scan-element index="{0}" format="le:s24/32&gt;&gt;0" scale="0.000298" />'
+                     '<attribute name="raw" /></channel>').format(chn)
+
+    return ('<?xml version="1.0" encoding="utf-8"?>'
+            '<!DOCTYPE context [<!ELEMENT context (device)*>'
+            '<!ATTLIST context name CDATA #REQUIRED>]>'
+            '<context name="serial" ><device id="{0}" name="{1}" >{2}'
+            '<attribute name="sampling_frequency" /></device></context>'
+            .format(DEVICE_ID, DEVICE_NAME, channels))
+
+class emulated_adc:
+    def __init__(self):
+        self.mask = 0
+        self.phase = 0
+
+    def scan_channels(self):
+        return [chn for chn in range(NUM_CHANNELS) if self.mask & (1 << chn)]
+
+    def read(self, nbytes):
+        chns = self.scan_channels()
+        scans = nbytes // (4 * len(chns))
+        data = bytearray()
+        for _ in range(scans):
+            for chn in chns:
+                code = int(4000000 * math.sin(2 * math.pi * (chn + 1) * self.phase / 1000))
+                data += struct.pack("<i", code)
+            self.phase += 1
+        return bytes(data)
+
+def stream_frames(fd, stream, adc, frame):
+    seq = 0
+    # Whole scans per frame
+    frame -= frame % (4 * len(adc.scan_channels()))
+    while not select.select([fd], [], [], 0)[0]:
+        stream.write(struct.pack("<IIII", STREAM_MAGIC, seq, frame, 0) + adc.read(frame))
+        seq += 1
+
+    stream.write(struct.pack("<IIII", STREAM_MAGIC, seq, 0, STREAM_FLAG_END))
+    # Discard the stop request
+    stream.read(1)
+
+def serve(fd, chunk, frame):
+    adc = emulated_adc()
+    stream = os.fdopen(fd, "rb+", buffering=0)
+    line = b""
+
+    while True:
+        c = stream.read(1)
+        if not c:
+            return
+        if c != b"\n":
+            line += c
+            continue
+
+        cmd = line.decode().strip().split()
+        line = b""
+        if not cmd:
+            continue
+
+        if cmd[0] == "PRINT":
+            xml = context_xml().encode()
+            stream.write(b"%d\n" % len(xml) + xml + b"\n")
+        elif cmd[0] == "TIMEOUT":
+            stream.write(b"0\n")
+        elif cmd[0] == "OPEN":
+            adc.mask = int(cmd[3], 16)
+            stream.write(b"0\n" if adc.scan_channels() else b"-22\n")
+        elif cmd[0] == "CLOSE":
+            adc.mask = 0
+            stream.write(b"0\n")
+        elif cmd[0] == "READBUF":
+            if frame:
+                stream_frames(fd, stream, adc, frame)
+            data = adc.read(int(cmd[2]))
+            # Data is returned in chunks, the first one preceded by the mask
+            for offset in range(0, len(data), chunk):
+                part = data[offset:offset + chunk]
+                stream.write(b"%d\n" % len(part))
+                if offset == 0:
+                    stream.write(b"%08x\n" % adc.mask)
+                stream.write(part)
+        else:
+            stream.write(b"-22\n")
+
+def main():
+    parser = argparse.ArgumentParser(description="Emulated IIOD serial device")
+    parser.add_argument("--chunk", type=int, default=4096,
+                        help="max bytes returned per READBUF response chunk")
+    parser.add_argument("--stream", action="store_true",
+                        help="emulate the firmware USB streaming mode")
+    parser.add_argument("--frame", type=int, default=32000,
+                        help="payload bytes per streamed frame")
+    parser.add_argument("--tcp", type=int, default=0,
+                        help="serve on this loopback TCP port instead of a pty")
+    args = parser.parse_args()
+    frame = args.frame if args.stream else 0
+
+    if args.tcp:
+        server = socket.create_server(("127.0.0.1", args.tcp))
+        print("127.0.0.1:%d" % args.tcp, flush=True)
+        try:
+            while True:
+                conn, _ = server.accept()
+                conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                try:
+                    serve(os.dup(conn.fileno()), args.chunk, frame)
+                except OSError:
+                    pass
+                conn.close()
+        except KeyboardInterrupt:
+            pass
+        return
+
+    master, slave = pty.openpty()
+    tty.setraw(master)
+    tty.setraw(slave)
+    print(os.ttyname(slave), flush=True)
+
+    try:
+        serve(master, args.chunk, frame)
+    except (KeyboardInterrupt, OSError):
+        pass
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,47 @@
+#!/bin/sh
+# Compares the sustained throughput of the READBUF (IIO buffer) path against
+# the firmware USB streaming mode on the same device.
+#
+# The streaming mode is selected with the system_config data_streaming_mode
+# device attribute (through iio_attr from libiio). Firmware without the
+# attribute is benchmarked on the READBUF path only.
+#
+# Usage: usb_throughput_benchmark.sh <serial device> <iio device> [scans] [buffer scans]
+#        e.g. usb_throughput_benchmark.sh /dev/ttyACM0 ad4062 2000000 4000
+
+set -e
+
+PORT=${1:?serial device}
+DEVICE=${2:?iio device}
+SCANS=${3:-1000000}
+BUFFER_SCANS=${4:-4000}
+BAUD=${BAUD:-230400}
+CAPTURE=${CAPTURE:-$(dirname "$0")/../build/iio_capture}
+OUT_DIR=${OUT_DIR:-$(mktemp -d)}
+URI="serial:${PORT},${BAUD}"
+
+set_streaming_mode() {
+	iio_attr -u "$URI" -d system_config data_streaming_mode "$1" > /dev/null 2>&1
+}
+
+run() {
+	echo "== $1 =="
+	shift
+	"$CAPTURE" -u "$PORT" -b "$BAUD" -d "$DEVICE" -n "$SCANS" -s "$BUFFER_SCANS" "$@"
+	echo
+}
+
+if command -v iio_attr > /dev/null 2>&1; then
+	set_streaming_mode iio_buffer || true
+fi
+
+run "READBUF ($BUFFER_SCANS scans per request)" -o "$OUT_DIR/readbuf.iiocap"
+
+if command -v iio_attr > /dev/null 2>&1 && set_streaming_mode usb_bulk; then
+	run "USB streaming" -S -o "$OUT_DIR/stream.iiocap"
+	set_streaming_mode iio_buffer
+else
+	echo "USB streaming mode not supported by the firmware (or iio_attr missing)"
+fi
+
+echo "Captures in $OUT_DIR"
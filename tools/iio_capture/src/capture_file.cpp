@@ -0,0 +1,291 @@
+/***************************************************************************//**
+ * @file    capture_file.cpp
+ * @brief   Self-describing capture file (scan data with per-channel metadata)
+ * @details IIOCAP file layout:
+ *          - 8 bytes magic "IIOCAP1\n"
+ *          - 4 bytes header size (little endian)
+ *          - JSON metadata header, space padded to the header size
+ *          - Scan data, exactly as received from the IIO buffer
+ *          The header and magic occupy the first CAPTURE_HEADER_SIZE bytes.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <unistd.h>
+
+#include "capture_file.h"
+
+/******************************************************************************/
+/********************* Macros and Constants Definitions ***********************/
+/******************************************************************************/
+
+#define CAPTURE_MAGIC		"IIOCAP1\n"
+#define CAPTURE_MAGIC_LEN	8
+
+/* Size of the magic, header size and metadata header (data is page aligned) */
+#define CAPTURE_HEADER_SIZE	4096
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Escape the string for JSON
+ * @param	str[in] - String
+ * @return	Quoted and escaped string
+ */
+static std::string json_str(const std::string &str)
+{
+	std::string out = "\"";
+
+	for (char c : str) {
+		if (c == '"' || c == '\\') {
+			out.push_back('\\');
+		}
+		out.push_back(c);
+	}
+
+	return out + "\"";
+}
+
+/*!
+ * @brief	Write all the data to the file at the given offset
+ * @param	fd[in] - File descriptor
+ * @param	data[in] - Data to write
+ * @param	len[in] - Number of bytes to write
+ * @param	offset[in] - File offset
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int pwrite_all(int fd, const void *data, size_t len, off_t offset)
+{
+	const uint8_t *ptr = static_cast<const uint8_t *>(data);
+	ssize_t ret;
+
+	while (len) {
+		ret = pwrite(fd, ptr, len, offset);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -errno;
+		}
+
+		ptr += ret;
+		offset += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+capture_file::~capture_file()
+{
+	if (fd_ >= 0) {
+		::close(fd_);
+	}
+}
+
+/*!
+ * @brief	Format the JSON metadata header
+ * @param	dropped_buffers[in] - Number of buffers dropped during the capture
+ * @return	Metadata header
+ */
+std::string capture_file::header(uint64_t dropped_buffers) const
+{
+	std::ostringstream json;
+	bool first = true;
+	char total[24];
+
+	/* Fixed width, so that the header size doesn't change when updated */
+	snprintf(total, sizeof(total), "%20llu",
+		 static_cast<unsigned long long>(data_bytes_ / scan_bytes_));
+
+	json << "{\n"
+	     << "\t\"device\": " << json_str(device_->name) << ",\n"
+	     << "\t\"device_id\": " << json_str(device_->id) << ",\n"
+	     << "\t\"scan_bytes\": " << scan_bytes_ << ",\n"
+	     << "\t\"buffer_scans\": " << buffer_scans_ << ",\n"
+	     << "\t\"total_scans\": " << total << ",\n"
+	     << "\t\"dropped_buffers\": " << dropped_buffers << ",\n"
+	     << "\t\"channels\": [";
+
+	for (const auto &chn : device_->channels) {
+		if (!chn.enabled) {
+			continue;
+		}
+
+		json << (first ? "\n" : ",\n")
+		     << "\t\t{ \"id\": " << json_str(chn.id)
+		     << ", \"name\": " << json_str(chn.name)
+		     << ", \"index\": " << chn.index
+		     << ", \"scan_offset\": " << chn.scan_offset
+		     << ", \"endianness\": \"" << (chn.scan_type.is_big_endian ? "be" : "le")
+		     << "\", \"signed\": " << (chn.scan_type.is_signed ? "true" : "false")
+		     << ", \"realbits\": " << unsigned(chn.scan_type.realbits)
+		     << ", \"storagebits\": " << unsigned(chn.scan_type.storagebits)
+		     << ", \"shift\": " << unsigned(chn.scan_type.shift)
+		     << ", \"repeat\": " << unsigned(chn.scan_type.repeat);
+
+		if (!chn.scale.empty()) {
+			json << ", \"scale\": " << json_str(chn.scale);
+		}
+		if (!chn.offset.empty()) {
+			json << ", \"offset\": " << json_str(chn.offset);
+		}
+
+		json << " }";
+		first = false;
+	}
+
+	json << "\n\t]\n}\n";
+
+	return json.str();
+}
+
+/*!
+ * @brief	Write (or update) the metadata header
+ * @param	dropped_buffers[in] - Number of buffers dropped during the capture
+ * @return	0 in case of success, negative error code otherwise
+ */
+int capture_file::write_header(uint64_t dropped_buffers)
+{
+	std::string meta = header(dropped_buffers);
+	uint8_t head[CAPTURE_HEADER_SIZE];
+	uint32_t meta_size = CAPTURE_HEADER_SIZE - CAPTURE_MAGIC_LEN - 4;
+	int fd;
+	int ret;
+
+	if (format_ == CAPTURE_FORMAT_RAW) {
+		fd = ::open((path_ + ".json").c_str(),
+			    O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (fd < 0) {
+			return -errno;
+		}
+
+		ret = pwrite_all(fd, meta.data(), meta.size(), 0);
+		::close(fd);
+
+		return ret;
+	}
+
+	if (meta.size() > meta_size) {
+		return -E2BIG;
+	}
+
+	memset(head, ' ', sizeof(head));
+	memcpy(head, CAPTURE_MAGIC, CAPTURE_MAGIC_LEN);
+	for (int i = 0; i < 4; i++) {
+		head[CAPTURE_MAGIC_LEN + i] = (meta_size >> (8 * i)) & 0xFF;
+	}
+	memcpy(&head[CAPTURE_MAGIC_LEN + 4], meta.data(), meta.size());
+
+	return pwrite_all(fd_, head, sizeof(head), 0);
+}
+
+/*!
+ * @brief	Create the capture file
+ * @param	path[in] - Capture file path
+ * @param	format[in] - Capture file format
+ * @param	device[in] - Captured device (enabled channels laid out)
+ * @param	scan_bytes[in] - Size of a scan (bytes)
+ * @param	buffer_scans[in] - Number of scans per IIO buffer
+ * @return	0 in case of success, negative error code otherwise
+ */
+int capture_file::open(const std::string &path, capture_format format,
+		       const iio_device_info &device, uint32_t scan_bytes,
+		       uint32_t buffer_scans)
+{
+	int ret;
+
+	if (fd_ >= 0 || !scan_bytes) {
+		return -EINVAL;
+	}
+
+	fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd_ < 0) {
+		return -errno;
+	}
+
+	path_ = path;
+	format_ = format;
+	device_ = &device;
+	scan_bytes_ = scan_bytes;
+	buffer_scans_ = buffer_scans;
+	data_bytes_ = 0;
+
+	ret = write_header(0);
+	if (ret) {
+		return ret;
+	}
+
+	if (lseek(fd_, (format == CAPTURE_FORMAT_RAW) ? 0 : CAPTURE_HEADER_SIZE,
+		  SEEK_SET) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Append the scan data to the capture file
+ * @param	data[in] - Scan data
+ * @param	len[in] - Number of bytes
+ * @return	0 in case of success, negative error code otherwise
+ */
+int capture_file::write(const void *data, size_t len)
+{
+	const uint8_t *ptr = static_cast<const uint8_t *>(data);
+	ssize_t ret;
+
+	data_bytes_ += len;
+
+	while (len) {
+		ret = ::write(fd_, ptr, len);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -errno;
+		}
+
+		ptr += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Finalize the metadata header and close the capture file
+ * @param	dropped_buffers[in] - Number of buffers dropped during the capture
+ * @return	0 in case of success, negative error code otherwise
+ */
+int capture_file::close(uint64_t dropped_buffers)
+{
+	int ret;
+
+	if (fd_ < 0) {
+		return -EINVAL;
+	}
+
+	ret = write_header(dropped_buffers);
+
+	if (::close(fd_) && !ret) {
+		ret = -errno;
+	}
+	fd_ = -1;
+
+	return ret;
+}
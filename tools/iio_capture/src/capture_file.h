@@ -0,0 +1,79 @@
+/***************************************************************************//**
+ * @file    capture_file.h
+ * @brief   Self-describing capture file (scan data with per-channel metadata)
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _CAPTURE_FILE_H_
+#define _CAPTURE_FILE_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "iio_context.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @enum capture_format
+ * @brief Capture file formats
+ */
+enum capture_format {
+	/* Metadata header followed by the scan data in a single file */
+	CAPTURE_FORMAT_IIOCAP,
+	/* Raw scan data, metadata in a '<file>.json' sidecar */
+	CAPTURE_FORMAT_RAW
+};
+
+/**
+ * @class capture_file
+ * @brief Capture file writer
+ * @note  The metadata header has a fixed size, so that the scan count can be
+ *        updated in place once the capture ends. The data starts page aligned.
+ */
+class capture_file
+{
+public:
+	capture_file() = default;
+	~capture_file();
+
+	capture_file(const capture_file &) = delete;
+	capture_file &operator=(const capture_file &) = delete;
+
+	int open(const std::string &path, capture_format format,
+		 const iio_device_info &device, uint32_t scan_bytes,
+		 uint32_t buffer_scans);
+	int write(const void *data, size_t len);
+	int close(uint64_t dropped_buffers);
+
+	bool is_open() const
+	{
+		return fd_ >= 0;
+	}
+
+private:
+	std::string header(uint64_t dropped_buffers) const;
+	int write_header(uint64_t dropped_buffers);
+
+	int fd_ = -1;
+	std::string path_;
+	capture_format format_ = CAPTURE_FORMAT_IIOCAP;
+	const iio_device_info *device_ = nullptr;
+	uint32_t scan_bytes_ = 0;
+	uint32_t buffer_scans_ = 0;
+	uint64_t data_bytes_ = 0;
+};
+
+#endif // _CAPTURE_FILE_H_
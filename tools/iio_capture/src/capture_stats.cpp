@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ * @file    capture_stats.cpp
+ * @brief   Capture throughput, drop and latency statistics
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "capture_stats.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Start the statistics of a new capture
+ * @return	None
+ */
+void capture_stats::start()
+{
+	bytes_ = 0;
+	buffers_ = 0;
+	dropped_ = 0;
+	overruns_ = 0;
+	latency_us_.clear();
+	start_ = clock::now();
+	stop_ = start_;
+}
+
+/*!
+ * @brief	Account a buffer read from the device
+ * @param	bytes[in] - Size of the buffer
+ * @param	latency[in] - Latency of the buffer read
+ * @return	None
+ */
+void capture_stats::add_buffer(uint32_t bytes, clock::duration latency)
+{
+	bytes_ += bytes;
+	buffers_++;
+	latency_us_.push_back(
+		std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+}
+
+/*!
+ * @brief	Account the buffers dropped (no free ring slot to receive them
+ *			into, or skipped by the firmware in the USB streaming mode)
+ * @param	count[in] - Number of buffers dropped
+ * @return	None
+ */
+void capture_stats::add_dropped(uint64_t count)
+{
+	dropped_ += count;
+}
+
+/*!
+ * @brief	Account a buffer overwritten by the firmware while being sent
+ * @return	None
+ */
+void capture_stats::add_overrun()
+{
+	overruns_++;
+}
+
+/*!
+ * @brief	Stop the statistics of the capture
+ * @return	None
+ */
+void capture_stats::stop()
+{
+	stop_ = clock::now();
+}
+
+/*!
+ * @brief	Get the percentile of the sorted values (nearest rank)
+ * @param	sorted[in] - Sorted values
+ * @param	pct[in] - Percentile (0 to 100)
+ * @return	Percentile value
+ */
+double capture_stats::percentile(std::vector<uint32_t> &sorted,
+				 double pct) const
+{
+	size_t rank;
+
+	if (sorted.empty()) {
+		return 0;
+	}
+
+	rank = static_cast<size_t>(std::ceil(pct / 100 * sorted.size()));
+
+	return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+/*!
+ * @brief	Print the capture statistics
+ * @param	out[in] - Output stream
+ * @return	None
+ */
+void capture_stats::report(FILE *out) const
+{
+	std::vector<uint32_t> sorted(latency_us_);
+	double secs = std::chrono::duration<double>(stop_ - start_).count();
+
+	std::sort(sorted.begin(), sorted.end());
+
+	fprintf(out, "Captured:      %llu bytes in %llu buffers (%.3f s)\n",
+		static_cast<unsigned long long>(bytes_),
+		static_cast<unsigned long long>(buffers_), secs);
+	fprintf(out, "Throughput:    %.3f MB/s sustained\n",
+		(secs > 0) ? bytes_ / secs / 1e6 : 0.0);
+	fprintf(out, "Dropped:       %llu buffers\n",
+		static_cast<unsigned long long>(dropped_));
+	fprintf(out, "Overruns:      %llu buffers\n",
+		static_cast<unsigned long long>(overruns_));
+	fprintf(out, "Latency (us):  p50 %.0f, p90 %.0f, p99 %.0f, max %.0f\n",
+		percentile(sorted, 50), percentile(sorted, 90), percentile(sorted, 99),
+		percentile(sorted, 100));
+}
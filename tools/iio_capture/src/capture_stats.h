@@ -0,0 +1,65 @@
+/***************************************************************************//**
+ * @file    capture_stats.h
+ * @brief   Capture throughput, drop and latency statistics
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _CAPTURE_STATS_H_
+#define _CAPTURE_STATS_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @class capture_stats
+ * @brief Statistics of the buffers read from the device
+ * @note  The latency of a buffer is the time from the READBUF request to the
+ *        last byte of the buffer received (from the previous frame in the
+ *        USB streaming mode).
+ */
+class capture_stats
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	void start();
+	void add_buffer(uint32_t bytes, clock::duration latency);
+	void add_dropped(uint64_t count = 1);
+	void add_overrun();
+	void stop();
+	void report(FILE *out) const;
+
+	uint64_t dropped() const
+	{
+		return dropped_;
+	}
+
+private:
+	double percentile(std::vector<uint32_t> &sorted, double pct) const;
+
+	clock::time_point start_;
+	clock::time_point stop_;
+	uint64_t bytes_ = 0;
+	uint64_t buffers_ = 0;
+	uint64_t dropped_ = 0;
+	uint64_t overruns_ = 0;
+	/* Buffer latencies (usec) */
+	std::vector<uint32_t> latency_us_;
+};
+
+#endif // _CAPTURE_STATS_H_
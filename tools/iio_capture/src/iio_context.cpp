@@ -0,0 +1,335 @@
+/***************************************************************************//**
+ * @file    iio_context.cpp
+ * @brief   IIO context XML parsing (devices, scan channels and scan types)
+ * @details Only the subset of the context XML needed for the buffer capture is
+ *          parsed: the devices, their channels and the scan elements. The XML
+ *          served by the IIOD firmware is flat and well formed, so a simple tag
+ *          tokenizer is used instead of a full XML parser.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+#include "iio_context.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct xml_tag
+ * @brief XML tag with its attributes
+ */
+struct xml_tag {
+	std::string name;
+	std::map<std::string, std::string> attrs;
+	bool is_closing = false;
+	bool is_empty = false;
+};
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Replace the predefined XML entities
+ * @param	value[in] - Attribute value
+ * @return	Unescaped attribute value
+ */
+static std::string xml_unescape(const std::string &value)
+{
+	static const std::pair<const char *, char> entities[] = {
+		{ "&lt;", '<' }, { "&gt;", '>' }, { "&amp;", '&' },
+		{ "&quot;", '"' }, { "&apos;", '\'' }
+	};
+	std::string out;
+	size_t pos = 0;
+	bool found;
+
+	while (pos < value.size()) {
+		found = false;
+
+		if (value[pos] == '&') {
+			for (const auto &entity : entities) {
+				if (!value.compare(pos, strlen(entity.first), entity.first)) {
+					out.push_back(entity.second);
+					pos += strlen(entity.first);
+					found = true;
+					break;
+				}
+			}
+		}
+
+		if (!found) {
+			out.push_back(value[pos++]);
+		}
+	}
+
+	return out;
+}
+
+/*!
+ * @brief	Parse the next tag of the XML document
+ * @param	xml[in] - XML document
+ * @param	pos[in,out] - Parse position
+ * @param	tag[out] - Parsed tag
+ * @return	true if a tag was parsed, false at the end of document
+ */
+static bool xml_next_tag(const std::string &xml, size_t &pos, xml_tag &tag)
+{
+	size_t start, end, name_end, eq, quote_end;
+	std::string body;
+	size_t i;
+
+	for (;;) {
+		start = xml.find('<', pos);
+		if (start == std::string::npos) {
+			return false;
+		}
+
+		end = xml.find('>', start);
+		if (end == std::string::npos) {
+			return false;
+		}
+
+		pos = end + 1;
+
+		/* Skip the declaration, DOCTYPE and comments */
+		if (xml[start + 1] != '?' && xml[start + 1] != '!') {
+			break;
+		}
+
+		/* The DOCTYPE may embed the DTD, which ends with "]>" */
+		if (!xml.compare(start, 9, "<!DOCTYPE")) {
+			size_t dtd = xml.find('[', start);
+			if (dtd != std::string::npos && dtd < end) {
+				end = xml.find("]>", dtd);
+				if (end == std::string::npos) {
+					return false;
+				}
+				pos = end + 2;
+			}
+		}
+	}
+
+	body = xml.substr(start + 1, end - start - 1);
+	tag = xml_tag();
+
+	if (!body.empty() && body[0] == '/') {
+		tag.is_closing = true;
+		body.erase(0, 1);
+	}
+
+	if (!body.empty() && body.back() == '/') {
+		tag.is_empty = true;
+		body.pop_back();
+	}
+
+	name_end = body.find_first_of(" \t\r\n");
+	tag.name = body.substr(0, name_end);
+	if (name_end == std::string::npos) {
+		return true;
+	}
+
+	/* Attributes are name="value" pairs */
+	i = name_end;
+	while ((eq = body.find('=', i)) != std::string::npos) {
+		std::string name = body.substr(i, eq - i);
+		char quote;
+
+		name.erase(std::remove_if(name.begin(), name.end(), ::isspace), name.end());
+
+		if (eq + 1 >= body.size()) {
+			break;
+		}
+
+		quote = body[eq + 1];
+		quote_end = body.find(quote, eq + 2);
+		if (quote_end == std::string::npos) {
+			break;
+		}
+
+		tag.attrs[name] = xml_unescape(body.substr(eq + 2, quote_end - eq - 2));
+		i = quote_end + 1;
+	}
+
+	return true;
+}
+
+/*!
+ * @brief	Parse the scan element format (e.g. "le:s24/32>>0")
+ * @param	format[in] - Scan element format string
+ * @param	scan_type[out] - Parsed scan type
+ * @return	0 in case of success, negative error code otherwise
+ */
+int iio_parse_scan_format(const std::string &format, iio_scan_type &scan_type)
+{
+	char endian[3] = { 0 };
+	char sign;
+	unsigned int realbits, storagebits, repeat = 1, shift = 0;
+	int ret;
+
+	if (format.find('X') != std::string::npos) {
+		ret = sscanf(format.c_str(), "%2c:%c%u/%uX%u>>%u", endian, &sign,
+			     &realbits, &storagebits, &repeat, &shift);
+		if (ret != 6) {
+			return -EINVAL;
+		}
+	} else {
+		ret = sscanf(format.c_str(), "%2c:%c%u/%u>>%u", endian, &sign,
+			     &realbits, &storagebits, &shift);
+		if (ret != 5) {
+			return -EINVAL;
+		}
+	}
+
+	if ((storagebits % 8) || !storagebits || storagebits > 64
+	    || realbits > storagebits || !repeat) {
+		return -EINVAL;
+	}
+
+	scan_type.is_big_endian = (endian[0] == 'b');
+	scan_type.is_signed = (sign == 's' || sign == 'S');
+	scan_type.is_fully_defined = (sign == 'S' || sign == 'U');
+	scan_type.realbits = realbits;
+	scan_type.storagebits = storagebits;
+	scan_type.shift = shift;
+	scan_type.repeat = repeat;
+
+	return 0;
+}
+
+/*!
+ * @brief	Parse the IIO context XML
+ * @param	xml[in] - Context XML (as returned by the IIOD PRINT command)
+ * @param	devices[out] - Devices of the context
+ * @return	0 in case of success, negative error code otherwise
+ */
+int iio_parse_context(const std::string &xml,
+		      std::vector<iio_device_info> &devices)
+{
+	iio_device_info *device = nullptr;
+	iio_scan_channel channel;
+	bool in_channel = false;
+	bool has_scan = false;
+	size_t pos = 0;
+	xml_tag tag;
+	int ret;
+
+	devices.clear();
+
+	while (xml_next_tag(xml, pos, tag)) {
+		if (tag.name == "device" && !tag.is_closing) {
+			devices.emplace_back();
+			device = &devices.back();
+			device->id = tag.attrs["id"];
+			device->name = tag.attrs["name"];
+		} else if (tag.name == "device") {
+			device = nullptr;
+		} else if (tag.name == "channel" && !tag.is_closing && device) {
+			device->nb_channels++;
+			channel = iio_scan_channel();
+			channel.id = tag.attrs["id"];
+			channel.name = tag.attrs["name"];
+			has_scan = false;
+			in_channel = !tag.is_empty;
+		} else if (tag.name == "channel" && in_channel) {
+			if (has_scan) {
+				device->channels.push_back(channel);
+			}
+			in_channel = false;
+		} else if (tag.name == "scan-element" && in_channel) {
+			ret = iio_parse_scan_format(tag.attrs["format"], channel.scan_type);
+			if (ret) {
+				return ret;
+			}
+
+			channel.index = std::stoul(tag.attrs["index"]);
+			channel.scale = tag.attrs["scale"];
+			channel.offset = tag.attrs["offset"];
+			has_scan = true;
+		}
+	}
+
+	if (devices.empty()) {
+		return -ENODEV;
+	}
+
+	/* Scans are laid out in the channel index order */
+	for (auto &dev : devices) {
+		std::sort(dev.channels.begin(), dev.channels.end(),
+		[](const iio_scan_channel & a, const iio_scan_channel & b) {
+			return a.index < b.index;
+		});
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Lay out the enabled channels in the scan
+ * @param	device[in,out] - IIO device
+ * @return	Size of the scan (in bytes)
+ * @note	Every sample is naturally aligned within the scan, and the scan is
+ *			padded to the largest sample, the same way the IIO buffer is.
+ */
+uint32_t iio_layout_scan(iio_device_info &device)
+{
+	uint32_t offset = 0;
+	uint32_t largest = 1;
+	uint32_t bytes;
+
+	for (auto &chn : device.channels) {
+		if (!chn.enabled) {
+			continue;
+		}
+
+		bytes = chn.scan_type.storagebits / 8;
+		offset = (offset + bytes - 1) / bytes * bytes;
+		chn.scan_offset = offset;
+		offset += bytes * chn.scan_type.repeat;
+		largest = std::max(largest, bytes);
+	}
+
+	return (offset + largest - 1) / largest * largest;
+}
+
+/*!
+ * @brief	Format the channel mask of the enabled channels (IIOD OPEN command)
+ * @param	device[in] - IIO device
+ * @return	Channel mask (32-bit hex words, most significant word first)
+ */
+std::string iio_channel_mask(const iio_device_info &device)
+{
+	uint32_t nb_words = (std::max<uint32_t>(device.nb_channels, 1) + 31) / 32;
+	std::vector<uint32_t> words(nb_words, 0);
+	std::string mask;
+	char word[9];
+
+	for (const auto &chn : device.channels) {
+		if (chn.enabled && chn.index / 32 < nb_words) {
+			words[chn.index / 32] |= 1u << (chn.index % 32);
+		}
+	}
+
+	for (auto it = words.rbegin(); it != words.rend(); ++it) {
+		snprintf(word, sizeof(word), "%08x", *it);
+		mask += word;
+	}
+
+	return mask;
+}
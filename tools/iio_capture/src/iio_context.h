@@ -0,0 +1,81 @@
+/***************************************************************************//**
+ * @file    iio_context.h
+ * @brief   IIO context XML parsing (devices, scan channels and scan types)
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _IIO_CONTEXT_H_
+#define _IIO_CONTEXT_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct iio_scan_type
+ * @brief Storage format of a channel in the scan (IIO 'scan_type')
+ */
+struct iio_scan_type {
+	bool is_big_endian = false;
+	bool is_signed = false;
+	/* Hardware offset is to be added to the data (upper case sign char) */
+	bool is_fully_defined = false;
+	uint8_t realbits = 0;
+	uint8_t storagebits = 0;
+	uint8_t shift = 0;
+	uint8_t repeat = 1;
+};
+
+/**
+ * @struct iio_scan_channel
+ * @brief Channel which can be captured through the IIO buffer
+ */
+struct iio_scan_channel {
+	std::string id;
+	std::string name;
+	/* Index of the channel (bit) in the channel mask */
+	uint32_t index = 0;
+	iio_scan_type scan_type;
+	/* Scale and offset advertised in the scan element (if any) */
+	std::string scale;
+	std::string offset;
+	/* Byte offset of the channel within the scan */
+	uint32_t scan_offset = 0;
+	bool enabled = false;
+};
+
+/**
+ * @struct iio_device_info
+ * @brief IIO device and its scan channels
+ */
+struct iio_device_info {
+	std::string id;
+	std::string name;
+	std::vector<iio_scan_channel> channels;
+	/* Total number of channels (sizes the channel mask) */
+	uint32_t nb_channels = 0;
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+int iio_parse_context(const std::string &xml,
+		      std::vector<iio_device_info> &devices);
+int iio_parse_scan_format(const std::string &format, iio_scan_type &scan_type);
+uint32_t iio_layout_scan(iio_device_info &device);
+std::string iio_channel_mask(const iio_device_info &device);
+
+#endif // _IIO_CONTEXT_H_
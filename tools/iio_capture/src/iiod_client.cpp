@@ -0,0 +1,224 @@
+/***************************************************************************//**
+ * @file    iiod_client.cpp
+ * @brief   IIOD (ASCII protocol) client for the serial/USB VCOM backends
+ * @details Implements the commands of the IIOD ASCII protocol served by the
+ *          firmware (same as the libiio serial backend): PRINT, TIMEOUT, OPEN,
+ *          READBUF and CLOSE. The READBUF payload is received straight into
+ *          the caller memory.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cerrno>
+#include <cstdlib>
+
+#include "iiod_client.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Read the integer response of a command
+ * @param	value[out] - Integer response
+ * @return	0 in case of success, negative error code otherwise
+ */
+int iiod_client::read_integer(long &value)
+{
+	std::string line;
+	char *end;
+	int ret;
+
+	/* Skip the empty lines (trailing line terminator of the XML) */
+	do {
+		ret = port_.read_line(line);
+		if (ret) {
+			return ret;
+		}
+	} while (line.empty());
+
+	value = strtol(line.c_str(), &end, 10);
+	if (end == line.c_str()) {
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Send the command and read its integer response
+ * @param	cmd[in] - Command (without the line terminator)
+ * @return	Command response (>= 0) in case of success, negative error
+ *			code otherwise
+ */
+int iiod_client::command(const std::string &cmd)
+{
+	std::string line = cmd + "\r\n";
+	long value;
+	int ret;
+
+	ret = port_.write_all(line.data(), line.size());
+	if (ret) {
+		return ret;
+	}
+
+	ret = read_integer(value);
+	if (ret) {
+		return ret;
+	}
+
+	return static_cast<int>(value);
+}
+
+/*!
+ * @brief	Read the IIO context XML
+ * @param	xml[out] - Context XML
+ * @return	0 in case of success, negative error code otherwise
+ */
+int iiod_client::get_xml(std::string &xml)
+{
+	int ret;
+
+	ret = command("PRINT");
+	if (ret < 0) {
+		return ret;
+	}
+
+	xml.resize(ret);
+
+	return port_.read_exact(&xml[0], xml.size());
+}
+
+/*!
+ * @brief	Set the IIOD client timeout on the firmware side
+ * @param	timeout_ms[in] - Timeout (msec)
+ * @return	0 in case of success, negative error code otherwise
+ */
+int iiod_client::set_timeout(uint32_t timeout_ms)
+{
+	int ret = command("TIMEOUT " + std::to_string(timeout_ms));
+
+	return (ret < 0) ? ret : 0;
+}
+
+/*!
+ * @brief	Open (enable) the device buffer
+ * @param	device[in] - Device ID (e.g. iio:device0)
+ * @param	samples[in] - Number of samples (scans) per buffer
+ * @param	mask[in] - Channel mask (hex words)
+ * @return	0 in case of success, negative error code otherwise
+ */
+int iiod_client::open_buffer(const std::string &device, uint32_t samples,
+			     const std::string &mask)
+{
+	int ret = command("OPEN " + device + " " + std::to_string(samples) + " " +
+			  mask);
+
+	return (ret < 0) ? ret : 0;
+}
+
+/*!
+ * @brief	Request the device buffer (without reading the response)
+ * @param	device[in] - Device ID (e.g. iio:device0)
+ * @param	bytes[in] - Number of bytes to read
+ * @return	0 in case of success, negative error code otherwise
+ */
+int iiod_client::request_buffer(const std::string &device, uint32_t bytes)
+{
+	std::string cmd = "READBUF " + device + " " + std::to_string(bytes) + "\r\n";
+
+	return port_.write_all(cmd.data(), cmd.size());
+}
+
+/*!
+ * @brief	Read the response of a device buffer request
+ * @param	data[out] - Memory to receive the buffer data into
+ * @param	bytes[in] - Number of bytes requested
+ * @return	0 in case of success, negative error code otherwise
+ * @note	The firmware may return the data in several chunks. The first
+ *			chunk is preceded by the channel mask.
+ */
+int iiod_client::read_buffer_response(void *data, uint32_t bytes)
+{
+	uint8_t *ptr = static_cast<uint8_t *>(data);
+	std::string mask;
+	bool mask_read = false;
+	long chunk;
+	int ret;
+
+	while (bytes) {
+		ret = read_integer(chunk);
+		if (ret) {
+			return ret;
+		}
+
+		if (chunk < 0) {
+			return static_cast<int>(chunk);
+		}
+
+		if (!chunk) {
+			return -EIO;
+		}
+
+		if (static_cast<unsigned long>(chunk) > bytes) {
+			return -EBADMSG;
+		}
+
+		if (!mask_read) {
+			ret = port_.read_line(mask);
+			if (ret) {
+				return ret;
+			}
+			mask_read = true;
+		}
+
+		ret = port_.read_exact(ptr, chunk);
+		if (ret) {
+			return ret;
+		}
+
+		ptr += chunk;
+		bytes -= chunk;
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Read the device buffer
+ * @param	device[in] - Device ID (e.g. iio:device0)
+ * @param	data[out] - Memory to receive the buffer data into
+ * @param	bytes[in] - Number of bytes to read
+ * @return	0 in case of success, negative error code otherwise
+ */
+int iiod_client::read_buffer(const std::string &device, void *data,
+			     uint32_t bytes)
+{
+	int ret = request_buffer(device, bytes);
+
+	if (ret) {
+		return ret;
+	}
+
+	return read_buffer_response(data, bytes);
+}
+
+/*!
+ * @brief	Close (disable) the device buffer
+ * @param	device[in] - Device ID (e.g. iio:device0)
+ * @return	0 in case of success, negative error code otherwise
+ */
+int iiod_client::close_buffer(const std::string &device)
+{
+	int ret = command("CLOSE " + device);
+
+	return (ret < 0) ? ret : 0;
+}
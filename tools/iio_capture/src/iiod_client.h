@@ -0,0 +1,53 @@
+/***************************************************************************//**
+ * @file    iiod_client.h
+ * @brief   IIOD (ASCII protocol) client for the serial/USB VCOM backends
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _IIOD_CLIENT_H_
+#define _IIOD_CLIENT_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cstdint>
+#include <string>
+
+#include "serial_port.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @class iiod_client
+ * @brief Client side of the IIOD commands used for the buffer capture
+ */
+class iiod_client
+{
+public:
+	explicit iiod_client(serial_port &port) : port_(port) {}
+
+	int get_xml(std::string &xml);
+	int set_timeout(uint32_t timeout_ms);
+	int open_buffer(const std::string &device, uint32_t samples,
+			const std::string &mask);
+	int read_buffer(const std::string &device, void *data, uint32_t bytes);
+	int request_buffer(const std::string &device, uint32_t bytes);
+	int read_buffer_response(void *data, uint32_t bytes);
+	int close_buffer(const std::string &device);
+
+private:
+	int command(const std::string &cmd);
+	int read_integer(long &value);
+
+	serial_port &port_;
+};
+
+#endif // _IIOD_CLIENT_H_
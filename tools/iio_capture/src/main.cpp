@@ -0,0 +1,557 @@
+/***************************************************************************//**
+ * @file    main.cpp
+ * @brief   Native IIO buffer capture tool for the serial/USB VCOM backends
+ * @details The device buffers are received straight into the slots of a memory
+ *          mapped ring by the capture (main) thread, and written out to the
+ *          capture file from the same memory by the writer thread. A buffer is
+ *          dropped (and counted) when the writer falls a full ring behind.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <getopt.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "capture_file.h"
+#include "capture_stats.h"
+#include "iio_context.h"
+#include "iiod_client.h"
+#include "mmap_ring.h"
+#include "serial_port.h"
+#include "usb_stream.h"
+
+/******************************************************************************/
+/********************* Macros and Constants Definitions ***********************/
+/******************************************************************************/
+
+#define DEFAULT_BAUD_RATE		230400
+#define DEFAULT_BUFFER_SCANS	400
+#define DEFAULT_RING_SLOTS		64
+#define DEFAULT_TIMEOUT_MS		5000
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct capture_options
+ * @brief Command line options
+ */
+struct capture_options {
+	std::string uri;
+	uint32_t baud_rate = DEFAULT_BAUD_RATE;
+	std::string device;
+	std::string channels;
+	uint32_t buffer_scans = DEFAULT_BUFFER_SCANS;
+	/* Total number of scans to capture (0 = until interrupted) */
+	uint64_t total_scans = 0;
+	std::string output;
+	capture_format format = CAPTURE_FORMAT_IIOCAP;
+	uint32_t ring_slots = DEFAULT_RING_SLOTS;
+	std::string ring_file;
+	uint32_t timeout_ms = DEFAULT_TIMEOUT_MS;
+	/* Firmware USB streaming mode (frames pushed after a single READBUF) */
+	bool stream = false;
+};
+
+/* Capture stop request (Ctrl+C) */
+static std::atomic<bool> stop_requested{false};
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Print the tool usage
+ * @param	prog[in] - Program name
+ * @return	None
+ */
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"Usage: %s -u <serial device> -d <device> -o <file> [options]\n"
+		"  -u, --uri <path>          Serial/VCOM device (e.g. /dev/ttyACM0), or\n"
+		"                            ip:host[:port] for a firmware host build\n"
+		"  -b, --baud <rate>         Baud rate (default %u, ignored by VCOM)\n"
+		"  -d, --device <name|id>    IIO device name or ID (e.g. ad4170)\n"
+		"  -c, --channels <list>     Comma separated channel IDs (default all)\n"
+		"  -s, --buffer-size <n>     Scans per IIO buffer (default %u)\n"
+		"  -n, --scans <n>           Total scans to capture (default until Ctrl+C)\n"
+		"  -o, --output <file>       Capture file\n"
+		"  -f, --format <fmt>        iiocap (default) or raw (+ .json sidecar)\n"
+		"  -r, --ring-slots <n>      Number of ring buffer slots (default %u)\n"
+		"  -m, --ring-file <file>    File backing the ring mapping (e.g. /dev/shm/..)\n"
+		"  -t, --timeout <msec>      Buffer read timeout (default %u)\n"
+		"  -S, --stream              Receive the frames pushed by the firmware\n"
+		"                            (device data_streaming_mode = usb_bulk)\n",
+		prog, DEFAULT_BAUD_RATE, DEFAULT_BUFFER_SCANS, DEFAULT_RING_SLOTS,
+		DEFAULT_TIMEOUT_MS);
+}
+
+/*!
+ * @brief	Parse the command line options
+ * @param	argc[in] - Number of arguments
+ * @param	argv[in] - Arguments
+ * @param	opts[out] - Parsed options
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int parse_options(int argc, char **argv, capture_options &opts)
+{
+	static const struct option long_opts[] = {
+		{ "uri", required_argument, nullptr, 'u' },
+		{ "baud", required_argument, nullptr, 'b' },
+		{ "device", required_argument, nullptr, 'd' },
+		{ "channels", required_argument, nullptr, 'c' },
+		{ "buffer-size", required_argument, nullptr, 's' },
+		{ "scans", required_argument, nullptr, 'n' },
+		{ "output", required_argument, nullptr, 'o' },
+		{ "format", required_argument, nullptr, 'f' },
+		{ "ring-slots", required_argument, nullptr, 'r' },
+		{ "ring-file", required_argument, nullptr, 'm' },
+		{ "timeout", required_argument, nullptr, 't' },
+		{ "stream", no_argument, nullptr, 'S' },
+		{ "help", no_argument, nullptr, 'h' },
+		{ nullptr, 0, nullptr, 0 }
+	};
+	int opt;
+
+	while ((opt = getopt_long(argc, argv, "u:b:d:c:s:n:o:f:r:m:t:Sh", long_opts,
+				  nullptr)) != -1) {
+		switch (opt) {
+		case 'u':
+			opts.uri = optarg;
+			break;
+		case 'b':
+			opts.baud_rate = strtoul(optarg, nullptr, 0);
+			break;
+		case 'd':
+			opts.device = optarg;
+			break;
+		case 'c':
+			opts.channels = optarg;
+			break;
+		case 's':
+			opts.buffer_scans = strtoul(optarg, nullptr, 0);
+			break;
+		case 'n':
+			opts.total_scans = strtoull(optarg, nullptr, 0);
+			break;
+		case 'o':
+			opts.output = optarg;
+			break;
+		case 'f':
+			if (!strcmp(optarg, "iiocap")) {
+				opts.format = CAPTURE_FORMAT_IIOCAP;
+			} else if (!strcmp(optarg, "raw")) {
+				opts.format = CAPTURE_FORMAT_RAW;
+			} else {
+				return -EINVAL;
+			}
+			break;
+		case 'r':
+			opts.ring_slots = strtoul(optarg, nullptr, 0);
+			break;
+		case 'm':
+			opts.ring_file = optarg;
+			break;
+		case 't':
+			opts.timeout_ms = strtoul(optarg, nullptr, 0);
+			break;
+		case 'S':
+			opts.stream = true;
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	if (opts.uri.empty() || opts.device.empty() || opts.output.empty()
+	    || !opts.buffer_scans || !opts.ring_slots) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Find the device and enable the requested channels
+ * @param	devices[in] - Devices of the context
+ * @param	opts[in] - Command line options
+ * @return	Captured device, nullptr if not found
+ */
+static iio_device_info *select_device(std::vector<iio_device_info> &devices,
+				      const capture_options &opts)
+{
+	std::istringstream list(opts.channels);
+	std::string id;
+	bool found;
+
+	for (auto &dev : devices) {
+		if (dev.name != opts.device && dev.id != opts.device) {
+			continue;
+		}
+
+		if (opts.channels.empty()) {
+			for (auto &chn : dev.channels) {
+				chn.enabled = true;
+			}
+			return dev.channels.empty() ? nullptr : &dev;
+		}
+
+		while (std::getline(list, id, ',')) {
+			found = false;
+			for (auto &chn : dev.channels) {
+				if (chn.id == id || (!chn.name.empty() && chn.name == id)) {
+					chn.enabled = true;
+					found = true;
+				}
+			}
+
+			if (!found) {
+				fprintf(stderr, "Channel '%s' is not a scan channel\n", id.c_str());
+				return nullptr;
+			}
+		}
+
+		return &dev;
+	}
+
+	fprintf(stderr, "Device '%s' not found\n", opts.device.c_str());
+
+	return nullptr;
+}
+
+/*!
+ * @brief	Write the ring slots out to the capture file (writer thread)
+ * @param	ring[in] - Buffer ring
+ * @param	file[in] - Capture file
+ * @param	status[out] - Write status
+ * @return	None
+ */
+static void writer_thread(mmap_ring &ring, capture_file &file,
+			  std::atomic<int> &status)
+{
+	uint8_t *slot;
+	int ret;
+
+	while ((slot = ring.acquire_read())) {
+		ret = file.write(slot, ring.slot_size());
+		ring.release_read();
+
+		if (ret) {
+			status = ret;
+			stop_requested = true;
+		}
+	}
+}
+
+/*!
+ * @brief	Request the capture to stop
+ * @param	sig[in] - Signal number
+ * @return	None
+ */
+static void on_signal(int sig)
+{
+	stop_requested = true;
+}
+
+/*!
+ * @brief	Set up the buffer ring and open the capture file
+ * @param	ring[out] - Buffer ring
+ * @param	file[out] - Capture file
+ * @param	opts[in] - Command line options
+ * @param	device[in] - Captured device
+ * @param	scan_bytes[in] - Size of a scan
+ * @param	buffer_scans[in] - Scans per ring slot
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int setup_capture(mmap_ring &ring, capture_file &file,
+			 const capture_options &opts,
+			 const iio_device_info &device, uint32_t scan_bytes,
+			 uint32_t buffer_scans)
+{
+	int ret;
+
+	ret = ring.init(opts.ring_slots, scan_bytes * buffer_scans, opts.ring_file);
+	if (!ret) {
+		ret = file.open(opts.output, opts.format, device, scan_bytes,
+				buffer_scans);
+	}
+	if (ret) {
+		fprintf(stderr, "Failed to set up the capture: %s\n", strerror(-ret));
+	}
+
+	return ret;
+}
+
+/*!
+ * @brief	Capture the device buffers with a READBUF request per buffer
+ * @param	client[in] - IIOD client
+ * @param	opts[in] - Command line options
+ * @param	device[in] - Captured device
+ * @param	scan_bytes[in] - Size of a scan
+ * @param	ring[out] - Buffer ring
+ * @param	file[out] - Capture file
+ * @param	stats[out] - Capture statistics
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int capture_buffers(iiod_client &client, const capture_options &opts,
+			   const iio_device_info &device, uint32_t scan_bytes,
+			   mmap_ring &ring, capture_file &file,
+			   capture_stats &stats)
+{
+	uint32_t buffer_bytes = scan_bytes * opts.buffer_scans;
+	std::vector<uint8_t> scratch(buffer_bytes);
+	uint64_t scans = 0;
+	uint8_t *slot;
+	int ret = 0;
+
+	while (!stop_requested && (!opts.total_scans || scans < opts.total_scans)) {
+		/* Receive into a free slot, or drop the buffer if the writer lags */
+		slot = ring.try_acquire_write();
+		if (!slot) {
+			stats.add_dropped();
+		}
+
+		auto t0 = capture_stats::clock::now();
+		ret = client.read_buffer(device.id, slot ? slot : scratch.data(),
+					 buffer_bytes);
+		if (ret) {
+			fprintf(stderr, "Buffer read failed: %s\n", strerror(-ret));
+			break;
+		}
+		stats.add_buffer(buffer_bytes, capture_stats::clock::now() - t0);
+
+		if (slot) {
+			ring.commit_write();
+		}
+		scans += opts.buffer_scans;
+	}
+
+	return ret;
+}
+
+/*!
+ * @brief	Capture the frames pushed by the firmware in the USB streaming mode
+ * @param	stream[in] - USB stream client
+ * @param	opts[in] - Command line options
+ * @param	device[in] - Captured device
+ * @param	scan_bytes[in] - Size of a scan
+ * @param	ring[out] - Buffer ring (set up from the first frame size)
+ * @param	file[out] - Capture file
+ * @param	writer[out] - Writer thread (started once the ring is set up)
+ * @param	write_status[out] - Write status of the writer thread
+ * @param	stats[out] - Capture statistics
+ * @return	0 in case of success, negative error code otherwise
+ * @note	A gap in the frame sequence is accounted as dropped buffers, and a
+ *			frame flagged as overwritten while being sent as an overrun.
+ */
+static int capture_stream(usb_stream_client &stream,
+			  const capture_options &opts,
+			  const iio_device_info &device, uint32_t scan_bytes,
+			  mmap_ring &ring, capture_file &file, std::thread &writer,
+			  std::atomic<int> &write_status, capture_stats &stats)
+{
+	std::vector<uint8_t> scratch;
+	usb_stream_frame frame;
+	uint32_t frame_bytes = 0;
+	uint32_t next_seq = 0;
+	uint64_t scans = 0;
+	uint8_t *slot;
+	int ret, stop_ret;
+
+	ret = stream.start(device.id, scan_bytes * opts.buffer_scans);
+	if (ret) {
+		fprintf(stderr, "Failed to start the stream: %s\n", strerror(-ret));
+		return ret;
+	}
+
+	auto t0 = capture_stats::clock::now();
+
+	while (!stop_requested && (!opts.total_scans || scans < opts.total_scans)) {
+		ret = stream.read_header(frame);
+		if (ret) {
+			break;
+		}
+
+		if (frame.flags & USB_STREAM_FLAG_END) {
+			/* Stopped by the firmware */
+			return -EPIPE;
+		}
+
+		/* The ring slots are sized from the first frame */
+		if (!frame_bytes) {
+			if (!frame.len || frame.len % scan_bytes) {
+				ret = -EBADMSG;
+				break;
+			}
+
+			frame_bytes = frame.len;
+			ret = setup_capture(ring, file, opts, device, scan_bytes,
+					    frame_bytes / scan_bytes);
+			if (ret) {
+				break;
+			}
+			writer = std::thread(writer_thread, std::ref(ring), std::ref(file),
+					     std::ref(write_status));
+			scratch.resize(frame_bytes);
+			next_seq = frame.seq;
+		} else if (frame.len != frame_bytes) {
+			ret = -EBADMSG;
+			break;
+		}
+
+		if (frame.flags & USB_STREAM_FLAG_OVERRUN) {
+			stats.add_overrun();
+		}
+
+		if (frame.seq != next_seq) {
+			stats.add_dropped(frame.seq - next_seq);
+		}
+		next_seq = frame.seq + 1;
+
+		/* Receive into a free slot, or drop the frame if the writer lags */
+		slot = ring.try_acquire_write();
+		if (!slot) {
+			stats.add_dropped();
+		}
+
+		ret = stream.read_payload(slot ? slot : scratch.data(), frame_bytes);
+		if (ret) {
+			break;
+		}
+
+		auto t1 = capture_stats::clock::now();
+		stats.add_buffer(frame_bytes, t1 - t0);
+		t0 = t1;
+
+		if (slot) {
+			ring.commit_write();
+		}
+		scans += frame_bytes / scan_bytes;
+	}
+
+	if (ret) {
+		fprintf(stderr, "Stream read failed: %s\n", strerror(-ret));
+		return ret;
+	}
+
+	stop_ret = stream.stop();
+	if (stop_ret) {
+		fprintf(stderr, "Failed to stop the stream: %s\n", strerror(-stop_ret));
+	}
+
+	return stop_ret;
+}
+
+/*!
+ * @brief	Main entry point of the capture tool
+ * @return	0 in case of success, 1 otherwise
+ */
+int main(int argc, char **argv)
+{
+	capture_options opts;
+	serial_port port;
+	iiod_client client(port);
+	usb_stream_client stream(port, client);
+	std::vector<iio_device_info> devices;
+	iio_device_info *device;
+	std::atomic<int> write_status{0};
+	std::thread writer;
+	capture_file file;
+	capture_stats stats;
+	mmap_ring ring;
+	std::string xml;
+	uint32_t scan_bytes;
+	int ret;
+
+	if (parse_options(argc, argv, opts)) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	ret = port.open(opts.uri, opts.baud_rate);
+	if (ret) {
+		fprintf(stderr, "Failed to open %s: %s\n", opts.uri.c_str(), strerror(-ret));
+		return 1;
+	}
+	port.set_timeout(opts.timeout_ms);
+
+	ret = client.get_xml(xml);
+	if (!ret) {
+		ret = iio_parse_context(xml, devices);
+	}
+	if (ret) {
+		fprintf(stderr, "Failed to read the IIO context: %s\n", strerror(-ret));
+		return 1;
+	}
+
+	device = select_device(devices, opts);
+	if (!device) {
+		return 1;
+	}
+
+	scan_bytes = iio_layout_scan(*device);
+
+	/* In the streaming mode, the ring is set up once the frame size is known */
+	if (!opts.stream
+	    && setup_capture(ring, file, opts, *device, scan_bytes, opts.buffer_scans)) {
+		return 1;
+	}
+
+	/* The firmware side timeout must cover a full buffer read */
+	client.set_timeout(opts.timeout_ms);
+
+	ret = client.open_buffer(device->id, opts.buffer_scans,
+				 iio_channel_mask(*device));
+	if (ret) {
+		fprintf(stderr, "Failed to open the buffer: %s\n", strerror(-ret));
+		return 1;
+	}
+
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+
+	stats.start();
+
+	if (opts.stream) {
+		ret = capture_stream(stream, opts, *device, scan_bytes, ring, file, writer,
+				     write_status, stats);
+	} else {
+		writer = std::thread(writer_thread, std::ref(ring), std::ref(file),
+				     std::ref(write_status));
+		ret = capture_buffers(client, opts, *device, scan_bytes, ring, file, stats);
+	}
+
+	stats.stop();
+	ring.shutdown();
+	if (writer.joinable()) {
+		writer.join();
+	}
+
+	client.close_buffer(device->id);
+
+	if ((file.is_open() && file.close(stats.dropped())) || write_status) {
+		fprintf(stderr, "Failed to write the capture file\n");
+		ret = -EIO;
+	}
+
+	stats.report(stdout);
+
+	return ret ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+/***************************************************************************//**
+ * @file    mmap_ring.cpp
+ * @brief   Memory mapped single producer/single consumer buffer ring
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "mmap_ring.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+mmap_ring::~mmap_ring()
+{
+	if (base_) {
+		munmap(base_, map_size_);
+	}
+}
+
+/*!
+ * @brief	Map the ring memory
+ * @param	slots[in] - Number of buffer slots
+ * @param	slot_size[in] - Size of a buffer slot (bytes)
+ * @param	backing_file[in] - File backing the mapping (empty for anonymous)
+ * @return	0 in case of success, negative error code otherwise
+ */
+int mmap_ring::init(uint32_t slots, size_t slot_size,
+		    const std::string &backing_file)
+{
+	int flags = MAP_SHARED;
+	int fd = -1;
+	int ret;
+
+	if (!slots || !slot_size || base_) {
+		return -EINVAL;
+	}
+
+	slots_ = slots;
+	slot_size_ = slot_size;
+	map_size_ = slots * slot_size;
+
+	if (backing_file.empty()) {
+		flags |= MAP_ANONYMOUS;
+	} else {
+		fd = open(backing_file.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+			  0644);
+		if (fd < 0) {
+			return -errno;
+		}
+
+		if (ftruncate(fd, map_size_)) {
+			ret = -errno;
+			close(fd);
+			return ret;
+		}
+	}
+
+	base_ = static_cast<uint8_t *>(mmap(nullptr, map_size_,
+					    PROT_READ | PROT_WRITE, flags, fd, 0));
+	ret = (base_ == MAP_FAILED) ? -errno : 0;
+
+	if (fd >= 0) {
+		close(fd);
+	}
+
+	if (ret) {
+		base_ = nullptr;
+		return ret;
+	}
+
+	/* Fault in the pages up front, so the first buffers don't pay for it */
+	madvise(base_, map_size_, MADV_WILLNEED);
+	for (size_t offset = 0; offset < map_size_; offset += getpagesize()) {
+		base_[offset] = 0;
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Get the next free slot to write into (producer)
+ * @return	Slot memory, nullptr if the ring is full
+ */
+uint8_t *mmap_ring::try_acquire_write()
+{
+	uint64_t head = head_.load(std::memory_order_relaxed);
+
+	if (head - tail_.load(std::memory_order_acquire) >= slots_) {
+		return nullptr;
+	}
+
+	return slot(head);
+}
+
+/*!
+ * @brief	Hand over the written slot to the consumer (producer)
+ * @return	None
+ */
+void mmap_ring::commit_write()
+{
+	head_.fetch_add(1, std::memory_order_release);
+
+	std::lock_guard<std::mutex> guard(lock_);
+	ready_.notify_one();
+}
+
+/*!
+ * @brief	Wait for the next written slot (consumer)
+ * @return	Slot memory, nullptr once the ring is shut down and drained
+ */
+uint8_t *mmap_ring::acquire_read()
+{
+	uint64_t tail = tail_.load(std::memory_order_relaxed);
+	std::unique_lock<std::mutex> guard(lock_);
+
+	ready_.wait(guard, [&] {
+		return head_.load(std::memory_order_acquire) != tail
+		       || shutdown_.load();
+	});
+
+	if (head_.load(std::memory_order_acquire) == tail) {
+		return nullptr;
+	}
+
+	return slot(tail);
+}
+
+/*!
+ * @brief	Return the read slot to the producer (consumer)
+ * @return	None
+ */
+void mmap_ring::release_read()
+{
+	tail_.fetch_add(1, std::memory_order_release);
+}
+
+/*!
+ * @brief	Stop the ring, the consumer drains the written slots and stops
+ * @return	None
+ */
+void mmap_ring::shutdown()
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	shutdown_.store(true);
+	ready_.notify_all();
+}
@@ -0,0 +1,78 @@
+/***************************************************************************//**
+ * @file    mmap_ring.h
+ * @brief   Memory mapped single producer/single consumer buffer ring
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _MMAP_RING_H_
+#define _MMAP_RING_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @class mmap_ring
+ * @brief Ring of fixed size buffer slots in a memory mapping
+ * @note  The producer receives the device buffers straight into the slots and
+ *        the consumer writes them out from the same memory. The mapping is
+ *        anonymous, or backed by a file (e.g. on /dev/shm) so that another
+ *        process can observe the capture live.
+ */
+class mmap_ring
+{
+public:
+	mmap_ring() = default;
+	~mmap_ring();
+
+	mmap_ring(const mmap_ring &) = delete;
+	mmap_ring &operator=(const mmap_ring &) = delete;
+
+	int init(uint32_t slots, size_t slot_size, const std::string &backing_file);
+
+	uint8_t *try_acquire_write();
+	void commit_write();
+	uint8_t *acquire_read();
+	void release_read();
+	void shutdown();
+
+	size_t slot_size() const
+	{
+		return slot_size_;
+	}
+
+private:
+	uint8_t *slot(uint64_t seq) const
+	{
+		return base_ + (seq % slots_) * slot_size_;
+	}
+
+	uint8_t *base_ = nullptr;
+	size_t map_size_ = 0;
+	uint32_t slots_ = 0;
+	size_t slot_size_ = 0;
+	/* Sequence numbers of the next slot to write and to read */
+	std::atomic<uint64_t> head_{0};
+	std::atomic<uint64_t> tail_{0};
+	std::atomic<bool> shutdown_{false};
+	std::mutex lock_;
+	std::condition_variable ready_;
+};
+
+#endif // _MMAP_RING_H_
@@ -0,0 +1,336 @@
+/***************************************************************************//**
+ * @file    serial_port.cpp
+ * @brief   Raw serial port (UART/VCOM) access for the IIO capture tool
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "serial_port.h"
+
+/******************************************************************************/
+/********************* Macros and Constants Definitions ***********************/
+/******************************************************************************/
+
+/* Max length of an IIOD response line */
+#define MAX_LINE_LEN	256
+
+/* Prefix of the TCP URIs (host builds of the firmware) */
+#define TCP_URI_PREFIX	"ip:"
+
+/* Default TCP port of the firmware host builds */
+#define DEFAULT_TCP_PORT	"30431"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Map the baud rate onto the termios speed
+ * @param	baud_rate[in] - Baud rate
+ * @return	termios speed, B0 if not supported
+ */
+static speed_t baud_to_speed(uint32_t baud_rate)
+{
+	switch (baud_rate) {
+	case 9600:
+		return B9600;
+	case 19200:
+		return B19200;
+	case 38400:
+		return B38400;
+	case 57600:
+		return B57600;
+	case 115200:
+		return B115200;
+	case 230400:
+		return B230400;
+#if defined(B460800)
+	case 460800:
+		return B460800;
+#endif
+#if defined(B921600)
+	case 921600:
+		return B921600;
+#endif
+#if defined(B3000000)
+	case 3000000:
+		return B3000000;
+#endif
+	default:
+		return B0;
+	}
+}
+
+serial_port::~serial_port()
+{
+	close();
+}
+
+/*!
+ * @brief	Connect to the IIO UART of a firmware host build
+ * @param	address[in] - host[:port]
+ * @return	0 in case of success, negative error code otherwise
+ */
+int serial_port::open_tcp(const std::string &address)
+{
+	struct addrinfo hints = {};
+	struct addrinfo *res;
+	struct addrinfo *ai;
+	std::string host = address;
+	std::string port = DEFAULT_TCP_PORT;
+	size_t sep = address.rfind(':');
+	int opt = 1;
+	int ret;
+
+	if (sep != std::string::npos) {
+		host = address.substr(0, sep);
+		port = address.substr(sep + 1);
+	}
+
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	ret = getaddrinfo(host.empty() ? "localhost" : host.c_str(), port.c_str(),
+			  &hints, &res);
+	if (ret) {
+		return -EHOSTUNREACH;
+	}
+
+	ret = -ECONNREFUSED;
+	for (ai = res; ai; ai = ai->ai_next) {
+		fd_ = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC,
+			     ai->ai_protocol);
+		if (fd_ < 0) {
+			ret = -errno;
+			continue;
+		}
+
+		if (!connect(fd_, ai->ai_addr, ai->ai_addrlen)) {
+			ret = 0;
+			break;
+		}
+
+		ret = -errno;
+		close();
+	}
+
+	freeaddrinfo(res);
+
+	if (!ret) {
+		/* The IIOD commands are short, send them without coalescing delay */
+		setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+	}
+
+	return ret;
+}
+
+/*!
+ * @brief	Open the serial port in raw mode
+ * @param	path[in] - Serial device path (e.g. /dev/ttyACM0), or ip:host[:port]
+ *			for the IIO UART of a firmware host build
+ * @param	baud_rate[in] - Baud rate (ignored by the USB VCOM ports)
+ * @return	0 in case of success, negative error code otherwise
+ * @note	Devices which are not terminals (e.g. FIFOs or sockets used for
+ *			emulation) are accepted as is.
+ */
+int serial_port::open(const std::string &path, uint32_t baud_rate)
+{
+	struct termios tty;
+	speed_t speed;
+
+	close();
+
+	if (!path.compare(0, sizeof(TCP_URI_PREFIX) - 1, TCP_URI_PREFIX)) {
+		return open_tcp(path.substr(sizeof(TCP_URI_PREFIX) - 1));
+	}
+
+	fd_ = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+	if (fd_ < 0) {
+		return -errno;
+	}
+
+	if (!isatty(fd_)) {
+		return 0;
+	}
+
+	speed = baud_to_speed(baud_rate);
+	if (speed == B0) {
+		close();
+		return -EINVAL;
+	}
+
+	if (tcgetattr(fd_, &tty)) {
+		int ret = -errno;
+		close();
+		return ret;
+	}
+
+	cfmakeraw(&tty);
+	cfsetispeed(&tty, speed);
+	cfsetospeed(&tty, speed);
+	tty.c_cflag |= CLOCAL | CREAD;
+	tty.c_cflag &= ~CRTSCTS;
+	tty.c_cc[VMIN] = 1;
+	tty.c_cc[VTIME] = 0;
+
+	if (tcsetattr(fd_, TCSANOW, &tty)) {
+		int ret = -errno;
+		close();
+		return ret;
+	}
+
+	/* Discard any stale response of an aborted session */
+	tcflush(fd_, TCIOFLUSH);
+
+	return 0;
+}
+
+/*!
+ * @brief	Close the serial port
+ * @return	None
+ */
+void serial_port::close()
+{
+	if (fd_ >= 0) {
+		::close(fd_);
+		fd_ = -1;
+	}
+}
+
+/*!
+ * @brief	Wait until the data is available to read
+ * @return	0 in case of success, negative error code otherwise
+ */
+int serial_port::wait_readable()
+{
+	struct pollfd pfd = { fd_, POLLIN, 0 };
+	int ret;
+
+	do {
+		ret = poll(&pfd, 1, timeout_ms_);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0) {
+		return -errno;
+	}
+
+	if (ret == 0) {
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Write all the data to the serial port
+ * @param	data[in] - Data to write
+ * @param	len[in] - Number of bytes to write
+ * @return	0 in case of success, negative error code otherwise
+ */
+int serial_port::write_all(const void *data, size_t len)
+{
+	const uint8_t *ptr = static_cast<const uint8_t *>(data);
+	ssize_t ret;
+
+	while (len) {
+		ret = ::write(fd_, ptr, len);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -errno;
+		}
+
+		ptr += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Read the exact number of bytes from the serial port
+ * @param	data[out] - Memory to read the data into
+ * @param	len[in] - Number of bytes to read
+ * @return	0 in case of success, negative error code otherwise
+ */
+int serial_port::read_exact(void *data, size_t len)
+{
+	uint8_t *ptr = static_cast<uint8_t *>(data);
+	ssize_t ret;
+
+	while (len) {
+		ret = wait_readable();
+		if (ret) {
+			return ret;
+		}
+
+		ret = ::read(fd_, ptr, len);
+		if (ret < 0) {
+			if (errno == EINTR || errno == EAGAIN) {
+				continue;
+			}
+			return -errno;
+		}
+
+		if (ret == 0) {
+			return -EPIPE;
+		}
+
+		ptr += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/*!
+ * @brief	Read a line (terminated by '\n') from the serial port
+ * @param	line[out] - Line read, without the line terminator
+ * @return	0 in case of success, negative error code otherwise
+ * @note	The line is read a byte at a time so that no bulk data following
+ *			the line gets consumed.
+ */
+int serial_port::read_line(std::string &line)
+{
+	char c;
+	int ret;
+
+	line.clear();
+
+	while (line.size() < MAX_LINE_LEN) {
+		ret = read_exact(&c, 1);
+		if (ret) {
+			return ret;
+		}
+
+		if (c == '\n') {
+			if (!line.empty() && line.back() == '\r') {
+				line.pop_back();
+			}
+			return 0;
+		}
+
+		line.push_back(c);
+	}
+
+	return -EOVERFLOW;
+}
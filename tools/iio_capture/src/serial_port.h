@@ -0,0 +1,63 @@
+/***************************************************************************//**
+ * @file    serial_port.h
+ * @brief   Raw serial port (UART/VCOM) access for the IIO capture tool
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _SERIAL_PORT_H_
+#define _SERIAL_PORT_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @class serial_port
+ * @brief Blocking serial port with read timeout
+ * @note  The received data is read straight into the caller memory, without
+ *        any intermediate buffering other than the one line read ahead for
+ *        the IIOD text responses.
+ */
+class serial_port
+{
+public:
+	serial_port() = default;
+	~serial_port();
+
+	serial_port(const serial_port &) = delete;
+	serial_port &operator=(const serial_port &) = delete;
+
+	int open(const std::string &path, uint32_t baud_rate);
+	void close();
+
+	void set_timeout(uint32_t timeout_ms)
+	{
+		timeout_ms_ = timeout_ms;
+	}
+
+	int write_all(const void *data, size_t len);
+	int read_exact(void *data, size_t len);
+	int read_line(std::string &line);
+
+private:
+	int open_tcp(const std::string &address);
+	int wait_readable();
+
+	int fd_ = -1;
+	uint32_t timeout_ms_ = 5000;
+};
+
+#endif // _SERIAL_PORT_H_
@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ * @file    usb_stream.cpp
+ * @brief   Client of the firmware binary framed USB streaming mode
+ * @details Every frame is a 16 byte little endian header (magic, sequence,
+ *          payload length and flags) followed by the payload, which is the
+ *          raw IIO scan data of one firmware DMA block. The stream ends with a
+ *          header only frame flagged USB_STREAM_FLAG_END.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cerrno>
+
+#include "usb_stream.h"
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Get a little endian 32-bit word
+ * @param	data[in] - Word bytes
+ * @return	Word value
+ */
+static uint32_t get_le32(const uint8_t *data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16)
+	       | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+/*!
+ * @brief	Start the stream
+ * @param	device[in] - Device ID (e.g. iio:device0)
+ * @param	buffer_bytes[in] - Size of the READBUF request
+ * @return	0 in case of success, negative error code otherwise
+ */
+int usb_stream_client::start(const std::string &device, uint32_t buffer_bytes)
+{
+	buffer_bytes_ = buffer_bytes;
+
+	return client_.request_buffer(device, buffer_bytes);
+}
+
+/*!
+ * @brief	Read the header of the next frame
+ * @param	frame[out] - Frame header fields
+ * @return	0 in case of success, negative error code otherwise
+ */
+int usb_stream_client::read_header(usb_stream_frame &frame)
+{
+	uint8_t hdr[USB_STREAM_HDR_SIZE];
+	int ret;
+
+	ret = port_.read_exact(hdr, sizeof(hdr));
+	if (ret) {
+		return ret;
+	}
+
+	if (get_le32(hdr) != USB_STREAM_MAGIC) {
+		return -EBADMSG;
+	}
+
+	frame.seq = get_le32(hdr + 4);
+	frame.len = get_le32(hdr + 8);
+	frame.flags = get_le32(hdr + 12);
+
+	return 0;
+}
+
+/*!
+ * @brief	Read the payload of the frame
+ * @param	data[out] - Memory to receive the payload into
+ * @param	len[in] - Payload length (from the frame header)
+ * @return	0 in case of success, negative error code otherwise
+ */
+int usb_stream_client::read_payload(void *data, uint32_t len)
+{
+	return port_.read_exact(data, len);
+}
+
+/*!
+ * @brief	Stop the stream
+ * @return	0 in case of success, negative error code otherwise
+ * @note	The frames in flight are discarded up to the end frame, then the
+ *			response of the READBUF request that started the stream is read.
+ */
+int usb_stream_client::stop()
+{
+	std::vector<uint8_t> discard;
+	usb_stream_frame frame;
+	const uint8_t stop_byte = 0;
+	int ret;
+
+	ret = port_.write_all(&stop_byte, 1);
+	if (ret) {
+		return ret;
+	}
+
+	for (;;) {
+		ret = read_header(frame);
+		if (ret) {
+			return ret;
+		}
+
+		if (frame.flags & USB_STREAM_FLAG_END) {
+			break;
+		}
+
+		discard.resize(frame.len);
+		ret = read_payload(discard.data(), frame.len);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	discard.resize(buffer_bytes_);
+
+	return client_.read_buffer_response(discard.data(), buffer_bytes_);
+}
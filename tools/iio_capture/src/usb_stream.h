@@ -0,0 +1,81 @@
+/***************************************************************************//**
+ * @file    usb_stream.h
+ * @brief   Client of the firmware binary framed USB streaming mode
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _USB_STREAM_H_
+#define _USB_STREAM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "iiod_client.h"
+#include "serial_port.h"
+
+/******************************************************************************/
+/********************* Macros and Constants Definitions ***********************/
+/******************************************************************************/
+
+/* Frame header magic ("STRM") */
+#define USB_STREAM_MAGIC			0x4D525453
+#define USB_STREAM_HDR_SIZE			16
+
+/* Frame flags */
+/* The payload of the previous frame was overwritten while being sent */
+#define USB_STREAM_FLAG_OVERRUN		(1u << 0)
+/* Last frame of the stream (no payload) */
+#define USB_STREAM_FLAG_END			(1u << 1)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct usb_stream_frame
+ * @brief Frame header fields
+ */
+struct usb_stream_frame {
+	/* Index of the firmware block, gaps are dropped blocks */
+	uint32_t seq = 0;
+	/* Number of payload bytes */
+	uint32_t len = 0;
+	uint32_t flags = 0;
+};
+
+/**
+ * @class usb_stream_client
+ * @brief Receives the frames pushed by the firmware in the USB streaming mode
+ * @note  The stream is started by a READBUF request with the firmware device
+ *        attribute data_streaming_mode set to usb_bulk. The firmware pushes
+ *        the frames until a byte is written to it, then completes the READBUF
+ *        request as usual.
+ */
+class usb_stream_client
+{
+public:
+	usb_stream_client(serial_port &port, iiod_client &client)
+		: port_(port), client_(client) {}
+
+	int start(const std::string &device, uint32_t buffer_bytes);
+	int read_header(usb_stream_frame &frame);
+	int read_payload(void *data, uint32_t len);
+	int stop();
+
+private:
+	serial_port &port_;
+	iiod_client &client_;
+	uint32_t buffer_bytes_ = 0;
+};
+
+#endif // _USB_STREAM_H_
@@ -0,0 +1,22 @@
+/***************************************************************************//**
+ * @file    no_os_alloc.h
+ * @brief   Host stand-in of the no-OS memory allocation API
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _NO_OS_ALLOC_H_
+#define _NO_OS_ALLOC_H_
+
+#include <stdlib.h>
+
+#define no_os_malloc(size)			malloc(size)
+#define no_os_calloc(nitems, size)	calloc(nitems, size)
+#define no_os_free(ptr)				free(ptr)
+
+#endif // _NO_OS_ALLOC_H_
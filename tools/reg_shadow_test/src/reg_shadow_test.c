@@ -0,0 +1,508 @@
+/***************************************************************************//**
+ * @file    reg_shadow_test.c
+ * @brief   Host unit tests of the register shadow
+ * @details Runs projects/_common/reg_shadow.c against a byte addressed model
+ *          of a device register map, streaming downwards (AD4170, default
+ *          ADDR_ASCENSION = 0) and upwards. Multi-byte registers are accessed
+ *          from their first byte in the streaming direction (the MSB), so
+ *          every register read, write, flush and reload is checked byte by
+ *          byte against the model, along with the number of transfers.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "reg_shadow.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Size of the modelled register map (the last register ends at the top) */
+#define TEST_MAP_SIZE			0x100
+
+/* Instruction phase ahead of the burst data (AD4170 long instruction) */
+#define TEST_HEADROOM			2
+
+/* Burst length covering every run of the register map */
+#define TEST_MAX_BURST			64
+
+/* Burst length splitting the runs of the register map */
+#define TEST_SHORT_BURST		5
+
+/* Number of registers of the modelled map */
+#define TEST_NB_REGS			(sizeof(test_regs) / sizeof(test_regs[0]))
+
+/* Runs of abutting registers in the modelled map */
+#define TEST_NB_RUNS			7
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/**
+ * @struct test_reg
+ * @brief Register of the modelled map
+ */
+struct test_reg {
+	/* Lowest byte address */
+	uint16_t base;
+	/* Size (in bytes) */
+	uint8_t size;
+};
+
+/**
+ * @struct test_model
+ * @brief Byte addressed device register map
+ */
+struct test_model {
+	uint8_t mem[TEST_MAP_SIZE];
+	/* Bytes written by the shadow */
+	uint8_t written[TEST_MAP_SIZE];
+	/* Register access addresses (bursts should start on one) */
+	uint8_t access[TEST_MAP_SIZE];
+	bool descending;
+	uint32_t transfers;
+	/* Bursts streaming out of the map */
+	uint32_t out_of_map;
+	/* Bursts not starting on a register access address */
+	uint32_t misaligned;
+};
+
+/* Register map: abutting runs of mixed sizes, gaps and a last register
+ * ending at the top of the map */
+static const struct test_reg test_regs[] = {
+	{ 0x00, 1 }, { 0x01, 1 }, { 0x02, 1 }, { 0x03, 1 },
+	{ 0x0A, 1 }, { 0x0B, 1 },
+	{ 0x0E, 2 },
+	{ 0x15, 3 }, { 0x18, 2 }, { 0x1A, 1 }, { 0x1B, 4 },
+	{ 0x80, 2 }, { 0x82, 2 }, { 0x84, 2 }, { 0x86, 2 },
+	{ 0xC0, 1 }, { 0xC1, 2 }, { 0xC3, 3 }, { 0xC6, 3 }, { 0xC9, 2 },
+	{ 0xFD, 3 }
+};
+
+/* Number of failed checks */
+static uint32_t test_failures;
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief	Report a failed check
+ * @param	what[in] - Check description
+ * @param	model[in] - Register model under test
+ * @param	reg[in] - Register index (or any value for map wide checks)
+ * @return	none
+ */
+static void test_fail(const char *what, const struct test_model *model,
+		      uint32_t reg)
+{
+	printf("FAIL: %s (%s, register %u)\n", what,
+	       model->descending ? "descending" : "ascending", reg);
+	test_failures++;
+}
+
+/**
+ * @brief	Fill the model with pseudo random bytes
+ * @param	model[out] - Register model
+ * @param	seed[in] - Pattern seed
+ * @return	none
+ */
+static void model_fill(struct test_model *model, uint32_t seed)
+{
+	uint32_t i;
+
+	for (i = 0; i < TEST_MAP_SIZE; i++) {
+		seed = seed * 1103515245 + 12345;
+		model->mem[i] = seed >> 16;
+	}
+}
+
+/**
+ * @brief	Get the access address of a register
+ * @param	model[in] - Register model
+ * @param	reg[in] - Register
+ * @return	Address of the MSB (first byte in the streaming direction)
+ */
+static uint16_t model_addr(const struct test_model *model,
+			   const struct test_reg *reg)
+{
+	return model->descending ? reg->base + reg->size - 1 : reg->base;
+}
+
+/**
+ * @brief	Get the value of a register in the model
+ * @param	model[in] - Register model
+ * @param	reg[in] - Register
+ * @return	Register value
+ */
+static uint32_t model_value(const struct test_model *model,
+			    const struct test_reg *reg)
+{
+	uint16_t addr = model_addr(model, reg);
+	uint32_t val = 0;
+	uint8_t i;
+
+	for (i = 0; i < reg->size; i++) {
+		val = (val << 8) | model->mem[model->descending ? addr - i : addr + i];
+	}
+
+	return val;
+}
+
+/**
+ * @brief	Stream bytes between the model and the burst data
+ * @param	ctx[in] - Register model
+ * @param	addr[in] - Address of the first byte
+ * @param	data[in,out] - Burst data (preceded by the instruction headroom)
+ * @param	len[in] - Number of bytes
+ * @param	write[in] - Write the data to the model (read it otherwise)
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t model_stream(void *ctx, uint16_t addr, uint8_t *data,
+			    uint16_t len, bool write)
+{
+	struct test_model *model = ctx;
+	int32_t pos;
+	uint16_t i;
+
+	/* Instruction phase, as the device transfers build it */
+	data[-2] = (write ? 0x00 : 0x80) | (uint8_t)(addr >> 8);
+	data[-1] = (uint8_t)addr;
+
+	if (!model->access[addr]) {
+		model->misaligned++;
+	}
+
+	for (i = 0; i < len; i++) {
+		pos = model->descending ? (int32_t)addr - i : (int32_t)addr + i;
+		if (pos < 0 || pos >= TEST_MAP_SIZE) {
+			model->out_of_map++;
+			return -EINVAL;
+		}
+
+		if (write) {
+			model->mem[pos] = data[i];
+			model->written[pos] = 1;
+		} else {
+			data[i] = model->mem[pos];
+		}
+	}
+
+	model->transfers++;
+
+	return 0;
+}
+
+static int32_t model_read(void *ctx, uint16_t addr, uint8_t *data,
+			  uint16_t len)
+{
+	return model_stream(ctx, addr, data, len, false);
+}
+
+static int32_t model_write(void *ctx, uint16_t addr, uint8_t *data,
+			   uint16_t len)
+{
+	return model_stream(ctx, addr, data, len, true);
+}
+
+static const struct reg_shadow_ops model_ops = {
+	.read = model_read,
+	.write = model_write
+};
+
+/**
+ * @brief	Create a register shadow of the model
+ * @param	model[in,out] - Register model (filled with random bytes)
+ * @param	descending[in] - Addresses decrement while streaming
+ * @param	max_burst[in] - Max data bytes per burst
+ * @param	regs[out] - Register list of the shadow
+ * @param	shadow[out] - Register shadow descriptor
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t test_setup(struct test_model *model, bool descending,
+			  uint16_t max_burst, struct reg_shadow_reg *regs,
+			  struct reg_shadow_desc **shadow)
+{
+	struct reg_shadow_init_param param = {
+		.map_size = TEST_MAP_SIZE,
+		.descending = descending,
+		.max_burst = max_burst,
+		.headroom = TEST_HEADROOM,
+		.ops = &model_ops,
+		.ctx = model
+	};
+	uint32_t i;
+
+	memset(model, 0, sizeof(*model));
+	model->descending = descending;
+	model_fill(model, 7);
+
+	for (i = 0; i < TEST_NB_REGS; i++) {
+		regs[i].addr = model_addr(model, &test_regs[i]);
+		regs[i].size = test_regs[i].size;
+		model->access[regs[i].addr] = 1;
+	}
+
+	return reg_shadow_init(shadow, &param);
+}
+
+/**
+ * @brief	Check the shadow reads every register as held by the model
+ * @param	model[in] - Register model
+ * @param	shadow[in] - Register shadow descriptor
+ * @param	what[in] - Check description
+ * @return	none
+ */
+static void check_regs(struct test_model *model, struct reg_shadow_desc *shadow,
+		       const char *what)
+{
+	uint32_t val;
+	uint32_t i;
+
+	for (i = 0; i < TEST_NB_REGS; i++) {
+		if (reg_shadow_read(shadow, model_addr(model, &test_regs[i]),
+				    test_regs[i].size, &val)) {
+			test_fail(what, model, i);
+		} else if (val != model_value(model, &test_regs[i])) {
+			test_fail(what, model, i);
+		}
+	}
+}
+
+/**
+ * @brief	Load, read and write every register of the map
+ * @param	descending[in] - Addresses decrement while streaming
+ * @return	none
+ */
+static void test_access(bool descending)
+{
+	struct reg_shadow_reg regs[TEST_NB_REGS];
+	struct reg_shadow_desc *shadow;
+	struct test_model model;
+	uint8_t expected[TEST_MAP_SIZE];
+	uint32_t transfers;
+	uint32_t val;
+	uint32_t i;
+	uint8_t b;
+
+	if (test_setup(&model, descending, TEST_MAX_BURST, regs, &shadow)) {
+		test_fail("init", &model, 0);
+		return;
+	}
+
+	/* One burst per run of abutting registers */
+	if (reg_shadow_load(shadow, regs, TEST_NB_REGS)
+	    || model.transfers != TEST_NB_RUNS) {
+		test_fail("load", &model, 0);
+	}
+
+	transfers = model.transfers;
+	check_regs(&model, shadow, "read after load");
+	if (model.transfers != transfers) {
+		test_fail("reads served from the image", &model, 0);
+	}
+
+	/* Write every other register: only their bytes may change */
+	memcpy(expected, model.mem, sizeof(expected));
+	for (i = 0; i < TEST_NB_REGS; i += 2) {
+		val = 0;
+		for (b = 0; b < test_regs[i].size; b++) {
+			val = (val << 8) | (uint8_t)(0xA0 + i + 16 * b);
+		}
+
+		if (reg_shadow_write(shadow, regs[i].addr, regs[i].size, val)) {
+			test_fail("write", &model, i);
+		}
+
+		for (b = 0; b < test_regs[i].size; b++) {
+			/* MSB first in the streaming direction */
+			expected[descending ? regs[i].addr - b : regs[i].addr + b] =
+				(uint8_t)(val >> (8 * (test_regs[i].size - 1 - b)));
+		}
+	}
+
+	if (model.transfers != transfers) {
+		test_fail("writes held until the flush", &model, 0);
+	}
+
+	if (reg_shadow_flush(shadow)) {
+		test_fail("flush", &model, 0);
+	}
+
+	if (memcmp(expected, model.mem, sizeof(expected))) {
+		test_fail("model after the flush", &model, 0);
+	}
+
+	for (i = 1; i < TEST_NB_REGS; i += 2) {
+		for (b = 0; b < test_regs[i].size; b++) {
+			if (model.written[test_regs[i].base + b]) {
+				test_fail("untouched register written", &model, i);
+			}
+		}
+	}
+
+	check_regs(&model, shadow, "read after flush");
+
+	/* Unchanged values are not written again */
+	transfers = model.transfers;
+	for (i = 0; i < TEST_NB_REGS; i++) {
+		reg_shadow_write(shadow, regs[i].addr, regs[i].size,
+				 model_value(&model, &test_regs[i]));
+	}
+
+	if (reg_shadow_flush(shadow) || model.transfers != transfers) {
+		test_fail("unchanged writes dropped", &model, 0);
+	}
+
+	/* Device reset: restore the whole map from the image */
+	memset(model.mem, 0, sizeof(model.mem));
+	reg_shadow_mark_dirty(shadow, regs, TEST_NB_REGS);
+	if (reg_shadow_flush(shadow)) {
+		test_fail("restore after reset", &model, 0);
+	}
+
+	for (i = 0; i < TEST_NB_REGS; i++) {
+		if (memcmp(&expected[test_regs[i].base], &model.mem[test_regs[i].base],
+			   test_regs[i].size)) {
+			test_fail("register restored after reset", &model, i);
+		}
+	}
+
+	/* Register changed by the device itself */
+	i = TEST_NB_REGS - 1;
+	model.mem[test_regs[i].base] ^= 0x5A;
+	model.mem[test_regs[i].base + test_regs[i].size - 1] ^= 0xA5;
+	reg_shadow_invalidate(shadow, regs[i].addr, regs[i].size);
+	transfers = model.transfers;
+	if (reg_shadow_read(shadow, regs[i].addr, regs[i].size, &val)
+	    || val != model_value(&model, &test_regs[i])
+	    || model.transfers != transfers + 1) {
+		test_fail("read after invalidate", &model, i);
+	}
+
+	if (model.out_of_map || model.misaligned) {
+		test_fail("bursts out of the map or off a register", &model, 0);
+	}
+
+	reg_shadow_remove(shadow);
+}
+
+/**
+ * @brief	Split the bursts longer than the burst buffer
+ * @param	descending[in] - Addresses decrement while streaming
+ * @return	none
+ */
+static void test_split(bool descending)
+{
+	struct reg_shadow_reg regs[TEST_NB_REGS];
+	struct reg_shadow_desc *shadow;
+	struct test_model model;
+	uint8_t expected[TEST_MAP_SIZE];
+	uint32_t i;
+
+	if (test_setup(&model, descending, TEST_SHORT_BURST, regs, &shadow)) {
+		test_fail("init", &model, 0);
+		return;
+	}
+
+	if (reg_shadow_load(shadow, regs, TEST_NB_REGS)) {
+		test_fail("split load", &model, 0);
+	}
+
+	check_regs(&model, shadow, "read after split load");
+
+	/* Rewrite the whole map with new values */
+	model_fill(&model, 11);
+	memcpy(expected, model.mem, sizeof(expected));
+	for (i = 0; i < TEST_NB_REGS; i++) {
+		reg_shadow_write(shadow, regs[i].addr, regs[i].size,
+				 model_value(&model, &test_regs[i]));
+	}
+	model_fill(&model, 7);
+
+	if (reg_shadow_flush(shadow)) {
+		test_fail("split flush", &model, 0);
+	}
+
+	for (i = 0; i < TEST_NB_REGS; i++) {
+		if (memcmp(&expected[test_regs[i].base], &model.mem[test_regs[i].base],
+			   test_regs[i].size)) {
+			test_fail("register after split flush", &model, i);
+		}
+	}
+
+	/* Bursts are cut ahead of a register */
+	if (model.out_of_map || model.misaligned) {
+		test_fail("split bursts out of the map or off a register", &model, 0);
+	}
+
+	reg_shadow_remove(shadow);
+}
+
+/**
+ * @brief	Reject the registers out of the map
+ * @param	descending[in] - Addresses decrement while streaming
+ * @return	none
+ */
+static void test_invalid(bool descending)
+{
+	struct reg_shadow_reg regs[TEST_NB_REGS];
+	struct reg_shadow_desc *shadow;
+	struct test_model model;
+	uint32_t val;
+
+	if (test_setup(&model, descending, TEST_MAX_BURST, regs, &shadow)) {
+		test_fail("init", &model, 0);
+		return;
+	}
+
+	if (reg_shadow_read(shadow, TEST_MAP_SIZE, 1, &val) != -EINVAL
+	    || reg_shadow_write(shadow, 0, 5, 0) != -EINVAL
+	    || reg_shadow_write(shadow, 0, 0, 0) != -EINVAL) {
+		test_fail("invalid register", &model, 0);
+	}
+
+	/* A multi-byte register streamed past the end of the map */
+	if (descending) {
+		val = reg_shadow_read(shadow, 1, 3, &val);
+	} else {
+		val = reg_shadow_read(shadow, TEST_MAP_SIZE - 2, 3, &val);
+	}
+	if ((int32_t)val != -EINVAL || model.transfers) {
+		test_fail("register across the map end", &model, 0);
+	}
+
+	reg_shadow_remove(shadow);
+}
+
+int main(void)
+{
+	test_access(true);
+	test_access(false);
+	test_split(true);
+	test_split(false);
+	test_invalid(true);
+	test_invalid(false);
+
+	if (test_failures) {
+		printf("%u check(s) failed\n", test_failures);
+		return EXIT_FAILURE;
+	}
+
+	printf("All register shadow checks passed\n");
+
+	return EXIT_SUCCESS;
+}
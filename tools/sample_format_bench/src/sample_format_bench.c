@@ -0,0 +1,581 @@
+/***************************************************************************//**
+ * @file    sample_format_bench.c
+ * @brief   Host unit tests and benchmark of the ADC sample format kernels
+ * @details Checks the unpack, sign extend, offset binary and pack kernels of
+ *          projects/_common/sample_format.c against byte wise references
+ *          (every size, aligned and unaligned sources, in place and out of
+ *          place), then times every format against the per sample shift and
+ *          compare loops the kernels replaced in the firmware.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC
+#endif
+#include "sample_format.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Largest sample count tested (covers the tail of every unrolled kernel) */
+#define TEST_MAX_SAMPLES		37
+
+/* Number of corner codes of the sign conversion tests */
+#define TEST_NB_CORNER_CODES	17
+
+/* Samples per benchmark block (ad4080 FIFO depth) */
+#define BENCH_SAMPLES			16384
+
+/* Total samples processed per measurement */
+#define BENCH_SAMPLES_PER_RUN	(16 * 1024 * 1024)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Number of failed checks */
+static uint32_t test_failures;
+
+/* Code resolutions of the sign extend and offset binary kernels */
+static const uint8_t test_bits[] = {
+	16, 18, 20, 24, 32
+};
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief	Report a failed check
+ * @param	what[in] - Check description
+ * @param	size[in] - Word size or resolution under test
+ * @param	samples[in] - Sample count under test
+ * @return	none
+ */
+static void test_fail(const char *what, uint32_t size, uint32_t samples)
+{
+	printf("FAIL: %s (%u, %u samples)\n", what, size, samples);
+	test_failures++;
+}
+
+/**
+ * @brief	Fill the buffer with pseudo random bytes
+ * @param	buff[out] - Buffer
+ * @param	nb_bytes[in] - Number of bytes to fill
+ * @param	seed[in] - Pattern seed
+ * @return	none
+ */
+static void fill_bytes(uint8_t *buff, uint32_t nb_bytes, uint32_t seed)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb_bytes; i++) {
+		seed = seed * 1103515245 + 12345;
+		buff[i] = seed >> 16;
+	}
+}
+
+/**
+ * @brief	Byte wise big endian unpack (reference)
+ * @param	src[in] - Packed words
+ * @param	dst[out] - Unpacked samples
+ * @param	samples[in] - Number of samples
+ * @param	bytes_per_word[in] - Packed word size
+ * @return	none
+ */
+static void ref_unpack_be(const uint8_t *src, uint32_t *dst, uint32_t samples,
+			  uint8_t bytes_per_word)
+{
+	uint32_t i;
+	uint8_t b;
+
+	for (i = 0; i < samples; i++) {
+		dst[i] = 0;
+		for (b = 0; b < bytes_per_word; b++) {
+			dst[i] = (dst[i] << 8) | *src++;
+		}
+	}
+}
+
+/**
+ * @brief	Two's complement value of a code (reference)
+ * @param	code[in] - Code
+ * @param	bits[in] - Resolution
+ * @return	Signed value
+ */
+static int64_t ref_twos(uint32_t code, uint8_t bits)
+{
+	uint64_t mask = (bits == 32) ? 0xFFFFFFFFULL : ((1ULL << bits) - 1);
+	uint64_t val = code & mask;
+
+	if (val & (1ULL << (bits - 1))) {
+		return (int64_t)val - (int64_t)(mask + 1);
+	}
+
+	return (int64_t)val;
+}
+
+/**
+ * @brief	Bit wise little endian pack (reference)
+ * @param	src[in] - Samples
+ * @param	dst[out] - Packed stream
+ * @param	samples[in] - Number of samples
+ * @param	bits[in] - Packed sample size
+ * @return	Number of bytes written
+ */
+static uint32_t ref_pack_le(const uint32_t *src, uint8_t *dst, uint32_t samples,
+			    uint8_t bits)
+{
+	uint32_t nb_bytes = (samples * bits + 7) / 8;
+	uint32_t bit;
+
+	memset(dst, 0, nb_bytes);
+	for (bit = 0; bit < samples * bits; bit++) {
+		if ((src[bit / bits] >> (bit % bits)) & 1) {
+			dst[bit / 8] |= 1 << (bit % 8);
+		}
+	}
+
+	return nb_bytes;
+}
+
+/**
+ * @brief	Test the unpack kernels
+ * @return	none
+ */
+static void test_unpack(void)
+{
+	uint8_t src[TEST_MAX_SAMPLES * 4 + 4];
+	uint32_t mem[TEST_MAX_SAMPLES + 1];
+	uint32_t ref[TEST_MAX_SAMPLES];
+	uint32_t samples;
+	uint8_t bytes;
+	uint8_t offset;
+
+	for (bytes = 2; bytes <= 4; bytes++) {
+		for (samples = 0; samples <= TEST_MAX_SAMPLES; samples++) {
+			fill_bytes(src, sizeof(src), samples * bytes);
+
+			/* Out of place, from every source alignment */
+			for (offset = 0; offset < 4; offset++) {
+				ref_unpack_be(&src[offset], ref, samples, bytes);
+				memset(mem, 0xA5, sizeof(mem));
+				if (sample_unpack_be(&src[offset], mem, samples, bytes)
+				    || memcmp(mem, ref, samples * sizeof(*ref))
+				    || mem[samples] != 0xA5A5A5A5) {
+					test_fail("unpack out of place", bytes * 8, samples);
+				}
+			}
+
+			/* In place, packed words at the tail of the destination */
+			ref_unpack_be(src, ref, samples, bytes);
+			memcpy((uint8_t *)mem + samples * (4 - bytes), src, samples * bytes);
+			sample_unpack_be((uint8_t *)mem + samples * (4 - bytes), mem, samples,
+					 bytes);
+			if (memcmp(mem, ref, samples * sizeof(*ref))) {
+				test_fail("unpack in place", bytes * 8, samples);
+			}
+		}
+	}
+
+	if (sample_unpack_be(src, mem, 1, 1) != -EINVAL
+	    || sample_unpack_be(src, mem, 1, 5) != -EINVAL
+	    || sample_unpack_be(NULL, mem, 1, 3) != -EINVAL) {
+		test_fail("unpack invalid arguments", 0, 1);
+	}
+}
+
+/**
+ * @brief	Test the sign extend and offset binary kernels
+ * @return	none
+ */
+static void test_sign(void)
+{
+	static const uint32_t corner_codes[TEST_NB_CORNER_CODES] = {
+		0, 1, 0x7FFF, 0x8000, 0xFFFF, 0x1FFFF, 0x20000, 0x3FFFF,
+		0x7FFFF, 0x80000, 0xFFFFF, 0x7FFFFF, 0x800000, 0xFFFFFF,
+		0x7FFFFFFF, 0x80000000, 0xFFFFFFFF
+	};
+	uint32_t data[TEST_NB_CORNER_CODES];
+	uint32_t half_scale;
+	uint32_t i;
+	uint32_t code;
+	uint8_t bits;
+	uint8_t b;
+
+	for (b = 0; b < sizeof(test_bits); b++) {
+		bits = test_bits[b];
+
+		for (i = 0; i < TEST_NB_CORNER_CODES; i++) {
+			/* Codes are within the resolution, as unpacked from the ADC */
+			code = (bits == 32) ? corner_codes[i] :
+			       corner_codes[i] & ((1UL << bits) - 1);
+			data[i] = code;
+
+			if (sample_sign_extend_code(code, bits) != ref_twos(code, bits)) {
+				test_fail("sign extend code", bits, 1);
+			}
+
+			if (sample_offset_binary_code(code, bits) !=
+			    ref_twos(code ^ (1UL << (bits - 1)), bits)) {
+				test_fail("offset binary code", bits, 1);
+			}
+		}
+
+		sample_sign_extend(data, TEST_NB_CORNER_CODES, bits);
+		for (i = 0; i < TEST_NB_CORNER_CODES; i++) {
+			if ((int32_t)data[i] != sample_sign_extend_code(
+				    (bits == 32) ? corner_codes[i] :
+				    corner_codes[i] & ((1UL << bits) - 1), bits)) {
+				test_fail("sign extend block", bits, TEST_NB_CORNER_CODES);
+				break;
+			}
+		}
+
+		/* Offset binary zero, mid and full scale codes map onto the most
+		 * negative, zero and most positive two's complement values */
+		half_scale = 1UL << (bits - 1);
+		data[0] = 0;
+		data[1] = half_scale;
+		data[2] = half_scale | (half_scale - 1);
+		sample_offset_binary_to_twos(data, 3, bits);
+		if ((int32_t)data[0] != ref_twos(half_scale, bits)
+		    || data[1] != 0
+		    || (int32_t)data[2] != ref_twos(half_scale - 1, bits)) {
+			test_fail("offset binary block", bits, 3);
+		}
+	}
+}
+
+/**
+ * @brief	Test the pack kernel
+ * @return	none
+ */
+static void test_pack(void)
+{
+	static const uint8_t pack_bits[] = { 16, 20, 24 };
+	uint32_t src[TEST_MAX_SAMPLES];
+	uint8_t out[TEST_MAX_SAMPLES * 3 + 1];
+	uint8_t ref[TEST_MAX_SAMPLES * 3 + 1];
+	uint32_t ref_size;
+	uint32_t samples;
+	int32_t size;
+	uint8_t b;
+
+	for (b = 0; b < sizeof(pack_bits); b++) {
+		for (samples = 0; samples <= TEST_MAX_SAMPLES; samples++) {
+			fill_bytes((uint8_t *)src, sizeof(src), samples + pack_bits[b]);
+			ref_size = ref_pack_le(src, ref, samples, pack_bits[b]);
+			memset(out, 0xA5, sizeof(out));
+			size = sample_pack_le(src, out, samples, pack_bits[b]);
+			if (size != (int32_t)ref_size || memcmp(out, ref, ref_size)
+			    || out[ref_size] != 0xA5) {
+				test_fail("pack", pack_bits[b], samples);
+			}
+		}
+	}
+
+	if (sample_pack_le(src, out, 1, 18) != -EINVAL) {
+		test_fail("pack invalid size", 18, 1);
+	}
+}
+
+/**
+ * @brief	Get a monotonic time stamp
+ * @return	Time (in ns)
+ */
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief	Get a cycle stamp
+ * @return	Time stamp counter (0 if unavailable)
+ */
+static uint64_t now_cycles(void)
+{
+#if defined(BENCH_HAS_TSC)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * @brief	Per sample big endian unpack, as previously done in the firmware
+ * @param	src[in] - Packed words
+ * @param	dst[out] - Unpacked samples
+ * @param	samples[in] - Number of samples
+ * @param	bytes_per_word[in] - Packed word size
+ * @return	none
+ */
+static void legacy_unpack_be(const uint8_t *src, uint32_t *dst,
+			     uint32_t samples, uint8_t bytes_per_word)
+{
+	uint32_t idx;
+
+	for (idx = 0; idx < samples; idx++) {
+		switch (bytes_per_word) {
+		case 2:
+			dst[idx] = ((uint32_t)src[2 * idx] << 8) | src[2 * idx + 1];
+			break;
+		case 3:
+			dst[idx] = ((uint32_t)src[3 * idx] << 16) |
+				   ((uint32_t)src[3 * idx + 1] << 8) | src[3 * idx + 2];
+			break;
+		default:
+			dst[idx] = ((uint32_t)src[4 * idx] << 24) |
+				   ((uint32_t)src[4 * idx + 1] << 16) |
+				   ((uint32_t)src[4 * idx + 2] << 8) | src[4 * idx + 3];
+			break;
+		}
+	}
+}
+
+/**
+ * @brief	Per sample compare and subtract sign conversion, as previously done
+ *			in the firmware (ad4170/ad7606 bipolar codes)
+ * @param	data[in,out] - Samples
+ * @param	samples[in] - Number of samples
+ * @param	bits[in] - Resolution
+ * @return	none
+ */
+static void legacy_sign_extend(uint32_t *data, uint32_t samples, uint8_t bits)
+{
+	uint32_t max_bipolar = 1UL << (bits - 1);
+	uint32_t max_unipolar = (bits == 32) ? 0xFFFFFFFF : (1UL << bits) - 1;
+	uint32_t idx;
+
+	for (idx = 0; idx < samples; idx++) {
+		if (data[idx] >= max_bipolar) {
+			data[idx] = -(int32_t)(max_unipolar - data[idx]) - 1;
+		}
+	}
+}
+
+/**
+ * @brief	Build the raw codes of one benchmark run
+ * @param	src[in] - Random source bytes
+ * @param	raw[out] - Raw codes limited to the resolution
+ * @param	bits[in] - ADC resolution
+ * @return	none
+ */
+static void bench_raw_codes(const uint8_t *src, uint32_t *raw, uint8_t bits)
+{
+	uint32_t mask = (bits < 32) ? ((1UL << bits) - 1) : 0xFFFFFFFFUL;
+	uint32_t idx;
+
+	sample_unpack_be(src, raw, BENCH_SAMPLES, 4);
+	for (idx = 0; idx < BENCH_SAMPLES; idx++) {
+		raw[idx] &= mask;
+	}
+}
+
+/**
+ * @brief	Print one benchmark result line
+ * @param	name[in] - Kernel name
+ * @param	bits[in] - Word size or resolution
+ * @param	legacy[in] - Legacy time (ns) and cycles for the run
+ * @param	kernel[in] - Kernel time (ns) and cycles for the run
+ * @return	none
+ */
+static void bench_print(const char *name, uint8_t bits, const uint64_t *legacy,
+			const uint64_t *kernel)
+{
+	printf("%-14s %4u  %8.3f  %8.3f", name, bits,
+	       (double)legacy[0] / BENCH_SAMPLES_PER_RUN,
+	       (double)kernel[0] / BENCH_SAMPLES_PER_RUN);
+#if defined(BENCH_HAS_TSC)
+	printf("  %8.2f  %8.2f", (double)legacy[1] / BENCH_SAMPLES_PER_RUN,
+	       (double)kernel[1] / BENCH_SAMPLES_PER_RUN);
+#endif
+	printf("  %6.2fx\n", (double)legacy[0] / kernel[0]);
+}
+
+/**
+ * @brief	Benchmark every kernel against the per sample firmware loops
+ * @return	none
+ */
+static void bench_run(void)
+{
+	static const uint8_t pack_bits[] = { 16, 20, 24 };
+	uint32_t reps = BENCH_SAMPLES_PER_RUN / BENCH_SAMPLES;
+	uint8_t *src = malloc(BENCH_SAMPLES * 4);
+	uint32_t *dst = malloc(BENCH_SAMPLES * 4);
+	uint32_t *raw = malloc(BENCH_SAMPLES * 4);
+	uint8_t *packed = malloc(BENCH_SAMPLES * 3);
+	uint64_t legacy[2];
+	uint64_t kernel[2];
+	uint64_t start[2];
+	uint32_t rep;
+	uint8_t bytes;
+	uint8_t b;
+
+	if (!src || !dst || !raw || !packed) {
+		printf("out of memory\n");
+		goto free_mem;
+	}
+
+	fill_bytes(src, BENCH_SAMPLES * 4, 1);
+
+	printf("\n%-14s %4s  %8s  %8s", "kernel", "bits", "ns/smp", "ns/smp");
+#if defined(BENCH_HAS_TSC)
+	printf("  %8s  %8s", "tsc/smp", "tsc/smp");
+#endif
+	printf("  %7s\n", "speedup");
+	printf("%-14s %4s  %8s  %8s", "", "", "legacy", "kernel");
+#if defined(BENCH_HAS_TSC)
+	printf("  %8s  %8s", "legacy", "kernel");
+#endif
+	printf("\n");
+
+	for (bytes = 2; bytes <= 4; bytes++) {
+		start[0] = now_ns();
+		start[1] = now_cycles();
+		for (rep = 0; rep < reps; rep++) {
+			legacy_unpack_be(src, dst, BENCH_SAMPLES, bytes);
+		}
+		legacy[1] = now_cycles() - start[1];
+		legacy[0] = now_ns() - start[0];
+
+		start[0] = now_ns();
+		start[1] = now_cycles();
+		for (rep = 0; rep < reps; rep++) {
+			sample_unpack_be(src, dst, BENCH_SAMPLES, bytes);
+		}
+		kernel[1] = now_cycles() - start[1];
+		kernel[0] = now_ns() - start[0];
+
+		bench_print("unpack_be", bytes * 8, legacy, kernel);
+	}
+
+	/* The in place conversions restart from the same raw codes on every
+	 * repetition (both loops pay the same copy), so the branchy legacy loop
+	 * sees a random sign mix instead of already converted values */
+	for (b = 0; b < sizeof(test_bits); b++) {
+		bench_raw_codes(src, raw, test_bits[b]);
+
+		start[0] = now_ns();
+		start[1] = now_cycles();
+		for (rep = 0; rep < reps; rep++) {
+			memcpy(dst, raw, BENCH_SAMPLES * 4);
+			legacy_sign_extend(dst, BENCH_SAMPLES, test_bits[b]);
+		}
+		legacy[1] = now_cycles() - start[1];
+		legacy[0] = now_ns() - start[0];
+
+		start[0] = now_ns();
+		start[1] = now_cycles();
+		for (rep = 0; rep < reps; rep++) {
+			memcpy(dst, raw, BENCH_SAMPLES * 4);
+			sample_sign_extend(dst, BENCH_SAMPLES, test_bits[b]);
+		}
+		kernel[1] = now_cycles() - start[1];
+		kernel[0] = now_ns() - start[0];
+
+		bench_print("sign_extend", test_bits[b], legacy, kernel);
+	}
+
+	for (b = 0; b < sizeof(test_bits); b++) {
+		bench_raw_codes(src, raw, test_bits[b]);
+
+		/* The legacy firmware had no block conversion: XOR + compare loop */
+		start[0] = now_ns();
+		start[1] = now_cycles();
+		for (rep = 0; rep < reps; rep++) {
+			memcpy(dst, raw, BENCH_SAMPLES * 4);
+			for (uint32_t idx = 0; idx < BENCH_SAMPLES; idx++) {
+				dst[idx] ^= 1UL << (test_bits[b] - 1);
+			}
+			legacy_sign_extend(dst, BENCH_SAMPLES, test_bits[b]);
+		}
+		legacy[1] = now_cycles() - start[1];
+		legacy[0] = now_ns() - start[0];
+
+		start[0] = now_ns();
+		start[1] = now_cycles();
+		for (rep = 0; rep < reps; rep++) {
+			memcpy(dst, raw, BENCH_SAMPLES * 4);
+			sample_offset_binary_to_twos(dst, BENCH_SAMPLES, test_bits[b]);
+		}
+		kernel[1] = now_cycles() - start[1];
+		kernel[0] = now_ns() - start[0];
+
+		bench_print("offset_binary", test_bits[b], legacy, kernel);
+	}
+
+	/* No firmware packed words before the kernel: compare against the bit
+	 * wise reference used by the tests */
+	for (b = 0; b < sizeof(pack_bits); b++) {
+		bench_raw_codes(src, dst, pack_bits[b]);
+
+		start[0] = now_ns();
+		start[1] = now_cycles();
+		for (rep = 0; rep < reps; rep++) {
+			ref_pack_le(dst, packed, BENCH_SAMPLES, pack_bits[b]);
+		}
+		legacy[1] = now_cycles() - start[1];
+		legacy[0] = now_ns() - start[0];
+
+		start[0] = now_ns();
+		start[1] = now_cycles();
+		for (rep = 0; rep < reps; rep++) {
+			sample_pack_le(dst, packed, BENCH_SAMPLES, pack_bits[b]);
+		}
+		kernel[1] = now_cycles() - start[1];
+		kernel[0] = now_ns() - start[0];
+
+		bench_print("pack_le", pack_bits[b], legacy, kernel);
+	}
+
+	/* Keep the results alive */
+	printf("(checksum %02x)\n", packed[0] ^ (uint8_t)dst[0]);
+
+free_mem:
+	free(packed);
+	free(raw);
+	free(dst);
+	free(src);
+}
+
+int main(int argc, char *argv[])
+{
+	test_unpack();
+	test_sign();
+	test_pack();
+
+	if (test_failures) {
+		printf("%u check(s) failed\n", test_failures);
+		return EXIT_FAILURE;
+	}
+	printf("All sample format checks passed\n");
+
+	if (argc > 1 && !strcmp(argv[1], "--test")) {
+		return EXIT_SUCCESS;
+	}
+
+	bench_run();
+
+	return EXIT_SUCCESS;
+}
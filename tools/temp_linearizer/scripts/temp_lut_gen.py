@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Generate the temperature sensor linearization tables.
+
+The tables of projects/_common/temp_linearizer_tables.c are generated from the
+reference conversions of the sensors (IEC 60751 Callendar-Van Dusen for the
+platinum RTDs, Steinhart-Hart for the NTC thermistor, NIST ITS-90 inverse
+polynomials for the type T thermocouple). For every sensor, the smallest
+uniform grid is selected whose linear interpolation stays within the error
+bound over the whole sensor range.
+
+Usage: temp_lut_gen.py [-o output.c] [--max-error degC]
+"""
+
+import argparse
+import math
+import os
+import sys
+
+# Callendar-Van Dusen coefficients (IEC 60751)
+CVD_A = 3.9083e-3
+CVD_B = -5.775e-7
+CVD_C = -4.183e-12
+
+# NTC 10K 44031RC Steinhart-Hart coefficients
+NTC_SH_A = 1.032e-3
+NTC_SH_B = 2.387e-4
+NTC_SH_C = 1.580e-7
+
+# NTC divider sense resistor (ohms), the NTC being on the low side
+NTC_RSENSE = 10000.0
+
+# Type T thermocouple inverse polynomials (NIST ITS-90), mV to degC
+TC_T_NEG = [0.0, 2.5949192e1, -2.1316967e-1, 7.9018692e-1, 4.2527777e-1,
+            1.3304473e-1, 2.0241446e-2, 1.2668171e-3]
+TC_T_POS = [0.0, 2.592800e1, -7.602961e-1, 4.637791e-2, -2.165394e-3,
+            6.048144e-5, -7.293422e-7]
+
+
+def rtd_ratio(temp):
+    """RTD resistance ratio R/R0 at a temperature (degC)."""
+    ratio = 1 + CVD_A * temp + CVD_B * temp * temp
+    if temp < 0:
+        ratio += CVD_C * (temp - 100) * temp ** 3
+    return ratio
+
+
+def rtd_temp(ratio):
+    """RTD temperature (degC) from the resistance ratio R/R0."""
+    temp = (-CVD_A + math.sqrt(CVD_A * CVD_A - 4 * CVD_B * (1 - ratio))) / (2 * CVD_B)
+    if ratio < 1:
+        # Solve the full equation below 0 degC (Newton)
+        for _ in range(20):
+            deriv = (CVD_A + 2 * CVD_B * temp
+                     + CVD_C * (4 * temp ** 3 - 300 * temp * temp))
+            temp -= (rtd_ratio(temp) - ratio) / deriv
+    return temp
+
+
+def ntc_resistance(temp):
+    """NTC resistance (ohms) at a temperature (degC)."""
+    inv_t = 1 / (temp + 273.15)
+    # Solve C*y^3 + B*y + (A - 1/T) = 0 for y = ln(R)
+    x = (NTC_SH_A - inv_t) / NTC_SH_C
+    y = math.sqrt((NTC_SH_B / (3 * NTC_SH_C)) ** 3 + x * x / 4)
+    return math.exp((y - x / 2) ** (1 / 3) - (y + x / 2) ** (1 / 3))
+
+
+def ntc_temp(ratio):
+    """NTC temperature (degC) from the divider ratio R/(R + Rsense)."""
+    ln_r = math.log(ratio * NTC_RSENSE / (1 - ratio))
+    return 1 / (NTC_SH_A + NTC_SH_B * ln_r + NTC_SH_C * ln_r ** 3) - 273.15
+
+
+def tc_t_temp(mv):
+    """Type T thermocouple temperature (degC) from the EMF (mV)."""
+    coeffs = TC_T_NEG if mv < 0 else TC_T_POS
+    return sum(c * mv ** i for i, c in enumerate(coeffs))
+
+
+# name, description, input, reference conversion, input range
+SENSORS = [
+    ("temp_lin_pt_rtd", "Platinum RTD (PT100/PT1000), -200 to 850 degC",
+     "resistance ratio R/R0", rtd_temp, rtd_ratio(-200), rtd_ratio(850)),
+    ("temp_lin_ntc_10k_44031", "NTC 10K 44031RC thermistor, -40 to 150 degC",
+     "divider ratio R/(R + 10K)", ntc_temp,
+     ntc_resistance(150) / (ntc_resistance(150) + NTC_RSENSE),
+     ntc_resistance(-40) / (ntc_resistance(-40) + NTC_RSENSE)),
+    ("temp_lin_tc_type_t", "Type T thermocouple, -200 to 400 degC",
+     "EMF in mV (0 degC reference junction)", tc_t_temp, -5.603, 20.872),
+]
+
+
+def table_error(conv, x_min, x_max, nb_points, oversampling=16):
+    """Max linear interpolation error of a uniform table (degC)."""
+    step = (x_max - x_min) / (nb_points - 1)
+    temps = [conv(x_min + i * step) for i in range(nb_points)]
+    err = 0.0
+    for i in range(nb_points - 1):
+        for k in range(1, oversampling):
+            frac = k / oversampling
+            x = x_min + (i + frac) * step
+            interp = temps[i] + frac * (temps[i + 1] - temps[i])
+            err = max(err, abs(interp - conv(x)))
+    return err, temps
+
+
+def select_table(conv, x_min, x_max, max_error):
+    """Smallest table (points) within the error bound."""
+    nb_points = 16
+    while True:
+        err, temps = table_error(conv, x_min, x_max, nb_points)
+        if err <= max_error or nb_points >= 4096:
+            return nb_points, err, temps
+        nb_points += 16
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("-o", "--output", default=os.path.join(
+        os.path.dirname(__file__), "..", "..", "..", "projects", "_common",
+        "temp_linearizer_tables.c"))
+    parser.add_argument("--max-error", type=float, default=0.01,
+                        help="max interpolation error (degC)")
+    args = parser.parse_args()
+
+    out = []
+    out.append("/***************************************************************************//**")
+    out.append(" * @file    temp_linearizer_tables.c")
+    out.append(" * @brief   Temperature sensor linearization tables")
+    out.append(" * @details Generated by tools/temp_linearizer/scripts/temp_lut_gen.py, do not")
+    out.append(" *          edit. Max interpolation error: %.3f degC." % args.max_error)
+    out.append("********************************************************************************")
+    out.append("* Copyright (c) 2026 Analog Devices, Inc.")
+    out.append("* All rights reserved.")
+    out.append("*")
+    out.append("* This software is proprietary to Analog Devices, Inc. and its licensors.")
+    out.append("* By using this software you agree to the terms of the associated")
+    out.append("* Analog Devices Software License Agreement.")
+    out.append("*******************************************************************************/")
+    out.append("")
+    out.append("/******************************************************************************/")
+    out.append("/***************************** Include Files **********************************/")
+    out.append("/******************************************************************************/")
+    out.append('#include "temp_linearizer.h"')
+    out.append("")
+    out.append("/******************************************************************************/")
+    out.append("/********************** Variables and User Defined Data Types *****************/")
+    out.append("/******************************************************************************/")
+
+    for name, desc, in_desc, conv, x_min, x_max in SENSORS:
+        nb_points, err, temps = select_table(conv, x_min, x_max, args.max_error)
+        step = (x_max - x_min) / (nb_points - 1)
+        print("%s: %u points, max error %.4f degC" % (name, nb_points, err),
+              file=sys.stderr)
+
+        out.append("")
+        out.append("/* %s" % desc)
+        out.append(" * Input: %s, %u points (max error %.4f degC) */" %
+                   (in_desc, nb_points, err))
+        out.append("static const float %s_temps[%u] = {" % (name, nb_points))
+        for i in range(0, nb_points, 6):
+            out.append("\t" + ", ".join("%.6ff" % t for t in temps[i:i + 6]) + ",")
+        out.append("};")
+        out.append("")
+        out.append("const struct temp_lin_table %s = {" % name)
+        out.append("\t.x_min = %.9gf," % x_min)
+        out.append("\t.x_scale = %.9gf," % (1 / step))
+        out.append("\t.nb_points = %u," % nb_points)
+        out.append("\t.temps = %s_temps" % name)
+        out.append("};")
+
+    with open(args.output, "w", newline="\n") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,342 @@
+/***************************************************************************//**
+ * @file    temp_lin_bench.c
+ * @brief   Host benchmark of the table driven temperature linearization
+ * @details Checks the accuracy of the linearization tables against the
+ *          reference sensor equations (Callendar-Van Dusen, Steinhart-Hart,
+ *          NIST ITS-90 inverse polynomials) evaluated in double precision,
+ *          and times the table conversions (per sample and per block of ADC
+ *          codes) against the per sample float evaluation of the equations.
+********************************************************************************
+* Copyright (c) 2026 Analog Devices, Inc.
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "temp_linearizer.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Callendar-Van Dusen coefficients (IEC 60751) */
+#define CVD_A		3.9083e-3
+#define CVD_B		-5.775e-7
+#define CVD_C		-4.183e-12
+
+/* NTC 10K 44031RC Steinhart-Hart coefficients */
+#define NTC_SH_A	1.032e-3
+#define NTC_SH_B	2.387e-4
+#define NTC_SH_C	1.580e-7
+
+/* NTC divider sense resistor (in ohms) */
+#define NTC_RSENSE	10000.0
+
+/* Points checked per table step for the accuracy */
+#define BENCH_OVERSAMPLING	64
+
+/* ADC codes per timed block (one firmware capture of 100 samples per
+ * channel, 8 channels) and number of timed blocks */
+#define BENCH_BLOCK_SIZE	800
+#define BENCH_NB_BLOCKS		20000
+
+/* Bipolar zero scale of a 24-bit ADC */
+#define BENCH_ZERO_CODE		(1 << 23)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Type T inverse polynomials (NIST ITS-90), mV to degC */
+static const double tc_t_neg[] = {
+	0.0, 2.5949192e1, -2.1316967e-1, 7.9018692e-1, 4.2527777e-1,
+	1.3304473e-1, 2.0241446e-2, 1.2668171e-3
+};
+
+static const double tc_t_pos[] = {
+	0.0, 2.592800e1, -7.602961e-1, 4.637791e-2, -2.165394e-3,
+	6.048144e-5, -7.293422e-7
+};
+
+/* Sensor under test */
+struct bench_sensor {
+	const char *name;
+	const struct temp_lin_table *tbl;
+	/* Reference conversion (double precision) */
+	double (*ref)(double x);
+	/* Per sample conversion of the firmware before the tables (float) */
+	float (*legacy)(float x);
+};
+
+/* Benchmark result sink (keeps the conversions from being optimized out) */
+static volatile float bench_sink;
+
+/******************************************************************************/
+/************************** Functions Definitions *****************************/
+/******************************************************************************/
+
+/**
+ * @brief	RTD temperature from the resistance ratio R/R0 (reference)
+ * @param	ratio[in] - Resistance ratio
+ * @return	Temperature (degC)
+ */
+static double rtd_ref(double ratio)
+{
+	double temp = (-CVD_A + sqrt(CVD_A * CVD_A - 4 * CVD_B * (1 - ratio))) /
+		      (2 * CVD_B);
+	double r;
+	double deriv;
+	int i;
+
+	if (ratio < 1) {
+		/* Full equation below 0 degC (Newton) */
+		for (i = 0; i < 20; i++) {
+			r = 1 + CVD_A * temp + CVD_B * temp * temp
+			    + CVD_C * (temp - 100) * temp * temp * temp;
+			deriv = CVD_A + 2 * CVD_B * temp
+				+ CVD_C * (4 * temp * temp * temp - 300 * temp * temp);
+			temp -= (r - ratio) / deriv;
+		}
+	}
+
+	return temp;
+}
+
+/**
+ * @brief	RTD temperature from the resistance ratio R/R0 (float, with the
+ *			usual polynomial fit below 0 degC)
+ * @param	ratio[in] - Resistance ratio
+ * @return	Temperature (degC)
+ */
+static float rtd_legacy(float ratio)
+{
+	float r;
+
+	if (ratio >= 1.0f) {
+		return (-(float)CVD_A + sqrtf((float)(CVD_A * CVD_A) - 4.0f *
+					      (float)CVD_B * (1.0f - ratio))) / (2.0f * (float)CVD_B);
+	}
+
+	r = ratio * 100.0f;
+	return -242.02f + 2.2228f * r + 2.5859e-3f * r * r - 4.8260e-6f * r * r * r
+	       - 2.8183e-8f * r * r * r * r + 1.5243e-10f * r * r * r * r * r;
+}
+
+/**
+ * @brief	NTC temperature from the divider ratio R/(R + Rsense) (reference)
+ * @param	ratio[in] - Divider ratio
+ * @return	Temperature (degC)
+ */
+static double ntc_ref(double ratio)
+{
+	double ln_r = log(ratio * NTC_RSENSE / (1 - ratio));
+
+	return 1 / (NTC_SH_A + NTC_SH_B * ln_r + NTC_SH_C * ln_r * ln_r * ln_r) -
+	       273.15;
+}
+
+/**
+ * @brief	NTC temperature from the divider ratio R/(R + Rsense) (float)
+ * @param	ratio[in] - Divider ratio
+ * @return	Temperature (degC)
+ */
+static float ntc_legacy(float ratio)
+{
+	float ln_r = logf(ratio * (float)NTC_RSENSE / (1.0f - ratio));
+
+	return 1.0f / ((float)NTC_SH_A + (float)NTC_SH_B * ln_r +
+		       (float)NTC_SH_C * powf(ln_r, 3)) - 273.15f;
+}
+
+/**
+ * @brief	Type T temperature from the EMF in mV (reference)
+ * @param	mv[in] - Thermocouple EMF
+ * @return	Temperature (degC)
+ */
+static double tc_t_ref(double mv)
+{
+	const double *coeffs = (mv < 0) ? tc_t_neg : tc_t_pos;
+	int nb = (mv < 0) ? 8 : 7;
+	double temp = 0;
+
+	while (nb--) {
+		temp = temp * mv + coeffs[nb];
+	}
+
+	return temp;
+}
+
+/**
+ * @brief	Type T temperature from the EMF in mV (float, power series)
+ * @param	mv[in] - Thermocouple EMF
+ * @return	Temperature (degC)
+ */
+static float tc_t_legacy(float mv)
+{
+	const double *coeffs = (mv < 0) ? tc_t_neg : tc_t_pos;
+	int nb = (mv < 0) ? 8 : 7;
+	float temp = 0;
+	int i;
+
+	for (i = 0; i < nb; i++) {
+		temp += (float)coeffs[i] * powf(mv, i);
+	}
+
+	return temp;
+}
+
+/**
+ * @brief	Get a monotonic time stamp
+ * @return	Time (in ns)
+ */
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief	Check the table accuracy against the reference conversion
+ * @param	sensor[in] - Sensor under test
+ * @return	none
+ */
+static void bench_accuracy(const struct bench_sensor *sensor)
+{
+	const struct temp_lin_table *tbl = sensor->tbl;
+	uint32_t nb = (tbl->nb_points - 1) * BENCH_OVERSAMPLING;
+	double step = 1.0 / (tbl->x_scale * BENCH_OVERSAMPLING);
+	double err_max = 0;
+	double err_sq = 0;
+	double legacy_max = 0;
+	double err;
+	double x;
+	uint32_t i;
+
+	for (i = 0; i <= nb; i++) {
+		x = tbl->x_min + i * step;
+
+		err = fabs(temp_lin_convert(tbl, (float)x) - sensor->ref(x));
+		err_sq += err * err;
+		if (err > err_max) {
+			err_max = err;
+		}
+
+		err = fabs(sensor->legacy((float)x) - sensor->ref(x));
+		if (err > legacy_max) {
+			legacy_max = err;
+		}
+	}
+
+	printf("%-8s %6u %8.1f  %10.4f %10.4f %12.4f\n", sensor->name,
+	       tbl->nb_points, tbl->nb_points * sizeof(float) / 1024.0, err_max,
+	       sqrt(err_sq / (nb + 1)), legacy_max);
+}
+
+/**
+ * @brief	Time the conversions of ADC code blocks spanning the sensor range
+ * @param	sensor[in] - Sensor under test
+ * @param	codes[in] - Code memory (BENCH_BLOCK_SIZE)
+ * @param	temps[in] - Temperature memory (BENCH_BLOCK_SIZE)
+ * @return	none
+ */
+static void bench_speed(const struct bench_sensor *sensor, int32_t *codes,
+			float *temps)
+{
+	const struct temp_lin_table *tbl = sensor->tbl;
+	float x_max = tbl->x_min + (tbl->nb_points - 1) / tbl->x_scale;
+	/* Bipolar ratiometric input, table input full range over half the
+	 * positive codes (x = code * scale + offset) */
+	float scale = (x_max - tbl->x_min) / (BENCH_ZERO_CODE / 2);
+	float offset = tbl->x_min - BENCH_ZERO_CODE * scale;
+	uint64_t t_legacy;
+	uint64_t t_single;
+	uint64_t t_block;
+	uint64_t start;
+	uint32_t block;
+	uint32_t i;
+
+	for (i = 0; i < BENCH_BLOCK_SIZE; i++) {
+		codes[i] = BENCH_ZERO_CODE + (int32_t)(((uint64_t)i * 7919 %
+						       BENCH_BLOCK_SIZE) * (BENCH_ZERO_CODE / 2) / BENCH_BLOCK_SIZE);
+	}
+
+	start = now_ns();
+	for (block = 0; block < BENCH_NB_BLOCKS; block++) {
+		for (i = 0; i < BENCH_BLOCK_SIZE; i++) {
+			temps[i] = sensor->legacy(codes[i] * scale + offset);
+		}
+		bench_sink = temps[block % BENCH_BLOCK_SIZE];
+	}
+	t_legacy = now_ns() - start;
+
+	start = now_ns();
+	for (block = 0; block < BENCH_NB_BLOCKS; block++) {
+		for (i = 0; i < BENCH_BLOCK_SIZE; i++) {
+			temps[i] = temp_lin_convert(tbl, codes[i] * scale + offset);
+		}
+		bench_sink = temps[block % BENCH_BLOCK_SIZE];
+	}
+	t_single = now_ns() - start;
+
+	start = now_ns();
+	for (block = 0; block < BENCH_NB_BLOCKS; block++) {
+		temp_lin_convert_codes(tbl, codes, BENCH_BLOCK_SIZE, scale, offset, temps);
+		bench_sink = temps[block % BENCH_BLOCK_SIZE];
+	}
+	t_block = now_ns() - start;
+
+	printf("%-8s %12.2f %12.2f %12.2f\n", sensor->name,
+	       (double)t_legacy / ((uint64_t)BENCH_NB_BLOCKS * BENCH_BLOCK_SIZE),
+	       (double)t_single / ((uint64_t)BENCH_NB_BLOCKS * BENCH_BLOCK_SIZE),
+	       (double)t_block / ((uint64_t)BENCH_NB_BLOCKS * BENCH_BLOCK_SIZE));
+}
+
+/**
+ * @brief	Run all the benchmarks
+ * @return	0 in case of success, 1 otherwise
+ */
+int main(void)
+{
+	static const struct bench_sensor sensors[] = {
+		{ "rtd", &temp_lin_pt_rtd, rtd_ref, rtd_legacy },
+		{ "ntc", &temp_lin_ntc_10k_44031, ntc_ref, ntc_legacy },
+		{ "tc_t", &temp_lin_tc_type_t, tc_t_ref, tc_t_legacy },
+	};
+	const size_t nb_sensors = sizeof(sensors) / sizeof(sensors[0]);
+	int32_t *codes = malloc(BENCH_BLOCK_SIZE * sizeof(*codes));
+	float *temps = malloc(BENCH_BLOCK_SIZE * sizeof(*temps));
+	size_t i;
+
+	if (!codes || !temps) {
+		free(codes);
+		free(temps);
+		return 1;
+	}
+
+	printf("sensor   points  kbytes  max err(C) rms err(C)  equation(C)\n");
+	for (i = 0; i < nb_sensors; i++) {
+		bench_accuracy(&sensors[i]);
+	}
+
+	printf("\nsensor   equation(ns)  table(ns)  block(ns)   per sample\n");
+	for (i = 0; i < nb_sensors; i++) {
+		bench_speed(&sensors[i], codes, temps);
+	}
+
+	free(codes);
+	free(temps);
+
+	return 0;
+}